@@ -110,6 +110,7 @@ set(vtk_cmake_module_files
   FindTBB.cmake
   FindTHEORA.cmake
   Findutf8cpp.cmake
+  FindZSTD.cmake
   FindCGNS.cmake
 
   vtkCMakeBackports.cmake
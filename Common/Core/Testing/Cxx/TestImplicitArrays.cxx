@@ -0,0 +1,258 @@
+/*==============================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+==============================================================================*/
+#include "vtkAffineArray.h"
+#include "vtkArrayDispatch.h"
+#include "vtkCompositeArray.h"
+#include "vtkConstantArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIndexedArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+
+// Needed for portable setenv on MSVC...
+#include "vtksys/SystemTools.hxx"
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+// A user defined backend, checking that any functor can be used.
+struct SquareBackend
+{
+  double operator()(vtkIdType valueIdx) const { return static_cast<double>(valueIdx * valueIdx); }
+};
+
+// Sums an array through the vtkGenericDataArray API.
+struct SumWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    for (const auto value : vtk::DataArrayValueRange(array))
+    {
+      this->Sum += static_cast<double>(value);
+    }
+  }
+
+  double Sum = 0.0;
+};
+
+int CheckValues(vtkDataArray* array, const std::vector<double>& expected, const char* name)
+{
+  if (array->GetNumberOfValues() != static_cast<vtkIdType>(expected.size()))
+  {
+    std::cerr << name << ": expected " << expected.size() << " values, got "
+              << array->GetNumberOfValues() << std::endl;
+    return 1;
+  }
+  const int numComps = array->GetNumberOfComponents();
+  for (vtkIdType idx = 0; idx < array->GetNumberOfValues(); ++idx)
+  {
+    const double value = array->GetComponent(idx / numComps, static_cast<int>(idx % numComps));
+    if (value != expected[idx])
+    {
+      std::cerr << name << ": value " << idx << " is " << value << ", expected " << expected[idx]
+                << std::endl;
+      return 1;
+    }
+  }
+
+  // Going through the generic fallback and through a typed worker must agree.
+  double expectedSum = 0.0;
+  for (double value : expected)
+  {
+    expectedSum += value;
+  }
+  SumWorker worker;
+  worker(array);
+  if (worker.Sum != expectedSum)
+  {
+    std::cerr << name << ": sum is " << worker.Sum << ", expected " << expectedSum << std::endl;
+    return 1;
+  }
+  return 0;
+}
+}
+
+int TestImplicitArrays(int, char*[])
+{
+  vtksys::SystemTools::PutEnv("VTK_SILENCE_GET_VOID_POINTER_WARNINGS=1");
+
+  int errors = 0;
+
+  // Constant
+  vtkNew<vtkConstantArray<int>> constant;
+  constant->ConstructBackend(42);
+  constant->SetNumberOfComponents(2);
+  constant->SetNumberOfTuples(10);
+  errors += CheckValues(constant, std::vector<double>(20, 42.0), "constant");
+  SumWorker typedWorker;
+  typedWorker(constant.GetPointer());
+  if (typedWorker.Sum != 20 * 42.0)
+  {
+    std::cerr << "constant: typed sum is " << typedWorker.Sum << std::endl;
+    ++errors;
+  }
+  if (constant->GetActualMemorySize() != 1)
+  {
+    std::cerr << "constant: the array should not allocate its values." << std::endl;
+    ++errors;
+  }
+
+  // Affine
+  vtkNew<vtkAffineArray<vtkIdType>> affine;
+  affine->ConstructBackend(3, 7);
+  affine->SetNumberOfTuples(100);
+  std::vector<double> expectedAffine;
+  for (vtkIdType idx = 0; idx < 100; ++idx)
+  {
+    expectedAffine.push_back(static_cast<double>(3 * idx + 7));
+  }
+  errors += CheckValues(affine, expectedAffine, "affine");
+
+  // Affine range goes through the regular vtkDataArray machinery.
+  double range[2];
+  affine->GetRange(range);
+  if (range[0] != 7 || range[1] != 3 * 99 + 7)
+  {
+    std::cerr << "affine: wrong range [" << range[0] << ", " << range[1] << "]" << std::endl;
+    ++errors;
+  }
+
+  // Composite
+  vtkNew<vtkFloatArray> first;
+  first->SetNumberOfComponents(2);
+  vtkNew<vtkIntArray> second;
+  second->SetNumberOfComponents(2);
+  std::vector<double> expectedComposite;
+  for (int idx = 0; idx < 6; ++idx)
+  {
+    first->InsertNextValue(idx + 0.5f);
+    expectedComposite.push_back(idx + 0.5);
+  }
+  for (int idx = 0; idx < 4; ++idx)
+  {
+    second->InsertNextValue(-idx);
+    expectedComposite.push_back(-idx);
+  }
+  vtkNew<vtkCompositeArray<double>> composite;
+  composite->ConstructBackend(std::vector<vtkDataArray*>{ first, second });
+  composite->SetNumberOfComponents(2);
+  composite->SetNumberOfTuples(5);
+  errors += CheckValues(composite, expectedComposite, "composite");
+
+  // Indexed, with a vtkIdList and with an array of indexes.
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType id : { 4, 0, 4, 2 })
+  {
+    ids->InsertNextId(id);
+  }
+  std::vector<double> expectedIndexed;
+  for (vtkIdType idx = 0; idx < ids->GetNumberOfIds(); ++idx)
+  {
+    expectedIndexed.push_back(static_cast<double>(3 * ids->GetId(idx) + 7));
+  }
+  vtkNew<vtkIndexedArray<vtkIdType>> indexed;
+  indexed->ConstructBackend(ids, affine);
+  indexed->SetNumberOfTuples(ids->GetNumberOfIds());
+  errors += CheckValues(indexed, expectedIndexed, "indexed (id list)");
+
+  vtkNew<vtkIntArray> idArray;
+  for (vtkIdType idx = 0; idx < ids->GetNumberOfIds(); ++idx)
+  {
+    idArray->InsertNextValue(static_cast<int>(ids->GetId(idx)));
+  }
+  vtkNew<vtkIndexedArray<float>> indexedFromArray;
+  indexedFromArray->ConstructBackend(idArray, affine);
+  indexedFromArray->SetNumberOfTuples(idArray->GetNumberOfTuples());
+  errors += CheckValues(indexedFromArray, expectedIndexed, "indexed (array)");
+
+  // User defined backend
+  vtkNew<vtkImplicitArray<SquareBackend>> square;
+  square->SetNumberOfTuples(10);
+  std::vector<double> expectedSquare;
+  for (vtkIdType idx = 0; idx < 10; ++idx)
+  {
+    expectedSquare.push_back(static_cast<double>(idx * idx));
+  }
+  errors += CheckValues(square, expectedSquare, "square");
+
+  // Copying out of an implicit array produces an explicit array.
+  vtkSmartPointer<vtkDataArray> explicitCopy = vtk::TakeSmartPointer(affine->NewInstance());
+  explicitCopy->DeepCopy(affine);
+  if (explicitCopy->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate)
+  {
+    std::cerr << "NewInstance should create an AOS array." << std::endl;
+    ++errors;
+  }
+  errors += CheckValues(explicitCopy, expectedAffine, "explicit copy");
+
+  // Deep copying an implicit array shares its backend.
+  vtkNew<vtkAffineArray<vtkIdType>> affineCopy;
+  affineCopy->DeepCopy(affine);
+  if (affineCopy->GetBackend() != affine->GetBackend())
+  {
+    std::cerr << "Deep copy of an implicit array should share the backend." << std::endl;
+    ++errors;
+  }
+  errors += CheckValues(affineCopy, expectedAffine, "implicit copy");
+
+  // GetVoidPointer materializes the values.
+  vtkIdType* materialized = static_cast<vtkIdType*>(affine->GetVoidPointer(0));
+  for (vtkIdType idx = 0; idx < 100; ++idx)
+  {
+    if (materialized[idx] != 3 * idx + 7)
+    {
+      std::cerr << "Wrong materialized value at " << idx << std::endl;
+      ++errors;
+      break;
+    }
+  }
+  affine->Squeeze();
+
+  // Initialize releases the backend, but the array can still be evaluated.
+  vtkNew<vtkCompositeArray<float>> emptied;
+  emptied->ConstructBackend(std::vector<vtkDataArray*>{ first });
+  emptied->Initialize();
+  emptied->SetNumberOfTuples(4);
+  errors += CheckValues(emptied, std::vector<double>(4, 0.0), "initialized composite");
+  vtkNew<vtkIndexedArray<double>> indexedEmptied;
+  indexedEmptied->Initialize();
+  indexedEmptied->SetNumberOfTuples(3);
+  errors += CheckValues(indexedEmptied, std::vector<double>(3, 0.0), "initialized indexed");
+  vtkNew<vtkAffineArray<vtkIdType>> affineEmptied;
+  affineEmptied->ConstructBackend(2, 5);
+  affineEmptied->Initialize();
+  affineEmptied->SetNumberOfTuples(2);
+  errors += CheckValues(affineEmptied, std::vector<double>{ 0.0, 1.0 }, "initialized affine");
+
+  // Dispatch always succeeds, through the fast path when the implicit arrays
+  // are part of the dispatch list or through the vtkDataArray API otherwise.
+  SumWorker dispatchWorker;
+  if (!vtkArrayDispatch::Dispatch::Execute(constant.GetPointer(), dispatchWorker))
+  {
+    dispatchWorker(static_cast<vtkDataArray*>(constant));
+  }
+  if (dispatchWorker.Sum != 20 * 42.0)
+  {
+    std::cerr << "Dispatched sum is " << dispatchWorker.Sum << std::endl;
+    ++errors;
+  }
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,37 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAffineArray
+ * @brief   An implicit array whose values are an affine function of the index.
+ *
+ * Convenience alias for `vtkImplicitArray<vtkAffineImplicitBackend<T>>`. This is
+ * also the name used to add these arrays to the vtkArrayDispatch list with the
+ * VTK_DISPATCH_AFFINE_ARRAYS CMake option.
+ *
+ * @sa
+ * vtkImplicitArray vtkAffineImplicitBackend
+ */
+
+#ifndef vtkAffineArray_h
+#define vtkAffineArray_h
+
+#include "vtkAffineImplicitBackend.h"
+#include "vtkImplicitArray.h"
+
+template <typename T>
+using vtkAffineArray = vtkImplicitArray<vtkAffineImplicitBackend<T>>;
+
+#endif // vtkAffineArray_h
+// VTK-HeaderTest-Exclude: vtkAffineArray.h
@@ -0,0 +1,71 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineImplicitBackend.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAffineImplicitBackend
+ * @brief   A backend for vtkImplicitArray computing `Slope * index + Intercept`.
+ *
+ * The index is the value index in AOS ordering. This covers identifier arrays
+ * such as the ones generated by vtkIdFilter (slope 1, intercept 0) or any
+ * regularly spaced sequence:
+ *
+ * \code
+ * vtkNew<vtkAffineArray<vtkIdType>> ids;
+ * ids->ConstructBackend(1, 0);
+ * ids->SetNumberOfTuples(numberOfPoints);
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray vtkAffineArray
+ */
+
+#ifndef vtkAffineImplicitBackend_h
+#define vtkAffineImplicitBackend_h
+
+#include "vtkType.h" // For vtkIdType
+
+template <typename ValueType>
+struct vtkAffineImplicitBackend
+{
+  vtkAffineImplicitBackend()
+    : Slope(1)
+    , Intercept(0)
+  {
+  }
+
+  vtkAffineImplicitBackend(ValueType slope, ValueType intercept)
+    : Slope(slope)
+    , Intercept(intercept)
+  {
+  }
+
+  /**
+   * Return `Slope * valueIdx + Intercept`.
+   */
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    return static_cast<ValueType>(this->Slope * valueIdx + this->Intercept);
+  }
+
+  /**
+   * The backend is two values, report the smallest possible footprint.
+   */
+  unsigned long GetMemorySize() const { return 1; }
+
+  ValueType Slope;
+  ValueType Intercept;
+};
+
+#endif // vtkAffineImplicitBackend_h
+// VTK-HeaderTest-Exclude: vtkAffineImplicitBackend.h
@@ -0,0 +1,37 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompositeArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCompositeArray
+ * @brief   An implicit array concatenating several arrays.
+ *
+ * Convenience alias for `vtkImplicitArray<vtkCompositeImplicitBackend<T>>`. This is
+ * also the name used to add these arrays to the vtkArrayDispatch list with the
+ * VTK_DISPATCH_COMPOSITE_ARRAYS CMake option.
+ *
+ * @sa
+ * vtkImplicitArray vtkCompositeImplicitBackend
+ */
+
+#ifndef vtkCompositeArray_h
+#define vtkCompositeArray_h
+
+#include "vtkCompositeImplicitBackend.h"
+#include "vtkImplicitArray.h"
+
+template <typename T>
+using vtkCompositeArray = vtkImplicitArray<vtkCompositeImplicitBackend<T>>;
+
+#endif // vtkCompositeArray_h
+// VTK-HeaderTest-Exclude: vtkCompositeArray.h
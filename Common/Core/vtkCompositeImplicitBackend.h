@@ -0,0 +1,110 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompositeImplicitBackend.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCompositeImplicitBackend
+ * @brief   A backend for vtkImplicitArray concatenating several arrays.
+ *
+ * The values of the implicit array are the values of the given arrays, one
+ * after the other, without copying them. All arrays must have the same number
+ * of components, which should also be the number of components of the
+ * implicit array. The arrays are referenced by the backend and must not be
+ * modified while it is in use.
+ *
+ * \code
+ * vtkNew<vtkCompositeArray<float>> points;
+ * points->ConstructBackend(std::vector<vtkDataArray*>{ left, right });
+ * points->SetNumberOfComponents(3);
+ * points->SetNumberOfTuples(left->GetNumberOfTuples() + right->GetNumberOfTuples());
+ * \endcode
+ *
+ * Locating the array holding a value is a binary search over the arrays, so
+ * access is logarithmic in the number of arrays and constant in their size.
+ * A default constructed backend has no arrays and evaluates to zero.
+ *
+ * @sa
+ * vtkImplicitArray vtkCompositeArray
+ */
+
+#ifndef vtkCompositeImplicitBackend_h
+#define vtkCompositeImplicitBackend_h
+
+#include "vtkDataArray.h"
+#include "vtkImplicitArray.h" // For vtk::detail::ImplicitArraySourceReader
+#include "vtkSmartPointer.h"  // For vtkSmartPointer
+
+#include <algorithm> // For std::upper_bound
+#include <vector>    // For std::vector
+
+template <typename ValueType>
+class vtkCompositeImplicitBackend
+{
+public:
+  vtkCompositeImplicitBackend() = default;
+
+  explicit vtkCompositeImplicitBackend(const std::vector<vtkDataArray*>& arrays)
+  {
+    vtkIdType offset = 0;
+    for (vtkDataArray* array : arrays)
+    {
+      if (!array || array->GetNumberOfValues() == 0)
+      {
+        continue;
+      }
+      offset += array->GetNumberOfValues();
+      this->Arrays.emplace_back(array);
+      this->Readers.emplace_back(array);
+      this->Offsets.push_back(offset);
+    }
+  }
+
+  /**
+   * Return the value at @a valueIdx in the concatenation of the arrays.
+   */
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    const std::size_t arrayIdx = static_cast<std::size_t>(
+      std::upper_bound(this->Offsets.begin(), this->Offsets.end(), valueIdx) -
+      this->Offsets.begin());
+    if (arrayIdx >= this->Readers.size())
+    {
+      // default constructed backend, or index past the end
+      return ValueType(0);
+    }
+    const vtkIdType start = arrayIdx == 0 ? 0 : this->Offsets[arrayIdx - 1];
+    return this->Readers[arrayIdx](valueIdx - start);
+  }
+
+  /**
+   * The memory of the referenced arrays, in kibibytes.
+   */
+  unsigned long GetMemorySize() const
+  {
+    unsigned long size = 1;
+    for (const auto& array : this->Arrays)
+    {
+      size += array->GetActualMemorySize();
+    }
+    return size;
+  }
+
+private:
+  std::vector<vtkSmartPointer<vtkDataArray>> Arrays;
+  std::vector<vtk::detail::ImplicitArraySourceReader<ValueType>> Readers;
+  // Cumulated number of values at the end of each array.
+  std::vector<vtkIdType> Offsets;
+};
+
+#endif // vtkCompositeImplicitBackend_h
+// VTK-HeaderTest-Exclude: vtkCompositeImplicitBackend.h
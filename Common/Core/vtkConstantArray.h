@@ -0,0 +1,37 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConstantArray
+ * @brief   An implicit array holding the same value everywhere.
+ *
+ * Convenience alias for `vtkImplicitArray<vtkConstantImplicitBackend<T>>`. This is
+ * also the name used to add these arrays to the vtkArrayDispatch list with the
+ * VTK_DISPATCH_CONSTANT_ARRAYS CMake option.
+ *
+ * @sa
+ * vtkImplicitArray vtkConstantImplicitBackend
+ */
+
+#ifndef vtkConstantArray_h
+#define vtkConstantArray_h
+
+#include "vtkConstantImplicitBackend.h"
+#include "vtkImplicitArray.h"
+
+template <typename T>
+using vtkConstantArray = vtkImplicitArray<vtkConstantImplicitBackend<T>>;
+
+#endif // vtkConstantArray_h
+// VTK-HeaderTest-Exclude: vtkConstantArray.h
@@ -0,0 +1,66 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantImplicitBackend.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConstantImplicitBackend
+ * @brief   A backend for vtkImplicitArray returning the same value for every
+ * index.
+ *
+ * Typical uses are uniform cell type arrays or per-block identifiers, which
+ * then cost a single value instead of one value per element:
+ *
+ * \code
+ * vtkNew<vtkConstantArray<int>> blockIds;
+ * blockIds->ConstructBackend(42);
+ * blockIds->SetNumberOfTuples(numberOfCells);
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray vtkConstantArray
+ */
+
+#ifndef vtkConstantImplicitBackend_h
+#define vtkConstantImplicitBackend_h
+
+#include "vtkSetGet.h" // For vtkNotUsed
+#include "vtkType.h"   // For vtkIdType
+
+template <typename ValueType>
+struct vtkConstantImplicitBackend
+{
+  vtkConstantImplicitBackend()
+    : Value(0)
+  {
+  }
+
+  explicit vtkConstantImplicitBackend(ValueType value)
+    : Value(value)
+  {
+  }
+
+  /**
+   * Return the constant value, whatever the index.
+   */
+  ValueType operator()(vtkIdType vtkNotUsed(valueIdx)) const { return this->Value; }
+
+  /**
+   * The backend is a single value, report the smallest possible footprint.
+   */
+  unsigned long GetMemorySize() const { return 1; }
+
+  ValueType Value;
+};
+
+#endif // vtkConstantImplicitBackend_h
+// VTK-HeaderTest-Exclude: vtkConstantImplicitBackend.h
@@ -15,6 +15,14 @@
 #   Include vtkTypedDataArray<ValueType> for the basic types supported
 #   by VTK. This enables the old-style in-situ vtkMappedDataArray subclasses
 #   to be used.
+# - VTK_DISPATCH_AFFINE_ARRAYS (default: OFF)
+#   Include vtkAffineArray<ValueType> for the basic types supported by VTK.
+# - VTK_DISPATCH_CONSTANT_ARRAYS (default: OFF)
+#   Include vtkConstantArray<ValueType> for the basic types supported by VTK.
+# - VTK_DISPATCH_COMPOSITE_ARRAYS (default: OFF)
+#   Include vtkCompositeArray<ValueType> for the basic types supported by VTK.
+# - VTK_DISPATCH_INDEXED_ARRAYS (default: OFF)
+#   Include vtkIndexedArray<ValueType> for the basic types supported by VTK.
 #
 # At a lower level, specific arrays can be added to the list individually in
 # two ways:
@@ -146,6 +154,18 @@ if (VTK_DISPATCH_TYPED_ARRAYS)
   )
 endif()
 
+# Implicit arrays, see vtkImplicitArray.h:
+foreach (implicit_backend IN ITEMS Affine Constant Composite Indexed)
+  string(TOUPPER "${implicit_backend}" implicit_backend_upper)
+  if (VTK_DISPATCH_${implicit_backend_upper}_ARRAYS)
+    list(APPEND vtkArrayDispatch_containers vtk${implicit_backend}Array)
+    set(vtkArrayDispatch_vtk${implicit_backend}Array_header vtk${implicit_backend}Array.h)
+    set(vtkArrayDispatch_vtk${implicit_backend}Array_types
+      ${vtkArrayDispatch_all_types}
+    )
+  endif()
+endforeach()
+
 endmacro()
 
 # Concatenates a list of strings into a single string, since string(CONCAT ...)
@@ -0,0 +1,296 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImplicitArray
+ * @brief   A read only array class that wraps an implicit function from
+ * integers to any value type supported by VTK.
+ *
+ * vtkImplicitArray is a vtkGenericDataArray whose values are not stored in
+ * memory but computed on demand by a "backend" object. The backend is any
+ * copyable type providing a const call operator mapping a value index (in
+ * AOS ordering) to a value:
+ *
+ * \code
+ * struct MyBackend
+ * {
+ *   double operator()(vtkIdType valueIdx) const { return 0.5 * valueIdx; }
+ * };
+ * vtkNew<vtkImplicitArray<MyBackend>> array;
+ * array->SetNumberOfComponents(3);
+ * array->SetNumberOfTuples(100);
+ * \endcode
+ *
+ * The value type of the array is deduced from the return type of the call
+ * operator. A backend may optionally provide a `unsigned long GetMemorySize()
+ * const` method returning its footprint in kibibytes, which is then reported
+ * by GetActualMemorySize().
+ *
+ * VTK provides the following backends, each with a convenience alias:
+ * - vtkConstantImplicitBackend / vtkConstantArray: the same value everywhere
+ * - vtkAffineImplicitBackend / vtkAffineArray: slope * index + intercept
+ * - vtkCompositeImplicitBackend / vtkCompositeArray: concatenation of arrays
+ * - vtkIndexedImplicitBackend / vtkIndexedArray: indirection through an id list
+ *
+ * Implicit arrays are read only: the setters are no-ops and NewInstance()
+ * returns an AOS array of the same value type, so that pipelines copying
+ * tuples out of an implicit array produce an explicit, writable array.
+ * GetVoidPointer() is supported but materializes the whole array in an
+ * internal cache, which defeats the purpose of the class; prefer the
+ * vtkArrayDispatch / vtkDataArrayRange API. Implicit arrays can be added to
+ * the dispatch list through the VTK_DISPATCH_*_ARRAYS CMake options.
+ *
+ * @sa
+ * vtkGenericDataArray vtkConstantArray vtkAffineArray vtkCompositeArray
+ * vtkIndexedArray
+ */
+
+#ifndef vtkImplicitArray_h
+#define vtkImplicitArray_h
+
+#include "vtkAOSDataArrayTemplate.h" // For the GetVoidPointer cache
+#include "vtkCommonCoreModule.h"     // For export macro
+#include "vtkGenericDataArray.h"
+#include "vtkObjectFactory.h" // For VTK_STANDARD_NEW_BODY
+#include "vtkSmartPointer.h"  // For the GetVoidPointer cache
+
+#include <memory>      // For std::shared_ptr
+#include <type_traits> // For std::decay
+#include <utility>     // For std::declval
+
+namespace vtk
+{
+namespace detail
+{
+/**
+ * Value type of an implicit array, deduced from the backend call operator.
+ */
+template <typename BackendT>
+struct ImplicitArrayValueType
+{
+  typedef typename std::decay<decltype(std::declval<const BackendT&>()(vtkIdType(0)))>::type Type;
+};
+
+/**
+ * Detects whether a backend reports its own memory footprint.
+ */
+template <typename BackendT, typename = void>
+struct ImplicitBackendHasMemorySize : std::false_type
+{
+};
+
+template <typename BackendT>
+struct ImplicitBackendHasMemorySize<BackendT,
+  decltype(void(std::declval<const BackendT&>().GetMemorySize()))> : std::true_type
+{
+};
+
+/**
+ * Read only access to the values of any vtkDataArray as @a ValueType, used by
+ * the backends wrapping other arrays. Arrays that are already AOS arrays of
+ * @a ValueType are read directly, the others go through the vtkDataArray API.
+ * A reader without array returns zero.
+ */
+template <typename ValueType>
+class ImplicitArraySourceReader
+{
+public:
+  ImplicitArraySourceReader()
+    : Array(nullptr)
+    , AOSArray(nullptr)
+    , NumberOfComponents(1)
+  {
+  }
+
+  explicit ImplicitArraySourceReader(vtkDataArray* array)
+    : Array(array)
+    , AOSArray(vtkAOSDataArrayTemplate<ValueType>::FastDownCast(array))
+    , NumberOfComponents(array ? array->GetNumberOfComponents() : 1)
+  {
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    if (!this->Array)
+    {
+      return ValueType(0);
+    }
+    if (this->AOSArray)
+    {
+      return this->AOSArray->GetValue(valueIdx);
+    }
+    return static_cast<ValueType>(this->Array->GetComponent(
+      valueIdx / this->NumberOfComponents, static_cast<int>(valueIdx % this->NumberOfComponents)));
+  }
+
+private:
+  vtkDataArray* Array;
+  vtkAOSDataArrayTemplate<ValueType>* AOSArray;
+  int NumberOfComponents;
+};
+} // end namespace detail
+} // end namespace vtk
+
+template <class BackendT>
+class vtkImplicitArray
+  : public vtkGenericDataArray<vtkImplicitArray<BackendT>,
+      typename vtk::detail::ImplicitArrayValueType<BackendT>::Type>
+{
+  typedef typename vtk::detail::ImplicitArrayValueType<BackendT>::Type ValueTypeT;
+  typedef vtkGenericDataArray<vtkImplicitArray<BackendT>, ValueTypeT> GenericDataArrayType;
+
+public:
+  typedef vtkImplicitArray<BackendT> SelfType;
+  vtkAbstractTypeMacroWithNewInstanceType(SelfType, GenericDataArrayType,
+    vtkAOSDataArrayTemplate<ValueTypeT>, typeid(SelfType).name());
+  vtkAOSArrayNewInstanceMacro(SelfType);
+  typedef typename Superclass::ValueType ValueType;
+  typedef BackendT BackendType;
+
+  static vtkImplicitArray* New();
+
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Get the value at @a valueIdx. @a valueIdx assumes AOS ordering.
+   */
+  inline ValueType GetValue(vtkIdType valueIdx) const { return (*this->Backend)(valueIdx); }
+
+  /**
+   * Implicit arrays are read only, this is a no-op.
+   */
+  void SetValue(vtkIdType vtkNotUsed(valueIdx), ValueType vtkNotUsed(value)) {}
+
+  /**
+   * Copy the tuple at @a tupleIdx into @a tuple.
+   */
+  inline void GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const
+  {
+    const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+      tuple[comp] = this->GetValue(valueIdx + comp);
+    }
+  }
+
+  /**
+   * Implicit arrays are read only, this is a no-op.
+   */
+  void SetTypedTuple(vtkIdType vtkNotUsed(tupleIdx), const ValueType* vtkNotUsed(tuple)) {}
+
+  /**
+   * Get component @a comp of the tuple at @a tupleIdx.
+   */
+  inline ValueType GetTypedComponent(vtkIdType tupleIdx, int comp) const
+  {
+    return this->GetValue(tupleIdx * this->NumberOfComponents + comp);
+  }
+
+  /**
+   * Implicit arrays are read only, this is a no-op.
+   */
+  void SetTypedComponent(
+    vtkIdType vtkNotUsed(tupleIdx), int vtkNotUsed(comp), ValueType vtkNotUsed(value))
+  {
+  }
+
+  ///@{
+  /**
+   * Set/Get the backend computing the values of this array. The backend is
+   * shared, so several arrays may point to the same one.
+   */
+  void SetBackend(std::shared_ptr<BackendT> backend);
+  std::shared_ptr<BackendT> GetBackend() const { return this->Backend; }
+  ///@}
+
+  /**
+   * Construct a new backend in place from @a params and use it.
+   */
+  template <typename... Params>
+  void ConstructBackend(Params&&... params)
+  {
+    this->SetBackend(std::make_shared<BackendT>(std::forward<Params>(params)...));
+  }
+
+  /**
+   * Materialize the array into an internal AOS buffer and return a pointer
+   * into it. This is expensive and should be avoided, see the class
+   * documentation. The buffer is released by Squeeze() and Initialize().
+   */
+  void* GetVoidPointer(vtkIdType valueIdx) override;
+
+  /**
+   * Write the values of the array in AOS ordering to the preallocated memory
+   * buffer, without going through the GetVoidPointer() cache.
+   */
+  void ExportToVoidPointer(void* ptr) override;
+
+  /**
+   * Release the buffer allocated by GetVoidPointer(), if any.
+   */
+  void Squeeze() override;
+
+  /**
+   * Reset the array to an empty state. The backend is replaced by a default
+   * constructed one, which releases whatever the previous backend referenced,
+   * unless the backend type cannot be default constructed.
+   */
+  void Initialize() override;
+
+  ///@{
+  /**
+   * Implicit arrays can only be deep copied from an implicit array with the
+   * same backend type, in which case the backend is shared. Copying from any
+   * other array is an error, since the values cannot be stored.
+   */
+  void DeepCopy(vtkAbstractArray* other) override;
+  void DeepCopy(vtkDataArray* other) override;
+  ///@}
+
+  /**
+   * Return the memory used by the backend in kibibytes, not the size the
+   * array would take if it was explicit.
+   */
+  unsigned long GetActualMemorySize() const override;
+
+  int GetArrayType() const override { return vtkAbstractArray::ImplicitArray; }
+
+protected:
+  vtkImplicitArray();
+  ~vtkImplicitArray() override;
+
+  ///@{
+  /**
+   * Nothing is allocated for implicit arrays, only the number of tuples is
+   * recorded by the superclass.
+   */
+  bool AllocateTuples(vtkIdType vtkNotUsed(numTuples)) { return true; }
+  bool ReallocateTuples(vtkIdType vtkNotUsed(numTuples)) { return true; }
+  ///@}
+
+  std::shared_ptr<BackendT> Backend;
+
+private:
+  vtkImplicitArray(const vtkImplicitArray&) = delete;
+  void operator=(const vtkImplicitArray&) = delete;
+
+  vtkSmartPointer<vtkAOSDataArrayTemplate<ValueType>> Cache;
+
+  friend class vtkGenericDataArray<vtkImplicitArray<BackendT>, ValueTypeT>;
+};
+
+#include "vtkImplicitArray.txx"
+
+#endif // vtkImplicitArray_h
+// VTK-HeaderTest-Exclude: vtkImplicitArray.h
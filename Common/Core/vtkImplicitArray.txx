@@ -0,0 +1,227 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkImplicitArray_txx
+#define vtkImplicitArray_txx
+
+#include "vtkImplicitArray.h"
+
+namespace vtk
+{
+namespace detail
+{
+//-----------------------------------------------------------------------------
+// Backends that can be default constructed are created along with the array,
+// the others have to be provided through SetBackend/ConstructBackend.
+template <typename BackendT>
+std::shared_ptr<BackendT> MakeDefaultImplicitBackend(std::true_type)
+{
+  return std::make_shared<BackendT>();
+}
+
+template <typename BackendT>
+std::shared_ptr<BackendT> MakeDefaultImplicitBackend(std::false_type)
+{
+  return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+template <typename BackendT>
+unsigned long GetImplicitBackendMemorySize(const BackendT& backend, std::true_type)
+{
+  return backend.GetMemorySize();
+}
+
+template <typename BackendT>
+unsigned long GetImplicitBackendMemorySize(const BackendT&, std::false_type)
+{
+  // Round up to the next kibibyte, like vtkDataArray::GetActualMemorySize.
+  return static_cast<unsigned long>((sizeof(BackendT) + 1023) / 1024);
+}
+} // end namespace detail
+} // end namespace vtk
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>* vtkImplicitArray<BackendT>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkImplicitArray<BackendT>);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::vtkImplicitArray()
+  : Backend(vtk::detail::MakeDefaultImplicitBackend<BackendT>(
+      typename std::is_default_constructible<BackendT>::type()))
+{
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::~vtkImplicitArray() = default;
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Backend: " << this->Backend.get() << "\n";
+  os << indent << "Cache: " << this->Cache.GetPointer() << "\n";
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::SetBackend(std::shared_ptr<BackendT> backend)
+{
+  if (this->Backend == backend)
+  {
+    return;
+  }
+  this->Backend = backend;
+  this->Cache = nullptr;
+  this->Modified();
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void* vtkImplicitArray<BackendT>::GetVoidPointer(vtkIdType valueIdx)
+{
+  if (!this->Backend)
+  {
+    vtkErrorMacro(<< "No backend set, cannot generate the array values.");
+    return nullptr;
+  }
+
+  // Allow warnings to be silenced, like vtkSOADataArrayTemplate does:
+  const char* silence = getenv("VTK_SILENCE_GET_VOID_POINTER_WARNINGS");
+  if (!silence)
+  {
+    vtkWarningMacro(<< "GetVoidPointer called. This is very expensive for "
+                       "implicit arrays, as the whole array must be "
+                       "materialized in memory. Using the vtkGenericDataArray "
+                       "API with vtkArrayDispatch is preferred. Define the "
+                       "environment variable VTK_SILENCE_GET_VOID_POINTER_WARNINGS "
+                       "to silence this warning.");
+  }
+
+  // Only regenerate the cache when the array changed since the last call.
+  if (!this->Cache || this->Cache->GetMTime() < this->GetMTime() ||
+    this->Cache->GetNumberOfValues() != this->GetNumberOfValues())
+  {
+    if (!this->Cache)
+    {
+      this->Cache = vtkSmartPointer<vtkAOSDataArrayTemplate<ValueType>>::New();
+    }
+    this->Cache->SetNumberOfComponents(this->NumberOfComponents);
+    this->Cache->SetNumberOfTuples(this->GetNumberOfTuples());
+    this->ExportToVoidPointer(this->Cache->GetPointer(0));
+    this->Cache->Modified();
+  }
+
+  return this->Cache->GetVoidPointer(valueIdx);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::ExportToVoidPointer(void* ptr)
+{
+  const vtkIdType numValues = this->GetNumberOfValues();
+  if (numValues == 0)
+  {
+    return;
+  }
+
+  if (!ptr)
+  {
+    vtkErrorMacro(<< "Buffer is nullptr.");
+    return;
+  }
+
+  ValueType* values = static_cast<ValueType*>(ptr);
+  for (vtkIdType idx = 0; idx < numValues; ++idx)
+  {
+    values[idx] = this->GetValue(idx);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::Squeeze()
+{
+  this->Superclass::Squeeze();
+  this->Cache = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::Initialize()
+{
+  this->Superclass::Initialize();
+  // Backends that cannot be default constructed are kept, otherwise the array
+  // could not be evaluated anymore.
+  std::shared_ptr<BackendT> backend = vtk::detail::MakeDefaultImplicitBackend<BackendT>(
+    typename std::is_default_constructible<BackendT>::type());
+  if (backend)
+  {
+    this->Backend = backend;
+  }
+  this->Cache = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::DeepCopy(vtkAbstractArray* other)
+{
+  this->DeepCopy(vtkDataArray::FastDownCast(other));
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::DeepCopy(vtkDataArray* other)
+{
+  if (other == nullptr || other == this)
+  {
+    return;
+  }
+
+  SelfType* implicit = dynamic_cast<SelfType*>(other);
+  if (!implicit)
+  {
+    vtkErrorMacro(<< "Cannot copy the values of a " << other->GetClassName()
+                  << " into a read only implicit array.");
+    return;
+  }
+
+  this->SetNumberOfComponents(implicit->GetNumberOfComponents());
+  this->SetNumberOfTuples(implicit->GetNumberOfTuples());
+  this->SetBackend(implicit->Backend);
+  // Copy the name, information and component names.
+  this->vtkAbstractArray::DeepCopy(other);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+unsigned long vtkImplicitArray<BackendT>::GetActualMemorySize() const
+{
+  unsigned long size = this->Cache ? this->Cache->GetActualMemorySize() : 0;
+  if (this->Backend)
+  {
+    size += vtk::detail::GetImplicitBackendMemorySize(
+      *this->Backend, vtk::detail::ImplicitBackendHasMemorySize<BackendT>());
+  }
+  return size;
+}
+
+#endif // vtkImplicitArray_txx
@@ -0,0 +1,37 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkIndexedArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkIndexedArray
+ * @brief   An implicit array indexing into another array.
+ *
+ * Convenience alias for `vtkImplicitArray<vtkIndexedImplicitBackend<T>>`. This is
+ * also the name used to add these arrays to the vtkArrayDispatch list with the
+ * VTK_DISPATCH_INDEXED_ARRAYS CMake option.
+ *
+ * @sa
+ * vtkImplicitArray vtkIndexedImplicitBackend
+ */
+
+#ifndef vtkIndexedArray_h
+#define vtkIndexedArray_h
+
+#include "vtkIndexedImplicitBackend.h"
+#include "vtkImplicitArray.h"
+
+template <typename T>
+using vtkIndexedArray = vtkImplicitArray<vtkIndexedImplicitBackend<T>>;
+
+#endif // vtkIndexedArray_h
+// VTK-HeaderTest-Exclude: vtkIndexedArray.h
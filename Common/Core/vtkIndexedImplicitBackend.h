@@ -0,0 +1,117 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkIndexedImplicitBackend.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkIndexedImplicitBackend
+ * @brief   A backend for vtkImplicitArray indexing into another array.
+ *
+ * Tuple `i` of the implicit array is tuple `Indexes[i]` of the wrapped array.
+ * This allows subsetting, permuting or repeating the tuples of an array
+ * without copying them, for instance when extracting a subset of cells. The
+ * indexes can be given as a vtkIdList or as a single component vtkDataArray.
+ * The implicit array must have the number of components of the wrapped array
+ * and as many tuples as there are indexes. The arrays are referenced by the
+ * backend and must not be modified while it is in use. A default constructed
+ * backend has no arrays and evaluates to zero.
+ *
+ * \code
+ * vtkNew<vtkIndexedArray<double>> subset;
+ * subset->ConstructBackend(ids, array);
+ * subset->SetNumberOfComponents(array->GetNumberOfComponents());
+ * subset->SetNumberOfTuples(ids->GetNumberOfIds());
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray vtkIndexedArray
+ */
+
+#ifndef vtkIndexedImplicitBackend_h
+#define vtkIndexedImplicitBackend_h
+
+#include "vtkDataArray.h"
+#include "vtkIdList.h"        // For vtkIdList
+#include "vtkIdTypeArray.h"   // For wrapping vtkIdList
+#include "vtkImplicitArray.h" // For vtk::detail::ImplicitArraySourceReader
+#include "vtkNew.h"           // For vtkNew
+#include "vtkSmartPointer.h"  // For vtkSmartPointer
+
+template <typename ValueType>
+class vtkIndexedImplicitBackend
+{
+public:
+  vtkIndexedImplicitBackend() = default;
+
+  vtkIndexedImplicitBackend(vtkIdList* indexes, vtkDataArray* array)
+    : IdList(indexes)
+  {
+    // Wrap the id list without copying it, the list is kept alive by IdList.
+    vtkNew<vtkIdTypeArray> wrapper;
+    if (indexes && indexes->GetNumberOfIds() > 0)
+    {
+      wrapper->SetArray(indexes->GetPointer(0), indexes->GetNumberOfIds(), /*save=*/1);
+    }
+    this->Initialize(wrapper, array);
+  }
+
+  vtkIndexedImplicitBackend(vtkDataArray* indexes, vtkDataArray* array)
+  {
+    this->Initialize(indexes, array);
+  }
+
+  /**
+   * Return component `valueIdx % NumberOfComponents` of the tuple
+   * `Indexes[valueIdx / NumberOfComponents]` of the wrapped array.
+   */
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    if (this->NumberOfComponents == 1)
+    {
+      return this->ArrayReader(this->IndexesReader(valueIdx));
+    }
+    const vtkIdType tupleIdx = valueIdx / this->NumberOfComponents;
+    const vtkIdType comp = valueIdx % this->NumberOfComponents;
+    return this->ArrayReader(this->IndexesReader(tupleIdx) * this->NumberOfComponents + comp);
+  }
+
+  /**
+   * The memory of the referenced arrays, in kibibytes.
+   */
+  unsigned long GetMemorySize() const
+  {
+    unsigned long size = 1;
+    size += this->Indexes ? this->Indexes->GetActualMemorySize() : 0;
+    size += this->Array ? this->Array->GetActualMemorySize() : 0;
+    return size;
+  }
+
+private:
+  void Initialize(vtkDataArray* indexes, vtkDataArray* array)
+  {
+    this->Indexes = indexes;
+    this->Array = array;
+    this->IndexesReader = vtk::detail::ImplicitArraySourceReader<vtkIdType>(indexes);
+    this->ArrayReader = vtk::detail::ImplicitArraySourceReader<ValueType>(array);
+    this->NumberOfComponents = array ? array->GetNumberOfComponents() : 1;
+  }
+
+  vtkSmartPointer<vtkIdList> IdList;
+  vtkSmartPointer<vtkDataArray> Indexes;
+  vtkSmartPointer<vtkDataArray> Array;
+  vtk::detail::ImplicitArraySourceReader<vtkIdType> IndexesReader;
+  vtk::detail::ImplicitArraySourceReader<ValueType> ArrayReader;
+  int NumberOfComponents = 1;
+};
+
+#endif // vtkIndexedImplicitBackend_h
+// VTK-HeaderTest-Exclude: vtkIndexedImplicitBackend.h
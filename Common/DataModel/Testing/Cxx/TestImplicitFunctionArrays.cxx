@@ -0,0 +1,169 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitFunctionArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Evaluate implicit functions over arrays of points, and check that the
+// values match the ones computed one point at a time.
+
+#include "vtkBox.h"
+#include "vtkCylinder.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImplicitBoolean.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPlanes.h"
+#include "vtkQuadric.h"
+#include "vtkSphere.h"
+#include "vtkTransform.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// Compare the array and point versions of the function, with single and
+// double precision points and values.
+template <typename PointsArrayType, typename ValuesArrayType>
+bool TestFunction(const char* name, vtkImplicitFunction* function)
+{
+  const int dim = 21;
+  vtkNew<PointsArrayType> points;
+  points->SetNumberOfComponents(3);
+  points->SetNumberOfTuples(dim * dim * dim);
+  vtkIdType ptId = 0;
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i, ++ptId)
+      {
+        points->SetTypedComponent(ptId, 0, -1.0 + 0.1 * i);
+        points->SetTypedComponent(ptId, 1, -1.0 + 0.1 * j);
+        points->SetTypedComponent(ptId, 2, -1.0 + 0.1 * k);
+      }
+    }
+  }
+
+  // The output array is resized by the function.
+  vtkNew<ValuesArrayType> values;
+  function->FunctionValue(points, values);
+  if (values->GetNumberOfComponents() != 1 ||
+    values->GetNumberOfTuples() != points->GetNumberOfTuples())
+  {
+    std::cerr << name << ": wrong size of the values array" << std::endl;
+    return false;
+  }
+
+  for (ptId = 0; ptId < points->GetNumberOfTuples(); ++ptId)
+  {
+    double x[3];
+    points->GetTuple(ptId, x);
+    const double expected =
+      static_cast<double>(static_cast<typename ValuesArrayType::ValueType>(function->FunctionValue(x)));
+    const double value = values->GetValue(ptId);
+    if (std::abs(value - expected) > 1e-6 * (1.0 + std::abs(expected)))
+    {
+      std::cerr << name << ": value " << value << " instead of " << expected << " at ("
+                << x[0] << ", " << x[1] << ", " << x[2] << ")" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestFunction(const char* name, vtkImplicitFunction* function)
+{
+  return TestFunction<vtkFloatArray, vtkDoubleArray>(name, function) &&
+    TestFunction<vtkDoubleArray, vtkDoubleArray>(name, function) &&
+    TestFunction<vtkDoubleArray, vtkFloatArray>(name, function);
+}
+}
+
+int TestImplicitFunctionArrays(int, char*[])
+{
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.1, 0.2, 0.3);
+  plane->SetNormal(1.0, 2.0, 3.0);
+
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(0.1, -0.2, 0.3);
+  sphere->SetRadius(0.6);
+
+  vtkNew<vtkBox> box;
+  box->SetBounds(-0.5, 0.4, -0.3, 0.6, -0.2, 0.25);
+
+  // A flat box takes another path in the box equation.
+  vtkNew<vtkBox> flatBox;
+  flatBox->SetBounds(-0.5, 0.4, 0.2, 0.2, -0.2, 0.25);
+
+  vtkNew<vtkCylinder> cylinder;
+  cylinder->SetCenter(0.1, 0.2, -0.1);
+  cylinder->SetAxis(1.0, 1.0, 0.0);
+  cylinder->SetRadius(0.4);
+
+  vtkNew<vtkPlanes> planes;
+  planes->SetBounds(-0.6, 0.5, -0.4, 0.7, -0.3, 0.2);
+
+  vtkNew<vtkQuadric> quadric;
+  quadric->SetCoefficients(1.0, 2.0, 3.0, 0.5, 0.0, 0.0, 0.1, 0.2, 0.3, -0.4);
+
+  // Transforms are applied through the point version of the function.
+  vtkNew<vtkTransform> transform;
+  transform->RotateZ(30.0);
+  transform->Translate(0.2, 0.0, -0.1);
+  vtkNew<vtkSphere> transformedSphere;
+  transformedSphere->SetRadius(0.3);
+  transformedSphere->SetTransform(transform);
+
+  if (!TestFunction("vtkPlane", plane) || !TestFunction("vtkSphere", sphere) ||
+    !TestFunction("vtkBox", box) || !TestFunction("flat vtkBox", flatBox) ||
+    !TestFunction("vtkCylinder", cylinder) || !TestFunction("vtkPlanes", planes) ||
+    !TestFunction("vtkQuadric", quadric) || !TestFunction("transformed vtkSphere", transformedSphere))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkImplicitBoolean> boolean;
+  if (!TestFunction("empty vtkImplicitBoolean", boolean))
+  {
+    return EXIT_FAILURE;
+  }
+  boolean->AddFunction(sphere);
+  boolean->AddFunction(box);
+  boolean->AddFunction(transformedSphere);
+  boolean->AddFunction(quadric);
+  const char* operations[] = { "union", "intersection", "difference", "union of magnitudes" };
+  for (int operation = vtkImplicitBoolean::VTK_UNION;
+       operation <= vtkImplicitBoolean::VTK_UNION_OF_MAGNITUDES; ++operation)
+  {
+    boolean->SetOperationType(operation);
+    if (!TestFunction(operations[operation], boolean))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A transformed boolean of booleans.
+  vtkNew<vtkImplicitBoolean> nested;
+  nested->SetOperationTypeToDifference();
+  nested->AddFunction(boolean);
+  nested->AddFunction(cylinder);
+  nested->SetTransform(transform);
+  if (!TestFunction("nested vtkImplicitBoolean", nested))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -13,13 +13,17 @@
 
 =========================================================================*/
 #include "vtkBox.h"
+#include "vtkArrayDispatch.h"
 #include "vtkBoundingBox.h"
+#include "vtkDataArrayRange.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm> // for sorting
 #include <cassert>
+#include <cmath>
 #include <limits> // for IntersectWithInfiniteLine
 #include <vector> // for IntersectWithPlane
 
@@ -187,6 +191,90 @@ double vtkBox::EvaluateFunction(double x[3])
   }
 }
 
+//------------------------------------------------------------------------------
+// Evaluate the box equation over arrays of points.
+namespace
+{
+struct BoxFunctionWorker
+{
+  double MinPoint[3];
+  double MaxPoint[3];
+  double Length[3];
+
+  // Accumulate the contribution of one axis, exactly as EvaluateFunction()
+  // does, but without early exits so that the loop can be if-converted.
+  static void AddAxis(double x, double minP, double maxP, double length, bool& inside,
+    double& minDistance, double& distance)
+  {
+    double dist;
+    if (length != 0.0)
+    {
+      const double t = (x - minP) / length;
+      dist = t <= 0.5 ? minP - x : x - maxP;
+      if (t < 0.0 || t > 1.0)
+      {
+        inside = false;
+      }
+      else if (dist > minDistance)
+      {
+        minDistance = dist;
+      }
+    }
+    else
+    {
+      dist = std::abs(x - minP);
+      inside = inside && dist <= 0.0;
+    }
+    distance += dist > 0.0 ? dist * dist : 0.0;
+  }
+
+  template <typename InputArrayType, typename OutputArrayType>
+  void operator()(InputArrayType* input, OutputArrayType* output)
+  {
+    VTK_ASSUME(input->GetNumberOfComponents() == 3);
+    VTK_ASSUME(output->GetNumberOfComponents() == 1);
+    using OutputValueType = vtk::GetAPIType<OutputArrayType>;
+    const double* minP = this->MinPoint;
+    const double* maxP = this->MaxPoint;
+    const double* length = this->Length;
+
+    vtkSMPTools::For(0, input->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      const auto srcTuples = vtk::DataArrayTupleRange<3>(input, begin, end);
+      auto dstValues = vtk::DataArrayValueRange<1>(output, begin, end);
+      auto dst = dstValues.begin();
+      for (const auto x : srcTuples)
+      {
+        bool inside = true;
+        double minDistance = -VTK_DOUBLE_MAX, distance = 0.0;
+        for (int i = 0; i < 3; ++i)
+        {
+          AddAxis(static_cast<double>(x[i]), minP[i], maxP[i], length[i], inside, minDistance,
+            distance);
+        }
+        *dst++ = static_cast<OutputValueType>(inside ? minDistance : std::sqrt(distance));
+      }
+    });
+  }
+};
+} // anonymous namespace
+
+void vtkBox::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
+{
+  output->SetNumberOfComponents(1);
+  output->SetNumberOfTuples(input->GetNumberOfTuples());
+
+  BoxFunctionWorker worker;
+  std::copy_n(this->BBox->GetMinPoint(), 3, worker.MinPoint);
+  std::copy_n(this->BBox->GetMaxPoint(), 3, worker.MaxPoint);
+  this->BBox->GetLengths(worker.Length);
+  using Dispatcher = vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::Reals,
+    vtkArrayDispatch::Reals>;
+  if (!Dispatcher::Execute(input, output, worker))
+  {
+    worker(input, output); // Use vtkDataArray API if dispatch fails.
+  }
+}
+
 //------------------------------------------------------------------------------
 // Evaluate box gradient.
 void vtkBox::EvaluateGradient(double x[3], double n[3])
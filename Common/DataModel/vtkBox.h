@@ -46,11 +46,15 @@ public:
    */
   static vtkBox* New();
 
+  ///@{
   /**
-   * Evaluate box defined by the two points (pMin,pMax).
+   * Evaluate box defined by the two points (pMin,pMax). The array version
+   * evaluates all the points in parallel.
    */
   using vtkImplicitFunction::EvaluateFunction;
+  void EvaluateFunction(vtkDataArray* input, vtkDataArray* output) override;
   double EvaluateFunction(double x[3]) override;
+  ///@}
 
   /**
    * Evaluate the gradient of the box.
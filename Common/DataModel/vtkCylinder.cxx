@@ -13,8 +13,13 @@
 
 =========================================================================*/
 #include "vtkCylinder.h"
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
 
 vtkStandardNewMacro(vtkCylinder);
 
@@ -48,6 +53,60 @@ double vtkCylinder::EvaluateFunction(double x[3])
   return ((vtkMath::Dot(x2C, x2C) - proj * proj) - this->Radius * this->Radius);
 }
 
+//------------------------------------------------------------------------------
+// Evaluate the cylinder equation over arrays of points.
+namespace
+{
+struct CylinderFunctionWorker
+{
+  double Center[3];
+  double Axis[3];
+  double Radius2;
+
+  template <typename InputArrayType, typename OutputArrayType>
+  void operator()(InputArrayType* input, OutputArrayType* output)
+  {
+    VTK_ASSUME(input->GetNumberOfComponents() == 3);
+    VTK_ASSUME(output->GetNumberOfComponents() == 1);
+    using OutputValueType = vtk::GetAPIType<OutputArrayType>;
+    const double c0 = this->Center[0], c1 = this->Center[1], c2 = this->Center[2];
+    const double a0 = this->Axis[0], a1 = this->Axis[1], a2 = this->Axis[2];
+    const double r2 = this->Radius2;
+
+    vtkSMPTools::For(0, input->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      const auto srcTuples = vtk::DataArrayTupleRange<3>(input, begin, end);
+      auto dstValues = vtk::DataArrayValueRange<1>(output, begin, end);
+      auto dst = dstValues.begin();
+      for (const auto x : srcTuples)
+      {
+        const double d0 = static_cast<double>(x[0]) - c0;
+        const double d1 = static_cast<double>(x[1]) - c1;
+        const double d2 = static_cast<double>(x[2]) - c2;
+        const double proj = a0 * d0 + a1 * d1 + a2 * d2;
+        *dst++ = static_cast<OutputValueType>(((d0 * d0 + d1 * d1 + d2 * d2) - proj * proj) - r2);
+      }
+    });
+  }
+};
+} // anonymous namespace
+
+void vtkCylinder::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
+{
+  output->SetNumberOfComponents(1);
+  output->SetNumberOfTuples(input->GetNumberOfTuples());
+
+  CylinderFunctionWorker worker;
+  std::copy_n(this->Center, 3, worker.Center);
+  std::copy_n(this->Axis, 3, worker.Axis);
+  worker.Radius2 = this->Radius * this->Radius;
+  using Dispatcher = vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::Reals,
+    vtkArrayDispatch::Reals>;
+  if (!Dispatcher::Execute(input, output, worker))
+  {
+    worker(input, output); // Use vtkDataArray API if dispatch fails.
+  }
+}
+
 //------------------------------------------------------------------------------
 // Evaluate cylinder function gradient (along potentially oriented axis). The
 // gradient is always in the radial direction, and thus must be projected
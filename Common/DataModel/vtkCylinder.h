@@ -55,9 +55,11 @@ public:
 
   ///@{
   /**
-   * Evaluate cylinder equation F(r) = r^2 - Radius^2.
+   * Evaluate cylinder equation F(r) = r^2 - Radius^2. The array version
+   * evaluates all the points in parallel.
    */
   using vtkImplicitFunction::EvaluateFunction;
+  void EvaluateFunction(vtkDataArray* input, vtkDataArray* output) override;
   double EvaluateFunction(double x[3]) override;
   ///@}
 
@@ -14,9 +14,14 @@
 =========================================================================*/
 #include "vtkImplicitBoolean.h"
 
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
 #include "vtkImplicitFunctionCollection.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 
+#include <algorithm>
 #include <cmath>
 
 vtkStandardNewMacro(vtkImplicitBoolean);
@@ -146,6 +151,100 @@ double vtkImplicitBoolean::EvaluateFunction(double x[3])
   return value;
 }
 
+namespace
+{
+// Combine the values of one more function with the values accumulated so
+// far. Both arrays have the same type, and rounding commutes with the min,
+// max and absolute value, so the result is the same as the point version.
+struct BooleanCombineWorker
+{
+  int OperationType;
+  bool First;
+
+  template <typename ValuesArrayType, typename FunctionArrayType>
+  void operator()(ValuesArrayType* values, FunctionArrayType* functionValues)
+  {
+    using ValueType = vtk::GetAPIType<ValuesArrayType>;
+    const int operation = this->OperationType;
+    const bool first = this->First;
+
+    vtkSMPTools::For(0, values->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      auto dst = vtk::DataArrayValueRange<1>(values, begin, end);
+      const auto src = vtk::DataArrayValueRange<1>(functionValues, begin, end);
+      switch (operation)
+      {
+        case vtkImplicitBoolean::VTK_UNION:
+          std::transform(dst.cbegin(), dst.cend(), src.cbegin(), dst.begin(),
+            [](ValueType a, ValueType b) -> ValueType { return b < a ? b : a; });
+          break;
+        case vtkImplicitBoolean::VTK_INTERSECTION:
+          std::transform(dst.cbegin(), dst.cend(), src.cbegin(), dst.begin(),
+            [](ValueType a, ValueType b) -> ValueType { return b > a ? b : a; });
+          break;
+        case vtkImplicitBoolean::VTK_UNION_OF_MAGNITUDES:
+          if (first)
+          {
+            std::transform(src.cbegin(), src.cend(), dst.begin(),
+              [](ValueType b) -> ValueType { return std::abs(b); });
+          }
+          else
+          {
+            std::transform(dst.cbegin(), dst.cend(), src.cbegin(), dst.begin(),
+              [](ValueType a, ValueType b) -> ValueType {
+                return std::abs(b) < a ? static_cast<ValueType>(std::abs(b)) : a;
+              });
+          }
+          break;
+        default: // difference
+          std::transform(dst.cbegin(), dst.cend(), src.cbegin(), dst.begin(),
+            [](ValueType a, ValueType b) -> ValueType { return -b > a ? -b : a; });
+      }
+    });
+  }
+};
+} // anonymous namespace
+
+// Evaluate boolean combinations over arrays of points. Each function is
+// evaluated with its own array version, which handles its transform.
+void vtkImplicitBoolean::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
+{
+  output->SetNumberOfComponents(1);
+  output->SetNumberOfTuples(input->GetNumberOfTuples());
+
+  vtkCollectionSimpleIterator sit;
+  this->FunctionList->InitTraversal(sit);
+  vtkImplicitFunction* f = this->FunctionList->GetNextImplicitFunction(sit);
+  if (!f)
+  {
+    output->Fill(0.0);
+    return;
+  }
+  f->FunctionValue(input, output);
+
+  BooleanCombineWorker worker;
+  worker.OperationType = this->OperationType;
+  worker.First = true;
+  using Dispatcher = vtkArrayDispatch::Dispatch2BySameValueType<vtkArrayDispatch::Reals>;
+  if (this->OperationType == VTK_UNION_OF_MAGNITUDES)
+  {
+    if (!Dispatcher::Execute(output, output, worker))
+    {
+      worker(output, output);
+    }
+  }
+  worker.First = false;
+
+  vtkSmartPointer<vtkDataArray> functionValues = vtk::TakeSmartPointer(output->NewInstance());
+  while ((f = this->FunctionList->GetNextImplicitFunction(sit)))
+  {
+    f->FunctionValue(input, functionValues);
+    if (!Dispatcher::Execute(output, functionValues.Get(), worker))
+    {
+      worker(output, functionValues.Get());
+    }
+  }
+}
+
 // Evaluate gradient of boolean combination.
 void vtkImplicitBoolean::EvaluateGradient(double x[3], double g[3])
 {
@@ -62,8 +62,11 @@ public:
   ///@{
   /**
    * Evaluate boolean combinations of implicit function using current operator.
+   * The array version evaluates each function over all the points with its
+   * own array version, then combines the values in parallel.
    */
   using vtkImplicitFunction::EvaluateFunction;
+  void EvaluateFunction(vtkDataArray* input, vtkDataArray* output) override;
   double EvaluateFunction(double x[3]) override;
   ///@}
 
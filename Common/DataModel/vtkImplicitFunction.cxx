@@ -112,6 +112,7 @@ void vtkImplicitFunction::FunctionValue(vtkDataArray* input, vtkDataArray* outpu
   }
   else // pass point through transform
   {
+    output->SetNumberOfComponents(1);
     FunctionWorker<TransformFunction> worker(TransformFunction(this, this->Transform));
     typedef vtkTypeList::Create<float, double> InputTypes;
     typedef vtkTypeList::Create<float, double> OutputTypes;
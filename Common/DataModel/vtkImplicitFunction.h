@@ -72,7 +72,10 @@ public:
   ///@{
   /**
    * Evaluate function at position x-y-z and return value. Point x[3] is
-   * transformed through transform (if provided).
+   * transformed through transform (if provided). The array version
+   * evaluates all the points of a 3-component array into a 1-component
+   * array, resized as needed, using the array version of EvaluateFunction()
+   * when there is no transform.
    */
   virtual void FunctionValue(vtkDataArray* input, vtkDataArray* output);
   double FunctionValue(const double x[3]);
@@ -116,7 +119,9 @@ public:
    * Evaluate function at position x-y-z and return value.  You should
    * generally not call this method directly, you should use
    * FunctionValue() instead.  This method must be implemented by
-   * any derived class.
+   * any derived class. The array version evaluates the points one at a
+   * time; subclasses that are thread safe override it to evaluate the
+   * points in parallel, in a loop the compiler can vectorize.
    */
   virtual double EvaluateFunction(double x[3]) = 0;
   virtual void EvaluateFunction(vtkDataArray* input, vtkDataArray* output);
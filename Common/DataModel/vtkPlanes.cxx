@@ -14,12 +14,17 @@
 =========================================================================*/
 #include "vtkPlanes.h"
 
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDoubleArray.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkPlanes);
 vtkCxxSetObjectMacro(vtkPlanes, Points, vtkPoints);
@@ -117,6 +122,80 @@ double vtkPlanes::EvaluateFunction(double x[3])
   return maxVal;
 }
 
+//------------------------------------------------------------------------------
+// Evaluate the plane equations over arrays of points.
+namespace
+{
+struct PlanesFunctionWorker
+{
+  // Normal and origin of each plane
+  std::vector<double> Planes;
+
+  template <typename InputArrayType, typename OutputArrayType>
+  void operator()(InputArrayType* input, OutputArrayType* output)
+  {
+    VTK_ASSUME(input->GetNumberOfComponents() == 3);
+    VTK_ASSUME(output->GetNumberOfComponents() == 1);
+    using OutputValueType = vtk::GetAPIType<OutputArrayType>;
+    const double* planes = this->Planes.data();
+    const vtkIdType numPlanes = static_cast<vtkIdType>(this->Planes.size() / 6);
+
+    vtkSMPTools::For(0, input->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      const auto srcTuples = vtk::DataArrayTupleRange<3>(input, begin, end);
+      auto dstValues = vtk::DataArrayValueRange<1>(output, begin, end);
+      auto dst = dstValues.begin();
+      for (const auto x : srcTuples)
+      {
+        const double x0 = static_cast<double>(x[0]);
+        const double x1 = static_cast<double>(x[1]);
+        const double x2 = static_cast<double>(x[2]);
+        double maxVal = -VTK_DOUBLE_MAX;
+        for (const double* p = planes; p < planes + 6 * numPlanes; p += 6)
+        {
+          const double val = p[0] * (x0 - p[3]) + p[1] * (x1 - p[4]) + p[2] * (x2 - p[5]);
+          maxVal = val > maxVal ? val : maxVal;
+        }
+        *dst++ = static_cast<OutputValueType>(maxVal);
+      }
+    });
+  }
+};
+} // anonymous namespace
+
+void vtkPlanes::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
+{
+  output->SetNumberOfComponents(1);
+  output->SetNumberOfTuples(input->GetNumberOfTuples());
+
+  if (!this->Points || !this->Normals)
+  {
+    vtkErrorMacro(<< "Please define points and/or normals!");
+    output->Fill(VTK_DOUBLE_MAX);
+    return;
+  }
+  const vtkIdType numPlanes = this->Points->GetNumberOfPoints();
+  if (numPlanes != this->Normals->GetNumberOfTuples())
+  {
+    vtkErrorMacro(<< "Number of normals/points inconsistent!");
+    output->Fill(VTK_DOUBLE_MAX);
+    return;
+  }
+
+  PlanesFunctionWorker worker;
+  worker.Planes.resize(6 * numPlanes);
+  for (vtkIdType i = 0; i < numPlanes; ++i)
+  {
+    this->Normals->GetTuple(i, worker.Planes.data() + 6 * i);
+    this->Points->GetPoint(i, worker.Planes.data() + 6 * i + 3);
+  }
+  using Dispatcher = vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::Reals,
+    vtkArrayDispatch::Reals>;
+  if (!Dispatcher::Execute(input, output, worker))
+  {
+    worker(input, output); // Use vtkDataArray API if dispatch fails.
+  }
+}
+
 //------------------------------------------------------------------------------
 // Evaluate planes gradient.
 void vtkPlanes::EvaluateGradient(double x[3], double n[3])
@@ -61,9 +61,11 @@ public:
   ///@{
   /**
    * Evaluate plane equations. Return largest value (i.e., an intersection
-   * operation between all planes).
+   * operation between all planes). The array version evaluates all the
+   * points in parallel.
    */
   using vtkImplicitFunction::EvaluateFunction;
+  void EvaluateFunction(vtkDataArray* input, vtkDataArray* output) override;
   double EvaluateFunction(double x[3]) override;
   ///@}
 
@@ -36,6 +36,7 @@ static int Test_complex_module();
 static int Test_fftfreq();
 static int Test_rfftfreq();
 static int Test_fft_direct_inverse();
+static int Test_fft_axis();
 
 int UnitTestFFT(int, char*[])
 {
@@ -49,6 +50,7 @@ int UnitTestFFT(int, char*[])
   status += Test_fftfreq();
   status += Test_rfftfreq();
   status += Test_fft_direct_inverse();
+  status += Test_fft_axis();
 
   if (status != 0)
   {
@@ -424,3 +426,88 @@ int Test_fft_direct_inverse()
   }
   return status;
 }
+
+int Test_fft_axis()
+{
+  int status = 0;
+  std::cout << "Test_fft_axis..";
+
+  // Sizes with even, odd and single rows along each axis
+  const vtkIdType dims[3] = { 6, 5, 36 };
+  const vtkIdType size = dims[0] * dims[1] * dims[2];
+  const vtkIdType strides[3] = { 1, dims[0], dims[0] * dims[1] };
+  std::vector<vtkFFT::ComplexNumber> input(size);
+  std::vector<vtkFFT::ScalarNumber> real(size);
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    input[i] = vtkFFT::ComplexNumber{ std::sin(0.1 * i), std::cos(0.37 * i) };
+    real[i] = std::sin(0.3 * i) + 0.5;
+  }
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    std::vector<vtkFFT::ComplexNumber> result = input;
+    vtkFFT::FftAxis(result.data(), dims, 3, axis);
+    std::vector<vtkFFT::ComplexNumber> realResult(size);
+    std::transform(real.begin(), real.end(), realResult.begin(),
+      [](vtkFFT::ScalarNumber x) { return vtkFFT::ComplexNumber{ x, 7.0 }; });
+    vtkFFT::RFftAxis(realResult.data(), dims, 3, axis);
+
+    // Compare each row to the one-dimensional transforms
+    const vtkIdType n = dims[axis];
+    for (vtkIdType first = 0; first < size; ++first)
+    {
+      if ((first / strides[axis]) % n != 0)
+      {
+        continue;
+      }
+      std::vector<vtkFFT::ComplexNumber> row(n);
+      std::vector<vtkFFT::ScalarNumber> realRow(n);
+      for (vtkIdType k = 0; k < n; ++k)
+      {
+        row[k] = input[first + k * strides[axis]];
+        realRow[k] = real[first + k * strides[axis]];
+      }
+      std::vector<vtkFFT::ComplexNumber> expected = vtkFFT::Fft(row);
+      std::vector<vtkFFT::ComplexNumber> realExpected = vtkFFT::Fft(realRow);
+      for (vtkIdType k = 0; k < n; ++k)
+      {
+        const vtkFFT::ComplexNumber& x = result[first + k * strides[axis]];
+        const vtkFFT::ComplexNumber& y = realResult[first + k * strides[axis]];
+        if (std::abs(x.r - expected[k].r) > 1e-10 || std::abs(x.i - expected[k].i) > 1e-10 ||
+          std::abs(y.r - realExpected[k].r) > 1e-10 || std::abs(y.i - realExpected[k].i) > 1e-10)
+        {
+          std::cout << "Wrong term " << k << " of the row at " << first << " along axis " << axis
+                    << std::endl;
+          status++;
+          break;
+        }
+      }
+    }
+  }
+
+  // The inverse transform goes back to the input
+  std::vector<vtkFFT::ComplexNumber> result = input;
+  vtkFFT::FftND(result.data(), dims, 3);
+  vtkFFT::FftND(result.data(), dims, 3, true);
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    if (std::abs(result[i].r - input[i].r) > 1e-10 || std::abs(result[i].i - input[i].i) > 1e-10)
+    {
+      std::cout << "Expected " << input[i].r << "+" << input[i].i << "i but got " << result[i].r
+                << "+" << result[i].i << "i" << std::endl;
+      status++;
+      break;
+    }
+  }
+
+  if (status)
+  {
+    std::cout << "..FAILED" << std::endl;
+  }
+  else
+  {
+    std::cout << ".PASSED" << std::endl;
+  }
+  return status;
+}
@@ -15,6 +15,305 @@
 #include "vtkFFT.h"
 
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Cache of the kissfft plans by size and direction. The plans of complex
+// transforms are only read by kiss_fft() and are shared by all the threads,
+// while those of real transforms hold a work buffer, so that each thread
+// borrows its own plan (see vtkFFTRealPlan).
+class vtkFFTPlans
+{
+public:
+  static vtkFFTPlans& GetInstance()
+  {
+    static vtkFFTPlans plans;
+    return plans;
+  }
+
+  ~vtkFFTPlans()
+  {
+    for (auto& plan : this->Plans)
+    {
+      kiss_fft_free(plan.second);
+    }
+    for (auto& plans : this->RealPlans)
+    {
+      for (kiss_fftr_cfg plan : plans.second)
+      {
+        kiss_fftr_free(plan);
+      }
+    }
+  }
+
+  kiss_fft_cfg GetPlan(int n, bool inverse)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    kiss_fft_cfg& plan = this->Plans[std::make_pair(n, inverse)];
+    if (plan == nullptr)
+    {
+      plan = kiss_fft_alloc(n, inverse ? 1 : 0, nullptr, nullptr);
+    }
+    return plan;
+  }
+
+  kiss_fftr_cfg AcquireRealPlan(int n, bool inverse)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      std::vector<kiss_fftr_cfg>& plans = this->RealPlans[std::make_pair(n, inverse)];
+      if (!plans.empty())
+      {
+        kiss_fftr_cfg plan = plans.back();
+        plans.pop_back();
+        return plan;
+      }
+    }
+    return kiss_fftr_alloc(n, inverse ? 1 : 0, nullptr, nullptr);
+  }
+
+  void ReleaseRealPlan(int n, bool inverse, kiss_fftr_cfg plan)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->RealPlans[std::make_pair(n, inverse)].push_back(plan);
+  }
+
+private:
+  std::mutex Mutex;
+  std::map<std::pair<int, bool>, kiss_fft_cfg> Plans;
+  std::map<std::pair<int, bool>, std::vector<kiss_fftr_cfg>> RealPlans;
+};
+
+//------------------------------------------------------------------------------
+// A plan of a real transform, borrowed from the cache for the lifetime of this
+// object. It is null for sizes that are not even.
+class vtkFFTRealPlan
+{
+public:
+  vtkFFTRealPlan(int n, bool inverse)
+    : Size(n)
+    , Inverse(inverse)
+    , Plan(n % 2 == 0 ? vtkFFTPlans::GetInstance().AcquireRealPlan(n, inverse) : nullptr)
+  {
+  }
+
+  ~vtkFFTRealPlan()
+  {
+    if (this->Plan != nullptr)
+    {
+      vtkFFTPlans::GetInstance().ReleaseRealPlan(this->Size, this->Inverse, this->Plan);
+    }
+  }
+
+  operator kiss_fftr_cfg() const { return this->Plan; }
+
+private:
+  vtkFFTRealPlan(const vtkFFTRealPlan&) = delete;
+  void operator=(const vtkFFTRealPlan&) = delete;
+
+  int Size;
+  bool Inverse;
+  kiss_fftr_cfg Plan;
+};
+
+//------------------------------------------------------------------------------
+// Transforms in place a contiguous row of complex numbers.
+class vtkFFTComplexRow
+{
+public:
+  vtkFFTComplexRow(int n, bool inverse)
+    : Plan(vtkFFTPlans::GetInstance().GetPlan(n, inverse))
+    , Scale(inverse ? 1.0 / n : 1.0)
+    , Work(n)
+  {
+  }
+
+  void operator()(vtkFFT::ComplexNumber* row)
+  {
+    kiss_fft(this->Plan, row, this->Work.data());
+    if (this->Scale != 1.0)
+    {
+      for (const vtkFFT::ComplexNumber& x : this->Work)
+      {
+        row->r = x.r * this->Scale;
+        row->i = x.i * this->Scale;
+        ++row;
+      }
+    }
+    else
+    {
+      std::copy(this->Work.begin(), this->Work.end(), row);
+    }
+  }
+
+private:
+  kiss_fft_cfg Plan;
+  vtkFFT::ScalarNumber Scale;
+  std::vector<vtkFFT::ComplexNumber> Work;
+};
+
+//------------------------------------------------------------------------------
+// Transforms in place a contiguous row of real numbers, stored in the real
+// parts of complex numbers. Rows of odd size use a complex transform.
+class vtkFFTRealRow
+{
+public:
+  vtkFFTRealRow(int n, bool vtkNotUsed(inverse))
+    : RealPlan(n, false)
+    , Plan(n % 2 == 0 ? nullptr : vtkFFTPlans::GetInstance().GetPlan(n, false))
+    , Size(n)
+    , Input(n % 2 == 0 ? n : 0)
+    , Work(n % 2 == 0 ? n / 2 + 1 : n)
+  {
+  }
+
+  void operator()(vtkFFT::ComplexNumber* row)
+  {
+    const int n = this->Size;
+    if (this->Plan != nullptr)
+    {
+      for (int k = 0; k < n; ++k)
+      {
+        row[k].i = 0.0;
+      }
+      kiss_fft(this->Plan, row, this->Work.data());
+      std::copy(this->Work.begin(), this->Work.end(), row);
+      return;
+    }
+    for (int k = 0; k < n; ++k)
+    {
+      this->Input[k] = row[k].r;
+    }
+    kiss_fftr(this->RealPlan, this->Input.data(), this->Work.data());
+    std::copy(this->Work.begin(), this->Work.end(), row);
+    for (int k = n / 2 + 1; k < n; ++k)
+    {
+      row[k].r = row[n - k].r;
+      row[k].i = -row[n - k].i;
+    }
+  }
+
+private:
+  vtkFFTRealPlan RealPlan;
+  kiss_fft_cfg Plan;
+  int Size;
+  std::vector<vtkFFT::ScalarNumber> Input;
+  std::vector<vtkFFT::ComplexNumber> Work;
+};
+
+//------------------------------------------------------------------------------
+// Number of rows that are copied together, so that the copies read whole cache
+// lines when the rows are not contiguous.
+const vtkIdType vtkFFTBlockSize = 16;
+
+//------------------------------------------------------------------------------
+// Applies a row transform to all the rows of an array along one axis. The rows
+// that are not contiguous are copied by blocks, whose elements are adjacent in
+// memory, into a buffer where they are transformed.
+template <class TRow>
+class vtkFFTRows
+{
+public:
+  vtkFFTRows(vtkFFT::ComplexNumber* data, const vtkIdType* dims, int rank, int axis, bool inverse)
+    : Data(data)
+    , Size(dims[axis])
+    , Stride(1)
+    , NumberOfRows(1)
+    , Inverse(inverse)
+  {
+    for (int i = 0; i < rank; ++i)
+    {
+      if (i < axis)
+      {
+        this->Stride *= dims[i];
+      }
+      else if (i > axis)
+      {
+        this->NumberOfRows *= dims[i];
+      }
+    }
+    this->NumberOfBlocks = (this->Stride + vtkFFTBlockSize - 1) / vtkFFTBlockSize;
+  }
+
+  void Execute()
+  {
+    vtkSMPTools::For(0, this->NumberOfRows * this->NumberOfBlocks, *this);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const vtkIdType n = this->Size;
+    const vtkIdType stride = this->Stride;
+    TRow transform(static_cast<int>(n), this->Inverse);
+    std::vector<vtkFFT::ComplexNumber> rows(stride > 1 ? vtkFFTBlockSize * n : 0);
+    for (vtkIdType item = begin; item < end; ++item)
+    {
+      const vtkIdType first = (item % this->NumberOfBlocks) * vtkFFTBlockSize;
+      vtkFFT::ComplexNumber* block =
+        this->Data + (item / this->NumberOfBlocks) * stride * n + first;
+      if (stride == 1)
+      {
+        transform(block);
+        continue;
+      }
+
+      const vtkIdType count = std::min(vtkFFTBlockSize, stride - first);
+      for (vtkIdType k = 0; k < n; ++k)
+      {
+        const vtkFFT::ComplexNumber* in = block + k * stride;
+        for (vtkIdType j = 0; j < count; ++j)
+        {
+          rows[j * n + k] = in[j];
+        }
+      }
+      for (vtkIdType j = 0; j < count; ++j)
+      {
+        transform(&rows[j * n]);
+      }
+      for (vtkIdType k = 0; k < n; ++k)
+      {
+        vtkFFT::ComplexNumber* out = block + k * stride;
+        for (vtkIdType j = 0; j < count; ++j)
+        {
+          out[j] = rows[j * n + k];
+        }
+      }
+    }
+  }
+
+private:
+  vtkFFT::ComplexNumber* Data;
+  vtkIdType Size;
+  vtkIdType Stride;
+  vtkIdType NumberOfRows;
+  vtkIdType NumberOfBlocks;
+  bool Inverse;
+};
+
+//------------------------------------------------------------------------------
+bool vtkFFTCheckAxis(const vtkIdType* dims, int rank, int axis)
+{
+  if (axis < 0 || axis >= rank)
+  {
+    return false;
+  }
+  for (int i = 0; i < rank; ++i)
+  {
+    if (dims[i] < 1)
+    {
+      return false;
+    }
+  }
+  return dims[axis] <= VTK_INT_MAX;
+}
+}
 
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkFFT);
@@ -27,14 +326,12 @@ std::vector<vtkFFT::ComplexNumber> vtkFFT::Fft(const std::vector<ComplexNumber>&
     return {};
   }
 
-  kiss_fft_cfg cfg =
-    kiss_fft_alloc(static_cast<int>(in.size()), 0 /*is_inverse_fft*/, nullptr, nullptr);
+  kiss_fft_cfg cfg = vtkFFTPlans::GetInstance().GetPlan(static_cast<int>(in.size()), false);
   if (cfg != nullptr)
   {
     std::vector<vtkFFT::ComplexNumber> result(in.size());
 
     kiss_fft(cfg, in.data(), &result[0]);
-    kiss_fft_free(cfg);
 
     return result;
   }
@@ -69,14 +366,12 @@ std::vector<vtkFFT::ComplexNumber> vtkFFT::RFft(const std::vector<ScalarNumber>&
     return std::vector<ComplexNumber>(res.begin(), res.begin() + outSize);
   }
 
-  kiss_fftr_cfg cfg =
-    kiss_fftr_alloc(static_cast<int>(in.size()), 0 /*is_inverse_fft*/, nullptr, nullptr);
+  vtkFFTRealPlan cfg(static_cast<int>(in.size()), false);
   if (cfg != nullptr)
   {
     std::vector<vtkFFT::ComplexNumber> result(outSize);
 
     kiss_fftr(cfg, in.data(), &result[0]);
-    kiss_fftr_free(cfg);
 
     return result;
   }
@@ -92,8 +387,7 @@ std::vector<vtkFFT::ComplexNumber> vtkFFT::IFft(const std::vector<vtkFFT::Comple
   }
 
   std::size_t outSize = in.size();
-  kiss_fft_cfg cfg =
-    kiss_fft_alloc(static_cast<int>(outSize), 1 /*is_inverse_fft*/, nullptr, nullptr);
+  kiss_fft_cfg cfg = vtkFFTPlans::GetInstance().GetPlan(static_cast<int>(outSize), true);
   if (cfg != nullptr)
   {
     std::vector<vtkFFT::ComplexNumber> result(outSize);
@@ -102,7 +396,6 @@ std::vector<vtkFFT::ComplexNumber> vtkFFT::IFft(const std::vector<vtkFFT::Comple
     std::for_each(result.begin(), result.end(), [outSize](vtkFFT::ComplexNumber& x) {
       x = vtkFFT::ComplexNumber{ x.r / outSize, x.i / outSize };
     });
-    kiss_fft_free(cfg);
 
     return result;
   }
@@ -118,8 +411,7 @@ std::vector<vtkFFT::ScalarNumber> vtkFFT::IRFft(const std::vector<vtkFFT::Comple
   }
 
   std::size_t outSize = (in.size() - 1) * 2;
-  kiss_fftr_cfg cfg =
-    kiss_fftr_alloc(static_cast<int>(outSize), 1 /*is_inverse_fft*/, nullptr, nullptr);
+  vtkFFTRealPlan cfg(static_cast<int>(outSize), true);
   if (cfg != nullptr)
   {
     std::vector<vtkFFT::ScalarNumber> result(outSize);
@@ -127,13 +419,39 @@ std::vector<vtkFFT::ScalarNumber> vtkFFT::IRFft(const std::vector<vtkFFT::Comple
     kiss_fftri(cfg, in.data(), &result[0]);
     std::for_each(result.begin(), result.end(),
       [outSize](vtkFFT::ScalarNumber& num) { num /= static_cast<vtkFFT::ScalarNumber>(outSize); });
-    kiss_fftr_free(cfg);
 
     return result;
   }
   return {};
 }
 
+//------------------------------------------------------------------------------
+void vtkFFT::FftAxis(ComplexNumber* data, const vtkIdType* dims, int rank, int axis, bool inverse)
+{
+  if (vtkFFTCheckAxis(dims, rank, axis))
+  {
+    vtkFFTRows<vtkFFTComplexRow>(data, dims, rank, axis, inverse).Execute();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkFFT::RFftAxis(ComplexNumber* data, const vtkIdType* dims, int rank, int axis)
+{
+  if (vtkFFTCheckAxis(dims, rank, axis))
+  {
+    vtkFFTRows<vtkFFTRealRow>(data, dims, rank, axis, false).Execute();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkFFT::FftND(ComplexNumber* data, const vtkIdType* dims, int rank, bool inverse)
+{
+  for (int axis = 0; axis < rank; ++axis)
+  {
+    vtkFFT::FftAxis(data, dims, rank, axis, inverse);
+  }
+}
+
 //------------------------------------------------------------------------------
 std::vector<double> vtkFFT::FftFreq(int windowLength, double sampleSpacing)
 {
@@ -94,6 +94,32 @@ public:
    */
   static std::vector<ScalarNumber> IRFft(const std::vector<ComplexNumber>& in);
 
+  /**
+   * Compute in place the one-dimensional DFTs, or their inverse, along one axis of a
+   * multi-dimensional array of complex numbers. @c dims holds the @c rank dimensions of the
+   * array, the first one varying fastest.
+   *
+   * The rows along the axis are gathered by blocks into contiguous buffers and transformed in
+   * parallel with vtkSMPTools. Like the other methods, the kissfft plans are cached by size,
+   * so that transforming many rows is much faster than calling @c Fft for each of them.
+   * The inverse transforms are scaled by 1/n like @c IFft.
+   */
+  static void FftAxis(
+    ComplexNumber* data, const vtkIdType* dims, int rank, int axis, bool inverse = false);
+
+  /**
+   * Same as @c FftAxis for a forward transform of real numbers, which are read from the real
+   * parts of @c data. The rows of even size are transformed as with @c RFft, and their
+   * negative-frequency terms are filled by hermitian symmetry, which takes about half the time.
+   */
+  static void RFftAxis(ComplexNumber* data, const vtkIdType* dims, int rank, int axis);
+
+  /**
+   * Compute in place the multi-dimensional DFT, or its inverse, of an array of complex numbers
+   * with @c FftAxis along each of its @c rank axes.
+   */
+  static void FftND(ComplexNumber* data, const vtkIdType* dims, int rank, bool inverse = false);
+
   /**
    * Return the absolute value (also known as norm, modulus, or magnitude) of complex number
    */
@@ -106,23 +106,32 @@ const char* HelpText =
   "  mandelbrot  The mandelbrot set.\n"
   "\n"
   "Filters: these are the algorithms that can be benchmarked.\n"
-  "  median:kernelsize=3        Test vtkImageMedian3D.\n"
+  "  median:kernelsize=3        Test vtkImageMedian3D (see below).\n"
   "  reslice:kernel=nearest     Test vtkImageReslice (see below).\n"
   "  resize:kernelsize=1        Test vtkImageResize.\n"
   "  convolve:kernelsize=3      Test vtkImageConvolve.\n"
   "  separable:kernelsize=3     Test vtkImageSeparableConvolution.\n"
-  "  gaussian:kernelsize=3      Test vtkImageGaussianSmooth.\n"
+  "  gaussian:kernelsize=3      Test vtkImageGaussianSmooth (see below).\n"
   "  bspline:degree=3           Test vtkImageBSplineCoefficients.\n"
   "  fft                        Test vtkImageFFT.\n"
   "  histogram:stencil          Test vtkImageHistogram.\n"
   "  colormap:components=3      Test vtkImageMapToColors.\n"
   "\n"
+  "The median filter takes the following options:\n"
+  "  kernelsize=3               The kernel size along each axis.\n"
+  "  algorithm=automatic|selection|histogram|network   The algorithm to use.\n"
+  "\n"
   "The reslice filter takes the following options:\n"
   "  stencil                    Spherical stencil (ignore voxels outside).\n"
   "  kernel=nearest|linear|cubic|sinc|bspline   The interpolator to use.\n"
   "  kernelsize=4               The kernelsize (sinc, bspline only).\n"
   "  rotation=0/0/0/0           Rotation angle (degrees) and axis.\n"
   "\n"
+  "The gaussian and separable filters take the following options:\n"
+  "  kernelsize=3               The kernel size (gaussian: 4 stdevs + 1).\n"
+  "  axis=x|y|z                 Convolve along one axis only.\n"
+  "  recursive                  Use the recursive gaussian (gaussian only).\n"
+  "\n"
   "The colormap filter takes the following options:\n"
   "  components=3               Output components (3=RGB, 4=RGBA).\n"
   "  greyscale                  Rescale but do not apply a vtkLookupTable.\n"
@@ -156,6 +165,16 @@ const char* DefaultFilters[] = {
   "gaussian:kernelsize=3",
   "convolve:kernelsize=3",
   "separable:kernelsize=3",
+
+  "gaussian:kernelsize=9:axis=x",
+  "gaussian:kernelsize=9:axis=y",
+  "gaussian:kernelsize=9:axis=z",
+  "gaussian:kernelsize=9:axis=z:recursive",
+  "gaussian:kernelsize=41:axis=z",
+  "gaussian:kernelsize=41:axis=z:recursive",
+  "separable:kernelsize=9:axis=x",
+  "separable:kernelsize=9:axis=y",
+  "separable:kernelsize=9:axis=z",
   "resize:kernelsize=3",
   "median:kernelsize=3",
 
@@ -196,6 +215,16 @@ static void ClearCPUCache(size_t cacheSize)
   threader->SingleMethodExecute();
 }
 
+// get the axis from an "axis=x|y|z" option, or -1 if not valid
+static int GetAxisOption(const std::string& arg, size_t n)
+{
+  if (n == std::string::npos || n + 2 != arg.size() || arg[n + 1] < 'x' || arg[n + 1] > 'z')
+  {
+    return -1;
+  }
+  return arg[n + 1] - 'x';
+}
+
 // verify that everything is set the way that we expect
 static void PrintInfo(vtkThreadedImageAlgorithm* filter, std::ostream& os)
 {
@@ -219,6 +248,7 @@ static void PrintInfo(vtkThreadedImageAlgorithm* filter, std::ostream& os)
   {
     imsize = median->GetKernelSize();
     os << "KernelSize: " << imsize[0] << "," << imsize[1] << "," << imsize[2] << "\n";
+    os << "Algorithm: " << median->GetAlgorithmAsString() << "\n";
   }
   vtkImageReslice* reslice = vtkImageReslice::SafeDownCast(filter);
   if (reslice)
@@ -284,9 +314,13 @@ static void PrintInfo(vtkThreadedImageAlgorithm* filter, std::ostream& os)
   vtkImageSeparableConvolution* separable = vtkImageSeparableConvolution::SafeDownCast(filter);
   if (separable)
   {
-    os << "XKernel: " << separable->GetXKernel()->GetNumberOfTuples() << "\n";
-    os << "YKernel: " << separable->GetYKernel()->GetNumberOfTuples() << "\n";
-    os << "ZKernel: " << separable->GetZKernel()->GetNumberOfTuples() << "\n";
+    vtkFloatArray* kernels[3] = { separable->GetXKernel(), separable->GetYKernel(),
+      separable->GetZKernel() };
+    for (int k = 0; k < 3; k++)
+    {
+      os << static_cast<char>('X' + k) << "Kernel: "
+         << (kernels[k] ? kernels[k]->GetNumberOfTuples() : 0) << "\n";
+    }
   }
   vtkImageGaussianSmooth* gaussian = vtkImageGaussianSmooth::SafeDownCast(filter);
   if (gaussian)
@@ -295,6 +329,8 @@ static void PrintInfo(vtkThreadedImageAlgorithm* filter, std::ostream& os)
     os << "StandardDeviations: " << f[0] << "," << f[1] << "," << f[2] << "\n";
     f = gaussian->GetRadiusFactors();
     os << "RadiusFactors: " << f[0] << "," << f[1] << "," << f[2] << "\n";
+    os << "Dimensionality: " << gaussian->GetDimensionality() << "\n";
+    os << "RecursiveFilter: " << gaussian->GetRecursiveFilter() << "\n";
   }
   vtkImageMapToColors* colors = vtkImageMapToColors::SafeDownCast(filter);
   if (colors)
@@ -343,21 +379,55 @@ static vtkThreadedImageAlgorithm* CreateFilter(const std::string& filterName, co
     vtkSmartPointer<vtkImageMedian3D> filter = vtkSmartPointer<vtkImageMedian3D>::New();
 
     int kernelsize = 3;
+    int algorithm = vtkImageMedian3D::Automatic;
 
-    if (args.size() > 1)
+    for (size_t k = 1; k < args.size(); k++)
     {
-      size_t n = args[1].find('=');
-      if (args[1].substr(0, n) != "kernelsize" || n == std::string::npos ||
-        n + 1 == args[1].size() || args[1][n + 1] < '1' || args[1][n + 1] > '9' || args.size() > 2)
+      size_t n = args[k].find('=');
+      std::string key = args[k].substr(0, n);
+      std::string value = (n == std::string::npos ? "" : args[k].substr(n + 1));
+      if (key == "kernelsize")
+      {
+        if (value.empty() || value[0] < '1' || value[0] > '9')
+        {
+          std::cerr << "median options: kernelsize=N:algorithm=name\n";
+          return nullptr;
+        }
+        kernelsize = std::atoi(value.c_str());
+      }
+      else if (key == "algorithm")
+      {
+        if (value == "automatic")
+        {
+          algorithm = vtkImageMedian3D::Automatic;
+        }
+        else if (value == "selection")
+        {
+          algorithm = vtkImageMedian3D::Selection;
+        }
+        else if (value == "histogram")
+        {
+          algorithm = vtkImageMedian3D::Histogram;
+        }
+        else if (value == "network")
+        {
+          algorithm = vtkImageMedian3D::SortingNetwork;
+        }
+        else
+        {
+          std::cerr << "median algorithm must be automatic, selection, histogram, or network\n";
+          return nullptr;
+        }
+      }
+      else
       {
-        std::cerr << "median options: kernelsize=N\n";
+        std::cerr << "median does not take option " << key << "\n";
         return nullptr;
       }
-      std::string num = args[1].substr(n + 1);
-      kernelsize = std::atoi(num.c_str());
     }
 
     filter->SetKernelSize(kernelsize, kernelsize, kernelsize);
+    filter->SetAlgorithm(algorithm);
     filter->Register(nullptr);
     return filter;
   }
@@ -688,21 +758,40 @@ static vtkThreadedImageAlgorithm* CreateFilter(const std::string& filterName, co
       vtkSmartPointer<vtkImageSeparableConvolution>::New();
 
     int kernelsize = 3;
+    int axis = -1;
 
-    if (args.size() > 1)
+    for (size_t k = 1; k < args.size(); k++)
     {
-      size_t n = args[1].find('=');
-      if (args[1].substr(0, n) != "kernelsize" || n == std::string::npos ||
-        n + 1 == args[1].size() || args[1][n + 1] < '1' || args[1][n + 1] > '9' || args.size() > 2)
+      size_t n = args[k].find('=');
+      std::string key = args[k].substr(0, n);
+      if (key == "kernelsize")
       {
-        std::cerr << "separable options: kernelsize=N\n";
-        return nullptr;
+        if (n == std::string::npos || n + 1 == args[k].size() || args[k][n + 1] < '1' ||
+          args[k][n + 1] > '9')
+        {
+          std::cerr << "separable options: kernelsize=N:axis=x|y|z\n";
+          return nullptr;
+        }
+        std::string num = args[k].substr(n + 1);
+        kernelsize = std::atoi(num.c_str());
+        if (kernelsize % 2 != 1)
+        {
+          std::cerr << "separable kernelsize must be odd\n";
+          return nullptr;
+        }
       }
-      std::string num = args[1].substr(n + 1);
-      kernelsize = std::atoi(num.c_str());
-      if (kernelsize % 2 != 1)
+      else if (key == "axis")
+      {
+        axis = GetAxisOption(args[k], n);
+        if (axis < 0)
+        {
+          std::cerr << "separable axis must be x, y, or z\n";
+          return nullptr;
+        }
+      }
+      else
       {
-        std::cerr << "separable kernelsize must be odd\n";
+        std::cerr << "separable does not take option " << key << "\n";
         return nullptr;
       }
     }
@@ -727,15 +816,25 @@ static vtkThreadedImageAlgorithm* CreateFilter(const std::string& filterName, co
     kernel2->SetNumberOfValues(1);
     kernel2->SetValue(0, 1.0);
 
-    filter->SetXKernel(kernel);
-    filter->SetYKernel(kernel);
-    if (size[2] > 1)
+    if (axis >= 0)
     {
-      filter->SetZKernel(kernel);
+      // convolve along one axis only
+      filter->SetXKernel(axis == 0 ? kernel : nullptr);
+      filter->SetYKernel(axis == 1 ? kernel : nullptr);
+      filter->SetZKernel(axis == 2 ? kernel : nullptr);
     }
     else
     {
-      filter->SetZKernel(kernel2);
+      filter->SetXKernel(kernel);
+      filter->SetYKernel(kernel);
+      if (size[2] > 1)
+      {
+        filter->SetZKernel(kernel);
+      }
+      else
+      {
+        filter->SetZKernel(kernel2);
+      }
     }
 
     filter->Register(nullptr);
@@ -747,27 +846,59 @@ static vtkThreadedImageAlgorithm* CreateFilter(const std::string& filterName, co
     vtkSmartPointer<vtkImageGaussianSmooth> filter = vtkSmartPointer<vtkImageGaussianSmooth>::New();
 
     int kernelsize = 3;
+    int axis = -1;
+    bool recursive = false;
 
-    if (args.size() > 1)
+    for (size_t k = 1; k < args.size(); k++)
     {
-      size_t n = args[1].find('=');
-      if (args[1].substr(0, n) != "kernelsize" || n == std::string::npos ||
-        n + 1 == args[1].size() || args[1][n + 1] < '1' || args[1][n + 1] > '9' || args.size() > 2)
+      size_t n = args[k].find('=');
+      std::string key = args[k].substr(0, n);
+      if (key == "kernelsize")
       {
-        std::cerr << "gaussian options: kernelsize=N\n";
-        return nullptr;
+        if (n == std::string::npos || n + 1 == args[k].size() || args[k][n + 1] < '1' ||
+          args[k][n + 1] > '9')
+        {
+          std::cerr << "gaussian options: kernelsize=N:axis=x|y|z:recursive\n";
+          return nullptr;
+        }
+        std::string num = args[k].substr(n + 1);
+        kernelsize = std::atoi(num.c_str());
+        if (kernelsize % 2 != 1)
+        {
+          std::cerr << "gaussian kernelsize must be odd\n";
+          return nullptr;
+        }
       }
-      std::string num = args[1].substr(n + 1);
-      kernelsize = std::atoi(num.c_str());
-      if (kernelsize % 2 != 1)
+      else if (key == "axis")
+      {
+        axis = GetAxisOption(args[k], n);
+        if (axis < 0)
+        {
+          std::cerr << "gaussian axis must be x, y, or z\n";
+          return nullptr;
+        }
+      }
+      else if (key == "recursive" && n == std::string::npos)
+      {
+        recursive = true;
+      }
+      else
       {
-        std::cerr << "gaussian kernelsize must be odd\n";
+        std::cerr << "gaussian does not take option " << key << "\n";
         return nullptr;
       }
     }
 
     double stdev = (kernelsize - 1.0) * 0.25;
-    if (size[2] > 1)
+    if (axis >= 0)
+    {
+      // smooth along one axis only, the axes before it are copied
+      double stdevs[3] = { 0.0, 0.0, 0.0 };
+      stdevs[axis] = stdev;
+      filter->SetStandardDeviations(stdevs);
+      filter->SetDimensionality(axis + 1);
+    }
+    else if (size[2] > 1)
     {
       filter->SetStandardDeviations(stdev, stdev, stdev);
     }
@@ -775,6 +906,7 @@ static vtkThreadedImageAlgorithm* CreateFilter(const std::string& filterName, co
     {
       filter->SetStandardDeviations(stdev, stdev, 0.0);
     }
+    filter->SetRecursiveFilter(recursive);
     filter->SetRadiusFactors(2.0, 2.0, 2.0);
 
     filter->Register(nullptr);
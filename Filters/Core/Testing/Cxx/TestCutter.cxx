@@ -15,13 +15,18 @@
 #include "vtkCutter.h"
 #include "vtkDataSetTriangleFilter.h"
 #include "vtkImageDataToPointSet.h"
+#include "vtkNew.h"
 #include "vtkPlane.h"
 #include "vtkPointDataToCellData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygonBuilder.h"
 #include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkSphere.h"
+#include "vtkUnstructuredGrid.h"
+#include <algorithm>
 #include <cassert>
 
 bool TestStructured(int type)
@@ -105,6 +110,87 @@ bool TestUnstructured()
   return true;
 }
 
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfPolys() != b->GetNumberOfPolys())
+  {
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < a->GetNumberOfPoints(); ++ptId)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(ptId, pa);
+    b->GetPoint(ptId, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+    {
+      return false;
+    }
+  }
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npa, npb;
+    const vtkIdType *ptsa, *ptsb;
+    a->GetCellPoints(cellId, npa, ptsa);
+    b->GetCellPoints(cellId, npb, ptsb);
+    if (npa != npb || !std::equal(ptsa, ptsa + npa, ptsb))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestThreadedUnstructured()
+{
+  vtkNew<vtkRTAnalyticSource> imageSource;
+  imageSource->SetWholeExtent(-10, 10, -10, 10, -10, 10);
+
+  vtkNew<vtkDataSetTriangleFilter> tetraFilter;
+  tetraFilter->SetInputConnection(imageSource->GetOutputPort());
+
+  vtkNew<vtkSphere> sphere;
+  sphere->SetRadius(6.3);
+
+  vtkNew<vtkCutter> cutter;
+  cutter->SetCutFunction(sphere);
+  cutter->SetInputConnection(tetraFilter->GetOutputPort());
+  cutter->SetBatchSize(1000);
+
+  // Sorting by cell goes through the serial code path.
+  cutter->SetSortByToSortByCell();
+  cutter->Update();
+  vtkNew<vtkPolyData> serial;
+  serial->ShallowCopy(cutter->GetOutput());
+
+  cutter->SetSortByToSortByValue();
+  cutter->Update();
+  vtkNew<vtkPolyData> threaded;
+  threaded->ShallowCopy(cutter->GetOutput());
+  if (threaded->GetNumberOfPoints() != serial->GetNumberOfPoints() ||
+    threaded->GetNumberOfPolys() != serial->GetNumberOfPolys() || threaded->CheckAttributes())
+  {
+    cerr << "Threaded cut differs from serial cut" << endl;
+    return false;
+  }
+
+  // The output must not depend on the batch size nor on the number of threads.
+  vtkNew<vtkPolyData> oneThread;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() {
+    cutter->Modified();
+    cutter->Update();
+    oneThread->ShallowCopy(cutter->GetOutput());
+  });
+  cutter->SetBatchSize(1);
+  cutter->Update();
+  if (!SamePolyData(threaded, oneThread) || !SamePolyData(threaded, cutter->GetOutput()))
+  {
+    cerr << "Threaded cut depends on the number of threads or the batch size" << endl;
+    return false;
+  }
+  return true;
+}
+
 int TestCutter(int, char*[])
 {
   for (int type = 0; type < 2; type++)
@@ -122,5 +208,11 @@ int TestCutter(int, char*[])
     return EXIT_FAILURE;
   }
 
+  if (!TestThreadedUnstructured())
+  {
+    cerr << "Cutting Unstructured in parallel failed" << endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,252 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelaunay3DPartitioned.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the partitioned triangulation of vtkDelaunay3D gives the same
+// tetrahedra as the serial triangulation for random points, for several
+// numbers of partitions, and a valid triangulation of a regular grid of
+// points (which is degenerate). The timings for 1 to the maximum number of
+// threads are reported so that the test can also be used as a scaling
+// benchmark: pass "--points N" to change the number of random points.
+
+#include <vtkDelaunay3D.h>
+#include <vtkFloatArray.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTools.h>
+#include <vtkTetra.h>
+#include <vtkTimerLog.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+
+namespace
+{
+typedef std::array<vtkIdType, 4> TetraIds;
+typedef std::array<vtkIdType, 3> FaceIds;
+
+void MakeRandomPoints(vtkIdType numPoints, int dataType, vtkPolyData* input)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(7);
+  vtkNew<vtkPoints> points;
+  points->SetDataType(dataType);
+  points->SetNumberOfPoints(numPoints);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Id");
+  scalars->SetNumberOfValues(numPoints);
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] = random->GetValue();
+      random->Next();
+    }
+    points->SetPoint(ptId, x);
+    scalars->SetValue(ptId, static_cast<float>(ptId));
+  }
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+}
+
+// Triangulate the input, returning the elapsed time.
+double Triangulate(vtkPolyData* input, int numPartitions, vtkUnstructuredGrid* output)
+{
+  vtkNew<vtkDelaunay3D> delaunay;
+  delaunay->SetInputData(input);
+  delaunay->SetPointInsertionOrderToSpatialOrder();
+  delaunay->SetNumberOfPartitions(numPartitions);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  delaunay->Update();
+  timer->StopTimer();
+
+  output->ShallowCopy(delaunay->GetOutput());
+  return timer->GetElapsedTime();
+}
+
+std::set<TetraIds> GetTetras(vtkUnstructuredGrid* output)
+{
+  std::set<TetraIds> tetras;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    output->GetCellPoints(cellId, npts, pts);
+    TetraIds tetra = { { pts[0], pts[1], pts[2], pts[3] } };
+    std::sort(tetra.begin(), tetra.end());
+    tetras.insert(tetra);
+  }
+  return tetras;
+}
+
+bool SameAsSerial(vtkPolyData* input, vtkUnstructuredGrid* serial, int numPartitions)
+{
+  vtkNew<vtkUnstructuredGrid> partitioned;
+  Triangulate(input, numPartitions, partitioned);
+  if (partitioned->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+    partitioned->GetPointData()->GetScalars() != input->GetPointData()->GetScalars())
+  {
+    std::cerr << numPartitions << " partitions: points or point data not passed" << std::endl;
+    return false;
+  }
+  if (partitioned->GetNumberOfCells() != serial->GetNumberOfCells() ||
+    GetTetras(partitioned) != GetTetras(serial))
+  {
+    std::cerr << numPartitions << " partitions: " << partitioned->GetNumberOfCells()
+              << " tetrahedra instead of the " << serial->GetNumberOfCells()
+              << " of the serial triangulation, or different ones" << std::endl;
+    return false;
+  }
+
+  // The partitioned output is ordered by partition: if the tetrahedra are in
+  // the serial order, the seams were not repaired and the filter fell back to
+  // the serial triangulation.
+  vtkIdType npts;
+  const vtkIdType* pts;
+  const vtkIdType* serialPts;
+  for (vtkIdType cellId = 0; cellId < serial->GetNumberOfCells(); ++cellId)
+  {
+    partitioned->GetCellPoints(cellId, npts, pts);
+    serial->GetCellPoints(cellId, npts, serialPts);
+    if (!std::equal(pts, pts + 4, serialPts))
+    {
+      return true;
+    }
+  }
+  std::cerr << numPartitions << " partitions: fell back to the serial triangulation" << std::endl;
+  return false;
+}
+
+// Check that the tetrahedra of the triangulation of a grid fill its box, and
+// that each face is shared by at most two of them.
+bool CheckGrid(vtkUnstructuredGrid* output, double volume)
+{
+  std::map<FaceIds, int> faceUses;
+  double totalVolume = 0.0;
+  double p[4][3];
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    output->GetCellPoints(cellId, npts, pts);
+    for (int i = 0; i < 4; ++i)
+    {
+      output->GetPoint(pts[i], p[i]);
+      FaceIds face = { { pts[(i + 1) % 4], pts[(i + 2) % 4], pts[(i + 3) % 4] } };
+      std::sort(face.begin(), face.end());
+      if (++faceUses[face] > 2)
+      {
+        std::cerr << "Grid: a face is used by more than two tetrahedra" << std::endl;
+        return false;
+      }
+    }
+    totalVolume += std::abs(vtkTetra::ComputeVolume(p[0], p[1], p[2], p[3]));
+  }
+  if (std::abs(totalVolume - volume) > 1e-6 * volume)
+  {
+    std::cerr << "Grid: the tetrahedra have a volume of " << totalVolume << " instead of " << volume
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDelaunay3DPartitioned(int argc, char* argv[])
+{
+  vtkIdType numPoints = 20000;
+  for (int i = 1; i < argc - 1; ++i)
+  {
+    if (!strcmp(argv[i], "--points"))
+    {
+      numPoints = atoi(argv[i + 1]);
+    }
+  }
+
+  // Random points are in general position, so their Delaunay triangulation
+  // is unique.
+  vtkNew<vtkPolyData> input;
+  MakeRandomPoints(numPoints, VTK_DOUBLE, input);
+  vtkNew<vtkUnstructuredGrid> serial;
+  const double serialTime = Triangulate(input, 1, serial);
+  for (int numPartitions : { 2, 3, 8, 16 })
+  {
+    if (!SameAsSerial(input, serial, numPartitions))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtkNew<vtkPolyData> floatInput;
+  MakeRandomPoints(5000, VTK_FLOAT, floatInput);
+  vtkNew<vtkUnstructuredGrid> floatSerial;
+  Triangulate(floatInput, 1, floatSerial);
+  if (!SameAsSerial(floatInput, floatSerial, 4))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A grid has many co-spherical points: the triangulation is not unique,
+  // but it must still be valid (possibly by falling back to the serial one).
+  vtkNew<vtkPoints> gridPoints;
+  const int dims[3] = { 24, 16, 12 };
+  for (int k = 0; k < dims[2]; ++k)
+  {
+    for (int j = 0; j < dims[1]; ++j)
+    {
+      for (int i = 0; i < dims[0]; ++i)
+      {
+        gridPoints->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  vtkNew<vtkPolyData> grid;
+  grid->SetPoints(gridPoints);
+  vtkNew<vtkUnstructuredGrid> gridOutput;
+  Triangulate(grid, 4, gridOutput);
+  if (!CheckGrid(gridOutput, (dims[0] - 1.0) * (dims[1] - 1.0) * (dims[2] - 1.0)))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Scaling: one partition per thread
+  std::cout << "Triangulated " << numPoints << " random points (" << vtkSMPTools::GetBackend()
+            << " backend)\n";
+  std::cout << "  serial: " << serial->GetNumberOfCells() << " tetrahedra in " << serialTime
+            << " s\n";
+  const int maxThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+  {
+    vtkNew<vtkUnstructuredGrid> partitioned;
+    double time = 0.0;
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ numThreads },
+      [&]() { time = Triangulate(input, std::max(2, numThreads), partitioned); });
+    std::cout << "  " << std::max(2, numThreads) << " partitions, " << numThreads
+              << " threads: " << partitioned->GetNumberOfCells() << " tetrahedra in " << time
+              << " s\n";
+  }
+  std::cout.flush();
+
+  return EXIT_SUCCESS;
+}
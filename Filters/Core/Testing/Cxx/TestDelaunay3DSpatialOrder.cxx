@@ -0,0 +1,185 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelaunay3DSpatialOrder.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkDelaunay3D generates a valid Delaunay triangulation when
+// points are inserted in input order and in spatial order, and that both
+// orders give the same tetrahedra.
+
+#include <vtkDelaunay3D.h>
+#include <vtkIdList.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkStaticPointLocator.h>
+#include <vtkTetra.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <set>
+
+namespace
+{
+typedef std::array<vtkIdType, 4> TetraIds;
+typedef std::array<vtkIdType, 3> FaceIds;
+
+// Check that the output is made of non degenerate tetrahedra, that each face
+// is shared by at most two of them, and that no input point lies inside the
+// circumsphere of a tetrahedron.
+bool CheckDelaunay(vtkPolyData* input, vtkUnstructuredGrid* output, const char* name)
+{
+  const vtkIdType numPoints = input->GetNumberOfPoints();
+  if (output->GetNumberOfPoints() != numPoints)
+  {
+    std::cerr << name << ": expected " << numPoints << " points, got "
+              << output->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(input);
+  locator->BuildLocator();
+  vtkNew<vtkIdList> closePoints;
+
+  std::map<FaceIds, int> faceUses;
+  std::set<vtkIdType> usedPoints;
+  double p[4][3];
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    if (output->GetCellType(cellId) != VTK_TETRA)
+    {
+      std::cerr << name << ": cell " << cellId << " is not a tetrahedron" << std::endl;
+      return false;
+    }
+    output->GetCellPoints(cellId, npts, pts);
+    for (int i = 0; i < 4; ++i)
+    {
+      output->GetPoint(pts[i], p[i]);
+      usedPoints.insert(pts[i]);
+    }
+    if (std::abs(vtkTetra::ComputeVolume(p[0], p[1], p[2], p[3])) < 1e-14)
+    {
+      std::cerr << name << ": tetrahedron " << cellId << " is degenerate" << std::endl;
+      return false;
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+      FaceIds face = { { pts[(i + 1) % 4], pts[(i + 2) % 4], pts[(i + 3) % 4] } };
+      std::sort(face.begin(), face.end());
+      if (++faceUses[face] > 2)
+      {
+        std::cerr << name << ": a face of tetrahedron " << cellId
+                  << " is used by more than two tetrahedra" << std::endl;
+        return false;
+      }
+    }
+
+    double center[3];
+    const double radius2 = vtkTetra::Circumsphere(p[0], p[1], p[2], p[3], center);
+    const double radius = std::sqrt(radius2);
+    locator->FindPointsWithinRadius(radius * (1.0 - 1e-6), center, closePoints);
+    for (vtkIdType i = 0; i < closePoints->GetNumberOfIds(); ++i)
+    {
+      const vtkIdType ptId = closePoints->GetId(i);
+      if (ptId != pts[0] && ptId != pts[1] && ptId != pts[2] && ptId != pts[3])
+      {
+        std::cerr << name << ": point " << ptId << " is inside the circumsphere of tetrahedron "
+                  << cellId << std::endl;
+        return false;
+      }
+    }
+  }
+
+  if (static_cast<vtkIdType>(usedPoints.size()) != numPoints)
+  {
+    std::cerr << name << ": " << numPoints - usedPoints.size() << " points are not triangulated"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+std::set<TetraIds> GetTetras(vtkUnstructuredGrid* output)
+{
+  std::set<TetraIds> tetras;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    output->GetCellPoints(cellId, npts, pts);
+    TetraIds tetra = { { pts[0], pts[1], pts[2], pts[3] } };
+    std::sort(tetra.begin(), tetra.end());
+    tetras.insert(tetra);
+  }
+  return tetras;
+}
+
+void Triangulate(vtkPolyData* input, int order, vtkUnstructuredGrid* output)
+{
+  vtkNew<vtkDelaunay3D> delaunay;
+  delaunay->SetInputData(input);
+  delaunay->SetPointInsertionOrder(order);
+  delaunay->Update();
+  output->ShallowCopy(delaunay->GetOutput());
+}
+}
+
+int TestDelaunay3DSpatialOrder(int, char*[])
+{
+  // Random points are in general position, so their Delaunay triangulation
+  // is unique.
+  const vtkIdType numPoints = 2000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPoints);
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] = random->GetValue();
+      random->Next();
+    }
+    points->SetPoint(ptId, x);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+
+  vtkNew<vtkUnstructuredGrid> inputOrder;
+  Triangulate(input, vtkDelaunay3D::INPUT_ORDER, inputOrder);
+  vtkNew<vtkUnstructuredGrid> spatialOrder;
+  Triangulate(input, vtkDelaunay3D::SPATIAL_ORDER, spatialOrder);
+
+  if (!CheckDelaunay(input, inputOrder, "input order") ||
+    !CheckDelaunay(input, spatialOrder, "spatial order"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (GetTetras(inputOrder) != GetTetras(spatialOrder))
+  {
+    std::cerr << "The tetrahedra differ between input and spatial order" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
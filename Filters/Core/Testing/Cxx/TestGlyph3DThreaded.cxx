@@ -0,0 +1,383 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyph3DThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Glyph many points, with a table of glyphs and with glyphs made of several
+// types of cells, and check that the glyphs are placed where expected, that
+// the cell data follows the cells, and that the output does not depend on
+// the number of threads. Bit arrays, which cannot be written concurrently,
+// must be copied too.
+
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+void Glyph(vtkGlyph3D* glyph3D, vtkPolyData* output)
+{
+  glyph3D->Update();
+  output->DeepCopy(glyph3D->GetOutput());
+}
+
+bool SameArray(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  const int numComps = a->GetNumberOfComponents();
+  for (vtkIdType idx = 0; idx < a->GetNumberOfValues(); ++idx)
+  {
+    if (a->GetComponent(idx / numComps, idx % numComps) !=
+      b->GetComponent(idx / numComps, idx % numComps))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells() ||
+    !SameArray(a->GetPoints()->GetData(), b->GetPoints()->GetData()) ||
+    a->GetPointData()->GetNumberOfArrays() != b->GetPointData()->GetNumberOfArrays() ||
+    a->GetCellData()->GetNumberOfArrays() != b->GetCellData()->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetPointData()->GetNumberOfArrays(); ++i)
+  {
+    if (!SameArray(a->GetPointData()->GetArray(i), b->GetPointData()->GetArray(i)))
+    {
+      return false;
+    }
+  }
+  for (int i = 0; i < a->GetCellData()->GetNumberOfArrays(); ++i)
+  {
+    if (!SameArray(a->GetCellData()->GetArray(i), b->GetCellData()->GetArray(i)))
+    {
+      return false;
+    }
+  }
+  vtkIdType nptsA, nptsB;
+  const vtkIdType* ptsA;
+  const vtkIdType* ptsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellPoints(cellId, nptsA, ptsA);
+    b->GetCellPoints(cellId, nptsB, ptsB);
+    if (nptsA != nptsB || !std::equal(ptsA, ptsA + nptsA, ptsB))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestManyPoints()
+{
+  // A grid of points with scalars and vectors, larger than a block of points.
+  const int dim = 60;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (int j = 0; j < dim; ++j)
+  {
+    for (int i = 0; i < dim; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.0);
+      scalars->InsertNextValue(std::sin(0.1 * i) * std::cos(0.1 * j));
+      vectors->InsertNextTuple3(std::cos(0.2 * j), std::sin(0.2 * i), 0.5);
+    }
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(8);
+  sphere->SetPhiResolution(6);
+
+  vtkNew<vtkGlyph3D> glyph3D;
+  glyph3D->SetInputData(input);
+  glyph3D->SetSourceConnection(sphere->GetOutputPort());
+  glyph3D->SetScaleModeToScaleByVector();
+  glyph3D->SetScaleFactor(0.4);
+  glyph3D->FillCellDataOn();
+  glyph3D->GeneratePointIdsOn();
+
+  vtkNew<vtkPolyData> threaded;
+  Glyph(glyph3D, threaded);
+  vtkNew<vtkPolyData> serial;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { Glyph(glyph3D, serial); });
+  if (!SameOutput(threaded, serial))
+  {
+    std::cerr << "Output depends on the number of threads" << std::endl;
+    return false;
+  }
+
+  sphere->Update();
+  const vtkIdType numSourcePts = sphere->GetOutput()->GetNumberOfPoints();
+  if (threaded->GetNumberOfPoints() != dim * dim * numSourcePts ||
+    threaded->GetNumberOfPolys() != dim * dim * sphere->GetOutput()->GetNumberOfPolys())
+  {
+    std::cerr << "Wrong number of glyph points or polygons" << std::endl;
+    return false;
+  }
+  vtkDataArray* pointIds = threaded->GetPointData()->GetArray("InputPointIds");
+  if (!pointIds || !threaded->GetPointData()->GetNormals())
+  {
+    std::cerr << "Missing point ids or normals" << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < threaded->GetNumberOfPoints(); ++ptId)
+  {
+    if (pointIds->GetComponent(ptId, 0) != ptId / numSourcePts)
+    {
+      std::cerr << "Wrong input point id of point " << ptId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestBitArrays()
+{
+  // Enough points for several blocks, with a bit array as plain point data
+  // and a bit array as color scalars.
+  const vtkIdType numPts = 3000;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkBitArray> flags;
+  flags->SetName("Flags");
+  vtkNew<vtkBitArray> colors;
+  colors->SetName("Colors");
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    points->InsertNextPoint(ptId, 0.0, 0.0);
+    flags->InsertNextValue(ptId % 3 == 0);
+    colors->InsertNextValue(ptId % 5 == 1);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(flags);
+  input->GetPointData()->SetScalars(colors);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(4);
+  sphere->SetPhiResolution(4);
+  sphere->Update();
+  const vtkIdType numSourcePts = sphere->GetOutput()->GetNumberOfPoints();
+  const vtkIdType numSourceCells = sphere->GetOutput()->GetNumberOfCells();
+
+  vtkNew<vtkGlyph3D> glyph3D;
+  glyph3D->SetInputData(input);
+  glyph3D->SetSourceConnection(sphere->GetOutputPort());
+  glyph3D->SetScaleModeToDataScalingOff();
+  glyph3D->SetColorModeToColorByScalar();
+  glyph3D->FillCellDataOn();
+
+  vtkNew<vtkPolyData> threaded;
+  Glyph(glyph3D, threaded);
+  vtkNew<vtkPolyData> serial;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { Glyph(glyph3D, serial); });
+  if (!SameOutput(threaded, serial))
+  {
+    std::cerr << "Output with bit arrays depends on the number of threads" << std::endl;
+    return false;
+  }
+
+  vtkDataArray* pointFlags = threaded->GetPointData()->GetArray("Flags");
+  vtkDataArray* pointColors = threaded->GetPointData()->GetArray("Colors");
+  vtkDataArray* cellFlags = threaded->GetCellData()->GetArray("Flags");
+  if (!vtkBitArray::SafeDownCast(pointFlags) || !vtkBitArray::SafeDownCast(pointColors) ||
+    !vtkBitArray::SafeDownCast(cellFlags))
+  {
+    std::cerr << "Bit arrays are missing from the output" << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < threaded->GetNumberOfPoints(); ++ptId)
+  {
+    const vtkIdType inPtId = ptId / numSourcePts;
+    if (pointFlags->GetComponent(ptId, 0) != (inPtId % 3 == 0) ||
+      pointColors->GetComponent(ptId, 0) != (inPtId % 5 == 1))
+    {
+      std::cerr << "Wrong bit values of point " << ptId << std::endl;
+      return false;
+    }
+  }
+  for (vtkIdType cellId = 0; cellId < threaded->GetNumberOfCells(); ++cellId)
+  {
+    if (cellFlags->GetComponent(cellId, 0) != ((cellId / numSourceCells) % 3 == 0))
+    {
+      std::cerr << "Wrong bit value of cell " << cellId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestPlacement()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(1.0, 2.0, 3.0);
+  points->InsertNextPoint(-1.0, 0.0, 0.5);
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+
+  // The default glyph is a line from (0,0,0) to (1,0,0).
+  vtkNew<vtkGlyph3D> glyph3D;
+  glyph3D->SetInputData(input);
+  glyph3D->SetScaleModeToDataScalingOff();
+  glyph3D->SetScaleFactor(2.0);
+  glyph3D->Update();
+
+  vtkPolyData* output = glyph3D->GetOutput();
+  const double expected[4][3] = { { 1.0, 2.0, 3.0 }, { 3.0, 2.0, 3.0 }, { -1.0, 0.0, 0.5 },
+    { 1.0, 0.0, 0.5 } };
+  if (output->GetNumberOfPoints() != 4 || output->GetNumberOfLines() != 2)
+  {
+    std::cerr << "Wrong number of glyph points or lines" << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < 4; ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    if (x[0] != expected[ptId][0] || x[1] != expected[ptId][1] || x[2] != expected[ptId][2])
+    {
+      std::cerr << "Wrong position of glyph point " << ptId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestTableAndCellTypes()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(10.0, 0.0, 0.0);
+  points->InsertNextPoint(20.0, 0.0, 0.0);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->InsertNextValue(0.2);
+  scalars->InsertNextValue(0.8);
+  scalars->InsertNextValue(0.3);
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+
+  // A glyph made of a vertex and a triangle, and a glyph made of a line.
+  vtkNew<vtkPoints> mixedPoints;
+  mixedPoints->InsertNextPoint(0.0, 0.0, 0.0);
+  mixedPoints->InsertNextPoint(1.0, 0.0, 0.0);
+  mixedPoints->InsertNextPoint(0.0, 1.0, 0.0);
+  vtkNew<vtkPolyData> mixed;
+  mixed->SetPoints(mixedPoints);
+  mixed->AllocateEstimate(2, 3);
+  const vtkIdType triangle[3] = { 0, 1, 2 };
+  mixed->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  mixed->InsertNextCell(VTK_VERTEX, 1, triangle + 2);
+  vtkNew<vtkPoints> linePoints;
+  linePoints->InsertNextPoint(0.0, 0.0, 0.0);
+  linePoints->InsertNextPoint(0.0, 0.0, 1.0);
+  vtkNew<vtkPolyData> line;
+  line->SetPoints(linePoints);
+  line->AllocateEstimate(1, 2);
+  line->InsertNextCell(VTK_LINE, 2, triangle);
+
+  // Without indexing, the cell data of each type of cells follows the input
+  // points.
+  vtkNew<vtkGlyph3D> glyph3D;
+  glyph3D->SetInputData(input);
+  glyph3D->SetSourceData(mixed);
+  glyph3D->SetScaleModeToDataScalingOff();
+  glyph3D->FillCellDataOn();
+  glyph3D->Update();
+  vtkPolyData* output = glyph3D->GetOutput();
+  vtkDataArray* cellScalars = output->GetCellData()->GetArray("Scalars");
+  const double expectedScalars[6] = { 0.2, 0.8, 0.3, 0.2, 0.8, 0.3 };
+  if (output->GetNumberOfVerts() != 3 || output->GetNumberOfPolys() != 3 || !cellScalars)
+  {
+    std::cerr << "Wrong glyph cells" << std::endl;
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellId < 6; ++cellId)
+  {
+    if (cellScalars->GetComponent(cellId, 0) != expectedScalars[cellId])
+    {
+      std::cerr << "Wrong cell data of cell " << cellId << std::endl;
+      return false;
+    }
+  }
+
+  // With indexing by scalar, each point picks its glyph in the table.
+  glyph3D->SetSourceData(0, mixed);
+  glyph3D->SetSourceData(1, line);
+  glyph3D->SetIndexModeToScalar();
+  glyph3D->SetRange(0.0, 1.0);
+  glyph3D->Update();
+  output = glyph3D->GetOutput();
+  if (output->GetNumberOfPoints() != 8 || output->GetNumberOfVerts() != 2 ||
+    output->GetNumberOfLines() != 1 || output->GetNumberOfPolys() != 2)
+  {
+    std::cerr << "Wrong glyphs picked in the table" << std::endl;
+    return false;
+  }
+  double x[3];
+  output->GetPoint(4, x);
+  if (x[0] != 10.0 || x[1] != 0.0 || x[2] != 1.0)
+  {
+    std::cerr << "Wrong position of the indexed glyph" << std::endl;
+    return false;
+  }
+  vtkIdType npts;
+  const vtkIdType* pts;
+  output->GetLines()->GetCellAtId(0, npts, pts);
+  if (npts != 2 || pts[0] != 3 || pts[1] != 4)
+  {
+    std::cerr << "Wrong connectivity of the indexed glyph" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestGlyph3DThreaded(int, char*[])
+{
+  if (!TestManyPoints() || !TestBitArrays() || !TestPlacement() || !TestTableAndCellTypes())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -16,12 +16,16 @@
 #include <vtkAppendPolyData.h>
 #include <vtkCellArray.h>
 #include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
 #include <vtkMinimalStandardRandomSequence.h>
 #include <vtkPointData.h>
 #include <vtkPolyDataConnectivityFilter.h>
 #include <vtkSmartPointer.h>
 #include <vtkSphereSource.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace
 {
 void InitializePolyData(vtkPolyData* polyData, int dataType)
@@ -185,6 +189,159 @@ bool MarkVisitedPoints()
 
   return succeeded;
 }
+// Label the regions with a serial wave propagation, as the filter used to.
+void LabelRegions(vtkPolyData* mesh, vtkDataArray* scalars, const double range[2],
+  std::vector<vtkIdType>& cellRegions, std::vector<vtkIdType>& pointRegions,
+  std::vector<vtkIdType>& regionSizes)
+{
+  mesh->BuildLinks();
+  cellRegions.assign(mesh->GetNumberOfCells(), -1);
+  pointRegions.assign(mesh->GetNumberOfPoints(), -1);
+  regionSizes.clear();
+  auto isConnected = [mesh, scalars, range](vtkIdType cellId) {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    mesh->GetCellPoints(cellId, npts, pts);
+    double minValue = VTK_DOUBLE_MAX, maxValue = -VTK_DOUBLE_MAX;
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const double s = static_cast<float>(scalars->GetComponent(pts[i], 0));
+      minValue = std::min(minValue, s);
+      maxValue = std::max(maxValue, s);
+    }
+    return maxValue >= range[0] && minValue <= range[1];
+  };
+  for (vtkIdType seedId = 0; seedId < mesh->GetNumberOfCells(); ++seedId)
+  {
+    if (cellRegions[seedId] >= 0)
+    {
+      continue;
+    }
+    const vtkIdType region = static_cast<vtkIdType>(regionSizes.size());
+    regionSizes.push_back(0);
+    std::vector<vtkIdType> wave(1, seedId);
+    while (!wave.empty())
+    {
+      std::vector<vtkIdType> nextWave;
+      for (vtkIdType cellId : wave)
+      {
+        if (cellRegions[cellId] >= 0)
+        {
+          continue;
+        }
+        cellRegions[cellId] = region;
+        ++regionSizes[region];
+        vtkIdType npts;
+        const vtkIdType* pts;
+        mesh->GetCellPoints(cellId, npts, pts);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          if (pointRegions[pts[i]] >= 0)
+          {
+            continue;
+          }
+          pointRegions[pts[i]] = region;
+          vtkIdType ncells;
+          vtkIdType* cells;
+          mesh->GetPointCells(pts[i], ncells, cells);
+          for (vtkIdType j = 0; j < ncells; ++j)
+          {
+            if (!scalars || isConnected(cells[j]))
+            {
+              nextWave.push_back(cells[j]);
+            }
+          }
+        }
+      }
+      wave.swap(nextWave);
+    }
+  }
+}
+
+bool CheckAllRegions(vtkPolyData* input, bool scalarConnectivity)
+{
+  const double range[2] = { -0.2, 0.2 };
+  vtkNew<vtkPolyDataConnectivityFilter> connectivity;
+  connectivity->SetInputData(input);
+  connectivity->SetExtractionModeToAllRegions();
+  connectivity->ColorRegionsOn();
+  connectivity->SetScalarConnectivity(scalarConnectivity);
+  connectivity->SetScalarRange(range[0], range[1]);
+  connectivity->Update();
+  vtkPolyData* output = connectivity->GetOutput();
+
+  std::vector<vtkIdType> cellRegions, pointRegions, regionSizes;
+  vtkNew<vtkPolyData> mesh;
+  mesh->CopyStructure(input);
+  LabelRegions(mesh, scalarConnectivity ? input->GetPointData()->GetScalars() : nullptr, range,
+    cellRegions, pointRegions, regionSizes);
+
+  if (connectivity->GetNumberOfExtractedRegions() != static_cast<int>(regionSizes.size()))
+  {
+    std::cerr << "Wrong number of regions " << connectivity->GetNumberOfExtractedRegions()
+              << ", expected " << regionSizes.size() << std::endl;
+    return false;
+  }
+  for (vtkIdType region = 0; region < static_cast<vtkIdType>(regionSizes.size()); ++region)
+  {
+    if (connectivity->GetRegionSizes()->GetValue(region) != regionSizes[region])
+    {
+      std::cerr << "Wrong size for region " << region << std::endl;
+      return false;
+    }
+  }
+
+  // The output points keep the order of the input points.
+  vtkDataArray* regionIds = output->GetPointData()->GetArray("RegionId");
+  if (output->GetNumberOfPoints() != input->GetNumberOfPoints() || !regionIds)
+  {
+    std::cerr << "Wrong output points" << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    if (regionIds->GetComponent(ptId, 0) != pointRegions[ptId])
+    {
+      std::cerr << "Wrong region for point " << ptId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool AllRegions()
+{
+  // Many disconnected spheres, with the x coordinate as scalars: scalar
+  // connectivity breaks them into more regions.
+  vtkNew<vtkAppendPolyData> spheres;
+  for (int k = 0; k < 4; ++k)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        vtkNew<vtkSphereSource> sphere;
+        sphere->SetCenter(3 - i, j, k);
+        sphere->SetThetaResolution(12);
+        sphere->SetPhiResolution(12);
+        sphere->Update();
+        spheres->AddInputData(sphere->GetOutput());
+      }
+    }
+  }
+  spheres->Update();
+  vtkNew<vtkPolyData> input;
+  input->ShallowCopy(spheres->GetOutput());
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    scalars->SetValue(ptId, static_cast<float>(input->GetPoint(ptId)[0] - 1.5));
+  }
+  input->GetPointData()->SetScalars(scalars);
+
+  return CheckAllRegions(input, false) && CheckAllRegions(input, true);
+}
 }
 
 int TestPolyDataConnectivityFilter(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
@@ -236,5 +393,10 @@ int TestPolyDataConnectivityFilter(int vtkNotUsed(argc), char* vtkNotUsed(argv)[
     return EXIT_FAILURE;
   }
 
+  if (!AllRegions())
+  {
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
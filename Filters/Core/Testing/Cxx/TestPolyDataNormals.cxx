@@ -0,0 +1,181 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataNormals.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compute the normals of a sphere with inconsistently ordered polygons and
+// of a cube with sharp edges, and check that the polygons are reordered, the
+// sharp edges split, and that the output does not depend on the number of
+// threads.
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkCleanPolyData.h>
+#include <vtkCubeSource.h>
+#include <vtkDataArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataNormals.h>
+#include <vtkSMPTools.h>
+#include <vtkSphereSource.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+void ComputeNormals(vtkPolyData* input, bool autoOrient, vtkPolyData* output)
+{
+  vtkNew<vtkPolyDataNormals> normals;
+  normals->SetInputData(input);
+  normals->SetAutoOrientNormals(autoOrient);
+  normals->ComputeCellNormalsOn();
+  normals->Update();
+  output->ShallowCopy(normals->GetOutput());
+}
+
+bool SameArray(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  for (vtkIdType idx = 0; idx < a->GetNumberOfValues(); ++idx)
+  {
+    if (a->GetComponent(idx / 3, idx % 3) != b->GetComponent(idx / 3, idx % 3))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfPolys() != b->GetNumberOfPolys() ||
+    !SameArray(a->GetPointData()->GetNormals(), b->GetPointData()->GetNormals()) ||
+    !SameArray(a->GetCellData()->GetNormals(), b->GetCellData()->GetNormals()))
+  {
+    return false;
+  }
+  vtkIdType npts;
+  const vtkIdType* ptsA;
+  const vtkIdType* ptsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellPoints(cellId, npts, ptsA);
+    b->GetCellPoints(cellId, npts, ptsB);
+    if (!std::equal(ptsA, ptsA + npts, ptsB))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestPolyDataNormals(int, char*[])
+{
+  // A sphere with one polygon out of three reversed.
+  vtkNew<vtkSphereSource> sphereSource;
+  sphereSource->SetThetaResolution(100);
+  sphereSource->SetPhiResolution(100);
+  sphereSource->Update();
+  vtkNew<vtkPolyData> sphere;
+  sphere->DeepCopy(sphereSource->GetOutput());
+  sphere->GetPointData()->SetNormals(nullptr);
+  for (vtkIdType cellId = 1; cellId < sphere->GetNumberOfPolys(); cellId += 3)
+  {
+    sphere->GetPolys()->ReverseCellAtId(cellId);
+  }
+
+  // Consistency alone orders the polygons like the first one, which is not
+  // reversed: the normals point outward. Auto orientation does the same.
+  for (int autoOrient = 0; autoOrient < 2; ++autoOrient)
+  {
+    vtkNew<vtkPolyData> oriented;
+    ComputeNormals(sphere, autoOrient != 0, oriented);
+    vtkDataArray* cellNormals = oriented->GetCellData()->GetNormals();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = 0; cellId < oriented->GetNumberOfCells(); ++cellId)
+    {
+      double x[3], normal[3];
+      oriented->GetCellPoints(cellId, npts, pts);
+      oriented->GetPoint(pts[0], x);
+      cellNormals->GetTuple(cellId, normal);
+      if (x[0] * normal[0] + x[1] * normal[1] + x[2] * normal[2] < 0.45)
+      {
+        std::cerr << "Wrong ordering of cell " << cellId << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    vtkDataArray* pointNormals = oriented->GetPointData()->GetNormals();
+    for (vtkIdType ptId = 0; ptId < oriented->GetNumberOfPoints(); ++ptId)
+    {
+      double x[3], normal[3];
+      oriented->GetPoint(ptId, x);
+      pointNormals->GetTuple(ptId, normal);
+      if (x[0] * normal[0] + x[1] * normal[1] + x[2] * normal[2] < 0.49)
+      {
+        std::cerr << "Wrong normal at point " << ptId << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    vtkNew<vtkPolyData> serial;
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 },
+      [&]() { ComputeNormals(sphere, autoOrient != 0, serial); });
+    if (!SameOutput(oriented, serial))
+    {
+      std::cerr << "Output depends on the number of threads" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The 8 corners of a cube are split in 3 points each, with axis aligned
+  // normals.
+  vtkNew<vtkCubeSource> cubeSource;
+  vtkNew<vtkCleanPolyData> clean;
+  clean->SetInputConnection(cubeSource->GetOutputPort());
+  clean->Update();
+  vtkNew<vtkPolyData> cube;
+  cube->ShallowCopy(clean->GetOutput());
+  cube->GetPointData()->SetNormals(nullptr);
+  vtkNew<vtkPolyData> split;
+  ComputeNormals(cube, false, split);
+  if (cube->GetNumberOfPoints() != 8 || split->GetNumberOfPoints() != 24)
+  {
+    std::cerr << "Wrong number of split points " << split->GetNumberOfPoints() << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkDataArray* pointNormals = split->GetPointData()->GetNormals();
+  for (vtkIdType ptId = 0; ptId < split->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], normal[3];
+    split->GetPoint(ptId, x);
+    pointNormals->GetTuple(ptId, normal);
+    const double maxComponent =
+      std::max(std::abs(normal[0]), std::max(std::abs(normal[1]), std::abs(normal[2])));
+    if (std::abs(maxComponent - 1.0) > 1e-6 ||
+      std::abs(x[0] * normal[0] + x[1] * normal[1] + x[2] * normal[2] - 0.5) > 1e-6)
+    {
+      std::cerr << "Wrong split normal at point " << ptId << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,355 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedQuadricDecimation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Decimate a sphere with vtkThreadedQuadricDecimation, vtkQuadricDecimation
+// and vtkDecimatePro, and compare how far the decimated vertices are from the
+// sphere. The timings are reported so that the test can also be used as a
+// benchmark: pass "--triangles N" to change the size of the sphere.
+
+#include <vtkBitArray.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDecimatePro.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkNew.h>
+#include <vtkPlaneSource.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkQuadricDecimation.h>
+#include <vtkSMPTools.h>
+#include <vtkSphereSource.h>
+#include <vtkStringArray.h>
+#include <vtkThreadedQuadricDecimation.h>
+#include <vtkTimerLog.h>
+#include <vtkTriangleFilter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+const double Radius = 0.5;
+
+// Decimate the input, returning the elapsed time.
+template <typename FilterType>
+double Decimate(FilterType* filter, vtkPolyData* input, vtkPolyData* output)
+{
+  filter->SetInputData(input);
+  filter->SetTargetReduction(0.9);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  filter->Update();
+  timer->StopTimer();
+
+  output->ShallowCopy(filter->GetOutput());
+  return timer->GetElapsedTime();
+}
+
+// Maximum and root mean square distance of the points to the sphere.
+void SphereDistance(vtkPolyData* mesh, double& maxDistance, double& rmsDistance)
+{
+  maxDistance = rmsDistance = 0.0;
+  for (vtkIdType ptId = 0; ptId < mesh->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    mesh->GetPoint(ptId, x);
+    const double distance = std::abs(std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]) - Radius);
+    maxDistance = std::max(maxDistance, distance);
+    rmsDistance += distance * distance;
+  }
+  rmsDistance = std::sqrt(rmsDistance / std::max<vtkIdType>(1, mesh->GetNumberOfPoints()));
+}
+
+void Report(const char* name, vtkPolyData* mesh, double time)
+{
+  double maxDistance, rmsDistance;
+  SphereDistance(mesh, maxDistance, rmsDistance);
+  std::cout << "  " << name << ": " << mesh->GetNumberOfPolys() << " triangles in " << time
+            << "s, max distance " << maxDistance << ", rms distance " << rmsDistance << "\n";
+}
+
+// Add the z coordinate and its sign as point data, and the cell ids, their
+// parity and their names as cell data. The bit and string arrays cannot be
+// copied concurrently.
+void AddAttributes(vtkPolyData* mesh)
+{
+  vtkNew<vtkDoubleArray> zCoords;
+  zCoords->SetName("Z");
+  zCoords->SetNumberOfTuples(mesh->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < mesh->GetNumberOfPoints(); ++ptId)
+  {
+    zCoords->SetValue(ptId, mesh->GetPoint(ptId)[2]);
+  }
+  mesh->GetPointData()->AddArray(zCoords);
+
+  vtkNew<vtkBitArray> upper;
+  upper->SetName("Upper");
+  upper->SetNumberOfTuples(mesh->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < mesh->GetNumberOfPoints(); ++ptId)
+  {
+    upper->SetValue(ptId, mesh->GetPoint(ptId)[2] > 0.0);
+  }
+  mesh->GetPointData()->AddArray(upper);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellId");
+  cellIds->SetNumberOfTuples(mesh->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->SetValue(cellId, cellId);
+  }
+  mesh->GetCellData()->AddArray(cellIds);
+
+  vtkNew<vtkBitArray> odd;
+  odd->SetName("Odd");
+  vtkNew<vtkStringArray> names;
+  names->SetName("Name");
+  odd->SetNumberOfTuples(mesh->GetNumberOfCells());
+  names->SetNumberOfTuples(mesh->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    odd->SetValue(cellId, cellId % 2);
+    names->SetValue(cellId, std::to_string(cellId));
+  }
+  mesh->GetCellData()->AddArray(odd);
+  mesh->GetCellData()->AddArray(names);
+}
+
+bool SameOutput(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfPolys() != b->GetNumberOfPolys())
+  {
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < a->GetNumberOfPoints(); ++ptId)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(ptId, pa);
+    b->GetPoint(ptId, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+    {
+      return false;
+    }
+  }
+  vtkIdType npts;
+  const vtkIdType* ptsA;
+  const vtkIdType* ptsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellPoints(cellId, npts, ptsA);
+    b->GetCellPoints(cellId, npts, ptsB);
+    if (!std::equal(ptsA, ptsA + npts, ptsB))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestThreadedQuadricDecimation(int argc, char* argv[])
+{
+  vtkIdType numTriangles = 20000;
+  for (int i = 1; i < argc - 1; ++i)
+  {
+    if (!strcmp(argv[i], "--triangles"))
+    {
+      numTriangles = atoi(argv[i + 1]);
+    }
+  }
+
+  // A sphere of resolution r has about 2 r^2 triangles.
+  const int resolution = std::max(8, static_cast<int>(std::sqrt(0.5 * numTriangles)));
+  vtkNew<vtkSphereSource> sphereSource;
+  sphereSource->SetRadius(Radius);
+  sphereSource->SetThetaResolution(resolution);
+  sphereSource->SetPhiResolution(resolution);
+  sphereSource->Update();
+  vtkNew<vtkPolyData> sphere;
+  sphere->ShallowCopy(sphereSource->GetOutput());
+  AddAttributes(sphere);
+
+  vtkNew<vtkThreadedQuadricDecimation> threaded;
+  vtkNew<vtkPolyData> threadedOutput;
+  const double threadedTime = Decimate(threaded.GetPointer(), sphere, threadedOutput);
+  vtkNew<vtkQuadricDecimation> quadric;
+  vtkNew<vtkPolyData> quadricOutput;
+  const double quadricTime = Decimate(quadric.GetPointer(), sphere, quadricOutput);
+  vtkNew<vtkDecimatePro> pro;
+  vtkNew<vtkPolyData> proOutput;
+  const double proTime = Decimate(pro.GetPointer(), sphere, proOutput);
+
+  std::cout << "Decimated a sphere of " << sphere->GetNumberOfPolys() << " triangles with "
+            << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads ("
+            << vtkSMPTools::GetBackend() << " backend)\n";
+  Report("vtkThreadedQuadricDecimation", threadedOutput, threadedTime);
+  std::cout << "    in " << threaded->GetNumberOfPasses() << " passes\n";
+  Report("vtkQuadricDecimation", quadricOutput, quadricTime);
+  Report("vtkDecimatePro", proOutput, proTime);
+  std::cout.flush();
+
+  if (threaded->GetActualReduction() < threaded->GetTargetReduction())
+  {
+    std::cerr << "Target reduction not reached: " << threaded->GetActualReduction() << std::endl;
+    return EXIT_FAILURE;
+  }
+  double maxDistance, rmsDistance;
+  SphereDistance(threadedOutput, maxDistance, rmsDistance);
+  if (maxDistance > 0.02 * Radius)
+  {
+    std::cerr << "Decimated points too far from the sphere: " << maxDistance << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The point data is interpolated along the collapsed edges, and the cell
+  // data passed from the triangles that are kept.
+  vtkDataArray* zCoords = threadedOutput->GetPointData()->GetArray("Z");
+  vtkDataArray* upper = threadedOutput->GetPointData()->GetArray("Upper");
+  vtkDataArray* cellIds = threadedOutput->GetCellData()->GetArray("CellId");
+  vtkDataArray* odd = threadedOutput->GetCellData()->GetArray("Odd");
+  vtkStringArray* names =
+    vtkStringArray::SafeDownCast(threadedOutput->GetCellData()->GetAbstractArray("Name"));
+  if (!zCoords || zCoords->GetNumberOfTuples() != threadedOutput->GetNumberOfPoints() ||
+    !upper || upper->GetNumberOfTuples() != threadedOutput->GetNumberOfPoints() || !cellIds ||
+    cellIds->GetNumberOfTuples() != threadedOutput->GetNumberOfCells() || !odd ||
+    odd->GetNumberOfTuples() != threadedOutput->GetNumberOfCells() || !names ||
+    names->GetNumberOfTuples() != threadedOutput->GetNumberOfCells())
+  {
+    std::cerr << "Missing attributes" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType ptId = 0; ptId < threadedOutput->GetNumberOfPoints(); ++ptId)
+  {
+    if (std::abs(zCoords->GetComponent(ptId, 0) - threadedOutput->GetPoint(ptId)[2]) >
+      0.02 * Radius)
+    {
+      std::cerr << "Wrong interpolated point data for point " << ptId << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  for (vtkIdType cellId = 0; cellId < threadedOutput->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType inputId = static_cast<vtkIdType>(cellIds->GetComponent(cellId, 0));
+    if ((cellId > 0 && inputId <= cellIds->GetComponent(cellId - 1, 0)) ||
+      odd->GetComponent(cellId, 0) != inputId % 2 ||
+      names->GetValue(cellId) != std::to_string(inputId))
+    {
+      std::cerr << "Wrong cell data for cell " << cellId << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The output must not depend on the number of threads.
+  vtkNew<vtkPolyData> serialOutput;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() {
+    vtkNew<vtkThreadedQuadricDecimation> serial;
+    Decimate(serial.GetPointer(), sphere, serialOutput);
+  });
+  if (!SameOutput(threadedOutput, serialOutput))
+  {
+    std::cerr << "Output depends on the number of threads" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // With the attribute error metric and volume preservation, the scalars
+  // are part of the error, and set to their optimal values.
+  vtkNew<vtkPolyData> scalarSphere;
+  scalarSphere->ShallowCopy(sphere);
+  scalarSphere->GetPointData()->SetActiveScalars("Z");
+  vtkNew<vtkPolyData> attributeOutputs[2];
+  double attributeReductions[2];
+  auto decimateAttributes = [&](int i) {
+    vtkNew<vtkThreadedQuadricDecimation> attribute;
+    attribute->AttributeErrorMetricOn();
+    attribute->VolumePreservationOn();
+    Decimate(attribute.GetPointer(), scalarSphere, attributeOutputs[i]);
+    attributeReductions[i] = attribute->GetActualReduction();
+  };
+  decimateAttributes(0);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { decimateAttributes(1); });
+  if (attributeReductions[0] < 0.9)
+  {
+    std::cerr << "Target reduction not reached with the attribute error metric: "
+              << attributeReductions[0] << std::endl;
+    return EXIT_FAILURE;
+  }
+  SphereDistance(attributeOutputs[0], maxDistance, rmsDistance);
+  vtkDataArray* scalars = attributeOutputs[0]->GetPointData()->GetScalars();
+  if (maxDistance > 0.02 * Radius || !scalars)
+  {
+    std::cerr << "Wrong output with the attribute error metric" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType ptId = 0; ptId < attributeOutputs[0]->GetNumberOfPoints(); ++ptId)
+  {
+    if (std::abs(scalars->GetComponent(ptId, 0) - attributeOutputs[0]->GetPoint(ptId)[2]) >
+      0.02 * Radius)
+    {
+      std::cerr << "Wrong optimal scalars for point " << ptId << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (!SameOutput(attributeOutputs[0], attributeOutputs[1]))
+  {
+    std::cerr << "Output depends on the number of threads with the attribute error metric"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A tight error bound stops the decimation early.
+  vtkNew<vtkThreadedQuadricDecimation> bounded;
+  bounded->SetMaximumError(1e-5 * Radius);
+  vtkNew<vtkPolyData> boundedOutput;
+  Decimate(bounded.GetPointer(), sphere, boundedOutput);
+  if (bounded->GetActualReduction() >= threaded->GetActualReduction())
+  {
+    std::cerr << "The maximum error did not limit the reduction" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A flat mesh is decimated without error, and its boundary is kept.
+  vtkNew<vtkPlaneSource> planeSource;
+  planeSource->SetResolution(20, 20);
+  vtkNew<vtkTriangleFilter> triangulate;
+  triangulate->SetInputConnection(planeSource->GetOutputPort());
+  triangulate->Update();
+  vtkNew<vtkThreadedQuadricDecimation> flat;
+  flat->SetMaximumError(1e-6);
+  vtkNew<vtkPolyData> flatOutput;
+  Decimate(flat.GetPointer(), triangulate->GetOutput(), flatOutput);
+  double inBounds[6], outBounds[6];
+  triangulate->GetOutput()->GetBounds(inBounds);
+  flatOutput->GetBounds(outBounds);
+  for (int i = 0; i < 6; ++i)
+  {
+    if (std::abs(inBounds[i] - outBounds[i]) > 1e-10)
+    {
+      std::cerr << "The boundary of the flat mesh was not preserved" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (flat->GetActualReduction() < 0.5)
+  {
+    std::cerr << "Flat mesh not decimated: " << flat->GetActualReduction() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,294 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectedRegionsInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConnectedRegionsInternal
+ * @brief   threaded labeling of the regions of cells connected through points
+ *
+ * ConnectedRegions labels all the cells of a dataset with the id of the
+ * region they belong to, two cells being connected when they share a point.
+ * The points are merged concurrently with a lock-free union-find, in which
+ * the root of a set is always its smallest point id, so the result does not
+ * depend on the order of the merges. The regions are then numbered in the
+ * order of their lowest cell id, which is the order in which a serial wave
+ * propagation seeded by each unvisited cell in turn discovers them.
+ *
+ * With scalar connectivity, only the cells whose point scalars fall in the
+ * scalar range connect to their neighbors. As in the serial traversal, a
+ * cell out of the range still starts a region when it is the lowest
+ * unvisited cell, and that region grows through all its points.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication
+ * between vtkConnectivityFilter and vtkPolyDataConnectivityFilter. At this
+ * time it is not meant to define a public API.
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectedRegionsInternal_h
+#define vtkConnectedRegionsInternal_h
+
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+class ConnectedRegions
+{
+public:
+  // Label the cells of the input. When scalars are given, a cell connects to
+  // its neighbors only if the scalars of any of its points (all of them when
+  // fullScalarConnectivity is set) fall in the scalar range.
+  void Label(vtkDataSet* input, vtkDataArray* scalars = nullptr,
+    const double scalarRange[2] = nullptr, bool fullScalarConnectivity = false);
+
+  // Region of each cell
+  std::vector<vtkIdType> CellRegions;
+
+  // Lowest region of the cells using each point, -1 for unused points
+  std::vector<vtkIdType> PointRegions;
+
+  // Number of cells of each region
+  std::vector<vtkIdType> RegionSizes;
+
+private:
+  vtkIdType Find(vtkIdType ptId)
+  {
+    // Path halving: the parents only ever decrease, so a stale read only
+    // slows the search down.
+    for (;;)
+    {
+      vtkIdType parent = this->Parents[ptId].load(std::memory_order_relaxed);
+      if (parent == ptId)
+      {
+        return ptId;
+      }
+      const vtkIdType grandParent = this->Parents[parent].load(std::memory_order_relaxed);
+      if (grandParent != parent)
+      {
+        this->Parents[ptId].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+      }
+      ptId = grandParent;
+    }
+  }
+
+  void Union(vtkIdType ptId0, vtkIdType ptId1)
+  {
+    for (;;)
+    {
+      vtkIdType root0 = this->Find(ptId0);
+      vtkIdType root1 = this->Find(ptId1);
+      if (root0 == root1)
+      {
+        return;
+      }
+      if (root0 < root1)
+      {
+        std::swap(root0, root1);
+      }
+      // Link the larger root below the smaller one, if it still is a root.
+      vtkIdType expected = root0;
+      if (this->Parents[root0].compare_exchange_strong(
+            expected, root1, std::memory_order_relaxed))
+      {
+        return;
+      }
+    }
+  }
+
+  bool IsScalarConnected(vtkIdList* ptIds)
+  {
+    // The serial filters compare the scalars in single precision.
+    float range[2] = { VTK_FLOAT_MAX, -VTK_FLOAT_MAX };
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+    {
+      const float s = static_cast<float>(this->Scalars->GetComponent(ptIds->GetId(i), 0));
+      range[0] = s < range[0] ? s : range[0];
+      range[1] = s > range[1] ? s : range[1];
+    }
+    if (this->FullScalarConnectivity)
+    {
+      return range[0] >= this->ScalarRange[0] && range[1] <= this->ScalarRange[1];
+    }
+    return range[1] >= this->ScalarRange[0] && range[0] <= this->ScalarRange[1];
+  }
+
+  std::unique_ptr<std::atomic<vtkIdType>[]> Parents;
+  vtkDataArray* Scalars = nullptr;
+  double ScalarRange[2] = { 0.0, 0.0 };
+  bool FullScalarConnectivity = false;
+};
+
+//------------------------------------------------------------------------------
+void ConnectedRegions::Label(vtkDataSet* input, vtkDataArray* scalars,
+  const double scalarRange[2], bool fullScalarConnectivity)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  this->Scalars = scalars;
+  if (scalars)
+  {
+    this->ScalarRange[0] = scalarRange[0];
+    this->ScalarRange[1] = scalarRange[1];
+  }
+  this->FullScalarConnectivity = fullScalarConnectivity;
+
+  // Make sure the cell points can be accessed concurrently.
+  vtkNew<vtkIdList> ptIds;
+  if (numCells > 0)
+  {
+    input->GetCellPoints(0, ptIds);
+  }
+
+  this->Parents.reset(new std::atomic<vtkIdType>[numPts]);
+  std::atomic<vtkIdType>* parents = this->Parents.get();
+  vtkSMPTools::For(0, numPts, [parents](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      parents[ptId].store(ptId, std::memory_order_relaxed);
+    }
+  });
+
+  // Merge the points of each connecting cell, and keep the set of the cell:
+  // -1 for the cells that do not connect to their neighbors.
+  std::vector<vtkIdType> cellRoots(numCells);
+  vtkIdType* cellRootsPtr = cellRoots.data();
+  vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
+  vtkSMPTools::For(0, numCells,
+    [this, input, cellRootsPtr, &tlPtIds](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* cellPtIds = tlPtIds.Local();
+      for (; cellId < endCellId; ++cellId)
+      {
+        input->GetCellPoints(cellId, cellPtIds);
+        const vtkIdType npts = cellPtIds->GetNumberOfIds();
+        if (npts == 0 || (this->Scalars && !this->IsScalarConnected(cellPtIds)))
+        {
+          cellRootsPtr[cellId] = -1;
+          continue;
+        }
+        cellRootsPtr[cellId] = cellPtIds->GetId(0);
+        for (vtkIdType i = 1; i < npts; ++i)
+        {
+          this->Union(cellPtIds->GetId(0), cellPtIds->GetId(i));
+        }
+      }
+    });
+  vtkSMPTools::For(0, numCells, [this, cellRootsPtr](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellRootsPtr[cellId] >= 0)
+      {
+        cellRootsPtr[cellId] = this->Find(cellRootsPtr[cellId]);
+      }
+    }
+  });
+
+  // Number the regions in the order of their lowest cell. A cell that does
+  // not connect to its neighbors makes its own region, which also takes over
+  // the sets of connecting cells around its points that are not numbered yet.
+  this->CellRegions.resize(numCells);
+  this->RegionSizes.clear();
+  std::vector<vtkIdType> rootRegions(numPts, -1);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    const vtkIdType root = cellRoots[cellId];
+    vtkIdType region;
+    if (root >= 0)
+    {
+      if (rootRegions[root] < 0)
+      {
+        rootRegions[root] = static_cast<vtkIdType>(this->RegionSizes.size());
+        this->RegionSizes.push_back(0);
+      }
+      region = rootRegions[root];
+    }
+    else
+    {
+      region = static_cast<vtkIdType>(this->RegionSizes.size());
+      this->RegionSizes.push_back(0);
+      if (this->Scalars)
+      {
+        input->GetCellPoints(cellId, ptIds);
+        for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+        {
+          const vtkIdType ptRoot = this->Find(ptIds->GetId(i));
+          if (rootRegions[ptRoot] < 0)
+          {
+            rootRegions[ptRoot] = region;
+          }
+        }
+      }
+    }
+    this->CellRegions[cellId] = region;
+    ++this->RegionSizes[region];
+  }
+
+  // The region of a point is the first region that reaches it.
+  std::unique_ptr<std::atomic<vtkIdType>[]> pointRegions(new std::atomic<vtkIdType>[numPts]);
+  std::atomic<vtkIdType>* pointRegionsPtr = pointRegions.get();
+  vtkSMPTools::For(0, numPts, [pointRegionsPtr](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      pointRegionsPtr[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  const vtkIdType* cellRegionsPtr = this->CellRegions.data();
+  vtkSMPTools::For(0, numCells,
+    [input, cellRegionsPtr, pointRegionsPtr, &tlPtIds](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* cellPtIds = tlPtIds.Local();
+      for (; cellId < endCellId; ++cellId)
+      {
+        const vtkIdType region = cellRegionsPtr[cellId];
+        input->GetCellPoints(cellId, cellPtIds);
+        for (vtkIdType i = 0; i < cellPtIds->GetNumberOfIds(); ++i)
+        {
+          std::atomic<vtkIdType>& ptRegion = pointRegionsPtr[cellPtIds->GetId(i)];
+          vtkIdType current = ptRegion.load(std::memory_order_relaxed);
+          while (region < current &&
+            !ptRegion.compare_exchange_weak(current, region, std::memory_order_relaxed))
+          {
+          }
+        }
+      }
+    });
+  this->PointRegions.resize(numPts);
+  vtkIdType* pointRegionsOut = this->PointRegions.data();
+  vtkSMPTools::For(
+    0, numPts, [pointRegionsPtr, pointRegionsOut](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        const vtkIdType region = pointRegionsPtr[ptId].load(std::memory_order_relaxed);
+        pointRegionsOut[ptId] = region == VTK_ID_MAX ? -1 : region;
+      }
+    });
+
+  this->Parents.reset();
+}
+
+} // anonymous namespace
+
+#endif
+// VTK-HeaderTest-Exclude: vtkConnectedRegionsInternal.h
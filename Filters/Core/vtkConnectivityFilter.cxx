@@ -16,6 +16,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectedRegionsInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -240,31 +241,35 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
-  { // visit all cells marking with region number
+  { // label all cells with their region number, using multiple threads
+    ConnectedRegions regions;
+    regions.Label(input, this->InScalars, this->ScalarRange);
+    this->UpdateProgress(0.8);
+
     for (cellId = 0; cellId < numCells; cellId++)
     {
-      if (cellId && !(cellId % 5000))
+      this->Visited[cellId] = regions.CellRegions[cellId];
+      this->NewCellScalars->SetValue(cellId, regions.CellRegions[cellId]);
+    }
+    // The points are numbered in the order of the input points.
+    for (i = 0; i < numPts; i++)
+    {
+      if (regions.PointRegions[i] >= 0)
       {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
+        this->PointMap[i] = this->PointNumber++;
+        this->NewScalars->SetValue(this->PointMap[i], regions.PointRegions[i]);
       }
-
-      if (this->Visited[cellId] < 0)
+    }
+    for (const vtkIdType numCellsInRegion : regions.RegionSizes)
+    {
+      if (numCellsInRegion > maxCellsInRegion)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave->InsertNextId(cellId);
-        this->TraverseAndMark(input);
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
-        {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
-        }
-
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave->Reset();
-        this->Wave2->Reset();
+        maxCellsInRegion = numCellsInRegion;
+        largestRegionId = this->RegionNumber;
       }
+      this->RegionSizes->InsertValue(this->RegionNumber++, numCellsInRegion);
     }
+    this->UpdateProgress(0.9);
   }
   else // regions have been seeded, everything considered in same region
   {
@@ -50,6 +50,12 @@
  * was processed and has no other significance with respect to the size of
  * or number of cells.
  *
+ * When all the cells are visited (extraction of all, largest or specified
+ * regions), the regions are labeled using multiple threads, with a concurrent
+ * union-find of the points of the connected cells. The regions are numbered
+ * in the order of their lowest cell id, whatever the number of threads, and
+ * the output points keep the order of the input points.
+ *
  * @sa
  * vtkPolyDataConnectivityFilter
  */
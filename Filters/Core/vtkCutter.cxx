@@ -15,8 +15,10 @@
 #include "vtkCutter.h"
 
 #include "vtk3DLinearGridPlaneCutter.h"
+#include "vtkAppendPolyData.h"
 #include "vtkArrayDispatch.h"
 #include "vtkAssume.h"
+#include "vtkBoundingBox.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
@@ -35,22 +37,30 @@
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
 #include "vtkNew.h"
+#include "vtkNonMergingPointLocator.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCleanPolyData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkSynchronizedTemplates3D.h"
 #include "vtkSynchronizedTemplatesCutter3D.h"
 #include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGridBase.h"
 
 #include <algorithm>
 #include <cmath>
+#include <memory>
+#include <vector>
 
 vtkStandardNewMacro(vtkCutter);
 vtkCxxSetObjectMacro(vtkCutter, CutFunction, vtkImplicitFunction);
@@ -68,6 +78,7 @@ vtkCutter::vtkCutter(vtkImplicitFunction* cf)
   this->Locator = nullptr;
   this->GenerateTriangles = 1;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->BatchSize = 10000;
 
   this->SynchronizedTemplates3D = vtkSynchronizedTemplates3D::New();
   this->SynchronizedTemplatesCutter3D = vtkSynchronizedTemplatesCutter3D::New();
@@ -320,6 +331,199 @@ vtkIdType GetFirstVisibleCell(vtkDataSet* DataSetInput)
   }
   return 0;
 }
+
+//------------------------------------------------------------------------------
+// The output of a batch of cells cut by vtkCutter::ThreadedUnstructuredGridCutter.
+// It is only created for the batches that the cut goes through.
+struct CutBatchOutput
+{
+  vtkNew<vtkPolyData> Output;
+  vtkNew<vtkPoints> Points;
+  vtkSmartPointer<vtkIncrementalPointLocator> Locator;
+  vtkNew<vtkCellArray> Verts;
+  vtkNew<vtkCellArray> Lines;
+  vtkNew<vtkCellArray> Polys;
+  std::unique_ptr<vtkContourHelper> Helper;
+
+  CutBatchOutput(bool mergePoints, int pointsType, const double bounds[6], vtkIdType estimatedSize,
+    vtkPointData* inPD, vtkCellData* inCD, bool generateTriangles)
+  {
+    this->Points->SetDataType(pointsType);
+    if (mergePoints)
+    {
+      this->Locator = vtkSmartPointer<vtkMergePoints>::New();
+    }
+    else
+    {
+      this->Locator = vtkSmartPointer<vtkNonMergingPointLocator>::New();
+    }
+    this->Locator->InitPointInsertion(this->Points, bounds, estimatedSize);
+
+    vtkPointData* outPD = this->Output->GetPointData();
+    vtkCellData* outCD = this->Output->GetCellData();
+    outPD->InterpolateAllocate(inPD, estimatedSize, estimatedSize / 2);
+    outCD->CopyAllocate(inCD, estimatedSize, estimatedSize / 2);
+    this->Helper.reset(new vtkContourHelper(this->Locator, this->Verts, this->Lines, this->Polys,
+      inPD, inCD, outPD, outCD, estimatedSize, generateTriangles));
+  }
+
+  vtkPolyData* Finalize()
+  {
+    this->Helper.reset();
+    this->Output->SetPoints(this->Points);
+    if (this->Verts->GetNumberOfCells())
+    {
+      this->Output->SetVerts(this->Verts);
+    }
+    if (this->Lines->GetNumberOfCells())
+    {
+      this->Output->SetLines(this->Lines);
+    }
+    if (this->Polys->GetNumberOfCells())
+    {
+      this->Output->SetPolys(this->Polys);
+    }
+    this->Output->Squeeze();
+    return this->Output;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Cut batches of cells of an unstructured grid. Each batch is cut into its own
+// polydata, with its own locator, so that appending the batches in order
+// gives the same output whatever the number of threads.
+struct CutUnstructuredGridBatches
+{
+  vtkUnstructuredGrid* Input;
+  const double* CutScalars;
+  vtkPointData* InPD;
+  vtkCellData* InCD;
+  const double* ContourValues;
+  int NumberOfContours;
+  const unsigned char* CellTypeDimensions;
+  bool MergePoints;
+  bool GenerateTriangles;
+  int PointsType;
+  vtkIdType NumberOfCells;
+  vtkIdType BatchSize;
+  vtkSmartPointer<vtkPolyData>* Pieces;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkDoubleArray> CellScalars;
+  vtkSMPThreadLocalObject<vtkIdList> CellPointIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> CellsToCut;
+
+  CutUnstructuredGridBatches(vtkUnstructuredGrid* input, const double* cutScalars,
+    vtkPointData* inPD, const double* contourValues, int numContours,
+    const unsigned char* cellTypeDimensions, bool mergePoints, bool generateTriangles,
+    int pointsType, vtkIdType batchSize, vtkSmartPointer<vtkPolyData>* pieces)
+    : Input(input)
+    , CutScalars(cutScalars)
+    , InPD(inPD)
+    , InCD(input->GetCellData())
+    , ContourValues(contourValues)
+    , NumberOfContours(numContours)
+    , CellTypeDimensions(cellTypeDimensions)
+    , MergePoints(mergePoints)
+    , GenerateTriangles(generateTriangles)
+    , PointsType(pointsType)
+    , NumberOfCells(input->GetNumberOfCells())
+    , BatchSize(batchSize)
+    , Pieces(pieces)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType batchId, vtkIdType endBatchId)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkDoubleArray* cellScalars = this->CellScalars.Local();
+    vtkIdList* ptIds = this->CellPointIds.Local();
+    std::vector<vtkIdType>& cellsToCut = this->CellsToCut.Local();
+    const double* contourValuesEnd = this->ContourValues + this->NumberOfContours;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double x[3];
+
+    for (; batchId < endBatchId; ++batchId)
+    {
+      const vtkIdType beginCellId = batchId * this->BatchSize;
+      const vtkIdType endCellId = std::min(beginCellId + this->BatchSize, this->NumberOfCells);
+
+      // Gather the cells that the cut goes through, lower dimensional cells
+      // first (see vtkCutter::UnstructuredGridCutter), and their bounds.
+      cellsToCut.clear();
+      vtkBoundingBox bbox;
+      for (int dimensionality = 1; dimensionality <= 3; ++dimensionality)
+      {
+        for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+        {
+          const int cellType = this->Input->GetCellType(cellId);
+          if (cellType >= VTK_NUMBER_OF_CELL_TYPES ||
+            this->CellTypeDimensions[cellType] != dimensionality)
+          {
+            continue;
+          }
+
+          this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+          double range[2] = { this->CutScalars[pts[0]], this->CutScalars[pts[0]] };
+          for (vtkIdType i = 1; i < npts; ++i)
+          {
+            range[0] = std::min(range[0], this->CutScalars[pts[i]]);
+            range[1] = std::max(range[1], this->CutScalars[pts[i]]);
+          }
+          for (const double* contourIter = this->ContourValues; contourIter != contourValuesEnd;
+               ++contourIter)
+          {
+            if (*contourIter >= range[0] && *contourIter <= range[1])
+            {
+              cellsToCut.push_back(cellId);
+              for (vtkIdType i = 0; i < npts; ++i)
+              {
+                this->Input->GetPoint(pts[i], x);
+                bbox.AddPoint(x);
+              }
+              break;
+            }
+          }
+        }
+      }
+
+      if (cellsToCut.empty())
+      {
+        continue;
+      }
+
+      const vtkIdType estimatedSize =
+        static_cast<vtkIdType>(cellsToCut.size()) * this->NumberOfContours;
+      double bounds[6];
+      bbox.GetBounds(bounds);
+      CutBatchOutput output(this->MergePoints, this->PointsType, bounds, estimatedSize, this->InPD,
+        this->InCD, this->GenerateTriangles);
+      for (vtkIdType cellId : cellsToCut)
+      {
+        this->Input->GetCell(cellId, cell);
+        this->Input->SetCellOrderAndRationalWeights(cellId, cell);
+        vtkIdList* cellPtIds = cell->GetPointIds();
+        npts = cellPtIds->GetNumberOfIds();
+        cellScalars->SetNumberOfTuples(npts);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          cellScalars->SetValue(i, this->CutScalars[cellPtIds->GetId(i)]);
+        }
+        for (const double* contourIter = this->ContourValues; contourIter != contourValuesEnd;
+             ++contourIter)
+        {
+          output.Helper->Contour(cell, *contourIter, cellScalars, cellId);
+        }
+      }
+      this->Pieces[batchId] = output.Finalize();
+    }
+  }
+
+  void Reduce() {}
+};
 }
 
 //------------------------------------------------------------------------------
@@ -418,8 +622,20 @@ int vtkCutter::RequestData(
       return retval;
     }
 
-    vtkDebugMacro(<< "Executing Unstructured Grid Cutter");
-    this->UnstructuredGridCutter(input, output);
+    // Unstructured grids are cut in parallel, unless the cells must be sorted
+    // or the points are merged by a locator that cannot be used per batch.
+    if (input->GetDataObjectType() == VTK_UNSTRUCTURED_GRID && this->SortBy == VTK_SORT_BY_VALUE &&
+      (!this->Locator || this->Locator->IsA("vtkMergePoints") ||
+        this->Locator->IsA("vtkNonMergingPointLocator")))
+    {
+      vtkDebugMacro(<< "Executing Threaded Unstructured Grid Cutter");
+      this->ThreadedUnstructuredGridCutter(input, output);
+    }
+    else
+    {
+      vtkDebugMacro(<< "Executing Unstructured Grid Cutter");
+      this->UnstructuredGridCutter(input, output);
+    }
   }
   else
   {
@@ -505,10 +721,10 @@ void vtkCutter::DataSetCutter(vtkDataSet* input, vtkPolyData* output)
   }
 
   newPoints = vtkPoints::New();
+  vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
   // set precision for the points in the output
   if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
   {
-    vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
     if (inputPointSet)
     {
       newPoints->SetDataType(inputPointSet->GetPoints()->GetDataType());
@@ -558,14 +774,21 @@ void vtkCutter::DataSetCutter(vtkDataSet* input, vtkPolyData* output)
   }
   this->Locator->InitPointInsertion(newPoints, input->GetBounds());
 
-  // Loop over all points evaluating scalar function at each point
-  //
-  for (vtkIdType i = 0; i < numPts; ++i)
+  // Evaluate the scalar function over all points, at once when they are
+  // explicit.
+  if (inputPointSet && inputPointSet->GetPoints())
   {
-    double x[3];
-    input->GetPoint(i, x);
-    double s = this->CutFunction->FunctionValue(x);
-    cutScalars->SetComponent(i, 0, s);
+    this->CutFunction->FunctionValue(inputPointSet->GetPoints()->GetData(), cutScalars);
+  }
+  else
+  {
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      double x[3];
+      input->GetPoint(i, x);
+      double s = this->CutFunction->FunctionValue(x);
+      cutScalars->SetComponent(i, 0, s);
+    }
   }
 
   // Compute some information for progress methods
@@ -1035,6 +1258,89 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
   output->Squeeze();
 }
 
+//------------------------------------------------------------------------------
+void vtkCutter::ThreadedUnstructuredGridCutter(vtkDataSet* dataSetInput, vtkPolyData* output)
+{
+  vtkUnstructuredGrid* input = vtkUnstructuredGrid::SafeDownCast(dataSetInput);
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  if (numCells < 1)
+  {
+    return;
+  }
+
+  // set precision for the points in the output
+  int pointsType = input->GetPoints()->GetDataType();
+  if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    pointsType = VTK_FLOAT;
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    pointsType = VTK_DOUBLE;
+  }
+
+  // Evaluate the cut function at the points
+  vtkNew<vtkDoubleArray> cutScalars;
+  cutScalars->SetNumberOfTuples(numPts);
+  this->CutFunction->FunctionValue(input->GetPoints()->GetData(), cutScalars);
+
+  // Interpolate data along edge. If generating cut scalars, do necessary setup
+  vtkSmartPointer<vtkPointData> inPD = input->GetPointData();
+  if (this->GenerateCutScalars)
+  {
+    inPD = vtkSmartPointer<vtkPointData>::New();
+    inPD->ShallowCopy(input->GetPointData()); // copies original attributes
+    inPD->SetScalars(cutScalars);
+  }
+
+  unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+  vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
+
+  const bool mergePoints = !this->Locator || !this->Locator->IsA("vtkNonMergingPointLocator");
+  const vtkIdType batchSize = static_cast<vtkIdType>(this->BatchSize);
+  const vtkIdType numBatches = (numCells - 1) / batchSize + 1;
+  std::vector<vtkSmartPointer<vtkPolyData>> pieces(numBatches);
+  CutUnstructuredGridBatches cutter(input, cutScalars->GetPointer(0), inPD,
+    this->ContourValues->GetValues(), this->ContourValues->GetNumberOfContours(),
+    cellTypeDimensions, mergePoints, this->GenerateTriangles != 0, pointsType, batchSize,
+    pieces.data());
+  vtkSMPTools::For(0, numBatches, cutter);
+  this->UpdateProgress(0.8);
+
+  // Append the batches in order, then merge the points shared by batches.
+  vtkNew<vtkAppendPolyData> append;
+  for (const auto& piece : pieces)
+  {
+    if (piece)
+    {
+      append->AddInputData(piece);
+    }
+  }
+  const int numPieces = append->GetNumberOfInputConnections(0);
+  if (numPieces == 0)
+  {
+    return;
+  }
+  if (mergePoints && numPieces > 1)
+  {
+    vtkNew<vtkStaticCleanPolyData> clean;
+    clean->SetInputConnection(append->GetOutputPort());
+    clean->ToleranceIsAbsoluteOn();
+    clean->SetAbsoluteTolerance(0.0);
+    clean->ConvertLinesToPointsOff();
+    clean->ConvertPolysToLinesOff();
+    clean->ConvertStripsToPolysOff();
+    clean->Update();
+    output->ShallowCopy(clean->GetOutput());
+  }
+  else
+  {
+    append->Update();
+    output->ShallowCopy(append->GetOutput());
+  }
+}
+
 //------------------------------------------------------------------------------
 // Specify a spatial locator for merging points. By default,
 // an instance of vtkMergePoints is used.
@@ -1086,4 +1392,5 @@ void vtkCutter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Generate Cut Scalars: " << (this->GenerateCutScalars ? "On\n" : "Off\n");
 
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Batch Size: " << this->BatchSize << "\n";
 }
@@ -38,6 +38,12 @@
  * By default, if an implicit function is set it is used to clip the data
  * set, otherwise the dataset scalars are used to perform the clipping.
  *
+ * Unstructured grids are cut in parallel using vtkSMPTools when the output
+ * is sorted by value and the points are merged with vtkMergePoints (the
+ * default) or not merged at all (vtkNonMergingPointLocator). The cells are
+ * processed in batches (see SetBatchSize()) that are appended in order, so
+ * that the output does not depend on the number of threads.
+ *
  * Note that specialized classes exist when cutting a dataset with a
  * plane. vtkPlenCutter handles any type of vtkDataSet, and will delegate to
  * internal instances of specialized plane cutters (e.g.,
@@ -226,6 +232,17 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Specify the number of input cells in a batch, where a batch defines a
+   * subset of the input cells operated on during threaded execution of
+   * unstructured grids. Generally this is only used for debugging or
+   * performance studies (since batch size affects the thread workload).
+   */
+  vtkSetClampMacro(BatchSize, unsigned int, 1, VTK_INT_MAX);
+  vtkGetMacro(BatchSize, unsigned int);
+  ///@}
+
 protected:
   vtkCutter(vtkImplicitFunction* cf = nullptr);
   ~vtkCutter() override;
@@ -234,6 +251,7 @@ protected:
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int port, vtkInformation* info) override;
   void UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output);
+  void ThreadedUnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output);
   void DataSetCutter(vtkDataSet* input, vtkPolyData* output);
   void StructuredPointsCutter(
     vtkDataSet*, vtkPolyData*, vtkInformation*, vtkInformationVector**, vtkInformationVector*);
@@ -252,6 +270,7 @@ protected:
   vtkContourValues* ContourValues;
   vtkTypeBool GenerateCutScalars;
   int OutputPointsPrecision;
+  unsigned int BatchSize;
 
 private:
   vtkCutter(const vtkCutter&) = delete;
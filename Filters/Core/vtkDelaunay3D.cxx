@@ -15,20 +15,32 @@
 
 #include "vtkDelaunay3D.h"
 
+#include "vtkCellArray.h"
 #include "vtkEdgeTable.h"
 #include "vtkExecutive.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 vtkStandardNewMacro(vtkDelaunay3D);
 
 //------------------------------------------------------------------------------
@@ -121,6 +133,276 @@ vtkDelaunayTetra* vtkTetraArray::Resize(vtkIdType sz)
   return this->Array;
 }
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Sort the input points so that consecutive points are spatially close. The
+// points are binned with a (threaded) static point locator, then the bins are
+// traversed along a serpentine path so that consecutive bins are neighbors.
+// The bounds of the locator are returned as well.
+void SpatialInsertionOrder(vtkPointSet* input, std::vector<vtkIdType>& order, double bounds[6])
+{
+  vtkNew<vtkStaticPointLocator> binner;
+  binner->SetDataSet(input);
+  binner->BuildLocator();
+  binner->GetBounds(bounds);
+
+  const int* divs = binner->GetDivisions();
+  vtkNew<vtkIdList> bucketIds;
+  order.clear();
+  order.reserve(input->GetNumberOfPoints());
+
+  vtkIdType row = 0;
+  for (int k = 0; k < divs[2]; ++k)
+  {
+    for (int jj = 0; jj < divs[1]; ++jj, ++row)
+    {
+      const int j = (k % 2 ? divs[1] - 1 - jj : jj);
+      for (int ii = 0; ii < divs[0]; ++ii)
+      {
+        const int i = (row % 2 ? divs[0] - 1 - ii : ii);
+        const vtkIdType bNum = i + static_cast<vtkIdType>(j) * divs[0] +
+          static_cast<vtkIdType>(k) * divs[0] * divs[1];
+        if (binner->GetNumberOfPointsInBucket(bNum) > 0)
+        {
+          binner->GetBucketIds(bNum, bucketIds);
+          order.insert(order.end(), bucketIds->GetPointer(0),
+            bucketIds->GetPointer(0) + bucketIds->GetNumberOfIds());
+        }
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Copy the connectivity of the retained tetras into the output cell array.
+struct ExtractTetras
+{
+  vtkUnstructuredGrid* Mesh;
+  const vtkIdType* TetraIds;
+  vtkIdType* Offsets;
+  vtkIdType* Connectivity;
+  vtkSMPThreadLocalObject<vtkIdList> PtIds;
+
+  ExtractTetras(vtkUnstructuredGrid* mesh, const vtkIdType* tetraIds, vtkIdType* offsets,
+    vtkIdType* connectivity)
+    : Mesh(mesh)
+    , TetraIds(tetraIds)
+    , Offsets(offsets)
+    , Connectivity(connectivity)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList*& ptIds = this->PtIds.Local();
+    vtkIdType npts;
+    const vtkIdType* tetraPts;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Mesh->GetCellPoints(this->TetraIds[i], npts, tetraPts, ptIds);
+      this->Offsets[i] = 4 * i;
+      std::copy(tetraPts, tetraPts + 4, this->Connectivity + 4 * i);
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Partitions smaller than this are not worth triangulating concurrently.
+const vtkIdType MinimumPartitionSize = 256;
+
+// A face of a tetra which is kept in the output, but whose neighbor (in the
+// triangulation the tetra comes from) is not.
+struct DelaunayFace
+{
+  vtkIdType Ids[3]; // sorted input point ids
+  bool Hull;        // the neighbor uses a bounding point (or does not exist)
+  double Center[3]; // circumsphere of the neighbor, its radius is negative
+  double Radius2;   // when there is no neighbor
+
+  bool operator<(const DelaunayFace& other) const
+  {
+    return std::lexicographical_compare(this->Ids, this->Ids + 3, other.Ids, other.Ids + 3);
+  }
+  bool SameFace(const DelaunayFace& other) const
+  {
+    return std::equal(this->Ids, this->Ids + 3, other.Ids);
+  }
+};
+
+// The points of a partition and the tetras it contributes to the output.
+struct DelaunayPartition
+{
+  std::vector<vtkIdType> PointIds;
+  double Box[6];                       // infinite on the outer sides
+  std::vector<vtkIdType> Tetras;       // four input point ids per tetra
+  std::vector<DelaunayFace> OpenFaces; // the faces to check on the seams
+  std::vector<vtkIdType> SeamPointIds; // points of the tetras which are not kept
+  int NumberOfDuplicatePoints = 0;
+  int NumberOfDegeneracies = 0;
+};
+
+//------------------------------------------------------------------------------
+// Split the points into boxes holding the same number of points: the points
+// are recursively split at the median of the axis of largest extent.
+class PointPartitioner
+{
+public:
+  PointPartitioner(vtkPoints* points)
+  {
+    const vtkIdType numPoints = points->GetNumberOfPoints();
+    this->Coordinates.resize(3 * numPoints);
+    for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+      points->GetPoint(i, this->Coordinates.data() + 3 * i);
+    }
+  }
+
+  void Split(int numPartitions, std::vector<DelaunayPartition>& partitions)
+  {
+    const vtkIdType numPoints = static_cast<vtkIdType>(this->Coordinates.size() / 3);
+    std::vector<vtkIdType> ptIds(numPoints);
+    for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+      ptIds[i] = i;
+    }
+    const double inf = std::numeric_limits<double>::infinity();
+    const double box[6] = { -inf, inf, -inf, inf, -inf, inf };
+    partitions.clear();
+    partitions.reserve(numPartitions);
+    this->Nodes.clear();
+    this->Build(ptIds.data(), ptIds.data() + numPoints, box, numPartitions, partitions);
+  }
+
+  // Return the partition whose box contains x.
+  int FindPartition(const double x[3]) const
+  {
+    const PartitionNode* node = this->Nodes.data();
+    while (node->Axis >= 0)
+    {
+      node = this->Nodes.data() + (x[node->Axis] < node->Split ? node->Left : node->Right);
+    }
+    return node->Partition;
+  }
+
+private:
+  struct PartitionNode
+  {
+    int Axis; // -1 for the leaves
+    double Split;
+    int Left;
+    int Right;
+    int Partition;
+  };
+
+  int Build(vtkIdType* begin, vtkIdType* end, const double box[6], int numPartitions,
+    std::vector<DelaunayPartition>& partitions)
+  {
+    const int nodeId = static_cast<int>(this->Nodes.size());
+    this->Nodes.push_back(PartitionNode{ -1, 0.0, -1, -1, -1 });
+    if (numPartitions == 1)
+    {
+      this->Nodes[nodeId].Partition = static_cast<int>(partitions.size());
+      partitions.emplace_back();
+      partitions.back().PointIds.assign(begin, end);
+      std::copy(box, box + 6, partitions.back().Box);
+      return nodeId;
+    }
+
+    const double* xyz = this->Coordinates.data();
+    double bounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN,
+      VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+    for (const vtkIdType* ptId = begin; ptId < end; ++ptId)
+    {
+      for (int k = 0; k < 3; ++k)
+      {
+        bounds[2 * k] = std::min(bounds[2 * k], xyz[3 * *ptId + k]);
+        bounds[2 * k + 1] = std::max(bounds[2 * k + 1], xyz[3 * *ptId + k]);
+      }
+    }
+    int axis = 0;
+    for (int k = 1; k < 3; ++k)
+    {
+      if (bounds[2 * k + 1] - bounds[2 * k] > bounds[2 * axis + 1] - bounds[2 * axis])
+      {
+        axis = k;
+      }
+    }
+
+    const int numLeft = numPartitions / 2;
+    vtkIdType* middle = begin + (end - begin) * numLeft / numPartitions;
+    std::nth_element(begin, middle, end, [xyz, axis](vtkIdType a, vtkIdType b) {
+      return xyz[3 * a + axis] < xyz[3 * b + axis] ||
+        (xyz[3 * a + axis] == xyz[3 * b + axis] && a < b);
+    });
+    const double split = xyz[3 * *middle + axis];
+
+    double leftBox[6], rightBox[6];
+    std::copy(box, box + 6, leftBox);
+    std::copy(box, box + 6, rightBox);
+    leftBox[2 * axis + 1] = split;
+    rightBox[2 * axis] = split;
+    const int left = this->Build(begin, middle, leftBox, numLeft, partitions);
+    const int right = this->Build(middle, end, rightBox, numPartitions - numLeft, partitions);
+    this->Nodes[nodeId] = PartitionNode{ axis, split, left, right, -1 };
+    return nodeId;
+  }
+
+  std::vector<double> Coordinates;
+  std::vector<PartitionNode> Nodes;
+};
+
+//------------------------------------------------------------------------------
+// Whether the sphere lies inside the box, at least margin away from its sides.
+bool InsideBox(const double box[6], const double center[3], double radius2, double margin)
+{
+  const double radius = std::sqrt(radius2);
+  for (int k = 0; k < 3; ++k)
+  {
+    if (center[k] - radius <= box[2 * k] + margin || center[k] + radius >= box[2 * k + 1] - margin)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Whether no point of the locator lies inside the sphere (same criterion as
+// InSphere()).
+bool EmptySphere(vtkStaticPointLocator* locator, const double center[3], double radius2)
+{
+  const vtkIdType ptId = locator->FindClosestPoint(center);
+  if (ptId < 0)
+  {
+    return true;
+  }
+  double x[3];
+  locator->GetDataSet()->GetPoint(ptId, x);
+  return vtkMath::Distance2BetweenPoints(x, center) >= 0.9999999999L * radius2;
+}
+
+//------------------------------------------------------------------------------
+// Mark the points of a triangulation which are not used by any tetra: these
+// were discarded as coincident with another point.
+void MarkDiscardedPoints(vtkUnstructuredGrid* Mesh, vtkIdType numPts, const vtkIdType* ptIds,
+  std::vector<char>& discarded)
+{
+  vtkCellLinks* links = static_cast<vtkCellLinks*>(Mesh->GetCellLinks());
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    if (links->GetNcells(i) == 0)
+    {
+      discarded[ptIds[i]] = 1;
+    }
+  }
+}
+} // anonymous namespace
+
 // vtkDelaunay3D methods
 //
 
@@ -138,8 +420,12 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->BoundingTriangulation = 0;
   this->Offset = 2.5;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->PointInsertionOrder = INPUT_ORDER;
+  this->NumberOfPartitions = 1;
   this->Locator = nullptr;
   this->TetraArray = nullptr;
+  this->LastTetraId = -1;
+  this->UseInputBounds = false;
 
   // added for performance
   this->Tetras = vtkIdList::New();
@@ -203,26 +489,48 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Me
     return 0;
   }
 
-  closestPoint = locator->FindClosestInsertedPoint(x);
-  vtkCellLinks* links = static_cast<vtkCellLinks*>(Mesh->GetCellLinks());
-  int numCells = links->GetNcells(closestPoint);
-  vtkIdType* cells = links->GetCells(closestPoint);
-  if (numCells <= 0) // shouldn't happen
+  // When the points are spatially sorted, the last tetra created is close
+  // to the point: walk from there rather than searching the closest point.
+  tetraId = -1;
+  if (this->PointInsertionOrder == SPATIAL_ORDER && this->LastTetraId >= 0)
   {
-    this->NumberOfDegeneracies++;
-    return 0;
-  }
-  else
-  {
-    tetraId = cells[0];
+    tetraId = this->FindTetra(Mesh, xd, this->LastTetraId, 0);
   }
 
-  // Okay, walk towards the containing tetrahedron
-  tetraId = this->FindTetra(Mesh, xd, tetraId, 0);
   if (tetraId < 0)
   {
-    this->NumberOfDegeneracies++;
-    return 0;
+    closestPoint = locator->FindClosestInsertedPoint(x);
+    vtkCellLinks* links = static_cast<vtkCellLinks*>(Mesh->GetCellLinks());
+    int numCells = links->GetNcells(closestPoint);
+    vtkIdType* cells = links->GetCells(closestPoint);
+    if (numCells <= 0) // shouldn't happen
+    {
+      this->NumberOfDegeneracies++;
+      return 0;
+    }
+    else
+    {
+      tetraId = cells[0];
+    }
+
+    // Okay, walk towards the containing tetrahedron
+    tetraId = this->FindTetra(Mesh, xd, tetraId, 0);
+
+    // The walk may wander in long, thin tetras. The closest point is then a
+    // neighbor of the point in the new triangulation: one of its tetras has
+    // the point inside its circumsphere, and the search can start there.
+    for (int i = 0; tetraId < 0 && i < numCells; i++)
+    {
+      if (this->InSphere(xd, cells[i]))
+      {
+        tetraId = cells[i];
+      }
+    }
+    if (tetraId < 0)
+    {
+      this->NumberOfDegeneracies++;
+      return 0;
+    }
   }
 
   // Initialize the list of tetras who contain the point according
@@ -454,6 +762,21 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  // Triangulate partitions of the points concurrently when requested, and
+  // when only tetras are output.
+  int numPartitions = (this->NumberOfPartitions > 0 ? this->NumberOfPartitions
+                                                    : vtkSMPTools::GetEstimatedNumberOfThreads());
+  numPartitions = static_cast<int>(std::min(static_cast<vtkIdType>(numPartitions),
+    inPoints->GetNumberOfPoints() / MinimumPartitionSize));
+  if (numPartitions > 1 && this->Alpha == 0.0 && !this->BoundingTriangulation)
+  {
+    if (this->TriangulatePartitions(input, output, numPartitions))
+    {
+      return 1;
+    }
+    vtkDebugMacro(<< "Seams of the partitions do not match, triangulating serially");
+  }
+
   cells = vtkIdList::New();
   cells->Allocate(64);
   holeTetras = vtkIdList::New();
@@ -484,22 +807,33 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
 
   points->Allocate(numPoints + 6);
 
+  // In spatial order, sort the points and size the locator from the bounds
+  // of the input rather than from the (much larger) initial triangulation.
+  std::vector<vtkIdType> insertionOrder;
+  if (this->PointInsertionOrder == SPATIAL_ORDER && numPoints > 0)
+  {
+    SpatialInsertionOrder(input, insertionOrder, this->InputBounds);
+    this->UseInputBounds = true;
+  }
+
   Mesh = this->InitPointInsertion(center, this->Offset * tol, numPoints, points);
+  this->UseInputBounds = false;
 
   // Insert each point into triangulation. Points laying "inside"
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
   // tetrahedra.
-  for (ptId = 0; ptId < numPoints; ptId++)
+  for (vtkIdType ptNum = 0; ptNum < numPoints; ptNum++)
   {
+    ptId = (insertionOrder.empty() ? ptNum : insertionOrder[ptNum]);
     inPoints->GetPoint(ptId, x);
 
     this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if (!(ptId % 250))
+    if (!(ptNum % 250))
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      vtkDebugMacro(<< "point #" << ptNum);
+      this->UpdateProgress(static_cast<double>(ptNum) / numPoints);
       if (this->GetAbortExecute())
       {
         break;
@@ -743,12 +1077,42 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     output->GetPointData()->PassData(input->GetPointData());
   }
 
-  for (i = 0; i < numTetras; i++)
+  if (output->GetNumberOfCells() == 0)
+  {
+    // Only tetras are output: build the cell array directly, in parallel.
+    std::vector<vtkIdType> outTetras;
+    outTetras.reserve(numTetras);
+    for (i = 0; i < numTetras; i++)
+    {
+      if (tetraUse[i] == 2)
+      {
+        outTetras.push_back(i);
+      }
+    }
+    const vtkIdType numOutTetras = static_cast<vtkIdType>(outTetras.size());
+
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(numOutTetras + 1);
+    offsets->SetValue(numOutTetras, 4 * numOutTetras);
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfValues(4 * numOutTetras);
+    ExtractTetras extract(
+      Mesh, outTetras.data(), offsets->GetPointer(0), connectivity->GetPointer(0));
+    vtkSMPTools::For(0, numOutTetras, extract);
+
+    vtkNew<vtkCellArray> tetras;
+    tetras->SetData(offsets, connectivity);
+    output->SetCells(VTK_TETRA, tetras);
+  }
+  else
   {
-    if (tetraUse[i] == 2)
+    for (i = 0; i < numTetras; i++)
     {
-      Mesh->GetCellPoints(i, npts, tetraPts);
-      output->InsertNextCell(VTK_TETRA, 4, tetraPts);
+      if (tetraUse[i] == 2)
+      {
+        Mesh->GetCellPoints(i, npts, tetraPts);
+        output->InsertNextCell(VTK_TETRA, 4, tetraPts);
+      }
     }
   }
   vtkDebugMacro(<< "Generated " << output->GetNumberOfPoints() << " points and "
@@ -765,6 +1129,384 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Triangulate a subset of the input points in spatial order. Used by the
+// partitioned triangulation, each partition with its own instance.
+vtkUnstructuredGrid* vtkDelaunay3D::TriangulateSubset(vtkPoints* inPoints, vtkIdType numPts,
+  const vtkIdType* ptIds, double center[3], double length, int dataType, vtkIdList* holeTetras)
+{
+  vtkNew<vtkPoints> subsetPoints;
+  subsetPoints->SetDataTypeToDouble();
+  subsetPoints->SetNumberOfPoints(numPts);
+  double x[3];
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    inPoints->GetPoint(ptIds[i], x);
+    subsetPoints->SetPoint(i, x);
+  }
+  vtkNew<vtkPolyData> subset;
+  subset->SetPoints(subsetPoints);
+
+  std::vector<vtkIdType> insertionOrder;
+  SpatialInsertionOrder(subset, insertionOrder, this->InputBounds);
+  this->UseInputBounds = true;
+
+  vtkPoints* points = vtkPoints::New();
+  points->SetDataType(dataType);
+  points->Allocate(numPts + 6);
+  vtkUnstructuredGrid* Mesh = this->InitPointInsertion(center, length, numPts, points);
+  this->UseInputBounds = false;
+
+  for (vtkIdType ptId : insertionOrder)
+  {
+    subsetPoints->GetPoint(ptId, x);
+    this->InsertPoint(Mesh, points, ptId, x, holeTetras);
+  }
+  this->EndPointInsertion();
+
+  return Mesh;
+}
+
+//------------------------------------------------------------------------------
+// Partitioned triangulation. Each partition is triangulated within the same
+// bounding octahedron as the whole input. A tetra of a partition whose
+// circumsphere lies inside the box of the partition is empty of the points of
+// the other partitions too, so it is a tetra of the whole triangulation. The
+// other tetras of the whole triangulation only use points of tetras which are
+// not kept in the partitions: these seam points are triangulated again, and
+// the seam tetras whose circumsphere is not inside a box and is empty of the
+// input points are kept. Finally, the faces between the kept tetras of the
+// different triangulations must match, or lie on the convex hull.
+bool vtkDelaunay3D::TriangulatePartitions(
+  vtkPointSet* input, vtkUnstructuredGrid* output, int numPartitions)
+{
+  vtkPoints* inPoints = input->GetPoints();
+  const vtkIdType numPoints = inPoints->GetNumberOfPoints();
+  double center[3];
+  input->GetCenter(center);
+  const double length = this->Offset * input->GetLength();
+
+  // Same precision of the points of the meshes as in the serial triangulation
+  int dataType = inPoints->GetDataType();
+  if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    dataType = VTK_FLOAT;
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    dataType = VTK_DOUBLE;
+  }
+
+  PointPartitioner partitioner(inPoints);
+  std::vector<DelaunayPartition> partitions;
+  partitioner.Split(numPartitions, partitions);
+
+  // One instance per partition, and one for the seams, discarding coincident
+  // points as this instance does.
+  if (this->Locator == nullptr)
+  {
+    this->CreateDefaultLocator();
+  }
+  std::vector<vtkSmartPointer<vtkDelaunay3D>> workers(numPartitions + 1);
+  for (auto& worker : workers)
+  {
+    worker = vtkSmartPointer<vtkDelaunay3D>::New();
+    worker->PointInsertionOrder = SPATIAL_ORDER;
+    worker->CreateDefaultLocator();
+    worker->Locator->SetTolerance(this->Locator->GetTolerance());
+  }
+
+  // A point close to a side of a box (closer than the tolerance of the
+  // locator) may be coincident with a point of another partition: the
+  // tetras using it must not be kept in the partition.
+  const double margin = this->Tolerance * input->GetLength() + this->Locator->GetTolerance();
+  std::vector<char> discarded(numPoints, 0);
+
+  // Record the kept tetras of a triangulation, and their faces whose neighbor
+  // is not kept.
+  auto extract = [](vtkDelaunay3D* worker, vtkUnstructuredGrid* Mesh, vtkIdType numPts,
+                   const vtkIdType* ptIds, const std::vector<char>& keep,
+                   DelaunayPartition& partition) {
+    static const int faceVertices[4][3] = { { 0, 1, 2 }, { 1, 2, 3 }, { 2, 3, 0 }, { 3, 0, 1 } };
+    vtkIdType npts, neiNpts, nei;
+    const vtkIdType* tetraPts;
+    const vtkIdType* neiPts;
+    for (vtkIdType tetraId = 0; tetraId < static_cast<vtkIdType>(keep.size()); ++tetraId)
+    {
+      if (!keep[tetraId])
+      {
+        continue;
+      }
+      Mesh->GetCellPoints(tetraId, npts, tetraPts);
+      for (int j = 0; j < 4; ++j)
+      {
+        partition.Tetras.push_back(ptIds[tetraPts[j]]);
+      }
+      for (const int* face : faceVertices)
+      {
+        const int hasNei = GetTetraFaceNeighbor(
+          Mesh, tetraId, tetraPts[face[0]], tetraPts[face[1]], tetraPts[face[2]], nei);
+        if (hasNei && keep[nei])
+        {
+          continue;
+        }
+        DelaunayFace openFace;
+        for (int j = 0; j < 3; ++j)
+        {
+          openFace.Ids[j] = ptIds[tetraPts[face[j]]];
+        }
+        std::sort(openFace.Ids, openFace.Ids + 3);
+        openFace.Hull = !hasNei;
+        openFace.Radius2 = -1.0;
+        if (hasNei)
+        {
+          Mesh->GetCellPoints(nei, neiNpts, neiPts);
+          openFace.Hull = *std::max_element(neiPts, neiPts + 4) >= numPts;
+          const vtkDelaunayTetra* sphere = worker->TetraArray->GetTetra(nei);
+          std::copy(sphere->center, sphere->center + 3, openFace.Center);
+          openFace.Radius2 = sphere->r2;
+        }
+        partition.OpenFaces.push_back(openFace);
+      }
+    }
+  };
+
+  // Triangulate the partitions concurrently
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType p = begin; p < end; ++p)
+    {
+      DelaunayPartition& partition = partitions[p];
+      vtkDelaunay3D* worker = workers[p];
+      const vtkIdType numPts = static_cast<vtkIdType>(partition.PointIds.size());
+      vtkNew<vtkIdList> holeTetras;
+      vtkUnstructuredGrid* Mesh = worker->TriangulateSubset(
+        inPoints, numPts, partition.PointIds.data(), center, length, dataType, holeTetras);
+
+      std::vector<char> keep(Mesh->GetNumberOfCells(), 1);
+      for (vtkIdType i = 0; i < holeTetras->GetNumberOfIds(); ++i)
+      {
+        keep[holeTetras->GetId(i)] = 0;
+      }
+      std::vector<char> seamPoints(numPts, 0);
+      vtkIdType npts;
+      const vtkIdType* tetraPts;
+      for (vtkIdType tetraId = 0; tetraId < static_cast<vtkIdType>(keep.size()); ++tetraId)
+      {
+        if (!keep[tetraId])
+        {
+          continue;
+        }
+        Mesh->GetCellPoints(tetraId, npts, tetraPts);
+        const vtkDelaunayTetra* sphere = worker->TetraArray->GetTetra(tetraId);
+        if (*std::max_element(tetraPts, tetraPts + 4) >= numPts ||
+          !InsideBox(partition.Box, sphere->center, sphere->r2, margin))
+        {
+          keep[tetraId] = 0;
+          for (int j = 0; j < 4; ++j)
+          {
+            if (tetraPts[j] < numPts)
+            {
+              seamPoints[tetraPts[j]] = 1;
+            }
+          }
+        }
+      }
+      for (vtkIdType i = 0; i < numPts; ++i)
+      {
+        if (seamPoints[i])
+        {
+          partition.SeamPointIds.push_back(partition.PointIds[i]);
+        }
+      }
+
+      MarkDiscardedPoints(Mesh, numPts, partition.PointIds.data(), discarded);
+      extract(worker, Mesh, numPts, partition.PointIds.data(), keep, partition);
+      partition.NumberOfDuplicatePoints = worker->NumberOfDuplicatePoints;
+      partition.NumberOfDegeneracies = worker->NumberOfDegeneracies;
+      Mesh->Delete();
+    }
+  });
+  this->UpdateProgress(0.6);
+
+  // Triangulate the seam points
+  std::vector<char> isSeamPoint(numPoints, 0);
+  for (const DelaunayPartition& partition : partitions)
+  {
+    for (vtkIdType ptId : partition.SeamPointIds)
+    {
+      isSeamPoint[ptId] = 1;
+    }
+  }
+  DelaunayPartition seam;
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    if (isSeamPoint[ptId])
+    {
+      seam.PointIds.push_back(ptId);
+    }
+  }
+  const vtkIdType numSeamPts = static_cast<vtkIdType>(seam.PointIds.size());
+  vtkDebugMacro(<< "Triangulating " << numSeamPts << " seam points of " << numPartitions
+                << " partitions");
+
+  // Points which are not discarded, to check the circumspheres
+  vtkNew<vtkPoints> keptPoints;
+  keptPoints->SetDataTypeToDouble();
+  vtkNew<vtkPolyData> keptPointSet;
+  vtkNew<vtkStaticPointLocator> locator;
+  if (numSeamPts > 0)
+  {
+    vtkDelaunay3D* worker = workers[numPartitions];
+    vtkNew<vtkIdList> holeTetras;
+    vtkUnstructuredGrid* Mesh = worker->TriangulateSubset(
+      inPoints, numSeamPts, seam.PointIds.data(), center, length, dataType, holeTetras);
+
+    std::vector<char> keep(Mesh->GetNumberOfCells(), 1);
+    for (vtkIdType i = 0; i < holeTetras->GetNumberOfIds(); ++i)
+    {
+      keep[holeTetras->GetId(i)] = 0;
+    }
+
+    MarkDiscardedPoints(Mesh, numSeamPts, seam.PointIds.data(), discarded);
+    keptPoints->Allocate(numPoints);
+    double x[3];
+    for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+    {
+      if (!discarded[ptId])
+      {
+        inPoints->GetPoint(ptId, x);
+        keptPoints->InsertNextPoint(x);
+      }
+    }
+    keptPointSet->SetPoints(keptPoints);
+    locator->SetDataSet(keptPointSet);
+    locator->BuildLocator();
+
+    // The seam tetras must cross the sides of the boxes (the others are kept
+    // in the partitions), and must be Delaunay tetras of all the points.
+    vtkSMPTools::For(0, static_cast<vtkIdType>(keep.size()), [&](vtkIdType begin, vtkIdType end) {
+      vtkIdType npts;
+      const vtkIdType* tetraPts;
+      for (vtkIdType tetraId = begin; tetraId < end; ++tetraId)
+      {
+        if (!keep[tetraId])
+        {
+          continue;
+        }
+        Mesh->GetCellPoints(tetraId, npts, tetraPts);
+        const vtkDelaunayTetra* sphere = worker->TetraArray->GetTetra(tetraId);
+        const DelaunayPartition& partition = partitions[partitioner.FindPartition(sphere->center)];
+        if (*std::max_element(tetraPts, tetraPts + 4) >= numSeamPts ||
+          InsideBox(partition.Box, sphere->center, sphere->r2, margin) ||
+          !EmptySphere(locator, sphere->center, sphere->r2))
+        {
+          keep[tetraId] = 0;
+        }
+      }
+    });
+
+    extract(worker, Mesh, numSeamPts, seam.PointIds.data(), keep, seam);
+    seam.NumberOfDuplicatePoints = worker->NumberOfDuplicatePoints;
+    seam.NumberOfDegeneracies = worker->NumberOfDegeneracies;
+    Mesh->Delete();
+  }
+  this->UpdateProgress(0.9);
+
+  // Check the seams: each open face must be shared by exactly two kept tetras,
+  // or lie on the convex hull of the input points. Points which could not be
+  // inserted in a triangulation are missing from the others, so give up.
+  partitions.push_back(std::move(seam));
+  for (const DelaunayPartition& partition : partitions)
+  {
+    if (partition.NumberOfDegeneracies > 0)
+    {
+      return false;
+    }
+  }
+  std::vector<DelaunayFace> openFaces;
+  for (const DelaunayPartition& partition : partitions)
+  {
+    openFaces.insert(openFaces.end(), partition.OpenFaces.begin(), partition.OpenFaces.end());
+  }
+  vtkSMPTools::Sort(openFaces.begin(), openFaces.end());
+  for (size_t i = 0, j; i < openFaces.size(); i = j)
+  {
+    for (j = i + 1; j < openFaces.size() && openFaces[j].SameFace(openFaces[i]); ++j)
+    {
+    }
+    if (j - i > 2)
+    {
+      return false;
+    }
+    if (j - i == 1)
+    {
+      const DelaunayFace& face = openFaces[i];
+      if (!face.Hull || face.Radius2 < 0.0)
+      {
+        return false;
+      }
+      if (!locator->GetDataSet() || !EmptySphere(locator, face.Center, face.Radius2))
+      {
+        return false;
+      }
+    }
+  }
+
+  // Send the tetras to the output
+  vtkIdType numTetras = 0;
+  this->NumberOfDuplicatePoints = 0;
+  this->NumberOfDegeneracies = 0;
+  for (const DelaunayPartition& partition : partitions)
+  {
+    numTetras += static_cast<vtkIdType>(partition.Tetras.size() / 4);
+    this->NumberOfDuplicatePoints += partition.NumberOfDuplicatePoints;
+    this->NumberOfDegeneracies += partition.NumberOfDegeneracies;
+  }
+
+  vtkDebugMacro(<< "Triangulated " << numPoints << " points, " << this->NumberOfDuplicatePoints
+                << " of which were duplicates");
+  if (this->NumberOfDegeneracies > 0)
+  {
+    vtkWarningMacro(<< this->NumberOfDegeneracies
+                    << " degenerate triangles encountered, mesh quality suspect");
+  }
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numTetras + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(4 * numTetras);
+  vtkIdType* conn = connectivity->GetPointer(0);
+  for (const DelaunayPartition& partition : partitions)
+  {
+    conn = std::copy(partition.Tetras.begin(), partition.Tetras.end(), conn);
+  }
+  for (vtkIdType i = 0; i <= numTetras; ++i)
+  {
+    offsets->SetValue(i, 4 * i);
+  }
+  vtkNew<vtkCellArray> tetras;
+  tetras->SetData(offsets, connectivity);
+
+  if (inPoints->GetDataType() != dataType)
+  {
+    vtkNew<vtkPoints> points;
+    points->SetDataType(dataType);
+    points->DeepCopy(inPoints);
+    output->SetPoints(points);
+  }
+  else
+  {
+    output->SetPoints(inPoints);
+  }
+  output->GetPointData()->PassData(input->GetPointData());
+  output->SetCells(VTK_TETRA, tetras);
+
+  vtkDebugMacro(<< "Generated " << output->GetNumberOfPoints() << " points and "
+                << output->GetNumberOfCells() << " tetrahedra");
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // This is a helper method used with InsertPoint() to create
 // tetrahedronalizations of points. Its purpose is construct an initial
@@ -787,6 +1529,7 @@ vtkUnstructuredGrid* vtkDelaunay3D::InitPointInsertion(
 
   this->NumberOfDuplicatePoints = 0;
   this->NumberOfDegeneracies = 0;
+  this->LastTetraId = -1;
 
   if (length <= 0.0)
   {
@@ -803,7 +1546,16 @@ vtkUnstructuredGrid* vtkDelaunay3D::InitPointInsertion(
   {
     this->CreateDefaultLocator();
   }
-  this->Locator->InitPointInsertion(points, bounds);
+  // The bounding points lie outside of the input bounds, but vtkPointLocator
+  // clamps them into its boundary buckets.
+  if (this->UseInputBounds && vtkPointLocator::SafeDownCast(this->Locator))
+  {
+    this->Locator->InitPointInsertion(points, this->InputBounds, numPtsToInsert);
+  }
+  else
+  {
+    this->Locator->InitPointInsertion(points, bounds);
+  }
 
   // create bounding octahedron: 6 points & 4 tetra
   x[0] = center[0] - length;
@@ -952,6 +1704,7 @@ void vtkDelaunay3D::InsertPoint(
       }
 
       this->InsertTetra(Mesh, points, tetraId);
+      this->LastTetraId = tetraId;
 
     } // for each face
 
@@ -1062,6 +1815,9 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Point Insertion Order: "
+     << (this->PointInsertionOrder == SPATIAL_ORDER ? "Spatial Order\n" : "Input Order\n");
+  os << indent << "Number Of Partitions: " << this->NumberOfPartitions << "\n";
 }
 
 //------------------------------------------------------------------------------
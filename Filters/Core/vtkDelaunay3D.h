@@ -87,6 +87,34 @@
  * will be found. However, in degenerate cases an enclosing tetrahedron may
  * not be found and the point will be rejected.
  *
+ * @warning
+ * Points are inserted in the order they are given by default. For large,
+ * spatially incoherent inputs (e.g., scans or randomly ordered points) the
+ * PointInsertionOrder can be set to SPATIAL_ORDER: the input points are first
+ * binned (using vtkStaticPointLocator), then inserted bin by bin along a
+ * serpentine path through the bins, each search for the enclosing
+ * tetrahedron starting from the last tetrahedron created. This greatly
+ * reduces the cost of point location. Since the Delaunay triangulation of
+ * points in general position is unique, the output is the same as in input
+ * order, except for degenerate configurations (see above) which may be
+ * triangulated differently. Point ids are not affected by the ordering.
+ *
+ * @warning
+ * Large inputs can also be triangulated concurrently by setting
+ * NumberOfPartitions. The points are split into boxes holding the same
+ * number of points (a kd-tree split), and the boxes are triangulated in
+ * parallel (vtkSMPTools), each in spatial order and within the same initial
+ * bounding triangulation. A tetrahedron whose circumsphere lies inside its
+ * box is part of the final triangulation. The points of all the other
+ * tetrahedra are triangulated again (serially) to repair the seams between
+ * the boxes: the seam tetrahedra whose circumsphere is not inside a box and
+ * contains no input point are kept. The faces on the seams are then checked
+ * to match; if they do not (which may happen with degenerate configurations)
+ * the whole input is triangulated serially instead. The tetrahedra are the
+ * same as with the serial triangulation, up to degeneracies, but they are
+ * ordered differently. The partitioned triangulation is only used when Alpha
+ * is zero and BoundingTriangulation is off.
+ *
  * @sa
  * vtkDelaunay2D vtkGaussianSplatter vtkUnstructuredGrid
  */
@@ -110,6 +138,15 @@ public:
   vtkTypeMacro(vtkDelaunay3D, vtkUnstructuredGridAlgorithm);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  /**
+   * Order in which the input points are inserted into the triangulation.
+   */
+  enum PointInsertionOrderType
+  {
+    INPUT_ORDER = 0,
+    SPATIAL_ORDER = 1
+  };
+
   /**
    * Construct object with Alpha = 0.0; Tolerance = 0.001; Offset = 2.5;
    * BoundingTriangulation turned off.
@@ -197,6 +234,32 @@ public:
   vtkBooleanMacro(BoundingTriangulation, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Specify the order in which the points are inserted into the
+   * triangulation. INPUT_ORDER (the default) inserts the points in the order
+   * of the input. SPATIAL_ORDER sorts the points with a spatial binning
+   * first, which is much faster for large point clouds whose ordering is
+   * not spatially coherent. See the class documentation for details.
+   */
+  vtkSetClampMacro(PointInsertionOrder, int, INPUT_ORDER, SPATIAL_ORDER);
+  vtkGetMacro(PointInsertionOrder, int);
+  void SetPointInsertionOrderToInputOrder() { this->SetPointInsertionOrder(INPUT_ORDER); }
+  void SetPointInsertionOrderToSpatialOrder() { this->SetPointInsertionOrder(SPATIAL_ORDER); }
+  ///@}
+
+  ///@{
+  /**
+   * Specify the number of partitions of the points which are triangulated
+   * concurrently. 1 (the default) triangulates the points serially, 0 uses one
+   * partition per thread (see vtkSMPTools). Small inputs, and inputs which
+   * require the serial algorithm (non-zero Alpha or BoundingTriangulation on),
+   * are triangulated serially. See the class documentation for details.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  ///@}
+
   ///@{
   /**
    * Set / get a spatial locator for merging points. By default,
@@ -278,6 +341,8 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  int PointInsertionOrder;
+  int NumberOfPartitions;
 
   vtkIncrementalPointLocator* Locator; // help locate points faster
 
@@ -301,6 +366,21 @@ private:                    // members added for performance
   vtkIdList* Tetras;        // used in InsertPoint
   vtkIdList* Faces;         // used in InsertPoint
   vtkIdList* CheckedTetras; // used by InsertPoint
+  vtkIdType LastTetraId;    // last tetra created, start of the walk in spatial order
+
+  // Bounds of the input points used to size the locator in spatial order
+  double InputBounds[6];
+  bool UseInputBounds;
+
+  // Triangulate the points ptIds of inPoints in spatial order, within the
+  // bounding octahedron of the given center and length. The point i of the
+  // returned mesh is ptIds[i], the bounding points follow.
+  vtkUnstructuredGrid* TriangulateSubset(vtkPoints* inPoints, vtkIdType numPts,
+    const vtkIdType* ptIds, double center[3], double length, int dataType, vtkIdList* holeTetras);
+
+  // Partitioned (threaded) triangulation of the input; returns false when the
+  // seams could not be repaired, the output is then left untouched.
+  bool TriangulatePartitions(vtkPointSet* input, vtkUnstructuredGrid* output, int numPartitions);
 
 private:
   vtkDelaunay3D(const vtkDelaunay3D&) = delete;
@@ -14,7 +14,9 @@
 =========================================================================*/
 #include "vtkGlyph3D.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -22,10 +24,13 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -33,6 +38,9 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
@@ -120,6 +128,132 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
 }
 
 //------------------------------------------------------------------------------
+namespace
+{
+// The cells of a polydata are stored by type: verts, lines, polys and strips.
+constexpr int NumberOfCellTypes = 4;
+
+// The input points are processed by blocks, whose output offsets are
+// computed first so that the glyphs can be written concurrently.
+constexpr vtkIdType GlyphBlockSize = 1024;
+
+// One glyph of the table of sources, with its points already moved by the
+// source transform, and its cells split by type as in the output.
+struct GlyphSource
+{
+  vtkPolyData* Source = nullptr;
+  vtkDataArray* Normals = nullptr;
+  vtkIdType NumberOfPoints = 0;
+  std::vector<double> Points;
+  std::vector<vtkIdType> Offsets[NumberOfCellTypes];
+  std::vector<vtkIdType> Connectivity[NumberOfCellTypes];
+
+  void Initialize(vtkPolyData* source, vtkTransform* sourceTransform)
+  {
+    this->Source = source;
+    this->Normals = source->GetPointData()->GetNormals();
+    this->NumberOfPoints = source->GetNumberOfPoints();
+
+    vtkSmartPointer<vtkPoints> points = source->GetPoints();
+    if (points && sourceTransform)
+    {
+      vtkNew<vtkPoints> transformedPoints;
+      transformedPoints->SetDataTypeToDouble();
+      transformedPoints->Allocate(this->NumberOfPoints);
+      sourceTransform->TransformPoints(points, transformedPoints);
+      points = transformedPoints;
+    }
+    this->Points.resize(3 * this->NumberOfPoints);
+    for (vtkIdType ptId = 0; ptId < this->NumberOfPoints; ++ptId)
+    {
+      points->GetPoint(ptId, this->Points.data() + 3 * ptId);
+    }
+
+    vtkCellArray* cells[NumberOfCellTypes] = { source->GetVerts(), source->GetLines(),
+      source->GetPolys(), source->GetStrips() };
+    for (int type = 0; type < NumberOfCellTypes; ++type)
+    {
+      const vtkIdType numCells = cells[type]->GetNumberOfCells();
+      this->Offsets[type].resize(numCells + 1);
+      this->Connectivity[type].resize(cells[type]->GetNumberOfConnectivityIds());
+      this->Offsets[type][0] = 0;
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        cells[type]->GetCellAtId(cellId, npts, pts);
+        const vtkIdType offset = this->Offsets[type][cellId];
+        std::copy(pts, pts + npts, this->Connectivity[type].begin() + offset);
+        this->Offsets[type][cellId + 1] = offset + npts;
+      }
+    }
+  }
+
+  vtkIdType GetNumberOfCells(int type) const
+  {
+    return static_cast<vtkIdType>(this->Offsets[type].size()) - 1;
+  }
+};
+
+// Sizes of the output of a block of input points, or offsets of its output.
+struct GlyphOffsets
+{
+  vtkIdType Points = 0;
+  vtkIdType Cells[NumberOfCellTypes] = { 0, 0, 0, 0 };
+  vtkIdType Connectivity[NumberOfCellTypes] = { 0, 0, 0, 0 };
+
+  void Add(const GlyphSource& glyph)
+  {
+    this->Points += glyph.NumberOfPoints;
+    for (int type = 0; type < NumberOfCellTypes; ++type)
+    {
+      this->Cells[type] += glyph.GetNumberOfCells(type);
+      this->Connectivity[type] += static_cast<vtkIdType>(glyph.Connectivity[type].size());
+    }
+  }
+
+  void Add(const GlyphOffsets& sizes)
+  {
+    this->Points += sizes.Points;
+    for (int type = 0; type < NumberOfCellTypes; ++type)
+    {
+      this->Cells[type] += sizes.Cells[type];
+      this->Connectivity[type] += sizes.Connectivity[type];
+    }
+  }
+};
+
+// Data driving the glyph of one input point.
+struct GlyphPoint
+{
+  double Scalar;
+  double Vector[3];
+  double VectorMagnitude;
+  double Scale[3];
+};
+
+template <typename T>
+void TransformGlyphPoints(const double matrix[4][4], const GlyphSource& glyph, T* outPts)
+{
+  const double* inPts = glyph.Points.data();
+  for (vtkIdType ptId = 0; ptId < glyph.NumberOfPoints; ++ptId, inPts += 3, outPts += 3)
+  {
+    const double x = inPts[0], y = inPts[1], z = inPts[2];
+    outPts[0] =
+      static_cast<T>(matrix[0][0] * x + matrix[0][1] * y + matrix[0][2] * z + matrix[0][3]);
+    outPts[1] =
+      static_cast<T>(matrix[1][0] * x + matrix[1][1] * y + matrix[1][2] * z + matrix[1][3]);
+    outPts[2] =
+      static_cast<T>(matrix[2][0] * x + matrix[2][1] * y + matrix[2][2] * z + matrix[2][3]);
+  }
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// The glyphs are generated in four passes: the glyph of each input point is
+// selected in parallel, then the subclasses can hide points, the output of
+// each block of points is counted and its offsets computed, and finally the
+// glyphs are transformed and written in parallel directly in the output.
 bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector, vtkPolyData* output,
   vtkDataArray* inSScalars, vtkDataArray* inVectors)
 {
@@ -136,40 +270,22 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   vtkPointData* pd;
   vtkDataArray* inCScalars; // Scalars for Coloring
   unsigned char* inGhostLevels = nullptr;
-  vtkDataArray *inNormals, *sourceNormals = nullptr;
+  vtkDataArray* inNormals;
   vtkDataArray* sourceTCoords = nullptr;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  vtkPoints* sourcePts = nullptr;
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
-  vtkPoints* newPts;
+  vtkIdType numPts;
   vtkDataArray* newScalars = nullptr;
   vtkDataArray* newVectors = nullptr;
   vtkDataArray* newNormals = nullptr;
   vtkDataArray* newTCoords = nullptr;
-  double x[3], v[3], vNew[3], s = 0.0, vMag = 0.0, value, tc[3];
-  vtkTransform* trans = vtkTransform::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdList* cellPts;
-  int npts;
-  vtkIdList* pts;
-  vtkIdType ptIncr, cellIncr, cellId;
-  int haveVectors, haveNormals, haveTCoords = 0;
-  double scalex, scaley, scalez, den;
+  bool haveVectors, haveNormals, haveTCoords = false;
+  double den;
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
   int numberOfSources = this->GetNumberOfInputConnections(1);
-  vtkIdTypeArray* pointIds = nullptr;
   vtkSmartPointer<vtkPolyData> source = this->GetSource(0, sourceVector);
-  vtkNew<vtkIdList> srcPointIdList;
-  vtkNew<vtkIdList> dstPointIdList;
-  vtkNew<vtkIdList> srcCellIdList;
-  vtkNew<vtkIdList> dstCellIdList;
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  pts = vtkIdList::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   pd = input->GetPointData();
   inNormals = this->GetInputArrayToProcess(2, input);
   inCScalars = this->GetInputArrayToProcess(3, input);
@@ -196,8 +312,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   if (numPts < 1)
   {
     vtkDebugMacro(<< "No points to glyph!");
-    pts->Delete();
-    trans->Delete();
     return true;
   }
 
@@ -207,16 +321,19 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   {
     den = 1.0;
   }
-  if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION ||
+  haveVectors = this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION ||
     (this->VectorMode != VTK_VECTOR_ROTATION_OFF &&
       ((this->VectorMode == VTK_USE_VECTOR && inVectors != nullptr) ||
-        (this->VectorMode == VTK_USE_NORMAL && inNormals != nullptr))))
-  {
-    haveVectors = 1;
-  }
-  else
+        (this->VectorMode == VTK_USE_NORMAL && inNormals != nullptr)));
+  vtkDataArray* array3D = nullptr;
+  if (haveVectors && this->VectorMode != VTK_FOLLOW_CAMERA_DIRECTION)
   {
-    haveVectors = 0;
+    array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+    if (array3D->GetNumberOfComponents() > 3)
+    {
+      vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
+      return false;
+    }
   }
 
   if ((this->IndexMode == VTK_INDEXING_BY_SCALAR && !inSScalars) ||
@@ -227,8 +344,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     if (source == nullptr)
     {
       vtkErrorMacro(<< "Indexing on but don't have data to index with");
-      pts->Delete();
-      trans->Delete();
       return true;
     }
     else
@@ -260,107 +375,198 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     source = defaultSource;
   }
 
+  // Prepare the table of glyphs. A missing glyph has no source, and the
+  // points that select it are not glyphed.
+  std::vector<GlyphSource> glyphs;
   if (this->IndexMode != VTK_INDEXING_OFF)
   {
     pd = nullptr;
-    haveNormals = 1;
-    for (numSourcePts = numSourceCells = i = 0; i < numberOfSources; i++)
+    haveNormals = true;
+    glyphs.resize(numberOfSources);
+    for (int i = 0; i < numberOfSources; i++)
     {
       source = this->GetSource(i, sourceVector);
       if (source != nullptr)
       {
-        if (source->GetNumberOfPoints() > numSourcePts)
-        {
-          numSourcePts = source->GetNumberOfPoints();
-        }
-        if (source->GetNumberOfCells() > numSourceCells)
-        {
-          numSourceCells = source->GetNumberOfCells();
-        }
-        if (!(sourceNormals = source->GetPointData()->GetNormals()))
-        {
-          haveNormals = 0;
-        }
+        glyphs[i].Initialize(source, this->SourceTransform);
+        haveNormals = haveNormals && glyphs[i].Normals != nullptr;
       }
     }
   }
   else
   {
-    sourcePts = source->GetPoints();
-    numSourcePts = sourcePts->GetNumberOfPoints();
-    numSourceCells = source->GetNumberOfCells();
+    glyphs.resize(1);
+    glyphs[0].Initialize(source, this->SourceTransform);
+    haveNormals = glyphs[0].Normals != nullptr;
+    sourceTCoords = source->GetPointData()->GetTCoords();
+    haveTCoords = sourceTCoords != nullptr;
+  }
+  const GlyphSource* glyphsPtr = glyphs.data();
+
+  // Compute the scalar, vector and scale of an input point, and the index of
+  // its glyph in the table.
+  auto evaluate = [&](vtkIdType inPtId, GlyphPoint& glyphPoint) -> int {
+    double* scale = glyphPoint.Scale;
+    double* v = glyphPoint.Vector;
+    scale[0] = scale[1] = scale[2] = 1.0;
+    glyphPoint.Scalar = 0.0;
+    v[0] = v[1] = v[2] = 0.0;
+    glyphPoint.VectorMagnitude = 0.0;
 
-    sourceNormals = source->GetPointData()->GetNormals();
-    if (sourceNormals)
+    // Get the scalar and vector data
+    if (inSScalars)
     {
-      haveNormals = 1;
+      glyphPoint.Scalar = inSScalars->GetComponent(inPtId, 0);
+      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scale[0] = scale[1] = scale[2] = glyphPoint.Scalar;
+      }
     }
-    else
+    if (haveVectors)
+    {
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        glyphPoint.VectorMagnitude = 1.0; // v is the direction of the camera
+      }
+      else
+      {
+        array3D->GetTuple(inPtId, v);
+        glyphPoint.VectorMagnitude = vtkMath::Norm(v);
+        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        {
+          scale[0] = v[0];
+          scale[1] = v[1];
+          scale[2] = v[2];
+        }
+        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+        {
+          scale[0] = scale[1] = scale[2] = glyphPoint.VectorMagnitude;
+        }
+      }
+    }
+
+    // Clamp data scale if enabled
+    if (this->Clamping)
     {
-      haveNormals = 0;
+      for (int i = 0; i < 3; ++i)
+      {
+        scale[i] = (scale[i] < this->Range[0]
+            ? this->Range[0]
+            : (scale[i] > this->Range[1] ? this->Range[1] : scale[i]));
+        scale[i] = (scale[i] - this->Range[0]) / den;
+      }
     }
 
-    sourceTCoords = source->GetPointData()->GetTCoords();
-    if (sourceTCoords)
+    // Compute index into table of glyphs
+    if (this->IndexMode == VTK_INDEXING_OFF)
     {
-      haveTCoords = 1;
+      return 0;
     }
-    else
+    const double value =
+      this->IndexMode == VTK_INDEXING_BY_SCALAR ? glyphPoint.Scalar : glyphPoint.VectorMagnitude;
+    int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
+    index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+    return index;
+  };
+
+  // Select the glyph of each point, -1 for the points that are not glyphed.
+  // Make sure that the points can be accessed concurrently.
+  double x[3];
+  input->GetPoint(0, x);
+  std::vector<int> glyphIndices(numPts);
+  int* glyphIndicesPtr = glyphIndices.data();
+  vtkSMPTools::For(0, numPts, [&](vtkIdType inPtId, vtkIdType endPtId) {
+    GlyphPoint glyphPoint;
+    for (; inPtId < endPtId; ++inPtId)
     {
-      haveTCoords = 0;
+      int index = evaluate(inPtId, glyphPoint);
+
+      // Make sure we're not indexing into empty glyph. Check ghost points: if
+      // we are processing a piece, we do not want to duplicate glyphs on the
+      // borders. Also skip the points blanked in a vtkUniformGrid.
+      if (index < 0 || !glyphsPtr[index].Source ||
+        (inGhostLevels &&
+          inGhostLevels[inPtId] &
+            (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT)) ||
+        (inputUG && !inputUG->IsPointVisible(inPtId)))
+      {
+        index = -1;
+      }
+      glyphIndicesPtr[inPtId] = index;
     }
+  });
 
-    // Prepare to copy output.
-    pd = input->GetPointData();
-    outputPD->CopyAllocate(pd, numPts * numSourcePts);
-    if (this->FillCellData)
+  // IsPointVisible() may not be thread safe in subclasses.
+  for (vtkIdType inPtId = 0; inPtId < numPts; ++inPtId)
+  {
+    if (glyphIndices[inPtId] >= 0 && !this->IsPointVisible(input, inPtId))
     {
-      outputCD->CopyGlobalIdsOn();
-      outputCD->CopyAllocate(pd, numPts * numSourceCells);
+      glyphIndices[inPtId] = -1;
     }
   }
+  this->UpdateProgress(0.2);
+  if (this->GetAbortExecute())
+  {
+    return true;
+  }
 
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  dstCellIdList->SetNumberOfIds(numSourceCells);
+  // Count the output of each block of points, and turn the counts into the
+  // offsets of the output of each block.
+  const vtkIdType numBlocks = (numPts + GlyphBlockSize - 1) / GlyphBlockSize;
+  std::vector<GlyphOffsets> blockOffsets(numBlocks + 1);
+  GlyphOffsets* blockOffsetsPtr = blockOffsets.data();
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+    for (; block < endBlock; ++block)
+    {
+      const vtkIdType endPtId = std::min(numPts, (block + 1) * GlyphBlockSize);
+      for (vtkIdType inPtId = block * GlyphBlockSize; inPtId < endPtId; ++inPtId)
+      {
+        if (glyphIndicesPtr[inPtId] >= 0)
+        {
+          blockOffsetsPtr[block + 1].Add(glyphsPtr[glyphIndicesPtr[inPtId]]);
+        }
+      }
+    }
+  });
+  for (vtkIdType block = 0; block < numBlocks; ++block)
+  {
+    blockOffsets[block + 1].Add(blockOffsets[block]);
+  }
+  const GlyphOffsets& totals = blockOffsets[numBlocks];
+  const vtkIdType numNewPts = totals.Points;
 
-  newPts = vtkPoints::New();
+  // Allocate the output arrays to their final size.
+  vtkNew<vtkPoints> newPts;
 
   // Set the desired precision for the points in the output.
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
   {
-    newPts->SetDataType(VTK_FLOAT);
+    newPts->SetDataType(VTK_DOUBLE);
   }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  else
   {
     newPts->SetDataType(VTK_FLOAT);
   }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_DOUBLE);
-  }
+  newPts->SetNumberOfPoints(numNewPts);
 
-  newPts->Allocate(numPts * numSourcePts);
+  vtkIdTypeArray* pointIds = nullptr;
   if (this->GeneratePointIds)
   {
     pointIds = vtkIdTypeArray::New();
     pointIds->SetName(this->PointIdsName);
-    pointIds->Allocate(numPts * numSourcePts);
-    outputPD->AddArray(pointIds);
-    pointIds->Delete();
+    pointIds->SetNumberOfValues(numNewPts);
   }
   if (this->ColorMode == VTK_COLOR_BY_SCALAR && inCScalars)
   {
     newScalars = inCScalars->NewInstance();
     newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
-    newScalars->Allocate(inCScalars->GetNumberOfComponents() * numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numNewPts);
     newScalars->SetName(inCScalars->GetName());
   }
   else if ((this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
   {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numNewPts);
     newScalars->SetName("GlyphScale");
     if (this->ScaleMode == VTK_SCALE_BY_SCALAR)
     {
@@ -370,360 +576,350 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   else if ((this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
   {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numNewPts);
     newScalars->SetName("VectorMagnitude");
   }
   if (haveVectors)
   {
     newVectors = vtkFloatArray::New();
     newVectors->SetNumberOfComponents(3);
-    newVectors->Allocate(3 * numPts * numSourcePts);
+    newVectors->SetNumberOfTuples(numNewPts);
     newVectors->SetName("GlyphVector");
   }
   if (haveNormals)
   {
     newNormals = vtkFloatArray::New();
     newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(numNewPts);
     newNormals->SetName("Normals");
   }
   if (haveTCoords)
   {
     newTCoords = vtkFloatArray::New();
-    int numComps = sourceTCoords->GetNumberOfComponents();
-    newTCoords->SetNumberOfComponents(numComps);
-    newTCoords->Allocate(numComps * numPts * numSourcePts);
+    newTCoords->SetNumberOfComponents(sourceTCoords->GetNumberOfComponents());
+    newTCoords->SetNumberOfTuples(numNewPts);
     newTCoords->SetName("TCoords");
   }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->AllocateEstimate(numPts * numSourceCells, 3);
-
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
+  vtkNew<vtkIdTypeArray> newOffsets[NumberOfCellTypes];
+  vtkNew<vtkIdTypeArray> newConnectivity[NumberOfCellTypes];
+  vtkIdType cellTypeOffsets[NumberOfCellTypes];
+  for (int type = 0; type < NumberOfCellTypes; ++type)
+  {
+    newOffsets[type]->SetNumberOfValues(totals.Cells[type] + 1);
+    newOffsets[type]->SetValue(totals.Cells[type], totals.Connectivity[type]);
+    newConnectivity[type]->SetNumberOfValues(totals.Connectivity[type]);
+    // Output cells are numbered verts first, then lines, polys and strips.
+    cellTypeOffsets[type] = type == 0 ? 0 : cellTypeOffsets[type - 1] + totals.Cells[type - 1];
+  }
 
-  // Traverse all Input points, transforming Source points and copying
-  // point attributes.
-  //
-  ptIncr = 0;
-  cellIncr = 0;
-  for (inPtId = 0; inPtId < numPts; inPtId++)
+  // Prepare to copy the input point data to the glyph points, and to the
+  // glyph cells if requested. Non-numeric arrays cannot be copied
+  // concurrently, and neither can bit arrays since their values share bytes
+  // (the array list would skip them anyway).
+  ArrayList pointArrays;
+  ArrayList cellArrays;
+  bool copyConcurrently = !(newScalars && newScalars->GetDataType() == VTK_BIT);
+  if (pd)
   {
-    scalex = scaley = scalez = 1.0;
-    if (!(inPtId % 10000))
+    outputPD->CopyAllocate(pd, numNewPts);
+    if (this->FillCellData)
     {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->GetAbortExecute())
-      {
-        break;
-      }
+      outputCD->CopyGlobalIdsOn();
+      outputCD->CopyAllocate(pd, cellTypeOffsets[NumberOfCellTypes - 1] +
+          totals.Cells[NumberOfCellTypes - 1]);
     }
-
-    // Get the scalar and vector data
-    if (inSScalars)
+    for (int i = 0; i < pd->GetNumberOfArrays(); ++i)
     {
-      s = inSScalars->GetComponent(inPtId, 0);
-      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      copyConcurrently = copyConcurrently && pd->GetArray(i) != nullptr &&
+        pd->GetArray(i)->GetDataType() != VTK_BIT;
+    }
+    if (copyConcurrently)
+    {
+      pointArrays.AddArrays(numNewPts, pd, outputPD, 0.0, false);
+      if (this->FillCellData)
       {
-        scalex = scaley = scalez = s;
+        cellArrays.AddArrays(cellTypeOffsets[NumberOfCellTypes - 1] +
+            totals.Cells[NumberOfCellTypes - 1],
+          pd, outputCD, 0.0, false);
       }
     }
+  }
+  this->UpdateProgress(0.3);
 
-    if (haveVectors)
+  // Traverse all Input points, transforming Source points and copying
+  // point attributes.
+  //
+  vtkSMPThreadLocalObject<vtkTransform> localTransforms;
+  float* newPtsFloat = newPts->GetDataType() == VTK_FLOAT
+    ? static_cast<float*>(newPts->GetVoidPointer(0))
+    : nullptr;
+  double* newPtsDouble = newPts->GetDataType() == VTK_DOUBLE
+    ? static_cast<double*>(newPts->GetVoidPointer(0))
+    : nullptr;
+  auto generateGlyphs = [&](vtkIdType block, vtkIdType endBlock) {
+    vtkTransform* trans = localTransforms.Local();
+    GlyphPoint glyphPoint;
+    double x[3], vNew[3], tc[3], normal[3], normalMatrix[16];
+    float* outNormal;
+    for (; block < endBlock; ++block)
     {
-      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
-      {
-        vMag = 1.0; // v will be set later
-      }
-      else
+      GlyphOffsets offsets = blockOffsetsPtr[block];
+      const vtkIdType endPtId = std::min(numPts, (block + 1) * GlyphBlockSize);
+      for (vtkIdType inPtId = block * GlyphBlockSize; inPtId < endPtId; ++inPtId)
       {
-        vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
-        if (array3D->GetNumberOfComponents() > 3)
+        if (glyphIndicesPtr[inPtId] < 0)
         {
-          vtkErrorMacro(<< "vtkDataArray " << array3D->GetName()
-                        << " has more than 3 components.\n");
-          pts->Delete();
-          trans->Delete();
-          if (newPts)
+          continue;
+        }
+        const GlyphSource& glyph = glyphsPtr[glyphIndicesPtr[inPtId]];
+        evaluate(inPtId, glyphPoint);
+        double* v = glyphPoint.Vector;
+        double* scale = glyphPoint.Scale;
+        const double vMag = glyphPoint.VectorMagnitude;
+        const vtkIdType numSourcePts = glyph.NumberOfPoints;
+        const vtkIdType ptIncr = offsets.Points;
+
+        // Copy all topology (transformation independent)
+        for (int type = 0; type < NumberOfCellTypes; ++type)
+        {
+          const vtkIdType numCells = glyph.GetNumberOfCells(type);
+          vtkIdType* outOffsets = newOffsets[type]->GetPointer(offsets.Cells[type]);
+          for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
           {
-            newPts->Delete();
+            outOffsets[cellId] = glyph.Offsets[type][cellId] + offsets.Connectivity[type];
           }
-          if (newVectors)
+          vtkIdType* outConnectivity =
+            newConnectivity[type]->GetPointer(offsets.Connectivity[type]);
+          for (const vtkIdType ptId : glyph.Connectivity[type])
           {
-            newVectors->Delete();
+            *outConnectivity++ = ptId + ptIncr;
           }
-          return false;
-        }
-
-        v[0] = 0;
-        v[1] = 0;
-        v[2] = 0;
-        array3D->GetTuple(inPtId, v);
-        vMag = vtkMath::Norm(v);
-        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
-        {
-          scalex = v[0];
-          scaley = v[1];
-          scalez = v[2];
         }
-        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
-        {
-          scalex = scaley = scalez = vMag;
-        }
-      }
-    }
-
-    // Clamp data scale if enabled
-    if (this->Clamping)
-    {
-      scalex = (scalex < this->Range[0] ? this->Range[0]
-                                        : (scalex > this->Range[1] ? this->Range[1] : scalex));
-      scalex = (scalex - this->Range[0]) / den;
-      scaley = (scaley < this->Range[0] ? this->Range[0]
-                                        : (scaley > this->Range[1] ? this->Range[1] : scaley));
-      scaley = (scaley - this->Range[0]) / den;
-      scalez = (scalez < this->Range[0] ? this->Range[0]
-                                        : (scalez > this->Range[1] ? this->Range[1] : scalez));
-      scalez = (scalez - this->Range[0]) / den;
-    }
 
-    // Compute index into table of glyphs
-    if (this->IndexMode != VTK_INDEXING_OFF)
-    {
-      if (this->IndexMode == VTK_INDEXING_BY_SCALAR)
-      {
-        value = s;
-      }
-      else
-      {
-        value = vMag;
-      }
+        // Now begin copying/transforming glyph
+        trans->Identity();
 
-      int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
-      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+        // translate Source to Input point
+        input->GetPoint(inPtId, x);
+        trans->Translate(x[0], x[1], x[2]);
 
-      source = this->GetSource(index, sourceVector);
-      if (source != nullptr)
-      {
-        sourcePts = source->GetPoints();
-        sourceNormals = source->GetPointData()->GetNormals();
-        numSourcePts = sourcePts->GetNumberOfPoints();
-        numSourceCells = source->GetNumberOfCells();
-      }
-    }
-
-    // Make sure we're not indexing into empty glyph
-    if (source == nullptr)
-    {
-      continue;
-    }
+        if (haveVectors)
+        {
+          if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+          {
+            // v = glyphNormal_World (glyph normal direction in World coordinate system)
+            v[0] = this->FollowedCameraPosition[0] - x[0];
+            v[1] = this->FollowedCameraPosition[1] - x[1];
+            v[2] = this->FollowedCameraPosition[2] - x[2];
+            vtkMath::Normalize(v);
+          }
 
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate glyphs on the borders.
-    if (inGhostLevels &&
-      inGhostLevels[inPtId] &
-        (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT))
-    {
-      continue;
-    }
+          // Copy Input vector
+          float* outVector = static_cast<vtkFloatArray*>(newVectors)->GetPointer(3 * ptIncr);
+          for (vtkIdType i = 0; i < numSourcePts; i++, outVector += 3)
+          {
+            outVector[0] = static_cast<float>(v[0]);
+            outVector[1] = static_cast<float>(v[1]);
+            outVector[2] = static_cast<float>(v[2]);
+          }
+          if (this->Orient)
+          {
+            if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+            {
+              double glyphRight_World[3]; // glyph right direction in World coordinate system
+              vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
+              // glyph up direction in World coordinate system
+              // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
+              // orthogonal to the normal direction)
+              double glyphUp_World[3];
+              vtkMath::Cross(v, glyphRight_World, glyphUp_World);
+              double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
+                glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2],
+                glyphUp_World[2], v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
+              trans->Concatenate(glyphToWorld);
+            }
+            else if (vMag > 0.0)
+            {
+              // if there is no y or z component
+              if (v[1] == 0.0 && v[2] == 0.0)
+              {
+                if (v[0] < 0) // just flip x if we need to
+                {
+                  trans->RotateWXYZ(180.0, 0, 1, 0);
+                }
+              }
+              else
+              {
+                vNew[0] = (v[0] + vMag) / 2.0;
+                vNew[1] = v[1] / 2.0;
+                vNew[2] = v[2] / 2.0;
+                trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+              }
+            }
+          }
+        }
 
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
-    }
+        if (haveTCoords)
+        {
+          for (vtkIdType i = 0; i < numSourcePts; i++)
+          {
+            sourceTCoords->GetTuple(i, tc);
+            newTCoords->SetTuple(i + ptIncr, tc);
+          }
+        }
 
-    if (!this->IsPointVisible(input, inPtId))
-    {
-      continue;
-    }
+        // determine scale factor from scalars if appropriate
+        // Copy scalar value
+        if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
+        {
+          float* outScalar = static_cast<vtkFloatArray*>(newScalars)->GetPointer(ptIncr);
+          std::fill_n(outScalar, numSourcePts, static_cast<float>(scale[0])); // = scaley = scalez
+        }
+        else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
+        {
+          for (vtkIdType i = 0; i < numSourcePts; i++)
+          {
+            newScalars->SetTuple(ptIncr + i, inPtId, inCScalars);
+          }
+        }
+        if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
+        {
+          float* outScalar = static_cast<vtkFloatArray*>(newScalars)->GetPointer(ptIncr);
+          std::fill_n(outScalar, numSourcePts, static_cast<float>(vMag));
+        }
 
-    // Now begin copying/transforming glyph
-    trans->Identity();
+        // scale data if appropriate
+        if (this->Scaling)
+        {
+          if (this->ScaleMode == VTK_DATA_SCALING_OFF)
+          {
+            scale[0] = scale[1] = scale[2] = this->ScaleFactor;
+          }
+          else
+          {
+            scale[0] *= this->ScaleFactor;
+            scale[1] *= this->ScaleFactor;
+            scale[2] *= this->ScaleFactor;
+          }
 
-    // Copy all topology (transformation independent)
-    for (cellId = 0; cellId < numSourceCells; cellId++)
-    {
-      source->GetCellPoints(cellId, pointIdList);
-      cellPts = pointIdList;
-      npts = cellPts->GetNumberOfIds();
-      for (pts->Reset(), i = 0; i < npts; i++)
-      {
-        pts->InsertId(i, cellPts->GetId(i) + ptIncr);
-      }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
-    }
+          for (int i = 0; i < 3; ++i)
+          {
+            if (scale[i] == 0.0)
+            {
+              scale[i] = 1.0e-10;
+            }
+          }
+          trans->Scale(scale[0], scale[1], scale[2]);
+        }
 
-    // translate Source to Input point
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
+        // multiply points and normals by resulting matrix
+        const double(*matrix)[4] = trans->GetMatrix()->Element;
+        if (newPtsFloat)
+        {
+          TransformGlyphPoints(matrix, glyph, newPtsFloat + 3 * ptIncr);
+        }
+        else
+        {
+          TransformGlyphPoints(matrix, glyph, newPtsDouble + 3 * ptIncr);
+        }
 
-    if (haveVectors)
-    {
-      // Copy Input vector
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newVectors->InsertTuple(i + ptIncr, v);
-      }
-      if (this->Orient)
-      {
-        if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+        if (haveNormals)
         {
-          // v = glyphNormal_World (glyph normal direction in World coordinate system)
-          v[0] = this->FollowedCameraPosition[0] - x[0];
-          v[1] = this->FollowedCameraPosition[1] - x[1];
-          v[2] = this->FollowedCameraPosition[2] - x[2];
-          vtkMath::Normalize(v);
-          double glyphRight_World[3]; // glyph right direction in World coordinate system
-          vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
-          // glyph up direction in World coordinate system
-          // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
-          // orthogonal to the normal direction)
-          double glyphUp_World[3];
-          vtkMath::Cross(v, glyphRight_World, glyphUp_World);
-          double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
-            glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2], glyphUp_World[2],
-            v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
-          trans->Concatenate(glyphToWorld);
+          // to transform the normals, multiply by the transposed inverse matrix
+          vtkMatrix4x4::DeepCopy(normalMatrix, trans->GetMatrix());
+          vtkMatrix4x4::Invert(normalMatrix, normalMatrix);
+          vtkMatrix4x4::Transpose(normalMatrix, normalMatrix);
+          outNormal = static_cast<vtkFloatArray*>(newNormals)->GetPointer(3 * ptIncr);
+          for (vtkIdType i = 0; i < numSourcePts; i++, outNormal += 3)
+          {
+            glyph.Normals->GetTuple(i, normal);
+            for (int j = 0; j < 3; ++j)
+            {
+              outNormal[j] = static_cast<float>(normalMatrix[4 * j] * normal[0] +
+                normalMatrix[4 * j + 1] * normal[1] + normalMatrix[4 * j + 2] * normal[2]);
+            }
+            vtkMath::Normalize(outNormal);
+          }
         }
-        else if (vMag > 0.0)
+
+        // Copy point data from source (if possible)
+        if (pd)
         {
-          // if there is no y or z component
-          if (v[1] == 0.0 && v[2] == 0.0)
+          for (vtkIdType i = 0; i < numSourcePts; ++i)
           {
-            if (v[0] < 0) // just flip x if we need to
+            if (copyConcurrently)
+            {
+              pointArrays.Copy(inPtId, ptIncr + i);
+            }
+            else
             {
-              trans->RotateWXYZ(180.0, 0, 1, 0);
+              outputPD->CopyData(pd, inPtId, ptIncr + i);
             }
           }
-          else
+          if (this->FillCellData)
           {
-            vNew[0] = (v[0] + vMag) / 2.0;
-            vNew[1] = v[1] / 2.0;
-            vNew[2] = v[2] / 2.0;
-            trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+            for (int type = 0; type < NumberOfCellTypes; ++type)
+            {
+              const vtkIdType cellIncr = cellTypeOffsets[type] + offsets.Cells[type];
+              for (vtkIdType i = 0; i < glyph.GetNumberOfCells(type); ++i)
+              {
+                if (copyConcurrently)
+                {
+                  cellArrays.Copy(inPtId, cellIncr + i);
+                }
+                else
+                {
+                  outputCD->CopyData(pd, inPtId, cellIncr + i);
+                }
+              }
+            }
           }
         }
-      }
-    }
-
-    if (haveTCoords)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        sourceTCoords->GetTuple(i, tc);
-        newTCoords->InsertTuple(i + ptIncr, tc);
-      }
-    }
-
-    // determine scale factor from scalars if appropriate
-    // Copy scalar value
-    if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &scalex); // = scaley = scalez
-      }
-    }
-    else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr + i);
-      }
-    }
-    if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &vMag);
-      }
-    }
 
-    // scale data if appropriate
-    if (this->Scaling)
-    {
-      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = this->ScaleFactor;
-      }
-      else
-      {
-        scalex *= this->ScaleFactor;
-        scaley *= this->ScaleFactor;
-        scalez *= this->ScaleFactor;
-      }
-
-      if (scalex == 0.0)
-      {
-        scalex = 1.0e-10;
-      }
-      if (scaley == 0.0)
-      {
-        scaley = 1.0e-10;
-      }
-      if (scalez == 0.0)
-      {
-        scalez = 1.0e-10;
-      }
-      trans->Scale(scalex, scaley, scalez);
-    }
-
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
-    {
-      trans->TransformPoints(sourcePts, newPts);
-    }
-
-    if (haveNormals)
-    {
-      trans->TransformNormals(sourceNormals, newNormals);
-    }
-
-    // Copy point data from source (if possible)
-    if (pd)
-    {
-      for (i = 0; i < numSourcePts; ++i)
-      {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
-      }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
-      if (this->FillCellData)
-      {
-        for (i = 0; i < numSourceCells; ++i)
+        // If point ids are to be generated, do it here
+        if (this->GeneratePointIds)
         {
-          srcCellIdList->SetId(i, inPtId);
-          dstCellIdList->SetId(i, cellIncr + i);
+          std::fill_n(pointIds->GetPointer(ptIncr), numSourcePts, inPtId);
         }
-        outputCD->CopyData(pd, srcCellIdList, dstCellIdList);
-      }
-    }
 
-    // If point ids are to be generated, do it here
-    if (this->GeneratePointIds)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        pointIds->InsertNextValue(inPtId);
+        offsets.Add(glyph);
       }
     }
-
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
+  };
+  if (copyConcurrently)
+  {
+    vtkSMPTools::For(0, numBlocks, generateGlyphs);
+  }
+  else
+  {
+    vtkSMPTools::LocalScope(
+      vtkSMPTools::Config{ 1 }, [&]() { vtkSMPTools::For(0, numBlocks, generateGlyphs); });
   }
 
   // Update ourselves and release memory
   //
   output->SetPoints(newPts);
-  newPts->Delete();
+  vtkCellArray* newCells[NumberOfCellTypes];
+  for (int type = 0; type < NumberOfCellTypes; ++type)
+  {
+    newCells[type] = vtkCellArray::New();
+    newCells[type]->SetData(newOffsets[type], newConnectivity[type]);
+  }
+  output->SetVerts(newCells[0]);
+  output->SetLines(newCells[1]);
+  output->SetPolys(newCells[2]);
+  output->SetStrips(newCells[3]);
+  for (int type = 0; type < NumberOfCellTypes; ++type)
+  {
+    newCells[type]->Delete();
+  }
+
+  if (pointIds)
+  {
+    outputPD->AddArray(pointIds);
+    pointIds->Delete();
+  }
 
   if (newScalars)
   {
@@ -751,8 +947,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   }
 
   output->Squeeze();
-  trans->Delete();
-  pts->Delete();
 
   return true;
 }
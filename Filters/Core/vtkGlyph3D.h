@@ -73,6 +73,13 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The size of the output of
+ * the input points is computed first, so that the glyphs are transformed and
+ * written concurrently at their final place in the output. The output does
+ * not depend on the number of threads. IsPointVisible() is called serially,
+ * so that subclasses overriding it need not be thread safe.
+ *
  * @sa
  * vtkTensorGlyph
  */
@@ -17,6 +17,7 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectedRegionsInternal.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -129,11 +130,18 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     }
   }
 
-  // Build cell structure
+  const bool seeded = this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION;
+
+  // Build cell structure. The links are only needed to grow seeded regions.
   //
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  if (seeded)
+  {
+    this->Mesh->BuildLinks();
+  }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -184,34 +192,33 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
-  if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
-    this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
-    this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
-  { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+  if (!seeded)
+  { // label all cells with their region number, using multiple threads
+    ConnectedRegions regions;
+    regions.Label(this->Mesh, this->InScalars, this->ScalarRange, this->FullScalarConnectivity != 0);
+    this->UpdateProgress(0.8);
+
+    std::copy(regions.CellRegions.begin(), regions.CellRegions.end(), this->Visited);
+    // The points are numbered in the order of the input points.
+    vtkIdTypeArray* newScalars = vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars);
+    for (i = 0; i < numPts; i++)
     {
-      if (cellId && !(cellId % 5000))
+      if (regions.PointRegions[i] >= 0)
       {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
+        this->PointMap[i] = this->PointNumber++;
+        newScalars->SetValue(this->PointMap[i], regions.PointRegions[i]);
       }
-
-      if (this->Visited[cellId] < 0)
+    }
+    for (const vtkIdType numCellsInRegion : regions.RegionSizes)
+    {
+      if (numCellsInRegion > maxCellsInRegion)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave.push_back(cellId);
-        this->TraverseAndMark();
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
-        {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
-        }
-
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave.clear();
-        this->Wave2.clear();
+        maxCellsInRegion = numCellsInRegion;
+        largestRegionId = this->RegionNumber;
       }
+      this->RegionSizes->InsertValue(this->RegionNumber++, numCellsInRegion);
     }
+    this->UpdateProgress(0.9);
   }
   else // regions have been seeded, everything considered in same region
   {
@@ -43,6 +43,12 @@
  * This use of ScalarConnectivity is particularly useful for selecting cells
  * for later processing.
  *
+ * When all the cells are visited (extraction of all, largest or specified
+ * regions), the regions are labeled using multiple threads, with a concurrent
+ * union-find of the points of the connected cells. The regions are numbered
+ * in the order of their lowest cell id, whatever the number of threads, and
+ * the output points keep the order of the input points.
+ *
  * @sa
  * vtkConnectivityFilter
  */
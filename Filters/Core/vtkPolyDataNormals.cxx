@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPolyDataNormals.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
@@ -27,12 +28,432 @@
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLinksTemplate.h"
 #include "vtkTriangleStrip.h"
 
-#include "vtkNew.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 vtkStandardNewMacro(vtkPolyDataNormals);
 
+namespace
+{
+using PolyLinks = vtkStaticCellLinksTemplate<vtkIdType>;
+
+const char CellNotVisited = 0;
+const char CellVisited = 1;
+
+// Waves of polygons smaller than this are traversed without spawning threads.
+const vtkIdType SerialWaveSize = 1024;
+
+// Build the links with the cells of each point in increasing order, as
+// vtkPolyData::BuildLinks() does: the traversals below depend on this order.
+void BuildSortedLinks(PolyLinks& links, vtkIdType numPts, vtkCellArray* polys)
+{
+  links.ThreadedBuildLinks(numPts, polys->GetNumberOfCells(), polys);
+  PolyLinks* linksPtr = &links;
+  vtkSMPTools::For(0, numPts, [linksPtr](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType* cells = linksPtr->GetCells(ptId);
+      std::sort(cells, cells + linksPtr->GetNcells(ptId));
+    }
+  });
+}
+
+// Same as vtkPolyData::GetCellEdgeNeighbors(), using the static links.
+void GetCellEdgeNeighbors(
+  PolyLinks* links, vtkIdType cellId, vtkIdType p1, vtkIdType p2, std::vector<vtkIdType>& cellIds)
+{
+  cellIds.clear();
+  const vtkIdType* cells1 = links->GetCells(p1);
+  const vtkIdType* cells1End = cells1 + links->GetNcells(p1);
+  const vtkIdType* cells2 = links->GetCells(p2);
+  const vtkIdType* cells2End = cells2 + links->GetNcells(p2);
+  for (; cells1 != cells1End; ++cells1)
+  {
+    if (*cells1 != cellId && std::find(cells2, cells2End, *cells1) != cells2End)
+    {
+      cellIds.push_back(*cells1);
+    }
+  }
+}
+
+template <typename Functor>
+void ForWave(vtkIdType size, Functor& functor)
+{
+  if (size < SerialWaveSize)
+  {
+    functor(0, size);
+  }
+  else
+  {
+    vtkSMPTools::For(0, size, functor);
+  }
+}
+
+// Propagate waves of consistently ordered polygons from a seed polygon.
+// Each wave is processed in parallel: an unvisited polygon is ordered by the
+// first polygon of the wave (in wave order) that it is an edge neighbor of,
+// and the next wave lists the polygons in the order they would be found by a
+// serial traversal of the wave. The result thus does not depend on the
+// number of threads.
+class PolygonOrderTraversal
+{
+public:
+  PolygonOrderTraversal(
+    vtkCellArray* polys, PolyLinks* links, char* visited, bool nonManifoldTraversal)
+    : Polys(polys)
+    , Links(links)
+    , Visited(visited)
+    , NonManifoldTraversal(nonManifoldTraversal)
+    , Claims(new std::atomic<vtkIdType>[polys->GetNumberOfCells()])
+  {
+    for (vtkIdType cellId = 0; cellId < polys->GetNumberOfCells(); ++cellId)
+    {
+      this->Claims[cellId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  }
+
+  // Traverse from the given (visited) seed, returning the number of
+  // polygons reordered.
+  vtkIdType Traverse(vtkIdType seedId)
+  {
+    std::vector<vtkIdType> wave(1, seedId);
+    std::vector<vtkIdType> nextWave;
+    std::vector<vtkIdType> offsets;
+    std::atomic<vtkIdType> numFlips(0);
+
+    while (!wave.empty())
+    {
+      const vtkIdType* waveIds = wave.data();
+      const vtkIdType numIds = static_cast<vtkIdType>(wave.size());
+
+      // Each unvisited neighbor is claimed by the first polygon of the wave.
+      auto claim = [this, waveIds](vtkIdType idx, vtkIdType endIdx) {
+        TraversalScratch& scratch = this->Scratch.Local();
+        for (; idx < endIdx; ++idx)
+        {
+          this->ForEachUnvisitedNeighbor(
+            waveIds[idx], scratch, [this, idx](vtkIdType neighbor, vtkIdType, vtkIdType) {
+              vtkIdType current = this->Claims[neighbor].load(std::memory_order_relaxed);
+              while (idx < current &&
+                !this->Claims[neighbor].compare_exchange_weak(
+                  current, idx, std::memory_order_relaxed))
+              {
+              }
+            });
+        }
+      };
+      ForWave(numIds, claim);
+
+      // Count the neighbors claimed by each polygon of the wave to know where
+      // they go in the next wave.
+      offsets.assign(numIds + 1, 0);
+      vtkIdType* offsetsPtr = offsets.data();
+      auto count = [this, waveIds, offsetsPtr](vtkIdType idx, vtkIdType endIdx) {
+        TraversalScratch& scratch = this->Scratch.Local();
+        for (; idx < endIdx; ++idx)
+        {
+          scratch.Claimed.clear();
+          this->ForEachUnvisitedNeighbor(waveIds[idx], scratch,
+            [this, idx, &scratch](vtkIdType neighbor, vtkIdType, vtkIdType) {
+              if (this->Claims[neighbor].load(std::memory_order_relaxed) == idx &&
+                std::find(scratch.Claimed.begin(), scratch.Claimed.end(), neighbor) ==
+                  scratch.Claimed.end())
+              {
+                scratch.Claimed.push_back(neighbor);
+              }
+            });
+          offsetsPtr[idx + 1] = static_cast<vtkIdType>(scratch.Claimed.size());
+        }
+      };
+      ForWave(numIds, count);
+      for (vtkIdType idx = 0; idx < numIds; ++idx)
+      {
+        offsets[idx + 1] += offsets[idx];
+      }
+
+      //  Check the direction of the neighbor ordering.  Should be
+      //  consistent with us (i.e., if we are n1->n2,
+      // neighbor should be n2->n1).
+      nextWave.resize(offsets[numIds]);
+      vtkIdType* nextIds = nextWave.data();
+      std::atomic<vtkIdType>* flips = &numFlips;
+      auto order = [this, waveIds, offsetsPtr, nextIds, flips](vtkIdType idx, vtkIdType endIdx) {
+        TraversalScratch& scratch = this->Scratch.Local();
+        for (; idx < endIdx; ++idx)
+        {
+          scratch.Claimed.clear();
+          vtkIdType* next = nextIds + offsetsPtr[idx];
+          this->ForEachUnvisitedNeighbor(waveIds[idx], scratch,
+            [this, idx, &scratch, &next, flips](vtkIdType neighbor, vtkIdType p1, vtkIdType p2) {
+              if (this->Claims[neighbor].load(std::memory_order_relaxed) != idx ||
+                std::find(scratch.Claimed.begin(), scratch.Claimed.end(), neighbor) !=
+                  scratch.Claimed.end())
+              {
+                return;
+              }
+              scratch.Claimed.push_back(neighbor);
+
+              vtkIdType numNeiPts;
+              const vtkIdType* neiPts;
+              this->Polys->GetCellAtId(
+                neighbor, numNeiPts, neiPts, this->NeighborPoints.Local());
+              vtkIdType l;
+              for (l = 0; l < numNeiPts; l++)
+              {
+                if (neiPts[l] == p2)
+                {
+                  break;
+                }
+              }
+
+              //  Have to reverse ordering if neighbor not consistent
+              //
+              if (neiPts[(l + 1) % numNeiPts] != p1)
+              {
+                flips->fetch_add(1, std::memory_order_relaxed);
+                this->Polys->ReverseCellAtId(neighbor);
+              }
+              *next++ = neighbor;
+            });
+        }
+      };
+      ForWave(numIds, order);
+
+      char* visited = this->Visited;
+      auto markVisited = [visited, nextIds](vtkIdType idx, vtkIdType endIdx) {
+        for (; idx < endIdx; ++idx)
+        {
+          visited[nextIds[idx]] = CellVisited;
+        }
+      };
+      ForWave(static_cast<vtkIdType>(nextWave.size()), markVisited);
+
+      // swap wave and proceed with propagation
+      wave.swap(nextWave);
+    }
+
+    return numFlips.load();
+  }
+
+private:
+  struct TraversalScratch
+  {
+    std::vector<vtkIdType> Neighbors;
+    std::vector<vtkIdType> Claimed;
+  };
+
+  // Call visit(neighbor, p1, p2) for each unvisited polygon sharing the edge
+  // (p1, p2) of the polygon cellId, in the order of a serial traversal.
+  template <typename Visitor>
+  void ForEachUnvisitedNeighbor(vtkIdType cellId, TraversalScratch& scratch, Visitor visit)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    this->Polys->GetCellAtId(cellId, npts, pts, this->CellPoints.Local());
+    for (vtkIdType j = 0; j < npts; ++j) // for each edge neighbor
+    {
+      const vtkIdType j1 = (j + 1 < npts) ? j + 1 : 0;
+      GetCellEdgeNeighbors(this->Links, cellId, pts[j], pts[j1], scratch.Neighbors);
+      if (scratch.Neighbors.size() == 1 || this->NonManifoldTraversal)
+      {
+        for (vtkIdType neighbor : scratch.Neighbors)
+        {
+          if (this->Visited[neighbor] == CellNotVisited)
+          {
+            visit(neighbor, pts[j], pts[j1]);
+          }
+        }
+      }
+    }
+  }
+
+  vtkCellArray* Polys;
+  PolyLinks* Links;
+  char* Visited;
+  bool NonManifoldTraversal;
+  std::unique_ptr<std::atomic<vtkIdType>[]> Claims;
+  vtkSMPThreadLocal<TraversalScratch> Scratch;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+  vtkSMPThreadLocalObject<vtkIdList> NeighborPoints;
+};
+
+// Mark the regions of polygons around each point: the polygons connected
+// across edges that are not sharp, non-manifold nor on the boundary belong to
+// the same region. The region of a polygon around a point is stored in the
+// slot of the polygon in the links of the point. A point used by N regions is
+// later split into N points.
+struct MarkRegions
+{
+  vtkCellArray* Polys;
+  PolyLinks* Links;
+  const float* PolyNormals;
+  double CosAngle;
+  int* Regions;
+  vtkIdType* NumNewPts;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> Neighbors;
+
+  MarkRegions(vtkCellArray* polys, PolyLinks* links, const float* polyNormals, double cosAngle,
+    int* regions, vtkIdType* numNewPts)
+    : Polys(polys)
+    , Links(links)
+    , PolyNormals(polyNormals)
+    , CosAngle(cosAngle)
+    , Regions(regions)
+    , NumNewPts(numNewPts)
+  {
+  }
+
+  int& Region(vtkIdType ptId, vtkIdType cellId)
+  {
+    const vtkIdType* cells = this->Links->GetCells(ptId);
+    const vtkIdType slot =
+      std::lower_bound(cells, cells + this->Links->GetNcells(ptId), cellId) - cells;
+    return this->Regions[this->Links->GetOffset(ptId) + slot];
+  }
+
+  void GetNormal(vtkIdType cellId, double normal[3])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      normal[i] = this->PolyNormals[3 * cellId + i];
+    }
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkIdList* cellPoints = this->CellPoints.Local();
+    std::vector<vtkIdType>& neighbors = this->Neighbors.Local();
+    vtkIdType numPts;
+    const vtkIdType* pts;
+    vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
+    double thisNormal[3], neiNormal[3];
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      // Get the cells using this point and make sure that we have to do something
+      const vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType* cells = this->Links->GetCells(ptId);
+      int* regions = this->Regions + this->Links->GetOffset(ptId);
+      this->NumNewPts[ptId] = 0;
+      if (ncells <= 1)
+      {
+        std::fill_n(regions, ncells, 0);
+        continue; // point does not need to be further disconnected
+      }
+
+      // Start by initializing the cells as unvisited
+      std::fill_n(regions, ncells, -1);
+
+      // Loop over all cells and mark the region that each is in.
+      int numRegions = 0;
+      for (vtkIdType j = 0; j < ncells; j++) // for all cells connected to point
+      {
+        int& seedRegion = this->Region(ptId, cells[j]);
+        if (seedRegion >= 0)
+        {
+          continue;
+        }
+        seedRegion = numRegions;
+        // okay, mark all the cells connected to this seed cell and using ptId
+        this->Polys->GetCellAtId(cells[j], numPts, pts, cellPoints);
+
+        // find the two edges
+        for (spot = 0; spot < numPts; spot++)
+        {
+          if (pts[spot] == ptId)
+          {
+            break;
+          }
+        }
+
+        if (spot == 0)
+        {
+          neiPt[0] = pts[spot + 1];
+          neiPt[1] = pts[numPts - 1];
+        }
+        else if (spot == (numPts - 1))
+        {
+          neiPt[0] = pts[spot - 1];
+          neiPt[1] = pts[0];
+        }
+        else
+        {
+          neiPt[0] = pts[spot + 1];
+          neiPt[1] = pts[spot - 1];
+        }
+
+        for (int i = 0; i < 2; i++) // for each of the two edges of the seed cell
+        {
+          cellId = cells[j];
+          nei = neiPt[i];
+          while (cellId >= 0) // while we can grow this region
+          {
+            GetCellEdgeNeighbors(this->Links, cellId, ptId, nei, neighbors);
+            if (neighbors.size() == 1 && this->Region(ptId, (neiCellId = neighbors[0])) < 0)
+            {
+              this->GetNormal(cellId, thisNormal);
+              this->GetNormal(neiCellId, neiNormal);
+
+              if (vtkMath::Dot(thisNormal, neiNormal) > this->CosAngle)
+              {
+                // visit and arrange to visit next edge neighbor
+                this->Region(ptId, neiCellId) = numRegions;
+                cellId = neiCellId;
+                this->Polys->GetCellAtId(cellId, numPts, pts, cellPoints);
+
+                for (spot = 0; spot < numPts; spot++)
+                {
+                  if (pts[spot] == ptId)
+                  {
+                    break;
+                  }
+                }
+
+                if (spot == 0)
+                {
+                  nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[numPts - 1]);
+                }
+                else if (spot == (numPts - 1))
+                {
+                  nei = (pts[spot - 1] != nei ? pts[spot - 1] : pts[0]);
+                }
+                else
+                {
+                  nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[spot - 1]);
+                }
+
+              } // if not separated by edge angle
+              else
+              {
+                cellId = -1; // separated by edge angle
+              }
+            } // if can move to edge neighbor
+            else
+            {
+              cellId = -1; // separated by previous visit, boundary, or non-manifold
+            }
+          } // while visit wave is propagating
+        }   // for each of the two edges of the starting cell
+        numRegions++;
+      } // for all cells connected to point ptId
+
+      // For N regions, N-1 duplicate (split) points are created.
+      this->NumNewPts[ptId] = numRegions - 1;
+    }
+  }
+};
+} // anonymous namespace
+
 // Construct with feature angle=30, splitting and consistency turned on,
 // flipNormals turned off, and non-manifold traversal turned on.
 vtkPolyDataNormals::vtkPolyDataNormals()
@@ -48,22 +469,8 @@ vtkPolyDataNormals::vtkPolyDataNormals()
   // some internal data
   this->NumFlips = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
-  this->Wave = nullptr;
-  this->Wave2 = nullptr;
-  this->CellIds = nullptr;
-  this->CellPoints = nullptr;
-  this->NeighborPoints = nullptr;
-  this->Map = nullptr;
-  this->OldMesh = nullptr;
-  this->NewMesh = nullptr;
-  this->Visited = nullptr;
-  this->PolyNormals = nullptr;
-  this->CosAngle = 0.0;
 }
 
-#define VTK_CELL_NOT_VISITED 0
-#define VTK_CELL_VISITED 1
-
 // Generate normals for polygon meshes
 int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -81,17 +488,14 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   vtkIdType numNewPts;
   double flipDirection = 1.0;
   vtkIdType numVerts, numLines, numPolys, numStrips;
-  vtkIdType cellId;
   vtkIdType numPts;
   vtkPoints* inPts;
-  vtkCellArray *inPolys, *inStrips, *polys;
-  vtkPoints* newPts = nullptr;
-  vtkFloatArray* newNormals;
+  vtkCellArray *inPolys, *inStrips;
+  vtkSmartPointer<vtkCellArray> polys;
+  vtkSmartPointer<vtkPoints> newPts;
   vtkPointData *pd, *outPD;
   vtkDataSetAttributes* outCD = output->GetCellData();
   double n[3];
-  vtkCellArray* newPolys;
-  vtkIdType ptId, oldId;
 
   vtkDebugMacro(<< "Generating surface normals");
 
@@ -120,16 +524,13 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     output->GetCellData()->PassData(input->GetCellData());
   }
 
-  // Load data into cell structure.  We need two copies: one is a
-  // non-writable mesh used to perform topological queries.  The other
-  // is used to write into and modify the connectivity of the mesh.
+  // Load the polygons. The input polygons are used to perform topological
+  // queries, and a copy of them is reordered and split.
   //
   inPts = input->GetPoints();
   inPolys = input->GetPolys();
   inStrips = input->GetStrips();
 
-  this->OldMesh = vtkPolyData::New();
-  this->OldMesh->SetPoints(inPts);
   if (numStrips > 0) // have to decompose strips into triangles
   {
     vtkDataSetAttributes* inCD = input->GetCellData();
@@ -138,9 +539,9 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     // triangles, cell data cannot be passed as it is and needs to
     // be copied tuple by tuple.
     outCD->CopyAllocate(inCD);
+    polys = vtkSmartPointer<vtkCellArray>::New();
     if (numPolys > 0)
     {
-      polys = vtkCellArray::New();
       polys->DeepCopy(inPolys);
       vtkNew<vtkIdList> ids;
       ids->SetNumberOfIds(numPolys);
@@ -152,7 +553,6 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     }
     else
     {
-      polys = vtkCellArray::New();
       polys->AllocateEstimate(numStrips, 5);
     }
     vtkIdType inCellIdx = numPolys;
@@ -166,53 +566,34 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
         outCD->CopyData(inCD, inCellIdx, outCellIdx++);
       }
     }
-    this->OldMesh->SetPolys(polys);
-    polys->Delete();
     numPolys = polys->GetNumberOfCells(); // added some new triangles
   }
   else
   {
-    this->OldMesh->SetPolys(inPolys);
     polys = inPolys;
   }
-  this->OldMesh->BuildLinks();
+
+  // The links of the input polygons drive the traversals and the splitting.
+  PolyLinks links;
+  if (this->Consistency || this->Splitting || this->AutoOrientNormals)
+  {
+    BuildSortedLinks(links, numPts, polys);
+  }
   this->UpdateProgress(0.10);
 
   pd = input->GetPointData();
   outPD = output->GetPointData();
 
-  this->NewMesh = vtkPolyData::New();
-  this->NewMesh->SetPoints(inPts);
   // create a copy because we're modifying it
-  newPolys = vtkCellArray::New();
+  vtkNew<vtkCellArray> newPolys;
   newPolys->DeepCopy(polys);
-  this->NewMesh->SetPolys(newPolys);
-  this->NewMesh->BuildCells(); // builds connectivity
-
-  // The visited array keeps track of which polygons have been visited.
-  //
-  if (this->Consistency || this->Splitting || this->AutoOrientNormals)
-  {
-    this->Visited = new int[numPolys];
-    memset(this->Visited, VTK_CELL_NOT_VISITED, numPolys * sizeof(int));
-    this->CellIds = vtkIdList::New();
-    this->CellIds->Allocate(VTK_CELL_SIZE);
-    this->CellPoints = vtkIdList::New();
-    this->CellPoints->Allocate(VTK_CELL_SIZE);
-    this->NeighborPoints = vtkIdList::New();
-    this->NeighborPoints->Allocate(VTK_CELL_SIZE);
-  }
-  else
-  {
-    this->Visited = nullptr;
-  }
 
   //  Traverse all polygons insuring proper direction of ordering.  This
   //  works by propagating a wave from a seed polygon to the polygon's
   //  edge neighbors. Each neighbor may be reordered to maintain consistency
   //  with its (already checked) neighbors.
   //
-  this->NumFlips = 0;
+  vtkIdType numFlips = 0;
   if (this->AutoOrientNormals)
   {
     // No need to check this->Consistency. It's implied.
@@ -225,25 +606,24 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     // has a normal that's "most aligned" with the X-axis. This process
     // will need to be repeated to handle all connected components in
     // the mesh. Report bugs/issues to cvolpe@ara.com.
+    std::vector<char> visited(numPolys, CellNotVisited);
+    PolygonOrderTraversal traversal(
+      newPolys, &links, visited.data(), this->NonManifoldTraversal != 0);
     int foundLeftmostCell;
     vtkIdType leftmostCellID = -1, currentPointID, currentCellID;
-    vtkIdType* leftmostCells;
+    const vtkIdType* leftmostCells;
     vtkIdType nleftmostCells;
     const vtkIdType* cellPts;
     vtkIdType nCellPts;
-    int cIdx;
+    vtkNew<vtkIdList> cellPoints;
     double bestNormalAbsXComponent;
     int bestReverseFlag;
-    vtkPriorityQueue* leftmostPoints = vtkPriorityQueue::New();
-    this->Wave = vtkIdList::New();
-    this->Wave->Allocate(numPolys / 4 + 1, numPolys);
-    this->Wave2 = vtkIdList::New();
-    this->Wave2->Allocate(numPolys / 4 + 1, numPolys);
+    vtkNew<vtkPriorityQueue> leftmostPoints;
 
     // Put all the points in the priority queue, based on x coord
     // So that we can find leftmost point
     leftmostPoints->Allocate(numPts);
-    for (ptId = 0; ptId < numPts; ptId++)
+    for (vtkIdType ptId = 0; ptId < numPts; ptId++)
     {
       leftmostPoints->Insert(inPts->GetPoint(ptId)[0], ptId);
     }
@@ -262,17 +642,18 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
       do
       {
         currentPointID = leftmostPoints->Pop();
-        this->OldMesh->GetPointCells(currentPointID, nleftmostCells, leftmostCells);
+        nleftmostCells = links.GetNcells(currentPointID);
+        leftmostCells = links.GetCells(currentPointID);
         bestNormalAbsXComponent = 0.0;
         bestReverseFlag = 0;
-        for (cIdx = 0; cIdx < nleftmostCells; cIdx++)
+        for (vtkIdType cIdx = 0; cIdx < nleftmostCells; cIdx++)
         {
           currentCellID = leftmostCells[cIdx];
-          if (this->Visited[currentCellID] == VTK_CELL_VISITED)
+          if (visited[currentCellID] == CellVisited)
           {
             continue;
           }
-          this->OldMesh->GetCellPoints(currentCellID, nCellPts, cellPts);
+          polys->GetCellAtId(currentCellID, nCellPts, cellPts, cellPoints);
           vtkPolygon::ComputeNormal(inPts, nCellPts, cellPts, n);
           // Ok, see if this leftmost cell candidate is the best
           // so far
@@ -295,86 +676,79 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
         // normals, but if both are true, then we leave it as it is.
         if (bestReverseFlag ^ this->FlipNormals)
         {
-          this->NewMesh->ReverseCell(leftmostCellID);
-          this->NumFlips++;
+          newPolys->ReverseCellAtId(leftmostCellID);
+          numFlips++;
         }
-        this->Wave->InsertNextId(leftmostCellID);
-        this->Visited[leftmostCellID] = VTK_CELL_VISITED;
-        this->TraverseAndOrder();
-        this->Wave->Reset();
-        this->Wave2->Reset();
+        visited[leftmostCellID] = CellVisited;
+        numFlips += traversal.Traverse(leftmostCellID);
       } // if found leftmost cell
     }   // Still some points in the queue
-    this->Wave->Delete();
-    this->Wave2->Delete();
-    leftmostPoints->Delete();
-    vtkDebugMacro(<< "Reversed ordering of " << this->NumFlips << " polygons");
+    vtkDebugMacro(<< "Reversed ordering of " << numFlips << " polygons");
   } // automatically orient normals
   else
   {
     if (this->Consistency)
     {
-      this->Wave = vtkIdList::New();
-      this->Wave->Allocate(numPolys / 4 + 1, numPolys);
-      this->Wave2 = vtkIdList::New();
-      this->Wave2->Allocate(numPolys / 4 + 1, numPolys);
-      for (cellId = 0; cellId < numPolys; cellId++)
+      std::vector<char> visited(numPolys, CellNotVisited);
+      PolygonOrderTraversal traversal(
+        newPolys, &links, visited.data(), this->NonManifoldTraversal != 0);
+      for (vtkIdType cellId = 0; cellId < numPolys; cellId++)
       {
-        if (this->Visited[cellId] == VTK_CELL_NOT_VISITED)
+        if (visited[cellId] == CellNotVisited)
         {
           if (this->FlipNormals)
           {
-            this->NumFlips++;
-            this->NewMesh->ReverseCell(cellId);
+            numFlips++;
+            newPolys->ReverseCellAtId(cellId);
           }
-          this->Wave->InsertNextId(cellId);
-          this->Visited[cellId] = VTK_CELL_VISITED;
-          this->TraverseAndOrder();
+          visited[cellId] = CellVisited;
+          numFlips += traversal.Traverse(cellId);
         }
-
-        this->Wave->Reset();
-        this->Wave2->Reset();
       }
-
-      this->Wave->Delete();
-      this->Wave2->Delete();
-      vtkDebugMacro(<< "Reversed ordering of " << this->NumFlips << " polygons");
+      vtkDebugMacro(<< "Reversed ordering of " << numFlips << " polygons");
     } // Consistent ordering
   }   // don't automatically orient normals
+  this->NumFlips = static_cast<int>(numFlips);
 
   this->UpdateProgress(0.333);
 
   //  Initial pass to compute polygon normals without effects of neighbors
   //
-  this->PolyNormals = vtkFloatArray::New();
-  this->PolyNormals->SetNumberOfComponents(3);
-  this->PolyNormals->SetName("Normals");
-  this->PolyNormals->SetNumberOfTuples(numVerts + numLines + numPolys);
+  vtkNew<vtkFloatArray> polyNormals;
+  polyNormals->SetNumberOfComponents(3);
+  polyNormals->SetName("Normals");
+  polyNormals->SetNumberOfTuples(numVerts + numLines + numPolys);
 
   vtkIdType offsetCells = numVerts + numLines;
   n[0] = 1.0;
   n[1] = 0.0;
   n[2] = 0.0;
-  for (cellId = 0; cellId < offsetCells; cellId++)
+  for (vtkIdType cellId = 0; cellId < offsetCells; cellId++)
   {
     // add a default value for vertices and lines
     // normals do not have meaningful values, we set them to X
-    this->PolyNormals->SetTuple(cellId, n);
+    polyNormals->SetTuple(cellId, n);
   }
 
-  for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
-  {
-    if ((cellId % 1000) == 0)
-    {
-      this->UpdateProgress(0.333 + 0.333 * (double)cellId / (double)numPolys);
-      if (this->GetAbortExecute())
+  float* fPolyNormals = polyNormals->GetPointer(3 * offsetCells);
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPoints;
+  vtkSMPTools::For(0, numPolys,
+    [&tlCellPoints, &newPolys, inPts, fPolyNormals](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* cellPoints = tlCellPoints.Local();
+      vtkIdType numCellPts;
+      const vtkIdType* cellPts;
+      double normal[3];
+      for (; cellId < endCellId; ++cellId)
       {
-        break;
+        newPolys->GetCellAtId(cellId, numCellPts, cellPts, cellPoints);
+        vtkPolygon::ComputeNormal(inPts, numCellPts, cellPts, normal);
+        for (int i = 0; i < 3; ++i)
+        {
+          fPolyNormals[3 * cellId + i] = static_cast<float>(normal[i]);
+        }
       }
-    }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(offsetCells + cellId, n);
-  }
+    });
+  this->UpdateProgress(0.666);
 
   // Split mesh if sharp features
   if (this->Splitting)
@@ -383,32 +757,79 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     //  edges found, split mesh creating new nodes.  Update polygon
     // connectivity.
     //
-    this->CosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
-    //  Splitting will create new points.  We have to create index array
-    // to map new points into old points.
-    //
-    this->Map = vtkIdList::New();
-    this->Map->SetNumberOfIds(numPts);
-    for (vtkIdType i = 0; i < numPts; i++)
+    const double cosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
+    std::vector<int> regions(links.GetLinksSize());
+    std::vector<vtkIdType> firstNewPt(numPts + 1);
+    MarkRegions markRegions(
+      polys, &links, fPolyNormals, cosAngle, regions.data(), firstNewPt.data());
+    vtkSMPTools::For(0, numPts, markRegions);
+
+    // The points split from a point are numbered after the input points, in
+    // the order of the input points.
+    vtkIdType numSplitPts = 0;
+    for (vtkIdType ptId = 0; ptId < numPts; ptId++)
     {
-      this->Map->SetId(i, i);
+      const vtkIdType numPtSplits = firstNewPt[ptId];
+      firstNewPt[ptId] = numSplitPts;
+      numSplitPts += numPtSplits;
     }
-
-    for (ptId = 0; ptId < numPts; ptId++)
-    {
-      this->MarkAndSplit(ptId);
-    } // for all input points
-
-    numNewPts = this->Map->GetNumberOfIds();
+    firstNewPt[numPts] = numSplitPts;
+    numNewPts = numPts + numSplitPts;
 
     vtkDebugMacro(<< "Created " << numNewPts - numPts << " new points");
 
-    //  Now need to map attributes of old points into new points.
+    // For all cells not in the first region of a point, the point is
+    // replaced with a new point, which is a duplicate of the first point
+    // but disconnected topologically.
+    const vtkIdType* first = firstNewPt.data();
+    if (numSplitPts > 0)
+    {
+      vtkSMPTools::For(0, numPolys,
+        [&tlCellPoints, &newPolys, &markRegions, first, numPts](
+          vtkIdType cellId, vtkIdType endCellId) {
+          vtkIdList* cellPoints = tlCellPoints.Local();
+          for (; cellId < endCellId; ++cellId)
+          {
+            newPolys->GetCellAtId(cellId, cellPoints);
+            bool replaced = false;
+            for (vtkIdType i = 0; i < cellPoints->GetNumberOfIds(); ++i)
+            {
+              const vtkIdType ptId = cellPoints->GetId(i);
+              if (first[ptId + 1] > first[ptId])
+              {
+                const int region = markRegions.Region(ptId, cellId);
+                if (region > 0)
+                {
+                  cellPoints->SetId(i, numPts + first[ptId] + region - 1);
+                  replaced = true;
+                }
+              }
+            }
+            if (replaced)
+            {
+              newPolys->ReplaceCellAtId(cellId, cellPoints);
+            }
+          }
+        });
+    }
+
+    //  Splitting will create new points.  We have to create index array
+    // to map new points into old points.
     //
-    outPD->CopyNormalsOff();
-    outPD->CopyAllocate(pd, numNewPts);
+    std::vector<vtkIdType> map(numNewPts);
+    vtkIdType* mapPtr = map.data();
+    vtkSMPTools::For(0, numPts, [mapPtr, first, numPts](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        mapPtr[ptId] = ptId;
+        for (vtkIdType newId = numPts + first[ptId]; newId < numPts + first[ptId + 1]; ++newId)
+        {
+          mapPtr[newId] = ptId;
+        }
+      }
+    });
 
-    newPts = vtkPoints::New();
+    newPts = vtkSmartPointer<vtkPoints>::New();
 
     // set precision for the points in the output
     if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
@@ -433,13 +854,46 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     }
 
     newPts->SetNumberOfPoints(numNewPts);
-    for (ptId = 0; ptId < numNewPts; ptId++)
+    vtkPoints* newPtsPtr = newPts;
+    vtkSMPTools::For(
+      0, numNewPts, [inPts, newPtsPtr, mapPtr](vtkIdType ptId, vtkIdType endPtId) {
+        double x[3];
+        for (; ptId < endPtId; ++ptId)
+        {
+          inPts->GetPoint(mapPtr[ptId], x);
+          newPtsPtr->SetPoint(ptId, x);
+        }
+      });
+
+    //  Now need to map attributes of old points into new points.
+    //  Non-numeric arrays cannot be copied concurrently.
+    //
+    outPD->CopyNormalsOff();
+    outPD->CopyAllocate(pd, numNewPts);
+    bool numericData = true;
+    for (int i = 0; i < pd->GetNumberOfArrays(); ++i)
+    {
+      numericData = numericData && pd->GetArray(i) != nullptr;
+    }
+    if (numericData)
+    {
+      ArrayList arrays;
+      arrays.AddArrays(numNewPts, pd, outPD, 0.0, false);
+      ArrayList* arraysPtr = &arrays;
+      vtkSMPTools::For(0, numNewPts, [arraysPtr, mapPtr](vtkIdType ptId, vtkIdType endPtId) {
+        for (; ptId < endPtId; ++ptId)
+        {
+          arraysPtr->Copy(mapPtr[ptId], ptId);
+        }
+      });
+    }
+    else
     {
-      oldId = this->Map->GetId(ptId);
-      newPts->SetPoint(ptId, inPts->GetPoint(oldId));
-      outPD->CopyData(pd, oldId, ptId);
+      for (vtkIdType ptId = 0; ptId < numNewPts; ptId++)
+      {
+        outPD->CopyData(pd, mapPtr[ptId], ptId);
+      }
     }
-    this->Map->Delete();
   } // splitting
 
   else // no splitting, so no new points
@@ -449,61 +903,56 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     outPD->PassData(pd);
   }
 
-  if (this->Consistency || this->Splitting)
-  {
-    delete[] this->Visited;
-    this->CellIds->Delete();
-    this->CellIds = nullptr;
-    this->CellPoints->Delete();
-    this->CellPoints = nullptr;
-    this->NeighborPoints->Delete();
-    this->NeighborPoints = nullptr;
-  }
-
   this->UpdateProgress(0.80);
 
-  //  Finally, traverse all elements, computing polygon normals and
-  //  accumulating them at the vertices.
+  //  Finally, gather the polygon normals at the points. Each point sums the
+  //  normals of its polygons in increasing order, like a serial traversal of
+  //  the polygons would.
   //
   if (this->FlipNormals && !this->Consistency)
   {
     flipDirection = -1.0;
   }
 
-  newNormals = vtkFloatArray::New();
-  newNormals->SetNumberOfComponents(3);
-  newNormals->SetNumberOfTuples(numNewPts);
-  newNormals->SetName("Normals");
-  float* fNormals = newNormals->WritePointer(0, 3 * numNewPts);
-  std::fill_n(fNormals, 3 * numNewPts, 0);
-
-  float* fPolyNormals = this->PolyNormals->WritePointer(3 * offsetCells, 3 * numPolys);
-
   if (this->ComputePointNormals)
   {
-    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); ++cellId)
-    {
-      for (vtkIdType i = 0; i < npts; ++i)
-      {
-        fNormals[3 * pts[i]] += fPolyNormals[3 * cellId];
-        fNormals[3 * pts[i] + 1] += fPolyNormals[3 * cellId + 1];
-        fNormals[3 * pts[i] + 2] += fPolyNormals[3 * cellId + 2];
-      }
-    }
+    PolyLinks newLinks;
+    BuildSortedLinks(newLinks, numNewPts, newPolys);
+    PolyLinks* newLinksPtr = &newLinks;
+
+    vtkNew<vtkFloatArray> newNormals;
+    newNormals->SetNumberOfComponents(3);
+    newNormals->SetNumberOfTuples(numNewPts);
+    newNormals->SetName("Normals");
+    float* fNormals = newNormals->GetPointer(0);
+
+    vtkSMPTools::For(0, numNewPts,
+      [newLinksPtr, fPolyNormals, fNormals, flipDirection](vtkIdType i, vtkIdType endPtId) {
+        for (; i < endPtId; ++i)
+        {
+          const vtkIdType* cells = newLinksPtr->GetCells(i);
+          const vtkIdType ncells = newLinksPtr->GetNcells(i);
+          float* normal = fNormals + 3 * i;
+          normal[0] = normal[1] = normal[2] = 0.0f;
+          for (vtkIdType k = 0; k < ncells; ++k)
+          {
+            normal[0] += fPolyNormals[3 * cells[k]];
+            normal[1] += fPolyNormals[3 * cells[k] + 1];
+            normal[2] += fPolyNormals[3 * cells[k] + 2];
+          }
 
-    for (vtkIdType i = 0; i < numNewPts; ++i)
-    {
-      const double length =
-        sqrt(fNormals[3 * i] * fNormals[3 * i] + fNormals[3 * i + 1] * fNormals[3 * i + 1] +
-          fNormals[3 * i + 2] * fNormals[3 * i + 2]) *
-        flipDirection;
-      if (length != 0.0)
-      {
-        fNormals[3 * i] /= length;
-        fNormals[3 * i + 1] /= length;
-        fNormals[3 * i + 2] /= length;
-      }
-    }
+          const double length =
+            sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]) *
+            flipDirection;
+          if (length != 0.0)
+          {
+            normal[0] /= length;
+            normal[1] /= length;
+            normal[2] /= length;
+          }
+        }
+      });
+    outPD->SetNormals(newNormals);
   }
 
   //  Update ourselves.  If no new nodes have been created (i.e., no
@@ -519,260 +968,22 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   else
   {
     output->SetPoints(newPts);
-    newPts->Delete();
   }
 
   if (this->ComputeCellNormals)
   {
-    outCD->SetNormals(this->PolyNormals);
-  }
-  this->PolyNormals->Delete();
-
-  if (this->ComputePointNormals)
-  {
-    outPD->SetNormals(newNormals);
+    outCD->SetNormals(polyNormals);
   }
-  newNormals->Delete();
 
   output->SetPolys(newPolys);
-  newPolys->Delete();
 
   // copy the original vertices and lines to the output
   output->SetVerts(input->GetVerts());
   output->SetLines(input->GetLines());
 
-  this->OldMesh->Delete();
-  this->NewMesh->Delete();
-
   return 1;
 }
 
-//  Propagate wave of consistently ordered polygons.
-//
-void vtkPolyDataNormals::TraverseAndOrder()
-{
-  vtkIdType i, k;
-  int j, l, j1;
-  vtkIdType numIds, cellId;
-  const vtkIdType* pts;
-  const vtkIdType* neiPts;
-  vtkIdType npts;
-  vtkIdType numNeiPts;
-  vtkIdType neighbor;
-  vtkIdList* tmpWave;
-
-  // propagate wave until nothing left in wave
-  while ((numIds = this->Wave->GetNumberOfIds()) > 0)
-  {
-    for (i = 0; i < numIds; i++)
-    {
-      cellId = this->Wave->GetId(i);
-
-      // Store the results here in a vtkIdList, since passing npts/pts directly
-      // would result in the data getting invalidated by the later call to
-      // NewMesh->GetCellPoints.
-      this->NewMesh->GetCellPoints(cellId, this->CellPoints);
-      npts = this->CellPoints->GetNumberOfIds();
-      pts = this->CellPoints->GetPointer(0);
-
-      for (j = 0, j1 = 1; j < npts; ++j, (j1 = (++j1 < npts) ? j1 : 0)) // for each edge neighbor
-      {
-        this->OldMesh->GetCellEdgeNeighbors(cellId, pts[j], pts[j1], this->CellIds);
-
-        //  Check the direction of the neighbor ordering.  Should be
-        //  consistent with us (i.e., if we are n1->n2,
-        // neighbor should be n2->n1).
-        if (this->CellIds->GetNumberOfIds() == 1 || this->NonManifoldTraversal)
-        {
-          for (k = 0; k < this->CellIds->GetNumberOfIds(); k++)
-          {
-            if (this->Visited[this->CellIds->GetId(k)] == VTK_CELL_NOT_VISITED)
-            {
-              neighbor = this->CellIds->GetId(k);
-              this->NewMesh->GetCellPoints(neighbor, this->NeighborPoints);
-              numNeiPts = this->NeighborPoints->GetNumberOfIds();
-              neiPts = this->NeighborPoints->GetPointer(0);
-
-              for (l = 0; l < numNeiPts; l++)
-              {
-                if (neiPts[l] == pts[j1])
-                {
-                  break;
-                }
-              }
-
-              //  Have to reverse ordering if neighbor not consistent
-              //
-              if (neiPts[(l + 1) % numNeiPts] != pts[j])
-              {
-                this->NumFlips++;
-                this->NewMesh->ReverseCell(neighbor);
-              }
-              this->Visited[neighbor] = VTK_CELL_VISITED;
-              this->Wave2->InsertNextId(neighbor);
-            } // if cell not visited
-          }   // for each edge neighbor
-        }     // for manifold or non-manifold traversal allowed
-      }       // for all edges of this polygon
-    }         // for all cells in wave
-
-    // swap wave and proceed with propagation
-    tmpWave = this->Wave;
-    this->Wave = this->Wave2;
-    this->Wave2 = tmpWave;
-    this->Wave2->Reset();
-  } // while wave still propagating
-}
-
-//
-//  Mark polygons around vertex.  Create new vertex (if necessary) and
-//  replace (i.e., split mesh).
-//
-void vtkPolyDataNormals::MarkAndSplit(vtkIdType ptId)
-{
-  int i, j;
-
-  // Get the cells using this point and make sure that we have to do something
-  vtkIdType ncells;
-  vtkIdType* cells;
-  this->OldMesh->GetPointCells(ptId, ncells, cells);
-  if (ncells <= 1)
-  {
-    return; // point does not need to be further disconnected
-  }
-
-  // Start moving around the "cycle" of points using the point. Label
-  // each point as requiring a visit. Then label each subregion of cells
-  // connected to this point that are connected (and not separated by
-  // a feature edge) with a given region number. For each N regions
-  // created, N-1 duplicate (split) points are created. The split point
-  // replaces the current point ptId in the polygons connectivity array.
-  //
-  // Start by initializing the cells as unvisited
-  for (i = 0; i < ncells; i++)
-  {
-    this->Visited[cells[i]] = -1;
-  }
-
-  // Loop over all cells and mark the region that each is in.
-  //
-  vtkIdType numPts;
-  const vtkIdType* pts;
-  int numRegions = 0;
-  vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
-  double thisNormal[3], neiNormal[3];
-  for (j = 0; j < ncells; j++) // for all cells connected to point
-  {
-    if (this->Visited[cells[j]] < 0) // for all unvisited cells
-    {
-      this->Visited[cells[j]] = numRegions;
-      // okay, mark all the cells connected to this seed cell and using ptId
-      this->OldMesh->GetCellPoints(cells[j], numPts, pts);
-
-      // find the two edges
-      for (spot = 0; spot < numPts; spot++)
-      {
-        if (pts[spot] == ptId)
-        {
-          break;
-        }
-      }
-
-      if (spot == 0)
-      {
-        neiPt[0] = pts[spot + 1];
-        neiPt[1] = pts[numPts - 1];
-      }
-      else if (spot == (numPts - 1))
-      {
-        neiPt[0] = pts[spot - 1];
-        neiPt[1] = pts[0];
-      }
-      else
-      {
-        neiPt[0] = pts[spot + 1];
-        neiPt[1] = pts[spot - 1];
-      }
-
-      for (i = 0; i < 2; i++) // for each of the two edges of the seed cell
-      {
-        cellId = cells[j];
-        nei = neiPt[i];
-        while (cellId >= 0) // while we can grow this region
-        {
-          this->OldMesh->GetCellEdgeNeighbors(cellId, ptId, nei, this->CellIds);
-          if (this->CellIds->GetNumberOfIds() == 1 &&
-            this->Visited[(neiCellId = this->CellIds->GetId(0))] < 0)
-          {
-            this->PolyNormals->GetTuple(cellId, thisNormal);
-            this->PolyNormals->GetTuple(neiCellId, neiNormal);
-
-            if (vtkMath::Dot(thisNormal, neiNormal) > CosAngle)
-            {
-              // visit and arrange to visit next edge neighbor
-              this->Visited[neiCellId] = numRegions;
-              cellId = neiCellId;
-              this->OldMesh->GetCellPoints(cellId, numPts, pts);
-
-              for (spot = 0; spot < numPts; spot++)
-              {
-                if (pts[spot] == ptId)
-                {
-                  break;
-                }
-              }
-
-              if (spot == 0)
-              {
-                nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[numPts - 1]);
-              }
-              else if (spot == (numPts - 1))
-              {
-                nei = (pts[spot - 1] != nei ? pts[spot - 1] : pts[0]);
-              }
-              else
-              {
-                nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[spot - 1]);
-              }
-
-            } // if not separated by edge angle
-            else
-            {
-              cellId = -1; // separated by edge angle
-            }
-          } // if can move to edge neighbor
-          else
-          {
-            cellId = -1; // separated by previous visit, boundary, or non-manifold
-          }
-        } // while visit wave is propagating
-      }   // for each of the two edges of the starting cell
-      numRegions++;
-    } // if cell is unvisited
-  }   // for all cells connected to point ptId
-
-  if (numRegions <= 1)
-  {
-    return; // a single region, no splitting ever required
-  }
-
-  // Okay, for all cells not in the first region, the ptId is
-  // replaced with a new ptId, which is a duplicate of the first
-  // point, but disconnected topologically.
-  //
-  vtkIdType lastId = this->Map->GetNumberOfIds();
-  vtkIdType replacementPoint;
-  for (j = 0; j < ncells; j++)
-  {
-    if (this->Visited[cells[j]] > 0) // replace point if splitting needed
-    {
-      replacementPoint = lastId + this->Visited[cells[j]] - 1;
-      this->Map->InsertId(replacementPoint, ptId);
-      this->NewMesh->ReplaceCellPoint(cells[j], ptId, replacementPoint);
-    } // if not in first regions and requiring splitting
-  }   // for all cells connected to ptId
-}
-
 void vtkPolyDataNormals::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
@@ -55,6 +55,10 @@
 #include "vtkPriorityQueue.h"
 #include "vtkTriangle.h"
 
+#include "vtkQuadricDecimationInternal.h"
+
+#include <vector>
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
 //------------------------------------------------------------------------------
@@ -428,25 +432,24 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
   vtkCellArray* polys;
   vtkIdType npts;
   const vtkIdType* pts = nullptr;
-  double point0[3], point1[3], point2[3];
   double n[3];
   double tempP1[3], tempP2[3], d, triArea2;
-  double data[16];
-  double *A[4], x[4];
-  int index[4];
-  A[0] = data;
-  A[1] = data + 4;
-  A[2] = data + 8;
-  A[3] = data + 12;
+  const int quadricSize = GetQuadricSize(this->NumberOfComponents);
 
   // allocate local QEM sparse matrix
-  QEM = new double[11 + 4 * this->NumberOfComponents];
+  QEM = new double[quadricSize];
+
+  // the triangle points followed by their attributes
+  std::vector<double> points(3 * (3 + this->NumberOfComponents));
+  double* point0 = points.data();
+  double* point1 = point0 + 3 + this->NumberOfComponents;
+  double* point2 = point1 + 3 + this->NumberOfComponents;
 
   // clear and allocate global QEM array
   for (ptId = 0; ptId < numPts; ptId++)
   {
-    this->ErrorQuadrics[ptId].Quadric = new double[11 + 4 * this->NumberOfComponents];
-    for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
+    this->ErrorQuadrics[ptId].Quadric = new double[quadricSize];
+    for (i = 0; i < quadricSize; i++)
     {
       this->ErrorQuadrics[ptId].Quadric[i] = 0.0;
     }
@@ -456,9 +459,9 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
   // compute the QEM for each face
   for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
   {
-    input->GetPoint(pts[0], point0);
-    input->GetPoint(pts[1], point1);
-    input->GetPoint(pts[2], point2);
+    this->GetPointAttributeArray(pts[0], point0);
+    this->GetPointAttributeArray(pts[1], point1);
+    this->GetPointAttributeArray(pts[2], point2);
     for (i = 0; i < 3; i++)
     {
       tempP1[i] = point1[i] - point0[i];
@@ -473,129 +476,18 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
     // could possible add in angle weights??
 
     // set the geometric part of the QEM
-    QEM[0] = n[0] * n[0];
-    QEM[1] = n[0] * n[1];
-    QEM[2] = n[0] * n[2];
-    QEM[3] = d * n[0];
-
-    QEM[4] = n[1] * n[1];
-    QEM[5] = n[1] * n[2];
-    QEM[6] = d * n[1];
+    SetPlaneQuadric(n, d, QEM);
 
-    QEM[7] = n[2] * n[2];
-    QEM[8] = d * n[2];
-
-    QEM[9] = d * d;
-    QEM[10] = 1;
-
-    if (this->AttributeErrorMetric)
+    if (this->AttributeErrorMetric &&
+      !AddAttributeQuadrics(point0, point1, point2, n, this->NumberOfComponents, QEM))
     {
-      for (i = 0; i < 3; i++)
-      {
-        A[0][i] = point0[i];
-        A[1][i] = point1[i];
-        A[2][i] = point2[i];
-        A[3][i] = n[i];
-      }
-      A[0][3] = A[1][3] = A[2][3] = 1;
-      A[3][3] = 0;
-
-      // should handle poorly condition matrix better
-      if (vtkMath::LUFactorLinearSystem(A, index, 4))
-      {
-        for (i = 0; i < this->NumberOfComponents; i++)
-        {
-          x[3] = 0;
-          if (i < this->AttributeComponents[0])
-          {
-            x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *
-              this->AttributeScale[0];
-            x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *
-              this->AttributeScale[0];
-            x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *
-              this->AttributeScale[0];
-          }
-          else if (i < this->AttributeComponents[1])
-          {
-            x[0] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[1] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[2] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-          }
-          else if (i < this->AttributeComponents[2])
-          {
-            x[0] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[0], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[1] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[1], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[2] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[2], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-          }
-          else if (i < this->AttributeComponents[3])
-          {
-            x[0] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[0], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[1] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[1], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[2] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[2], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-          }
-          else if (i < this->AttributeComponents[4])
-          {
-            x[0] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[1] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[2] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-          }
-          vtkMath::LUSolveLinearSystem(A, index, x, 4);
-
-          // add in the contribution of this element into the QEM
-          QEM[0] += x[0] * x[0];
-          QEM[1] += x[0] * x[1];
-          QEM[2] += x[0] * x[2];
-          QEM[3] += x[3] * x[0];
-
-          QEM[4] += x[1] * x[1];
-          QEM[5] += x[1] * x[2];
-          QEM[6] += x[3] * x[1];
-
-          QEM[7] += x[2] * x[2];
-          QEM[8] += x[3] * x[2];
-
-          QEM[9] += x[3] * x[3];
-
-          QEM[11 + i * 4] = -x[0];
-          QEM[12 + i * 4] = -x[1];
-          QEM[13 + i * 4] = -x[2];
-          QEM[14 + i * 4] = -x[3];
-        }
-      }
-      else
-      {
-        vtkErrorMacro(<< "Unable to factor attribute matrix!");
-      }
+      vtkErrorMacro(<< "Unable to factor attribute matrix!");
     }
 
     // add the QEM to all points of the face
     for (i = 0; i < 3; i++)
     {
-      for (j = 0; j < 11 + 4 * this->NumberOfComponents; j++)
+      for (j = 0; j < quadricSize; j++)
       {
         this->ErrorQuadrics[pts[i]].Quadric[j] += QEM[j] * triArea2;
       }
@@ -628,11 +520,11 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
   vtkIdType npts;
   const vtkIdType* pts;
   double t0[3], t1[3], t2[3];
-  double e0[3], e1[3], n[3], c, d, w;
+  double n[3], d, w;
   vtkIdList* cellIds = vtkIdList::New();
 
   // allocate local QEM space matrix
-  QEM = new double[11 + 4 * this->NumberOfComponents];
+  QEM = new double[GetQuadricSize(this->NumberOfComponents)];
 
   for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
   {
@@ -650,44 +542,12 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
 
         // computing a plane which is orthogonal to line t1, t2 and incident
         // with it
-        for (j = 0; j < 3; j++)
-        {
-          e0[j] = t2[j] - t1[j];
-        }
-        for (j = 0; j < 3; j++)
-        {
-          e1[j] = t0[j] - t1[j];
-        }
-
-        // compute n so that it is orthogonal to e0 and parallel to the
-        // triangle
-        c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
-        for (j = 0; j < 3; j++)
-        {
-          n[j] = e1[j] - c * e0[j];
-        }
-        vtkMath::Normalize(n);
-        d = -vtkMath::Dot(n, t1);
-        w = vtkMath::Norm(e0);
+        w = ComputeBoundaryPlane(t0, t1, t2, n, d);
 
         // w *= w;
         // area issue ??
         // could possible add in angle weights??
-        QEM[0] = n[0] * n[0];
-        QEM[1] = n[0] * n[1];
-        QEM[2] = n[0] * n[2];
-        QEM[3] = d * n[0];
-
-        QEM[4] = n[1] * n[1];
-        QEM[5] = n[1] * n[2];
-        QEM[6] = d * n[1];
-
-        QEM[7] = n[2] * n[2];
-        QEM[8] = d * n[2];
-
-        QEM[9] = d * d;
-
-        QEM[10] = 1;
+        SetPlaneQuadric(n, d, QEM);
 
         // need to add orthogonal plane with the other Attributes, but this
         // is not clear??
@@ -849,345 +709,58 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 {
-  static const double errorNumber = 1e-10;
-  double temp[3], A[3][3], b[3];
   vtkIdType pointIds[2];
-  double cost = 0.0;
-  double* index;
-  int i, j;
-  double newPoint[4];
-  double v[3], c, norm, normTemp, temp2[3];
   double pt1[3], pt2[3];
+  int i;
 
   pointIds[0] = this->EndPoint1List->GetId(edgeId);
   pointIds[1] = this->EndPoint2List->GetId(edgeId);
 
-  for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
+  for (i = 0; i < GetQuadricSize(this->NumberOfComponents); i++)
   {
     this->TempQuad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
-
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
-
-  norm = vtkMath::Norm(A[0]);
-  normTemp = vtkMath::Norm(A[1]);
-  norm = norm > normTemp ? norm : normTemp;
-  normTemp = vtkMath::Norm(A[2]);
-  norm = norm > normTemp ? norm : normTemp;
-
-  if (fabs(vtkMath::Determinant3x3(A)) / (norm * norm * norm) > errorNumber)
-  {
-    // it would be better to use the normal of the matrix to test singularity??
-    vtkMath::LinearSolve3x3(A, b, x);
-    vtkMath::Multiply3x3(A, x, temp);
-    // error too high, backup plans
-  }
-  else
-  {
-    // cheapest point along the edge
-    this->Mesh->GetPoints()->GetPoint(pointIds[0], pt1);
-    this->Mesh->GetPoints()->GetPoint(pointIds[1], pt2);
-    v[0] = pt2[0] - pt1[0];
-    v[1] = pt2[1] - pt1[1];
-    v[2] = pt2[2] - pt1[2];
-
-    // equation for the edge pt1 + c * v
-    // attempt least squares fit for c for A*(pt1 + c * v) = b
-    vtkMath::Multiply3x3(A, v, temp2);
-    if (vtkMath::Dot(temp2, temp2) > errorNumber)
-    {
-      vtkMath::Multiply3x3(A, pt1, temp);
-      for (i = 0; i < 3; i++)
-        temp[i] = b[i] - temp[i];
-      c = vtkMath::Dot(temp2, temp) / vtkMath::Dot(temp2, temp2);
-      for (i = 0; i < 3; i++)
-        x[i] = pt1[i] + c * v[i];
-    }
-    else
-    {
-      // use mid point
-      // might want to change to best of mid and end points??
-      for (i = 0; i < 3; i++)
-      {
-        x[i] = 0.5 * (pt1[i] + pt2[i]);
-      }
-    }
-  }
-
-  newPoint[0] = x[0];
-  newPoint[1] = x[1];
-  newPoint[2] = x[2];
-  newPoint[3] = 1;
-
-  // Compute the cost
-  // x'*quad*x
-  index = this->TempQuad;
-  for (i = 0; i < 4; i++)
-  {
-    cost += (*index++) * newPoint[i] * newPoint[i];
-    for (j = i + 1; j < 4; j++)
-    {
-      cost += 2.0 * (*index++) * newPoint[i] * newPoint[j];
-    }
-  }
-
-  return cost;
+  this->Mesh->GetPoints()->GetPoint(pointIds[0], pt1);
+  this->Mesh->GetPoints()->GetPoint(pointIds[1], pt2);
+  return ComputeGeometricCost(this->TempQuad, pt1, pt2, x);
 }
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
 {
-  // this function is so ugly because the functionality of converting an QEM
-  // into a dense matrix was not extracted into a separate function and
-  // neither was multiplication and some other matrix and vector primitives
-  static const double errorNumber = 1e-10;
   vtkIdType pointIds[2];
-  double cost = 0.0;
-  int i, j;
-  int solveOk;
+  double volume[4];
+  int i;
 
   pointIds[0] = this->EndPoint1List->GetId(edgeId);
   pointIds[1] = this->EndPoint2List->GetId(edgeId);
 
-  for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
+  for (i = 0; i < GetQuadricSize(this->NumberOfComponents); i++)
   {
     this->TempQuad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  // copy the temp quad into TempA
-  // converting from the sparse matrix format into a dense
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
-
-  this->TempB[0] = -this->TempQuad[3];
-  this->TempB[1] = -this->TempQuad[6];
-  this->TempB[2] = -this->TempQuad[8];
-
-  for (i = 3; i < 3 + this->NumberOfComponents; i++)
-  {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
-    this->TempB[i] = -this->TempQuad[11 + 4 * (i - 3) + 3];
-  }
-
-  // Set zero to all components of the submatrix a[3:n;3:n] and al to its diagonal
-  for (i = 3; i < 3 + this->NumberOfComponents; i++)
-  {
-    for (j = 3; j < 3 + this->NumberOfComponents; j++)
-    {
-      if (i == j)
-      {
-        this->TempA[i][j] = this->TempQuad[10];
-      }
-      else
-      {
-        this->TempA[i][j] = 0;
-      }
-    }
-  }
-  if (this->VolumePreservation)
-  {
-    // Add row/col for volume constraint
-    for (i = 0; i < 3 + this->NumberOfComponents + 1; i++)
-    {
-      if (i >= 3)
-      {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
-      }
-      else
-      {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
-          this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
-          this->VolumeConstraints[pointIds[1] * 4 + i];
-      }
-    }
-    // Add constraint to b
-    this->TempB[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
-    this->TempB[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
-  }
-
-  for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
-  {
-    x[i] = this->TempB[i];
-  }
-
-  // solve A*x = b
-  // this clobers A
-  // need to develop a quality of the solution test??
-  solveOk = vtkMath::SolveLinearSystem(
-    this->TempA, x, 3 + this->NumberOfComponents + this->VolumePreservation);
-
-  // need to copy back into A
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
-
-  for (i = 3; i < 3 + this->NumberOfComponents; i++)
-  {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
-  }
-
-  for (i = 3; i < 3 + this->NumberOfComponents; i++)
-  {
-    for (j = 3; j < 3 + this->NumberOfComponents; j++)
-    {
-      if (i == j)
-      {
-        this->TempA[i][j] = this->TempQuad[10];
-      }
-      else
-      {
-        this->TempA[i][j] = 0;
-      }
-    }
-  }
   if (this->VolumePreservation)
   {
-    // Add row/col for volume constraint
-    for (i = 0; i < 3 + this->NumberOfComponents + 1; i++)
+    for (i = 0; i < 4; i++)
     {
-      if (i >= 3)
-      {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
-      }
-      else
-      {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
-          this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
-          this->VolumeConstraints[pointIds[1] * 4 + i];
-      }
+      volume[i] =
+        this->VolumeConstraints[pointIds[0] * 4 + i] + this->VolumeConstraints[pointIds[1] * 4 + i];
     }
   }
 
-  // check for failure to solve the system
-  if (!solveOk)
-  {
-    // cheapest point along the edge
-    // this should not frequently occur, so I am using dynamic allocation
-    double* pt1 = new double[3 + this->NumberOfComponents];
-    double* pt2 = new double[3 + this->NumberOfComponents];
-    double* v = new double[3 + this->NumberOfComponents];
-    double* temp = new double[3 + this->NumberOfComponents];
-    double* temp2 = new double[3 + this->NumberOfComponents];
-    double d = 0;
-    double c = 0;
-
-    this->GetPointAttributeArray(pointIds[0], pt1);
-    this->GetPointAttributeArray(pointIds[1], pt2);
-    for (i = 0; i < 3 + this->NumberOfComponents; ++i)
-    {
-      v[i] = pt2[i] - pt1[i];
-    }
-
-    // equation for the edge pt1 + c * v
-    // attempt least squares fit for c for A*(pt1 + c * v) = b
-    // temp2 = A*v
-    for (i = 0; i < 3 + this->NumberOfComponents; ++i)
-    {
-      temp2[i] = 0;
-      for (j = 0; j < 3 + this->NumberOfComponents; ++j)
-      {
-        temp2[i] += this->TempA[i][j] * v[j];
-      }
-    }
-
-    // c = v dot v
-    for (i = 0; i < 3 + this->NumberOfComponents; ++i)
-    {
-      d += temp2[i] * temp2[i];
-    }
-
-    if (d > errorNumber)
-    {
-      // temp = A*pt1
-      for (i = 0; i < 3 + this->NumberOfComponents; ++i)
-      {
-        temp[i] = 0;
-        for (j = 0; j < 3 + this->NumberOfComponents; ++j)
-        {
-          temp[i] += this->TempA[i][j] * pt1[j];
-        }
-      }
-
-      for (i = 0; i < 3 + this->NumberOfComponents; i++)
-      {
-        temp[i] = this->TempB[i] - temp[i];
-      }
-
-      for (i = 0; i < 3 + this->NumberOfComponents; i++)
-      {
-        c += temp2[i] * temp[i];
-      }
-      c = c / d;
+  // the end points with their attributes, used when the system is singular
+  std::vector<double> endPoints(2 * (3 + this->NumberOfComponents));
+  double* pt1 = endPoints.data();
+  double* pt2 = pt1 + 3 + this->NumberOfComponents;
+  this->GetPointAttributeArray(pointIds[0], pt1);
+  this->GetPointAttributeArray(pointIds[1], pt2);
 
-      for (i = 0; i < 3 + this->NumberOfComponents; i++)
-      {
-        x[i] = pt1[i] + c * v[i];
-      }
-    }
-    else
-    {
-      // use mid point
-      // might want to change to best of mid and end points??
-      for (i = 0; i < 3 + this->NumberOfComponents; i++)
-      {
-        x[i] = 0.5 * (pt1[i] + pt2[i]);
-      }
-    }
-    delete[] pt1;
-    delete[] pt2;
-    delete[] v;
-    delete[] temp;
-    delete[] temp2;
-  }
-
-  // Compute the cost
-  // x'*A*x - 2*b*x + d
-  for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
-  {
-    cost += this->TempA[i][i] * x[i] * x[i];
-    for (j = i + 1; j < 3 + this->NumberOfComponents + this->VolumePreservation; j++)
-    {
-      cost += 2.0 * this->TempA[i][j] * x[i] * x[j];
-    }
-  }
-  for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
-  {
-    cost -= 2.0 * this->TempB[i] * x[i];
-  }
-
-  cost += this->TempQuad[9];
-
-  return cost;
+  return ComputeAttributeCost(this->TempQuad, this->VolumePreservation ? volume : nullptr,
+    this->NumberOfComponents, pt1, pt2, this->TempA, this->TempB, x);
 }
 
 int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
@@ -1246,41 +819,7 @@ int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
 int vtkQuadricDecimation::TrianglePlaneCheck(
   const double t0[3], const double t1[3], const double t2[3], const double* x)
 {
-  double e0[3], e1[3], n[3], e2[3];
-  double c;
-  int i;
-
-  for (i = 0; i < 3; i++)
-  {
-    e0[i] = t2[i] - t1[i];
-  }
-  for (i = 0; i < 3; i++)
-  {
-    e1[i] = t0[i] - t1[i];
-  }
-
-  // projection of e0 onto e1
-  c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
-  for (i = 0; i < 3; i++)
-  {
-    n[i] = e1[i] - c * e0[i];
-  }
-
-  for (i = 0; i < 3; i++)
-  {
-    e2[i] = x[i] - t1[i];
-  }
-
-  vtkMath::Normalize(n);
-  vtkMath::Normalize(e2);
-  if (vtkMath::Dot(n, e2) > 1e-5)
-  {
-    return 1;
-  }
-  else
-  {
-    return 0;
-  }
+  return ::TrianglePlaneCheck(t0, t1, t2, x) ? 1 : 0;
 }
 
 int vtkQuadricDecimation::IsGoodPlacement(vtkIdType pt0Id, vtkIdType pt1Id, const double* x)
@@ -1343,104 +882,27 @@ int vtkQuadricDecimation::IsGoodPlacement(vtkIdType pt0Id, vtkIdType pt1Id, cons
 void vtkQuadricDecimation::ComputeNumberOfComponents()
 {
   vtkPointData* pd = this->Mesh->GetPointData();
-  int i, j;
-  double range[2], maxRange = 0.0;
-
-  this->NumberOfComponents = 0;
+  const vtkTypeBool use[] = { this->ScalarsAttribute, this->VectorsAttribute,
+    this->NormalsAttribute, this->TCoordsAttribute, this->TensorsAttribute };
+  const double weights[] = { this->ScalarsWeight, this->VectorsWeight, this->NormalsWeight,
+    this->TCoordsWeight, this->TensorsWeight };
+  QuadricAttributes attributes;
+  attributes.Select(pd, use, weights);
+
+  // only the attributes of the error metric are passed to the output
   pd->CopyAllOff();
-
-  for (i = 0; i < 6; i++)
-  {
-    this->AttributeComponents[i] = 0;
-    this->AttributeScale[i] = 1.0;
-  }
-
-  // Scalar attributes
-  if (pd->GetScalars() != nullptr && this->ScalarsAttribute)
+  for (int i = 0; i < QuadricAttributes::NumberOfAttributes; i++)
   {
-    for (j = 0; j < pd->GetScalars()->GetNumberOfComponents(); j++)
-    {
-      pd->GetRange(pd->GetScalars()->GetName(), range, j);
-      maxRange = (maxRange < (range[1] - range[0]) ? (range[1] - range[0]) : maxRange);
-    }
-    if (maxRange != 0.0)
-    {
-      this->NumberOfComponents += pd->GetScalars()->GetNumberOfComponents();
-      pd->CopyScalarsOn();
-      this->AttributeScale[0] = this->ScalarsWeight / maxRange;
-      maxRange = 0.0;
-    }
-    vtkDebugMacro("scalars " << this->NumberOfComponents << " " << this->AttributeScale[0]);
-  }
-  this->AttributeComponents[0] = this->NumberOfComponents;
-
-  // Vector attributes
-  if (pd->GetVectors() != nullptr && this->VectorsAttribute)
-  {
-    for (j = 0; j < pd->GetVectors()->GetNumberOfComponents(); j++)
-    {
-      pd->GetRange(pd->GetVectors()->GetName(), range, j);
-      maxRange = (maxRange < (range[1] - range[0]) ? (range[1] - range[0]) : maxRange);
-    }
-    if (maxRange != 0.0)
-    {
-      this->NumberOfComponents += pd->GetVectors()->GetNumberOfComponents();
-      pd->CopyVectorsOn();
-      this->AttributeScale[1] = this->VectorsWeight / maxRange;
-      maxRange = 0.0;
-    }
-    vtkDebugMacro("vectors " << this->NumberOfComponents << " " << this->AttributeScale[1]);
-  }
-  this->AttributeComponents[1] = this->NumberOfComponents;
-
-  // Normals attributes -- normals are assumed normalized
-  if (pd->GetNormals() != nullptr && this->NormalsAttribute)
-  {
-    this->NumberOfComponents += 3;
-    pd->CopyNormalsOn();
-    this->AttributeScale[2] = 0.5 * this->NormalsWeight;
-    vtkDebugMacro("normals " << this->NumberOfComponents << " " << this->AttributeScale[2]);
-  }
-  this->AttributeComponents[2] = this->NumberOfComponents;
-
-  // Texture coords attributes
-  if (pd->GetTCoords() != nullptr && this->TCoordsAttribute)
-  {
-    for (j = 0; j < pd->GetTCoords()->GetNumberOfComponents(); j++)
-    {
-      pd->GetRange(pd->GetTCoords()->GetName(), range, j);
-      maxRange = (maxRange < (range[1] - range[0]) ? (range[1] - range[0]) : maxRange);
-    }
-    if (maxRange != 0.0)
-    {
-      this->NumberOfComponents += pd->GetTCoords()->GetNumberOfComponents();
-      pd->CopyTCoordsOn();
-      this->AttributeScale[3] = this->TCoordsWeight / maxRange;
-      maxRange = 0.0;
-    }
-    vtkDebugMacro("tcoords " << this->NumberOfComponents << " " << this->AttributeScale[3]);
-  }
-  this->AttributeComponents[3] = this->NumberOfComponents;
-
-  // Tensors attributes
-  if (pd->GetTensors() != nullptr && this->TensorsAttribute)
-  {
-    vtkDataArray* inTensors = pd->GetTensors();
-    int nComp = inTensors->GetNumberOfComponents();
-    for (j = 0; j < nComp; j++)
-    {
-      pd->GetRange(inTensors->GetName(), range, j);
-      maxRange = (maxRange < (range[1] - range[0]) ? (range[1] - range[0]) : maxRange);
-    }
-    if (maxRange != 0.0)
+    if (attributes.Arrays[i])
     {
-      this->NumberOfComponents += nComp;
-      pd->CopyTensorsOn();
-      this->AttributeScale[4] = this->TensorsWeight / maxRange;
+      pd->SetCopyAttribute(i, 1);
     }
-    vtkDebugMacro("tensors " << this->NumberOfComponents << " " << this->AttributeScale[4]);
+    this->AttributeComponents[i] = attributes.Components[i];
+    this->AttributeScale[i] = attributes.Scale[i];
   }
-  this->AttributeComponents[4] = this->NumberOfComponents;
+  this->AttributeComponents[5] = 0;
+  this->AttributeScale[5] = 1.0;
+  this->NumberOfComponents = attributes.NumberOfComponents;
 
   vtkDebugMacro("Number of components: " << this->NumberOfComponents);
 }
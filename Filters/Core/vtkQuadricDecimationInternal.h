@@ -0,0 +1,528 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkQuadricDecimationInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkQuadricDecimationInternal
+ * @brief   quadric error measure shared by the quadric decimation filters
+ *
+ * These functions build the quadrics of the triangles, of the boundary
+ * edges and of the point attributes, find the optimal collapse point of an
+ * edge and its cost, and check that a collapse point does not flip the
+ * triangles around it. The quadric of a point is stored as the upper
+ * triangle of the symmetric 4x4 geometric matrix row by row, followed by the
+ * accumulated area and by 4 values per attribute component (Hoppe's
+ * extension of the Garland and Heckbert quadrics). The attributes are
+ * scaled by their weights, and follow the point coordinates in the arrays
+ * describing the points of an edge.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication
+ * between vtkQuadricDecimation and vtkThreadedQuadricDecimation. At this
+ * time it is not meant to define a public API.
+ *
+ * @sa
+ * vtkQuadricDecimation vtkThreadedQuadricDecimation
+ */
+
+#ifndef vtkQuadricDecimationInternal_h
+#define vtkQuadricDecimationInternal_h
+
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Number of values in the quadric of a point with numComps attribute
+// components.
+inline int GetQuadricSize(int numComps)
+{
+  return 11 + 4 * numComps;
+}
+
+// Set the geometric part of the quadric of the plane n.x + d = 0.
+inline void SetPlaneQuadric(const double n[3], double d, double* QEM)
+{
+  QEM[0] = n[0] * n[0];
+  QEM[1] = n[0] * n[1];
+  QEM[2] = n[0] * n[2];
+  QEM[3] = d * n[0];
+
+  QEM[4] = n[1] * n[1];
+  QEM[5] = n[1] * n[2];
+  QEM[6] = d * n[1];
+
+  QEM[7] = n[2] * n[2];
+  QEM[8] = d * n[2];
+
+  QEM[9] = d * d;
+
+  QEM[10] = 1;
+}
+
+// Compute the plane n.x + d = 0 orthogonal to the triangle (t0, t1, t2) and
+// incident with its edge (t1, t2), which constrains a boundary edge. Returns
+// the length of the edge, used to weight the constraint.
+inline double ComputeBoundaryPlane(
+  const double t0[3], const double t1[3], const double t2[3], double n[3], double& d)
+{
+  double e0[3], e1[3];
+  for (int j = 0; j < 3; j++)
+  {
+    e0[j] = t2[j] - t1[j];
+    e1[j] = t0[j] - t1[j];
+  }
+
+  // compute n so that it is orthogonal to e0 and parallel to the
+  // triangle
+  const double c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
+  for (int j = 0; j < 3; j++)
+  {
+    n[j] = e1[j] - c * e0[j];
+  }
+  vtkMath::Normalize(n);
+  d = -vtkMath::Dot(n, t1);
+  return vtkMath::Norm(e0);
+}
+
+// Add to QEM, which holds the plane quadric of the triangle (x0, x1, x2)
+// with unit normal n, the quadrics of the numComps attributes interpolated
+// linearly over the triangle. Each xi holds the point coordinates followed
+// by the scaled attributes. Returns false, leaving QEM unchanged, when the
+// attribute gradients cannot be computed.
+inline bool AddAttributeQuadrics(const double* x0, const double* x1, const double* x2,
+  const double n[3], int numComps, double* QEM)
+{
+  double data[16];
+  double* A[4] = { data, data + 4, data + 8, data + 12 };
+  double x[4];
+  int index[4];
+  for (int i = 0; i < 3; i++)
+  {
+    A[0][i] = x0[i];
+    A[1][i] = x1[i];
+    A[2][i] = x2[i];
+    A[3][i] = n[i];
+  }
+  A[0][3] = A[1][3] = A[2][3] = 1;
+  A[3][3] = 0;
+
+  // should handle poorly condition matrix better
+  if (!vtkMath::LUFactorLinearSystem(A, index, 4))
+  {
+    return false;
+  }
+
+  for (int i = 0; i < numComps; i++)
+  {
+    x[0] = x0[3 + i];
+    x[1] = x1[3 + i];
+    x[2] = x2[3 + i];
+    x[3] = 0;
+    vtkMath::LUSolveLinearSystem(A, index, x, 4);
+
+    // add in the contribution of this element into the QEM
+    QEM[0] += x[0] * x[0];
+    QEM[1] += x[0] * x[1];
+    QEM[2] += x[0] * x[2];
+    QEM[3] += x[3] * x[0];
+
+    QEM[4] += x[1] * x[1];
+    QEM[5] += x[1] * x[2];
+    QEM[6] += x[3] * x[1];
+
+    QEM[7] += x[2] * x[2];
+    QEM[8] += x[3] * x[2];
+
+    QEM[9] += x[3] * x[3];
+
+    QEM[11 + i * 4] = -x[0];
+    QEM[12 + i * 4] = -x[1];
+    QEM[13 + i * 4] = -x[2];
+    QEM[14 + i * 4] = -x[3];
+  }
+  return true;
+}
+
+// Find the point x minimizing the geometric part of the quadric of the
+// collapse of edge (pt1, pt2), and return its cost. When the quadric is
+// singular, x is the cheapest point along the edge.
+inline double ComputeGeometricCost(
+  const double* quad, const double pt1[3], const double pt2[3], double x[3])
+{
+  static const double errorNumber = 1e-10;
+  double A[3][3], b[3], temp[3], temp2[3], v[3];
+
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
+
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
+
+  double norm = vtkMath::Norm(A[0]);
+  double normTemp = vtkMath::Norm(A[1]);
+  norm = norm > normTemp ? norm : normTemp;
+  normTemp = vtkMath::Norm(A[2]);
+  norm = norm > normTemp ? norm : normTemp;
+
+  if (std::fabs(vtkMath::Determinant3x3(A)) / (norm * norm * norm) > errorNumber)
+  {
+    // it would be better to use the normal of the matrix to test singularity??
+    vtkMath::LinearSolve3x3(A, b, x);
+  }
+  else
+  {
+    // cheapest point along the edge
+    for (int i = 0; i < 3; i++)
+    {
+      v[i] = pt2[i] - pt1[i];
+    }
+
+    // equation for the edge pt1 + c * v
+    // attempt least squares fit for c for A*(pt1 + c * v) = b
+    vtkMath::Multiply3x3(A, v, temp2);
+    if (vtkMath::Dot(temp2, temp2) > errorNumber)
+    {
+      vtkMath::Multiply3x3(A, pt1, temp);
+      for (int i = 0; i < 3; i++)
+      {
+        temp[i] = b[i] - temp[i];
+      }
+      const double c = vtkMath::Dot(temp2, temp) / vtkMath::Dot(temp2, temp2);
+      for (int i = 0; i < 3; i++)
+      {
+        x[i] = pt1[i] + c * v[i];
+      }
+    }
+    else
+    {
+      // use mid point
+      // might want to change to best of mid and end points??
+      for (int i = 0; i < 3; i++)
+      {
+        x[i] = 0.5 * (pt1[i] + pt2[i]);
+      }
+    }
+  }
+
+  // Compute the cost
+  // x'*quad*x
+  const double newPoint[4] = { x[0], x[1], x[2], 1.0 };
+  double cost = 0.0;
+  const double* index = quad;
+  for (int i = 0; i < 4; i++)
+  {
+    cost += (*index++) * newPoint[i] * newPoint[i];
+    for (int j = i + 1; j < 4; j++)
+    {
+      cost += 2.0 * (*index++) * newPoint[i] * newPoint[j];
+    }
+  }
+  return cost;
+}
+
+// Convert the quadric into the dense matrix A and vector b of the error
+// x'*A*x - 2*b*x + quad[9] over the coordinates and the numComps attribute
+// components. When volume is not null, it holds the volume constraint of
+// the collapse (g_vol and d_vol), added as a last row and column for its
+// Lagrange multiplier.
+inline void GetDenseQuadric(
+  const double* quad, const double* volume, int numComps, double** A, double* b)
+{
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
+
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
+
+  for (int i = 3; i < 3 + numComps; i++)
+  {
+    A[0][i] = A[i][0] = quad[11 + 4 * (i - 3)];
+    A[1][i] = A[i][1] = quad[11 + 4 * (i - 3) + 1];
+    A[2][i] = A[i][2] = quad[11 + 4 * (i - 3) + 2];
+    b[i] = -quad[11 + 4 * (i - 3) + 3];
+  }
+
+  // Set zero to all components of the submatrix a[3:n;3:n] and al to its diagonal
+  for (int i = 3; i < 3 + numComps; i++)
+  {
+    for (int j = 3; j < 3 + numComps; j++)
+    {
+      A[i][j] = (i == j ? quad[10] : 0);
+    }
+  }
+
+  if (volume)
+  {
+    // Add row/col for volume constraint
+    const int last = 3 + numComps;
+    for (int i = 0; i < last + 1; i++)
+    {
+      A[i][last] = A[last][i] = (i < 3 ? volume[i] : 0);
+    }
+    // Add constraint to b
+    b[last] = volume[3];
+  }
+}
+
+// Find the point x minimizing the quadric with attributes of the collapse
+// of edge (pt1, pt2), and return its cost. pt1 and pt2 hold the point
+// coordinates followed by the scaled attributes, and the volume constraint
+// is used when volume is not null (see GetDenseQuadric). A and b are work
+// space for as many rows and values as there are unknowns, the Lagrange
+// multiplier included. When the system cannot be solved, x is the cheapest
+// point along the edge.
+inline double ComputeAttributeCost(const double* quad, const double* volume, int numComps,
+  const double* pt1, const double* pt2, double** A, double* b, double* x)
+{
+  static const double errorNumber = 1e-10;
+  const int size = 3 + numComps;
+  const int numUnknowns = size + (volume ? 1 : 0);
+
+  GetDenseQuadric(quad, volume, numComps, A, b);
+  for (int i = 0; i < numUnknowns; i++)
+  {
+    x[i] = b[i];
+  }
+
+  // solve A*x = b
+  // this clobers A
+  // need to develop a quality of the solution test??
+  const int solveOk = vtkMath::SolveLinearSystem(A, x, numUnknowns);
+
+  // need to copy back into A
+  GetDenseQuadric(quad, volume, numComps, A, b);
+
+  // check for failure to solve the system
+  if (!solveOk)
+  {
+    // cheapest point along the edge
+    // this should not frequently occur, so I am using dynamic allocation
+    std::vector<double> work(3 * size);
+    double* v = work.data();
+    double* temp = v + size;
+    double* temp2 = temp + size;
+    double d = 0;
+    double c = 0;
+
+    for (int i = 0; i < size; ++i)
+    {
+      v[i] = pt2[i] - pt1[i];
+    }
+
+    // equation for the edge pt1 + c * v
+    // attempt least squares fit for c for A*(pt1 + c * v) = b
+    // temp2 = A*v
+    for (int i = 0; i < size; ++i)
+    {
+      temp2[i] = 0;
+      for (int j = 0; j < size; ++j)
+      {
+        temp2[i] += A[i][j] * v[j];
+      }
+    }
+
+    // c = v dot v
+    for (int i = 0; i < size; ++i)
+    {
+      d += temp2[i] * temp2[i];
+    }
+
+    if (d > errorNumber)
+    {
+      // temp = A*pt1
+      for (int i = 0; i < size; ++i)
+      {
+        temp[i] = 0;
+        for (int j = 0; j < size; ++j)
+        {
+          temp[i] += A[i][j] * pt1[j];
+        }
+      }
+
+      for (int i = 0; i < size; i++)
+      {
+        temp[i] = b[i] - temp[i];
+      }
+
+      for (int i = 0; i < size; i++)
+      {
+        c += temp2[i] * temp[i];
+      }
+      c = c / d;
+
+      for (int i = 0; i < size; i++)
+      {
+        x[i] = pt1[i] + c * v[i];
+      }
+    }
+    else
+    {
+      // use mid point
+      // might want to change to best of mid and end points??
+      for (int i = 0; i < size; i++)
+      {
+        x[i] = 0.5 * (pt1[i] + pt2[i]);
+      }
+    }
+  }
+
+  // Compute the cost
+  // x'*A*x - 2*b*x + d
+  double cost = 0.0;
+  for (int i = 0; i < numUnknowns; i++)
+  {
+    cost += A[i][i] * x[i] * x[i];
+    for (int j = i + 1; j < numUnknowns; j++)
+    {
+      cost += 2.0 * A[i][j] * x[i] * x[j];
+    }
+  }
+  for (int i = 0; i < numUnknowns; i++)
+  {
+    cost -= 2.0 * b[i] * x[i];
+  }
+
+  cost += quad[9];
+
+  return cost;
+}
+
+// triangle t0, t1, t2 and point x
+// determines if t0 and x are on the same side of the plane defined by
+// t1 and t2, and parallel to the normal of the triangle
+inline bool TrianglePlaneCheck(
+  const double t0[3], const double t1[3], const double t2[3], const double* x)
+{
+  double e0[3], e1[3], n[3], e2[3];
+  for (int i = 0; i < 3; i++)
+  {
+    e0[i] = t2[i] - t1[i];
+    e1[i] = t0[i] - t1[i];
+    e2[i] = x[i] - t1[i];
+  }
+
+  // projection of e0 onto e1
+  const double c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
+  for (int i = 0; i < 3; i++)
+  {
+    n[i] = e1[i] - c * e0[i];
+  }
+
+  vtkMath::Normalize(n);
+  vtkMath::Normalize(e2);
+  return vtkMath::Dot(n, e2) > 1e-5;
+}
+
+// The point attributes included in the error measure, in this order:
+// scalars, vectors, normals, texture coordinates and tensors.
+struct QuadricAttributes
+{
+  static const int NumberOfAttributes = 5;
+
+  vtkDataArray* Arrays[NumberOfAttributes];
+  int Components[NumberOfAttributes]; // end of the components of each attribute
+  double Scale[NumberOfAttributes];
+  int NumberOfComponents;
+
+  // Select the attributes of pd to include. An attribute is included when
+  // its flag is set and its range is not empty; its components are then
+  // scaled by its weight divided by the largest component range. The
+  // normals are assumed normalized.
+  void Select(vtkPointData* pd, const vtkTypeBool use[NumberOfAttributes],
+    const double weights[NumberOfAttributes])
+  {
+    vtkDataArray* arrays[NumberOfAttributes] = { pd->GetScalars(), pd->GetVectors(),
+      pd->GetNormals(), pd->GetTCoords(), pd->GetTensors() };
+    this->NumberOfComponents = 0;
+    for (int i = 0; i < NumberOfAttributes; i++)
+    {
+      this->Arrays[i] = nullptr;
+      this->Scale[i] = 1.0;
+      if (arrays[i] != nullptr && use[i])
+      {
+        if (i == vtkDataSetAttributes::NORMALS)
+        {
+          this->Arrays[i] = arrays[i];
+          this->NumberOfComponents += 3;
+          this->Scale[i] = 0.5 * weights[i];
+        }
+        else
+        {
+          double range[2], maxRange = 0.0;
+          const int numComps = arrays[i]->GetNumberOfComponents();
+          for (int j = 0; j < numComps; j++)
+          {
+            pd->GetRange(arrays[i]->GetName(), range, j);
+            maxRange = (maxRange < (range[1] - range[0]) ? (range[1] - range[0]) : maxRange);
+          }
+          if (maxRange != 0.0)
+          {
+            this->Arrays[i] = arrays[i];
+            this->NumberOfComponents += numComps;
+            this->Scale[i] = weights[i] / maxRange;
+          }
+        }
+      }
+      this->Components[i] = this->NumberOfComponents;
+    }
+  }
+
+  // Get the scaled attributes of a point.
+  void Get(vtkIdType ptId, double* x) const
+  {
+    int start = 0;
+    for (int i = 0; i < NumberOfAttributes; i++)
+    {
+      for (int j = start; j < this->Components[i]; j++)
+      {
+        x[j] = this->Arrays[i]->GetComponent(ptId, j - start) * this->Scale[i];
+      }
+      start = this->Components[i];
+    }
+  }
+
+  // Set the attributes of a point from their scaled values.
+  void Set(vtkIdType ptId, const double* x) const
+  {
+    int start = 0;
+    for (int i = 0; i < NumberOfAttributes; i++)
+    {
+      for (int j = start; j < this->Components[i]; j++)
+      {
+        this->Arrays[i]->SetComponent(ptId, j - start, x[j] / this->Scale[i]);
+      }
+      start = this->Components[i];
+    }
+  }
+};
+
+} // anonymous namespace
+
+#endif
+// VTK-HeaderTest-Exclude: vtkQuadricDecimationInternal.h
@@ -0,0 +1,1360 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedQuadricDecimation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkThreadedQuadricDecimation.h"
+
+#include "vtkArrayListTemplate.h"
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimationInternal.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkThreadedQuadricDecimation);
+
+namespace
+{
+// Fraction of the edges that can be collapsed concurrently which are
+// collapsed in a pass. Only collapsing the cheapest of them lets the
+// expensive collapses wait for the cheaper ones around, which keeps the
+// error close to the one of a global priority queue.
+const double BatchFraction = 0.25;
+
+// The cheapest collapse found for a vertex. The edge end points are ordered
+// (V0 < V1) so that both end points compute exactly the same collapse.
+struct EdgeCollapse
+{
+  double Cost;
+  vtkIdType V0;
+  vtkIdType V1;
+  int NumberOfDeletedTriangles;
+  bool Cheaper; // whether cheaper edges of the vertex could not be collapsed
+
+  void Invalidate()
+  {
+    this->Cost = VTK_DOUBLE_MAX;
+    this->V0 = this->V1 = -1;
+    this->NumberOfDeletedTriangles = 0;
+    this->Cheaper = false;
+  }
+
+  bool IsValid() const { return this->V0 >= 0; }
+
+  bool SameEdge(const EdgeCollapse& other) const
+  {
+    return this->V0 == other.V0 && this->V1 == other.V1;
+  }
+
+  // Ties are broken with the edge end points, so that no two edges compare
+  // equal and the selected collapses do not depend on the processing order.
+  bool operator<(const EdgeCollapse& other) const
+  {
+    if (this->Cost != other.Cost)
+    {
+      return this->Cost < other.Cost;
+    }
+    if (this->V0 != other.V0)
+    {
+      return this->V0 < other.V0;
+    }
+    return this->V1 < other.V1;
+  }
+};
+
+// Triangles using each point. The list of a point is a range of the Links
+// pool: when an edge is collapsed, the merged list of the remaining point is
+// appended to the pool, and the deleted triangles are removed from the lists
+// of the points opposite to the edge.
+struct TriangleLinks
+{
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Sizes;
+  std::vector<vtkIdType> Links;
+
+  void Build(vtkIdType numPts, const vtkIdType* tris, vtkIdType numTris)
+  {
+    this->Offsets.assign(numPts, 0);
+    this->Sizes.assign(numPts, 0);
+    this->Links.resize(3 * numTris);
+    for (vtkIdType idx = 0; idx < 3 * numTris; ++idx)
+    {
+      ++this->Sizes[tris[idx]];
+    }
+    for (vtkIdType ptId = 1; ptId < numPts; ++ptId)
+    {
+      this->Offsets[ptId] = this->Offsets[ptId - 1] + this->Sizes[ptId - 1];
+    }
+    std::vector<vtkIdType> insert(this->Offsets);
+    for (vtkIdType triId = 0; triId < numTris; ++triId)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        this->Links[insert[tris[3 * triId + i]]++] = triId;
+      }
+    }
+  }
+
+  void Remove(vtkIdType ptId, vtkIdType triId)
+  {
+    vtkIdType* begin = this->Links.data() + this->Offsets[ptId];
+    vtkIdType* end = begin + this->Sizes[ptId];
+    this->Sizes[ptId] = std::remove(begin, end, triId) - begin;
+  }
+};
+
+// An edge collapse considered by a vertex, and the offset of its collapse
+// point in CollapseScratch::Targets.
+struct CollapseCandidate
+{
+  EdgeCollapse Collapse;
+  size_t Target;
+
+  bool operator<(const CollapseCandidate& other) const { return this->Collapse < other.Collapse; }
+};
+
+// Per thread work space used while looking for edge collapses.
+struct CollapseScratch
+{
+  std::vector<vtkIdType> Neighbors;
+  std::vector<vtkIdType> Neighbors0;
+  std::vector<vtkIdType> Neighbors1;
+  std::vector<CollapseCandidate> Candidates;
+  std::vector<double> Targets;
+
+  // Cost of a collapse: the sum of the quadrics, the end points with their
+  // attributes, and the dense system of the attributes.
+  std::vector<double> Quadric;
+  std::vector<double> EndPoints;
+  std::vector<double> AData;
+  std::vector<double*> A;
+  std::vector<double> B;
+
+  void Initialize(int numComps, int targetSize)
+  {
+    this->Quadric.resize(GetQuadricSize(numComps));
+    this->EndPoints.resize(2 * (3 + numComps));
+    this->AData.resize(targetSize * targetSize);
+    this->A.resize(targetSize);
+    this->B.resize(targetSize);
+    for (int i = 0; i < targetSize; ++i)
+    {
+      this->A[i] = this->AData.data() + i * targetSize;
+    }
+  }
+};
+
+// The working mesh: double precision points, their quadrics (and volume
+// constraints), their scaled attributes, the triangles and the triangle
+// links.
+struct DecimationMesh
+{
+  double* Points;
+  double* Quadrics;
+  double* Volumes; // 4 values per point, nullptr without volume preservation
+  double* Attributes;
+  int NumberOfComponents;
+  int QuadricSize;
+  int TargetSize; // the coordinates, the attributes and the Lagrange multiplier
+  vtkIdType* Triangles;
+  TriangleLinks* Links;
+
+  vtkIdType GetNumberOfTriangles(vtkIdType ptId) const { return this->Links->Sizes[ptId]; }
+  const vtkIdType* GetTriangles(vtkIdType ptId) const
+  {
+    return this->Links->Links.data() + this->Links->Offsets[ptId];
+  }
+  static bool Uses(const vtkIdType* tri, vtkIdType ptId)
+  {
+    return tri[0] == ptId || tri[1] == ptId || tri[2] == ptId;
+  }
+
+  // Sorted list of the points sharing a triangle with ptId. Returns whether
+  // ptId is on the boundary, that is whether one of its edges is not used
+  // by exactly two triangles.
+  bool GetNeighbors(vtkIdType ptId, std::vector<vtkIdType>& neighbors) const
+  {
+    neighbors.clear();
+    const vtkIdType numTris = this->GetNumberOfTriangles(ptId);
+    const vtkIdType* tris = this->GetTriangles(ptId);
+    for (vtkIdType i = 0; i < numTris; ++i)
+    {
+      const vtkIdType* tri = this->Triangles + 3 * tris[i];
+      for (int j = 0; j < 3; ++j)
+      {
+        if (tri[j] != ptId)
+        {
+          neighbors.push_back(tri[j]);
+        }
+      }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    bool boundary = false;
+    size_t numNeighbors = 0;
+    for (size_t i = 0; i < neighbors.size();)
+    {
+      size_t j = i + 1;
+      while (j < neighbors.size() && neighbors[j] == neighbors[i])
+      {
+        ++j;
+      }
+      boundary |= j - i != 2;
+      neighbors[numNeighbors++] = neighbors[i];
+      i = j;
+    }
+    neighbors.resize(numNeighbors);
+    return boundary;
+  }
+
+  // Number of triangles using the edge (p0, p1).
+  int CountEdgeTriangles(vtkIdType p0, vtkIdType p1) const
+  {
+    int count = 0;
+    const vtkIdType numTris = this->GetNumberOfTriangles(p0);
+    const vtkIdType* tris = this->GetTriangles(p0);
+    for (vtkIdType i = 0; i < numTris; ++i)
+    {
+      count += Uses(this->Triangles + 3 * tris[i], p1) ? 1 : 0;
+    }
+    return count;
+  }
+
+  bool HasTriangle(vtkIdType p0, vtkIdType p1, vtkIdType p2) const
+  {
+    const vtkIdType numTris = this->GetNumberOfTriangles(p0);
+    const vtkIdType* tris = this->GetTriangles(p0);
+    for (vtkIdType i = 0; i < numTris; ++i)
+    {
+      const vtkIdType* tri = this->Triangles + 3 * tris[i];
+      if (Uses(tri, p1) && Uses(tri, p2))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Cost of the collapse of edge (p0, p1) and its optimal point x: the
+  // coordinates, followed with the attribute error metric by the scaled
+  // attributes, and with volume preservation by the Lagrange multiplier.
+  double ComputeCost(vtkIdType p0, vtkIdType p1, double* x, CollapseScratch& scratch) const
+  {
+    double* quad = scratch.Quadric.data();
+    const double* q0 = this->Quadrics + this->QuadricSize * p0;
+    const double* q1 = this->Quadrics + this->QuadricSize * p1;
+    for (int i = 0; i < this->QuadricSize; i++)
+    {
+      quad[i] = q0[i] + q1[i];
+    }
+    if (this->NumberOfComponents == 0 && !this->Volumes)
+    {
+      return ComputeGeometricCost(quad, this->Points + 3 * p0, this->Points + 3 * p1, x);
+    }
+
+    double volume[4];
+    if (this->Volumes)
+    {
+      for (int i = 0; i < 4; i++)
+      {
+        volume[i] = this->Volumes[4 * p0 + i] + this->Volumes[4 * p1 + i];
+      }
+    }
+    const int size = 3 + this->NumberOfComponents;
+    const vtkIdType ends[2] = { p0, p1 };
+    double* pts[2] = { scratch.EndPoints.data(), scratch.EndPoints.data() + size };
+    for (int e = 0; e < 2; ++e)
+    {
+      std::copy_n(this->Points + 3 * ends[e], 3, pts[e]);
+      std::copy_n(this->Attributes + this->NumberOfComponents * ends[e], this->NumberOfComponents,
+        pts[e] + 3);
+    }
+    return ComputeAttributeCost(quad, this->Volumes ? volume : nullptr, this->NumberOfComponents,
+      pts[0], pts[1], scratch.A.data(), scratch.B.data(), x);
+  }
+
+  // Root mean square distance from the collapse point to the planes of the
+  // quadrics (the attribute errors included with the attribute error
+  // metric).
+  double ComputeError(const EdgeCollapse& collapse) const
+  {
+    const double weight = this->Quadrics[this->QuadricSize * collapse.V0 + 10] +
+      this->Quadrics[this->QuadricSize * collapse.V1 + 10];
+    if (weight <= 0.0 || collapse.Cost <= 0.0)
+    {
+      return 0.0;
+    }
+    return std::sqrt(collapse.Cost / weight);
+  }
+
+  // Same test as vtkQuadricDecimation::IsGoodPlacement: none of the triangles
+  // moved by the collapse may flip.
+  bool IsGoodPlacement(vtkIdType p0, vtkIdType p1, const double* x) const
+  {
+    const vtkIdType ends[2][2] = { { p0, p1 }, { p1, p0 } };
+    for (int e = 0; e < 2; ++e)
+    {
+      const vtkIdType ptId = ends[e][0];
+      const vtkIdType numTris = this->GetNumberOfTriangles(ptId);
+      const vtkIdType* tris = this->GetTriangles(ptId);
+      for (vtkIdType i = 0; i < numTris; ++i)
+      {
+        const vtkIdType* tri = this->Triangles + 3 * tris[i];
+        if (Uses(tri, ends[e][1]))
+        {
+          continue;
+        }
+        const int k = tri[0] == ptId ? 0 : (tri[1] == ptId ? 1 : 2);
+        if (!TrianglePlaneCheck(this->Points + 3 * tri[k], this->Points + 3 * tri[(k + 1) % 3],
+              this->Points + 3 * tri[(k + 2) % 3], x))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // Check that collapsing p1 onto p0 preserves the topology of the mesh:
+  // the edge is manifold, a boundary is not pinched, and the only points
+  // connected to both end points are the ones opposite to the edge (the
+  // link condition). Returns the number of triangles deleted by the
+  // collapse, or 0 if the edge cannot be collapsed.
+  int CanCollapse(vtkIdType p0, vtkIdType p1, CollapseScratch& scratch) const
+  {
+    const int numShared = this->CountEdgeTriangles(p0, p1);
+    if (numShared < 1 || numShared > 2)
+    {
+      return 0;
+    }
+
+    const bool boundary0 = this->GetNeighbors(p0, scratch.Neighbors0);
+    const bool boundary1 = this->GetNeighbors(p1, scratch.Neighbors1);
+    if (numShared == 2 && boundary0 && boundary1)
+    {
+      return 0;
+    }
+
+    int numCommon = 0;
+    auto it0 = scratch.Neighbors0.begin();
+    auto it1 = scratch.Neighbors1.begin();
+    while (it0 != scratch.Neighbors0.end() && it1 != scratch.Neighbors1.end())
+    {
+      if (*it0 < *it1)
+      {
+        ++it0;
+      }
+      else if (*it1 < *it0)
+      {
+        ++it1;
+      }
+      else
+      {
+        ++numCommon;
+        ++it0;
+        ++it1;
+      }
+    }
+    if (numCommon != numShared)
+    {
+      return 0;
+    }
+
+    // A triangle moved onto an existing triangle would be duplicated.
+    const vtkIdType numTris = this->GetNumberOfTriangles(p1);
+    const vtkIdType* tris = this->GetTriangles(p1);
+    for (vtkIdType i = 0; i < numTris; ++i)
+    {
+      const vtkIdType* tri = this->Triangles + 3 * tris[i];
+      if (Uses(tri, p0))
+      {
+        continue;
+      }
+      const int k = tri[0] == p1 ? 0 : (tri[1] == p1 ? 1 : 2);
+      if (this->HasTriangle(p0, tri[(k + 1) % 3], tri[(k + 2) % 3]))
+      {
+        return 0;
+      }
+    }
+    return numShared;
+  }
+};
+
+// Compute the quadric of each triangle, weighted by its area: its plane,
+// the attributes interpolated over it with the attribute error metric, and
+// its volume constraint with volume preservation.
+struct ComputeTriangleQuadrics
+{
+  const DecimationMesh* Mesh;
+  double* TriangleQuadrics;
+  int Stride;
+
+  void operator()(vtkIdType triId, vtkIdType endTriId) const
+  {
+    const int numComps = this->Mesh->NumberOfComponents;
+    const int size = 3 + numComps;
+    std::vector<double> points(3 * size);
+    double* x[3] = { points.data(), points.data() + size, points.data() + 2 * size };
+    double tempP1[3], tempP2[3], n[3];
+    for (; triId < endTriId; ++triId)
+    {
+      const vtkIdType* tri = this->Mesh->Triangles + 3 * triId;
+      for (int k = 0; k < 3; ++k)
+      {
+        std::copy_n(this->Mesh->Points + 3 * tri[k], 3, x[k]);
+        std::copy_n(this->Mesh->Attributes + numComps * tri[k], numComps, x[k] + 3);
+      }
+      for (int i = 0; i < 3; i++)
+      {
+        tempP1[i] = x[1][i] - x[0][i];
+        tempP2[i] = x[2][i] - x[0][i];
+      }
+      vtkMath::Cross(tempP1, tempP2, n);
+      const double area = 0.5 * vtkMath::Normalize(n);
+      const double d = -vtkMath::Dot(n, x[0]);
+
+      double* QEM = this->TriangleQuadrics + this->Stride * triId;
+      SetPlaneQuadric(n, d, QEM);
+      if (numComps > 0 && !AddAttributeQuadrics(x[0], x[1], x[2], n, numComps, QEM))
+      {
+        // the attributes of a degenerate triangle add nothing
+        std::fill_n(QEM + 11, 4 * numComps, 0.0);
+      }
+      for (int i = 0; i < this->Mesh->QuadricSize; i++)
+      {
+        QEM[i] *= area;
+      }
+
+      // volume constraint: g_vol and d_vol of the triangle
+      if (this->Mesh->Volumes)
+      {
+        double* volume = QEM + this->Mesh->QuadricSize;
+        for (int i = 0; i < 3; i++)
+        {
+          volume[i] = n[i] * area * 2.0;
+        }
+        volume[3] = -d * area * 2.0;
+      }
+    }
+  }
+};
+
+// Accumulate the quadrics of the triangles using each point, and the
+// constraint planes of its boundary edges (see
+// vtkQuadricDecimation::AddBoundaryConstraints). Each point only writes its
+// own quadric.
+struct InitializeQuadrics
+{
+  const DecimationMesh* Mesh;
+  const double* TriangleQuadrics;
+  int Stride;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId) const
+  {
+    const int quadricSize = this->Mesh->QuadricSize;
+    double QEM[11];
+    double n[3], d;
+    for (; ptId < endPtId; ++ptId)
+    {
+      double* quadric = this->Mesh->Quadrics + quadricSize * ptId;
+      double* volume = this->Mesh->Volumes ? this->Mesh->Volumes + 4 * ptId : nullptr;
+      std::fill_n(quadric, quadricSize, 0.0);
+      if (volume)
+      {
+        std::fill_n(volume, 4, 0.0);
+      }
+      const vtkIdType numTris = this->Mesh->GetNumberOfTriangles(ptId);
+      const vtkIdType* tris = this->Mesh->GetTriangles(ptId);
+      for (vtkIdType i = 0; i < numTris; ++i)
+      {
+        const double* triQuadric = this->TriangleQuadrics + this->Stride * tris[i];
+        for (int j = 0; j < quadricSize; j++)
+        {
+          quadric[j] += triQuadric[j];
+        }
+        if (volume)
+        {
+          for (int j = 0; j < 4; j++)
+          {
+            volume[j] += triQuadric[quadricSize + j];
+          }
+        }
+      }
+
+      for (vtkIdType i = 0; i < numTris; ++i)
+      {
+        const vtkIdType* pts = this->Mesh->Triangles + 3 * tris[i];
+        for (int k = 0; k < 3; ++k)
+        {
+          const vtkIdType p1 = pts[k];
+          const vtkIdType p2 = pts[(k + 1) % 3];
+          if ((p1 != ptId && p2 != ptId) || this->Mesh->CountEdgeTriangles(p1, p2) != 1)
+          {
+            continue;
+          }
+          const double w = ComputeBoundaryPlane(this->Mesh->Points + 3 * pts[(k + 2) % 3],
+            this->Mesh->Points + 3 * p1, this->Mesh->Points + 3 * p2, n, d);
+          SetPlaneQuadric(n, d, QEM);
+          for (int j = 0; j < 11; j++)
+          {
+            quadric[j] += QEM[j] * w;
+          }
+        }
+      }
+    }
+  }
+};
+
+// For each point of a list, find its cheapest edge that can be collapsed,
+// and the collapse point. The costs of the edges whose end points did not
+// move are unchanged: when the previous cheapest collapse of a point that
+// did not move was its cheapest edge, only the edges to its moved neighbors
+// can be cheaper. The points whose cheapest collapse changed are flagged as
+// modified.
+struct FindCheapestCollapses
+{
+  const DecimationMesh* Mesh;
+  double MaximumError;
+  const vtkIdType* PointIds;
+  const unsigned char* Moved;
+  EdgeCollapse* Cheapest;
+  double* Targets;
+  unsigned char* Modified;
+  vtkSMPThreadLocal<CollapseScratch> Scratch;
+
+  FindCheapestCollapses(const DecimationMesh* mesh, double maxError, const vtkIdType* ptIds,
+    const unsigned char* moved, EdgeCollapse* cheapest, double* targets, unsigned char* modified)
+    : Mesh(mesh)
+    , MaximumError(maxError)
+    , PointIds(ptIds)
+    , Moved(moved)
+    , Cheapest(cheapest)
+    , Targets(targets)
+    , Modified(modified)
+  {
+  }
+
+  void AddCandidate(vtkIdType ptId, vtkIdType neighbor, double maxCost, CollapseScratch& scratch)
+  {
+    const int targetSize = this->Mesh->TargetSize;
+    CollapseCandidate candidate;
+    candidate.Collapse.V0 = std::min(ptId, neighbor);
+    candidate.Collapse.V1 = std::max(ptId, neighbor);
+    candidate.Target = scratch.Targets.size();
+    scratch.Targets.resize(candidate.Target + targetSize);
+    candidate.Collapse.Cost = this->Mesh->ComputeCost(candidate.Collapse.V0,
+      candidate.Collapse.V1, scratch.Targets.data() + candidate.Target, scratch);
+    if (candidate.Collapse.Cost < VTK_DOUBLE_MAX && candidate.Collapse.Cost <= maxCost &&
+      this->Mesh->ComputeError(candidate.Collapse) <= this->MaximumError)
+    {
+      scratch.Candidates.push_back(candidate);
+    }
+  }
+
+  // Set the cheapest collapse of ptId to the cheapest candidate that can be
+  // done, only looking at the cheapest candidate when firstOnly is set.
+  bool SelectCandidate(vtkIdType ptId, bool firstOnly, CollapseScratch& scratch)
+  {
+    const int targetSize = this->Mesh->TargetSize;
+    std::sort(scratch.Candidates.begin(), scratch.Candidates.end());
+    for (size_t i = 0; i < scratch.Candidates.size() && (i == 0 || !firstOnly); ++i)
+    {
+      EdgeCollapse& collapse = scratch.Candidates[i].Collapse;
+      const double* target = scratch.Targets.data() + scratch.Candidates[i].Target;
+      collapse.NumberOfDeletedTriangles =
+        this->Mesh->CanCollapse(collapse.V0, collapse.V1, scratch);
+      if (collapse.NumberOfDeletedTriangles > 0 &&
+        this->Mesh->IsGoodPlacement(collapse.V0, collapse.V1, target))
+      {
+        collapse.Cheaper = i > 0;
+        this->Cheapest[ptId] = collapse;
+        std::copy_n(target, targetSize, this->Targets + targetSize * ptId);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void operator()(vtkIdType idx, vtkIdType endIdx)
+  {
+    const int targetSize = this->Mesh->TargetSize;
+    CollapseScratch& scratch = this->Scratch.Local();
+    if (scratch.A.empty())
+    {
+      scratch.Initialize(this->Mesh->NumberOfComponents, targetSize);
+    }
+    for (; idx < endIdx; ++idx)
+    {
+      const vtkIdType ptId = this->PointIds[idx];
+      const EdgeCollapse previous = this->Cheapest[ptId];
+      this->Cheapest[ptId].Invalidate();
+      if (this->Mesh->GetNumberOfTriangles(ptId) == 0)
+      {
+        this->Modified[ptId] = previous.IsValid();
+        continue;
+      }
+
+      this->Mesh->GetNeighbors(ptId, scratch.Neighbors);
+      bool found = false;
+      const vtkIdType other = previous.V0 == ptId ? previous.V1 : previous.V0;
+      if (previous.IsValid() && !previous.Cheaper && !this->Moved[ptId] && !this->Moved[other])
+      {
+        scratch.Candidates.clear();
+        scratch.Targets.assign(
+          this->Targets + targetSize * ptId, this->Targets + targetSize * (ptId + 1));
+        CollapseCandidate candidate = { previous, 0 };
+        scratch.Candidates.push_back(candidate);
+        for (vtkIdType neighbor : scratch.Neighbors)
+        {
+          if (this->Moved[neighbor])
+          {
+            this->AddCandidate(ptId, neighbor, previous.Cost, scratch);
+          }
+        }
+        found = this->SelectCandidate(ptId, true, scratch);
+      }
+      if (!found)
+      {
+        scratch.Candidates.clear();
+        scratch.Targets.clear();
+        for (vtkIdType neighbor : scratch.Neighbors)
+        {
+          this->AddCandidate(ptId, neighbor, VTK_DOUBLE_MAX, scratch);
+        }
+        this->SelectCandidate(ptId, false, scratch);
+      }
+      const EdgeCollapse& cheapest = this->Cheapest[ptId];
+      this->Modified[ptId] = !cheapest.SameEdge(previous) || cheapest.Cost != previous.Cost;
+    }
+  }
+};
+
+// For each point of a list, find the point of its neighborhood (itself
+// included) with the cheapest collapse.
+struct FindNeighborhoodMinimum
+{
+  const DecimationMesh* Mesh;
+  const vtkIdType* PointIds;
+  const EdgeCollapse* Cheapest;
+  vtkIdType* Minimum;
+
+  void operator()(vtkIdType idx, vtkIdType endIdx) const
+  {
+    for (; idx < endIdx; ++idx)
+    {
+      const vtkIdType ptId = this->PointIds[idx];
+      vtkIdType minimum = ptId;
+      if (this->Cheapest[ptId].IsValid())
+      {
+        const vtkIdType numTris = this->Mesh->GetNumberOfTriangles(ptId);
+        const vtkIdType* tris = this->Mesh->GetTriangles(ptId);
+        for (vtkIdType i = 0; i < numTris; ++i)
+        {
+          const vtkIdType* tri = this->Mesh->Triangles + 3 * tris[i];
+          for (int j = 0; j < 3; ++j)
+          {
+            if (this->Cheapest[tri[j]] < this->Cheapest[minimum])
+            {
+              minimum = tri[j];
+            }
+          }
+        }
+      }
+      this->Minimum[ptId] = minimum;
+    }
+  }
+};
+
+// What a collapse leaves to the serial update of the mesh.
+struct CollapseRecord
+{
+  vtkIdType DeletedTriangles[2];
+  int NumberOfDeletedTriangles;
+  double T; // parametric coordinate of the interpolated point data
+};
+
+// Collapse the selected edges. A selected edge is cheaper than the cheapest
+// collapses of all the points around its end points, so no two selected
+// edges share a triangle: each collapse only touches its own points and
+// triangles, and the range of the links pool reserved for it. The deleted
+// triangles, which are also used by the points opposite to the edge, are
+// only recorded.
+struct CollapseEdges
+{
+  const DecimationMesh* Mesh;
+  const double* Targets;
+  const vtkIdType* Collapses;
+  const vtkIdType* LinksOffsets;
+  const EdgeCollapse* Cheapest;
+  CollapseRecord* Records;
+  ArrayList* Arrays;
+
+  void operator()(vtkIdType idx, vtkIdType endIdx) const
+  {
+    const DecimationMesh* mesh = this->Mesh;
+    const int numComps = mesh->NumberOfComponents;
+    for (; idx < endIdx; ++idx)
+    {
+      const EdgeCollapse& collapse = this->Cheapest[this->Collapses[idx]];
+      const vtkIdType p0 = collapse.V0;
+      const vtkIdType p1 = collapse.V1;
+      const double* x = this->Targets + mesh->TargetSize * p0;
+      double* x0 = mesh->Points + 3 * p0;
+      const double* x1 = mesh->Points + 3 * p1;
+      CollapseRecord& record = this->Records[idx];
+
+      // Interpolate the point data at the projection of the new point on
+      // the edge.
+      double v[3], w[3];
+      for (int i = 0; i < 3; ++i)
+      {
+        v[i] = x1[i] - x0[i];
+        w[i] = x[i] - x0[i];
+      }
+      const double length2 = vtkMath::Dot(v, v);
+      double t = length2 > 0.0 ? vtkMath::Dot(v, w) / length2 : 0.5;
+      t = std::min(1.0, std::max(0.0, t));
+      record.T = t;
+      this->Arrays->InterpolateEdge(p0, p1, t, p0);
+      std::copy(x, x + 3, x0);
+      std::copy_n(x + 3, numComps, mesh->Attributes + numComps * p0);
+
+      double* q0 = mesh->Quadrics + mesh->QuadricSize * p0;
+      const double* q1 = mesh->Quadrics + mesh->QuadricSize * p1;
+      for (int i = 0; i < mesh->QuadricSize; ++i)
+      {
+        q0[i] += q1[i];
+      }
+      if (mesh->Volumes)
+      {
+        for (int i = 0; i < 4; ++i)
+        {
+          mesh->Volumes[4 * p0 + i] += mesh->Volumes[4 * p1 + i];
+        }
+      }
+
+      // Merge the triangles of p1 into those of p0.
+      TriangleLinks* links = mesh->Links;
+      vtkIdType* merged = links->Links.data() + this->LinksOffsets[idx];
+      vtkIdType numMerged = 0;
+      record.NumberOfDeletedTriangles = 0;
+      const vtkIdType numTris0 = mesh->GetNumberOfTriangles(p0);
+      const vtkIdType* tris0 = mesh->GetTriangles(p0);
+      for (vtkIdType i = 0; i < numTris0; ++i)
+      {
+        if (DecimationMesh::Uses(mesh->Triangles + 3 * tris0[i], p1))
+        {
+          record.DeletedTriangles[record.NumberOfDeletedTriangles++] = tris0[i];
+        }
+        else
+        {
+          merged[numMerged++] = tris0[i];
+        }
+      }
+      const vtkIdType numTris1 = mesh->GetNumberOfTriangles(p1);
+      const vtkIdType* tris1 = mesh->GetTriangles(p1);
+      for (vtkIdType i = 0; i < numTris1; ++i)
+      {
+        vtkIdType* tri = mesh->Triangles + 3 * tris1[i];
+        if (DecimationMesh::Uses(tri, p0))
+        {
+          continue;
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+          if (tri[k] == p1)
+          {
+            tri[k] = p0;
+          }
+        }
+        merged[numMerged++] = tris1[i];
+      }
+      links->Offsets[p0] = this->LinksOffsets[idx];
+      links->Sizes[p0] = numMerged;
+      links->Sizes[p1] = 0;
+    }
+  }
+};
+
+// Arrays that ArrayList cannot interpolate or copy from several threads:
+// the non numeric arrays, which it skips, and the bit arrays, whose values
+// share bytes. These are handled serially.
+bool IsSerialArray(vtkAbstractArray* array)
+{
+  return !vtkArrayDownCast<vtkDataArray>(array) || array->GetDataType() == VTK_BIT;
+}
+
+bool CanCopyConcurrently(vtkDataSetAttributes* attributes)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    if (IsSerialArray(attributes->GetAbstractArray(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Append to ring the points that are not marked yet among the seeds and the
+// points sharing a triangle with them, and mark them.
+void AddRing(const DecimationMesh& mesh, const std::vector<vtkIdType>& seeds,
+  std::vector<unsigned char>& marked, std::vector<vtkIdType>& ring)
+{
+  for (vtkIdType seed : seeds)
+  {
+    if (!marked[seed])
+    {
+      marked[seed] = 1;
+      ring.push_back(seed);
+    }
+    const vtkIdType numTris = mesh.GetNumberOfTriangles(seed);
+    const vtkIdType* tris = mesh.GetTriangles(seed);
+    for (vtkIdType i = 0; i < numTris; ++i)
+    {
+      const vtkIdType* tri = mesh.Triangles + 3 * tris[i];
+      for (int j = 0; j < 3; ++j)
+      {
+        if (!marked[tri[j]])
+        {
+          marked[tri[j]] = 1;
+          ring.push_back(tri[j]);
+        }
+      }
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+vtkThreadedQuadricDecimation::vtkThreadedQuadricDecimation()
+{
+  this->TargetReduction = 0.9;
+  this->MaximumError = VTK_DOUBLE_MAX;
+
+  this->AttributeErrorMetric = 0;
+  this->VolumePreservation = 0;
+  this->ScalarsAttribute = 1;
+  this->VectorsAttribute = 1;
+  this->NormalsAttribute = 1;
+  this->TCoordsAttribute = 1;
+  this->TensorsAttribute = 1;
+
+  this->ScalarsWeight = 0.1;
+  this->VectorsWeight = 0.1;
+  this->NormalsWeight = 0.1;
+  this->TCoordsWeight = 0.1;
+  this->TensorsWeight = 0.1;
+
+  this->ActualReduction = 0.0;
+  this->NumberOfPasses = 0;
+}
+
+//------------------------------------------------------------------------------
+int vtkThreadedQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // get the info objects
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+
+  // get the input and output
+  vtkPolyData* input = vtkPolyData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  this->ActualReduction = 0.0;
+  this->NumberOfPasses = 0;
+
+  vtkPoints* inPts = input->GetPoints();
+  vtkCellArray* polys = input->GetPolys();
+  if (inPts == nullptr || polys == nullptr)
+  {
+    vtkErrorMacro("Nothing to decimate");
+    return 1;
+  }
+  if (polys->GetMaxCellSize() > 3)
+  {
+    vtkErrorMacro("Can only decimate triangles");
+    return 1;
+  }
+
+  // Copy the non degenerate triangles to the working mesh, remembering the
+  // cell they come from. The polys come after the verts and lines in the
+  // cell data.
+  const vtkIdType numPts = inPts->GetNumberOfPoints();
+  const vtkIdType cellIdOffset = input->GetNumberOfVerts() + input->GetNumberOfLines();
+  std::vector<vtkIdType> triangles;
+  std::vector<vtkIdType> triangleIds;
+  triangles.reserve(3 * polys->GetNumberOfCells());
+  triangleIds.reserve(polys->GetNumberOfCells());
+  auto iter = vtk::TakeSmartPointer(polys->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    if (npts == 3 && pts[0] != pts[1] && pts[0] != pts[2] && pts[1] != pts[2])
+    {
+      triangles.insert(triangles.end(), pts, pts + 3);
+      triangleIds.push_back(cellIdOffset + iter->GetCurrentCellId());
+    }
+  }
+  const vtkIdType numTris = static_cast<vtkIdType>(triangleIds.size());
+  if (numPts < 1 || numTris < 1)
+  {
+    vtkDebugMacro(<< "No triangles to decimate");
+    return 1;
+  }
+
+  std::vector<double> points(3 * numPts);
+  double* pointsPtr = points.data();
+  vtkSMPTools::For(0, numPts, [inPts, pointsPtr](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      inPts->GetPoint(ptId, pointsPtr + 3 * ptId);
+    }
+  });
+
+  // The point data is interpolated in place while collapsing the edges: the
+  // numeric arrays concurrently, the others serially.
+  vtkNew<vtkPointData> workPD;
+  workPD->DeepCopy(input->GetPointData());
+  ArrayList workArrays;
+  workArrays.AddSelfInterpolatingArrays(numPts, workPD);
+  std::vector<vtkAbstractArray*> serialArrays;
+  for (int i = 0; i < workPD->GetNumberOfArrays(); ++i)
+  {
+    if (IsSerialArray(workPD->GetAbstractArray(i)))
+    {
+      serialArrays.push_back(workPD->GetAbstractArray(i));
+    }
+  }
+
+  // The attributes of the error metric, scaled by their weights. The
+  // collapses set them to the optimal values instead of interpolating them.
+  QuadricAttributes attributes;
+  attributes.NumberOfComponents = 0;
+  if (this->AttributeErrorMetric)
+  {
+    const vtkTypeBool use[] = { this->ScalarsAttribute, this->VectorsAttribute,
+      this->NormalsAttribute, this->TCoordsAttribute, this->TensorsAttribute };
+    const double weights[] = { this->ScalarsWeight, this->VectorsWeight, this->NormalsWeight,
+      this->TCoordsWeight, this->TensorsWeight };
+    attributes.Select(workPD, use, weights);
+    vtkDebugMacro(<< "Number of attribute components: " << attributes.NumberOfComponents);
+  }
+  const int numComps = attributes.NumberOfComponents;
+  std::vector<double> pointAttributes(numComps * numPts);
+  if (numComps > 0)
+  {
+    double* attributesPtr = pointAttributes.data();
+    const QuadricAttributes* attributesInfo = &attributes;
+    vtkSMPTools::For(
+      0, numPts, [attributesPtr, attributesInfo, numComps](vtkIdType ptId, vtkIdType endPtId) {
+        for (; ptId < endPtId; ++ptId)
+        {
+          attributesInfo->Get(ptId, attributesPtr + numComps * ptId);
+        }
+      });
+  }
+
+  const int quadricSize = GetQuadricSize(numComps);
+  const int targetSize = 3 + numComps + (this->VolumePreservation ? 1 : 0);
+  std::vector<double> quadrics(quadricSize * numPts);
+  std::vector<double> volumes(this->VolumePreservation ? 4 * numPts : 0);
+  TriangleLinks links;
+  links.Build(numPts, triangles.data(), numTris);
+  DecimationMesh mesh = { pointsPtr, quadrics.data(),
+    this->VolumePreservation ? volumes.data() : nullptr, pointAttributes.data(), numComps,
+    quadricSize, targetSize, triangles.data(), &links };
+
+  vtkDebugMacro(<< "Computing Quadrics");
+  {
+    const int stride = quadricSize + (this->VolumePreservation ? 4 : 0);
+    std::vector<double> triangleQuadrics(stride * numTris);
+    ComputeTriangleQuadrics computeTriangles = { &mesh, triangleQuadrics.data(), stride };
+    vtkSMPTools::For(0, numTris, computeTriangles);
+    InitializeQuadrics initialize = { &mesh, triangleQuadrics.data(), stride };
+    vtkSMPTools::For(0, numPts, initialize);
+  }
+  this->UpdateProgress(0.1);
+
+  // Collapse edges in passes until the desired reduction is reached. After
+  // the first pass, the cheapest collapses are only computed again for the
+  // points up to two edges away from the collapsed edges, whose
+  // neighborhoods changed, and the neighborhood minima for the points around
+  // the collapsed edges and the modified cheapest collapses.
+  vtkIdType numToDelete = static_cast<vtkIdType>(this->TargetReduction * numTris);
+  if (numToDelete < this->TargetReduction * numTris)
+  {
+    ++numToDelete;
+  }
+  vtkIdType numCurrentTris = numTris;
+  std::vector<EdgeCollapse> cheapest(numPts);
+  std::vector<double> targets(targetSize * numPts);
+  std::vector<vtkIdType> minimum(numPts);
+  std::vector<unsigned char> modified(numPts, 0);
+  std::vector<unsigned char> moved(numPts, 0);
+  std::vector<unsigned char> marked(numPts, 0);
+  std::vector<vtkIdType> changed(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    cheapest[ptId].Invalidate();
+    minimum[ptId] = ptId;
+    changed[ptId] = ptId;
+  }
+  std::vector<vtkIdType> ring;
+  std::vector<vtkIdType> neighborhoods;
+  std::vector<vtkIdType> seeds;
+  std::vector<vtkIdType> selectable;
+  std::vector<unsigned char> isSelectable(numPts, 0);
+  std::vector<vtkIdType> collapses;
+  std::vector<vtkIdType> linksOffsets;
+  std::vector<CollapseRecord> records;
+  const EdgeCollapse* cheapestPtr = cheapest.data();
+  const vtkIdType* minimumPtr = minimum.data();
+  // An edge can be collapsed when it is the cheapest collapse of both of its
+  // end points and of their neighborhoods.
+  auto canSelect = [cheapestPtr, minimumPtr](const EdgeCollapse& collapse) {
+    return collapse.IsValid() && collapse.SameEdge(cheapestPtr[collapse.V0]) &&
+      collapse.SameEdge(cheapestPtr[collapse.V1]) &&
+      collapse.SameEdge(cheapestPtr[minimumPtr[collapse.V0]]) &&
+      collapse.SameEdge(cheapestPtr[minimumPtr[collapse.V1]]);
+  };
+
+  int abort = 0;
+  while (!abort && numTris - numCurrentTris < numToDelete)
+  {
+    FindCheapestCollapses findCheapest(&mesh, this->MaximumError, changed.data(), moved.data(),
+      cheapest.data(), targets.data(), modified.data());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(changed.size()), findCheapest);
+
+    // The neighborhood minima change around the points remaining from the
+    // collapsed edges (the seeds left by the previous pass) and around the
+    // modified cheapest collapses.
+    for (vtkIdType ptId : changed)
+    {
+      if (modified[ptId])
+      {
+        seeds.push_back(ptId);
+      }
+    }
+    neighborhoods.clear();
+    AddRing(mesh, seeds, marked, neighborhoods);
+    for (vtkIdType ptId : neighborhoods)
+    {
+      marked[ptId] = 0;
+    }
+    FindNeighborhoodMinimum findMinimum = { &mesh, neighborhoods.data(), cheapestPtr,
+      minimum.data() };
+    vtkSMPTools::For(0, static_cast<vtkIdType>(neighborhoods.size()), findMinimum);
+
+    // Update the edges that can be collapsed, which are listed by their
+    // first end point: the ones left from the previous passes may no longer
+    // be, and new ones can only appear where the neighborhood minima were
+    // computed again.
+    size_t numSelectable = 0;
+    for (vtkIdType ptId : selectable)
+    {
+      if (cheapest[ptId].V0 == ptId && canSelect(cheapest[ptId]))
+      {
+        selectable[numSelectable++] = ptId;
+      }
+      else
+      {
+        isSelectable[ptId] = 0;
+      }
+    }
+    selectable.resize(numSelectable);
+    for (vtkIdType ptId : neighborhoods)
+    {
+      const EdgeCollapse& collapse = cheapest[ptId];
+      if (collapse.IsValid() && !isSelectable[collapse.V0] && canSelect(collapse))
+      {
+        isSelectable[collapse.V0] = 1;
+        selectable.push_back(collapse.V0);
+      }
+    }
+    if (selectable.empty())
+    {
+      break;
+    }
+
+    // Only collapse the cheapest of these edges, without going past the
+    // target.
+    const size_t numCandidates = std::max<size_t>(
+      1, static_cast<size_t>(std::ceil(BatchFraction * selectable.size())));
+    std::partial_sort(selectable.begin(), selectable.begin() + numCandidates, selectable.end(),
+      [cheapestPtr](vtkIdType p0, vtkIdType p1) { return cheapestPtr[p0] < cheapestPtr[p1]; });
+    const vtkIdType numRemaining = numToDelete - (numTris - numCurrentTris);
+    vtkIdType numDeleted = 0;
+    size_t numCollapses = 0;
+    while (numCollapses < numCandidates && numDeleted < numRemaining)
+    {
+      numDeleted += cheapest[selectable[numCollapses++]].NumberOfDeletedTriangles;
+    }
+    collapses.assign(selectable.begin(), selectable.begin() + numCollapses);
+    for (vtkIdType ptId : collapses)
+    {
+      isSelectable[ptId] = 0;
+    }
+    selectable.erase(selectable.begin(), selectable.begin() + numCollapses);
+
+    // Reserve the ranges of the links pool receiving the merged triangles.
+    linksOffsets.resize(numCollapses);
+    vtkIdType poolSize = static_cast<vtkIdType>(links.Links.size());
+    for (size_t idx = 0; idx < numCollapses; ++idx)
+    {
+      const EdgeCollapse& collapse = cheapest[collapses[idx]];
+      linksOffsets[idx] = poolSize;
+      poolSize += links.Sizes[collapse.V0] + links.Sizes[collapse.V1];
+    }
+    links.Links.resize(poolSize);
+    records.resize(numCollapses);
+
+    CollapseEdges collapseEdges = { &mesh, targets.data(), collapses.data(), linksOffsets.data(),
+      cheapestPtr, records.data(), &workArrays };
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numCollapses), collapseEdges);
+
+    // Remove the deleted triangles from the points opposite to the edges,
+    // and set the point data that cannot be written concurrently.
+    for (vtkIdType ptId : seeds)
+    {
+      moved[ptId] = 0;
+    }
+    seeds.clear();
+    for (size_t idx = 0; idx < numCollapses; ++idx)
+    {
+      const vtkIdType p0 = cheapest[collapses[idx]].V0;
+      const vtkIdType p1 = cheapest[collapses[idx]].V1;
+      const CollapseRecord& record = records[idx];
+      for (int i = 0; i < record.NumberOfDeletedTriangles; ++i)
+      {
+        vtkIdType* tri = &triangles[3 * record.DeletedTriangles[i]];
+        for (int k = 0; k < 3; ++k)
+        {
+          if (tri[k] != p0 && tri[k] != p1)
+          {
+            links.Remove(tri[k], record.DeletedTriangles[i]);
+          }
+        }
+        tri[0] = -1; // deleted
+      }
+      numCurrentTris -= record.NumberOfDeletedTriangles;
+
+      for (vtkAbstractArray* array : serialArrays)
+      {
+        array->InterpolateTuple(p0, p0, array, p1, array, record.T);
+      }
+      if (numComps > 0)
+      {
+        attributes.Set(p0, &targets[targetSize * p0 + 3]);
+      }
+      cheapest[p1].Invalidate();
+      minimum[p1] = p1;
+      moved[p0] = 1;
+      seeds.push_back(p0);
+    }
+    ++this->NumberOfPasses;
+
+    // The points up to two edges away from the collapsed edges.
+    changed.clear();
+    ring.clear();
+    AddRing(mesh, seeds, marked, changed);
+    AddRing(mesh, changed, marked, ring);
+    changed.insert(changed.end(), ring.begin(), ring.end());
+    for (vtkIdType ptId : changed)
+    {
+      marked[ptId] = 0;
+    }
+
+    vtkDebugMacro(<< "Pass " << this->NumberOfPasses << ": collapsed " << numCollapses
+                  << " edges, " << numCurrentTris << " triangles left");
+    this->UpdateProgress(0.1 + 0.8 * (numTris - numCurrentTris) / numToDelete);
+    abort = this->GetAbortExecute();
+  }
+  this->ActualReduction = static_cast<double>(numTris - numCurrentTris) / numTris;
+
+  // Squeeze out the deleted triangles.
+  numCurrentTris = 0;
+  for (vtkIdType triId = 0; triId < numTris; ++triId)
+  {
+    if (triangles[3 * triId] >= 0)
+    {
+      std::copy_n(&triangles[3 * triId], 3, &triangles[3 * numCurrentTris]);
+      triangleIds[numCurrentTris++] = triangleIds[triId];
+    }
+  }
+
+  // Only the points used by the remaining triangles are passed to the
+  // output, in input order.
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  for (vtkIdType idx = 0; idx < 3 * numCurrentTris; ++idx)
+  {
+    pointMap[triangles[idx]] = 1;
+  }
+  vtkIdType numOutPts = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (pointMap[ptId] > 0)
+    {
+      pointMap[ptId] = numOutPts++;
+    }
+  }
+
+  vtkNew<vtkPoints> outPts;
+  outPts->SetDataType(inPts->GetDataType());
+  outPts->SetNumberOfPoints(numOutPts);
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(workPD, numOutPts);
+  ArrayList outArrays;
+  ArrayList* outArraysPtr = nullptr;
+  if (serialArrays.empty())
+  {
+    outArrays.AddArrays(numOutPts, workPD, outPD, 0.0, false);
+    outArraysPtr = &outArrays;
+  }
+  vtkDataArray* outPtsData = outPts->GetData();
+  const vtkIdType* pointMapPtr = pointMap.data();
+  vtkSMPTools::For(0, numPts,
+    [outPtsData, pointsPtr, pointMapPtr, outArraysPtr](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        const vtkIdType outId = pointMapPtr[ptId];
+        if (outId >= 0)
+        {
+          outPtsData->SetTuple(outId, pointsPtr + 3 * ptId);
+          if (outArraysPtr)
+          {
+            outArraysPtr->Copy(ptId, outId);
+          }
+        }
+      }
+    });
+  if (!outArraysPtr)
+  {
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      if (pointMap[ptId] >= 0)
+      {
+        outPD->CopyData(workPD, ptId, pointMap[ptId]);
+      }
+    }
+  }
+
+  // renormalize the interpolated normals
+  vtkDataArray* normals = outPD->GetNormals();
+  if (normals != nullptr && normals->GetNumberOfComponents() == 3)
+  {
+    vtkSMPTools::For(0, numOutPts, [normals](vtkIdType ptId, vtkIdType endPtId) {
+      double n[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        normals->GetTuple(ptId, n);
+        vtkMath::Normalize(n);
+        normals->SetTuple(ptId, n);
+      }
+    });
+  }
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numCurrentTris + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numCurrentTris);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkIdType* connPtr = connectivity->GetPointer(0);
+  const vtkIdType* trianglesPtr = triangles.data();
+  vtkSMPTools::For(0, numCurrentTris,
+    [offsetsPtr, connPtr, trianglesPtr, pointMapPtr](vtkIdType triId, vtkIdType endTriId) {
+      for (; triId < endTriId; ++triId)
+      {
+        offsetsPtr[triId] = 3 * triId;
+        for (int i = 0; i < 3; ++i)
+        {
+          connPtr[3 * triId + i] = pointMapPtr[trianglesPtr[3 * triId + i]];
+        }
+      }
+    });
+  offsetsPtr[numCurrentTris] = 3 * numCurrentTris;
+  vtkNew<vtkCellArray> outPolys;
+  outPolys->SetData(offsets, connectivity);
+
+  vtkCellData* inCD = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(inCD, numCurrentTris);
+  if (CanCopyConcurrently(inCD))
+  {
+    ArrayList cellArrays;
+    cellArrays.AddArrays(numCurrentTris, inCD, outCD, 0.0, false);
+    const vtkIdType* triangleIdsPtr = triangleIds.data();
+    ArrayList* cellArraysPtr = &cellArrays;
+    vtkSMPTools::For(
+      0, numCurrentTris, [triangleIdsPtr, cellArraysPtr](vtkIdType triId, vtkIdType endTriId) {
+        for (; triId < endTriId; ++triId)
+        {
+          cellArraysPtr->Copy(triangleIdsPtr[triId], triId);
+        }
+      });
+  }
+  else
+  {
+    for (vtkIdType triId = 0; triId < numCurrentTris; ++triId)
+    {
+      outCD->CopyData(inCD, triangleIds[triId], triId);
+    }
+  }
+
+  output->SetPoints(outPts);
+  output->SetPolys(outPolys);
+  output->GetFieldData()->PassData(input->GetFieldData());
+
+  vtkDebugMacro(<< "Decimated " << numTris << " triangles to " << numCurrentTris << " in "
+                << this->NumberOfPasses << " passes");
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Target Reduction: " << this->TargetReduction << "\n";
+  os << indent << "Maximum Error: " << this->MaximumError << "\n";
+  os << indent << "Attribute Error Metric: " << (this->AttributeErrorMetric ? "On\n" : "Off\n");
+  os << indent << "Volume Preservation: " << (this->VolumePreservation ? "On\n" : "Off\n");
+  os << indent << "Scalars Attribute: " << (this->ScalarsAttribute ? "On\n" : "Off\n");
+  os << indent << "Vectors Attribute: " << (this->VectorsAttribute ? "On\n" : "Off\n");
+  os << indent << "Normals Attribute: " << (this->NormalsAttribute ? "On\n" : "Off\n");
+  os << indent << "TCoords Attribute: " << (this->TCoordsAttribute ? "On\n" : "Off\n");
+  os << indent << "Tensors Attribute: " << (this->TensorsAttribute ? "On\n" : "Off\n");
+  os << indent << "Scalars Weight: " << this->ScalarsWeight << "\n";
+  os << indent << "Vectors Weight: " << this->VectorsWeight << "\n";
+  os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
+  os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
+  os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+  os << indent << "Actual Reduction: " << this->ActualReduction << "\n";
+  os << indent << "Number Of Passes: " << this->NumberOfPasses << "\n";
+}
@@ -0,0 +1,201 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedQuadricDecimation.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkThreadedQuadricDecimation
+ * @brief   reduce the number of triangles in a mesh using multiple threads
+ *
+ * vtkThreadedQuadricDecimation reduces the number of triangles in a
+ * triangle mesh using the same quadric error measure as
+ * vtkQuadricDecimation: each vertex carries the area weighted quadric of the
+ * planes of the triangles using it (plus the constraint planes of the
+ * boundary edges), and the cost of collapsing an edge is the quadric error
+ * of the optimal collapse point. Only triangles are treated; use
+ * vtkTriangleFilter first to decimate polygonal meshes.
+ *
+ * Instead of collapsing edges one at a time from a global priority queue,
+ * the filter proceeds in passes. Every vertex first computes in parallel the
+ * cheapest edge it can collapse. An edge can then be collapsed when it is
+ * cheaper than the cheapest edges of all the vertices around its end points;
+ * such edges are far enough apart that they can be collapsed concurrently
+ * without any locking. Each pass collapses the cheapest of them, then only
+ * computes again the cheapest edges of the vertices whose neighborhood
+ * changed. The passes repeat until the target reduction is reached, or until
+ * no edge can be collapsed. The result does not depend on the number of
+ * threads.
+ *
+ * Edges are only collapsed when the topology of the mesh is preserved (the
+ * link condition holds, boundaries are not pinched) and when no triangle is
+ * flipped by the new point location. The MaximumError bound further prevents
+ * the collapse of edges whose error, expressed as a distance, is too large.
+ *
+ * The point data is interpolated along the collapsed edges, and the cell data
+ * of the triangles that are kept is passed to the output. As in
+ * vtkQuadricDecimation, the point attributes can be included in the error
+ * measure (AttributeErrorMetric), in which case the collapses set them to
+ * their optimal values, and the volume of the mesh can be preserved
+ * (VolumePreservation).
+ *
+ * @sa
+ * vtkQuadricDecimation vtkDecimatePro
+ */
+
+#ifndef vtkThreadedQuadricDecimation_h
+#define vtkThreadedQuadricDecimation_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkPolyDataAlgorithm.h"
+
+class VTKFILTERSCORE_EXPORT vtkThreadedQuadricDecimation : public vtkPolyDataAlgorithm
+{
+public:
+  vtkTypeMacro(vtkThreadedQuadricDecimation, vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkThreadedQuadricDecimation* New();
+
+  ///@{
+  /**
+   * Set/Get the desired reduction (expressed as a fraction of the original
+   * number of triangles). The actual reduction may be less depending on
+   * triangulation, topological constraints and the maximum error.
+   */
+  vtkSetClampMacro(TargetReduction, double, 0.0, 1.0);
+  vtkGetMacro(TargetReduction, double);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum error allowed for an edge collapse. The error is the
+   * root mean square distance from the collapse point to the planes
+   * accumulated in the quadrics of the edge end points, in world units. By
+   * default there is no bound (VTK_DOUBLE_MAX).
+   */
+  vtkSetClampMacro(MaximumError, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(MaximumError, double);
+  ///@}
+
+  ///@{
+  /**
+   * Decide whether to include data attributes in the error metric. If off,
+   * then only geometric error is used to control the decimation. By default
+   * the attribute errors are off. The error bounded by MaximumError then
+   * includes the weighted attribute errors.
+   */
+  vtkSetMacro(AttributeErrorMetric, vtkTypeBool);
+  vtkGetMacro(AttributeErrorMetric, vtkTypeBool);
+  vtkBooleanMacro(AttributeErrorMetric, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Decide whether to activate volume preservation which greatly reduces
+   * errors in triangle normal direction. If off, volume preservation is
+   * disabled and if AttributeErrorMetric is active, these errors can be
+   * large. By default VolumePreservation is off.
+   */
+  vtkSetMacro(VolumePreservation, vtkTypeBool);
+  vtkGetMacro(VolumePreservation, vtkTypeBool);
+  vtkBooleanMacro(VolumePreservation, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * If attribute errors are to be included in the metric (i.e.,
+   * AttributeErrorMetric is on), then the following flags control which
+   * attributes are to be included in the error calculation. By default all
+   * of these are on.
+   */
+  vtkSetMacro(ScalarsAttribute, vtkTypeBool);
+  vtkGetMacro(ScalarsAttribute, vtkTypeBool);
+  vtkBooleanMacro(ScalarsAttribute, vtkTypeBool);
+  vtkSetMacro(VectorsAttribute, vtkTypeBool);
+  vtkGetMacro(VectorsAttribute, vtkTypeBool);
+  vtkBooleanMacro(VectorsAttribute, vtkTypeBool);
+  vtkSetMacro(NormalsAttribute, vtkTypeBool);
+  vtkGetMacro(NormalsAttribute, vtkTypeBool);
+  vtkBooleanMacro(NormalsAttribute, vtkTypeBool);
+  vtkSetMacro(TCoordsAttribute, vtkTypeBool);
+  vtkGetMacro(TCoordsAttribute, vtkTypeBool);
+  vtkBooleanMacro(TCoordsAttribute, vtkTypeBool);
+  vtkSetMacro(TensorsAttribute, vtkTypeBool);
+  vtkGetMacro(TensorsAttribute, vtkTypeBool);
+  vtkBooleanMacro(TensorsAttribute, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the scaling weight contribution of the attribute. These
+   * values are used to weight the contribution of the attributes
+   * towards the error metric.
+   */
+  vtkSetMacro(ScalarsWeight, double);
+  vtkSetMacro(VectorsWeight, double);
+  vtkSetMacro(NormalsWeight, double);
+  vtkSetMacro(TCoordsWeight, double);
+  vtkSetMacro(TensorsWeight, double);
+  vtkGetMacro(ScalarsWeight, double);
+  vtkGetMacro(VectorsWeight, double);
+  vtkGetMacro(NormalsWeight, double);
+  vtkGetMacro(TCoordsWeight, double);
+  vtkGetMacro(TensorsWeight, double);
+  ///@}
+
+  ///@{
+  /**
+   * Get the actual reduction. This value is only valid after the
+   * filter has executed.
+   */
+  vtkGetMacro(ActualReduction, double);
+  ///@}
+
+  ///@{
+  /**
+   * Get the number of passes of parallel edge collapses performed during the
+   * last execution.
+   */
+  vtkGetMacro(NumberOfPasses, int);
+  ///@}
+
+protected:
+  vtkThreadedQuadricDecimation();
+  ~vtkThreadedQuadricDecimation() override = default;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  double TargetReduction;
+  double MaximumError;
+  vtkTypeBool AttributeErrorMetric;
+  vtkTypeBool VolumePreservation;
+
+  vtkTypeBool ScalarsAttribute;
+  vtkTypeBool VectorsAttribute;
+  vtkTypeBool NormalsAttribute;
+  vtkTypeBool TCoordsAttribute;
+  vtkTypeBool TensorsAttribute;
+
+  double ScalarsWeight;
+  double VectorsWeight;
+  double NormalsWeight;
+  double TCoordsWeight;
+  double TensorsWeight;
+
+  double ActualReduction;
+  int NumberOfPasses;
+
+private:
+  vtkThreadedQuadricDecimation(const vtkThreadedQuadricDecimation&) = delete;
+  void operator=(const vtkThreadedQuadricDecimation&) = delete;
+};
+
+#endif
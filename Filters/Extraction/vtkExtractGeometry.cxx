@@ -18,6 +18,7 @@
 #include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
+#include "vtkDoubleArray.h"
 #include "vtkEventForwarderCommand.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -28,6 +29,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -162,13 +164,31 @@ int vtkExtractGeometry::RequestData(
   outputCD->CopyAllocate(cd);
   vtkFloatArray* newScalars = nullptr;
 
-  if (!this->ExtractBoundaryCells)
+  // Evaluate the implicit function over all the points at once when they are
+  // explicit.
+  vtkNew<vtkDoubleArray> values;
+  vtkPointSet* pointSet = vtkPointSet::SafeDownCast(input);
+  if (pointSet && pointSet->GetPoints())
+  {
+    this->ImplicitFunction->FunctionValue(pointSet->GetPoints()->GetData(), values);
+  }
+  else
   {
+    values->SetNumberOfTuples(numPts);
     for (ptId = 0; ptId < numPts; ptId++)
     {
       input->GetPoint(ptId, x);
-      if ((this->ImplicitFunction->FunctionValue(x) * multiplier) < 0.0)
+      values->SetValue(ptId, this->ImplicitFunction->FunctionValue(x));
+    }
+  }
+
+  if (!this->ExtractBoundaryCells)
+  {
+    for (ptId = 0; ptId < numPts; ptId++)
+    {
+      if ((values->GetValue(ptId) * multiplier) < 0.0)
       {
+        input->GetPoint(ptId, x);
         newId = newPts->InsertNextPoint(x);
         pointMap[ptId] = newId;
         outputPD->CopyData(pd, ptId, newId);
@@ -184,8 +204,7 @@ int vtkExtractGeometry::RequestData(
 
     for (ptId = 0; ptId < numPts; ptId++)
     {
-      input->GetPoint(ptId, x);
-      val = this->ImplicitFunction->FunctionValue(x) * multiplier;
+      val = values->GetValue(ptId) * multiplier;
       newScalars->SetValue(ptId, val);
     }
   }
@@ -0,0 +1,368 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTableBasedClipDataSet.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Clip an unstructured grid of hexahedra with vtkTableBasedClipDataSet and
+// check the clipped volume, the cell data and that the output does not
+// depend on the number of threads nor on the batch size. Bit and string
+// arrays, which cannot be copied concurrently, must be copied too.
+
+#include <vtkBitArray.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDataSetTriangleFilter.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkNew.h>
+#include <vtkPlane.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkSMPTools.h>
+#include <vtkStringArray.h>
+#include <vtkTableBasedClipDataSet.h>
+#include <vtkTetra.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+const int Resolution = 10;
+
+void MakeHexahedra(vtkUnstructuredGrid* grid)
+{
+  const int dim = Resolution + 1;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> xCoords;
+  xCoords->SetName("X");
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        const double x = static_cast<double>(i) / Resolution;
+        points->InsertNextPoint(x, static_cast<double>(j) / Resolution,
+          static_cast<double>(k) / Resolution);
+        xCoords->InsertNextValue(x);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(xCoords);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellId");
+  grid->Allocate(Resolution * Resolution * Resolution);
+  for (int k = 0; k < Resolution; ++k)
+  {
+    for (int j = 0; j < Resolution; ++j)
+    {
+      for (int i = 0; i < Resolution; ++i)
+      {
+        const vtkIdType p = i + dim * (j + dim * k);
+        const vtkIdType hex[8] = { p, p + 1, p + 1 + dim, p + dim, p + dim * dim,
+          p + 1 + dim * dim, p + 1 + dim + dim * dim, p + dim + dim * dim };
+        cellIds->InsertNextValue(grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex));
+      }
+    }
+  }
+  grid->GetCellData()->AddArray(cellIds);
+}
+
+void Clip(vtkUnstructuredGrid* input, unsigned int batchSize, vtkUnstructuredGrid* output)
+{
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.35, 0.5, 0.5);
+  plane->SetNormal(1.0, 1.0, 0.0);
+
+  vtkNew<vtkTableBasedClipDataSet> clipper;
+  clipper->SetInputData(input);
+  clipper->SetClipFunction(plane);
+  clipper->SetBatchSize(batchSize);
+  clipper->Update();
+  output->ShallowCopy(clipper->GetOutput());
+}
+
+bool SameValues(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  for (vtkIdType idx = 0; idx < a->GetNumberOfValues(); ++idx)
+  {
+    if (a->GetComponent(idx, 0) != b->GetComponent(idx, 0))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < a->GetNumberOfPoints(); ++ptId)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(ptId, pa);
+    b->GetPoint(ptId, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+    {
+      return false;
+    }
+  }
+  return SameValues(
+           a->GetCells()->GetConnectivityArray(), b->GetCells()->GetConnectivityArray()) &&
+    SameValues(a->GetCells()->GetOffsetsArray(), b->GetCells()->GetOffsetsArray()) &&
+    SameValues(a->GetCellTypesArray(), b->GetCellTypesArray());
+}
+
+bool SameStrings(vtkAbstractArray* a, vtkAbstractArray* b)
+{
+  vtkStringArray* stringsA = vtkStringArray::SafeDownCast(a);
+  vtkStringArray* stringsB = vtkStringArray::SafeDownCast(b);
+  if (!stringsA || !stringsB || stringsA->GetNumberOfValues() != stringsB->GetNumberOfValues())
+  {
+    return false;
+  }
+  for (vtkIdType idx = 0; idx < stringsA->GetNumberOfValues(); ++idx)
+  {
+    if (stringsA->GetValue(idx) != stringsB->GetValue(idx))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestBitAndStringArrays()
+{
+  // Bit and string arrays in the point data and in the cell data, next to
+  // the numeric ones
+  vtkNew<vtkUnstructuredGrid> hexahedra;
+  MakeHexahedra(hexahedra);
+  vtkNew<vtkBitArray> pointBits;
+  pointBits->SetName("PointBits");
+  vtkNew<vtkStringArray> pointNames;
+  pointNames->SetName("PointNames");
+  for (vtkIdType ptId = 0; ptId < hexahedra->GetNumberOfPoints(); ++ptId)
+  {
+    pointBits->InsertNextValue(ptId % 3 == 0);
+    pointNames->InsertNextValue("p" + std::to_string(ptId));
+  }
+  hexahedra->GetPointData()->AddArray(pointBits);
+  hexahedra->GetPointData()->AddArray(pointNames);
+  vtkNew<vtkBitArray> cellBits;
+  cellBits->SetName("CellBits");
+  vtkNew<vtkStringArray> cellNames;
+  cellNames->SetName("CellNames");
+  for (vtkIdType cellId = 0; cellId < hexahedra->GetNumberOfCells(); ++cellId)
+  {
+    cellBits->InsertNextValue(cellId % 3 == 1);
+    cellNames->InsertNextValue("c" + std::to_string(cellId));
+  }
+  hexahedra->GetCellData()->AddArray(cellBits);
+  hexahedra->GetCellData()->AddArray(cellNames);
+
+  vtkNew<vtkUnstructuredGrid> clipped;
+  Clip(hexahedra, 10000, clipped);
+  vtkNew<vtkUnstructuredGrid> smallBatches;
+  Clip(hexahedra, 7, smallBatches);
+  vtkNew<vtkUnstructuredGrid> serial;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { Clip(hexahedra, 10000, serial); });
+  for (vtkUnstructuredGrid* other : { smallBatches.GetPointer(), serial.GetPointer() })
+  {
+    if (!SameOutput(clipped, other) ||
+      !SameValues(clipped->GetPointData()->GetArray("PointBits"),
+        other->GetPointData()->GetArray("PointBits")) ||
+      !SameStrings(clipped->GetPointData()->GetAbstractArray("PointNames"),
+        other->GetPointData()->GetAbstractArray("PointNames")))
+    {
+      std::cerr << "Output with bit and string arrays depends on the batch size or the number "
+                   "of threads"
+                << std::endl;
+      return false;
+    }
+  }
+
+  vtkBitArray* outPointBits =
+    vtkBitArray::SafeDownCast(clipped->GetPointData()->GetAbstractArray("PointBits"));
+  vtkStringArray* outPointNames =
+    vtkStringArray::SafeDownCast(clipped->GetPointData()->GetAbstractArray("PointNames"));
+  vtkBitArray* outCellBits =
+    vtkBitArray::SafeDownCast(clipped->GetCellData()->GetAbstractArray("CellBits"));
+  vtkStringArray* outCellNames =
+    vtkStringArray::SafeDownCast(clipped->GetCellData()->GetAbstractArray("CellNames"));
+  vtkDataArray* cellIds = clipped->GetCellData()->GetArray("CellId");
+  if (!outPointBits || !outPointNames || !outCellBits || !outCellNames || !cellIds ||
+    outPointBits->GetNumberOfValues() != clipped->GetNumberOfPoints() ||
+    outPointNames->GetNumberOfValues() != clipped->GetNumberOfPoints() ||
+    outCellBits->GetNumberOfValues() != clipped->GetNumberOfCells() ||
+    outCellNames->GetNumberOfValues() != clipped->GetNumberOfCells())
+  {
+    std::cerr << "Missing bit or string arrays" << std::endl;
+    return false;
+  }
+
+  // The output points at the nodes of the grid are copies of input points.
+  const int dim = Resolution + 1;
+  vtkIdType numCopies = 0;
+  for (vtkIdType ptId = 0; ptId < clipped->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    clipped->GetPoint(ptId, x);
+    vtkIdType inPtId = 0;
+    bool node = true;
+    for (int i = 2; i >= 0; --i)
+    {
+      const double index = std::round(x[i] * Resolution);
+      node = node && std::abs(x[i] * Resolution - index) < 1e-9;
+      inPtId = inPtId * dim + static_cast<vtkIdType>(index);
+    }
+    if (!node)
+    {
+      continue;
+    }
+    ++numCopies;
+    if (outPointBits->GetValue(ptId) != (inPtId % 3 == 0) ||
+      outPointNames->GetValue(ptId) != "p" + std::to_string(inPtId))
+    {
+      std::cerr << "Wrong bit or string value of point " << ptId << std::endl;
+      return false;
+    }
+  }
+  if (numCopies == 0 || numCopies == clipped->GetNumberOfPoints())
+  {
+    std::cerr << "Expected both copied and interpolated points" << std::endl;
+    return false;
+  }
+
+  for (vtkIdType cellId = 0; cellId < clipped->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType inputId = static_cast<vtkIdType>(cellIds->GetComponent(cellId, 0));
+    if (outCellBits->GetValue(cellId) != (inputId % 3 == 1) ||
+      outCellNames->GetValue(cellId) != "c" + std::to_string(inputId))
+    {
+      std::cerr << "Wrong bit or string value of cell " << cellId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestTableBasedClipDataSet(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> hexahedra;
+  MakeHexahedra(hexahedra);
+
+  vtkNew<vtkUnstructuredGrid> clipped;
+  Clip(hexahedra, 10000, clipped);
+
+  // The plane goes through the middle of cells, so all kinds of clip cases
+  // show up: the volume on the positive side of the plane is known.
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputData(clipped);
+  tetrahedralize->Update();
+  vtkUnstructuredGrid* tetras = tetrahedralize->GetOutput();
+  double volume = 0.0;
+  double p[4][3];
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < tetras->GetNumberOfCells(); ++cellId)
+  {
+    tetras->GetCellPoints(cellId, npts, pts);
+    for (int i = 0; i < 4; ++i)
+    {
+      tetras->GetPoint(pts[i], p[i]);
+    }
+    volume += std::abs(vtkTetra::ComputeVolume(p[0], p[1], p[2], p[3]));
+  }
+  // The plane x + y = 0.85 cuts the triangle x + y < 0.85 out of the square.
+  const double expectedVolume = 1.0 - 0.5 * 0.85 * 0.85;
+  if (std::abs(volume - expectedVolume) > 1e-10)
+  {
+    std::cerr << "Wrong clipped volume " << volume << ", expected " << expectedVolume << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Point data is interpolated on the clip edges.
+  vtkDataArray* xCoords = clipped->GetPointData()->GetArray("X");
+  if (!xCoords || xCoords->GetNumberOfTuples() != clipped->GetNumberOfPoints())
+  {
+    std::cerr << "Missing interpolated point data" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType ptId = 0; ptId < clipped->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    clipped->GetPoint(ptId, x);
+    if (std::abs(x[0] - xCoords->GetComponent(ptId, 0)) > 1e-10 || x[0] + x[1] < 0.85 - 1e-10)
+    {
+      std::cerr << "Wrong output point " << ptId << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Cell data is copied from the cell each output cell comes from, and the
+  // output cells follow the order of the input cells.
+  vtkDataArray* cellIds = clipped->GetCellData()->GetArray("CellId");
+  if (!cellIds || cellIds->GetNumberOfTuples() != clipped->GetNumberOfCells())
+  {
+    std::cerr << "Missing cell data" << std::endl;
+    return EXIT_FAILURE;
+  }
+  double lastId = -1.0;
+  for (vtkIdType cellId = 0; cellId < clipped->GetNumberOfCells(); ++cellId)
+  {
+    const double inputId = cellIds->GetComponent(cellId, 0);
+    double bounds[6], inputBounds[6];
+    clipped->GetCellBounds(cellId, bounds);
+    hexahedra->GetCellBounds(static_cast<vtkIdType>(inputId), inputBounds);
+    if (inputId < lastId || bounds[0] < inputBounds[0] - 1e-10 ||
+      bounds[1] > inputBounds[1] + 1e-10 || bounds[2] < inputBounds[2] - 1e-10 ||
+      bounds[3] > inputBounds[3] + 1e-10)
+    {
+      std::cerr << "Wrong cell data for output cell " << cellId << std::endl;
+      return EXIT_FAILURE;
+    }
+    lastId = inputId;
+  }
+
+  // The output must not depend on the batch size nor on the number of threads.
+  vtkNew<vtkUnstructuredGrid> smallBatches;
+  Clip(hexahedra, 7, smallBatches);
+  vtkNew<vtkUnstructuredGrid> serial;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { Clip(hexahedra, 10000, serial); });
+  if (!SameOutput(clipped, smallBatches) || !SameOutput(clipped, serial))
+  {
+    std::cerr << "Output depends on the batch size or the number of threads" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!TestBitAndStringArrays())
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
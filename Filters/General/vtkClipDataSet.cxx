@@ -19,6 +19,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkClipVolume.h"
+#include "vtkDoubleArray.h"
 #include "vtkExecutive.h"
 #include "vtkFloatArray.h"
 #include "vtkGenericCell.h"
@@ -29,9 +30,11 @@
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
 #include "vtkPolyhedron.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -306,10 +309,18 @@ int vtkClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
     {
       inPD->SetScalars(tmpScalars);
     }
-    for (i = 0; i < numPts; i++)
+    vtkPointSet* pointSet = vtkPointSet::SafeDownCast(input);
+    if (pointSet && pointSet->GetPoints())
     {
-      s = this->ClipFunction->FunctionValue(input->GetPoint(i));
-      tmpScalars->SetTuple1(i, s);
+      this->ClipFunction->FunctionValue(pointSet->GetPoints()->GetData(), tmpScalars);
+    }
+    else
+    {
+      for (i = 0; i < numPts; i++)
+      {
+        s = this->ClipFunction->FunctionValue(input->GetPoint(i));
+        tmpScalars->SetTuple1(i, s);
+      }
     }
     clipScalars = tmpScalars;
   }
@@ -504,13 +515,35 @@ int vtkClipDataSet::ClipPoints(
   {
     value = this->Value;
   }
+  vtkDataArray* clipScalars = nullptr;
+  vtkNew<vtkDoubleArray> functionValues;
   if (this->ClipFunction)
+  {
+    vtkPointSet* pointSet = vtkPointSet::SafeDownCast(input);
+    if (pointSet && pointSet->GetPoints())
+    {
+      this->ClipFunction->FunctionValue(pointSet->GetPoints()->GetData(), functionValues);
+    }
+    else
+    {
+      functionValues->SetNumberOfTuples(numPts);
+      for (vtkIdType i = 0; i < numPts; i++)
+      {
+        functionValues->SetValue(i, this->ClipFunction->FunctionValue(input->GetPoint(i)));
+      }
+    }
+    clipScalars = functionValues;
+  }
+  else
+  {
+    clipScalars = this->GetInputArrayToProcess(0, inputVector);
+  }
+  if (clipScalars)
   {
     for (vtkIdType i = 0; i < numPts; i++)
     {
-      double* pt = input->GetPoint(i);
-      double fv = this->ClipFunction->FunctionValue(pt);
       int addPoint = 0;
+      double fv = clipScalars->GetTuple1(i);
       if (this->InsideOut)
       {
         if (fv <= value)
@@ -532,37 +565,6 @@ int vtkClipDataSet::ClipPoints(
       }
     }
   }
-  else
-  {
-    vtkDataArray* clipScalars = this->GetInputArrayToProcess(0, inputVector);
-    if (clipScalars)
-    {
-      for (vtkIdType i = 0; i < numPts; i++)
-      {
-        int addPoint = 0;
-        double fv = clipScalars->GetTuple1(i);
-        if (this->InsideOut)
-        {
-          if (fv <= value)
-          {
-            addPoint = 1;
-          }
-        }
-        else
-        {
-          if (fv > value)
-          {
-            addPoint = 1;
-          }
-        }
-        if (addPoint)
-        {
-          vtkIdType id = outPoints->InsertNextPoint(input->GetPoint(i));
-          outPD->CopyData(inPD, i, id);
-        }
-      }
-    }
-  }
 
   output->SetPoints(outPoints);
   outPoints->Delete();
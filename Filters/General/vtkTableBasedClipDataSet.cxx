@@ -33,6 +33,7 @@
 #include "vtkExecutive.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -45,18 +46,29 @@
 #include "vtkPlane.h"
 
 #include "vtkAppendFilter.h"
+#include "vtkArrayDispatch.h"
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <vector>
+
 // NOLINTNEXTLINE(bugprone-suspicious-include)
 #include "vtkTableBasedClipCases.cxx"
 
@@ -1543,6 +1555,635 @@ inline void GetPoint(
 // =============== vtkTableBasedClipperVolumeFromVolume ( end ) ===============
 // ============================================================================
 
+// ============================================================================
+// =========== Threaded clipping of unstructured grids (begin) ================
+// ============================================================================
+
+namespace
+{
+typedef const int TableBasedClipperEdgeVertices[2];
+
+//------------------------------------------------------------------------------
+// Return whether the cell type is handled by the clip tables. The other cells
+// are handed over to vtkClipDataSet.
+bool CanClipCellType(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_TETRA:
+    case VTK_PYRAMID:
+    case VTK_WEDGE:
+    case VTK_HEXAHEDRON:
+    case VTK_VOXEL:
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_PIXEL:
+    case VTK_LINE:
+    case VTK_VERTEX:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Look up the output shapes of a clip case: returns the shape description,
+// the number of shapes and the cell vertices defining the cell edges.
+const unsigned char* GetClipCase(
+  int cellType, int caseIndx, int& nOutputs, TableBasedClipperEdgeVertices*& edgeVtxs)
+{
+  int startIdx = 0;
+  const unsigned char* thisCase = nullptr;
+  nOutputs = 0;
+  edgeVtxs = nullptr;
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesTet[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[caseIndx];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
+      break;
+
+    case VTK_PYRAMID:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesPyr[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[caseIndx];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
+      break;
+
+    case VTK_WEDGE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesWdg[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[caseIndx];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
+      break;
+
+    case VTK_HEXAHEDRON:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
+      break;
+
+    case VTK_VOXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesVox[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[caseIndx];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
+      break;
+
+    case VTK_TRIANGLE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesTri[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[caseIndx];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
+      break;
+
+    case VTK_QUAD:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
+      break;
+
+    case VTK_PIXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesPix[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[caseIndx];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
+      break;
+
+    case VTK_LINE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesLin[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[caseIndx];
+      edgeVtxs = vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
+      break;
+
+    case VTK_VERTEX:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesVtx[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[caseIndx];
+      break;
+  }
+  return thisCase;
+}
+
+//------------------------------------------------------------------------------
+// Decode the header of the next output shape of a clip case. Returns the
+// number of points of the shape and advances thisCase to the point codes.
+int GetShapeHeader(const unsigned char*& thisCase, unsigned char& theShape, int& theColor,
+  int& intrpIdx, int& vtkType)
+{
+  int nCellPts = 0;
+  intrpIdx = -1;
+  vtkType = VTK_EMPTY_CELL;
+  theShape = *thisCase++;
+  switch (theShape)
+  {
+    case ST_HEX:
+      nCellPts = 8;
+      vtkType = VTK_HEXAHEDRON;
+      break;
+    case ST_WDG:
+      nCellPts = 6;
+      vtkType = VTK_WEDGE;
+      break;
+    case ST_PYR:
+      nCellPts = 5;
+      vtkType = VTK_PYRAMID;
+      break;
+    case ST_TET:
+      nCellPts = 4;
+      vtkType = VTK_TETRA;
+      break;
+    case ST_QUA:
+      nCellPts = 4;
+      vtkType = VTK_QUAD;
+      break;
+    case ST_TRI:
+      nCellPts = 3;
+      vtkType = VTK_TRIANGLE;
+      break;
+    case ST_LIN:
+      nCellPts = 2;
+      vtkType = VTK_LINE;
+      break;
+    case ST_VTX:
+      nCellPts = 1;
+      vtkType = VTK_VERTEX;
+      break;
+    case ST_PNT:
+      intrpIdx = *thisCase++;
+      theColor = *thisCase++;
+      return *thisCase++;
+    default:
+      theColor = -1;
+      return -1;
+  }
+  theColor = *thisCase++;
+  return nCellPts;
+}
+
+//------------------------------------------------------------------------------
+// Compute the clip case of a cell from the (offset) clip scalars.
+int ComputeClipCase(vtkIdType npts, const vtkIdType* pts, const double* scalars)
+{
+  int caseIndx = 0;
+  for (vtkIdType j = npts - 1; j >= 0; j--)
+  {
+    caseIndx += ((scalars[pts[j]] >= 0.0) ? 1 : 0);
+    caseIndx <<= (1 - (!j));
+  }
+  return caseIndx;
+}
+
+// The output size of a batch of input cells, accumulated in the first pass.
+// A prefix sum then turns the sizes into the offsets at which the batch
+// writes its output in the second pass.
+struct TableBasedClipperBatch
+{
+  vtkIdType NumberOfCells;
+  vtkIdType ConnectivitySize;
+  vtkIdType NumberOfEdges;
+  vtkIdType NumberOfCentroids;
+  vtkIdType CentroidConnectivitySize;
+  vtkIdType NumberOfSpecials;
+};
+
+// Clip edges record where the point generated on the edge is referenced:
+// ConnIdx >= 0 is an index in the cell connectivity, ConnIdx < 0 is an index
+// (-1 - ConnIdx) in the connectivity of the centroid points.
+struct TableBasedClipperEdgeData
+{
+  vtkIdType ConnIdx;
+};
+using TableBasedClipperEdgeTuple = EdgeTuple<vtkIdType, TableBasedClipperEdgeData>;
+using TableBasedClipperEdgeLocator =
+  vtkStaticEdgeLocatorTemplate<vtkIdType, TableBasedClipperEdgeData>;
+
+//------------------------------------------------------------------------------
+// Whether the arrays can be copied by ArrayList from several threads: the
+// array list skips non-numeric arrays, and bit arrays share bytes between
+// their values. Otherwise the attributes are copied serially.
+bool CanCopyConcurrently(vtkDataSetAttributes* attributes)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = attributes->GetAbstractArray(i);
+    if (!vtkArrayDownCast<vtkDataArray>(array) || array->GetDataType() == VTK_BIT)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The parametric coordinate of the clip point on an edge.
+double EdgeParameter(const TableBasedClipperEdgeTuple& edge, const double* scalars)
+{
+  const double s0 = scalars[edge.V0];
+  const double delta = scalars[edge.V1] - s0;
+  return (delta == 0.0 ? 0.0 : -s0 / delta);
+}
+
+//------------------------------------------------------------------------------
+// Evaluate the clip scalars at the points, offset by the iso value.
+struct EvaluateClipScalars
+{
+  vtkDataArray* ClipArray;
+  double IsoValue;
+  double* Scalars;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for (; ptId < endPtId; ++ptId)
+    {
+      this->Scalars[ptId] = this->ClipArray->GetComponent(ptId, 0) - this->IsoValue;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// First pass: compute the clip case of each cell and count, per batch of
+// cells, the size of the output.
+struct ClassifyCells
+{
+  vtkUnstructuredGrid* Input;
+  const double* Scalars;
+  bool InsideOut;
+  vtkIdType NumberOfCells;
+  vtkIdType BatchSize;
+  int* CellCases;
+  TableBasedClipperBatch* Batches;
+  vtkSMPThreadLocalObject<vtkIdList> CellPointIds;
+
+  ClassifyCells(vtkUnstructuredGrid* input, const double* scalars, bool insideOut,
+    vtkIdType batchSize, int* cellCases, TableBasedClipperBatch* batches)
+    : Input(input)
+    , Scalars(scalars)
+    , InsideOut(insideOut)
+    , NumberOfCells(input->GetNumberOfCells())
+    , BatchSize(batchSize)
+    , CellCases(cellCases)
+    , Batches(batches)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType batchId, vtkIdType endBatchId)
+  {
+    vtkIdList*& ptIds = this->CellPointIds.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; batchId < endBatchId; ++batchId)
+    {
+      TableBasedClipperBatch& batch = this->Batches[batchId];
+      batch = TableBasedClipperBatch();
+      vtkIdType cellId = batchId * this->BatchSize;
+      const vtkIdType endCellId = std::min(cellId + this->BatchSize, this->NumberOfCells);
+      for (; cellId < endCellId; ++cellId)
+      {
+        const int cellType = this->Input->GetCellType(cellId);
+        if (!CanClipCellType(cellType))
+        {
+          this->CellCases[cellId] = -1;
+          batch.NumberOfSpecials++;
+          continue;
+        }
+
+        this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+        const int caseIndx = ComputeClipCase(npts, pts, this->Scalars);
+        this->CellCases[cellId] = caseIndx;
+
+        int nOutputs;
+        TableBasedClipperEdgeVertices* edgeVtxs;
+        const unsigned char* thisCase = GetClipCase(cellType, caseIndx, nOutputs, edgeVtxs);
+        for (int j = 0; j < nOutputs; j++)
+        {
+          unsigned char theShape;
+          int theColor, intrpIdx, vtkType;
+          const int nCellPts = GetShapeHeader(thisCase, theShape, theColor, intrpIdx, vtkType);
+          if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
+          {
+            // We don't want this one; it's the wrong side.
+            thisCase += nCellPts;
+            continue;
+          }
+
+          for (int p = 0; p < nCellPts; p++)
+          {
+            const unsigned char pntIndex = *thisCase++;
+            if (pntIndex >= EA && pntIndex <= EL)
+            {
+              batch.NumberOfEdges++;
+            }
+          }
+          if (theShape == ST_PNT)
+          {
+            batch.NumberOfCentroids++;
+            batch.CentroidConnectivitySize += nCellPts;
+          }
+          else
+          {
+            batch.NumberOfCells++;
+            batch.ConnectivitySize += nCellPts;
+          }
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Second pass: write the output cells of each batch at the offsets computed
+// by the prefix sum. The connectivity refers to input point ids (to be
+// renumbered), to centroid points (encoded as negative ids) or to clip edges
+// (recorded in the edge array, and filled in once the edges are merged).
+// The cell data is copied by CellArrays, or the input cell of each output
+// cell is recorded in CellSources to copy it serially.
+struct GenerateCells
+{
+  vtkUnstructuredGrid* Input;
+  const int* CellCases;
+  bool InsideOut;
+  vtkIdType NumberOfCells;
+  vtkIdType BatchSize;
+  const TableBasedClipperBatch* Batches;
+  vtkIdType EdgePlaceholder;
+  unsigned char* Types;
+  vtkIdType* Offsets;
+  vtkIdType* Connectivity;
+  vtkIdType* CentroidOffsets;
+  vtkIdType* CentroidConnectivity;
+  TableBasedClipperEdgeTuple* Edges;
+  ArrayList* CellArrays;
+  vtkIdType* CellSources;
+  vtkSMPThreadLocalObject<vtkIdList> CellPointIds;
+
+  GenerateCells(vtkUnstructuredGrid* input, const int* cellCases, bool insideOut,
+    vtkIdType batchSize, const TableBasedClipperBatch* batches, unsigned char* types,
+    vtkIdType* offsets, vtkIdType* connectivity, vtkIdType* centroidOffsets,
+    vtkIdType* centroidConnectivity, TableBasedClipperEdgeTuple* edges, ArrayList* cellArrays,
+    vtkIdType* cellSources)
+    : Input(input)
+    , CellCases(cellCases)
+    , InsideOut(insideOut)
+    , NumberOfCells(input->GetNumberOfCells())
+    , BatchSize(batchSize)
+    , Batches(batches)
+    , EdgePlaceholder(input->GetNumberOfPoints())
+    , Types(types)
+    , Offsets(offsets)
+    , Connectivity(connectivity)
+    , CentroidOffsets(centroidOffsets)
+    , CentroidConnectivity(centroidConnectivity)
+    , Edges(edges)
+    , CellArrays(cellArrays)
+    , CellSources(cellSources)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType batchId, vtkIdType endBatchId)
+  {
+    vtkIdList*& ptIds = this->CellPointIds.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; batchId < endBatchId; ++batchId)
+    {
+      const TableBasedClipperBatch& batch = this->Batches[batchId];
+      vtkIdType outCellId = batch.NumberOfCells;
+      vtkIdType connIdx = batch.ConnectivitySize;
+      TableBasedClipperEdgeTuple* edge = this->Edges + batch.NumberOfEdges;
+      vtkIdType centroidId = batch.NumberOfCentroids;
+      vtkIdType centroidConnIdx = batch.CentroidConnectivitySize;
+
+      vtkIdType cellId = batchId * this->BatchSize;
+      const vtkIdType endCellId = std::min(cellId + this->BatchSize, this->NumberOfCells);
+      for (; cellId < endCellId; ++cellId)
+      {
+        const int caseIndx = this->CellCases[cellId];
+        if (caseIndx < 0)
+        {
+          continue; // handled by vtkClipDataSet
+        }
+        this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+
+        int nOutputs;
+        TableBasedClipperEdgeVertices* edgeVtxs;
+        const unsigned char* thisCase =
+          GetClipCase(this->Input->GetCellType(cellId), caseIndx, nOutputs, edgeVtxs);
+        vtkIdType intrpIds[4] = { 0, 0, 0, 0 };
+        for (int j = 0; j < nOutputs; j++)
+        {
+          unsigned char theShape;
+          int theColor, intrpIdx, vtkType;
+          const int nCellPts = GetShapeHeader(thisCase, theShape, theColor, intrpIdx, vtkType);
+          if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
+          {
+            thisCase += nCellPts;
+            continue;
+          }
+
+          vtkIdType* conn;
+          vtkIdType baseIdx;
+          if (theShape == ST_PNT)
+          {
+            this->CentroidOffsets[centroidId] = centroidConnIdx;
+            conn = this->CentroidConnectivity + centroidConnIdx;
+            baseIdx = -1 - centroidConnIdx;
+            centroidConnIdx += nCellPts;
+            intrpIds[intrpIdx] = -1 - centroidId++;
+          }
+          else
+          {
+            this->Types[outCellId] = static_cast<unsigned char>(vtkType);
+            this->Offsets[outCellId] = connIdx;
+            if (this->CellArrays)
+            {
+              this->CellArrays->Copy(cellId, outCellId);
+            }
+            else
+            {
+              this->CellSources[outCellId] = cellId;
+            }
+            ++outCellId;
+            conn = this->Connectivity + connIdx;
+            baseIdx = connIdx;
+            connIdx += nCellPts;
+          }
+
+          for (int p = 0; p < nCellPts; p++)
+          {
+            const unsigned char pntIndex = *thisCase++;
+            if (pntIndex <= P7)
+            {
+              conn[p] = pts[pntIndex];
+            }
+            else if (pntIndex >= EA && pntIndex <= EL)
+            {
+              conn[p] = this->EdgePlaceholder;
+              edge->Define(pts[edgeVtxs[pntIndex - EA][0]], pts[edgeVtxs[pntIndex - EA][1]]);
+              edge->Data.ConnIdx = (baseIdx >= 0 ? baseIdx + p : baseIdx - p);
+              ++edge;
+            }
+            else if (pntIndex >= N0 && pntIndex <= N3)
+            {
+              conn[p] = intrpIds[pntIndex - N0];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Renumber the connectivity once the kept input points and the clip edges
+// are known: input points are mapped to their output id, centroids are
+// placed after the edge points. Edge placeholders are left untouched.
+struct RenumberConnectivity
+{
+  vtkIdType* Connectivity;
+  const vtkIdType* PointMap;
+  vtkIdType EdgePlaceholder;
+  vtkIdType CentroidStart;
+
+  void operator()(vtkIdType idx, vtkIdType endIdx)
+  {
+    for (; idx < endIdx; ++idx)
+    {
+      const vtkIdType ptId = this->Connectivity[idx];
+      if (ptId < 0)
+      {
+        this->Connectivity[idx] = this->CentroidStart - 1 - ptId;
+      }
+      else if (ptId < this->EdgePlaceholder)
+      {
+        this->Connectivity[idx] = this->PointMap[ptId];
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Generate the output points and point data: kept input points, points
+// interpolated on the merged clip edges, then the centroid points. The point
+// data is only interpolated here if arrays is not null.
+struct OutputPointsWorker
+{
+  template <typename InPtsT, typename OutPtsT>
+  void operator()(InPtsT* inPts, OutPtsT* outPts, const vtkIdType* pointMap,
+    const double* scalars, const TableBasedClipperEdgeTuple* edges, const vtkIdType* mergeOffsets,
+    vtkIdType numKeptPts, vtkIdType numEdgePts, ArrayList* arrays)
+  {
+    const vtkIdType numInPts = inPts->GetNumberOfTuples();
+
+    vtkSMPTools::For(0, numInPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      const auto in = vtk::DataArrayTupleRange<3>(inPts);
+      auto out = vtk::DataArrayTupleRange<3>(outPts);
+      for (; ptId < endPtId; ++ptId)
+      {
+        const vtkIdType outId = pointMap[ptId];
+        if (outId >= 0)
+        {
+          const auto xin = in[ptId];
+          auto xout = out[outId];
+          xout[0] = xin[0];
+          xout[1] = xin[1];
+          xout[2] = xin[2];
+          if (arrays)
+          {
+            arrays->Copy(ptId, outId);
+          }
+        }
+      }
+    });
+
+    vtkSMPTools::For(0, numEdgePts, [&](vtkIdType edgeId, vtkIdType endEdgeId) {
+      const auto in = vtk::DataArrayTupleRange<3>(inPts);
+      auto out = vtk::DataArrayTupleRange<3>(outPts);
+      for (; edgeId < endEdgeId; ++edgeId)
+      {
+        const TableBasedClipperEdgeTuple& edge = edges[mergeOffsets[edgeId]];
+        const double t = EdgeParameter(edge, scalars);
+        const auto x0 = in[edge.V0];
+        const auto x1 = in[edge.V1];
+        const vtkIdType outId = numKeptPts + edgeId;
+        auto xout = out[outId];
+        for (int i = 0; i < 3; ++i)
+        {
+          const double v0 = static_cast<double>(x0[i]);
+          xout[i] = v0 + t * (static_cast<double>(x1[i]) - v0);
+        }
+        if (arrays)
+        {
+          arrays->InterpolateEdge(edge.V0, edge.V1, t, outId);
+        }
+      }
+    });
+  }
+};
+
+//------------------------------------------------------------------------------
+// Centroid points are the average of other output points of the same cell,
+// including previous centroid points of that cell. They are generated per
+// batch, in order, which satisfies these dependencies. The point data is only
+// averaged here if arrays is not null.
+struct CentroidPointsWorker
+{
+  template <typename OutPtsT>
+  void operator()(OutPtsT* outPts, const TableBasedClipperBatch* batches, vtkIdType numBatches,
+    vtkIdType numCentroids, const vtkIdType* centroidOffsets, const vtkIdType* centroidConn,
+    vtkIdType centroidStart, ArrayList* arrays)
+  {
+    vtkSMPTools::For(0, numBatches, [&](vtkIdType batchId, vtkIdType endBatchId) {
+      auto pts = vtk::DataArrayTupleRange<3>(outPts);
+      for (; batchId < endBatchId; ++batchId)
+      {
+        const vtkIdType beginId = batches[batchId].NumberOfCentroids;
+        const vtkIdType endId =
+          (batchId + 1 < numBatches ? batches[batchId + 1].NumberOfCentroids : numCentroids);
+        for (vtkIdType centroidId = beginId; centroidId < endId; ++centroidId)
+        {
+          const vtkIdType* ids = centroidConn + centroidOffsets[centroidId];
+          const int numIds =
+            static_cast<int>(centroidOffsets[centroidId + 1] - centroidOffsets[centroidId]);
+          double x[3] = { 0.0, 0.0, 0.0 };
+          for (int k = 0; k < numIds; ++k)
+          {
+            const auto p = pts[ids[k]];
+            x[0] += p[0];
+            x[1] += p[1];
+            x[2] += p[2];
+          }
+          const vtkIdType outId = centroidStart + centroidId;
+          auto xout = pts[outId];
+          xout[0] = x[0] / numIds;
+          xout[1] = x[1] / numIds;
+          xout[2] = x[2] / numIds;
+          if (arrays)
+          {
+            arrays->Average(numIds, ids, outId);
+          }
+        }
+      }
+    });
+  }
+};
+} // anonymous namespace
+
+// ============================================================================
+// ============ Threaded clipping of unstructured grids ( end ) ===============
+// ============================================================================
 //------------------------------------------------------------------------------
 // Construct with user-specified implicit function; InsideOut turned off; value
 // set to 0.0; and generate clip scalars turned off.
@@ -1565,6 +2206,7 @@ vtkTableBasedClipDataSet::vtkTableBasedClipDataSet(vtkImplicitFunction* cf)
   this->GenerateClippedOutput = 0;
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->BatchSize = 10000;
 
   this->SetNumberOfOutputPorts(2);
   vtkUnstructuredGrid* output2 = vtkUnstructuredGrid::New();
@@ -1748,10 +2390,18 @@ int vtkTableBasedClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
       cpyInput->GetPointData()->SetScalars(pScalars);
     }
 
-    for (i = 0; i < numbPnts; i++)
+    vtkPointSet* pointSet = vtkPointSet::SafeDownCast(cpyInput);
+    if (pointSet && pointSet->GetPoints())
     {
-      double s = this->ClipFunction->FunctionValue(cpyInput->GetPoint(i));
-      pScalars->SetTuple1(i, s);
+      this->ClipFunction->FunctionValue(pointSet->GetPoints()->GetData(), pScalars);
+    }
+    else
+    {
+      for (i = 0; i < numbPnts; i++)
+      {
+        double s = this->ClipFunction->FunctionValue(cpyInput->GetPoint(i));
+        pScalars->SetTuple1(i, s);
+      }
     }
 
     clipAray = pScalars;
@@ -2902,383 +3552,291 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
   vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
 {
   vtkUnstructuredGrid* unstruct = vtkUnstructuredGrid::SafeDownCast(inputGrd);
+  const vtkIdType numPts = unstruct->GetNumberOfPoints();
+  const vtkIdType numCells = unstruct->GetNumberOfCells();
+  if (numPts < 1 || numCells < 1)
+  {
+    return;
+  }
 
-  vtkIdType i, j;
-  vtkIdType numbPnts = 0;
-  int numCants = 0; // number of cells not clipped by this filter
-  vtkIdType numCells = unstruct->GetNumberOfCells();
-
-  // volume from volume
-  vtkTableBasedClipperVolumeFromVolume* visItVFV =
-    new vtkTableBasedClipperVolumeFromVolume(this->OutputPointsPrecision,
-      unstruct->GetNumberOfPoints(), int(pow(double(numCells), double(0.6667f))) * 5 + 100);
+  // Offset the clip scalars by the iso value once, so that the cell cases and
+  // the edge intersections are computed from the same values.
+  std::vector<double> scalars(numPts);
+  EvaluateClipScalars evaluator = { clipAray, isoValue, scalars.data() };
+  vtkSMPTools::For(0, numPts, evaluator);
+
+  // First pass: compute the cell cases and the size of the output of each
+  // batch of cells.
+  const vtkIdType batchSize = static_cast<vtkIdType>(this->BatchSize);
+  const vtkIdType numBatches = (numCells - 1) / batchSize + 1;
+  std::vector<int> cellCases(numCells);
+  std::vector<TableBasedClipperBatch> batches(numBatches);
+  ClassifyCells classify(
+    unstruct, scalars.data(), this->InsideOut != 0, batchSize, cellCases.data(), batches.data());
+  vtkSMPTools::For(0, numBatches, classify);
+
+  // Prefix sum: each batch now holds the offsets where its output is written.
+  TableBasedClipperBatch totals = { 0, 0, 0, 0, 0, 0 };
+  for (TableBasedClipperBatch& batch : batches)
+  {
+    const TableBasedClipperBatch counts = batch;
+    batch = totals;
+    totals.NumberOfCells += counts.NumberOfCells;
+    totals.ConnectivitySize += counts.ConnectivitySize;
+    totals.NumberOfEdges += counts.NumberOfEdges;
+    totals.NumberOfCentroids += counts.NumberOfCentroids;
+    totals.CentroidConnectivitySize += counts.CentroidConnectivitySize;
+    totals.NumberOfSpecials += counts.NumberOfSpecials;
+  }
+
+  // The cells that cannot be clipped with the tables are appended later on.
+  vtkSmartPointer<vtkUnstructuredGrid> tableGrid = outputUG;
+  if (totals.NumberOfSpecials > 0)
+  {
+    tableGrid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  }
+
+  // Second pass: generate the cells and their cell data.
+  vtkNew<vtkUnsignedCharArray> cellTypes;
+  cellTypes->SetNumberOfValues(totals.NumberOfCells);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(totals.NumberOfCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(totals.ConnectivitySize);
+  vtkIdType* conn = connectivity->GetPointer(0);
+  std::vector<vtkIdType> centroidOffsets(totals.NumberOfCentroids + 1);
+  std::vector<vtkIdType> centroidConn(totals.CentroidConnectivitySize);
+  std::vector<TableBasedClipperEdgeTuple> edges(totals.NumberOfEdges);
+
+  vtkCellData* inCD = unstruct->GetCellData();
+  vtkCellData* outCD = tableGrid->GetCellData();
+  outCD->CopyAllocate(inCD, totals.NumberOfCells);
+  const bool copyCellsConcurrently = CanCopyConcurrently(inCD);
+  ArrayList cellArrays;
+  std::vector<vtkIdType> cellSources;
+  if (copyCellsConcurrently)
+  {
+    cellArrays.AddArrays(totals.NumberOfCells, inCD, outCD, 0.0, false);
+  }
+  else
+  {
+    cellSources.resize(totals.NumberOfCells);
+  }
 
-  // the stuffs that can not be clipped by this filter
-  vtkUnstructuredGrid* specials = vtkUnstructuredGrid::New();
-  specials->SetPoints(unstruct->GetPoints());
-  specials->GetPointData()->ShallowCopy(unstruct->GetPointData());
-  specials->Allocate(numCells);
+  GenerateCells generate(unstruct, cellCases.data(), this->InsideOut != 0, batchSize,
+    batches.data(), cellTypes->GetPointer(0), offsets->GetPointer(0), conn, centroidOffsets.data(),
+    centroidConn.data(), edges.data(), copyCellsConcurrently ? &cellArrays : nullptr,
+    cellSources.data());
+  vtkSMPTools::For(0, numBatches, generate);
+  for (vtkIdType outCellId = 0; outCellId < static_cast<vtkIdType>(cellSources.size());
+       ++outCellId)
+  {
+    outCD->CopyData(inCD, cellSources[outCellId], outCellId);
+  }
+  offsets->SetValue(totals.NumberOfCells, totals.ConnectivitySize);
+  centroidOffsets[totals.NumberOfCentroids] = totals.CentroidConnectivitySize;
 
-  for (i = 0; i < numCells; i++)
+  // Group the clip edges shared by neighboring cells. Sorting the edges makes
+  // the numbering of the new points independent of the number of threads.
+  TableBasedClipperEdgeLocator edgeLocator;
+  vtkIdType numEdgePts = 0;
+  const vtkIdType* mergeOffsets = nullptr;
+  if (totals.NumberOfEdges > 0)
   {
-    int cellType = unstruct->GetCellType(i);
-    const vtkIdType* pntIndxs = nullptr;
-    unstruct->GetCellPoints(i, numbPnts, pntIndxs);
+    mergeOffsets = edgeLocator.MergeEdges(totals.NumberOfEdges, edges.data(), numEdgePts);
+  }
 
-    bool bCanClip = false;
-    switch (cellType)
+  // Only the input points used by the output cells are kept, in input order.
+  // All threads mark the used points with the same value.
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkIdType* ptMap = pointMap.data();
+  auto markPoints = [ptMap, numPts](const vtkIdType* ids, vtkIdType numIds) {
+    vtkSMPTools::For(0, numIds, [ids, ptMap, numPts](vtkIdType idx, vtkIdType endIdx) {
+      for (; idx < endIdx; ++idx)
+      {
+        if (ids[idx] >= 0 && ids[idx] < numPts)
+        {
+          ptMap[ids[idx]] = 1;
+        }
+      }
+    });
+  };
+  markPoints(conn, totals.ConnectivitySize);
+  markPoints(centroidConn.data(), totals.CentroidConnectivitySize);
+  vtkIdType numKeptPts = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (ptMap[ptId] > 0)
     {
-      case VTK_TETRA:
-      case VTK_PYRAMID:
-      case VTK_WEDGE:
-      case VTK_HEXAHEDRON:
-      case VTK_VOXEL:
-      case VTK_TRIANGLE:
-      case VTK_QUAD:
-      case VTK_PIXEL:
-      case VTK_LINE:
-      case VTK_VERTEX:
-        bCanClip = true;
-        break;
-
-      default:
-        bCanClip = false;
-        break;
+      ptMap[ptId] = numKeptPts++;
     }
+  }
 
-    if (bCanClip)
-    {
-      int caseIndx = 0;
-      double grdDiffs[8];
+  // Renumber the connectivity, then point the clip edges to their new points.
+  const vtkIdType centroidStart = numKeptPts + numEdgePts;
+  RenumberConnectivity renumber = { conn, ptMap, numPts, centroidStart };
+  vtkSMPTools::For(0, totals.ConnectivitySize, renumber);
+  renumber.Connectivity = centroidConn.data();
+  vtkSMPTools::For(0, totals.CentroidConnectivitySize, renumber);
 
-      for (j = numbPnts - 1; j >= 0; j--)
+  const TableBasedClipperEdgeTuple* edgeArray = edges.data();
+  vtkIdType* centroidConnArray = centroidConn.data();
+  vtkSMPTools::For(0, numEdgePts, [&](vtkIdType edgeId, vtkIdType endEdgeId) {
+    for (; edgeId < endEdgeId; ++edgeId)
+    {
+      const vtkIdType outId = numKeptPts + edgeId;
+      for (vtkIdType i = mergeOffsets[edgeId]; i < mergeOffsets[edgeId + 1]; ++i)
       {
-        grdDiffs[j] = clipAray->GetComponent(pntIndxs[j], 0) - isoValue;
-        caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
-        caseIndx <<= (1 - (!j));
+        const vtkIdType connIdx = edgeArray[i].Data.ConnIdx;
+        if (connIdx >= 0)
+        {
+          conn[connIdx] = outId;
+        }
+        else
+        {
+          centroidConnArray[-1 - connIdx] = outId;
+        }
       }
+    }
+  });
 
-      int startIdx = 0;
-      int nOutputs = 0;
-      typedef const int EDGEIDXS[2];
-      EDGEIDXS* edgeVtxs = nullptr;
-      unsigned char* thisCase = nullptr;
-
-      // start index, split case, number of output, and vertices from edges
-      switch (cellType)
-      {
-        case VTK_TETRA:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesTet[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
-          break;
-
-        case VTK_PYRAMID:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesPyr[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
-          break;
-
-        case VTK_WEDGE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesWdg[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
-          break;
-
-        case VTK_HEXAHEDRON:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
-          break;
-
-        case VTK_VOXEL:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesVox[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
-          break;
-
-        case VTK_TRIANGLE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesTri[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
-          break;
-
-        case VTK_QUAD:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
-          break;
-
-        case VTK_PIXEL:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesPix[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
-          break;
-
-        case VTK_LINE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesLin[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
-          break;
-
-        case VTK_VERTEX:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesVtx[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[caseIndx];
-          edgeVtxs = nullptr;
-          break;
-      }
-
-      int intrpIds[4];
-      for (j = 0; j < nOutputs; j++)
-      {
-        int nCellPts = 0;
-        int theColor = -1;
-        int intrpIdx = -1;
-        unsigned char theShape = *thisCase++;
-
-        // number of points and color
-        switch (theShape)
-        {
-          case ST_HEX:
-            nCellPts = 8;
-            theColor = *thisCase++;
-            break;
-
-          case ST_WDG:
-            nCellPts = 6;
-            theColor = *thisCase++;
-            break;
-
-          case ST_PYR:
-            nCellPts = 5;
-            theColor = *thisCase++;
-            break;
-
-          case ST_TET:
-            nCellPts = 4;
-            theColor = *thisCase++;
-            break;
-
-          case ST_QUA:
-            nCellPts = 4;
-            theColor = *thisCase++;
-            break;
-
-          case ST_TRI:
-            nCellPts = 3;
-            theColor = *thisCase++;
-            break;
-
-          case ST_LIN:
-            nCellPts = 2;
-            theColor = *thisCase++;
-            break;
-
-          case ST_VTX:
-            nCellPts = 1;
-            theColor = *thisCase++;
-            break;
-
-          case ST_PNT:
-            intrpIdx = *thisCase++;
-            theColor = *thisCase++;
-            nCellPts = *thisCase++;
-            break;
-
-          default:
-            vtkErrorMacro(<< "An invalid output shape was found "
-                          << "in the ClipCases." << endl);
-        }
-
-        if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
-        {
-          // We don't want this one; it's the wrong side.
-          thisCase += nCellPts;
-          continue;
-        }
-
-        vtkIdType shapeIds[8];
-        for (int p = 0; p < nCellPts; p++)
-        {
-          unsigned char pntIndex = *thisCase++;
-
-          if (pntIndex <= P7)
-          {
-            // We know pt P0 must be >P0 since we already
-            // assume P0 == 0.  This is why we do not
-            // bother subtracting P0 from pt here.
-            shapeIds[p] = pntIndxs[pntIndex];
-          }
-          else if (pntIndex >= EA && pntIndex <= EL)
-          {
-            int pt1Index = edgeVtxs[pntIndex - EA][0];
-            int pt2Index = edgeVtxs[pntIndex - EA][1];
-            if (pt2Index < pt1Index)
-            {
-              int temp = pt2Index;
-              pt2Index = pt1Index;
-              pt1Index = temp;
-            }
-            double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
-            double pt1ToIso = 0.0 - grdDiffs[pt1Index];
-            double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
-
-            vtkIdType pntIndx1 = pntIndxs[pt1Index];
-            vtkIdType pntIndx2 = pntIndxs[pt2Index];
-
-            shapeIds[p] = visItVFV->AddPoint(pntIndx1, pntIndx2, p1Weight);
-          }
-          else if (pntIndex >= N0 && pntIndex <= N3)
-          {
-            shapeIds[p] = intrpIds[pntIndex - N0];
-          }
-          else
-          {
-            vtkErrorMacro(<< "An invalid output point value was found "
-                          << "in the ClipCases." << endl);
-          }
-        }
-
-        switch (theShape)
-        {
-          case ST_HEX:
-            visItVFV->AddHex(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4],
-              shapeIds[5], shapeIds[6], shapeIds[7]);
-            break;
-
-          case ST_WDG:
-            visItVFV->AddWedge(
-              i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4], shapeIds[5]);
-            break;
-
-          case ST_PYR:
-            visItVFV->AddPyramid(
-              i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4]);
-            break;
-
-          case ST_TET:
-            visItVFV->AddTet(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-            break;
-
-          case ST_QUA:
-            visItVFV->AddQuad(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-            break;
-
-          case ST_TRI:
-            visItVFV->AddTri(i, shapeIds[0], shapeIds[1], shapeIds[2]);
-            break;
-
-          case ST_LIN:
-            visItVFV->AddLine(i, shapeIds[0], shapeIds[1]);
-            break;
-
-          case ST_VTX:
-            visItVFV->AddVertex(i, shapeIds[0]);
-            break;
+  // Generate the output points and the point data.
+  const vtkIdType numOutPts = centroidStart + totals.NumberOfCentroids;
+  vtkPoints* inPts = unstruct->GetPoints();
+  vtkNew<vtkPoints> outPts;
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    outPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    outPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    outPts->SetDataType(VTK_DOUBLE);
+  }
+  outPts->SetNumberOfPoints(numOutPts);
 
-          case ST_PNT:
-            intrpIds[intrpIdx] = visItVFV->AddCentroidPoint(nCellPts, shapeIds);
-            break;
-        }
-      }
+  vtkPointData* inPD = unstruct->GetPointData();
+  vtkPointData* outPD = tableGrid->GetPointData();
+  outPD->InterpolateAllocate(inPD, numOutPts);
+  const bool copyPointsConcurrently = CanCopyConcurrently(inPD);
+  ArrayList pointArrays;
+  if (copyPointsConcurrently)
+  {
+    pointArrays.AddArrays(numOutPts, inPD, outPD, 0.0, false);
+  }
 
-      edgeVtxs = nullptr;
-      thisCase = nullptr;
-    }
-    else if (cellType == VTK_POLYHEDRON)
+  using vtkArrayDispatch::Reals;
+  OutputPointsWorker pointsWorker;
+  ArrayList* pointArraysPtr = copyPointsConcurrently ? &pointArrays : nullptr;
+  if (!vtkArrayDispatch::Dispatch2ByValueType<Reals, Reals>::Execute(inPts->GetData(),
+        outPts->GetData(), pointsWorker, ptMap, scalars.data(), edgeArray, mergeOffsets,
+        numKeptPts, numEdgePts, pointArraysPtr))
+  { // Fallback to slow path for other point types
+    pointsWorker(inPts->GetData(), outPts->GetData(), ptMap, scalars.data(), edgeArray,
+      mergeOffsets, numKeptPts, numEdgePts, pointArraysPtr);
+  }
+  if (!copyPointsConcurrently)
+  {
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
     {
-      if (numCants == 0)
+      if (ptMap[ptId] >= 0)
       {
-        specials->GetCellData()->CopyAllocate(unstruct->GetCellData(), numCells);
+        outPD->CopyData(inPD, ptId, ptMap[ptId]);
       }
-      vtkIdType nfaces;
-      const vtkIdType* facePtIds;
-      unstruct->GetFaceStream(i, nfaces, facePtIds);
-      specials->InsertNextCell(cellType, nfaces, facePtIds);
-      specials->GetCellData()->CopyData(unstruct->GetCellData(), i, numCants);
-      numCants++;
     }
-    else
+    for (vtkIdType edgeId = 0; edgeId < numEdgePts; ++edgeId)
     {
-      if (numCants == 0)
-      {
-        specials->GetCellData()->CopyAllocate(unstruct->GetCellData(), numCells);
-      }
-      specials->InsertNextCell(cellType, numbPnts, pntIndxs);
-      specials->GetCellData()->CopyData(unstruct->GetCellData(), i, numCants);
-      numCants++;
+      const TableBasedClipperEdgeTuple& edge = edgeArray[mergeOffsets[edgeId]];
+      outPD->InterpolateEdge(
+        inPD, numKeptPts + edgeId, edge.V0, edge.V1, EdgeParameter(edge, scalars.data()));
     }
-
-    pntIndxs = nullptr;
   }
 
-  int toDelete = 0;
-  double* theCords = nullptr;
-  vtkPoints* inputPts = unstruct->GetPoints();
-  if (inputPts->GetDataType() == VTK_DOUBLE)
-  {
-    theCords = static_cast<double*>(inputPts->GetVoidPointer(0));
-  }
-  else
+  if (totals.NumberOfCentroids > 0)
   {
-    toDelete = 1;
-    numbPnts = inputPts->GetNumberOfPoints();
-    theCords = new double[numbPnts * 3];
-    for (i = 0; i < numbPnts; i++)
+    ArrayList centroidArrays;
+    if (copyPointsConcurrently)
     {
-      inputPts->GetPoint(i, theCords + (i << 1) + i);
+      centroidArrays.AddSelfInterpolatingArrays(numOutPts, outPD);
+    }
+    ArrayList* centroidArraysPtr = copyPointsConcurrently ? &centroidArrays : nullptr;
+    CentroidPointsWorker centroidWorker;
+    if (!vtkArrayDispatch::DispatchByValueType<Reals>::Execute(outPts->GetData(), centroidWorker,
+          batches.data(), numBatches, totals.NumberOfCentroids, centroidOffsets.data(),
+          centroidConnArray, centroidStart, centroidArraysPtr))
+    { // Fallback to slow path for other point types
+      centroidWorker(outPts->GetData(), batches.data(), numBatches, totals.NumberOfCentroids,
+        centroidOffsets.data(), centroidConnArray, centroidStart, centroidArraysPtr);
+    }
+
+    // Centroids depend on the previous ones, so they are averaged in order.
+    if (!copyPointsConcurrently)
+    {
+      vtkNew<vtkIdList> centroidIds;
+      std::vector<double> weights;
+      for (vtkIdType centroidId = 0; centroidId < totals.NumberOfCentroids; ++centroidId)
+      {
+        const vtkIdType numIds = centroidOffsets[centroidId + 1] - centroidOffsets[centroidId];
+        centroidIds->SetNumberOfIds(numIds);
+        for (vtkIdType k = 0; k < numIds; ++k)
+        {
+          centroidIds->SetId(k, centroidConnArray[centroidOffsets[centroidId] + k]);
+        }
+        weights.assign(numIds, 1.0 / numIds);
+        outPD->InterpolatePoint(outPD, centroidStart + centroidId, centroidIds, weights.data());
+      }
     }
   }
-  inputPts = nullptr;
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  tableGrid->SetPoints(outPts);
+  tableGrid->SetCells(cellTypes, cells);
 
   // the stuff that can not be clipped
-  if (numCants > 0)
-  {
-    vtkUnstructuredGrid* vtkUGrid = vtkUnstructuredGrid::New();
-    this->ClipDataSet(specials, clipAray, vtkUGrid);
+  if (totals.NumberOfSpecials > 0)
+  {
+    vtkNew<vtkUnstructuredGrid> specials;
+    specials->SetPoints(inPts);
+    specials->GetPointData()->ShallowCopy(inPD);
+    specials->Allocate(totals.NumberOfSpecials);
+    specials->GetCellData()->CopyAllocate(inCD, totals.NumberOfSpecials);
+
+    vtkIdType numCants = 0;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+      if (cellCases[cellId] >= 0)
+      {
+        continue;
+      }
+      const int cellType = unstruct->GetCellType(cellId);
+      if (cellType == VTK_POLYHEDRON)
+      {
+        unstruct->GetFaceStream(cellId, npts, pts);
+      }
+      else
+      {
+        unstruct->GetCellPoints(cellId, npts, pts);
+      }
+      specials->InsertNextCell(cellType, npts, pts);
+      specials->GetCellData()->CopyData(inCD, cellId, numCants++);
+    }
 
-    vtkUnstructuredGrid* visItGrd = vtkUnstructuredGrid::New();
-    visItVFV->ConstructDataSet(unstruct, visItGrd, theCords);
+    vtkNew<vtkUnstructuredGrid> vtkUGrid;
+    this->ClipDataSet(specials, clipAray, vtkUGrid);
 
-    vtkAppendFilter* appender = vtkAppendFilter::New();
+    vtkNew<vtkAppendFilter> appender;
     appender->AddInputData(vtkUGrid);
-    appender->AddInputData(visItGrd);
+    appender->AddInputData(tableGrid);
     appender->Update();
 
     outputUG->ShallowCopy(appender->GetOutput());
-
-    appender->Delete();
-    visItGrd->Delete();
-    vtkUGrid->Delete();
-    appender = nullptr;
-    vtkUGrid = nullptr;
-    visItGrd = nullptr;
   }
-  else
-  {
-    visItVFV->ConstructDataSet(unstruct, outputUG, theCords);
-  }
-
-  specials->Delete();
-  delete visItVFV;
-  if (toDelete)
-  {
-    delete[] theCords;
-  }
-  specials = nullptr;
-  visItVFV = nullptr;
-  theCords = nullptr;
-  unstruct = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -3313,4 +3871,5 @@ void vtkTableBasedClipDataSet::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UseValueAsOffset: " << (this->UseValueAsOffset ? "On\n" : "Off\n");
 
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Batch Size: " << this->BatchSize << "\n";
 }
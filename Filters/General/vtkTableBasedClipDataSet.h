@@ -68,6 +68,12 @@
  *  advantages are gained by adopting the unique clipping and triangulation tables
  *  proposed by VisIt.
  *
+ *  Unstructured grids are clipped in parallel using vtkSMPTools: the cells are
+ *  processed in batches (see SetBatchSize()), and the points generated on the
+ *  clipped edges are merged with vtkStaticEdgeLocatorTemplate. The output is
+ *  identical whatever the number of threads, and the output cells are ordered
+ *  like the input cells they come from.
+ *
  * @warning
  *  vtkTableBasedClipDataSet makes use of a hash table (that is provided by class
  *  maintained by internal class vtkTableBasedClipperDataSetFromVolume) to achieve
@@ -226,6 +232,17 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Specify the number of input cells in a batch, where a batch defines a
+   * subset of the input cells operated on during threaded execution of
+   * unstructured grids. Generally this is only used for debugging or
+   * performance studies (since batch size affects the thread workload).
+   */
+  vtkSetClampMacro(BatchSize, unsigned int, 1, VTK_INT_MAX);
+  vtkGetMacro(BatchSize, unsigned int);
+  ///@}
+
 protected:
   vtkTableBasedClipDataSet(vtkImplicitFunction* cf = nullptr);
   ~vtkTableBasedClipDataSet() override;
@@ -304,6 +321,7 @@ protected:
   vtkIncrementalPointLocator* Locator;
 
   int OutputPointsPrecision;
+  unsigned int BatchSize;
 
 private:
   vtkTableBasedClipDataSet(const vtkTableBasedClipDataSet&) = delete;
@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedDataWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes the time steps of a changing polydata with vtkThreadedDataWriter,
+// in XML and legacy formats, with writers chosen from the file names and
+// given by the caller, and checks the files once flushed, as well as the
+// bound on the queued memory and the report of the failed writes.
+
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkThreadedDataWriter.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+const int NumberOfSteps = 8;
+const vtkIdType NumberOfPoints = 20000;
+
+// The simulation replaces its arrays at each step, so the queued shallow
+// copies keep the values of their own step.
+void Advance(vtkPolyData* polyData, int step)
+{
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(NumberOfPoints);
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  values->SetNumberOfValues(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->SetPoint(i, i, step, 0);
+    values->SetValue(i, i * 0.5 + step);
+  }
+  polyData->SetPoints(points);
+  polyData->GetPointData()->AddArray(values);
+}
+
+bool Check(vtkPolyData* polyData, int step, const std::string& fileName)
+{
+  vtkDoubleArray* values =
+    vtkDoubleArray::SafeDownCast(polyData->GetPointData()->GetArray("values"));
+  if (polyData->GetNumberOfPoints() != NumberOfPoints || !values ||
+    values->GetNumberOfValues() != NumberOfPoints)
+  {
+    std::cerr << "Wrong data in " << fileName << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    if (polyData->GetPoint(i)[1] != step || values->GetValue(i) != i * 0.5 + step)
+    {
+      std::cerr << "Wrong value " << i << " in " << fileName << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string FileName(const std::string& prefix, int step, const char* extension)
+{
+  return prefix + "-" + std::to_string(step) + extension;
+}
+}
+
+int TestThreadedDataWriter(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestThreadedDataWriter";
+  delete[] tempDir;
+
+  vtkNew<vtkThreadedDataWriter> threadedWriter;
+  threadedWriter->SetMaxThreads(3);
+  threadedWriter->Initialize();
+
+  // Room for about two steps, to have Write() wait for the workers.
+  vtkNew<vtkPolyData> polyData;
+  Advance(polyData, 0);
+  const unsigned long stepMemory = polyData->GetActualMemorySize();
+  threadedWriter->SetMaxQueuedMemory(2 * stepMemory + stepMemory / 2);
+
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    Advance(polyData, step);
+    vtkNew<vtkXMLPolyDataWriter> writer;
+    writer->SetFileName(FileName(prefix, step, "-lz4.vtp").c_str());
+    writer->SetCompressorTypeToLZ4();
+    if (!threadedWriter->Write(polyData, FileName(prefix, step, ".vtp").c_str()) ||
+      !threadedWriter->Write(polyData, FileName(prefix, step, ".vtk").c_str()) ||
+      !threadedWriter->Write(polyData, writer))
+    {
+      std::cerr << "Cannot queue step " << step << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (threadedWriter->GetQueuedMemory() > threadedWriter->GetMaxQueuedMemory())
+    {
+      std::cerr << "Queued " << threadedWriter->GetQueuedMemory() << " KiB, more than "
+                << threadedWriter->GetMaxQueuedMemory() << " KiB" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (!threadedWriter->Flush() || threadedWriter->GetQueuedMemory() != 0)
+  {
+    std::cerr << "Failed to write the steps." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    const char* extensions[] = { ".vtp", "-lz4.vtp" };
+    for (const char* extension : extensions)
+    {
+      vtkNew<vtkXMLPolyDataReader> reader;
+      const std::string fileName = FileName(prefix, step, extension);
+      reader->SetFileName(fileName.c_str());
+      reader->Update();
+      if (!Check(reader->GetOutput(), step, fileName))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+    vtkNew<vtkPolyDataReader> reader;
+    const std::string fileName = FileName(prefix, step, ".vtk");
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    if (!Check(reader->GetOutput(), step, fileName))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A failed write is reported by the next Flush() only.
+  std::cout << "Expecting an error for a missing directory." << std::endl;
+  threadedWriter->Write(polyData, (prefix + "-missing/step.vtp").c_str());
+  if (threadedWriter->Flush() || !threadedWriter->Flush())
+  {
+    std::cerr << "Wrong report of a failed write." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  threadedWriter->Finalize();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,285 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedDataWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkThreadedDataWriter.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkErrorCode.h"
+#include "vtkGenericDataObjectWriter.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedTaskQueue.h"
+#include "vtkWriter.h"
+#include "vtkXMLDataObjectWriter.h"
+#include "vtkXMLWriter.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <string>
+
+#define MAX_NUMBER_OF_THREADS_IN_POOL 32
+//****************************************************************************
+namespace
+{
+bool WriteData(vtkDataObject* data, vtkAlgorithm* writer)
+{
+  writer->SetInputDataObject(0, data);
+  bool success;
+  if (vtkWriter* dataWriter = vtkWriter::SafeDownCast(writer))
+  {
+    success = dataWriter->Write() != 0;
+  }
+  else if (vtkXMLWriterBase* xmlWriter = vtkXMLWriterBase::SafeDownCast(writer))
+  {
+    // The XML writers only report their errors through the error code.
+    success = xmlWriter->Write() != 0 && xmlWriter->GetErrorCode() == vtkErrorCode::NoError;
+  }
+  else
+  {
+    writer->Modified();
+    writer->UpdateWholeExtent();
+    success = writer->GetErrorCode() == vtkErrorCode::NoError;
+  }
+  // Do not keep the data alive through the writer.
+  writer->SetInputDataObject(0, nullptr);
+  return success;
+}
+}
+
+//****************************************************************************
+class vtkThreadedDataWriter::vtkInternals
+{
+private:
+  using TaskQueueType = vtkThreadedTaskQueue<void, vtkSmartPointer<vtkDataObject>,
+    vtkSmartPointer<vtkAlgorithm>, unsigned long>;
+  std::unique_ptr<TaskQueueType> Queue;
+
+  // Guard the bookkeeping of the queued writes, updated by the workers.
+  std::mutex Mutex;
+  std::condition_variable WriteDone;
+  vtkIdType NumberOfQueuedWrites = 0;
+  unsigned long QueuedMemory = 0;
+  std::multiset<vtkAlgorithm*> QueuedWriters;
+  bool Failed = false;
+
+  void Run(vtkDataObject* data, vtkAlgorithm* writer, unsigned long size)
+  {
+    vtkLogF(TRACE, "writing %s with %s", data->GetClassName(), writer->GetClassName());
+    bool success = ::WriteData(data, writer);
+
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    --this->NumberOfQueuedWrites;
+    this->QueuedMemory -= size;
+    this->QueuedWriters.erase(this->QueuedWriters.find(writer));
+    this->Failed |= !success;
+    lock.unlock();
+    this->WriteDone.notify_all();
+  }
+
+public:
+  ~vtkInternals() { this->TerminateAllWorkers(); }
+
+  bool IsRunning() const { return this->Queue != nullptr; }
+
+  void TerminateAllWorkers()
+  {
+    this->WaitForAllWrites();
+    this->Queue.reset(nullptr);
+  }
+
+  void SpawnWorkers(vtkTypeUInt32 numberOfThreads)
+  {
+    this->Queue.reset(new TaskQueueType(
+      [this](vtkSmartPointer<vtkDataObject> data, vtkSmartPointer<vtkAlgorithm> writer,
+        unsigned long size) { this->Run(data, writer, size); },
+      /*strict_ordering=*/true,
+      /*buffer_size=*/-1,
+      /*max_concurrent_tasks=*/static_cast<int>(numberOfThreads)));
+  }
+
+  // Wait for room in the queue, and for the writer to be done with its
+  // previous data, then reserve them.
+  void Reserve(vtkAlgorithm* writer, unsigned long size, unsigned long maxQueuedMemory)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->WriteDone.wait(lock, [&]() {
+      return this->QueuedWriters.count(writer) == 0 &&
+        (maxQueuedMemory == 0 || this->NumberOfQueuedWrites == 0 ||
+          this->QueuedMemory + size <= maxQueuedMemory);
+    });
+    ++this->NumberOfQueuedWrites;
+    this->QueuedMemory += size;
+    this->QueuedWriters.insert(writer);
+  }
+
+  void Push(vtkSmartPointer<vtkDataObject>&& data, vtkSmartPointer<vtkAlgorithm>&& writer,
+    unsigned long size)
+  {
+    this->Queue->Push(std::move(data), std::move(writer), std::move(size));
+  }
+
+  // The task queue only tracks the last completed task, which is not enough
+  // with several workers, so count the writes instead.
+  void WaitForAllWrites()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->WriteDone.wait(lock, [this]() { return this->NumberOfQueuedWrites == 0; });
+  }
+
+  // Returns false if a write failed since the previous call.
+  bool ResetStatus()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    bool success = !this->Failed;
+    this->Failed = false;
+    return success;
+  }
+
+  unsigned long GetQueuedMemory()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->QueuedMemory;
+  }
+};
+
+vtkStandardNewMacro(vtkThreadedDataWriter);
+//------------------------------------------------------------------------------
+vtkThreadedDataWriter::vtkThreadedDataWriter()
+  : Internals(new vtkInternals())
+{
+  this->MaxThreads = 1;
+  this->MaxQueuedMemory = 1048576;
+  this->DeepCopy = false;
+}
+
+//------------------------------------------------------------------------------
+vtkThreadedDataWriter::~vtkThreadedDataWriter()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::SetMaxThreads(vtkTypeUInt32 maxThreads)
+{
+  if (maxThreads < MAX_NUMBER_OF_THREADS_IN_POOL && maxThreads > 0 &&
+    this->MaxThreads != maxThreads)
+  {
+    this->MaxThreads = maxThreads;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::Initialize()
+{
+  // Stop any started thread first
+  this->Internals->TerminateAllWorkers();
+  this->Internals->SpawnWorkers(this->MaxThreads);
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedDataWriter::Write(vtkDataObject* data, vtkAlgorithm* writer)
+{
+  if (data == nullptr || writer == nullptr)
+  {
+    vtkErrorMacro(<< "Write: Please specify the data and the writer!");
+    return false;
+  }
+  if (!this->Internals->IsRunning())
+  {
+    this->Initialize();
+  }
+
+  // Wait before copying, so that a deep copy does not add to the memory
+  // while waiting.
+  unsigned long size = data->GetActualMemorySize();
+  this->Internals->Reserve(writer, size, this->MaxQueuedMemory);
+
+  // The copy lets the caller modify or release the data object right away,
+  // as for data propagated in the pipeline.
+  vtkSmartPointer<vtkDataObject> copy;
+  copy.TakeReference(data->NewInstance());
+  if (this->DeepCopy)
+  {
+    copy->DeepCopy(data);
+  }
+  else
+  {
+    copy->ShallowCopy(data);
+  }
+  this->Internals->Push(std::move(copy), vtkSmartPointer<vtkAlgorithm>(writer), size);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedDataWriter::Write(vtkDataObject* data, const char* fileName)
+{
+  if (data == nullptr || fileName == nullptr)
+  {
+    vtkErrorMacro(<< "Write: Please specify the data and the file name!");
+    return false;
+  }
+
+  std::string name = fileName;
+  if (name.size() > 4 && name.compare(name.size() - 4, 4, ".vtk") == 0)
+  {
+    vtkNew<vtkGenericDataObjectWriter> writer;
+    writer->SetFileName(fileName);
+    writer->SetFileTypeToBinary();
+    return this->Write(data, writer);
+  }
+
+  vtkSmartPointer<vtkXMLWriter> writer;
+  writer.TakeReference(vtkXMLDataObjectWriter::NewWriter(data->GetDataObjectType()));
+  if (writer == nullptr)
+  {
+    vtkErrorMacro(<< "Write: No XML writer for " << data->GetClassName() << "!");
+    return false;
+  }
+  writer->SetFileName(fileName);
+  return this->Write(data, writer);
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedDataWriter::Flush()
+{
+  this->Internals->WaitForAllWrites();
+  return this->Internals->ResetStatus();
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkThreadedDataWriter::GetQueuedMemory()
+{
+  return this->Internals->GetQueuedMemory();
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaxThreads: " << this->MaxThreads << endl;
+  os << indent << "MaxQueuedMemory: " << this->MaxQueuedMemory << endl;
+  os << indent << "DeepCopy: " << (this->DeepCopy ? "On" : "Off") << endl;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::Finalize()
+{
+  this->Internals->TerminateAllWorkers();
+}
@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedDataWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class    vtkThreadedDataWriter
+ * @brief    class used to write data objects with any writer using threads,
+ *           so that the caller does not wait for the files to be written.
+ *
+ * @details  Each call to Write() takes a copy of the data object, shallow by
+ *           default, and queues it with the writer to use. The writes are
+ *           done in order by a pool of worker threads. A writer may be any
+ *           vtkWriter or vtkXMLWriter subclass, or any algorithm writing its
+ *           input when updated; it is given the copy as input, so the file
+ *           name and the other settings must be set beforehand. Write() may
+ *           also choose the writer from the file name: legacy for `.vtk`,
+ *           the XML writer of the data type otherwise.
+ *
+ *           The data held by the queue is bounded by MaxQueuedMemory: when
+ *           it is reached, Write() waits for earlier writes to complete.
+ *           Flush() waits for all the queued writes.
+ *
+ *           With shallow copies, the arrays of the data object are shared
+ *           with the queue and must not be modified in place until they are
+ *           written, while the data object itself may be modified or
+ *           released right away. Turn DeepCopy on to copy the arrays too, at
+ *           the cost of the copy and of the memory.
+ *
+ * @sa vtkThreadedImageWriter
+ */
+
+#ifndef vtkThreadedDataWriter_h
+#define vtkThreadedDataWriter_h
+
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkDataObject;
+
+class VTKIOASYNCHRONOUS_EXPORT vtkThreadedDataWriter : public vtkObject
+{
+public:
+  static vtkThreadedDataWriter* New();
+  vtkTypeMacro(vtkThreadedDataWriter, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Start a pool of MaxThreads worker threads, after waiting for any running
+   * thread to terminate. Write() calls it if no pool is running, so it is
+   * only needed after changing the thread count.
+   */
+  void Initialize();
+
+  /**
+   * Queue a copy of the data to be written by the given writer, which must
+   * be ready to write but for its input. The writer is held by the queue
+   * until the data is written and must not be modified meanwhile: use a new
+   * writer for each call, or call Flush() before changing its file name.
+   * Passing a queued writer again waits for its previous write.
+   * Returns false if nothing was queued.
+   */
+  bool Write(vtkDataObject* data, vtkAlgorithm* writer);
+
+  /**
+   * Queue a copy of the data to be written to the given file, with the
+   * legacy writer if the file name ends with `.vtk` and with the XML writer
+   * of the data type otherwise. Returns false if nothing was queued.
+   */
+  bool Write(vtkDataObject* data, VTK_FILEPATH const char* fileName);
+
+  /**
+   * Wait for all the queued writes. Returns false if any write failed since
+   * the previous call.
+   */
+  bool Flush();
+
+  /**
+   * Define the number of worker thread to use.
+   * Initialize() need to be called after any thread count change.
+   * Default is 1, which keeps the writes of a given file in order.
+   */
+  void SetMaxThreads(vtkTypeUInt32);
+  vtkGetMacro(MaxThreads, vtkTypeUInt32);
+
+  ///@{
+  /**
+   * Maximum memory, in kibibytes, held by the queued data objects as
+   * reported by vtkDataObject::GetActualMemorySize(). Write() waits for
+   * earlier writes to complete when it is reached. A data object bigger
+   * than this limit is queued once the queue is empty. 0 means no limit.
+   * Default is 1048576 (1 GiB).
+   */
+  vtkSetMacro(MaxQueuedMemory, unsigned long);
+  vtkGetMacro(MaxQueuedMemory, unsigned long);
+  ///@}
+
+  /**
+   * Memory, in kibibytes, held by the queued data objects.
+   */
+  unsigned long GetQueuedMemory();
+
+  ///@{
+  /**
+   * Deep copy the data objects instead of shallow copying them, so that
+   * their arrays may be modified as soon as Write() returns.
+   * Default is false.
+   */
+  vtkSetMacro(DeepCopy, bool);
+  vtkGetMacro(DeepCopy, bool);
+  vtkBooleanMacro(DeepCopy, bool);
+  ///@}
+
+  /**
+   * This method will wait for any running thread to terminate.
+   */
+  void Finalize();
+
+protected:
+  vtkThreadedDataWriter();
+  ~vtkThreadedDataWriter() override;
+
+private:
+  vtkThreadedDataWriter(const vtkThreadedDataWriter&) = delete;
+  void operator=(const vtkThreadedDataWriter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+  vtkTypeUInt32 MaxThreads;
+  unsigned long MaxQueuedMemory;
+  bool DeepCopy;
+};
+
+#endif
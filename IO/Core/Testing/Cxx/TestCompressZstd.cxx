@@ -0,0 +1,166 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompressZstd.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkZstdDataCompressor
+// .SECTION Description
+// Checks the round trip at several levels, with and without a dictionary,
+// with a trained dictionary, and with blocks compressed concurrently.
+
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// A small block of text-like data, similar from one block to the next.
+std::vector<unsigned char> MakeBlock(int index)
+{
+  std::string text;
+  for (int i = 0; i < 20; ++i)
+  {
+    text += "<DataArray type=\"Float32\" Name=\"Array" + std::to_string(index * 20 + i) +
+      "\" NumberOfComponents=\"3\" format=\"appended\"/>\n";
+  }
+  return std::vector<unsigned char>(text.begin(), text.end());
+}
+
+// Compresses and uncompresses the block, returns the compressed size or 0.
+size_t RoundTrip(vtkZstdDataCompressor* compressor, const std::vector<unsigned char>& block)
+{
+  vtkSmartPointer<vtkUnsignedCharArray> compressed;
+  compressed.TakeReference(compressor->Compress(block.data(), block.size()));
+  if (!compressed)
+  {
+    return 0;
+  }
+  std::vector<unsigned char> uncompressed(block.size());
+  size_t size = compressor->Uncompress(compressed->GetPointer(0),
+    static_cast<size_t>(compressed->GetNumberOfValues()), uncompressed.data(), block.size());
+  if (size != block.size() || uncompressed != block)
+  {
+    return 0;
+  }
+  return static_cast<size_t>(compressed->GetNumberOfValues());
+}
+}
+
+int TestCompressZstd(int, char*[])
+{
+  vtkNew<vtkZstdDataCompressor> compressor;
+  std::vector<unsigned char> block = MakeBlock(0);
+
+  for (int level = 1; level <= 9; ++level)
+  {
+    compressor->SetCompressionLevel(level);
+    if (compressor->GetCompressionLevel() != level || RoundTrip(compressor, block) == 0)
+    {
+      std::cerr << "Round trip failed at level " << level << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A dictionary made of similar blocks helps compressing a small one.
+  std::vector<unsigned char> dictionary;
+  for (int i = 1; i < 10; ++i)
+  {
+    std::vector<unsigned char> other = MakeBlock(i);
+    dictionary.insert(dictionary.end(), other.begin(), other.end());
+  }
+  size_t plainSize = RoundTrip(compressor, block);
+  compressor->SetDictionary(dictionary.data(), dictionary.size());
+  size_t dictionarySize = RoundTrip(compressor, block);
+  if (compressor->GetDictionarySize() != dictionary.size() || dictionarySize == 0 ||
+    dictionarySize >= plainSize)
+  {
+    std::cerr << "Compression with a dictionary failed: " << dictionarySize << " bytes, "
+              << plainSize << " without" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The data cannot be uncompressed without the dictionary.
+  vtkSmartPointer<vtkUnsignedCharArray> compressed;
+  compressed.TakeReference(compressor->Compress(block.data(), block.size()));
+  vtkNew<vtkZstdDataCompressor> plainCompressor;
+  std::vector<unsigned char> uncompressed(block.size());
+  vtkObject::GlobalWarningDisplayOff();
+  size_t size = plainCompressor->Uncompress(compressed->GetPointer(0),
+    static_cast<size_t>(compressed->GetNumberOfValues()), uncompressed.data(), block.size());
+  vtkObject::GlobalWarningDisplayOn();
+  if (size != 0)
+  {
+    std::cerr << "Data compressed with a dictionary were uncompressed without it" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Blocks compressed concurrently, as the XML writers do.
+  const vtkIdType numberOfBlocks = 64;
+  std::vector<int> results(numberOfBlocks, 0);
+  vtkSMPTools::For(0, numberOfBlocks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      results[i] = RoundTrip(compressor, MakeBlock(static_cast<int>(i))) != 0;
+    }
+  });
+  for (vtkIdType i = 0; i < numberOfBlocks; ++i)
+  {
+    if (!results[i])
+    {
+      std::cerr << "Concurrent round trip failed for block " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  compressor->SetDictionary(nullptr, 0);
+  if (compressor->GetDictionarySize() != 0 || RoundTrip(compressor, block) != plainSize)
+  {
+    std::cerr << "Removing the dictionary failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A dictionary trained on many similar blocks.
+  std::vector<unsigned char> data;
+  for (int i = 1; i < 200; ++i)
+  {
+    std::vector<unsigned char> other = MakeBlock(i);
+    data.insert(data.end(), other.begin(), other.end());
+  }
+  compressor->SetMaximumDictionarySize(4096);
+  if (!compressor->TrainDictionary(data.data(), data.size(), block.size()) ||
+    compressor->GetDictionarySize() == 0 || compressor->GetDictionarySize() > 4096)
+  {
+    std::cerr << "Training a dictionary failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  size_t trainedSize = RoundTrip(compressor, block);
+  if (trainedSize == 0 || trainedSize >= plainSize)
+  {
+    std::cerr << "Compression with a trained dictionary failed: " << trainedSize << " bytes, "
+              << plainSize << " without" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (compressor->TrainDictionary(block.data(), 10, block.size()) ||
+    compressor->GetDictionarySize() != 0)
+  {
+    std::cerr << "A dictionary was trained on too few data" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
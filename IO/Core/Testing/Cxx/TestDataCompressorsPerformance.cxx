@@ -0,0 +1,195 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataCompressorsPerformance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test speed and ratio of the data compressors.
+// .SECTION Description
+// Compresses representative float and int arrays by blocks, as the XML
+// writers do, with each compressor at a few levels. Reports the ratio and
+// the compression and decompression speeds, and checks the round trip.
+
+#include "vtkDataCompressor.h"
+#include "vtkIOCoreConfigure.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkLZMADataCompressor.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkZLibDataCompressor.h"
+
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Number of values of the arrays and size of the compressed blocks.
+const size_t NumberOfValues = 1 << 16;
+const size_t BlockSize = 32768;
+
+struct Sample
+{
+  std::string Name;
+  std::vector<unsigned char> Data;
+};
+
+template <typename T>
+Sample MakeSample(const std::string& name, const std::vector<T>& values)
+{
+  Sample sample;
+  sample.Name = name;
+  sample.Data.resize(values.size() * sizeof(T));
+  std::memcpy(sample.Data.data(), values.data(), sample.Data.size());
+  return sample;
+}
+
+std::vector<Sample> MakeSamples()
+{
+  std::vector<Sample> samples;
+
+  // A smooth field, as a pressure or a temperature.
+  std::vector<float> smooth(NumberOfValues);
+  for (size_t i = 0; i < NumberOfValues; ++i)
+  {
+    smooth[i] = static_cast<float>(std::sin(i * 0.001) * std::cos(i * 0.00037));
+  }
+  samples.push_back(MakeSample("float smooth", smooth));
+
+  // The same field with noise in the low bits, as measured or turbulent data.
+  std::vector<double> noisy(NumberOfValues);
+  unsigned int seed = 12345;
+  for (size_t i = 0; i < NumberOfValues; ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    noisy[i] = smooth[i] + ((seed >> 8) % 1000) * 1e-7;
+  }
+  samples.push_back(MakeSample("double noisy", noisy));
+
+  // Region labels, as material ids.
+  std::vector<int> labels(NumberOfValues);
+  for (size_t i = 0; i < NumberOfValues; ++i)
+  {
+    labels[i] = static_cast<int>((i / 1000) % 7);
+  }
+  samples.push_back(MakeSample("int labels", labels));
+
+  // Connectivity-like increasing ids.
+  std::vector<long long> ids(NumberOfValues);
+  for (size_t i = 0; i < NumberOfValues; ++i)
+  {
+    ids[i] = static_cast<long long>(i / 4 + (i % 4) * 17);
+  }
+  samples.push_back(MakeSample("int64 ids", ids));
+
+  return samples;
+}
+
+bool Measure(const std::string& name, vtkDataCompressor* compressor, const Sample& sample)
+{
+  const std::vector<unsigned char>& data = sample.Data;
+  size_t numberOfBlocks = (data.size() + BlockSize - 1) / BlockSize;
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> blocks(numberOfBlocks);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  size_t compressedSize = 0;
+  for (size_t b = 0; b < numberOfBlocks; ++b)
+  {
+    size_t size = std::min(BlockSize, data.size() - b * BlockSize);
+    blocks[b].TakeReference(compressor->Compress(data.data() + b * BlockSize, size));
+    if (!blocks[b])
+    {
+      std::cerr << name << " failed to compress " << sample.Name << std::endl;
+      return false;
+    }
+    compressedSize += static_cast<size_t>(blocks[b]->GetNumberOfValues());
+  }
+  timer->StopTimer();
+  double compressTime = timer->GetElapsedTime();
+
+  std::vector<unsigned char> result(data.size());
+  timer->StartTimer();
+  for (size_t b = 0; b < numberOfBlocks; ++b)
+  {
+    size_t size = std::min(BlockSize, data.size() - b * BlockSize);
+    if (compressor->Uncompress(blocks[b]->GetPointer(0),
+          static_cast<size_t>(blocks[b]->GetNumberOfValues()), result.data() + b * BlockSize,
+          size) != size)
+    {
+      std::cerr << name << " failed to uncompress " << sample.Name << std::endl;
+      return false;
+    }
+  }
+  timer->StopTimer();
+  double uncompressTime = timer->GetElapsedTime();
+
+  if (result != data)
+  {
+    std::cerr << name << " did not give back " << sample.Name << std::endl;
+    return false;
+  }
+
+  double megaBytes = data.size() / (1024. * 1024.);
+  std::cout << std::left << std::setw(10) << name << std::setw(14) << sample.Name << std::right
+            << std::fixed << std::setprecision(2) << std::setw(8)
+            << static_cast<double>(data.size()) / compressedSize << std::setprecision(1)
+            << std::setw(10) << megaBytes / std::max(compressTime, 1e-9) << std::setw(10)
+            << megaBytes / std::max(uncompressTime, 1e-9) << std::endl;
+  return true;
+}
+}
+
+int TestDataCompressorsPerformance(int, char*[])
+{
+  std::vector<Sample> samples = MakeSamples();
+
+  std::cout << std::left << std::setw(10) << "codec" << std::setw(14) << "array" << std::right
+            << std::setw(8) << "ratio" << std::setw(10) << "MB/s in" << std::setw(10) << "MB/s out"
+            << std::endl;
+
+  bool result = true;
+  const int levels[] = { 1, 5, 9 };
+  for (int level : levels)
+  {
+    std::vector<std::pair<std::string, vtkSmartPointer<vtkDataCompressor>>> compressors;
+    compressors.emplace_back("zlib", vtkSmartPointer<vtkZLibDataCompressor>::New());
+    compressors.emplace_back("lz4", vtkSmartPointer<vtkLZ4DataCompressor>::New());
+    vtkSmartPointer<vtkLZ4DataCompressor> lz4hc = vtkSmartPointer<vtkLZ4DataCompressor>::New();
+    lz4hc->HighCompressionOn();
+    compressors.emplace_back("lz4hc", lz4hc);
+    compressors.emplace_back("lzma", vtkSmartPointer<vtkLZMADataCompressor>::New());
+#ifdef VTK_USE_ZSTD
+    compressors.emplace_back("zstd", vtkSmartPointer<vtkZstdDataCompressor>::New());
+#endif
+
+    for (auto& compressor : compressors)
+    {
+      compressor.second->SetCompressionLevel(level);
+      std::string name = compressor.first + "-" + std::to_string(level);
+      for (const Sample& sample : samples)
+      {
+        result &= Measure(name, compressor.second, sample);
+      }
+    }
+  }
+  return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -22,6 +22,7 @@ vtkStandardNewMacro(vtkLZ4DataCompressor);
 vtkLZ4DataCompressor::vtkLZ4DataCompressor()
 {
   this->AccelerationLevel = 1;
+  this->HighCompression = false;
 }
 
 //------------------------------------------------------------------------------
@@ -33,6 +34,7 @@ void vtkLZ4DataCompressor::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "AccelerationLevel: " << this->AccelerationLevel << endl;
+  os << indent << "HighCompression: " << this->HighCompression << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -42,8 +44,20 @@ size_t vtkLZ4DataCompressor::CompressBuffer(unsigned char const* uncompressedDat
   const char* ud = reinterpret_cast<const char*>(uncompressedData);
   char* cd = reinterpret_cast<char*>(compressedData);
   // Call LZ4's compress function.
-  int cs = LZ4_compress_fast(ud, cd, static_cast<int>(uncompressedSize),
-    static_cast<int>(compressionSpace), this->AccelerationLevel);
+  int cs;
+  if (this->HighCompression)
+  {
+    // Compression levels 1 to 9, i.e. 10 - AccelerationLevel, select the
+    // LZ4 HC levels 4 to 12.
+    int level = this->AccelerationLevel < 9 ? 13 - this->AccelerationLevel : 4;
+    cs = LZ4_compress_HC(
+      ud, cd, static_cast<int>(uncompressedSize), static_cast<int>(compressionSpace), level);
+  }
+  else
+  {
+    cs = LZ4_compress_fast(ud, cd, static_cast<int>(uncompressedSize),
+      static_cast<int>(compressionSpace), this->AccelerationLevel);
+  }
   if (cs == 0)
   {
     vtkErrorMacro("LZ4 error while compressing data.");
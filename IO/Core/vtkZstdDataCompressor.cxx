@@ -0,0 +1,267 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZstdDataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkZstdDataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+
+#include <algorithm>
+#include <zdict.h>
+#include <zstd.h>
+
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+namespace
+{
+// zstd levels for the compression levels 1 to 9.
+const int ZstdLevels[9] = { 1, 2, 3, 5, 7, 9, 12, 15, 19 };
+}
+
+// The XML writers compress blocks concurrently, so each thread has its own
+// contexts. They are expensive to create and are kept between blocks. The
+// digested dictionaries are read only and shared.
+class vtkZstdDataCompressor::vtkInternals
+{
+public:
+  struct Contexts
+  {
+    ZSTD_CCtx* Compression = nullptr;
+    ZSTD_DCtx* Decompression = nullptr;
+
+    // Copies, from the thread local exemplar, do not share the contexts.
+    Contexts() = default;
+    Contexts(const Contexts&) {}
+    Contexts& operator=(const Contexts&) { return *this; }
+    ~Contexts()
+    {
+      ZSTD_freeCCtx(this->Compression);
+      ZSTD_freeDCtx(this->Decompression);
+    }
+  };
+
+  vtkSMPThreadLocal<Contexts> LocalContexts;
+  ZSTD_CDict* CompressionDictionary = nullptr;
+  ZSTD_DDict* DecompressionDictionary = nullptr;
+
+  ~vtkInternals()
+  {
+    ZSTD_freeCDict(this->CompressionDictionary);
+    ZSTD_freeDDict(this->DecompressionDictionary);
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+{
+  this->CompressionLevel = 3;
+  this->MaximumDictionarySize = 16384;
+  this->TrainDictionaries = false;
+  this->Internals = new vtkInternals;
+}
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor()
+{
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+  os << indent << "DictionarySize: " << this->Dictionary.size() << endl;
+  os << indent << "MaximumDictionarySize: " << this->MaximumDictionarySize << endl;
+  os << indent << "TrainDictionaries: " << (this->TrainDictionaries ? "On" : "Off") << endl;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  vtkInternals::Contexts& contexts = this->Internals->LocalContexts.Local();
+  if (!contexts.Compression)
+  {
+    contexts.Compression = ZSTD_createCCtx();
+  }
+
+  size_t cs;
+  if (this->Internals->CompressionDictionary)
+  {
+    cs = ZSTD_compress_usingCDict(contexts.Compression, compressedData, compressionSpace,
+      uncompressedData, uncompressedSize, this->Internals->CompressionDictionary);
+  }
+  else
+  {
+    cs = ZSTD_compressCCtx(contexts.Compression, compressedData, compressionSpace,
+      uncompressedData, uncompressedSize, ZstdLevels[this->CompressionLevel - 1]);
+  }
+  if (ZSTD_isError(cs))
+  {
+    vtkErrorMacro("Zstd error while compressing data: " << ZSTD_getErrorName(cs));
+    return 0;
+  }
+  return cs;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  vtkInternals::Contexts& contexts = this->Internals->LocalContexts.Local();
+  if (!contexts.Decompression)
+  {
+    contexts.Decompression = ZSTD_createDCtx();
+  }
+
+  size_t us;
+  if (this->Internals->DecompressionDictionary)
+  {
+    us = ZSTD_decompress_usingDDict(contexts.Decompression, uncompressedData, uncompressedSize,
+      compressedData, compressedSize, this->Internals->DecompressionDictionary);
+  }
+  else
+  {
+    us = ZSTD_decompressDCtx(
+      contexts.Decompression, uncompressedData, uncompressedSize, compressedData, compressedSize);
+  }
+  if (ZSTD_isError(us))
+  {
+    vtkErrorMacro("Zstd error while uncompressing data: " << ZSTD_getErrorName(us));
+    return 0;
+  }
+  // Make sure the output size matched that expected.
+  if (us != uncompressedSize)
+  {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected "
+      << uncompressedSize << " and got " << us);
+    return 0;
+  }
+  return us;
+}
+
+//------------------------------------------------------------------------------
+int vtkZstdDataCompressor::GetCompressionLevel()
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << this->CompressionLevel);
+  return this->CompressionLevel;
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  int min = 1;
+  int max = 9;
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  int level = compressionLevel < min ? min : (compressionLevel > max ? max : compressionLevel);
+  if (this->CompressionLevel != level)
+  {
+    this->CompressionLevel = level;
+    this->UpdateDictionaries();
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetDictionary(const unsigned char* dictionary, size_t size)
+{
+  if (!dictionary)
+  {
+    size = 0;
+  }
+  // The XML readers set the dictionary of each array, which is often the
+  // same one: digesting it again would be wasted.
+  if (size == this->Dictionary.size() &&
+    std::equal(dictionary, dictionary + size, this->Dictionary.begin()))
+  {
+    return;
+  }
+  this->Dictionary.assign(dictionary, dictionary + size);
+  this->UpdateDictionaries();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+bool vtkZstdDataCompressor::TrainDictionary(
+  const unsigned char* data, size_t size, size_t blockSize)
+{
+  if (!data || blockSize == 0)
+  {
+    size = 0;
+    blockSize = 1;
+  }
+
+  // Take every step-th block, so that the samples cover the data without
+  // making the training too long.
+  const size_t numberOfBlocks = (size + blockSize - 1) / blockSize;
+  const size_t maximumSamples = std::max<size_t>(100 * this->MaximumDictionarySize / blockSize, 1);
+  const size_t step = std::max<size_t>((numberOfBlocks + maximumSamples - 1) / maximumSamples, 1);
+  std::vector<unsigned char> samples;
+  std::vector<size_t> sampleSizes;
+  for (size_t block = 0; block < numberOfBlocks; block += step)
+  {
+    const size_t begin = block * blockSize;
+    const size_t sampleSize = std::min(blockSize, size - begin);
+    samples.insert(samples.end(), data + begin, data + begin + sampleSize);
+    sampleSizes.push_back(sampleSize);
+  }
+
+  if (sampleSizes.empty())
+  {
+    this->SetDictionary(nullptr, 0);
+    return false;
+  }
+  std::vector<unsigned char> dictionary(this->MaximumDictionarySize);
+  const size_t dictionarySize = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(),
+    samples.data(), sampleSizes.data(), static_cast<unsigned int>(sampleSizes.size()));
+  if (ZDICT_isError(dictionarySize))
+  {
+    vtkDebugMacro("Cannot train a dictionary on " << sampleSizes.size() << " blocks: "
+                                                  << ZDICT_getErrorName(dictionarySize));
+    this->SetDictionary(nullptr, 0);
+    return false;
+  }
+  this->SetDictionary(dictionary.data(), dictionarySize);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::UpdateDictionaries()
+{
+  // The dictionaries are digested here rather than on first use, because
+  // blocks may be compressed concurrently. The compression dictionary
+  // depends on the level.
+  vtkInternals* internals = this->Internals;
+  ZSTD_freeCDict(internals->CompressionDictionary);
+  internals->CompressionDictionary = nullptr;
+  ZSTD_freeDDict(internals->DecompressionDictionary);
+  internals->DecompressionDictionary = nullptr;
+  if (!this->Dictionary.empty())
+  {
+    internals->CompressionDictionary = ZSTD_createCDict(
+      this->Dictionary.data(), this->Dictionary.size(), ZstdLevels[this->CompressionLevel - 1]);
+    internals->DecompressionDictionary =
+      ZSTD_createDDict(this->Dictionary.data(), this->Dictionary.size());
+  }
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
@@ -0,0 +1,131 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZstdDataCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkZstdDataCompressor
+ * @brief   Data compression using Zstandard.
+ *
+ * vtkZstdDataCompressor provides a concrete vtkDataCompressor class
+ * using zstd for compressing and uncompressing data. It is only available
+ * when VTK is built with `VTK_USE_ZSTD` against an external zstd library.
+ *
+ * An optional dictionary, trained with TrainDictionary() or `zstd --train`
+ * on blocks of similar data, improves the compression of small blocks. Data
+ * compressed with a dictionary can only be uncompressed with the same
+ * dictionary: the XML writers store the dictionary used for each array with
+ * the array, and the XML readers use it to uncompress the array. With
+ * TrainDictionaries on, the XML writers train a dictionary for each array.
+ *
+ * Blocks may be compressed and uncompressed concurrently.
+ */
+
+#ifndef vtkZstdDataCompressor_h
+#define vtkZstdDataCompressor_h
+
+#include "vtkDataCompressor.h"
+#include "vtkIOCoreModule.h" // For export macro
+
+#include <vector> // For Dictionary
+
+class VTKIOCORE_EXPORT vtkZstdDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZstdDataCompressor, vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkZstdDataCompressor* New();
+
+  /**
+   *  Get the maximum space that may be needed to store data of the
+   *  given uncompressed size after compression.  This is the minimum
+   *  size of the output buffer that can be passed to the four-argument
+   *  Compress method.
+   */
+  size_t GetMaximumCompressionSpace(size_t size) override;
+
+  ///@{
+  /**
+   * Get/Set the compression level, from 1 (fastest) to 9 (best
+   * compression). The levels are mapped to the zstd levels 1 to 19.
+   */
+  int GetCompressionLevel() override;
+  void SetCompressionLevel(int compressionLevel) override;
+  ///@}
+
+  ///@{
+  /**
+   * Set the dictionary used to compress and uncompress data. The data are
+   * copied. Pass a null pointer or a zero size to remove the dictionary.
+   */
+  void SetDictionary(const unsigned char* dictionary, size_t size);
+  const unsigned char* GetDictionary() const
+  {
+    return this->Dictionary.empty() ? nullptr : this->Dictionary.data();
+  }
+  size_t GetDictionarySize() const { return this->Dictionary.size(); }
+  ///@}
+
+  /**
+   * Train a dictionary on data that will be compressed in blocks of
+   * blockSize bytes, and use it. At most 100 times MaximumDictionarySize
+   * bytes, in blocks spread over the data, are used for the training.
+   * Returns false, and removes the dictionary, when zstd cannot train one,
+   * e.g. because the data have too few blocks.
+   */
+  bool TrainDictionary(const unsigned char* data, size_t size, size_t blockSize);
+
+  ///@{
+  /**
+   * Get/Set the maximum size of the trained dictionaries, 16 KiB by default.
+   */
+  vtkSetClampMacro(MaximumDictionarySize, size_t, 256, 1 << 20);
+  vtkGetMacro(MaximumDictionarySize, size_t);
+  ///@}
+
+  ///@{
+  /**
+   * When on, the XML writers train a dictionary for each array they write
+   * (see TrainDictionary()) and store it in the file. Off by default.
+   */
+  vtkSetMacro(TrainDictionaries, bool);
+  vtkGetMacro(TrainDictionaries, bool);
+  vtkBooleanMacro(TrainDictionaries, bool);
+  ///@}
+
+protected:
+  vtkZstdDataCompressor();
+  ~vtkZstdDataCompressor() override;
+
+  int CompressionLevel;
+  std::vector<unsigned char> Dictionary;
+  size_t MaximumDictionarySize;
+  bool TrainDictionaries;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override;
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t uncompressedSize) override;
+
+private:
+  vtkZstdDataCompressor(const vtkZstdDataCompressor&) = delete;
+  void operator=(const vtkZstdDataCompressor&) = delete;
+
+  void UpdateDictionaries();
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -73,6 +73,9 @@ vtkExodusIICache::vtkExodusIICache()
 {
   this->Size = 0.;
   this->Capacity = 2.;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NotFound = nullptr;
 }
 
 vtkExodusIICache::~vtkExodusIICache()
@@ -87,6 +90,8 @@ void vtkExodusIICache::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Size: " << this->Size << " MiB\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
 }
 
 void vtkExodusIICache::Clear()
@@ -196,18 +201,24 @@ void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value)
 
 vtkDataArray*& vtkExodusIICache::Find(const vtkExodusIICacheKey& key)
 {
-  static vtkDataArray* dummy = nullptr;
-
   vtkExodusIICacheRef it = this->Cache.find(key);
   if (it != this->Cache.end())
   {
+    ++this->NumberOfHits;
     this->LRU.erase(it->second->LRUEntry);
     it->second->LRUEntry = this->LRU.insert(this->LRU.begin(), it);
     return it->second->Value;
   }
 
-  dummy = nullptr;
-  return dummy;
+  ++this->NumberOfMisses;
+  this->NotFound = nullptr;
+  return this->NotFound;
+}
+
+void vtkExodusIICache::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
 }
 
 int vtkExodusIICache::Invalidate(const vtkExodusIICacheKey& key)
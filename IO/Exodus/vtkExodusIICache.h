@@ -167,6 +167,15 @@ public:
    */
   int Invalidate(const vtkExodusIICacheKey& key, const vtkExodusIICacheKey& pattern);
 
+  /// Number of calls to Find() that returned an entry since the last ResetStatistics().
+  vtkGetMacro(NumberOfHits, vtkIdType);
+
+  /// Number of calls to Find() that returned nullptr since the last ResetStatistics().
+  vtkGetMacro(NumberOfMisses, vtkIdType);
+
+  /// Reset the hit and miss counts.
+  void ResetStatistics();
+
 protected:
   /// Default constructor
   vtkExodusIICache();
@@ -195,6 +204,16 @@ protected:
   /// The actual LRU list (indices into the cache ordered least to most recently used).
   vtkExodusIICacheLRU LRU;
 
+  /// The hit and miss counts of Find().
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
+
+  /** What Find() returns a reference to when the key does not exist.
+   * This is a member rather than a static so that readers running on
+   * different threads do not share it.
+   */
+  vtkDataArray* NotFound;
+
 private:
   vtkExodusIICache(const vtkExodusIICache&) = delete;
   void operator=(const vtkExodusIICache&) = delete;
@@ -315,6 +315,11 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
 
+  this->PrefetchNextTimeStep = false;
+  this->CurrentTimeStep = -1;
+  this->CurrentTimeStepSize = 0.;
+  this->PrefetchedTimeStep = -1;
+
   this->HasModeShapes = 0;
   this->ModeShapeTime = -1.;
   this->AnimateModeShapes = 1;
@@ -345,6 +350,7 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 //------------------------------------------------------------------------------
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
+  this->DiscardPrefetch();
   this->CloseFile();
   this->Cache->Delete();
   this->CacheSize = 0;
@@ -1591,14 +1597,43 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
     arr = this->Cache->Find(key);
   }
 
-  if (arr)
+  if (!arr)
   {
-    //
-    return arr;
+    arr = this->ReadArray(key, this->Exoid);
+
+    // Even if the array is larger than the allowable cache size, it will keep the most recent
+    // insertion. So, we delete our reference knowing that the Cache will keep the object "alive"
+    // until whatever called GetCacheOrRead() references the array. But, once you get an array from
+    // GetCacheOrRead(), you better start running!
+    if (arr)
+    {
+      this->Cache->Insert(key, arr);
+      arr->FastDelete();
+    }
   }
 
-  int exoid = this->Exoid;
-  int maxNameLength = this->Parent->GetMaxNameLength();
+  // Remember the results arrays of the time step being read, to prefetch them for the next one.
+  if (arr && key.Time >= 0 && key.Time == this->CurrentTimeStep &&
+    (key.ObjectType == vtkExodusIIReader::GLOBAL || key.ObjectType == vtkExodusIIReader::NODAL ||
+      key.ObjectType == vtkExodusIIReader::EDGE_BLOCK ||
+      key.ObjectType == vtkExodusIIReader::FACE_BLOCK ||
+      key.ObjectType == vtkExodusIIReader::ELEM_BLOCK ||
+      key.ObjectType == vtkExodusIIReader::NODE_SET ||
+      key.ObjectType == vtkExodusIIReader::EDGE_SET ||
+      key.ObjectType == vtkExodusIIReader::FACE_SET ||
+      key.ObjectType == vtkExodusIIReader::SIDE_SET ||
+      key.ObjectType == vtkExodusIIReader::ELEM_SET) &&
+    this->CurrentTimeStepKeys.insert(key).second)
+  {
+    this->CurrentTimeStepSize += arr->GetActualMemorySize() / 1024.;
+  }
+  return arr;
+}
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkExodusIIReaderPrivate::ReadArray(vtkExodusIICacheKey key, int exoid)
+{
+  vtkDataArray* arr = nullptr;
 
   // If array is nullptr, try reading it from file.
   if (key.ObjectType == vtkExodusIIReader::GLOBAL)
@@ -2824,6 +2859,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
     char* cdum = nullptr;
     int i, j;
 
+    int maxNameLength = this->Parent->GetMaxNameLength();
     vtkCharArray* carr = vtkCharArray::New();
     carr->SetName("QA_Records");
     carr->SetNumberOfComponents(maxNameLength + 1);
@@ -2889,17 +2925,75 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
                                                                   << " which I know nothing about");
     arr = nullptr;
   }
+  return arr;
+}
 
-  // Even if the array is larger than the allowable cache size, it will keep the most recent
-  // insertion. So, we delete our reference knowing that the Cache will keep the object "alive"
-  // until whatever called GetCacheOrRead() references the array. But, once you get an array from
-  // GetCacheOrRead(), you better start running!
-  if (arr)
+//------------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::StartPrefetch(vtkIdType timeStep)
+{
+#ifndef EXODUS_THREADSAFE
+  // The exodus calls of the background read would not be serialized with
+  // the ones of the main thread.
+  (void)timeStep;
+#else
+  // The prefetched arrays would not stay in the cache if the current ones do not fit.
+  if (!this->PrefetchNextTimeStep || this->HasModeShapes || this->CurrentTimeStepKeys.empty() ||
+    timeStep >= this->GetNumberOfTimeSteps() || this->CurrentTimeStepSize > this->CacheSize)
   {
-    this->Cache->Insert(key, arr);
-    arr->FastDelete();
+    return;
+  }
+
+  std::vector<vtkExodusIICacheKey> keys(
+    this->CurrentTimeStepKeys.begin(), this->CurrentTimeStepKeys.end());
+  for (auto& key : keys)
+  {
+    key.Time = static_cast<int>(timeStep);
+  }
+  this->PrefetchedTimeStep = timeStep;
+
+  // RequestData closes the file, so read through another handle.
+  std::string fileName = this->Parent->GetFileName();
+  this->Prefetch = std::async(std::launch::async, [this, keys, fileName]() {
+    int appWordSize = this->AppWordSize;
+    int diskWordSize = this->DiskWordSize;
+    float exodusVersion;
+    int exoid = ex_open(fileName.c_str(), EX_READ, &appWordSize, &diskWordSize, &exodusVersion);
+    if (exoid < 0)
+    {
+      return;
+    }
+#ifdef VTK_USE_64BIT_IDS
+    ex_set_int64_status(exoid, EX_ALL_INT64_API);
+#endif
+    for (const auto& key : keys)
+    {
+      vtkSmartPointer<vtkDataArray> arr;
+      arr.TakeReference(this->ReadArray(key, exoid));
+      if (arr)
+      {
+        this->PrefetchedArrays.emplace_back(key, arr);
+      }
+    }
+    ex_close(exoid);
+  });
+#endif
+}
+
+//------------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::WaitForPrefetch()
+{
+  if (this->Prefetch.valid())
+  {
+    this->Prefetch.get();
   }
-  return arr;
+}
+
+//------------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::DiscardPrefetch()
+{
+  this->WaitForPrefetch();
+  this->PrefetchedArrays.clear();
+  this->PrefetchedTimeStep = -1;
 }
 
 //------------------------------------------------------------------------------
@@ -3719,6 +3813,7 @@ void vtkExodusIIReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ModeShapesRange:  [ " << this->GetModeShapesRange()[0] << ", "
      << this->GetModeShapesRange()[1] << "]\n";
   os << indent << "IgnoreFileTime: " << this->GetIgnoreFileTime() << "\n";
+  os << indent << "PrefetchNextTimeStep: " << this->GetPrefetchNextTimeStep() << "\n";
   os << indent << "SILUpdateStamp: " << this->SILUpdateStamp << "\n";
   os << indent << "UseLegacyBlockNames: " << this->UseLegacyBlockNames << "\n";
   if (this->Metadata)
@@ -3862,6 +3957,10 @@ int vtkExodusIIReaderPrivate::OpenFile(const char* filename)
     this->CloseFile();
   }
 
+  // Do not overlap the calls of the background read with the ones made
+  // while the file is open.
+  this->WaitForPrefetch();
+
   this->Exoid =
     ex_open(filename, EX_READ, &this->AppWordSize, &this->DiskWordSize, &this->ExodusVersion);
   if (this->Exoid <= 0)
@@ -4013,6 +4112,9 @@ void vtkExodusIIReaderPrivate::BuildSIL()
 //------------------------------------------------------------------------------
 int vtkExodusIIReaderPrivate::RequestInformation()
 {
+  // The arrays read in the background may not match the new metadata.
+  this->DiscardPrefetch();
+
   int exoid = this->Exoid;
   // int itmp[5];
   vtkIdType* ids;
@@ -4529,6 +4631,21 @@ int vtkExodusIIReaderPrivate::RequestData(vtkIdType timeStep, vtkMultiBlockDataS
     vtkErrorMacro("You must specify an output mesh");
   }
 
+  // Use the arrays read in the background if they are for this time step.
+  this->WaitForPrefetch();
+  if (this->PrefetchedTimeStep == timeStep)
+  {
+    for (auto& prefetched : this->PrefetchedArrays)
+    {
+      this->Cache->Insert(prefetched.first, prefetched.second);
+    }
+  }
+  this->PrefetchedArrays.clear();
+  this->PrefetchedTimeStep = -1;
+  this->CurrentTimeStep = timeStep;
+  this->CurrentTimeStepKeys.clear();
+  this->CurrentTimeStepSize = 0.;
+
   // Iterate over all block and set types, creating a
   // multiblock dataset to hold objects of each type.
   int conntypidx;
@@ -4622,6 +4739,9 @@ int vtkExodusIIReaderPrivate::RequestData(vtkIdType timeStep, vtkMultiBlockDataS
 
   this->CloseFile();
 
+  this->CurrentTimeStep = -1;
+  this->StartPrefetch(timeStep + 1);
+
   return 0;
 }
 
@@ -4806,6 +4926,7 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 
 void vtkExodusIIReaderPrivate::ResetCache()
 {
+  this->DiscardPrefetch();
   this->Cache->Clear();
   this->Cache->SetCacheCapacity(
     this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
@@ -5790,6 +5911,17 @@ bool vtkExodusIIReader::GetIgnoreFileTime()
   return this->Metadata->GetIgnoreFileTime();
 }
 
+void vtkExodusIIReader::SetPrefetchNextTimeStep(bool value)
+{
+  // The output does not depend on it, so the reader is not modified.
+  this->Metadata->SetPrefetchNextTimeStep(value);
+}
+
+bool vtkExodusIIReader::GetPrefetchNextTimeStep()
+{
+  return this->Metadata->GetPrefetchNextTimeStep();
+}
+
 const char* vtkExodusIIReader::GetTitle()
 {
   return this->Metadata->ModelParameters.title;
@@ -6747,6 +6879,21 @@ double vtkExodusIIReader::GetCacheSize()
   return this->Metadata->GetCacheSize();
 }
 
+vtkIdType vtkExodusIIReader::GetNumberOfCacheHits()
+{
+  return this->Metadata->GetCache()->GetNumberOfHits();
+}
+
+vtkIdType vtkExodusIIReader::GetNumberOfCacheMisses()
+{
+  return this->Metadata->GetCache()->GetNumberOfMisses();
+}
+
+void vtkExodusIIReader::ResetCacheStatistics()
+{
+  this->Metadata->GetCache()->ResetStatistics();
+}
+
 void vtkExodusIIReader::SetSqueezePoints(bool sp)
 {
   this->Metadata->SetSqueezePoints(sp ? 1 : 0);
@@ -350,6 +350,25 @@ public:
   vtkBooleanMacro(IgnoreFileTime, bool);
   ///@}
 
+  ///@{
+  /**
+   * When on, after reading a time step, the reader starts reading the same
+   * results variables for the next time step in a background thread, so
+   * that they are in the cache when that time step is requested. This is
+   * done only if the variables of a time step fit in the cache (see
+   * SetCacheSize()). Default is off.
+   *
+   * This is ignored when the exodus library is not built thread safe, as on
+   * Windows. The exodus library serializes its own calls, but not the ones
+   * of other netCDF users: do not turn this on if other netCDF based readers,
+   * such as vtkNetCDFReader, may run while the reader waits for its next
+   * request.
+   */
+  virtual void SetPrefetchNextTimeStep(bool flag);
+  bool GetPrefetchNextTimeStep();
+  vtkBooleanMacro(PrefetchNextTimeStep, bool);
+  ///@}
+
   ///@{
   /**
    * Access to meta data generated by UpdateInformation.
@@ -791,6 +810,16 @@ public:
    */
   double GetCacheSize();
 
+  ///@{
+  /**
+   * Number of arrays found in the cache, and of arrays read from the file,
+   * since the last call to ResetCacheStatistics().
+   */
+  virtual vtkIdType GetNumberOfCacheHits();
+  virtual vtkIdType GetNumberOfCacheMisses();
+  virtual void ResetCacheStatistics();
+  ///@}
+
   ///@{
   /**
    * Should the reader output only points used by elements in the output mesh,
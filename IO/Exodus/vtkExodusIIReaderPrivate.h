@@ -8,11 +8,15 @@
 #include "vtkExodusIICache.h"  // for vtkExodusIICacheKey
 #include "vtkExodusIIReader.h" // for vtkExodusIIReader
 #include "vtkObject.h"
+#include "vtkSmartPointer.h"            // for vtkSmartPointer
 #include "vtkStdString.h"               // for vtkStdString
 #include "vtksys/RegularExpression.hxx" // for vtksys::RegularExpression
 
-#include <map>    // for std::map
-#include <vector> // for std::vector
+#include <future>  // for std::future
+#include <map>     // for std::map
+#include <set>     // for std::set
+#include <utility> // for std::pair
+#include <vector>  // for std::vector
 
 #include "vtkIOExodusModule.h" // For export macro
 #include "vtk_exodusII.h"      // for exodus APIs
@@ -86,6 +90,9 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /// Return the cache, for its statistics.
+  vtkExodusIICache* GetCache() { return this->Cache; }
+
   /** Return the number of time steps in the open file.
    * You must have called RequestInformation() before
    * invoking this member function.
@@ -261,6 +268,9 @@ public:
   vtkSetMacro(IgnoreFileTime, bool);
   vtkGetMacro(IgnoreFileTime, bool);
 
+  vtkSetMacro(PrefetchNextTimeStep, bool);
+  vtkGetMacro(PrefetchNextTimeStep, bool);
+
   vtkDataArray* FindDisplacementVectors(int timeStep);
 
   const struct ex_init_params* GetModelParams() const { return &this->ModelParameters; }
@@ -631,6 +641,27 @@ protected:
    */
   vtkDataArray* GetCacheOrRead(vtkExodusIICacheKey);
 
+  /** Read the array of the specified cache key from the file with handle
+   * \a exoid, without looking into the cache or inserting into it. The
+   * caller owns the returned array. Time-varying results arrays may be read
+   * this way from another thread when the Exodus library is built thread
+   * safe, as it then serializes its calls.
+   */
+  vtkDataArray* ReadArray(vtkExodusIICacheKey, int exoid);
+
+  /** Start reading in the background the results arrays of the given time
+   * step that were read for the current one, when PrefetchNextTimeStep is on
+   * and they fit in the cache. Does nothing unless EXODUS_THREADSAFE is
+   * defined. OpenFile() waits for the background read to finish.
+   */
+  void StartPrefetch(vtkIdType timeStep);
+
+  /// Wait for the arrays being read in the background.
+  void WaitForPrefetch();
+
+  /// Wait for the arrays being read in the background and drop them.
+  void DiscardPrefetch();
+
   /** Return the index of an object type (in a private list of all object types).
    * This returns a 0-based index if the object type was found and -1 if it
    * was not.
@@ -817,6 +848,23 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /// Whether to read the results arrays of the next time step in the background.
+  bool PrefetchNextTimeStep;
+
+  /** The time step being read by RequestData, and the keys and total size in
+   * MiB of the results arrays read for it.
+   */
+  vtkIdType CurrentTimeStep;
+  std::set<vtkExodusIICacheKey> CurrentTimeStepKeys;
+  double CurrentTimeStepSize;
+
+  /** The arrays read in the background, inserted into the cache when their
+   * time step is requested.
+   */
+  std::future<void> Prefetch;
+  vtkIdType PrefetchedTimeStep;
+  std::vector<std::pair<vtkExodusIICacheKey, vtkSmartPointer<vtkDataArray>>> PrefetchedArrays;
+
   vtkTypeBool ApplyDisplacements;
   float DisplacementMagnitude;
   vtkTypeBool HasModeShapes;
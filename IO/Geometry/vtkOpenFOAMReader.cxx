@@ -191,6 +191,7 @@
 #include "vtkPolyhedron.h"
 #include "vtkPyramid.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -202,6 +203,7 @@
 #include "vtkTypeInt8Array.h"
 #include "vtkTypeTraits.h"
 #include "vtkTypeUInt8Array.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkVertex.h"
 #include "vtkWedge.h"
@@ -1236,6 +1238,17 @@ private:
 #endif
   );
 
+  // Insert a range of cells into a grid or a vtkFoamCellChunk
+  template <typename GridT>
+  void InsertCells(GridT* grid, vtkIdType begin, vtkIdType end,
+    const vtkFoamLabelListList& meshCells, const vtkFoamLabelListList& meshFaces,
+    vtkIdList* cellLabels
+#if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
+    ,
+    vtkIdTypeArray* additionalCells, vtkFloatArray* pointArray
+#endif
+  );
+
   vtkUnstructuredGrid* MakeInternalMesh(std::unique_ptr<vtkFoamLabelListList>& meshCellsPtr,
     const vtkFoamLabelListList& meshFaces, vtkFloatArray* pointArray);
 
@@ -3621,6 +3634,22 @@ struct vtkFoamRead
       }
     }
 
+    // Read the binary contents of the tuples [start, start + nRead) of a list into data
+    static void ReadTuples(vtkFoamIOobject& io, primitiveT* data, vtkTypeInt64 start,
+      vtkTypeInt64 nRead, vtkTypeInt64 nTuples, vtkTypeInt64 tupleLength)
+    {
+      const vtkTypeInt64 readLength =
+        io.Read(reinterpret_cast<unsigned char*>(data), nRead * tupleLength);
+      if (readLength != nRead * tupleLength)
+      {
+        const vtkTypeInt64 i = start + std::max(readLength, vtkTypeInt64(0)) / tupleLength;
+        throw vtkFoamError() << "Failed to read tuple " << i << '/' << nTuples << ": Expected "
+                             << tupleLength << " bytes, got "
+                             << std::max(readLength - (i - start) * tupleLength, vtkTypeInt64(0))
+                             << " bytes.";
+      }
+    }
+
     void ReadBinaryList(vtkFoamIOobject& io)
     {
       const vtkTypeInt64 nTuples = this->Ptr->GetNumberOfTuples();
@@ -3652,21 +3681,38 @@ struct vtkFoamRead
         // Compiler hint for better unrolling:
         VTK_ASSUME(this->Ptr->GetNumberOfComponents() == nComponents);
 
-        const unsigned tupleLength = (sizeof(primitiveT) * nComponents);
-        primitiveT tuple[nComponents];
+        const vtkTypeInt64 tupleLength = (sizeof(primitiveT) * nComponents);
 
-        for (vtkTypeInt64 i = 0; i < nTuples; ++i)
+        if (typeid(ValueType) == typeid(primitiveT))
         {
-          const int readLength = io.Read(reinterpret_cast<unsigned char*>(tuple), tupleLength);
-          if (readLength != tupleLength)
+          // Same representation: decode the whole list straight into the array
+          auto* data = reinterpret_cast<primitiveT*>(this->Ptr->GetPointer(0));
+          ReadTuples(io, data, 0, nTuples, nTuples, tupleLength);
+          for (vtkTypeInt64 i = 0; nComponents == 6 && i < nTuples; ++i)
           {
-            throw vtkFoamError() << "Failed to read tuple " << i << '/' << nTuples << ": Expected "
-                                 << tupleLength << " bytes, got " << readLength << " bytes.";
+            ::remapFoamTuple<nComponents == 6>(data + nComponents * i); // For symmTensor
           }
-          ::remapFoamTuple<nComponents == 6>(tuple); // For symmTensor
-          for (int cmpt = 0; cmpt < nComponents; ++cmpt)
+        }
+        else
+        {
+          // Decode blocks of tuples, converted to the array type
+          const vtkTypeInt64 blockSize = 4096;
+          std::vector<primitiveT> buffer(nComponents * std::min(blockSize, nTuples));
+
+          for (vtkTypeInt64 start = 0; start < nTuples; start += blockSize)
           {
-            this->Ptr->SetTypedComponent(i, cmpt, static_cast<ValueType>(tuple[cmpt]));
+            const vtkTypeInt64 nBlockTuples = std::min(blockSize, nTuples - start);
+            ReadTuples(io, buffer.data(), start, nBlockTuples, nTuples, tupleLength);
+            ValueType* output = this->Ptr->GetPointer(nComponents * start);
+            for (vtkTypeInt64 i = 0; i < nBlockTuples; ++i)
+            {
+              primitiveT* tuple = buffer.data() + nComponents * i;
+              ::remapFoamTuple<nComponents == 6>(tuple); // For symmTensor
+              for (int cmpt = 0; cmpt < nComponents; ++cmpt)
+              {
+                output[nComponents * i + cmpt] = static_cast<ValueType>(tuple[cmpt]);
+              }
+            }
           }
         }
       }
@@ -7174,6 +7220,42 @@ bool vtkOpenFOAMReaderPrivate::CheckFaceList(const vtkFoamLabelListList& faces)
   return true;
 }
 
+//------------------------------------------------------------------------------
+// struct vtkFoamCellChunk
+// The cells of a range of the mesh, built by one thread before being
+// concatenated with the other ranges. Mirrors the vtkUnstructuredGrid layout,
+// with offsets relative to the chunk.
+struct vtkFoamCellChunk
+{
+  std::vector<unsigned char> Types;
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Connectivity;
+  std::vector<vtkIdType> FaceLocations; // -1 for non-polyhedral cells
+  std::vector<vtkIdType> Faces;         // nFaces, (nFacePoints, facePoints...) per polyhedron
+
+  void InsertNextCell(int type, vtkIdType npts, const vtkIdType pts[])
+  {
+    this->Types.push_back(static_cast<unsigned char>(type));
+    this->Offsets.push_back(static_cast<vtkIdType>(this->Connectivity.size()));
+    this->Connectivity.insert(this->Connectivity.end(), pts, pts + npts);
+    this->FaceLocations.push_back(-1);
+  }
+
+  void InsertNextCell(
+    int type, vtkIdType npts, const vtkIdType pts[], vtkIdType nfaces, const vtkIdType faces[])
+  {
+    this->InsertNextCell(type, npts, pts);
+    this->FaceLocations.back() = static_cast<vtkIdType>(this->Faces.size());
+    this->Faces.push_back(nfaces);
+    const vtkIdType* facesEnd = faces;
+    for (vtkIdType facei = 0; facei < nfaces; ++facei)
+    {
+      facesEnd += *facesEnd + 1;
+    }
+    this->Faces.insert(this->Faces.end(), faces, facesEnd);
+  }
+};
+
 //------------------------------------------------------------------------------
 // determine cell shape and insert the cell into the mesh
 // hexahedron, prism, pyramid, tetrahedron and decompose polyhedron
@@ -7186,21 +7268,9 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
 #endif
 )
 {
-  // Scratch arrays
-  vtkFoamStackVector<vtkIdType, 256> cellPoints;  // For inserting primitive cell points
-  vtkFoamStackVector<vtkIdType, 1024> polyPoints; // For inserting polyhedral faces and sizes
-  vtkFoamLabelListList::CellType cellFaces;       // For analyzing cell types (shapes)
-  vtkFoamLabelListList::CellType facePoints;      // For processing individual cell faces
-
-  const bool faceOwner64Bit = ::Is64BitArray(this->FaceOwner);
-  const bool cellLabels64Bit = faceOwner64Bit; // reasonable assumption
-
   const vtkIdType nCells = (cellLabels == nullptr ? this->NumCells : cellLabels->GetNumberOfIds());
 
 #if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
-  // Local variable for polyhedral decomposition
-  vtkIdType nAdditionalPoints = 0;
-
   if (additionalCells && cellLabels) // sanity check
   {
     vtkErrorMacro(<< "Decompose polyhedral is not supported on mesh subset");
@@ -7217,7 +7287,140 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
   }
   const auto& meshCells = *meshCellsPtr;
 
-  for (vtkIdType celli = 0; celli < nCells; ++celli)
+  // Number of cells built at once by a thread
+  const vtkIdType chunkSize = 8192;
+
+  // Insert directly when decomposing polyhedra, which appends points and
+  // cells as it goes, and for meshes too small to be worth the concatenation
+#if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
+  if (additionalCells || nCells <= chunkSize || internalMesh->GetNumberOfCells())
+  {
+    this->InsertCells(
+      internalMesh, 0, nCells, meshCells, meshFaces, cellLabels, additionalCells, pointArray);
+    return;
+  }
+#else
+  if (nCells <= chunkSize || internalMesh->GetNumberOfCells())
+  {
+    this->InsertCells(internalMesh, 0, nCells, meshCells, meshFaces, cellLabels);
+    return;
+  }
+#endif
+
+  // Build the chunks of cells concurrently
+  const vtkIdType nChunks = (nCells + chunkSize - 1) / chunkSize;
+  std::vector<vtkFoamCellChunk> chunks(nChunks);
+  vtkSMPTools::For(0, nChunks, 1, [&](vtkIdType firstChunk, vtkIdType lastChunk) {
+    for (vtkIdType chunki = firstChunk; chunki < lastChunk; ++chunki)
+    {
+      const vtkIdType begin = chunki * chunkSize;
+      const vtkIdType end = std::min(begin + chunkSize, nCells);
+      vtkFoamCellChunk& chunk = chunks[chunki];
+      chunk.Types.reserve(end - begin);
+      chunk.Offsets.reserve(end - begin);
+      chunk.FaceLocations.reserve(end - begin);
+      chunk.Connectivity.reserve(8 * (end - begin));
+#if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
+      this->InsertCells(&chunk, begin, end, meshCells, meshFaces, cellLabels, nullptr, nullptr);
+#else
+      this->InsertCells(&chunk, begin, end, meshCells, meshFaces, cellLabels);
+#endif
+    }
+  });
+
+  // Concatenate the chunks in order
+  std::vector<vtkIdType> cellStarts(nChunks + 1, 0);
+  std::vector<vtkIdType> connStarts(nChunks + 1, 0);
+  std::vector<vtkIdType> faceStarts(nChunks + 1, 0);
+  for (vtkIdType chunki = 0; chunki < nChunks; ++chunki)
+  {
+    const vtkFoamCellChunk& chunk = chunks[chunki];
+    cellStarts[chunki + 1] = cellStarts[chunki] + static_cast<vtkIdType>(chunk.Types.size());
+    connStarts[chunki + 1] = connStarts[chunki] + static_cast<vtkIdType>(chunk.Connectivity.size());
+    faceStarts[chunki + 1] = faceStarts[chunki] + static_cast<vtkIdType>(chunk.Faces.size());
+  }
+  const vtkIdType nInserted = cellStarts[nChunks];
+  const bool hasPolyhedra = (faceStarts[nChunks] > 0);
+
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(nInserted);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(nInserted + 1);
+  offsets->SetValue(nInserted, connStarts[nChunks]);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(connStarts[nChunks]);
+  vtkSmartPointer<vtkIdTypeArray> faceLocations;
+  vtkSmartPointer<vtkIdTypeArray> faces;
+  if (hasPolyhedra)
+  {
+    faceLocations = vtkSmartPointer<vtkIdTypeArray>::New();
+    faceLocations->SetNumberOfValues(nInserted);
+    faces = vtkSmartPointer<vtkIdTypeArray>::New();
+    faces->SetNumberOfValues(faceStarts[nChunks]);
+  }
+
+  vtkSMPTools::For(0, nChunks, 1, [&](vtkIdType firstChunk, vtkIdType lastChunk) {
+    for (vtkIdType chunki = firstChunk; chunki < lastChunk; ++chunki)
+    {
+      const vtkFoamCellChunk& chunk = chunks[chunki];
+      const vtkIdType cellStart = cellStarts[chunki];
+      const size_t nChunkCells = chunk.Types.size();
+      std::copy(chunk.Types.begin(), chunk.Types.end(), types->GetPointer(cellStart));
+      std::copy(chunk.Connectivity.begin(), chunk.Connectivity.end(),
+        connectivity->GetPointer(connStarts[chunki]));
+      vtkIdType* cellOffsets = offsets->GetPointer(cellStart);
+      for (size_t i = 0; i < nChunkCells; ++i)
+      {
+        cellOffsets[i] = chunk.Offsets[i] + connStarts[chunki];
+      }
+      if (hasPolyhedra)
+      {
+        std::copy(chunk.Faces.begin(), chunk.Faces.end(), faces->GetPointer(faceStarts[chunki]));
+        vtkIdType* cellFaceLocations = faceLocations->GetPointer(cellStart);
+        for (size_t i = 0; i < nChunkCells; ++i)
+        {
+          cellFaceLocations[i] =
+            (chunk.FaceLocations[i] < 0 ? -1 : chunk.FaceLocations[i] + faceStarts[chunki]);
+        }
+      }
+    }
+  });
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  internalMesh->SetCells(types, cells, faceLocations, faces);
+}
+
+//------------------------------------------------------------------------------
+// determine the shapes of the cells [begin, end) of the mesh, or of the
+// cellLabels subset, and insert them into the grid
+template <typename GridT>
+void vtkOpenFOAMReaderPrivate::InsertCells(GridT* grid, vtkIdType begin, vtkIdType end,
+  const vtkFoamLabelListList& meshCells, const vtkFoamLabelListList& meshFaces,
+  vtkIdList* cellLabels
+#if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
+  ,
+  vtkIdTypeArray* additionalCells, vtkFloatArray* pointArray
+#endif
+)
+{
+  // Scratch arrays
+  vtkFoamStackVector<vtkIdType, 256> cellPoints;  // For inserting primitive cell points
+  vtkFoamStackVector<vtkIdType, 1024> polyPoints; // For inserting polyhedral faces and sizes
+  vtkFoamLabelListList::CellType cellFaces;       // For analyzing cell types (shapes)
+  vtkFoamLabelListList::CellType facePoints;      // For processing individual cell faces
+
+  const bool faceOwner64Bit = ::Is64BitArray(this->FaceOwner);
+  const bool cellLabels64Bit = faceOwner64Bit; // reasonable assumption
+
+  const vtkIdType nCells = (cellLabels == nullptr ? this->NumCells : cellLabels->GetNumberOfIds());
+
+#if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
+  // Local variable for polyhedral decomposition
+  vtkIdType nAdditionalPoints = 0;
+#endif
+
+  for (vtkIdType celli = begin; celli < end; ++celli)
   {
     vtkIdType cellId = celli;
     if (cellLabels != nullptr)
@@ -7458,7 +7661,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
       }
 
       // Add HEXAHEDRON (hex) cell to the mesh
-      internalMesh->InsertNextCell(VTK_HEXAHEDRON, 8, cellPoints.data());
+      grid->InsertNextCell(VTK_HEXAHEDRON, 8, cellPoints.data());
     }
 
     // OpenFOAM "prism" | vtkWedge
@@ -7644,7 +7847,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
         }
 
         // Add WEDGE (prism) cell to the mesh
-        internalMesh->InsertNextCell(VTK_WEDGE, 6, cellPoints.data());
+        grid->InsertNextCell(VTK_WEDGE, 6, cellPoints.data());
       }
     }
 
@@ -7716,7 +7919,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
       cellPoints[nCellPoints++] = apexMeshPointi;
 
       // Add tetra or pyramid to the mesh
-      internalMesh->InsertNextCell(cellType, nCellPoints, cellPoints.data());
+      grid->InsertNextCell(cellType, nCellPoints, cellPoints.data());
     }
 
     // Polyhedron cell (vtkPolyhedron)
@@ -7739,7 +7942,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
         if (allEmpty)
         {
           vtkWarningMacro("Warning: No points in cellId " << cellId);
-          internalMesh->InsertNextCell(VTK_EMPTY_CELL, 0, cellPoints.data());
+          grid->InsertNextCell(VTK_EMPTY_CELL, 0, cellPoints.data());
           continue;
         }
       }
@@ -7860,7 +8063,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
             if (firstCell)
             {
               firstCell = false;
-              internalMesh->InsertNextCell(VTK_PYRAMID, 5, cellPoints.data());
+              grid->InsertNextCell(VTK_PYRAMID, 5, cellPoints.data());
             }
             else
             {
@@ -7889,7 +8092,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
             if (firstCell)
             {
               firstCell = false;
-              internalMesh->InsertNextCell(VTK_TETRA, 4, cellPoints.data());
+              grid->InsertNextCell(VTK_TETRA, 4, cellPoints.data());
             }
             else
             {
@@ -8002,7 +8205,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
         }
 
         // Create the poly cell and insert it into the mesh
-        internalMesh->InsertNextCell(VTK_POLYHEDRON, static_cast<vtkIdType>(nCellPoints),
+        grid->InsertNextCell(VTK_POLYHEDRON, static_cast<vtkIdType>(nCellPoints),
           cellPoints.data(), static_cast<vtkIdType>(cellFaces.size()), polyPoints.data());
       }
     }
@@ -11208,7 +11411,10 @@ int vtkOpenFOAMReader::RequestData(vtkInformation* vtkNotUsed(request),
       .empty())
   {
     ret = reader->RequestData(output);
-    this->Parent->CurrentReaderIndex++;
+    if (!vtkSMPTools::IsParallelScope())
+    {
+      this->Parent->CurrentReaderIndex++;
+    }
   }
   else
   {
@@ -11233,7 +11439,10 @@ int vtkOpenFOAMReader::RequestData(vtkInformation* vtkNotUsed(request),
       {
         ret = 0;
       }
-      this->Parent->CurrentReaderIndex++;
+      if (!vtkSMPTools::IsParallelScope())
+      {
+        this->Parent->CurrentReaderIndex++;
+      }
     }
   }
 
@@ -11647,6 +11856,11 @@ void vtkOpenFOAMReader::UpdateStatus()
 //------------------------------------------------------------------------------
 void vtkOpenFOAMReader::UpdateProgress(double amount)
 {
+  // The sub-readers updated concurrently do not report their progress
+  if (vtkSMPTools::IsParallelScope())
+  {
+    return;
+  }
   this->vtkAlgorithm::UpdateProgress(
     (static_cast<double>(this->Parent->CurrentReaderIndex) + amount) /
     static_cast<double>(this->Parent->NumberOfReaders));
@@ -0,0 +1,336 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHDFReaderTransient.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write VTK HDF files with steps, an unstructured grid whose first two steps
+// share the geometry and an image data, and check that vtkHDFReader reports
+// their time steps, reads the requested step and reuses the cached arrays.
+// The step of a requested time is also found when the time values are not
+// sorted, and the Step set on the reader is read when no time is requested.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkHDF5ScopedHandle.h"
+#include "vtkHDFReader.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTesting.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtk_hdf5.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+template <typename T>
+bool WriteDataSet(hid_t group, const char* name, hid_t type, const std::vector<hsize_t>& dims,
+  const std::vector<T>& values)
+{
+  vtkHDF::ScopedH5SHandle space =
+    H5Screate_simple(static_cast<int>(dims.size()), dims.data(), nullptr);
+  vtkHDF::ScopedH5DHandle dataset =
+    H5Dcreate(group, name, type, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  return dataset >= 0 && H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data()) >= 0;
+}
+
+bool WriteIntAttribute(hid_t group, const char* name, const std::vector<int>& values)
+{
+  hsize_t size = values.size();
+  vtkHDF::ScopedH5SHandle space = H5Screate_simple(1, &size, nullptr);
+  vtkHDF::ScopedH5AHandle attribute =
+    H5Acreate(group, name, H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT);
+  return attribute >= 0 && H5Awrite(attribute, H5T_NATIVE_INT, values.data()) >= 0;
+}
+
+bool WriteDoubleAttribute(hid_t group, const char* name, const std::vector<double>& values)
+{
+  hsize_t size = values.size();
+  vtkHDF::ScopedH5SHandle space = H5Screate_simple(1, &size, nullptr);
+  vtkHDF::ScopedH5AHandle attribute =
+    H5Acreate(group, name, H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, H5P_DEFAULT);
+  return attribute >= 0 && H5Awrite(attribute, H5T_NATIVE_DOUBLE, values.data()) >= 0;
+}
+
+bool WriteHeader(hid_t group, const char* type)
+{
+  vtkHDF::ScopedH5THandle stringType = H5Tcopy(H5T_C_S1);
+  H5Tset_size(stringType, std::strlen(type));
+  H5Tset_strpad(stringType, H5T_STR_NULLPAD);
+  vtkHDF::ScopedH5SHandle space = H5Screate(H5S_SCALAR);
+  vtkHDF::ScopedH5AHandle attribute =
+    H5Acreate(group, "Type", stringType, space, H5P_DEFAULT, H5P_DEFAULT);
+  return WriteIntAttribute(group, "Version", { 2, 0 }) && attribute >= 0 &&
+    H5Awrite(attribute, stringType, type) >= 0;
+}
+
+bool WriteSteps(hid_t group, const std::vector<double>& values,
+  const std::vector<std::string>& pointArrays, const std::vector<std::vector<int>>& pointOffsets)
+{
+  vtkHDF::ScopedH5GHandle steps = H5Gcreate(group, "Steps", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  vtkHDF::ScopedH5GHandle pointDataOffsets =
+    H5Gcreate(steps, "PointDataOffsets", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  const hsize_t numberOfSteps = values.size();
+  if (!WriteIntAttribute(steps, "NSteps", { static_cast<int>(numberOfSteps) }) ||
+    !WriteDataSet(steps, "Values", H5T_NATIVE_DOUBLE, { numberOfSteps }, values))
+  {
+    return false;
+  }
+  for (size_t i = 0; i < pointArrays.size(); ++i)
+  {
+    if (!WriteDataSet(pointDataOffsets, pointArrays[i].c_str(), H5T_NATIVE_INT, { numberOfSteps },
+          pointOffsets[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Three steps of an unstructured grid. The first two steps share a
+// tetrahedron, the third one has a tetrahedron and a vertex. The point data
+// changes with each step, the cell data of the first two steps is the same.
+bool WriteUnstructuredGrid(const std::string& fileName)
+{
+  vtkHDF::ScopedH5FHandle file =
+    H5Fcreate(fileName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  vtkHDF::ScopedH5GHandle root = H5Gcreate(file, "/VTKHDF", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  if (root < 0 || !WriteHeader(root, "UnstructuredGrid") ||
+    !WriteSteps(root, { 0.0, 0.5, 1.0 }, { "Temperature" }, { { 0, 4, 8 } }))
+  {
+    return false;
+  }
+  vtkHDF::ScopedH5GHandle steps = H5Gopen(root, "Steps", H5P_DEFAULT);
+  vtkHDF::ScopedH5GHandle cellDataOffsets =
+    H5Gcreate(steps, "CellDataOffsets", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  vtkHDF::ScopedH5GHandle fieldDataOffsets =
+    H5Gcreate(steps, "FieldDataOffsets", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  vtkHDF::ScopedH5GHandle fieldDataSizes =
+    H5Gcreate(steps, "FieldDataSizes", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  vtkHDF::ScopedH5GHandle pointData =
+    H5Gcreate(root, "PointData", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  vtkHDF::ScopedH5GHandle cellData =
+    H5Gcreate(root, "CellData", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  vtkHDF::ScopedH5GHandle fieldData =
+    H5Gcreate(root, "FieldData", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  return WriteDataSet(steps, "NumberOfParts", H5T_NATIVE_INT, { 3 }, std::vector<int>{ 1, 1, 1 }) &&
+    WriteDataSet(steps, "PartOffsets", H5T_NATIVE_INT, { 3 }, std::vector<int>{ 0, 0, 1 }) &&
+    WriteDataSet(steps, "PointOffsets", H5T_NATIVE_INT, { 3 }, std::vector<int>{ 0, 0, 4 }) &&
+    WriteDataSet(steps, "CellOffsets", H5T_NATIVE_INT, { 3, 1 }, std::vector<int>{ 0, 0, 1 }) &&
+    WriteDataSet(
+      steps, "ConnectivityIdOffsets", H5T_NATIVE_INT, { 3, 1 }, std::vector<int>{ 0, 0, 4 }) &&
+    WriteDataSet(root, "NumberOfPoints", H5T_NATIVE_INT, { 2 }, std::vector<int>{ 4, 5 }) &&
+    WriteDataSet(root, "NumberOfCells", H5T_NATIVE_INT, { 2 }, std::vector<int>{ 1, 2 }) &&
+    WriteDataSet(
+      root, "NumberOfConnectivityIds", H5T_NATIVE_INT, { 2 }, std::vector<int>{ 4, 5 }) &&
+    WriteDataSet(root, "Points", H5T_NATIVE_DOUBLE, { 9, 3 },
+      std::vector<double>{ 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 2, 0, 0, 0, 2,
+        3, 3, 3 }) &&
+    WriteDataSet(root, "Offsets", H5T_NATIVE_INT, { 5 }, std::vector<int>{ 0, 4, 0, 4, 5 }) &&
+    WriteDataSet(
+      root, "Connectivity", H5T_NATIVE_INT, { 9 }, std::vector<int>{ 0, 1, 2, 3, 0, 1, 2, 3, 4 }) &&
+    WriteDataSet(root, "Types", H5T_NATIVE_UCHAR, { 3 },
+      std::vector<unsigned char>{ VTK_TETRA, VTK_TETRA, VTK_VERTEX }) &&
+    WriteDataSet(pointData, "Temperature", H5T_NATIVE_FLOAT, { 13 },
+      std::vector<float>{ 0, 1, 2, 3, 10, 11, 12, 13, 20, 21, 22, 23, 24 }) &&
+    WriteDataSet(cellDataOffsets, "Material", H5T_NATIVE_INT, { 3 }, std::vector<int>{ 0, 0, 1 }) &&
+    WriteDataSet(cellData, "Material", H5T_NATIVE_INT, { 3 }, std::vector<int>{ 7, 8, 9 }) &&
+    WriteDataSet(fieldDataOffsets, "Energy", H5T_NATIVE_INT, { 3 }, std::vector<int>{ 0, 1, 2 }) &&
+    WriteDataSet(fieldDataSizes, "Energy", H5T_NATIVE_INT, { 3 }, std::vector<int>{ 1, 1, 1 }) &&
+    WriteDataSet(
+      fieldData, "Energy", H5T_NATIVE_DOUBLE, { 3 }, std::vector<double>{ 100, 90, 80 });
+}
+
+// Two steps of a 3x2 image, the point data has one more dimension with the
+// values of each step.
+bool WriteImageData(const std::string& fileName, const std::vector<double>& times)
+{
+  vtkHDF::ScopedH5FHandle file =
+    H5Fcreate(fileName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  vtkHDF::ScopedH5GHandle root = H5Gcreate(file, "/VTKHDF", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  if (root < 0 || !WriteHeader(root, "ImageData") ||
+    !WriteSteps(root, times, { "Density" }, { { 1, 0 } }))
+  {
+    return false;
+  }
+  vtkHDF::ScopedH5GHandle pointData =
+    H5Gcreate(root, "PointData", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  return WriteIntAttribute(root, "WholeExtent", { 0, 2, 0, 1, 0, 0 }) &&
+    WriteDoubleAttribute(root, "Origin", { 0, 0, 0 }) &&
+    WriteDoubleAttribute(root, "Spacing", { 1, 1, 1 }) &&
+    WriteDoubleAttribute(root, "Direction", { 1, 0, 0, 0, 1, 0, 0, 0, 1 }) &&
+    WriteDataSet(pointData, "Density", H5T_NATIVE_DOUBLE, { 2, 2, 3 },
+      std::vector<double>{ 0, 1, 2, 3, 4, 5, 10, 11, 12, 13, 14, 15 });
+}
+
+vtkDataObject* UpdateTime(vtkHDFReader* reader, double time)
+{
+  reader->UpdateTimeStep(time);
+  return reader->GetOutputDataObject(0);
+}
+
+bool TestUnstructuredGrid(const std::string& fileName)
+{
+  if (!WriteUnstructuredGrid(fileName))
+  {
+    std::cerr << "Error writing " << fileName << std::endl;
+    return false;
+  }
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UseCacheOn();
+  reader->UpdateInformation();
+  vtkInformation* outInfo = reader->GetOutputInformation(0);
+  if (reader->GetNumberOfSteps() != 3 ||
+    outInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()) != 3 ||
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS())[1] != 0.5)
+  {
+    std::cerr << "Wrong time steps" << std::endl;
+    return false;
+  }
+
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(UpdateTime(reader, 0.0));
+  vtkSmartPointer<vtkDataArray> points = output->GetPoints()->GetData();
+  vtkSmartPointer<vtkDataArray> material = output->GetCellData()->GetArray("Material");
+
+  // the second step shares the geometry and the cell data of the first one
+  output = vtkUnstructuredGrid::SafeDownCast(UpdateTime(reader, 0.7));
+  vtkDataArray* temperature = output->GetPointData()->GetArray("Temperature");
+  if (reader->GetStep() != 0 ||
+    output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != 0.5 ||
+    output->GetNumberOfPoints() != 4 ||
+    output->GetNumberOfCells() != 1 || !temperature || temperature->GetComponent(2, 0) != 12 ||
+    output->GetFieldData()->GetArray("Energy")->GetComponent(0, 0) != 90)
+  {
+    std::cerr << "Wrong second step" << std::endl;
+    return false;
+  }
+  if (output->GetPoints()->GetData() != points ||
+    output->GetCellData()->GetArray("Material") != material)
+  {
+    std::cerr << "The arrays shared by the steps are read again" << std::endl;
+    return false;
+  }
+
+  output = vtkUnstructuredGrid::SafeDownCast(UpdateTime(reader, 1.0));
+  temperature = output->GetPointData()->GetArray("Temperature");
+  if (output->GetNumberOfPoints() != 5 || output->GetNumberOfCells() != 2 ||
+    output->GetCellType(1) != VTK_VERTEX || output->GetPoint(4)[0] != 3 ||
+    temperature->GetComponent(4, 0) != 24 ||
+    output->GetCellData()->GetArray("Material")->GetComponent(1, 0) != 9 ||
+    output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != 1.0)
+  {
+    std::cerr << "Wrong third step" << std::endl;
+    return false;
+  }
+  if (output->GetPoints()->GetData() == points)
+  {
+    std::cerr << "The geometry of the third step is not read" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool CheckDensity(vtkDataObject* data, int step)
+{
+  // the first step uses the second values of the file
+  vtkImageData* output = vtkImageData::SafeDownCast(data);
+  vtkDataArray* density = output ? output->GetPointData()->GetArray("Density") : nullptr;
+  if (!density || density->GetNumberOfTuples() != 6)
+  {
+    std::cerr << "Wrong image data" << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < 6; ++ptId)
+  {
+    if (density->GetComponent(ptId, 0) != (step == 0 ? 10 : 0) + ptId)
+    {
+      std::cerr << "Wrong density of point " << ptId << " at step " << step << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestImageData(const std::string& fileName)
+{
+  if (!WriteImageData(fileName, { 1.0, 2.0 }))
+  {
+    std::cerr << "Error writing " << fileName << std::endl;
+    return false;
+  }
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  for (int step = 0; step < 2; ++step)
+  {
+    if (!CheckDensity(UpdateTime(reader, step + 1.0), step))
+    {
+      return false;
+    }
+  }
+
+  // without a requested time, the Step of the reader is read
+  vtkNew<vtkHDFReader> stepReader;
+  stepReader->SetFileName(fileName.c_str());
+  stepReader->SetStep(1);
+  stepReader->Update();
+  if (stepReader->GetStep() != 1 || !CheckDensity(stepReader->GetOutputDataObject(0), 1))
+  {
+    std::cerr << "Wrong step read without a requested time" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestUnsortedSteps(const std::string& fileName)
+{
+  if (!WriteImageData(fileName, { 2.0, 1.0 }))
+  {
+    std::cerr << "Error writing " << fileName << std::endl;
+    return false;
+  }
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  // the reader warns that the time values are not sorted
+  const int warnings = vtkObject::GetGlobalWarningDisplay();
+  vtkObject::GlobalWarningDisplayOff();
+  reader->UpdateInformation();
+  // the step of the nearest time value is read
+  const bool ok = CheckDensity(UpdateTime(reader, 1.9), 0) &&
+    CheckDensity(UpdateTime(reader, 1.2), 1) && CheckDensity(UpdateTime(reader, 5.0), 0);
+  vtkObject::SetGlobalWarningDisplay(warnings);
+  return ok;
+}
+}
+
+int TestHDFReaderTransient(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string tempDirectory = testing->GetTempDirectory();
+  if (!TestUnstructuredGrid(tempDirectory + "/TestHDFReaderTransientGrid.hdf") ||
+    !TestImageData(tempDirectory + "/TestHDFReaderTransientImage.hdf") ||
+    !TestUnsortedSteps(tempDirectory + "/TestHDFReaderTransientUnsorted.hdf"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,428 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHDFWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write image data, unstructured grids and polydata with vtkHDFWriter, with
+// and without compression, and check that vtkHDFReader reads them back.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkHDF5ScopedHandle.h"
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+#include "vtkTesting.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtk_hdf5.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+bool SameArray(vtkDataArray* array, vtkDataArray* expectedArray)
+{
+  if (!array || !expectedArray)
+  {
+    std::cerr << "Missing array "
+              << (expectedArray && expectedArray->GetName() ? expectedArray->GetName() : "")
+              << std::endl;
+    return false;
+  }
+  if (array->GetDataType() != expectedArray->GetDataType() ||
+    array->GetNumberOfComponents() != expectedArray->GetNumberOfComponents() ||
+    array->GetNumberOfTuples() != expectedArray->GetNumberOfTuples())
+  {
+    std::cerr << "Wrong type or size of array " << expectedArray->GetName() << std::endl;
+    return false;
+  }
+  const int numComps = array->GetNumberOfComponents();
+  for (vtkIdType tupleId = 0; tupleId < array->GetNumberOfTuples(); ++tupleId)
+  {
+    for (int compId = 0; compId < numComps; ++compId)
+    {
+      if (array->GetComponent(tupleId, compId) != expectedArray->GetComponent(tupleId, compId))
+      {
+        std::cerr << "Expecting " << expectedArray->GetComponent(tupleId, compId)
+                  << " for tuple/component: " << tupleId << "/" << compId << " of "
+                  << expectedArray->GetName()
+                  << " but got: " << array->GetComponent(tupleId, compId) << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameArrays(vtkFieldData* data, vtkFieldData* expectedData)
+{
+  for (int i = 0; i < expectedData->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* expectedArray = expectedData->GetArray(i);
+    if (expectedArray && !SameArray(data->GetArray(expectedArray->GetName()), expectedArray))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameFieldData(vtkFieldData* data, vtkFieldData* expectedData)
+{
+  vtkStringArray* names = vtkStringArray::SafeDownCast(data->GetAbstractArray("Names"));
+  vtkStringArray* expectedNames =
+    vtkStringArray::SafeDownCast(expectedData->GetAbstractArray("Names"));
+  if (!names || names->GetNumberOfValues() != expectedNames->GetNumberOfValues())
+  {
+    std::cerr << "Wrong string field data" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < names->GetNumberOfValues(); ++i)
+  {
+    if (names->GetValue(i) != expectedNames->GetValue(i))
+    {
+      std::cerr << "Expecting " << expectedNames->GetValue(i) << " but got " << names->GetValue(i)
+                << std::endl;
+      return false;
+    }
+  }
+  return SameArrays(data, expectedData);
+}
+
+void AddFieldData(vtkDataObject* data)
+{
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  names->InsertNextValue("first");
+  names->InsertNextValue("second name");
+  data->GetFieldData()->AddArray(names);
+  vtkNew<vtkDoubleArray> time;
+  time->SetName("Time");
+  time->InsertNextValue(4.25);
+  data->GetFieldData()->AddArray(time);
+}
+
+bool Write(vtkDataObject* data, const std::string& fileName, int compressionLevel)
+{
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(data);
+  writer->SetFileName(fileName.c_str());
+  // small chunks, so that the datasets are split in several chunks
+  writer->SetChunkSize(16);
+  writer->SetCompressionLevel(compressionLevel);
+  if (!writer->Write())
+  {
+    std::cerr << "Error writing " << fileName << std::endl;
+    return false;
+  }
+
+  // files without steps keep the version of the first readers
+  int version[2] = { -1, -1 };
+  vtkHDF::ScopedH5FHandle file = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  vtkHDF::ScopedH5AHandle attribute =
+    H5Aopen_by_name(file, "/VTKHDF", "Version", H5P_DEFAULT, H5P_DEFAULT);
+  if (attribute < 0 || H5Aread(attribute, H5T_NATIVE_INT, version) < 0 || version[0] != 1 ||
+    version[1] != 0)
+  {
+    std::cerr << "Wrong version " << version[0] << "." << version[1] << " in " << fileName
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestImageData(const std::string& fileName, int compressionLevel)
+{
+  // An extent that does not start at 0, with a flat y axis.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(2, 7, 5, 5, -1, 3);
+  image->SetOrigin(1.0, -2.0, 0.5);
+  image->SetSpacing(0.5, 1.0, 2.0);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < image->GetNumberOfPoints(); ++ptId)
+  {
+    scalars->SetValue(ptId, 0.5f * ptId);
+    vectors->SetTuple3(ptId, ptId, -ptId, 2.0 * ptId);
+  }
+  image->GetPointData()->SetScalars(scalars);
+  image->GetPointData()->SetVectors(vectors);
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(image->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < image->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->SetValue(cellId, static_cast<int>(3 * cellId));
+  }
+  image->GetCellData()->AddArray(cellIds);
+  AddFieldData(image);
+
+  if (!Write(image, fileName, compressionLevel))
+  {
+    return false;
+  }
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkImageData* output = vtkImageData::SafeDownCast(reader->GetOutputAsDataSet());
+  if (!output)
+  {
+    std::cerr << "Error reading image data from " << fileName << std::endl;
+    return false;
+  }
+  int extent[6];
+  output->GetExtent(extent);
+  for (int i = 0; i < 6; ++i)
+  {
+    if (extent[i] != image->GetExtent()[i])
+    {
+      std::cerr << "Wrong extent" << std::endl;
+      return false;
+    }
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    if (output->GetOrigin()[i] != image->GetOrigin()[i] ||
+      output->GetSpacing()[i] != image->GetSpacing()[i])
+    {
+      std::cerr << "Wrong origin or spacing" << std::endl;
+      return false;
+    }
+  }
+  return SameArrays(output->GetPointData(), image->GetPointData()) &&
+    SameArrays(output->GetCellData(), image->GetCellData()) &&
+    SameFieldData(output->GetFieldData(), image->GetFieldData());
+}
+
+bool TestUnstructuredGrid(const std::string& fileName, int compressionLevel)
+{
+  // A strip of hexahedra with a triangle and a vertex.
+  const int numHexes = 10;
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i <= numHexes; ++i)
+  {
+    points->InsertNextPoint(i, 0.0, 0.0);
+    points->InsertNextPoint(i, 1.0, 0.0);
+    points->InsertNextPoint(i, 1.0, 1.0);
+    points->InsertNextPoint(i, 0.0, 1.0);
+  }
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->AllocateEstimate(numHexes + 2, 8);
+  for (vtkIdType i = 0; i < numHexes; ++i)
+  {
+    const vtkIdType hex[8] = { 4 * i, 4 * i + 1, 4 * i + 2, 4 * i + 3, 4 * i + 4, 4 * i + 5,
+      4 * i + 6, 4 * i + 7 };
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+  }
+  const vtkIdType triangle[3] = { 0, 5, 10 };
+  grid->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  grid->InsertNextCell(VTK_VERTEX, 1, triangle + 2);
+
+  vtkNew<vtkDoubleArray> distance;
+  distance->SetName("Distance");
+  for (vtkIdType ptId = 0; ptId < grid->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    grid->GetPoint(ptId, x);
+    distance->InsertNextValue(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+  }
+  grid->GetPointData()->SetScalars(distance);
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName("Colors");
+  colors->SetNumberOfComponents(3);
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    colors->InsertNextTuple3(cellId, 2 * cellId, 255 - cellId);
+  }
+  grid->GetCellData()->AddArray(colors);
+  AddFieldData(grid);
+
+  if (!Write(grid, fileName, compressionLevel))
+  {
+    return false;
+  }
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(reader->GetOutputAsDataSet());
+  if (!output)
+  {
+    std::cerr << "Error reading unstructured grid from " << fileName << std::endl;
+    return false;
+  }
+  if (output->GetNumberOfCells() != grid->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of cells" << std::endl;
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npts, expectedNpts;
+    const vtkIdType* pts;
+    const vtkIdType* expectedPts;
+    output->GetCellPoints(cellId, npts, pts);
+    grid->GetCellPoints(cellId, expectedNpts, expectedPts);
+    if (output->GetCellType(cellId) != grid->GetCellType(cellId) || npts != expectedNpts ||
+      !std::equal(pts, pts + npts, expectedPts))
+    {
+      std::cerr << "Wrong cell " << cellId << std::endl;
+      return false;
+    }
+  }
+  return SameArray(output->GetPoints()->GetData(), grid->GetPoints()->GetData()) &&
+    SameArrays(output->GetPointData(), grid->GetPointData()) &&
+    SameArrays(output->GetCellData(), grid->GetCellData()) &&
+    SameFieldData(output->GetFieldData(), grid->GetFieldData());
+}
+
+bool SameCells(vtkCellArray* cells, vtkCellArray* expectedCells)
+{
+  if (cells->GetNumberOfCells() != expectedCells->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellId < cells->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npts, expectedNpts;
+    const vtkIdType* pts;
+    const vtkIdType* expectedPts;
+    cells->GetCellAtId(cellId, npts, pts);
+    expectedCells->GetCellAtId(cellId, expectedNpts, expectedPts);
+    if (npts != expectedNpts || !std::equal(pts, pts + npts, expectedPts))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestPolyData(const std::string& fileName, int compressionLevel)
+{
+  // Vertices, lines and polygons, without strips.
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 30; ++i)
+  {
+    points->InsertNextPoint(i, i % 3, 0.5 * i);
+  }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  polyData->AllocateEstimate(40, 4);
+  for (vtkIdType i = 0; i < 27; ++i)
+  {
+    const vtkIdType ids[3] = { i, i + 1, i + 2 };
+    polyData->InsertNextCell(i % 3 == 0 ? VTK_TRIANGLE : VTK_LINE, i % 3 == 0 ? 3 : 2, ids);
+    if (i % 9 == 0)
+    {
+      polyData->InsertNextCell(VTK_VERTEX, 1, ids);
+    }
+  }
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < polyData->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(static_cast<int>(cellId));
+  }
+  polyData->GetCellData()->AddArray(cellIds);
+  vtkNew<vtkFloatArray> heights;
+  heights->SetName("Heights");
+  for (vtkIdType ptId = 0; ptId < polyData->GetNumberOfPoints(); ++ptId)
+  {
+    heights->InsertNextValue(polyData->GetPoint(ptId)[2]);
+  }
+  polyData->GetPointData()->AddArray(heights);
+  AddFieldData(polyData);
+
+  if (!Write(polyData, fileName, compressionLevel))
+  {
+    return false;
+  }
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkPolyData* output = vtkPolyData::SafeDownCast(reader->GetOutputAsDataSet());
+  if (!output)
+  {
+    std::cerr << "Error reading polydata from " << fileName << std::endl;
+    return false;
+  }
+  if (!SameCells(output->GetVerts(), polyData->GetVerts()) ||
+    !SameCells(output->GetLines(), polyData->GetLines()) ||
+    !SameCells(output->GetPolys(), polyData->GetPolys()) || output->GetNumberOfStrips() != 0)
+  {
+    std::cerr << "Wrong polydata cells" << std::endl;
+    return false;
+  }
+  // the cells are read as vertices, lines then polygons, not in the order
+  // they were inserted: the cell data must follow them
+  vtkDataArray* outputCellIds = output->GetCellData()->GetArray("CellIds");
+  if (!outputCellIds || outputCellIds->GetNumberOfTuples() != polyData->GetNumberOfCells())
+  {
+    std::cerr << "Missing cell data" << std::endl;
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npts, expectedNpts;
+    const vtkIdType* pts;
+    const vtkIdType* expectedPts;
+    output->GetCellPoints(cellId, npts, pts);
+    polyData->GetCellPoints(
+      static_cast<vtkIdType>(outputCellIds->GetComponent(cellId, 0)), expectedNpts, expectedPts);
+    if (npts != expectedNpts || !std::equal(pts, pts + npts, expectedPts))
+    {
+      std::cerr << "Wrong cell data of cell " << cellId << std::endl;
+      return false;
+    }
+  }
+  return SameArray(output->GetPoints()->GetData(), polyData->GetPoints()->GetData()) &&
+    SameArrays(output->GetPointData(), polyData->GetPointData()) &&
+    SameFieldData(output->GetFieldData(), polyData->GetFieldData());
+}
+}
+
+int TestHDFWriter(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string tempDirectory = testing->GetTempDirectory();
+  for (int compressionLevel : { 0, 4 })
+  {
+    const std::string suffix = std::to_string(compressionLevel) + ".hdf";
+    if (!TestImageData(tempDirectory + "/TestHDFWriterImage" + suffix, compressionLevel) ||
+      !TestUnstructuredGrid(
+        tempDirectory + "/TestHDFWriterUnstructuredGrid" + suffix, compressionLevel) ||
+      !TestPolyData(tempDirectory + "/TestHDFWriterPolyData" + suffix, compressionLevel))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
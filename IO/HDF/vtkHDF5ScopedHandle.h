@@ -1,6 +1,8 @@
 #ifndef vtkHDF5ScopedHandle_h
 #define vtkHDF5ScopedHandle_h
 
+#include "vtk_hdf5.h"
+
 namespace vtkHDF
 {
 
@@ -42,6 +44,9 @@ DefineScopedHandle(F);
 // Defines ScopedH5GHandle closed with H5Gclose
 DefineScopedHandle(G);
 
+// Defines ScopedH5PHandle closed with H5Pclose
+DefineScopedHandle(P);
+
 // Defines ScopedH5SHandle closed with H5Sclose
 DefineScopedHandle(S);
 
@@ -15,8 +15,11 @@
 #include "vtkHDFReader.h"
 
 #include "vtkAppendDataSets.h"
+#include "vtkAppendPolyData.h"
 #include "vtkArrayIteratorIncludes.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataSet.h"
@@ -29,6 +32,9 @@
 #include "vtkMatrix3x3.h"
 #include "vtkObjectFactory.h"
 #include "vtkOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkQuadratureSchemeDefinition.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGrid.h"
@@ -38,12 +44,16 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cctype>
+#include <cmath>
 #include <functional>
 #include <locale>
+#include <map>
 #include <numeric>
 #include <sstream>
+#include <string>
 #include <vector>
 
 vtkStandardNewMacro(vtkHDFReader);
@@ -51,35 +61,126 @@ vtkStandardNewMacro(vtkHDFReader);
 namespace
 {
 //----------------------------------------------------------------------------
+// Only the trailing flat dimensions are dropped, a flat y dimension is kept
+// when z is not flat.
 int GetNDims(int* extent)
 {
   int ndims = 3;
   if (extent[5] - extent[4] == 0)
   {
     --ndims;
-  }
-  if (extent[3] - extent[2] == 0)
-  {
-    --ndims;
+    if (extent[3] - extent[2] == 0)
+    {
+      --ndims;
+    }
   }
   return ndims;
 }
 
 //----------------------------------------------------------------------------
-std::vector<hsize_t> ReduceDimension(int* updateExtent, int* wholeExtent)
+// Extent of the values of 'updateExtent' in the datasets of the file, which
+// start at the beginning of 'wholeExtent'. Cell arrays have one value less
+// along each dimension that is not flat.
+std::vector<hsize_t> ReduceDimension(int* updateExtent, int* wholeExtent, int attributeType)
 {
   int dims = ::GetNDims(wholeExtent);
   std::vector<hsize_t> v(2 * dims);
   for (int i = 0; i < dims; ++i)
   {
     int j = 2 * i;
-    v[j] = updateExtent[j];
-    v[j + 1] = updateExtent[j + 1];
+    int cellOffset = attributeType == vtkDataObject::CELL && updateExtent[j + 1] > updateExtent[j];
+    v[j] = updateExtent[j] - wholeExtent[j];
+    v[j + 1] = updateExtent[j + 1] - wholeExtent[j] - cellOffset;
   }
   return v;
 }
+
+//----------------------------------------------------------------------------
+// in the same order as vtkDataObject::AttributeTypes: POINT, CELL, FIELD
+const std::array<const char*, 3> ATTRIBUTE_GROUPS = { "PointData", "CellData", "FieldData" };
+
+// Groups of the cells of a vtkPolyData, in the order of the cell ids.
+const std::array<const char*, 4> POLY_DATA_TOPOLOGIES = { "Vertices", "Lines", "Polygons",
+  "Strips" };
+
+//----------------------------------------------------------------------------
+// Identifies the values of dataset 'name' read from 'slab' of the file.
+template <typename T>
+std::string GetCacheKey(const std::string& name, const std::vector<T>& slab)
+{
+  std::ostringstream key;
+  key << name;
+  for (const T& value : slab)
+  {
+    key << " " << value;
+  }
+  return key.str();
+}
 }
 
+//----------------------------------------------------------------------------
+// Arrays read for the last update, identified by the dataset and the slab
+// of the dataset they were read from.
+class vtkHDFReader::DataCache
+{
+public:
+  /**
+   * Starts an update: the arrays of the last update can be reused, unless
+   * the cache is disabled or the file changed.
+   */
+  void BeginUpdate(bool enabled, const std::string& fileName)
+  {
+    this->Enabled = enabled;
+    this->Previous.clear();
+    if (enabled && fileName == this->FileName)
+    {
+      this->Previous.swap(this->Current);
+    }
+    this->Current.clear();
+    this->FileName = fileName;
+  }
+
+  /**
+   * Releases the arrays of the last update that are not used by this one.
+   */
+  void EndUpdate() { this->Previous.clear(); }
+
+  /**
+   * Returns the array read for 'key', calling 'newArray' to read it when it
+   * is not cached.
+   */
+  template <typename T, typename NewArrayT>
+  vtkSmartPointer<T> Get(const std::string& key, NewArrayT newArray)
+  {
+    if (!this->Enabled)
+    {
+      return vtk::TakeSmartPointer(newArray());
+    }
+    auto it = this->Current.find(key);
+    if (it == this->Current.end())
+    {
+      auto previous = this->Previous.find(key);
+      if (previous == this->Previous.end())
+      {
+        vtkSmartPointer<T> array = vtk::TakeSmartPointer(newArray());
+        if (array)
+        {
+          this->Current[key] = array;
+        }
+        return array;
+      }
+      it = this->Current.insert(*previous).first;
+    }
+    return T::SafeDownCast(it->second);
+  }
+
+private:
+  bool Enabled = false;
+  std::string FileName;
+  std::map<std::string, vtkSmartPointer<vtkAbstractArray>> Previous;
+  std::map<std::string, vtkSmartPointer<vtkAbstractArray>> Current;
+};
+
 //----------------------------------------------------------------------------
 vtkHDFReader::vtkHDFReader()
 {
@@ -101,12 +202,14 @@ vtkHDFReader::vtkHDFReader()
   std::fill(this->Origin, this->Origin + 3, 0.0);
   std::fill(this->Spacing, this->Spacing + 3, 0.0);
   this->Impl = new vtkHDFReader::Implementation(this);
+  this->Cache = new vtkHDFReader::DataCache;
 }
 
 //----------------------------------------------------------------------------
 vtkHDFReader::~vtkHDFReader()
 {
   delete this->Impl;
+  delete this->Cache;
   this->SetFileName(nullptr);
   for (int i = 0; i < vtkHDFReader::GetNumberOfAttributeTypes(); ++i)
   {
@@ -125,6 +228,14 @@ void vtkHDFReader::PrintSelf(ostream& os, vtkIndent indent)
      << "\n";
   os << indent << "PointDataArraySelection: " << this->DataArraySelection[vtkDataObject::POINT]
      << "\n";
+  os << indent << "Step: " << this->Step << "\n";
+  os << indent << "UseCache: " << (this->UseCache ? "On" : "Off") << "\n";
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkHDFReader::GetNumberOfSteps()
+{
+  return this->Impl->GetNumberOfSteps();
 }
 
 //----------------------------------------------------------------------------
@@ -219,7 +330,7 @@ int vtkHDFReader::RequestDataObject(vtkInformation*, vtkInformationVector** vtkN
   vtkInformationVector* outputVector)
 {
   std::map<int, std::string> typeNameMap = { { VTK_IMAGE_DATA, "vtkImageData" },
-    { VTK_UNSTRUCTURED_GRID, "vtkUnstructuredGrid" },
+    { VTK_UNSTRUCTURED_GRID, "vtkUnstructuredGrid" }, { VTK_POLY_DATA, "vtkPolyData" },
     { VTK_OVERLAPPING_AMR, "vtkOverlappingAMR" } };
   vtkInformation* info = outputVector->GetInformationObject(0);
   vtkDataObject* output = info->Get(vtkDataObject::DATA_OBJECT());
@@ -255,6 +366,10 @@ int vtkHDFReader::RequestDataObject(vtkInformation*, vtkInformationVector** vtkN
     {
       newOutput = vtkUnstructuredGrid::New();
     }
+    else if (dataSetType == VTK_POLY_DATA)
+    {
+      newOutput = vtkPolyData::New();
+    }
     else if (dataSetType == VTK_OVERLAPPING_AMR)
     {
       newOutput = vtkOverlappingAMR::New();
@@ -320,7 +435,7 @@ int vtkHDFReader::RequestInformation(vtkInformation* vtkNotUsed(request),
     outInfo->Set(vtkDataObject::SPACING(), this->Spacing, 3);
     outInfo->Set(CAN_PRODUCE_SUB_EXTENT(), 1);
   }
-  else if (dataSetType == VTK_UNSTRUCTURED_GRID)
+  else if (dataSetType == VTK_UNSTRUCTURED_GRID || dataSetType == VTK_POLY_DATA)
   {
     outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
   }
@@ -338,6 +453,29 @@ int vtkHDFReader::RequestInformation(vtkInformation* vtkNotUsed(request),
     vtkErrorMacro("Invalid dataset type: " << dataSetType);
     return 0;
   }
+
+  // the steps of AMR are not read
+  vtkIdType numberOfSteps = this->Impl->GetNumberOfSteps();
+  if (numberOfSteps > 0 && dataSetType != VTK_OVERLAPPING_AMR)
+  {
+    const std::vector<double>& values = this->Impl->GetStepValues();
+    this->SortedStepValues = std::is_sorted(values.begin(), values.end());
+    if (!this->SortedStepValues)
+    {
+      vtkWarningMacro("The time values of the steps are not sorted, a requested time will "
+                      "read the step of the nearest time value.");
+    }
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), values.data(),
+      static_cast<int>(numberOfSteps));
+    auto range = std::minmax_element(values.begin(), values.end());
+    double timeRange[2] = { *range.first, *range.second };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange, 2);
+  }
+  else
+  {
+    outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_RANGE());
+  }
   return 1;
 }
 
@@ -373,20 +511,31 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
     return 0;
   }
 
-  // in the same order as vtkDataObject::AttributeTypes: POINT, CELL, FIELD
-  for (int attributeType = 0; attributeType < vtkHDFReader::GetNumberOfAttributeTypes();
-       ++attributeType)
+  // in the same order as vtkDataObject::AttributeTypes: POINT, CELL
+  // field arrays are added by AddFieldArrays
+  for (int attributeType = 0; attributeType < vtkDataObject::FIELD; ++attributeType)
   {
     std::vector<std::string> names = this->Impl->GetArrayNames(attributeType);
     for (const std::string& name : names)
     {
       if (this->DataArraySelection[attributeType]->ArrayIsEnabled(name.c_str()))
       {
-        vtkSmartPointer<vtkDataArray> array;
-        std::vector<hsize_t> fileExtent = ::ReduceDimension(&updateExtent[0], this->WholeExtent);
-        std::copy(updateExtent.begin(), updateExtent.end(), fileExtent.begin());
-        if ((array = vtk::TakeSmartPointer(
-               this->Impl->NewArray(attributeType, name.c_str(), fileExtent))) == nullptr)
+        std::vector<hsize_t> fileExtent =
+          ::ReduceDimension(&updateExtent[0], this->WholeExtent, attributeType);
+        // the arrays with steps have one more dimension, the slowest one,
+        // with the values of each step
+        vtkIdType offset = this->Impl->GetNumberOfSteps() > 0
+          ? this->Impl->GetArrayOffset(this->ReadStep, attributeType, name)
+          : -1;
+        if (offset >= 0)
+        {
+          fileExtent.push_back(offset);
+          fileExtent.push_back(offset);
+        }
+        vtkSmartPointer<vtkDataArray> array = this->Cache->Get<vtkDataArray>(
+          ::GetCacheKey(std::string(ATTRIBUTE_GROUPS[attributeType]) + "/" + name, fileExtent),
+          [&]() { return this->Impl->NewArray(attributeType, name.c_str(), fileExtent); });
+        if (array == nullptr)
         {
           vtkErrorMacro("Error reading array " << name);
           return 0;
@@ -405,8 +554,26 @@ int vtkHDFReader::AddFieldArrays(vtkDataObject* data)
   std::vector<std::string> names = this->Impl->GetArrayNames(vtkDataObject::FIELD);
   for (const std::string& name : names)
   {
-    vtkSmartPointer<vtkAbstractArray> array;
-    if ((array = vtk::TakeSmartPointer(this->Impl->NewFieldArray(name.c_str()))) == nullptr)
+    // the field arrays with steps have the offset and the number of tuples of
+    // each step
+    vtkIdType offset = -1;
+    vtkIdType size = -1;
+    if (this->Impl->GetNumberOfSteps() > 0 &&
+      (offset = this->Impl->GetArrayOffset(this->ReadStep, vtkDataObject::FIELD, name)) >= 0)
+    {
+      std::vector<vtkIdType> sizes =
+        this->Impl->GetStepValues(("FieldDataSizes/" + name).c_str(), this->ReadStep);
+      if (sizes.empty())
+      {
+        vtkErrorMacro("Error reading the size of array " << name);
+        return 0;
+      }
+      size = sizes[0];
+    }
+    vtkSmartPointer<vtkAbstractArray> array = this->Cache->Get<vtkAbstractArray>(
+      ::GetCacheKey<vtkIdType>(std::string("FieldData/") + name, { offset, size }),
+      [&]() { return this->Impl->NewFieldArray(name.c_str(), offset, size); });
+    if (array == nullptr)
     {
       vtkErrorMacro("Error reading array " << name);
       return 0;
@@ -417,18 +584,81 @@ int vtkHDFReader::AddFieldArrays(vtkDataObject* data)
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkHDFReader::ReadStepOffsets(size_t numberOfTopologies, vtkIdType& partOffset,
+  vtkIdType& pointOffset, std::vector<vtkIdType>& cellOffsets,
+  std::vector<vtkIdType>& connectivityIdOffsets)
+{
+  partOffset = 0;
+  pointOffset = 0;
+  cellOffsets.assign(numberOfTopologies, 0);
+  connectivityIdOffsets.assign(numberOfTopologies, 0);
+  if (this->Impl->GetNumberOfSteps() == 0)
+  {
+    return 1;
+  }
+  std::vector<vtkIdType> partOffsets = this->Impl->GetStepValues("PartOffsets", this->ReadStep);
+  std::vector<vtkIdType> pointOffsets = this->Impl->GetStepValues("PointOffsets", this->ReadStep);
+  cellOffsets = this->Impl->GetStepValues("CellOffsets", this->ReadStep);
+  connectivityIdOffsets = this->Impl->GetStepValues("ConnectivityIdOffsets", this->ReadStep);
+  if (partOffsets.size() != 1 || pointOffsets.size() != 1 ||
+    cellOffsets.size() != numberOfTopologies || connectivityIdOffsets.size() != numberOfTopologies)
+  {
+    vtkErrorMacro("Cannot read the offsets of step " << this->ReadStep);
+    return 0;
+  }
+  partOffset = partOffsets[0];
+  pointOffset = pointOffsets[0];
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFReader::ReadArrays(
+  int attributeType, vtkIdType pieceOffset, vtkIdType numberOfTuples, vtkFieldData* data)
+{
+  std::vector<std::string> names = this->Impl->GetArrayNames(attributeType);
+  for (const std::string& name : names)
+  {
+    if (this->DataArraySelection[attributeType]->ArrayIsEnabled(name.c_str()))
+    {
+      // arrays without offsets have the same values for all steps
+      vtkIdType offset = this->Impl->GetNumberOfSteps() > 0
+        ? this->Impl->GetArrayOffset(this->ReadStep, attributeType, name)
+        : -1;
+      vtkIdType start = std::max(offset, static_cast<vtkIdType>(0)) + pieceOffset;
+      vtkSmartPointer<vtkDataArray> array = this->Cache->Get<vtkDataArray>(
+        ::GetCacheKey<vtkIdType>(
+          std::string(ATTRIBUTE_GROUPS[attributeType]) + "/" + name, { start, numberOfTuples }),
+        [&]() { return this->Impl->NewArray(attributeType, name.c_str(), start, numberOfTuples); });
+      if (array == nullptr)
+      {
+        vtkErrorMacro("Error reading array " << name);
+        return 0;
+      }
+      array->SetName(name.c_str());
+      data->AddArray(array);
+    }
+  }
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 int vtkHDFReader::Read(const std::vector<vtkIdType>& numberOfPoints,
   const std::vector<vtkIdType>& numberOfCells,
-  const std::vector<vtkIdType>& numberOfConnectivityIds, int filePiece,
-  vtkUnstructuredGrid* pieceData)
+  const std::vector<vtkIdType>& numberOfConnectivityIds, vtkIdType partOffset,
+  vtkIdType startingPointOffset, vtkIdType startingCellOffset,
+  vtkIdType startingConnectivityIdOffset, int filePiece, vtkUnstructuredGrid* pieceData)
 {
   // read the piece and add it to data
   vtkNew<vtkPoints> points;
   vtkSmartPointer<vtkDataArray> pointArray;
-  vtkIdType pointOffset = std::accumulate(&numberOfPoints[0], &numberOfPoints[filePiece], 0);
-  if ((pointArray = vtk::TakeSmartPointer(this->Impl->NewMetadataArray(
-         "Points", pointOffset, numberOfPoints[filePiece]))) == nullptr)
+  vtkIdType pointOffset = std::accumulate(
+    numberOfPoints.begin(), numberOfPoints.begin() + filePiece, static_cast<vtkIdType>(0));
+  vtkIdType offset = startingPointOffset + pointOffset;
+  if ((pointArray = this->Cache->Get<vtkDataArray>(
+         ::GetCacheKey<vtkIdType>("Points", { offset, numberOfPoints[filePiece] }), [&]() {
+           return this->Impl->NewMetadataArray("Points", offset, numberOfPoints[filePiece]);
+         })) == nullptr)
   {
     vtkErrorMacro("Cannot read the Points array");
     return 0;
@@ -440,26 +670,39 @@ int vtkHDFReader::Read(const std::vector<vtkIdType>& numberOfPoints,
   vtkSmartPointer<vtkDataArray> connectivityArray;
   vtkSmartPointer<vtkDataArray> p;
   vtkUnsignedCharArray* typesArray;
-  // the offsets array has (numberOfCells[i] + 1) elements.
-  vtkIdType offset = std::accumulate(&numberOfCells[0], &numberOfCells[filePiece], filePiece);
-  if ((offsetsArray = vtk::TakeSmartPointer(
-         this->Impl->NewMetadataArray("Offsets", offset, numberOfCells[filePiece] + 1))) == nullptr)
+  // the offsets array has (numberOfCells[i] + 1) elements per piece, including
+  // the pieces of the previous steps.
+  vtkIdType cellOffset = std::accumulate(
+    numberOfCells.begin(), numberOfCells.begin() + filePiece, static_cast<vtkIdType>(0));
+  offset = startingCellOffset + partOffset + cellOffset + filePiece;
+  if ((offsetsArray = this->Cache->Get<vtkDataArray>(
+         ::GetCacheKey<vtkIdType>("Offsets", { offset, numberOfCells[filePiece] + 1 }), [&]() {
+           return this->Impl->NewMetadataArray("Offsets", offset, numberOfCells[filePiece] + 1);
+         })) == nullptr)
   {
     vtkErrorMacro("Cannot read the Offsets array");
     return 0;
   }
-  offset = std::accumulate(&numberOfConnectivityIds[0], &numberOfConnectivityIds[filePiece], 0);
-  if ((connectivityArray = vtk::TakeSmartPointer(this->Impl->NewMetadataArray(
-         "Connectivity", offset, numberOfConnectivityIds[filePiece]))) == nullptr)
+  offset = startingConnectivityIdOffset +
+    std::accumulate(numberOfConnectivityIds.begin(), numberOfConnectivityIds.begin() + filePiece,
+      static_cast<vtkIdType>(0));
+  if ((connectivityArray = this->Cache->Get<vtkDataArray>(
+         ::GetCacheKey<vtkIdType>("Connectivity", { offset, numberOfConnectivityIds[filePiece] }),
+         [&]() {
+           return this->Impl->NewMetadataArray(
+             "Connectivity", offset, numberOfConnectivityIds[filePiece]);
+         })) == nullptr)
   {
     vtkErrorMacro("Cannot read the Connectivity array");
     return 0;
   }
   cellArray->SetData(offsetsArray, connectivityArray);
 
-  vtkIdType cellOffset = std::accumulate(&numberOfCells[0], &numberOfCells[filePiece], 0);
-  if ((p = vtk::TakeSmartPointer(
-         this->Impl->NewMetadataArray("Types", cellOffset, numberOfCells[filePiece]))) == nullptr)
+  offset = startingCellOffset + cellOffset;
+  if ((p = this->Cache->Get<vtkDataArray>(
+         ::GetCacheKey<vtkIdType>("Types", { offset, numberOfCells[filePiece] }), [&]() {
+           return this->Impl->NewMetadataArray("Types", offset, numberOfCells[filePiece]);
+         })) == nullptr)
   {
     vtkErrorMacro("Cannot read the Types array");
     return 0;
@@ -471,55 +714,53 @@ int vtkHDFReader::Read(const std::vector<vtkIdType>& numberOfPoints,
   }
   pieceData->SetCells(typesArray, cellArray);
 
-  std::vector<vtkIdType> offsets = { pointOffset, cellOffset };
-  std::vector<const std::vector<vtkIdType>*> numberOf = { &numberOfPoints, &numberOfCells };
-  // in the same order as vtkDataObject::AttributeTypes: POINT, CELL, FIELD
   // field arrays are only read on node 0
-  for (int attributeType = 0; attributeType < vtkDataObject::FIELD; ++attributeType)
-  {
-    std::vector<std::string> names = this->Impl->GetArrayNames(attributeType);
-    for (const std::string& name : names)
-    {
-      if (this->DataArraySelection[attributeType]->ArrayIsEnabled(name.c_str()))
-      {
-        vtkSmartPointer<vtkDataArray> array;
-        if ((array = vtk::TakeSmartPointer(this->Impl->NewArray(attributeType, name.c_str(),
-               offsets[attributeType], (*numberOf[attributeType])[filePiece]))) == nullptr)
-        {
-          vtkErrorMacro("Error reading array " << name);
-          return 0;
-        }
-        array->SetName(name.c_str());
-        pieceData->GetAttributesAsFieldData(attributeType)->AddArray(array);
-      }
-    }
-  }
-  return 1;
+  return this->ReadArrays(
+           vtkDataObject::POINT, pointOffset, numberOfPoints[filePiece], pieceData->GetPointData()) &&
+    this->ReadArrays(
+      vtkDataObject::CELL, cellOffset, numberOfCells[filePiece], pieceData->GetCellData());
 }
 
 //------------------------------------------------------------------------------
 int vtkHDFReader::Read(vtkInformation* outInfo, vtkUnstructuredGrid* data)
 {
   // this->PrintPieceInformation(outInfo);
-  int filePieceCount = this->Impl->GetNumberOfPieces();
-  std::vector<vtkIdType> numberOfPoints = this->Impl->GetMetadata("NumberOfPoints", filePieceCount);
+  vtkIdType partOffset = 0;
+  vtkIdType startingPointOffset = 0;
+  std::vector<vtkIdType> startingCellOffsets, startingConnectivityIdOffsets;
+  if (!this->ReadStepOffsets(
+        1, partOffset, startingPointOffset, startingCellOffsets, startingConnectivityIdOffsets))
+  {
+    return 0;
+  }
+  int filePieceCount = this->Impl->GetNumberOfPieces(this->ReadStep);
+  std::vector<vtkIdType> numberOfPoints =
+    this->Impl->GetMetadata("NumberOfPoints", filePieceCount, partOffset);
   if (numberOfPoints.empty())
   {
     return 0;
   }
-  std::vector<vtkIdType> numberOfCells = this->Impl->GetMetadata("NumberOfCells", filePieceCount);
+  std::vector<vtkIdType> numberOfCells =
+    this->Impl->GetMetadata("NumberOfCells", filePieceCount, partOffset);
   if (numberOfCells.empty())
   {
     return 0;
   }
   std::vector<vtkIdType> numberOfConnectivityIds =
-    this->Impl->GetMetadata("NumberOfConnectivityIds", filePieceCount);
+    this->Impl->GetMetadata("NumberOfConnectivityIds", filePieceCount, partOffset);
   if (numberOfConnectivityIds.empty())
   {
     return 0;
   }
   int memoryPieceCount = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
   int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  if (piece + memoryPieceCount >= filePieceCount)
+  {
+    // a single piece is read directly in the output, sharing the cached arrays
+    return piece >= filePieceCount ||
+      this->Read(numberOfPoints, numberOfCells, numberOfConnectivityIds, partOffset,
+        startingPointOffset, startingCellOffsets[0], startingConnectivityIdOffsets[0], piece, data);
+  }
   vtkNew<vtkUnstructuredGrid> pieceData;
   vtkNew<vtkAppendDataSets> append;
   append->AddInputData(data);
@@ -527,7 +768,154 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkUnstructuredGrid* data)
   for (int filePiece = piece; filePiece < filePieceCount; filePiece += memoryPieceCount)
   {
     pieceData->Initialize();
-    if (!this->Read(numberOfPoints, numberOfCells, numberOfConnectivityIds, filePiece, pieceData))
+    if (!this->Read(numberOfPoints, numberOfCells, numberOfConnectivityIds, partOffset,
+          startingPointOffset, startingCellOffsets[0], startingConnectivityIdOffsets[0], filePiece,
+          pieceData))
+    {
+      return 0;
+    }
+    append->Update();
+    data->ShallowCopy(append->GetOutput());
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFReader::Read(const std::vector<vtkIdType>& numberOfPoints,
+  const std::vector<std::vector<vtkIdType>>& numberOfCells,
+  const std::vector<std::vector<vtkIdType>>& numberOfConnectivityIds, vtkIdType partOffset,
+  vtkIdType startingPointOffset, const std::vector<vtkIdType>& startingCellOffsets,
+  const std::vector<vtkIdType>& startingConnectivityIdOffsets, int filePiece,
+  vtkPolyData* pieceData)
+{
+  vtkNew<vtkPoints> points;
+  vtkSmartPointer<vtkDataArray> pointArray;
+  vtkIdType pointOffset = std::accumulate(
+    numberOfPoints.begin(), numberOfPoints.begin() + filePiece, static_cast<vtkIdType>(0));
+  vtkIdType offset = startingPointOffset + pointOffset;
+  if ((pointArray = this->Cache->Get<vtkDataArray>(
+         ::GetCacheKey<vtkIdType>("Points", { offset, numberOfPoints[filePiece] }), [&]() {
+           return this->Impl->NewMetadataArray("Points", offset, numberOfPoints[filePiece]);
+         })) == nullptr)
+  {
+    vtkErrorMacro("Cannot read the Points array");
+    return 0;
+  }
+  points->SetData(pointArray);
+  pieceData->SetPoints(points);
+
+  // the cell data of a piece follows the cells of all topologies of the
+  // previous pieces
+  using SetCellsMethod = void (vtkPolyData::*)(vtkCellArray*);
+  const std::array<SetCellsMethod, 4> setCells = { &vtkPolyData::SetVerts, &vtkPolyData::SetLines,
+    &vtkPolyData::SetPolys, &vtkPolyData::SetStrips };
+  vtkIdType cellDataOffset = 0;
+  vtkIdType numberOfPieceCells = 0;
+  for (size_t topology = 0; topology < POLY_DATA_TOPOLOGIES.size(); ++topology)
+  {
+    const std::string group = POLY_DATA_TOPOLOGIES[topology];
+    const std::vector<vtkIdType>& topologyCells = numberOfCells[topology];
+    const std::vector<vtkIdType>& topologyConnectivityIds = numberOfConnectivityIds[topology];
+    vtkIdType cellOffset = std::accumulate(
+      topologyCells.begin(), topologyCells.begin() + filePiece, static_cast<vtkIdType>(0));
+    cellDataOffset += cellOffset;
+    numberOfPieceCells += topologyCells[filePiece];
+
+    // the offsets array has (numberOfCells[i] + 1) elements per piece,
+    // including the pieces of the previous steps.
+    vtkSmartPointer<vtkDataArray> offsetsArray;
+    const std::string offsetsName = group + "/Offsets";
+    offset = startingCellOffsets[topology] + partOffset + cellOffset + filePiece;
+    if ((offsetsArray = this->Cache->Get<vtkDataArray>(
+           ::GetCacheKey<vtkIdType>(offsetsName, { offset, topologyCells[filePiece] + 1 }), [&]() {
+             return this->Impl->NewMetadataArray(
+               offsetsName.c_str(), offset, topologyCells[filePiece] + 1);
+           })) == nullptr)
+    {
+      vtkErrorMacro("Cannot read the " << offsetsName << " array");
+      return 0;
+    }
+    vtkSmartPointer<vtkDataArray> connectivityArray;
+    const std::string connectivityName = group + "/Connectivity";
+    offset = startingConnectivityIdOffsets[topology] +
+      std::accumulate(topologyConnectivityIds.begin(),
+        topologyConnectivityIds.begin() + filePiece, static_cast<vtkIdType>(0));
+    if ((connectivityArray = this->Cache->Get<vtkDataArray>(
+           ::GetCacheKey<vtkIdType>(
+             connectivityName, { offset, topologyConnectivityIds[filePiece] }),
+           [&]() {
+             return this->Impl->NewMetadataArray(
+               connectivityName.c_str(), offset, topologyConnectivityIds[filePiece]);
+           })) == nullptr)
+    {
+      vtkErrorMacro("Cannot read the " << connectivityName << " array");
+      return 0;
+    }
+    vtkNew<vtkCellArray> cellArray;
+    if (!cellArray->SetData(offsetsArray, connectivityArray))
+    {
+      vtkErrorMacro("Invalid " << offsetsName << " or " << connectivityName << " array");
+      return 0;
+    }
+    (pieceData->*setCells[topology])(cellArray);
+  }
+
+  // field arrays are only read on node 0
+  return this->ReadArrays(
+           vtkDataObject::POINT, pointOffset, numberOfPoints[filePiece], pieceData->GetPointData()) &&
+    this->ReadArrays(
+      vtkDataObject::CELL, cellDataOffset, numberOfPieceCells, pieceData->GetCellData());
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFReader::Read(vtkInformation* outInfo, vtkPolyData* data)
+{
+  vtkIdType partOffset = 0;
+  vtkIdType startingPointOffset = 0;
+  std::vector<vtkIdType> startingCellOffsets, startingConnectivityIdOffsets;
+  if (!this->ReadStepOffsets(POLY_DATA_TOPOLOGIES.size(), partOffset, startingPointOffset,
+        startingCellOffsets, startingConnectivityIdOffsets))
+  {
+    return 0;
+  }
+  int filePieceCount = this->Impl->GetNumberOfPieces(this->ReadStep);
+  std::vector<vtkIdType> numberOfPoints =
+    this->Impl->GetMetadata("NumberOfPoints", filePieceCount, partOffset);
+  if (numberOfPoints.empty())
+  {
+    return 0;
+  }
+  std::vector<std::vector<vtkIdType>> numberOfCells, numberOfConnectivityIds;
+  for (const char* group : POLY_DATA_TOPOLOGIES)
+  {
+    numberOfCells.push_back(this->Impl->GetMetadata(
+      (std::string(group) + "/NumberOfCells").c_str(), filePieceCount, partOffset));
+    numberOfConnectivityIds.push_back(this->Impl->GetMetadata(
+      (std::string(group) + "/NumberOfConnectivityIds").c_str(), filePieceCount, partOffset));
+    if (numberOfCells.back().empty() || numberOfConnectivityIds.back().empty())
+    {
+      return 0;
+    }
+  }
+  int memoryPieceCount = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+  int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  if (piece + memoryPieceCount >= filePieceCount)
+  {
+    // a single piece is read directly in the output, sharing the cached arrays
+    return piece >= filePieceCount ||
+      this->Read(numberOfPoints, numberOfCells, numberOfConnectivityIds, partOffset,
+        startingPointOffset, startingCellOffsets, startingConnectivityIdOffsets, piece, data);
+  }
+  vtkNew<vtkPolyData> pieceData;
+  vtkNew<vtkAppendPolyData> append;
+  append->AddInputData(data);
+  append->AddInputData(pieceData);
+  for (int filePiece = piece; filePiece < filePieceCount; filePiece += memoryPieceCount)
+  {
+    pieceData->Initialize();
+    if (!this->Read(numberOfPoints, numberOfCells, numberOfConnectivityIds, partOffset,
+          startingPointOffset, startingCellOffsets, startingConnectivityIdOffsets, filePiece,
+          pieceData))
     {
       return 0;
     }
@@ -567,6 +955,40 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
     return 0;
   }
   int dataSetType = this->Impl->GetDataSetType();
+
+  // read the last step starting at or before the requested time, or the
+  // step of the nearest time if the time values are not sorted
+  vtkIdType numberOfSteps = this->Impl->GetNumberOfSteps();
+  this->ReadStep = this->Step;
+  if (numberOfSteps > 0 && dataSetType != VTK_OVERLAPPING_AMR)
+  {
+    const std::vector<double>& values = this->Impl->GetStepValues();
+    if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+    {
+      double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+      if (this->SortedStepValues)
+      {
+        this->ReadStep =
+          std::upper_bound(values.begin(), values.end(), time) - values.begin() - 1;
+      }
+      else
+      {
+        this->ReadStep = 0;
+        for (vtkIdType step = 1; step < numberOfSteps; ++step)
+        {
+          if (std::abs(values[step] - time) < std::abs(values[this->ReadStep] - time))
+          {
+            this->ReadStep = step;
+          }
+        }
+      }
+    }
+    this->ReadStep =
+      std::max(static_cast<vtkIdType>(0), std::min(this->ReadStep, numberOfSteps - 1));
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), values[this->ReadStep]);
+  }
+
+  this->Cache->BeginUpdate(this->UseCache, this->FileName);
   if (dataSetType == VTK_IMAGE_DATA)
   {
     vtkImageData* data = vtkImageData::SafeDownCast(output);
@@ -577,6 +999,11 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
     vtkUnstructuredGrid* data = vtkUnstructuredGrid::SafeDownCast(output);
     ok = this->Read(outInfo, data);
   }
+  else if (dataSetType == VTK_POLY_DATA)
+  {
+    vtkPolyData* data = vtkPolyData::SafeDownCast(output);
+    ok = this->Read(outInfo, data);
+  }
   else if (dataSetType == VTK_OVERLAPPING_AMR)
   {
     vtkOverlappingAMR* data = vtkOverlappingAMR::SafeDownCast(output);
@@ -585,7 +1012,9 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
   else
   {
     vtkErrorMacro("HDF dataset type unknown: " << dataSetType);
-    return 0;
+    ok = 0;
   }
-  return ok && this->AddFieldArrays(output);
+  ok = ok && this->AddFieldArrays(output);
+  this->Cache->EndUpdate();
+  return ok;
 }
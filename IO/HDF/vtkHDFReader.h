@@ -34,7 +34,9 @@ class vtkDataSetAttributes;
 class vtkImageData;
 class vtkInformationVector;
 class vtkInformation;
+class vtkFieldData;
 class vtkOverlappingAMR;
+class vtkPolyData;
 class vtkUnstructuredGrid;
 
 /**
@@ -42,8 +44,20 @@ class vtkUnstructuredGrid;
  * @brief  Read VTK HDF files.
  *
  * Reads data saved using the VTK HDF format which supports all
- * vtkDataSet types (image data and unstructured grid are currently
- * implemented) and serial as well as parallel processing.
+ * vtkDataSet types (image data, unstructured grid, polydata and overlapping
+ * AMR are currently implemented) and serial as well as parallel processing.
+ *
+ * Image data, unstructured grids and polydata can have several steps in the
+ * same file, described by the /VTKHDF/Steps group. The time values of the
+ * steps are reported as TIME_STEPS and the step matching the requested
+ * UPDATE_TIME_STEP is read. The geometry, the topology and each array of a
+ * step are found at offsets in the datasets of the file, so steps can share
+ * values that do not change.
+ *
+ * With UseCache on, the arrays read for the last update are kept and reused
+ * for the next update when the step shares them, so that moving through time
+ * only reads the values that changed. Cached arrays are shared between the
+ * outputs of the updates and should not be modified in place.
  *
  */
 class VTKIOHDF_EXPORT vtkHDFReader : public vtkDataObjectAlgorithm
@@ -108,6 +122,32 @@ public:
   vtkSetMacro(MaximumLevelsToReadByDefaultForAMR, unsigned int);
   vtkGetMacro(MaximumLevelsToReadByDefaultForAMR, unsigned int);
 
+  /**
+   * Get the number of steps of the dataset, 0 for a dataset without steps.
+   * Available after RequestInformation.
+   */
+  vtkIdType GetNumberOfSteps();
+
+  //@{
+  /**
+   * Get/Set the step read when the pipeline does not request a time. When
+   * it does, the last step whose time value is at or before the requested
+   * time is read instead, without changing Step. Default is 0.
+   */
+  vtkSetMacro(Step, vtkIdType);
+  vtkGetMacro(Step, vtkIdType);
+  //@}
+
+  //@{
+  /**
+   * Keep the arrays read for the last update, and reuse them when the next
+   * update reads the same values from the file. Default is off.
+   */
+  vtkSetMacro(UseCache, bool);
+  vtkGetMacro(UseCache, bool);
+  vtkBooleanMacro(UseCache, bool);
+  //@}
+
 protected:
   vtkHDFReader();
   ~vtkHDFReader() override;
@@ -130,17 +170,47 @@ protected:
    */
   int Read(vtkInformation* outInfo, vtkImageData* data);
   int Read(vtkInformation* outInfo, vtkUnstructuredGrid* data);
+  int Read(vtkInformation* outInfo, vtkPolyData* data);
   int Read(vtkInformation* outInfo, vtkOverlappingAMR* data);
   //@}
   /**
    * Read 'pieceData' specified by 'filePiece' where
    * number of points, cells and connectivity ids
-   * store those numbers for all pieces.
+   * store those numbers for all pieces of the step. The offsets give where
+   * the step starts in the partitions, points, cells and connectivity ids
+   * of the file.
    */
   int Read(const std::vector<vtkIdType>& numberOfPoints,
     const std::vector<vtkIdType>& numberOfCells,
-    const std::vector<vtkIdType>& numberOfConnectivityIds, int filePiece,
-    vtkUnstructuredGrid* pieceData);
+    const std::vector<vtkIdType>& numberOfConnectivityIds, vtkIdType partOffset,
+    vtkIdType startingPointOffset, vtkIdType startingCellOffset,
+    vtkIdType startingConnectivityIdOffset, int filePiece, vtkUnstructuredGrid* pieceData);
+  /**
+   * Read polydata 'pieceData' specified by 'filePiece'. The number of cells
+   * and connectivity ids and the starting offsets are given for each
+   * topology: vertices, lines, polygons and strips.
+   */
+  int Read(const std::vector<vtkIdType>& numberOfPoints,
+    const std::vector<std::vector<vtkIdType>>& numberOfCells,
+    const std::vector<std::vector<vtkIdType>>& numberOfConnectivityIds, vtkIdType partOffset,
+    vtkIdType startingPointOffset, const std::vector<vtkIdType>& startingCellOffsets,
+    const std::vector<vtkIdType>& startingConnectivityIdOffsets, int filePiece,
+    vtkPolyData* pieceData);
+  /**
+   * Read where the current step starts in the partitions, points, cells and
+   * connectivity ids of the file, with cell and connectivity id offsets for
+   * 'numberOfTopologies' topologies. The offsets are 0 for a dataset without
+   * steps. Returns 1 if successfull, 0 otherwise.
+   */
+  int ReadStepOffsets(size_t numberOfTopologies, vtkIdType& partOffset, vtkIdType& pointOffset,
+    std::vector<vtkIdType>& cellOffsets, std::vector<vtkIdType>& connectivityIdOffsets);
+  /**
+   * Read the enabled point or cell arrays of a piece, starting at
+   * 'pieceOffset' in the values of the current step, and add them to
+   * 'data'.
+   */
+  int ReadArrays(int attributeType, vtkIdType pieceOffset, vtkIdType numberOfTuples,
+    vtkFieldData* data);
   /**
    * Read the field arrays from the file and add them to the dataset.
    */
@@ -202,8 +272,19 @@ protected:
 
   unsigned int MaximumLevelsToReadByDefaultForAMR = 0;
 
+  vtkIdType Step = 0;
+  bool UseCache = false;
+
+  // The step being read, Step or the step of the requested time
+  vtkIdType ReadStep = 0;
+  // Whether the time values of the steps are increasing
+  bool SortedStepValues = true;
+
   class Implementation;
   Implementation* Impl;
+
+  class DataCache;
+  DataCache* Cache;
 };
 
 #endif
@@ -82,8 +82,10 @@ vtkHDFReader::Implementation::TypeDescription vtkHDFReader::Implementation::GetT
 vtkHDFReader::Implementation::Implementation(vtkHDFReader* reader)
   : File(-1)
   , VTKGroup(-1)
+  , StepsGroup(-1)
   , DataSetType(-1)
   , NumberOfPieces(-1)
+  , NumberOfSteps(0)
   , Reader(reader)
 {
   std::fill(this->AttributeDataGroup.begin(), this->AttributeDataGroup.end(), -1);
@@ -147,6 +149,8 @@ bool vtkHDFReader::Implementation::Open(const char* fileName)
     vtkErrorWithObjectMacro(this->Reader, "Invalid filename: " << fileName);
     return false;
   }
+  // needed to read the steps
+  this->BuildTypeReaderMap();
   if (this->FileName.empty() || this->FileName != fileName)
   {
     this->FileName = fileName;
@@ -200,7 +204,7 @@ bool vtkHDFReader::Implementation::Open(const char* fileName)
 
     try
     {
-      if (this->DataSetType == VTK_UNSTRUCTURED_GRID)
+      if (this->DataSetType == VTK_UNSTRUCTURED_GRID || this->DataSetType == VTK_POLY_DATA)
       {
         const char* datasetName = "/VTKHDF/NumberOfPoints";
         std::vector<hsize_t> dims = this->GetDimensions(datasetName);
@@ -214,6 +218,10 @@ bool vtkHDFReader::Implementation::Open(const char* fileName)
       {
         this->NumberOfPieces = 1;
       }
+      if (!this->ReadSteps())
+      {
+        throw std::runtime_error("Cannot read the steps of " + this->FileName);
+      }
     }
     catch (const std::exception& e)
     {
@@ -221,7 +229,6 @@ bool vtkHDFReader::Implementation::Open(const char* fileName)
       error = true;
     }
   }
-  this->BuildTypeReaderMap();
   return !error;
 }
 
@@ -287,6 +294,10 @@ bool vtkHDFReader::Implementation::ReadDataSetType()
     {
       this->DataSetType = VTK_UNSTRUCTURED_GRID;
     }
+    else if (typeName == "PolyData")
+    {
+      this->DataSetType = VTK_POLY_DATA;
+    }
     else
     {
       vtkErrorWithObjectMacro(this->Reader, "Unknown data set type: " << typeName);
@@ -306,6 +317,9 @@ void vtkHDFReader::Implementation::Close()
 {
   this->DataSetType = -1;
   this->NumberOfPieces = 0;
+  this->NumberOfSteps = 0;
+  this->StepValues.clear();
+  this->NumberOfParts.clear();
   std::fill(this->Version.begin(), this->Version.end(), 0);
   for (size_t i = 0; i < this->AttributeDataGroup.size(); ++i)
   {
@@ -315,6 +329,11 @@ void vtkHDFReader::Implementation::Close()
       this->AttributeDataGroup[i] = -1;
     }
   }
+  if (this->StepsGroup >= 0)
+  {
+    H5Gclose(this->StepsGroup);
+    this->StepsGroup = -1;
+  }
   if (this->VTKGroup >= 0)
   {
     H5Gclose(this->VTKGroup);
@@ -327,6 +346,119 @@ void vtkHDFReader::Implementation::Close()
   }
 }
 
+//------------------------------------------------------------------------------
+bool vtkHDFReader::Implementation::ReadSteps()
+{
+  this->NumberOfSteps = 0;
+  this->StepValues.clear();
+  this->NumberOfParts.clear();
+  if (H5Lexists(this->VTKGroup, "Steps", H5P_DEFAULT) <= 0)
+  {
+    // a dataset without steps
+    return true;
+  }
+  if ((this->StepsGroup = H5Gopen(this->VTKGroup, "Steps", H5P_DEFAULT)) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Reader, "Cannot open the Steps group");
+    return false;
+  }
+  int numberOfSteps = 0;
+  vtkHDF::ScopedH5AHandle attr = H5Aopen_name(this->StepsGroup, "NSteps");
+  if (attr < 0 || H5Aread(attr, H5T_NATIVE_INT, &numberOfSteps) < 0 || numberOfSteps < 1)
+  {
+    vtkErrorWithObjectMacro(this->Reader, "Cannot read the NSteps attribute of the Steps group");
+    return false;
+  }
+
+  std::vector<hsize_t> fileExtent = { 0, static_cast<hsize_t>(numberOfSteps - 1) };
+  auto values = vtk::TakeSmartPointer(this->NewArrayForGroup(this->StepsGroup, "Values", fileExtent));
+  if (!values)
+  {
+    return false;
+  }
+  auto valueRange = vtk::DataArrayValueRange<1>(values);
+  this->StepValues.assign(valueRange.begin(), valueRange.end());
+  this->NumberOfParts.assign(numberOfSteps, this->NumberOfPieces);
+  if (H5Lexists(this->StepsGroup, "NumberOfParts", H5P_DEFAULT) > 0)
+  {
+    auto parts =
+      vtk::TakeSmartPointer(this->NewArrayForGroup(this->StepsGroup, "NumberOfParts", fileExtent));
+    if (!parts)
+    {
+      return false;
+    }
+    auto partRange = vtk::DataArrayValueRange<1>(parts);
+    std::copy(partRange.begin(), partRange.end(), this->NumberOfParts.begin());
+  }
+  this->NumberOfSteps = numberOfSteps;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFReader::Implementation::GetNumberOfPieces(vtkIdType step)
+{
+  if (step >= 0 && step < this->NumberOfSteps)
+  {
+    return static_cast<int>(this->NumberOfParts[step]);
+  }
+  return this->NumberOfPieces;
+}
+
+//------------------------------------------------------------------------------
+std::vector<vtkIdType> vtkHDFReader::Implementation::GetStepValues(
+  const char* name, vtkIdType step)
+{
+  std::vector<vtkIdType> values;
+  if (step < 0 || step >= this->NumberOfSteps)
+  {
+    vtkErrorWithObjectMacro(this->Reader, "Invalid step: " << step);
+    return values;
+  }
+  std::vector<hsize_t> dims;
+  hid_t tempNativeType = H5I_INVALID_HID;
+  vtkHDF::ScopedH5DHandle dataset = this->OpenDataSet(this->StepsGroup, name, &tempNativeType, dims);
+  vtkHDF::ScopedH5THandle nativeType = tempNativeType;
+  if (dataset < 0)
+  {
+    return values;
+  }
+  // the row of a 2D dataset is read as a 1D slab, slowest dimension last
+  std::vector<hsize_t> fileExtent = { static_cast<hsize_t>(step), static_cast<hsize_t>(step) };
+  if (dims.size() == 2)
+  {
+    fileExtent.insert(fileExtent.begin(), { 0, dims[1] - 1 });
+  }
+  auto a = vtk::TakeSmartPointer(this->NewArrayForGroup(dataset, nativeType, dims, fileExtent));
+  if (!a)
+  {
+    return values;
+  }
+  auto range = vtk::DataArrayValueRange(a);
+  values.assign(range.begin(), range.end());
+  return values;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkHDFReader::Implementation::GetArrayOffset(
+  vtkIdType step, int attributeType, const std::string& name)
+{
+  // in the same order as vtkDataObject::AttributeTypes: POINT, CELL, FIELD
+  static const std::array<std::string, 3> groupNames = { "PointDataOffsets", "CellDataOffsets",
+    "FieldDataOffsets" };
+  if (this->StepsGroup < 0 ||
+    H5Lexists(this->StepsGroup, groupNames[attributeType].c_str(), H5P_DEFAULT) <= 0)
+  {
+    return -1;
+  }
+  std::string path = groupNames[attributeType] + "/" + name;
+  if (H5Lexists(this->StepsGroup, path.c_str(), H5P_DEFAULT) <= 0)
+  {
+    return -1;
+  }
+  std::vector<vtkIdType> offset = this->GetStepValues(path.c_str(), step);
+  return offset.empty() ? -1 : offset[0];
+}
+
 //------------------------------------------------------------------------------
 void vtkHDFReader::Implementation::BuildTypeReaderMap()
 {
@@ -724,7 +856,8 @@ vtkStringArray* vtkHDFReader::Implementation::NewStringArray(hid_t dataset, hsiz
 }
 
 //------------------------------------------------------------------------------
-vtkAbstractArray* vtkHDFReader::Implementation::NewFieldArray(const char* name)
+vtkAbstractArray* vtkHDFReader::Implementation::NewFieldArray(
+  const char* name, vtkIdType offset, vtkIdType size)
 {
   hid_t tempNativeType = -1;
   std::vector<hsize_t> dims;
@@ -742,6 +875,18 @@ vtkAbstractArray* vtkHDFReader::Implementation::NewFieldArray(const char* name)
     if (dims.size() == 1)
     {
       array = this->NewStringArray(dataset, dims[0]);
+      if (array && offset >= 0)
+      {
+        // keep the strings of the requested step
+        vtkStringArray* stepArray = vtkStringArray::New();
+        stepArray->SetNumberOfValues(size);
+        for (vtkIdType i = 0; i < size; ++i)
+        {
+          stepArray->SetValue(i, array->GetValue(offset + i));
+        }
+        array->Delete();
+        array = stepArray;
+      }
     }
     else
     {
@@ -756,6 +901,10 @@ vtkAbstractArray* vtkHDFReader::Implementation::NewFieldArray(const char* name)
     // empty fileExtent means read all values from the file
     // field arrays are always 1D
     std::vector<hsize_t> fileExtent;
+    if (offset >= 0)
+    {
+      fileExtent = { static_cast<hsize_t>(offset), static_cast<hsize_t>(offset + size - 1) };
+    }
     return NewArrayForGroup(this->AttributeDataGroup[vtkDataObject::FIELD], name, fileExtent);
   }
 }
@@ -769,10 +918,11 @@ vtkDataArray* vtkHDFReader::Implementation::NewMetadataArray(
 }
 
 //------------------------------------------------------------------------------
-std::vector<vtkIdType> vtkHDFReader::Implementation::GetMetadata(const char* name, hsize_t size)
+std::vector<vtkIdType> vtkHDFReader::Implementation::GetMetadata(
+  const char* name, hsize_t size, hsize_t offset)
 {
   std::vector<vtkIdType> v;
-  std::vector<hsize_t> fileExtent = { 0, size - 1 };
+  std::vector<hsize_t> fileExtent = { offset, offset + size - 1 };
   auto a = vtk::TakeSmartPointer(NewArrayForGroup(this->VTKGroup, name, fileExtent));
   if (!a)
   {
@@ -876,6 +1026,11 @@ vtkDataArray* vtkHDFReader::Implementation::NewArray(
   auto array = vtkAOSDataArrayTemplate<T>::SafeDownCast(NewVtkDataArray<T>());
   array->SetNumberOfComponents(numberOfComponents);
   array->SetNumberOfTuples(numberOfTuples);
+  if (numberOfTuples == 0)
+  {
+    // nothing to read, such as the strips of polydata without strips
+    return array;
+  }
   T* data = array->GetPointer(0);
   if (!this->NewArray(dataset, fileExtent, numberOfComponents, data))
   {
@@ -50,8 +50,8 @@ public:
    */
   void Close();
   /**
-   * Type of vtkDataSet stored by the HDF file, such as VTK_IMAGE_DATA or
-   * VTK_UNSTRUCTURED_GRID, from vtkTypes.h
+   * Type of vtkDataSet stored by the HDF file, such as VTK_IMAGE_DATA,
+   * VTK_UNSTRUCTURED_GRID or VTK_POLY_DATA, from vtkTypes.h
    */
   int GetDataSetType() { return this->DataSetType; }
   /**
@@ -64,9 +64,30 @@ public:
   template <typename T>
   bool GetAttribute(const char* attributeName, size_t numberOfElements, T* value);
   /**
-   * Returns the number of partitions for this dataset.
+   * Returns the number of partitions for this dataset, or for 'step' for
+   * datasets with steps.
    */
-  int GetNumberOfPieces() { return this->NumberOfPieces; }
+  int GetNumberOfPieces(vtkIdType step = -1);
+  /**
+   * Returns the number of steps of a dataset with steps, or 0 for a dataset
+   * without steps.
+   */
+  vtkIdType GetNumberOfSteps() { return this->NumberOfSteps; }
+  /**
+   * Returns the time values of the steps.
+   */
+  const std::vector<double>& GetStepValues() { return this->StepValues; }
+  /**
+   * Reads the row of 'step' of a dataset of the /VTKHDF/Steps group, such as
+   * PointOffsets or CellOffsets. Returns an empty vector for an error.
+   */
+  std::vector<vtkIdType> GetStepValues(const char* name, vtkIdType step);
+  /**
+   * Returns the offset of the values of array 'name' for 'step', read from
+   * the [Point|Cell|Field]DataOffsets groups of /VTKHDF/Steps, or -1 when the
+   * array has no offsets, in which case all steps use the same values.
+   */
+  vtkIdType GetArrayOffset(vtkIdType step, int attributeType, const std::string& name);
   /**
    * For an ImageData, sets the extent for 'partitionIndex'. Returns
    * true for success and false otherwise.
@@ -88,18 +109,18 @@ public:
   vtkDataArray* NewArray(
     int attributeType, const char* name, const std::vector<hsize_t>& fileExtent);
   vtkDataArray* NewArray(int attributeType, const char* name, hsize_t offset, hsize_t size);
-  vtkAbstractArray* NewFieldArray(const char* name);
+  vtkAbstractArray* NewFieldArray(const char* name, vtkIdType offset = -1, vtkIdType size = -1);
   //@}
 
   //@{
   /**
    * Reads a 1D metadata array in a DataArray or a vector of vtkIdType.
-   * We read either the whole array for the vector version or a slice
-   * specified with (offset, size). For an error we return nullptr or an
-   * empty vector.
+   * We read a slice specified with (offset, size). For an error we return
+   * nullptr or an empty vector. 'name' is relative to the /VTKHDF group, such
+   * as "Polygons/Offsets".
    */
   vtkDataArray* NewMetadataArray(const char* name, hsize_t offset, hsize_t size);
-  std::vector<vtkIdType> GetMetadata(const char* name, hsize_t size);
+  std::vector<vtkIdType> GetMetadata(const char* name, hsize_t size, hsize_t offset = 0);
   //@}
   /**
    * Returns the dimensions of a HDF dataset.
@@ -198,10 +219,14 @@ private:
   std::string FileName;
   hid_t File;
   hid_t VTKGroup;
+  hid_t StepsGroup;
   // in the same order as vtkDataObject::AttributeTypes: POINT, CELL, FIELD
   std::array<hid_t, 3> AttributeDataGroup;
   int DataSetType;
   int NumberOfPieces;
+  vtkIdType NumberOfSteps;
+  std::vector<double> StepValues;
+  std::vector<vtkIdType> NumberOfParts;
   std::array<int, 2> Version;
   vtkHDFReader* Reader;
   using ArrayReader = vtkDataArray* (vtkHDFReader::Implementation::*)(hid_t dataset,
@@ -209,6 +234,7 @@ private:
   std::map<TypeDescription, ArrayReader> TypeReaderMap;
 
   bool ReadDataSetType();
+  bool ReadSteps();
 
   //@{
   /**
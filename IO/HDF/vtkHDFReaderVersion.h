@@ -20,7 +20,7 @@
 #ifndef vtkHDFReaderVersion_h
 #define vtkHDFReaderVersion_h
 
-const int vtkHDFReaderMajorVersion = 1;
+const int vtkHDFReaderMajorVersion = 2;
 const int vtkHDFReaderMinorVersion = 0;
 
 #endif // vtkHDFReaderVersion_h
@@ -0,0 +1,571 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkHDFWriter.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCommunicator.h"
+#include "vtkDataArray.h"
+#include "vtkErrorCode.h"
+#include "vtkFieldData.h"
+#include "vtkHDFWriterImplementation.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <string>
+
+vtkStandardNewMacro(vtkHDFWriter);
+vtkCxxSetObjectMacro(vtkHDFWriter, Controller, vtkMultiProcessController);
+
+namespace
+{
+// Tag of the messages passing the turn to write between processes.
+const int WRITE_TURN_TAG = 10437;
+
+// Groups of the cells of a vtkPolyData, in the order of the cell ids.
+const std::array<const char*, 4> POLY_DATA_TOPOLOGIES = { "Vertices", "Lines", "Polygons",
+  "Strips" };
+
+//----------------------------------------------------------------------------
+// Same number of dimensions as the datasets read by vtkHDFReader: the
+// trailing flat dimensions are dropped.
+int GetNDims(const int* extent)
+{
+  int ndims = 3;
+  if (extent[5] - extent[4] == 0)
+  {
+    --ndims;
+    if (extent[3] - extent[2] == 0)
+    {
+      --ndims;
+    }
+  }
+  return ndims;
+}
+
+//----------------------------------------------------------------------------
+// Offset of 'piece' in per piece counts stored with 'stride' counts per
+// piece.
+vtkIdType GetPieceOffset(
+  const std::vector<vtkIdType>& counts, int piece, int stride, int countIndex)
+{
+  vtkIdType offset = 0;
+  for (int i = 0; i < piece; ++i)
+  {
+    offset += counts[i * stride + countIndex];
+  }
+  return offset;
+}
+
+//----------------------------------------------------------------------------
+// Count of each piece, from per piece counts stored with 'stride' counts per
+// piece.
+std::vector<vtkIdType> GetPieceCounts(
+  const std::vector<vtkIdType>& counts, int stride, int countIndex)
+{
+  std::vector<vtkIdType> pieceCounts(counts.size() / stride);
+  for (size_t i = 0; i < pieceCounts.size(); ++i)
+  {
+    pieceCounts[i] = counts[i * stride + countIndex];
+  }
+  return pieceCounts;
+}
+
+//----------------------------------------------------------------------------
+// The cell data of polydata is written in the order of the cells of the
+// topologies: vertices, lines, polygons then strips. The cell data of cells
+// inserted in another order is reordered.
+vtkSmartPointer<vtkFieldData> GetOrderedCellData(vtkPolyData* input)
+{
+  vtkCellData* cellData = input->GetCellData();
+  const vtkIdType numberOfCells = input->GetNumberOfCells();
+  const vtkIdType starts[4] = { 0, input->GetNumberOfVerts(),
+    input->GetNumberOfVerts() + input->GetNumberOfLines(),
+    input->GetNumberOfVerts() + input->GetNumberOfLines() + input->GetNumberOfPolys() };
+  vtkNew<vtkIdList> order;
+  order->SetNumberOfIds(numberOfCells);
+  bool ordered = true;
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    int topology;
+    switch (input->GetCellType(cellId))
+    {
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+        topology = 0;
+        break;
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+        topology = 1;
+        break;
+      case VTK_TRIANGLE:
+      case VTK_QUAD:
+      case VTK_POLYGON:
+        topology = 2;
+        break;
+      case VTK_TRIANGLE_STRIP:
+        topology = 3;
+        break;
+      default:
+        // deleted cells, the cell data is written as it is
+        return cellData;
+    }
+    const vtkIdType index = starts[topology] + input->GetCellIdRelativeToCellArray(cellId);
+    order->SetId(index, cellId);
+    ordered = ordered && index == cellId;
+  }
+  if (ordered)
+  {
+    return cellData;
+  }
+  vtkNew<vtkFieldData> orderedCellData;
+  for (int i = 0; i < cellData->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = cellData->GetAbstractArray(i);
+    auto orderedArray = vtk::TakeSmartPointer(array->NewInstance());
+    orderedArray->SetName(array->GetName());
+    orderedArray->SetNumberOfComponents(array->GetNumberOfComponents());
+    orderedArray->SetNumberOfTuples(numberOfCells);
+    array->GetTuples(order, orderedArray);
+    orderedCellData->AddArray(orderedArray);
+  }
+  return orderedCellData;
+}
+}
+
+//------------------------------------------------------------------------------
+vtkHDFWriter::vtkHDFWriter()
+  : FileName(nullptr)
+  , ChunkSize(25000)
+  , CompressionLevel(0)
+  , Controller(nullptr)
+{
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->Impl = new vtkHDFWriter::Implementation(this);
+}
+
+//------------------------------------------------------------------------------
+vtkHDFWriter::~vtkHDFWriter()
+{
+  delete this->Impl;
+  this->SetFileName(nullptr);
+  this->SetController(nullptr);
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "ChunkSize: " << this->ChunkSize << "\n";
+  os << indent << "CompressionLevel: " << this->CompressionLevel << "\n";
+  os << indent << "Controller: " << this->Controller << "\n";
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFWriter::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkImageData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeBool vtkHDFWriter::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT()))
+  {
+    return this->RequestUpdateExtent(request, inputVector, outputVector);
+  }
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFWriter::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
+{
+  if (this->Controller)
+  {
+    vtkInformation* info = inputVector[0]->GetInformationObject(0);
+    info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+      this->Controller->GetLocalProcessId());
+    info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+      this->Controller->GetNumberOfProcesses());
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::WriteData()
+{
+  if (!this->FileName)
+  {
+    vtkErrorMacro("Requires valid output file name");
+    this->SetErrorCode(vtkErrorCode::NoFileNameError);
+    return;
+  }
+
+  vtkDataObject* input = this->GetInput();
+  bool ok = false;
+  if (vtkImageData* imageData = vtkImageData::SafeDownCast(input))
+  {
+    ok = this->WriteImageData(imageData);
+  }
+  else if (vtkUnstructuredGrid* unstructuredGrid = vtkUnstructuredGrid::SafeDownCast(input))
+  {
+    ok = this->WriteUnstructuredGrid(unstructuredGrid);
+  }
+  else if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(input))
+  {
+    ok = this->WritePolyData(polyData);
+  }
+  else
+  {
+    vtkErrorMacro("Unsupported data type: " << (input ? input->GetClassName() : "(none)"));
+  }
+  if (!ok)
+  {
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+  }
+}
+
+//------------------------------------------------------------------------------
+std::vector<vtkIdType> vtkHDFWriter::GatherCounts(const std::vector<vtkIdType>& counts)
+{
+  if (!this->Controller || this->Controller->GetNumberOfProcesses() <= 1)
+  {
+    return counts;
+  }
+  std::vector<vtkIdType> allCounts(counts.size() * this->Controller->GetNumberOfProcesses());
+  this->Controller->AllGather(
+    counts.data(), allCounts.data(), static_cast<vtkIdType>(counts.size()));
+  return allCounts;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::WriteInTurn(const std::function<bool()>& write)
+{
+  const int numberOfProcesses = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  if (numberOfProcesses <= 1)
+  {
+    bool ok = write();
+    this->Impl->Close();
+    return ok;
+  }
+
+  const int rank = this->Controller->GetLocalProcessId();
+  int ok = 1;
+  if (rank > 0)
+  {
+    this->Controller->Receive(&ok, 1, rank - 1, WRITE_TURN_TAG);
+  }
+  if (ok)
+  {
+    ok = write() ? 1 : 0;
+    this->Impl->Close();
+  }
+  if (rank < numberOfProcesses - 1)
+  {
+    this->Controller->Send(&ok, 1, rank + 1, WRITE_TURN_TAG);
+  }
+  int allOk = 0;
+  this->Controller->AllReduce(&ok, &allOk, 1, vtkCommunicator::MIN_OP);
+  return allOk != 0;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::WriteImageData(vtkImageData* input)
+{
+  // The whole extent is the union of the extents of the pieces.
+  int extent[6];
+  input->GetExtent(extent);
+  std::vector<vtkIdType> extents = this->GatherCounts(
+    std::vector<vtkIdType>(extent, extent + 6));
+  int wholeExtent[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX,
+    VTK_INT_MIN };
+  for (size_t piece = 0; piece < extents.size() / 6; ++piece)
+  {
+    const vtkIdType* pieceExtent = &extents[6 * piece];
+    if (pieceExtent[0] > pieceExtent[1] || pieceExtent[2] > pieceExtent[3] ||
+      pieceExtent[4] > pieceExtent[5])
+    {
+      // empty piece
+      continue;
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      wholeExtent[2 * i] = std::min(wholeExtent[2 * i], static_cast<int>(pieceExtent[2 * i]));
+      wholeExtent[2 * i + 1] =
+        std::max(wholeExtent[2 * i + 1], static_cast<int>(pieceExtent[2 * i + 1]));
+    }
+  }
+  if (wholeExtent[0] > wholeExtent[1])
+  {
+    std::fill(wholeExtent, wholeExtent + 6, 0);
+  }
+  const bool emptyPiece = extent[0] > extent[1] || extent[2] > extent[3] || extent[4] > extent[5];
+
+  // The arrays are stored with the slowest varying dimension first. The
+  // cell arrays have one value less along each dimension that is not flat.
+  const int ndims = ::GetNDims(wholeExtent);
+  std::vector<hsize_t> pointDims(ndims), cellDims(ndims);
+  std::vector<hsize_t> pointStart(ndims), pointCount(ndims), cellStart(ndims), cellCount(ndims);
+  for (int i = 0; i < ndims; ++i)
+  {
+    const int axis = ndims - 1 - i;
+    const bool flat = wholeExtent[2 * axis + 1] == wholeExtent[2 * axis];
+    pointDims[i] = wholeExtent[2 * axis + 1] - wholeExtent[2 * axis] + 1;
+    cellDims[i] = flat ? 1 : pointDims[i] - 1;
+    pointStart[i] = cellStart[i] = emptyPiece ? 0 : extent[2 * axis] - wholeExtent[2 * axis];
+    pointCount[i] = emptyPiece ? 0 : extent[2 * axis + 1] - extent[2 * axis] + 1;
+    cellCount[i] = emptyPiece ? 0 : (flat ? 1 : pointCount[i] - 1);
+  }
+
+  return this->WriteInTurn([&]() {
+    if (this->Controller == nullptr || this->Controller->GetLocalProcessId() == 0)
+    {
+      double direction[9];
+      vtkMatrix3x3::DeepCopy(direction, input->GetDirectionMatrix());
+      if (!this->Impl->Create(this->FileName) || !this->Impl->WriteHeader("ImageData") ||
+        !this->Impl->WriteAttribute("WholeExtent", 6, wholeExtent) ||
+        !this->Impl->WriteAttribute("Origin", 3, input->GetOrigin()) ||
+        !this->Impl->WriteAttribute("Spacing", 3, input->GetSpacing()) ||
+        !this->Impl->WriteAttribute("Direction", 9, direction) ||
+        !this->Impl->CreateArrayDataSets("PointData", input->GetPointData(), pointDims) ||
+        !this->Impl->CreateArrayDataSets("CellData", input->GetCellData(), cellDims) ||
+        !this->Impl->WriteFieldData(input->GetFieldData()))
+      {
+        return false;
+      }
+    }
+    else if (!this->Impl->Open(this->FileName))
+    {
+      return false;
+    }
+    return this->Impl->WriteArrays("PointData", input->GetPointData(), pointStart, pointCount) &&
+      this->Impl->WriteArrays("CellData", input->GetCellData(), cellStart, cellCount);
+  });
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::WriteUnstructuredGrid(vtkUnstructuredGrid* input)
+{
+  vtkCellArray* cells = input->GetCells();
+  const vtkIdType numberOfCells = input->GetNumberOfCells();
+  const vtkIdType numberOfConnectivityIds = cells ? cells->GetNumberOfConnectivityIds() : 0;
+  const std::vector<vtkIdType> counts =
+    this->GatherCounts({ input->GetNumberOfPoints(), numberOfCells, numberOfConnectivityIds });
+  const int numberOfPieces = static_cast<int>(counts.size() / 3);
+  const int piece = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+  const hsize_t pointOffset = ::GetPieceOffset(counts, piece, 3, 0);
+  const hsize_t cellOffset = ::GetPieceOffset(counts, piece, 3, 1);
+  const hsize_t connectivityOffset = ::GetPieceOffset(counts, piece, 3, 2);
+
+  return this->WriteInTurn([&]() {
+    if (piece == 0)
+    {
+      const hid_t idType = vtkHDFWriter::Implementation::GetNativeType(VTK_ID_TYPE);
+      const std::vector<vtkIdType> numberOfPoints = ::GetPieceCounts(counts, 3, 0);
+      const std::vector<vtkIdType> numbersOfCells = ::GetPieceCounts(counts, 3, 1);
+      const std::vector<vtkIdType> numbersOfConnectivityIds = ::GetPieceCounts(counts, 3, 2);
+      const hsize_t totalPoints = ::GetPieceOffset(counts, numberOfPieces, 3, 0);
+      const hsize_t totalCells = ::GetPieceOffset(counts, numberOfPieces, 3, 1);
+      const hsize_t totalConnectivityIds = ::GetPieceOffset(counts, numberOfPieces, 3, 2);
+      const hid_t pointType = vtkHDFWriter::Implementation::GetNativeType(
+        input->GetPoints() ? input->GetPoints()->GetDataType() : VTK_FLOAT);
+      const hsize_t pieces = numberOfPieces;
+      if (!this->Impl->Create(this->FileName) || !this->Impl->WriteHeader("UnstructuredGrid") ||
+        !this->Impl->CreateDataSet("NumberOfPoints", idType, { pieces }) ||
+        !this->Impl->WriteValues("NumberOfPoints", idType, 0, pieces, numberOfPoints.data()) ||
+        !this->Impl->CreateDataSet("NumberOfCells", idType, { pieces }) ||
+        !this->Impl->WriteValues("NumberOfCells", idType, 0, pieces, numbersOfCells.data()) ||
+        !this->Impl->CreateDataSet("NumberOfConnectivityIds", idType, { pieces }) ||
+        !this->Impl->WriteValues(
+          "NumberOfConnectivityIds", idType, 0, pieces, numbersOfConnectivityIds.data()) ||
+        !this->Impl->CreateDataSet("Points", pointType, { totalPoints }, 3) ||
+        !this->Impl->CreateDataSet("Offsets", idType, { totalCells + pieces }) ||
+        !this->Impl->CreateDataSet("Connectivity", idType, { totalConnectivityIds }) ||
+        !this->Impl->CreateDataSet("Types", H5T_NATIVE_UCHAR, { totalCells }) ||
+        !this->Impl->CreateArrayDataSets("PointData", input->GetPointData(), { totalPoints }) ||
+        !this->Impl->CreateArrayDataSets("CellData", input->GetCellData(), { totalCells }) ||
+        !this->Impl->WriteFieldData(input->GetFieldData()))
+      {
+        return false;
+      }
+    }
+    else if (!this->Impl->Open(this->FileName))
+    {
+      return false;
+    }
+
+    // Each piece has one offset more than cells.
+    const hsize_t numberOfPoints = input->GetNumberOfPoints();
+    if (numberOfPoints > 0 &&
+      !this->Impl->WriteArray(
+        "Points", input->GetPoints()->GetData(), { pointOffset }, { numberOfPoints }))
+    {
+      return false;
+    }
+    if (cells &&
+      (!this->Impl->WriteArray("Offsets", cells->GetOffsetsArray(), { cellOffset + piece },
+         { static_cast<hsize_t>(numberOfCells + 1) }) ||
+        !this->Impl->WriteArray("Connectivity", cells->GetConnectivityArray(),
+          { connectivityOffset }, { static_cast<hsize_t>(numberOfConnectivityIds) }) ||
+        !this->Impl->WriteArray("Types", input->GetCellTypesArray(), { cellOffset },
+          { static_cast<hsize_t>(numberOfCells) })))
+    {
+      return false;
+    }
+    return this->Impl->WriteArrays(
+             "PointData", input->GetPointData(), { pointOffset }, { numberOfPoints }) &&
+      this->Impl->WriteArrays("CellData", input->GetCellData(), { cellOffset },
+        { static_cast<hsize_t>(numberOfCells) });
+  });
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::WritePolyData(vtkPolyData* input)
+{
+  // The counts of each piece are the number of points, then the number of
+  // cells and connectivity ids of each topology.
+  const int stride = 1 + 2 * static_cast<int>(POLY_DATA_TOPOLOGIES.size());
+  vtkCellArray* cells[4] = { input->GetVerts(), input->GetLines(), input->GetPolys(),
+    input->GetStrips() };
+  std::vector<vtkIdType> localCounts = { input->GetNumberOfPoints() };
+  for (vtkCellArray* cellArray : cells)
+  {
+    localCounts.push_back(cellArray->GetNumberOfCells());
+    localCounts.push_back(cellArray->GetNumberOfConnectivityIds());
+  }
+  const std::vector<vtkIdType> counts = this->GatherCounts(localCounts);
+  const int numberOfPieces = static_cast<int>(counts.size() / stride);
+  const int piece = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+
+  // The cell data of a piece follows the cells of all topologies of the
+  // previous pieces.
+  hsize_t cellDataOffset = 0;
+  hsize_t totalCells = 0;
+  for (int i = 0; i < numberOfPieces; ++i)
+  {
+    for (size_t topology = 0; topology < POLY_DATA_TOPOLOGIES.size(); ++topology)
+    {
+      const vtkIdType pieceCells = counts[i * stride + 1 + 2 * topology];
+      cellDataOffset += i < piece ? pieceCells : 0;
+      totalCells += pieceCells;
+    }
+  }
+  const hsize_t pointOffset = ::GetPieceOffset(counts, piece, stride, 0);
+  vtkSmartPointer<vtkFieldData> cellData = ::GetOrderedCellData(input);
+
+  return this->WriteInTurn([&]() {
+    const hid_t idType = vtkHDFWriter::Implementation::GetNativeType(VTK_ID_TYPE);
+    const hsize_t pieces = numberOfPieces;
+    if (piece == 0)
+    {
+      const std::vector<vtkIdType> numberOfPoints = ::GetPieceCounts(counts, stride, 0);
+      const hsize_t totalPoints = ::GetPieceOffset(counts, numberOfPieces, stride, 0);
+      const hid_t pointType = vtkHDFWriter::Implementation::GetNativeType(
+        input->GetPoints() ? input->GetPoints()->GetDataType() : VTK_FLOAT);
+      if (!this->Impl->Create(this->FileName) || !this->Impl->WriteHeader("PolyData") ||
+        !this->Impl->CreateDataSet("NumberOfPoints", idType, { pieces }) ||
+        !this->Impl->WriteValues("NumberOfPoints", idType, 0, pieces, numberOfPoints.data()) ||
+        !this->Impl->CreateDataSet("Points", pointType, { totalPoints }, 3) ||
+        !this->Impl->CreateArrayDataSets("PointData", input->GetPointData(), { totalPoints }) ||
+        !this->Impl->CreateArrayDataSets("CellData", input->GetCellData(), { totalCells }) ||
+        !this->Impl->WriteFieldData(input->GetFieldData()))
+      {
+        return false;
+      }
+      for (size_t topology = 0; topology < POLY_DATA_TOPOLOGIES.size(); ++topology)
+      {
+        const std::string group = POLY_DATA_TOPOLOGIES[topology];
+        const std::vector<vtkIdType> numbersOfCells =
+          ::GetPieceCounts(counts, stride, 1 + 2 * static_cast<int>(topology));
+        const std::vector<vtkIdType> numbersOfConnectivityIds =
+          ::GetPieceCounts(counts, stride, 2 + 2 * static_cast<int>(topology));
+        const hsize_t topologyCells = std::accumulate(
+          numbersOfCells.begin(), numbersOfCells.end(), static_cast<vtkIdType>(0));
+        const hsize_t topologyConnectivityIds = std::accumulate(numbersOfConnectivityIds.begin(),
+          numbersOfConnectivityIds.end(), static_cast<vtkIdType>(0));
+        if (!this->Impl->CreateGroup(group.c_str()) ||
+          !this->Impl->CreateDataSet((group + "/NumberOfCells").c_str(), idType, { pieces }) ||
+          !this->Impl->WriteValues((group + "/NumberOfCells").c_str(), idType, 0, pieces,
+            numbersOfCells.data()) ||
+          !this->Impl->CreateDataSet(
+            (group + "/NumberOfConnectivityIds").c_str(), idType, { pieces }) ||
+          !this->Impl->WriteValues((group + "/NumberOfConnectivityIds").c_str(), idType, 0,
+            pieces, numbersOfConnectivityIds.data()) ||
+          !this->Impl->CreateDataSet(
+            (group + "/Offsets").c_str(), idType, { topologyCells + pieces }) ||
+          !this->Impl->CreateDataSet(
+            (group + "/Connectivity").c_str(), idType, { topologyConnectivityIds }))
+        {
+          return false;
+        }
+      }
+    }
+    else if (!this->Impl->Open(this->FileName))
+    {
+      return false;
+    }
+
+    const hsize_t numberOfPoints = input->GetNumberOfPoints();
+    if (numberOfPoints > 0 &&
+      !this->Impl->WriteArray(
+        "Points", input->GetPoints()->GetData(), { pointOffset }, { numberOfPoints }))
+    {
+      return false;
+    }
+    for (size_t topology = 0; topology < POLY_DATA_TOPOLOGIES.size(); ++topology)
+    {
+      // Each piece has one offset more than cells.
+      const std::string group = POLY_DATA_TOPOLOGIES[topology];
+      const int cellsIndex = 1 + 2 * static_cast<int>(topology);
+      const hsize_t offsetsOffset = ::GetPieceOffset(counts, piece, stride, cellsIndex) + piece;
+      const hsize_t connectivityOffset = ::GetPieceOffset(counts, piece, stride, cellsIndex + 1);
+      vtkCellArray* cellArray = cells[topology];
+      if (!this->Impl->WriteArray((group + "/Offsets").c_str(), cellArray->GetOffsetsArray(),
+            { offsetsOffset }, { static_cast<hsize_t>(cellArray->GetNumberOfCells() + 1) }) ||
+        !this->Impl->WriteArray((group + "/Connectivity").c_str(),
+          cellArray->GetConnectivityArray(), { connectivityOffset },
+          { static_cast<hsize_t>(cellArray->GetNumberOfConnectivityIds()) }))
+      {
+        return false;
+      }
+    }
+    return this->Impl->WriteArrays(
+             "PointData", input->GetPointData(), { pointOffset }, { numberOfPoints }) &&
+      this->Impl->WriteArrays("CellData", cellData, { cellDataOffset },
+        { static_cast<hsize_t>(input->GetNumberOfCells()) });
+  });
+}
@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkHDFWriter
+ * @brief   VTKHDF format writer.
+ *
+ * vtkHDFWriter writes vtkImageData, vtkUnstructuredGrid and vtkPolyData
+ * using the VTK HDF format read by vtkHDFReader. Point, cell and field
+ * arrays are written with their type and number of components, so that
+ * reading the file back gives the same dataset.
+ *
+ * The datasets of the file can be split in chunks of ChunkSize tuples,
+ * which are then compressed with deflate when CompressionLevel is not 0.
+ * A ChunkSize of 0 writes contiguous datasets, without compression.
+ *
+ * When running in parallel, each process writes the piece it is requested
+ * by the Controller in the same file: the pieces of unstructured grids and
+ * polydata are stored as the partitions of the file, and the pieces of image
+ * data are written at their extent in the whole extent. The processes write
+ * their piece in turn, so that the HDF5 library does not need to be built
+ * with MPI support. All pieces must have the same point, cell and field
+ * arrays; the field arrays are written by the first process.
+ *
+ * @sa
+ * vtkHDFReader
+ */
+
+#ifndef vtkHDFWriter_h
+#define vtkHDFWriter_h
+
+#include "vtkIOHDFModule.h" // For export macro
+#include "vtkWriter.h"
+
+#include <functional> // For std::function
+#include <vector>     // For std::vector
+
+class vtkImageData;
+class vtkMultiProcessController;
+class vtkPolyData;
+class vtkUnstructuredGrid;
+
+class VTKIOHDF_EXPORT vtkHDFWriter : public vtkWriter
+{
+public:
+  static vtkHDFWriter* New();
+  vtkTypeMacro(vtkHDFWriter, vtkWriter);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the name of the output file.
+   */
+  vtkSetFilePathMacro(FileName);
+  vtkGetFilePathMacro(FileName);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the number of tuples of the chunks of the HDF5 datasets.
+   * 0 writes contiguous datasets. Default is 25000.
+   */
+  vtkSetClampMacro(ChunkSize, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(ChunkSize, vtkIdType);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the deflate compression level of the chunks, from 0 (no
+   * compression) to 9. Compression needs a ChunkSize larger than 0.
+   * Default is 0.
+   */
+  vtkSetClampMacro(CompressionLevel, int, 0, 9);
+  vtkGetMacro(CompressionLevel, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the controller used to write the pieces of all the processes
+   * in the same file. Initialized to
+   * `vtkMultiProcessController::GetGlobalController` in the constructor.
+   */
+  void SetController(vtkMultiProcessController* controller);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  ///@}
+
+protected:
+  vtkHDFWriter();
+  ~vtkHDFWriter() override;
+
+  vtkTypeBool ProcessRequest(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  virtual int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector);
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  void WriteData() override;
+
+  //@{
+  /**
+   * Write the piece of this process. Returns true for success on all
+   * processes and false otherwise.
+   */
+  bool WriteImageData(vtkImageData* input);
+  bool WriteUnstructuredGrid(vtkUnstructuredGrid* input);
+  bool WritePolyData(vtkPolyData* input);
+  //@}
+
+  /**
+   * Gathers the counts of all processes, in process order.
+   */
+  std::vector<vtkIdType> GatherCounts(const std::vector<vtkIdType>& counts);
+
+  /**
+   * Calls 'write' on each process in turn, starting with the first one, so
+   * that they do not access the file at the same time. A process does not
+   * write after a failure on a previous one. Returns true for success on all
+   * processes and false otherwise.
+   */
+  bool WriteInTurn(const std::function<bool()>& write);
+
+  /**
+   * The output file's name.
+   */
+  char* FileName;
+
+  vtkIdType ChunkSize;
+  int CompressionLevel;
+  vtkMultiProcessController* Controller;
+
+  class Implementation;
+  Implementation* Impl;
+
+private:
+  vtkHDFWriter(const vtkHDFWriter&) = delete;
+  void operator=(const vtkHDFWriter&) = delete;
+};
+
+#endif
@@ -0,0 +1,458 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriterImplementation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkHDFWriterImplementation.h"
+
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkHDF5ScopedHandle.h"
+#include "vtkHDFReaderVersion.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+//------------------------------------------------------------------------------
+vtkHDFWriter::Implementation::Implementation(vtkHDFWriter* writer)
+  : Writer(writer)
+  , File(-1)
+  , VTKGroup(-1)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkHDFWriter::Implementation::~Implementation()
+{
+  this->Close();
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::Create(const char* fileName)
+{
+  this->Close();
+  if ((this->File = H5Fcreate(fileName, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create file " << fileName);
+    return false;
+  }
+  if ((this->VTKGroup = H5Gcreate(this->File, "/VTKHDF", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) <
+    0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create the /VTKHDF group in " << fileName);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::Open(const char* fileName)
+{
+  this->Close();
+  if ((this->File = H5Fopen(fileName, H5F_ACC_RDWR, H5P_DEFAULT)) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot open file " << fileName);
+    return false;
+  }
+  if ((this->VTKGroup = H5Gopen(this->File, "/VTKHDF", H5P_DEFAULT)) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot open the /VTKHDF group in " << fileName);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::Implementation::Close()
+{
+  if (this->VTKGroup >= 0)
+  {
+    // Files with steps need a reader of the current version, the others are
+    // kept readable by the readers of version 1.
+    if (H5Lexists(this->VTKGroup, "Steps", H5P_DEFAULT) > 0)
+    {
+      const int version[2] = { vtkHDFReaderMajorVersion, vtkHDFReaderMinorVersion };
+      vtkHDF::ScopedH5AHandle attribute = H5Aopen(this->VTKGroup, "Version", H5P_DEFAULT);
+      if (attribute < 0 || H5Awrite(attribute, H5T_NATIVE_INT, version) < 0)
+      {
+        vtkErrorWithObjectMacro(this->Writer, "Cannot update the Version attribute");
+      }
+    }
+    H5Gclose(this->VTKGroup);
+    this->VTKGroup = -1;
+  }
+  if (this->File >= 0)
+  {
+    H5Fclose(this->File);
+    this->File = -1;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteHeader(const char* dataSetType)
+{
+  // Version 2 is only needed by files with steps, see Close()
+  const int version[2] = { 1, 0 };
+  if (!this->WriteAttribute("Version", 2, version))
+  {
+    return false;
+  }
+
+  // The type is a fixed length string without terminating null character.
+  vtkHDF::ScopedH5THandle stringType = H5Tcopy(H5T_C_S1);
+  if (stringType < 0 || H5Tset_size(stringType, strlen(dataSetType)) < 0 ||
+    H5Tset_strpad(stringType, H5T_STR_NULLPAD) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create the type of the Type attribute");
+    return false;
+  }
+  vtkHDF::ScopedH5SHandle space = H5Screate(H5S_SCALAR);
+  vtkHDF::ScopedH5AHandle attribute =
+    H5Acreate(this->VTKGroup, "Type", stringType, space, H5P_DEFAULT, H5P_DEFAULT);
+  if (attribute < 0 || H5Awrite(attribute, stringType, dataSetType) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot write the Type attribute");
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+namespace
+{
+bool WriteAttribute(
+  hid_t group, const char* name, hid_t nativeType, hsize_t numberOfElements, const void* value)
+{
+  vtkHDF::ScopedH5SHandle space = H5Screate_simple(1, &numberOfElements, nullptr);
+  if (space < 0)
+  {
+    return false;
+  }
+  vtkHDF::ScopedH5AHandle attribute =
+    H5Acreate(group, name, nativeType, space, H5P_DEFAULT, H5P_DEFAULT);
+  return attribute >= 0 && H5Awrite(attribute, nativeType, value) >= 0;
+}
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteAttribute(
+  const char* name, hsize_t numberOfElements, const int* value)
+{
+  if (!::WriteAttribute(this->VTKGroup, name, H5T_NATIVE_INT, numberOfElements, value))
+  {
+    vtkErrorWithObjectMacro(this->Writer, << std::string("Cannot write ") + name + " attribute");
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteAttribute(
+  const char* name, hsize_t numberOfElements, const double* value)
+{
+  if (!::WriteAttribute(this->VTKGroup, name, H5T_NATIVE_DOUBLE, numberOfElements, value))
+  {
+    vtkErrorWithObjectMacro(this->Writer, << std::string("Cannot write ") + name + " attribute");
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::CreateGroup(const char* path)
+{
+  vtkHDF::ScopedH5GHandle group =
+    H5Gcreate(this->VTKGroup, path, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  if (group < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, << std::string("Cannot create group ") + path);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::CreateDataSet(
+  const char* path, hid_t nativeType, const std::vector<hsize_t>& dims, int numberOfComponents)
+{
+  std::vector<hsize_t> fileDims = dims;
+  if (numberOfComponents > 1)
+  {
+    fileDims.push_back(numberOfComponents);
+  }
+  vtkHDF::ScopedH5SHandle space =
+    H5Screate_simple(static_cast<int>(fileDims.size()), fileDims.data(), nullptr);
+  vtkHDF::ScopedH5PHandle properties = H5Pcreate(H5P_DATASET_CREATE);
+  if (space < 0 || properties < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, << std::string("Cannot create dataset ") + path);
+    return false;
+  }
+
+  // Chunks hold whole tuples, and are filled along the fastest varying
+  // dimensions first. Empty datasets cannot be chunked.
+  const hsize_t chunkSize = static_cast<hsize_t>(this->Writer->GetChunkSize());
+  if (chunkSize > 0 &&
+    std::find(fileDims.begin(), fileDims.end(), hsize_t(0)) == fileDims.end())
+  {
+    std::vector<hsize_t> chunk = fileDims;
+    hsize_t remaining = chunkSize;
+    for (size_t i = dims.size(); i-- > 0;)
+    {
+      chunk[i] = std::max(hsize_t(1), std::min(dims[i], remaining));
+      remaining /= chunk[i];
+    }
+    if (H5Pset_chunk(properties, static_cast<int>(chunk.size()), chunk.data()) < 0 ||
+      (this->Writer->GetCompressionLevel() > 0 &&
+        H5Pset_deflate(properties, this->Writer->GetCompressionLevel()) < 0))
+    {
+      vtkErrorWithObjectMacro(
+        this->Writer, << std::string("Cannot set the chunks of dataset ") + path);
+      return false;
+    }
+  }
+
+  vtkHDF::ScopedH5DHandle dataset =
+    H5Dcreate(this->VTKGroup, path, nativeType, space, H5P_DEFAULT, properties, H5P_DEFAULT);
+  if (dataset < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, << std::string("Cannot create dataset ") + path);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::IsWritable(vtkAbstractArray* array)
+{
+  if (!array->GetName() || !array->GetName()[0])
+  {
+    vtkWarningWithObjectMacro(this->Writer, "Skipping an array without name");
+    return false;
+  }
+  if (!vtkArrayDownCast<vtkDataArray>(array) ||
+    vtkHDFWriter::Implementation::GetNativeType(array->GetDataType()) < 0)
+  {
+    vtkWarningWithObjectMacro(
+      this->Writer, "Skipping array " << array->GetName() << " of unsupported type");
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::CreateArrayDataSets(
+  const char* group, vtkFieldData* fieldData, const std::vector<hsize_t>& numberOfTuples)
+{
+  if (!this->CreateGroup(group))
+  {
+    return false;
+  }
+  for (int i = 0; i < fieldData->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = fieldData->GetAbstractArray(i);
+    if (!this->IsWritable(array))
+    {
+      continue;
+    }
+    const std::string path = std::string(group) + "/" + array->GetName();
+    if (!this->CreateDataSet(path.c_str(), GetNativeType(array->GetDataType()), numberOfTuples,
+          array->GetNumberOfComponents()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteSlab(const char* path, hid_t nativeType,
+  const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, const void* data)
+{
+  if (std::find(count.begin(), count.end(), hsize_t(0)) != count.end())
+  {
+    // nothing to write
+    return true;
+  }
+  vtkHDF::ScopedH5DHandle dataset = H5Dopen(this->VTKGroup, path, H5P_DEFAULT);
+  if (dataset < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, << std::string("Cannot open dataset ") + path);
+    return false;
+  }
+  vtkHDF::ScopedH5SHandle fileSpace = H5Dget_space(dataset);
+  vtkHDF::ScopedH5SHandle memorySpace =
+    H5Screate_simple(static_cast<int>(count.size()), count.data(), nullptr);
+  if (fileSpace < 0 || memorySpace < 0 ||
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr) <
+      0)
+  {
+    vtkErrorWithObjectMacro(
+      this->Writer, << std::string("Error selecting hyperslab for dataset ") + path);
+    return false;
+  }
+  if (H5Dwrite(dataset, nativeType, memorySpace, fileSpace, H5P_DEFAULT, data) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, << std::string("Error writing dataset ") + path);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteArray(const char* path, vtkDataArray* array,
+  const std::vector<hsize_t>& start, const std::vector<hsize_t>& count)
+{
+  // HDF5 needs the values contiguous in memory. It converts them to the type
+  // of the dataset, which may differ between the pieces.
+  vtkSmartPointer<vtkDataArray> values = array;
+  if (!array->HasStandardMemoryLayout())
+  {
+    values = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(array->GetDataType()));
+    values->DeepCopy(array);
+  }
+  std::vector<hsize_t> fileStart = start;
+  std::vector<hsize_t> fileCount = count;
+  if (array->GetNumberOfComponents() > 1)
+  {
+    fileStart.push_back(0);
+    fileCount.push_back(array->GetNumberOfComponents());
+  }
+  return this->WriteSlab(path, GetNativeType(values->GetDataType()), fileStart, fileCount,
+    values->GetVoidPointer(0));
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteArrays(const char* group, vtkFieldData* fieldData,
+  const std::vector<hsize_t>& start, const std::vector<hsize_t>& count)
+{
+  for (int i = 0; i < fieldData->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = fieldData->GetArray(i);
+    if (!array || !array->GetName() || GetNativeType(array->GetDataType()) < 0)
+    {
+      continue;
+    }
+    const std::string path = std::string(group) + "/" + array->GetName();
+    if (H5Lexists(this->VTKGroup, path.c_str(), H5P_DEFAULT) <= 0)
+    {
+      vtkWarningWithObjectMacro(this->Writer,
+        "Skipping array " << array->GetName() << " missing from the first piece");
+      continue;
+    }
+    if (!this->WriteArray(path.c_str(), array, start, count))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteValues(
+  const char* path, hid_t nativeType, hsize_t start, hsize_t count, const void* values)
+{
+  return this->WriteSlab(path, nativeType, { start }, { count }, values);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteFieldData(vtkFieldData* fieldData)
+{
+  if (!this->CreateGroup("FieldData"))
+  {
+    return false;
+  }
+  for (int i = 0; i < fieldData->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = fieldData->GetAbstractArray(i);
+    const std::string path = std::string("FieldData/") + (array->GetName() ? array->GetName() : "");
+    vtkStringArray* stringArray = vtkArrayDownCast<vtkStringArray>(array);
+    if (stringArray && array->GetName() && array->GetName()[0])
+    {
+      // strings are stored as a 1D dataset of variable length strings.
+      vtkHDF::ScopedH5THandle stringType = H5Tcopy(H5T_C_S1);
+      const hsize_t size = static_cast<hsize_t>(stringArray->GetNumberOfValues());
+      vtkHDF::ScopedH5SHandle space = H5Screate_simple(1, &size, nullptr);
+      if (stringType < 0 || space < 0 || H5Tset_size(stringType, H5T_VARIABLE) < 0)
+      {
+        vtkErrorWithObjectMacro(this->Writer, << "Cannot create dataset " << path);
+        return false;
+      }
+      vtkHDF::ScopedH5DHandle dataset = H5Dcreate(
+        this->VTKGroup, path.c_str(), stringType, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      std::vector<const char*> strings(size);
+      for (hsize_t j = 0; j < size; ++j)
+      {
+        strings[j] = stringArray->GetValue(j).c_str();
+      }
+      if (dataset < 0 ||
+        H5Dwrite(dataset, stringType, H5S_ALL, H5S_ALL, H5P_DEFAULT, strings.data()) < 0)
+      {
+        vtkErrorWithObjectMacro(this->Writer, << "Cannot write dataset " << path);
+        return false;
+      }
+    }
+    else if (this->IsWritable(array))
+    {
+      const std::vector<hsize_t> dims = { static_cast<hsize_t>(array->GetNumberOfTuples()) };
+      if (!this->CreateDataSet(path.c_str(), GetNativeType(array->GetDataType()), dims,
+            array->GetNumberOfComponents()) ||
+        !this->WriteArray(path.c_str(), vtkArrayDownCast<vtkDataArray>(array), { 0 }, dims))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+hid_t vtkHDFWriter::Implementation::GetNativeType(int vtkType)
+{
+  switch (vtkType)
+  {
+    case VTK_CHAR:
+      return H5T_NATIVE_CHAR;
+    case VTK_SIGNED_CHAR:
+      return H5T_NATIVE_SCHAR;
+    case VTK_UNSIGNED_CHAR:
+      return H5T_NATIVE_UCHAR;
+    case VTK_SHORT:
+      return H5T_NATIVE_SHORT;
+    case VTK_UNSIGNED_SHORT:
+      return H5T_NATIVE_USHORT;
+    case VTK_INT:
+      return H5T_NATIVE_INT;
+    case VTK_UNSIGNED_INT:
+      return H5T_NATIVE_UINT;
+    case VTK_LONG:
+      return H5T_NATIVE_LONG;
+    case VTK_UNSIGNED_LONG:
+      return H5T_NATIVE_ULONG;
+    case VTK_LONG_LONG:
+      return H5T_NATIVE_LLONG;
+    case VTK_UNSIGNED_LONG_LONG:
+      return H5T_NATIVE_ULLONG;
+    case VTK_ID_TYPE:
+      return sizeof(vtkIdType) == sizeof(long long) ? H5T_NATIVE_LLONG : H5T_NATIVE_INT;
+    case VTK_FLOAT:
+      return H5T_NATIVE_FLOAT;
+    case VTK_DOUBLE:
+      return H5T_NATIVE_DOUBLE;
+    default:
+      return -1;
+  }
+}
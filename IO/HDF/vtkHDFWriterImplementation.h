@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriterImplementation.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkHDFWriterImplementation
+ * @brief   Implementation class for vtkHDFWriter
+ *
+ */
+
+#ifndef vtkHDFWriterImplementation_h
+#define vtkHDFWriterImplementation_h
+
+#include "vtkHDFWriter.h"
+#include "vtk_hdf5.h"
+#include <vector>
+
+class vtkAbstractArray;
+class vtkDataArray;
+class vtkFieldData;
+
+/**
+ * Implementation for the vtkHDFWriter. Creates or opens a VTK HDF file,
+ * defines its datasets and writes the pieces of the data into them.
+ * The paths of the datasets and groups are relative to the /VTKHDF group.
+ */
+class vtkHDFWriter::Implementation
+{
+public:
+  Implementation(vtkHDFWriter* writer);
+  virtual ~Implementation();
+  /**
+   * Creates the file, replacing any existing file, with an empty /VTKHDF
+   * group.
+   */
+  bool Create(VTK_FILEPATH const char* fileName);
+  /**
+   * Opens an existing VTK HDF file for writing.
+   */
+  bool Open(VTK_FILEPATH const char* fileName);
+  /**
+   * Closes the VTK HDF file and releases any allocated resources.
+   */
+  void Close();
+  /**
+   * Writes the Version and Type attributes of the /VTKHDF group.
+   */
+  bool WriteHeader(const char* dataSetType);
+  //@{
+  /**
+   * Writes an attribute of the /VTKHDF group.
+   */
+  bool WriteAttribute(const char* name, hsize_t numberOfElements, const int* value);
+  bool WriteAttribute(const char* name, hsize_t numberOfElements, const double* value);
+  //@}
+  /**
+   * Creates a group.
+   */
+  bool CreateGroup(const char* path);
+  /**
+   * Creates a dataset of 'nativeType' values. 'dims' are the numbers of
+   * tuples along each dimension, the components are added as the last
+   * dimension when there is more than one. The dataset is split in chunks of
+   * about ChunkSize tuples, compressed if requested.
+   */
+  bool CreateDataSet(const char* path, hid_t nativeType, const std::vector<hsize_t>& dims,
+    int numberOfComponents = 1);
+  /**
+   * Creates the datasets of the arrays of 'fieldData' in the 'group', with
+   * 'numberOfTuples' tuples. The arrays without a name and the arrays
+   * that are not vtkDataArray are skipped.
+   */
+  bool CreateArrayDataSets(
+    const char* group, vtkFieldData* fieldData, const std::vector<hsize_t>& numberOfTuples);
+  /**
+   * Writes the tuples of 'array' to the hyperslab of the dataset starting at
+   * 'start' with 'count' tuples along each dimension.
+   */
+  bool WriteArray(const char* path, vtkDataArray* array, const std::vector<hsize_t>& start,
+    const std::vector<hsize_t>& count);
+  /**
+   * Writes the arrays of 'fieldData' to the datasets of the 'group' created by
+   * CreateArrayDataSets.
+   */
+  bool WriteArrays(const char* group, vtkFieldData* fieldData, const std::vector<hsize_t>& start,
+    const std::vector<hsize_t>& count);
+  /**
+   * Writes 1D values of 'nativeType' to a dataset, starting at 'start'.
+   */
+  bool WriteValues(const char* path, hid_t nativeType, hsize_t start, hsize_t count,
+    const void* values);
+  /**
+   * Creates and writes the field arrays in the FieldData group.
+   */
+  bool WriteFieldData(vtkFieldData* fieldData);
+  /**
+   * HDF native type of a VTK type, or -1 for the types that cannot be written.
+   */
+  static hid_t GetNativeType(int vtkType);
+
+private:
+  vtkHDFWriter* Writer;
+  hid_t File;
+  hid_t VTKGroup;
+
+  bool WriteSlab(const char* path, hid_t nativeType, const std::vector<hsize_t>& start,
+    const std::vector<hsize_t>& count, const void* data);
+  bool IsWritable(vtkAbstractArray* array);
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkHDFWriterImplementation.h
@@ -0,0 +1,231 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelimitedTextReaderParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that parsing delimited text by chunks in parallel gives the same
+// table as the sequential parsing, with quoted fields, escape sequences
+// going on to the next record, blank lines, short and long records and
+// columns detected as numeric late in the input.
+
+#include "vtkAbstractArray.h"
+#include "vtkDelimitedTextReader.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+#include "vtkVariant.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+const int NumberOfRows = 30000;
+
+std::string MakeContent(bool escapeEveryRecord, bool duplicateNames)
+{
+  std::ostringstream content;
+  content << (duplicateNames ? "id,value,ratio,label,mixed,value\r\n"
+                             : "id,value,ratio,label,mixed,sparse\r\n");
+  unsigned int seed = 4321;
+  for (int i = 0; i < NumberOfRows; ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    const unsigned int random = (seed >> 8) % 1000;
+    content << i << ',';
+    if (i % 17 == 0)
+    {
+      content << "  " << random << " ";
+    }
+    else if (i % 23 != 0)
+    {
+      content << random;
+    }
+    content << ',' << i * 0.25 + random * 1e-3 << ',';
+    switch (i % 5)
+    {
+      case 0:
+        content << "\"name, with a comma\"";
+        break;
+      case 1:
+        content << "escaped \\\"quote\\\" and \\ttab";
+        break;
+      case 2:
+        content << "caf\xc3\xa9";
+        break;
+      default:
+        content << "plain" << random;
+    }
+    // Integers up to late in the input, then a real.
+    content << ',' << (i == NumberOfRows - 100 ? "3.5" : std::to_string(random));
+    if (i % 7 != 0)
+    {
+      content << ',' << (i == NumberOfRows / 2 ? "n/a" : std::to_string(i % 11));
+    }
+    if (i % 13 == 0)
+    {
+      content << ",extra,fields";
+    }
+    if (escapeEveryRecord || i % 131 == 0)
+    {
+      content << (i % 2 ? "\\" : ",\\");
+    }
+    content << (i % 2 ? "\n" : "\r\n");
+    if (i % 97 == 0)
+    {
+      content << "\r\n  \n";
+    }
+  }
+  // No record delimiter at the end of the input.
+  content << "last,1,2";
+  return content.str();
+}
+
+vtkSmartPointer<vtkTable> Read(const std::string& content, const std::string& fileName,
+  bool parallel, bool haveHeaders, bool detectNumericColumns, bool forceDouble, bool trim,
+  bool merge)
+{
+  vtkNew<vtkDelimitedTextReader> reader;
+  if (fileName.empty())
+  {
+    reader->SetReadFromInputString(true);
+    reader->SetInputString(content);
+  }
+  else
+  {
+    reader->SetFileName(fileName.c_str());
+  }
+  reader->SetParallelParsing(parallel);
+  reader->SetHaveHeaders(haveHeaders);
+  reader->SetDetectNumericColumns(detectNumericColumns);
+  reader->SetForceDouble(forceDouble);
+  reader->SetTrimWhitespacePriorToNumericConversion(trim);
+  reader->SetMergeConsecutiveDelimiters(merge);
+  reader->SetDefaultIntegerValue(-1);
+  reader->SetDefaultDoubleValue(-2.5);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool Compare(vtkTable* expected, vtkTable* table)
+{
+  if (expected->GetNumberOfColumns() != table->GetNumberOfColumns())
+  {
+    std::cerr << "Got " << table->GetNumberOfColumns() << " columns instead of "
+              << expected->GetNumberOfColumns() << std::endl;
+    return false;
+  }
+  for (vtkIdType c = 0; c < expected->GetNumberOfColumns(); ++c)
+  {
+    vtkAbstractArray* expectedColumn = expected->GetColumn(c);
+    vtkAbstractArray* column = table->GetColumn(c);
+    if (std::string(expectedColumn->GetName()) != column->GetName() ||
+      std::string(expectedColumn->GetClassName()) != column->GetClassName() ||
+      expectedColumn->GetNumberOfValues() != column->GetNumberOfValues())
+    {
+      std::cerr << "Column " << c << " is " << column->GetClassName() << " " << column->GetName()
+                << " with " << column->GetNumberOfValues() << " values instead of "
+                << expectedColumn->GetClassName() << " " << expectedColumn->GetName() << " with "
+                << expectedColumn->GetNumberOfValues() << " values" << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < column->GetNumberOfValues(); ++i)
+    {
+      if (expectedColumn->GetVariantValue(i).ToString() != column->GetVariantValue(i).ToString())
+      {
+        std::cerr << "Value " << i << " of column " << c << " is "
+                  << column->GetVariantValue(i).ToString() << " instead of "
+                  << expectedColumn->GetVariantValue(i).ToString() << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool Check(const std::string& content, const std::string& fileName, bool haveHeaders,
+  bool detectNumericColumns, bool forceDouble, bool trim, bool merge)
+{
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  vtkSmartPointer<vtkTable> expected =
+    Read(content, fileName, false, haveHeaders, detectNumericColumns, forceDouble, trim, merge);
+  timer->StopTimer();
+  const double sequentialTime = timer->GetElapsedTime();
+
+  vtkSmartPointer<vtkTable> table;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4, "STDThread", false }, [&]() {
+    timer->StartTimer();
+    table =
+      Read(content, fileName, true, haveHeaders, detectNumericColumns, forceDouble, trim, merge);
+    timer->StopTimer();
+  });
+
+  std::cout << "headers " << haveHeaders << " numeric " << detectNumericColumns << " double "
+            << forceDouble << " trim " << trim << " merge " << merge << ": "
+            << expected->GetNumberOfRows() << " rows read in " << sequentialTime << " s, "
+            << timer->GetElapsedTime() << " s in parallel" << std::endl;
+  return Compare(expected, table);
+}
+}
+
+int TestDelimitedTextReaderParallel(int argc, char* argv[])
+{
+  const std::string content = MakeContent(false, false);
+  if (!Check(content, "", true, true, false, false, false) ||
+    !Check(content, "", true, true, false, true, false) ||
+    !Check(content, "", true, true, true, true, true) ||
+    !Check(content, "", false, true, false, true, false) ||
+    !Check(content, "", true, false, false, false, false) ||
+    !Check(content, "", false, false, false, false, true))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Every chunk starts within an escape sequence.
+  if (!Check(MakeContent(true, false), "", true, true, false, true, false))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Columns with the same name replace each other.
+  if (!Check(MakeContent(false, true), "", true, true, false, true, false))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Blank input, and input from a file.
+  if (!Check("\r\n \n", "", true, true, false, false, false))
+  {
+    return EXIT_FAILURE;
+  }
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fileName = std::string(tempDir) + "/TestDelimitedTextReaderParallel.csv";
+  delete[] tempDir;
+  {
+    std::ofstream file(fileName.c_str(), std::ios::binary);
+    file << content;
+  }
+  if (!Check(content, fileName, true, true, false, true, false))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -21,15 +21,19 @@
 #include "vtkDelimitedTextReader.h"
 #include "vtkCommand.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkStringToNumeric.h"
 #include "vtkTable.h"
+#include "vtkVariant.h"
 
 #include "vtkTextCodec.h"
 #include "vtkTextCodecFactory.h"
@@ -38,8 +42,11 @@
 #include <vtk_utf8.h>
 
 #include <algorithm>
+#include <exception>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -57,6 +64,32 @@
 namespace
 {
 
+/// Records of a chunk of the input parsed on its own, when parsing in
+/// parallel: the fields of record i are Fields[RecordOffsets[i]] up to the
+/// start of the next record.
+struct DelimitedTextChunk
+{
+  size_t Begin = 0;
+  size_t End = 0;
+  bool StartsInEscapeSequence = false;
+  bool EndsInEscapeSequence = false;
+  std::vector<std::string> Fields;
+  std::vector<size_t> RecordOffsets;
+  std::exception_ptr Error;
+
+  // Index of the first record of the chunk in the whole input.
+  vtkIdType FirstRecord = 0;
+
+  // Values of the fields converted as vtkStringToNumeric does, with the
+  // first rows of each column where the conversion to an integer or to a
+  // number fails, and the last row of each column that has a field.
+  std::vector<double> Values;
+  std::vector<unsigned char> Kinds;
+  std::vector<vtkIdType> FirstNonInteger;
+  std::vector<vtkIdType> FirstNonNumeric;
+  std::vector<vtkIdType> LastRow;
+};
+
 class DelimitedTextIterator : public vtkTextCodec::OutputIterator
 {
 public:
@@ -92,6 +125,10 @@ public:
 
   ~DelimitedTextIterator() override
   {
+    if (!this->OutputTable)
+    {
+      return;
+    }
     // Ensure that all table columns have the same length ...
     for (vtkIdType i = 0; i != this->OutputTable->GetNumberOfColumns(); ++i)
     {
@@ -104,6 +141,17 @@ public:
     }
   }
 
+  // Collects the fields in the chunk instead of the output table. The
+  // escape sequence is the only state that goes on from a record to the
+  // next one.
+  void SetChunk(DelimitedTextChunk* chunk)
+  {
+    this->Chunk = chunk;
+    this->ProcessEscapeSequence = chunk->StartsInEscapeSequence;
+  }
+
+  bool IsInEscapeSequence() const { return this->ProcessEscapeSequence; }
+
   // Handle windows files that do not have a carriage return line feed on the last line of the file
   // ...
   void ReachedEndOfInput()
@@ -249,6 +297,16 @@ public:
 private:
   void InsertField()
   {
+    if (this->Chunk)
+    {
+      if (this->Chunk->RecordOffsets.size() <= static_cast<size_t>(this->CurrentRecordIndex))
+      {
+        this->Chunk->RecordOffsets.push_back(this->Chunk->Fields.size());
+      }
+      this->Chunk->Fields.push_back(this->CurrentField);
+      return;
+    }
+
     if (this->CurrentFieldIndex >= this->OutputTable->GetNumberOfColumns() &&
       0 == this->CurrentRecordIndex)
     {
@@ -302,8 +360,49 @@ private:
   bool ProcessEscapeSequence;
   bool UseStringDelimiter;
   vtkTypeUInt32 WithinString;
+  DelimitedTextChunk* Chunk = nullptr;
+};
+
+enum FieldKind : unsigned char
+{
+  EmptyField,
+  IntegerField,
+  RealField,
+  TextField
 };
 
+// Converts a field the same way as vtkStringToNumeric.
+FieldKind ConvertField(const std::string& field, bool trimWhitespace, double& value)
+{
+  vtkStdString str = field;
+  if (trimWhitespace)
+  {
+    size_t startPos = str.find_first_not_of(" \n\t\r");
+    if (startPos == vtkStdString::npos)
+    {
+      str = "";
+    }
+    else
+    {
+      size_t endPos = str.find_last_not_of(" \n\t\r");
+      str = str.substr(startPos, endPos - startPos + 1);
+    }
+  }
+  if (str.empty())
+  {
+    return EmptyField;
+  }
+  bool ok;
+  int intValue = vtkVariant(str).ToInt(&ok);
+  if (ok)
+  {
+    value = intValue;
+    return IntegerField;
+  }
+  value = vtkVariant(str).ToDouble(&ok);
+  return ok ? RealField : TextField;
+}
+
 } // End anonymous namespace
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -344,6 +443,7 @@ vtkDelimitedTextReader::vtkDelimitedTextReader()
   this->DefaultIntegerValue = 0;
   this->DefaultDoubleValue = 0.0;
   this->TrimWhitespacePriorToNumericConversion = false;
+  this->ParallelParsing = false;
 }
 
 vtkDelimitedTextReader::~vtkDelimitedTextReader()
@@ -398,6 +498,7 @@ void vtkDelimitedTextReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OutputPedigreeIds: " << (this->OutputPedigreeIds ? "true" : "false") << endl;
   os << indent << "AddTabFieldDelimiter: " << (this->AddTabFieldDelimiter ? "true" : "false")
      << endl;
+  os << indent << "ParallelParsing: " << (this->ParallelParsing ? "true" : "false") << endl;
 }
 
 void vtkDelimitedTextReader::SetInputString(const char* in)
@@ -505,43 +606,7 @@ int vtkDelimitedTextReader::ReadData(vtkTable* const output_table)
       throw std::runtime_error("You must specify a pedigree id array name");
     }
 
-    istream* input_stream_pt = nullptr;
-    vtksys::ifstream file_stream;
-    std::istringstream string_stream;
-
-    if (!this->ReadFromInputString)
-    {
-      // If the filename hasn't been specified, we're done ...
-      if (!this->FileName)
-      {
-        return 1;
-      }
-      // Get the total size of the input file in bytes
-      file_stream.open(this->FileName, ios::binary);
-      if (!file_stream.good())
-      {
-        throw std::runtime_error("Unable to open input file " + std::string(this->FileName));
-      }
-
-      file_stream.seekg(0, ios::end);
-      // const vtkIdType total_bytes = file_stream.tellg();
-      file_stream.seekg(0, ios::beg);
-
-      input_stream_pt = &file_stream;
-    }
-    else
-    {
-      string_stream.str(this->InputString);
-      input_stream_pt = &string_stream;
-    }
-
-    vtkTextCodec* transCodec = nullptr;
-
-    if (this->UnicodeCharacterSet)
-    {
-      transCodec = vtkTextCodecFactory::CodecForName(this->UnicodeCharacterSet);
-    }
-    else
+    if (!this->UnicodeCharacterSet)
     {
       char tstring[2];
       tstring[1] = '\0';
@@ -555,23 +620,70 @@ int vtkDelimitedTextReader::ReadData(vtkTable* const output_table)
       }
       this->UnicodeFieldDelimiters = fieldDelimiterCharacters;
       this->UnicodeStringDelimiters = tstring;
-      transCodec = vtkTextCodecFactory::CodecToHandle(*input_stream_pt);
     }
 
-    if (nullptr == transCodec)
+    // The iterator resizes the columns when destroyed, after the numeric
+    // columns detection.
+    std::unique_ptr<DelimitedTextIterator> iterator;
+    bool numericColumnsDetected = false;
+    if (!this->ParallelParsing || !this->ReadDataInParallel(output_table, numericColumnsDetected))
     {
-      // should this use the locale instead??
-      return 1;
-    }
+      istream* input_stream_pt = nullptr;
+      vtksys::ifstream file_stream;
+      std::istringstream string_stream;
 
-    DelimitedTextIterator iterator(this->MaxRecords, this->UnicodeRecordDelimiters,
-      this->UnicodeFieldDelimiters, this->UnicodeStringDelimiters, this->UnicodeWhitespace,
-      this->UnicodeEscapeCharacter, this->HaveHeaders, this->MergeConsecutiveDelimiters,
-      this->UseStringDelimiter, output_table);
+      if (!this->ReadFromInputString)
+      {
+        // If the filename hasn't been specified, we're done ...
+        if (!this->FileName)
+        {
+          return 1;
+        }
+        // Get the total size of the input file in bytes
+        file_stream.open(this->FileName, ios::binary);
+        if (!file_stream.good())
+        {
+          throw std::runtime_error("Unable to open input file " + std::string(this->FileName));
+        }
 
-    transCodec->ToUnicode(*input_stream_pt, iterator);
-    iterator.ReachedEndOfInput();
-    transCodec->Delete();
+        file_stream.seekg(0, ios::end);
+        // const vtkIdType total_bytes = file_stream.tellg();
+        file_stream.seekg(0, ios::beg);
+
+        input_stream_pt = &file_stream;
+      }
+      else
+      {
+        string_stream.str(this->InputString);
+        input_stream_pt = &string_stream;
+      }
+
+      vtkTextCodec* transCodec = nullptr;
+
+      if (this->UnicodeCharacterSet)
+      {
+        transCodec = vtkTextCodecFactory::CodecForName(this->UnicodeCharacterSet);
+      }
+      else
+      {
+        transCodec = vtkTextCodecFactory::CodecToHandle(*input_stream_pt);
+      }
+
+      if (nullptr == transCodec)
+      {
+        // should this use the locale instead??
+        return 1;
+      }
+
+      iterator.reset(new DelimitedTextIterator(this->MaxRecords, this->UnicodeRecordDelimiters,
+        this->UnicodeFieldDelimiters, this->UnicodeStringDelimiters, this->UnicodeWhitespace,
+        this->UnicodeEscapeCharacter, this->HaveHeaders, this->MergeConsecutiveDelimiters,
+        this->UseStringDelimiter, output_table));
+
+      transCodec->ToUnicode(*input_stream_pt, *iterator);
+      iterator->ReachedEndOfInput();
+      transCodec->Delete();
+    }
 
     if (this->OutputPedigreeIds)
     {
@@ -602,7 +714,7 @@ int vtkDelimitedTextReader::ReadData(vtkTable* const output_table)
       }
     }
 
-    if (this->DetectNumericColumns)
+    if (this->DetectNumericColumns && !numericColumnsDetected)
     {
       vtkStringToNumeric* converter = vtkStringToNumeric::New();
       converter->SetForceDouble(this->ForceDouble);
@@ -634,3 +746,365 @@ int vtkDelimitedTextReader::ReadData(vtkTable* const output_table)
 
   return 1;
 }
+
+bool vtkDelimitedTextReader::ReadDataInParallel(
+  vtkTable* const output_table, bool& numericColumnsDetected)
+{
+  // The chunks end after a record delimiter, looked for byte by byte.
+  if (this->MaxRecords != 0 || this->UnicodeRecordDelimiters.empty() ||
+    std::any_of(this->UnicodeRecordDelimiters.begin(), this->UnicodeRecordDelimiters.end(),
+      [](char c) { return static_cast<unsigned char>(c) > 0x7f; }))
+  {
+    return false;
+  }
+
+  std::string content;
+  if (!this->ReadFromInputString)
+  {
+    if (!this->FileName)
+    {
+      return false;
+    }
+    vtksys::ifstream file_stream(this->FileName, ios::binary);
+    if (!file_stream.good())
+    {
+      return false;
+    }
+    file_stream.seekg(0, ios::end);
+    content.resize(static_cast<size_t>(file_stream.tellg()));
+    file_stream.seekg(0, ios::beg);
+    file_stream.read(&content[0], static_cast<std::streamsize>(content.size()));
+  }
+  else if (this->InputString)
+  {
+    content = this->InputString;
+  }
+  else
+  {
+    return false;
+  }
+
+  // Only the codecs where a record delimiter byte is always a whole
+  // character allow to split the input anywhere after one.
+  vtkSmartPointer<vtkTextCodec> codec;
+  if (this->UnicodeCharacterSet)
+  {
+    codec.TakeReference(vtkTextCodecFactory::CodecForName(this->UnicodeCharacterSet));
+  }
+  else if (std::all_of(content.begin(), content.end(),
+             [](char c) { return static_cast<unsigned char>(c) <= 0x7f; }))
+  {
+    codec.TakeReference(vtkTextCodecFactory::CodecForName("US-ASCII"));
+  }
+  else
+  {
+    std::istringstream string_stream(content);
+    codec.TakeReference(vtkTextCodecFactory::CodecToHandle(string_stream));
+  }
+  const std::string codecName = codec ? codec->Name() : "";
+  if (codecName != "US-ASCII" && codecName != "UTF-8")
+  {
+    return false;
+  }
+
+  const size_t numberOfThreads =
+    static_cast<size_t>(std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+  const size_t chunkSize = std::max<size_t>(1 << 16, content.size() / (4 * numberOfThreads) + 1);
+  std::vector<DelimitedTextChunk> chunks;
+  for (size_t begin = 0; begin < content.size(); begin = chunks.back().End)
+  {
+    size_t end = content.size();
+    if (end - begin > chunkSize)
+    {
+      end = content.find_first_of(this->UnicodeRecordDelimiters, begin + chunkSize);
+      end = end == std::string::npos ? content.size() : end + 1;
+    }
+    chunks.emplace_back();
+    chunks.back().Begin = begin;
+    chunks.back().End = end;
+  }
+  const vtkIdType numberOfChunks = static_cast<vtkIdType>(chunks.size());
+
+  auto parseChunk = [&](vtkIdType index) {
+    DelimitedTextChunk& chunk = chunks[index];
+    chunk.Fields.clear();
+    chunk.RecordOffsets.clear();
+    chunk.Error = nullptr;
+    try
+    {
+      vtkSmartPointer<vtkTextCodec> chunkCodec;
+      chunkCodec.TakeReference(vtkTextCodecFactory::CodecForName(codecName.c_str()));
+      std::istringstream chunk_stream(content.substr(chunk.Begin, chunk.End - chunk.Begin));
+      DelimitedTextIterator iterator(0, this->UnicodeRecordDelimiters,
+        this->UnicodeFieldDelimiters, this->UnicodeStringDelimiters, this->UnicodeWhitespace,
+        this->UnicodeEscapeCharacter, this->HaveHeaders, this->MergeConsecutiveDelimiters,
+        this->UseStringDelimiter, nullptr);
+      iterator.SetChunk(&chunk);
+      chunkCodec->ToUnicode(chunk_stream, iterator);
+      if (index + 1 == numberOfChunks)
+      {
+        iterator.ReachedEndOfInput();
+      }
+      chunk.EndsInEscapeSequence = iterator.IsInEscapeSequence();
+    }
+    catch (...)
+    {
+      chunk.Error = std::current_exception();
+    }
+  };
+
+  vtkSMPTools::For(0, numberOfChunks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      parseChunk(i);
+    }
+  });
+  // Each chunk was parsed as if it started a record with no pending escape
+  // sequence; parse again the rare ones that do not.
+  for (vtkIdType i = 1; i < numberOfChunks; ++i)
+  {
+    if (chunks[i - 1].EndsInEscapeSequence && !chunks[i - 1].Error)
+    {
+      chunks[i].StartsInEscapeSequence = true;
+      parseChunk(i);
+    }
+  }
+  for (const DelimitedTextChunk& chunk : chunks)
+  {
+    if (chunk.Error)
+    {
+      std::rethrow_exception(chunk.Error);
+    }
+  }
+
+  vtkIdType numberOfRecords = 0;
+  const DelimitedTextChunk* firstChunk = nullptr;
+  for (DelimitedTextChunk& chunk : chunks)
+  {
+    chunk.FirstRecord = numberOfRecords;
+    numberOfRecords += static_cast<vtkIdType>(chunk.RecordOffsets.size());
+    if (!firstChunk && !chunk.RecordOffsets.empty())
+    {
+      firstChunk = &chunk;
+    }
+  }
+  if (!firstChunk)
+  {
+    return true;
+  }
+
+  // The first record gives the columns.
+  const size_t numberOfColumns = firstChunk->RecordOffsets.size() > 1
+    ? firstChunk->RecordOffsets[1]
+    : firstChunk->Fields.size();
+  std::vector<std::string> names(numberOfColumns);
+  for (size_t c = 0; c < numberOfColumns; ++c)
+  {
+    if (this->HaveHeaders)
+    {
+      names[c] = firstChunk->Fields[c].c_str();
+    }
+    else
+    {
+      std::stringstream buffer;
+      buffer << "Field " << c;
+      names[c] = buffer.str();
+    }
+  }
+  // The table replaces the columns by name, and the sequential parsing
+  // then fills them by index.
+  if (std::set<std::string>(names.begin(), names.end()).size() != numberOfColumns)
+  {
+    return false;
+  }
+  const bool detectNumericColumns = this->DetectNumericColumns;
+
+  const vtkIdType headerRecords = this->HaveHeaders ? 1 : 0;
+  // Number of fields of a record of a chunk.
+  auto numberOfFields = [](const DelimitedTextChunk& chunk, size_t r) {
+    return (r + 1 < chunk.RecordOffsets.size() ? chunk.RecordOffsets[r + 1]
+                                               : chunk.Fields.size()) -
+      chunk.RecordOffsets[r];
+  };
+  const bool trimWhitespace = this->TrimWhitespacePriorToNumericConversion;
+  const vtkIdType noRow = std::numeric_limits<vtkIdType>::max();
+  vtkSMPTools::For(0, numberOfChunks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      DelimitedTextChunk& chunk = chunks[i];
+      chunk.LastRow.assign(numberOfColumns, -1);
+      if (detectNumericColumns)
+      {
+        chunk.FirstNonInteger.assign(numberOfColumns, noRow);
+        chunk.FirstNonNumeric.assign(numberOfColumns, noRow);
+        chunk.Values.resize(chunk.Fields.size());
+        chunk.Kinds.assign(chunk.Fields.size(), TextField);
+      }
+      for (size_t r = 0; r < chunk.RecordOffsets.size(); ++r)
+      {
+        const vtkIdType row = chunk.FirstRecord + static_cast<vtkIdType>(r) - headerRecords;
+        if (row < 0)
+        {
+          continue;
+        }
+        const size_t begin = chunk.RecordOffsets[r];
+        const size_t count = std::min(numberOfFields(chunk, r), numberOfColumns);
+        for (size_t c = 0; c < count; ++c)
+        {
+          chunk.LastRow[c] = row;
+          // Like vtkStringToNumeric, stop converting a column once a field
+          // is not a number.
+          if (detectNumericColumns && chunk.FirstNonNumeric[c] == noRow)
+          {
+            FieldKind kind = ConvertField(chunk.Fields[begin + c], trimWhitespace,
+              chunk.Values[begin + c]);
+            chunk.Kinds[begin + c] = kind;
+            if (kind >= RealField && chunk.FirstNonInteger[c] == noRow)
+            {
+              chunk.FirstNonInteger[c] = row;
+            }
+            if (kind == TextField)
+            {
+              chunk.FirstNonNumeric[c] = row;
+            }
+          }
+        }
+      }
+    }
+  });
+
+  // First row from the given one that has a field in the column, or -1.
+  auto nextRowWithField = [&](size_t c, vtkIdType row) -> vtkIdType {
+    const vtkIdType record = row + headerRecords;
+    auto chunk = std::upper_bound(chunks.begin(), chunks.end(), record,
+      [](vtkIdType value, const DelimitedTextChunk& item) { return value < item.FirstRecord; });
+    for (--chunk; chunk != chunks.end(); ++chunk)
+    {
+      for (size_t r = static_cast<size_t>(std::max<vtkIdType>(record - chunk->FirstRecord, 0));
+           r < chunk->RecordOffsets.size(); ++r)
+      {
+        if (numberOfFields(*chunk, r) > c)
+        {
+          return chunk->FirstRecord + static_cast<vtkIdType>(r) - headerRecords;
+        }
+      }
+    }
+    return -1;
+  };
+
+  // As when parsing sequentially, all the columns are added empty since the
+  // last records may be shorter than the first one.
+  std::vector<vtkIdType> numberOfRows(numberOfColumns, 0);
+  for (size_t c = 0; c < numberOfColumns; ++c)
+  {
+    for (const DelimitedTextChunk& chunk : chunks)
+    {
+      numberOfRows[c] = std::max(numberOfRows[c], chunk.LastRow[c] + 1);
+    }
+  }
+  std::vector<vtkSmartPointer<vtkAbstractArray>> columns(numberOfColumns);
+  for (size_t c = 0; c < numberOfColumns; ++c)
+  {
+    bool allInteger = true;
+    bool allNumeric = detectNumericColumns;
+    for (const DelimitedTextChunk& chunk : chunks)
+    {
+      if (detectNumericColumns)
+      {
+        allInteger &= chunk.FirstNonInteger[c] == noRow;
+        allNumeric &= chunk.FirstNonNumeric[c] == noRow;
+      }
+    }
+    if (allNumeric && !this->ForceDouble && allInteger && numberOfRows[c])
+    {
+      columns[c] = vtkSmartPointer<vtkIntArray>::New();
+    }
+    else if (allNumeric)
+    {
+      columns[c] = vtkSmartPointer<vtkDoubleArray>::New();
+    }
+    else
+    {
+      columns[c] = vtkSmartPointer<vtkStringArray>::New();
+      // The sequential parsing resizes the short columns to the number of
+      // rows of the first one, which gives them that many values only if
+      // vtkStringArray::InsertValue allocated more.
+      if (numberOfRows[c] < numberOfRows[0])
+      {
+        vtkIdType size = 0;
+        for (vtkIdType row = nextRowWithField(c, 0); row >= 0; row = nextRowWithField(c, size))
+        {
+          size += row + 2;
+        }
+        if (size > numberOfRows[0])
+        {
+          numberOfRows[c] = numberOfRows[0];
+        }
+      }
+    }
+    columns[c]->SetName(names[c].c_str());
+    output_table->AddColumn(columns[c]);
+  }
+
+  std::vector<vtkStdString*> strings(numberOfColumns, nullptr);
+  std::vector<int*> integers(numberOfColumns, nullptr);
+  std::vector<double*> reals(numberOfColumns, nullptr);
+  for (size_t c = 0; c < numberOfColumns; ++c)
+  {
+    columns[c]->SetNumberOfValues(numberOfRows[c]);
+    if (vtkIntArray* integerColumn = vtkIntArray::SafeDownCast(columns[c]))
+    {
+      integerColumn->FillValue(this->DefaultIntegerValue);
+      integers[c] = integerColumn->GetPointer(0);
+    }
+    else if (vtkDoubleArray* realColumn = vtkDoubleArray::SafeDownCast(columns[c]))
+    {
+      realColumn->FillValue(this->DefaultDoubleValue);
+      reals[c] = realColumn->GetPointer(0);
+    }
+    else
+    {
+      strings[c] = vtkStringArray::SafeDownCast(columns[c])->GetPointer(0);
+    }
+  }
+
+  vtkSMPTools::For(0, numberOfChunks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      DelimitedTextChunk& chunk = chunks[i];
+      for (size_t r = 0; r < chunk.RecordOffsets.size(); ++r)
+      {
+        const vtkIdType row = chunk.FirstRecord + static_cast<vtkIdType>(r) - headerRecords;
+        if (row < 0)
+        {
+          continue;
+        }
+        const size_t begin = chunk.RecordOffsets[r];
+        const size_t count = std::min(numberOfFields(chunk, r), numberOfColumns);
+        for (size_t c = 0; c < count; ++c)
+        {
+          const size_t field = begin + c;
+          if (strings[c])
+          {
+            strings[c][row].swap(chunk.Fields[field]);
+          }
+          else if (chunk.Kinds[field] != EmptyField)
+          {
+            if (integers[c])
+            {
+              integers[c][row] = static_cast<int>(chunk.Values[field]);
+            }
+            else
+            {
+              reals[c][row] = chunk.Values[field];
+            }
+          }
+        }
+      }
+      chunk = DelimitedTextChunk();
+    }
+  });
+
+  numericColumnsDetected = detectNumericColumns;
+  return true;
+}
@@ -49,6 +49,13 @@
  *
  * This class emits ProgressEvent for every 100 lines it reads.
  *
+ * When ParallelParsing is on, the whole input is loaded in memory, split
+ * into chunks of complete records and the chunks are parsed concurrently
+ * with vtkSMPTools. The numeric columns are then detected and converted
+ * chunk by chunk, straight into the typed columns, without the
+ * vtkStringToNumeric pass. The output is the same as the one of the
+ * sequential parsing.
+ *
  * @par Thanks:
  * Thanks to Andy Wilson, Brian Wylie, Tim Shead, and Thomas Otahal
  * from Sandia National Laboratories for implementing this class.
@@ -305,6 +312,18 @@ public:
   vtkBooleanMacro(AddTabFieldDelimiter, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set to true, the records are parsed concurrently, by chunks of the
+   * input. This applies to US-ASCII and UTF-8 input with single byte record
+   * delimiters when MaxRecords is 0; other input is parsed sequentially.
+   * Default is off.
+   */
+  vtkSetMacro(ParallelParsing, bool);
+  vtkGetMacro(ParallelParsing, bool);
+  vtkBooleanMacro(ParallelParsing, bool);
+  ///@}
+
   /**
    * Returns a human-readable description of the most recent error, if any.
    * Otherwise, returns an empty string.  Note that the result is only valid
@@ -331,6 +350,12 @@ protected:
   // Read the content of the input file.
   int ReadData(vtkTable* const output_table);
 
+  // Read the content of the input file by chunks parsed concurrently.
+  // Returns false, with the output untouched, if the input cannot be split
+  // in chunks; numericColumnsDetected is set when the numeric columns were
+  // converted along.
+  bool ReadDataInParallel(vtkTable* const output_table, bool& numericColumnsDetected);
+
   char* FileName;
   vtkTypeBool ReadFromInputString;
   char* InputString;
@@ -356,6 +381,7 @@ protected:
   bool GeneratePedigreeIds;
   bool OutputPedigreeIds;
   bool AddTabFieldDelimiter;
+  bool ParallelParsing;
   vtkStdString LastError;
   vtkTypeUInt32 ReplacementCharacter;
 
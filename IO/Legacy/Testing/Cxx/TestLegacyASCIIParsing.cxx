@@ -0,0 +1,247 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIParsing.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks the parsing of the numbers of the ascii legacy files, and reports
+// the reading speed of ascii and binary files.
+
+#include "vtkCellArray.h"
+#include "vtkCharArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkTypeInt64Array.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+namespace
+{
+// Numbers in the forms the writers of various tools produce, with mixed
+// separators.
+const char* ASCIIFile = "# vtk DataFile Version 3.0\n"
+                        "ASCII parsing\n"
+                        "ASCII\n"
+                        "DATASET POLYDATA\n"
+                        "FIELD FieldData 3\n"
+                        "chars 1 4 char\n"
+                        "-128 127 0 65\n"
+                        "bytes 1 4 unsigned_char\n"
+                        "0 255 +7 10\n"
+                        "ids 1 4 vtktypeint64\n"
+                        "-9223372036854775808 9223372036854775807 0 -42\n"
+                        "POINTS 4 double\n"
+                        "+1 1. .5\t-2.5E-3\r\n"
+                        "1e+02   nan -inf INF\n"
+                        "-0 0.1 1e-310 17976931348623157e292\n"
+                        "POLYGONS 1 5\n"
+                        "4 0 1 2\n"
+                        "3\n"
+                        "POINT_DATA 4\n"
+                        "SCALARS values float 1\n"
+                        "LOOKUP_TABLE default\n"
+                        "3.25 -1 1e3 0.1\n";
+
+bool CheckParsing()
+{
+  vtkNew<vtkPolyDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(ASCIIFile);
+  reader->Update();
+  vtkPolyData* polyData = reader->GetOutput();
+
+  const double infinity = std::numeric_limits<double>::infinity();
+  const double points[12] = { 1, 1, 0.5, -2.5e-3, 100, 0, -infinity, infinity, -0.0, 0.1, 1e-310,
+    1.7976931348623157e308 };
+  if (polyData->GetNumberOfPoints() != 4)
+  {
+    std::cerr << "Wrong number of points." << std::endl;
+    return false;
+  }
+  for (int i = 0; i < 12; ++i)
+  {
+    double value = polyData->GetPoint(i / 3)[i % 3];
+    if (i == 5 ? !std::isnan(value) : value != points[i])
+    {
+      std::cerr << "Wrong point coordinate " << i << ": " << value << std::endl;
+      return false;
+    }
+  }
+
+  vtkCellArray* polys = polyData->GetPolys();
+  vtkIdType numberOfIds;
+  const vtkIdType* ids;
+  polys->InitTraversal();
+  if (polys->GetNumberOfCells() != 1 || !polys->GetNextCell(numberOfIds, ids) ||
+    numberOfIds != 4 || ids[0] != 0 || ids[1] != 1 || ids[2] != 2 || ids[3] != 3)
+  {
+    std::cerr << "Wrong polygon." << std::endl;
+    return false;
+  }
+
+  vtkFloatArray* values =
+    vtkFloatArray::SafeDownCast(polyData->GetPointData()->GetArray("values"));
+  if (!values || values->GetValue(0) != 3.25f || values->GetValue(1) != -1.0f ||
+    values->GetValue(2) != 1000.0f || values->GetValue(3) != 0.1f)
+  {
+    std::cerr << "Wrong scalars." << std::endl;
+    return false;
+  }
+
+  vtkFieldData* fieldData = polyData->GetFieldData();
+  vtkCharArray* chars = vtkCharArray::SafeDownCast(fieldData->GetAbstractArray("chars"));
+  vtkUnsignedCharArray* bytes =
+    vtkUnsignedCharArray::SafeDownCast(fieldData->GetAbstractArray("bytes"));
+  vtkTypeInt64Array* int64s = vtkTypeInt64Array::SafeDownCast(fieldData->GetAbstractArray("ids"));
+  if (!chars || chars->GetValue(0) != static_cast<char>(-128) || chars->GetValue(1) != 127 ||
+    chars->GetValue(2) != 0 || chars->GetValue(3) != 'A')
+  {
+    std::cerr << "Wrong char array." << std::endl;
+    return false;
+  }
+  if (!bytes || bytes->GetValue(0) != 0 || bytes->GetValue(1) != 255 || bytes->GetValue(2) != 7 ||
+    bytes->GetValue(3) != 10)
+  {
+    std::cerr << "Wrong unsigned char array." << std::endl;
+    return false;
+  }
+  if (!int64s || int64s->GetValue(0) != std::numeric_limits<vtkTypeInt64>::min() ||
+    int64s->GetValue(1) != std::numeric_limits<vtkTypeInt64>::max() || int64s->GetValue(2) != 0 ||
+    int64s->GetValue(3) != -42)
+  {
+    std::cerr << "Wrong int64 array." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkPolyData> MakePolyData(vtkIdType numberOfPoints)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(numberOfPoints);
+  vtkNew<vtkDoubleArray> pressure;
+  pressure->SetName("pressure");
+  pressure->SetNumberOfValues(numberOfPoints);
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("labels");
+  labels->SetNumberOfValues(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    points->SetPoint(i, std::sin(i * 0.01), std::cos(i * 0.01), i * 1e-3);
+    pressure->SetValue(i, 101325.0 + std::sin(i * 0.001) * 1e3);
+    labels->SetValue(i, static_cast<int>(i % 1000) - 500);
+  }
+  vtkNew<vtkCellArray> polys;
+  for (vtkIdType i = 0; i + 2 < numberOfPoints; i += 3)
+  {
+    const vtkIdType triangle[3] = { i, i + 1, i + 2 };
+    polys->InsertNextCell(3, triangle);
+  }
+
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  polyData->SetPolys(polys);
+  polyData->GetPointData()->AddArray(pressure);
+  polyData->GetPointData()->AddArray(labels);
+  return polyData;
+}
+
+bool CheckThroughput(vtkPolyData* expected, bool binary)
+{
+  vtkNew<vtkPolyDataWriter> writer;
+  writer->SetInputData(expected);
+  writer->WriteToOutputStringOn();
+  writer->SetFileType(binary ? VTK_BINARY : VTK_ASCII);
+  writer->Write();
+  const std::string content = writer->GetOutputStdString();
+
+  vtkNew<vtkPolyDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  reader->Update();
+  timer->StopTimer();
+  vtkPolyData* polyData = reader->GetOutput();
+
+  // The ascii writer rounds the values, so compare with a tolerance.
+  const double tolerance = binary ? 0.0 : 1e-5;
+  vtkDataArray* arrays[3] = { polyData->GetPoints() ? polyData->GetPoints()->GetData() : nullptr,
+    polyData->GetPointData()->GetArray("pressure"), polyData->GetPointData()->GetArray("labels") };
+  vtkDataArray* expectedArrays[3] = { expected->GetPoints()->GetData(),
+    expected->GetPointData()->GetArray("pressure"), expected->GetPointData()->GetArray("labels") };
+  for (int a = 0; a < 3; ++a)
+  {
+    if (!arrays[a] || arrays[a]->GetNumberOfValues() != expectedArrays[a]->GetNumberOfValues())
+    {
+      std::cerr << "Missing or wrong sized array " << a << std::endl;
+      return false;
+    }
+    const int numberOfComponents = arrays[a]->GetNumberOfComponents();
+    for (vtkIdType i = 0; i < arrays[a]->GetNumberOfValues(); ++i)
+    {
+      double value = arrays[a]->GetComponent(i / numberOfComponents, i % numberOfComponents);
+      double expectedValue =
+        expectedArrays[a]->GetComponent(i / numberOfComponents, i % numberOfComponents);
+      if (std::abs(value - expectedValue) > tolerance * std::max(1.0, std::abs(expectedValue)))
+      {
+        std::cerr << "Wrong value " << i << " in array " << a << ": " << value << " instead of "
+                  << expectedValue << std::endl;
+        return false;
+      }
+    }
+  }
+  if (polyData->GetNumberOfPolys() != expected->GetNumberOfPolys())
+  {
+    std::cerr << "Wrong number of polygons." << std::endl;
+    return false;
+  }
+
+  double megaBytes = content.size() / (1024. * 1024.);
+  std::cout << (binary ? "binary " : "ascii  ") << std::fixed << std::setprecision(1)
+            << std::setw(8) << megaBytes << " MB " << std::setw(10)
+            << megaBytes / std::max(timer->GetElapsedTime(), 1e-9) << " MB/s" << std::endl;
+  return true;
+}
+}
+
+int TestLegacyASCIIParsing(int, char*[])
+{
+  if (!CheckParsing())
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkPolyData> polyData = MakePolyData(300000);
+  if (!CheckThroughput(polyData, false) || !CheckThroughput(polyData, true))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
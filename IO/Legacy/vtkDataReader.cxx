@@ -61,8 +61,12 @@
 #include "vtksys/FStream.hxx"
 #include <vtksys/SystemTools.hxx>
 
+#include "vtk_doubleconversion.h"
+#include VTK_DOUBLECONVERSION_HEADER(double-conversion.h)
+
 #include <algorithm>
 #include <cctype>
+#include <limits>
 #include <sstream>
 #include <vector>
 
@@ -1518,22 +1522,217 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
   return 1;
 }
 
-// General templated function to read data of various types.
-template <class T>
-int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
+namespace
+{
+// Parses the whitespace separated numbers of the ascii sections. The stream
+// is read by large chunks instead of one formatted extraction per value, and
+// the characters read past the last parsed number are given back to the
+// stream on destruction, as Peek() does, so that the reading of the file can
+// go on from there.
+class vtkASCIINumberParser
 {
-  vtkIdType i, j;
+public:
+  vtkASCIINumberParser(istream* is, vtkIdType numberOfValues)
+    : IS(is)
+  {
+    // Enough for the expected values without reading too far past small
+    // arrays; the buffer grows if a single token does not fit.
+    const vtkIdType chunkSize = std::min<vtkIdType>(
+      std::max<vtkIdType>(numberOfValues * 16, 1024), vtkIdType(1) << 20);
+    this->Buffer.resize(static_cast<size_t>(chunkSize));
+  }
+
+  ~vtkASCIINumberParser()
+  {
+    const size_t unparsed = this->Size - this->Position;
+    if (unparsed > 0)
+    {
+      this->IS->clear();
+      this->IS->seekg(-static_cast<std::streamoff>(unparsed), ios::cur);
+    }
+    else if (this->EndOfStream)
+    {
+      // Same state as after extracting the last value of the stream.
+      this->IS->clear(ios::eofbit);
+    }
+  }
+
+  template <typename T>
+  bool Read(T* value)
+  {
+    const char* begin;
+    const char* end;
+    return this->NextToken(begin, end) && vtkASCIINumberParser::Parse(begin, end, *value);
+  }
 
-  for (i = 0; i < numTuples; i++)
+private:
+  static bool IsSpace(char c)
   {
-    for (j = 0; j < numComp; j++)
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+  }
+
+  // Moves the unparsed characters to the front of the buffer and appends
+  // the next chunk of the stream.
+  void Fill()
+  {
+    this->Size -= this->Position;
+    std::copy(this->Buffer.begin() + this->Position,
+      this->Buffer.begin() + this->Position + this->Size, this->Buffer.begin());
+    this->Position = 0;
+    if (this->Size == this->Buffer.size())
     {
-      if (!self->Read(data++))
+      this->Buffer.resize(2 * this->Buffer.size());
+    }
+    const size_t requested = this->Buffer.size() - this->Size;
+    this->IS->read(&this->Buffer[this->Size], static_cast<std::streamsize>(requested));
+    const size_t count = static_cast<size_t>(this->IS->gcount());
+    this->Size += count;
+    this->EndOfStream = count < requested;
+  }
+
+  bool NextToken(const char*& begin, const char*& end)
+  {
+    for (;;)
+    {
+      while (this->Position < this->Size && IsSpace(this->Buffer[this->Position]))
       {
-        vtkGenericWarningMacro(<< "Error reading ascii data. Possible mismatch of "
-                                  "datasize with declaration.");
-        return 0;
+        ++this->Position;
+      }
+      if (this->Position == this->Size)
+      {
+        if (this->EndOfStream)
+        {
+          return false;
+        }
+        this->Fill();
+        continue;
+      }
+      size_t tokenEnd = this->Position;
+      while (tokenEnd < this->Size && !IsSpace(this->Buffer[tokenEnd]))
+      {
+        ++tokenEnd;
+      }
+      if (tokenEnd == this->Size && !this->EndOfStream)
+      {
+        // The token may go on in the next chunk.
+        this->Fill();
+        continue;
+      }
+      begin = this->Buffer.data() + this->Position;
+      end = this->Buffer.data() + tokenEnd;
+      this->Position = tokenEnd;
+      return true;
+    }
+  }
+
+  template <typename T>
+  static bool ParseInteger(const char* begin, const char* end, T& value)
+  {
+    bool negative = false;
+    if (*begin == '-' || *begin == '+')
+    {
+      negative = *begin == '-';
+      ++begin;
+    }
+    if (begin == end)
+    {
+      return false;
+    }
+    unsigned long long magnitude = 0;
+    for (; begin < end; ++begin)
+    {
+      const unsigned int digit = static_cast<unsigned int>(*begin - '0');
+      if (digit > 9 || magnitude > (std::numeric_limits<unsigned long long>::max() - digit) / 10)
+      {
+        return false;
+      }
+      magnitude = magnitude * 10 + digit;
+    }
+    const unsigned long long maximum = static_cast<unsigned long long>(std::numeric_limits<T>::max());
+    if (std::numeric_limits<T>::is_signed && negative)
+    {
+      if (magnitude > maximum + 1)
+      {
+        return false;
+      }
+      value = static_cast<T>(-static_cast<long long>(magnitude - 1) - 1);
+    }
+    else
+    {
+      if (magnitude > maximum)
+      {
+        return false;
       }
+      // Negative values wrap around for unsigned types, as with operator>>.
+      value = static_cast<T>(negative ? 0 - magnitude : magnitude);
+    }
+    return true;
+  }
+
+  static const double_conversion::StringToDoubleConverter& GetConverter()
+  {
+    static const double_conversion::StringToDoubleConverter converter(
+      double_conversion::StringToDoubleConverter::ALLOW_CASE_INSENSIBILITY, 0.0,
+      std::numeric_limits<double>::quiet_NaN(), "inf", "nan");
+    return converter;
+  }
+
+  // char types are written and read as integers.
+  static bool Parse(const char* begin, const char* end, char& value)
+  {
+    int result;
+    bool success = ParseInteger(begin, end, result);
+    value = static_cast<char>(result);
+    return success;
+  }
+  static bool Parse(const char* begin, const char* end, unsigned char& value)
+  {
+    int result;
+    bool success = ParseInteger(begin, end, result);
+    value = static_cast<unsigned char>(result);
+    return success;
+  }
+  static bool Parse(const char* begin, const char* end, float& value)
+  {
+    int processed = 0;
+    const int length = static_cast<int>(end - begin);
+    value = GetConverter().StringToFloat(begin, length, &processed);
+    return processed == length;
+  }
+  static bool Parse(const char* begin, const char* end, double& value)
+  {
+    int processed = 0;
+    const int length = static_cast<int>(end - begin);
+    value = GetConverter().StringToDouble(begin, length, &processed);
+    return processed == length;
+  }
+  template <typename T>
+  static bool Parse(const char* begin, const char* end, T& value)
+  {
+    return ParseInteger(begin, end, value);
+  }
+
+  istream* IS;
+  std::vector<char> Buffer;
+  size_t Position = 0;
+  size_t Size = 0;
+  bool EndOfStream = false;
+};
+}
+
+// General templated function to read data of various types.
+template <class T>
+int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
+{
+  const vtkIdType numValues = numTuples * numComp;
+  vtkASCIINumberParser parser(self->GetIStream(), numValues);
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    if (!parser.Read(data++))
+    {
+      vtkGenericWarningMacro(<< "Error reading ascii data. Possible mismatch of "
+                                "datasize with declaration.");
+      return 0;
     }
   }
   return 1;
@@ -3170,7 +3369,6 @@ int vtkDataReader::ReadCells(vtkSmartPointer<vtkCellArray>& cellArray)
 int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
 {
   char line[256];
-  int i;
 
   if (this->FileType == VTK_BINARY)
   {
@@ -3188,15 +3386,12 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
   }
   else // ascii
   {
-    for (i = 0; i < size; i++)
+    if (!vtkReadASCIIData(this, data, size, 1))
     {
-      if (!this->Read(data + i))
-      {
-        const char* fname = this->CurrentFileName.c_str();
-        vtkErrorMacro(<< "Error reading ascii cell data!"
-                      << " for file: " << (fname ? fname : "(Null FileName)"));
-        return 0;
-      }
+      const char* fname = this->CurrentFileName.c_str();
+      vtkErrorMacro(<< "Error reading ascii cell data!"
+                    << " for file: " << (fname ? fname : "(Null FileName)"));
+      return 0;
     }
   }
 
@@ -0,0 +1,240 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPLYReaderPieces.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the binary PLY reading and writing by chunks
+// .SECTION Description
+// Writes a point cloud with normals, colors and texture coordinates in
+// binary (both byte orders) and ascii files, and checks that they are read
+// back whole, by pieces, and with only the selected arrays, as well as a
+// mesh, which is read by the first piece only. Also checks that the array
+// selection follows the file.
+
+#include "vtkCellArray.h"
+#include "vtkDataArraySelection.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkPLYReader.h"
+#include "vtkPLYWriter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+const vtkIdType NumberOfPoints = 100000;
+
+void MakeCloud(vtkPolyData* cloud)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName("RGBA");
+  colors->SetNumberOfComponents(4);
+  vtkNew<vtkFloatArray> tcoords;
+  tcoords->SetName("TCoords");
+  tcoords->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->InsertNextPoint(i * 0.25, -i * 0.5, i % 1000);
+    normals->InsertNextTuple3(i % 3, i % 5, -1.5);
+    colors->InsertNextTuple4(i % 256, (i / 256) % 256, 7, 255 - i % 256);
+    tcoords->InsertNextTuple2(i * 1e-5, 1 - i * 1e-5);
+  }
+  cloud->SetPoints(points);
+  cloud->SetPolys(vtkNew<vtkCellArray>());
+  cloud->GetPointData()->SetNormals(normals);
+  cloud->GetPointData()->SetScalars(colors);
+  cloud->GetPointData()->SetTCoords(tcoords);
+}
+
+bool Write(vtkPolyData* data, const std::string& fileName, int fileType, int byteOrder)
+{
+  vtkNew<vtkPLYWriter> writer;
+  writer->SetInputData(data);
+  writer->SetFileName(fileName.c_str());
+  writer->SetFileType(fileType);
+  writer->SetDataByteOrder(byteOrder);
+  writer->SetArrayName("RGBA");
+  writer->EnableAlphaOn();
+  if (!writer->Write())
+  {
+    std::cerr << "Cannot write " << fileName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool SameArray(vtkDataArray* expected, vtkDataArray* array, vtkIdType offset, const char* name)
+{
+  if (!array || array->GetNumberOfComponents() != expected->GetNumberOfComponents() ||
+    offset + array->GetNumberOfTuples() > expected->GetNumberOfTuples())
+  {
+    std::cerr << "Missing or wrong sized " << name << std::endl;
+    return false;
+  }
+  const int numComps = array->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < numComps; ++c)
+    {
+      if (array->GetComponent(i, c) != expected->GetComponent(offset + i, c))
+      {
+        std::cerr << "Wrong " << name << " " << offset + i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Compares the points of a piece, starting at offset, to the cloud
+bool SamePoints(vtkPolyData* cloud, vtkPolyData* piece, vtkIdType offset, bool withNormals)
+{
+  vtkPointData* expected = cloud->GetPointData();
+  vtkPointData* pd = piece->GetPointData();
+  if (withNormals != (pd->GetNormals() != nullptr))
+  {
+    std::cerr << "Normals " << (withNormals ? "not " : "") << "read." << std::endl;
+    return false;
+  }
+  return SameArray(cloud->GetPoints()->GetData(), piece->GetPoints()->GetData(), offset,
+           "points") &&
+    SameArray(expected->GetScalars(), pd->GetArray("RGBA"), offset, "colors") &&
+    SameArray(expected->GetTCoords(), pd->GetTCoords(), offset, "texture coordinates") &&
+    (!withNormals || SameArray(expected->GetNormals(), pd->GetNormals(), offset, "normals"));
+}
+}
+
+int TestPLYReaderPieces(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestPLYReaderPieces";
+  delete[] tempDir;
+
+  vtkNew<vtkPolyData> cloud;
+  MakeCloud(cloud);
+  const std::string fileNames[] = { prefix + "-le.ply", prefix + "-be.ply", prefix + "-ascii.ply" };
+  if (!Write(cloud, fileNames[0], VTK_BINARY, VTK_LITTLE_ENDIAN) ||
+    !Write(cloud, fileNames[1], VTK_BINARY, VTK_BIG_ENDIAN) ||
+    !Write(cloud, fileNames[2], VTK_ASCII, VTK_LITTLE_ENDIAN))
+  {
+    return EXIT_FAILURE;
+  }
+
+  for (const std::string& fileName : fileNames)
+  {
+    vtkNew<vtkPLYReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    if (reader->GetOutput()->GetNumberOfPoints() != NumberOfPoints ||
+      !SamePoints(cloud, reader->GetOutput(), 0, true))
+    {
+      std::cerr << "Cannot read " << fileName << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The pieces of binary point clouds read their range of vertices, without
+  // the unselected arrays.
+  for (int f = 0; f < 2; ++f)
+  {
+    vtkNew<vtkPLYReader> reader;
+    reader->SetFileName(fileNames[f].c_str());
+    reader->UpdateInformation();
+    if (reader->GetPointDataArraySelection()->GetNumberOfArrays() != 3)
+    {
+      std::cerr << "Wrong point arrays in " << fileNames[f] << std::endl;
+      return EXIT_FAILURE;
+    }
+    reader->GetPointDataArraySelection()->DisableArray("Normals");
+    const int numPieces = 3;
+    vtkIdType offset = 0;
+    for (int piece = 0; piece < numPieces; ++piece)
+    {
+      reader->UpdatePiece(piece, numPieces, 0);
+      vtkPolyData* output = reader->GetOutput();
+      if (output->GetNumberOfPoints() == 0 || !SamePoints(cloud, output, offset, false))
+      {
+        std::cerr << "Wrong piece " << piece << " of " << fileNames[f] << std::endl;
+        return EXIT_FAILURE;
+      }
+      offset += output->GetNumberOfPoints();
+    }
+    if (offset != NumberOfPoints)
+    {
+      std::cerr << "The pieces of " << fileNames[f] << " have " << offset << " points."
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Meshes are read by the first piece
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  vtkPolyData* mesh = sphere->GetOutput();
+  const std::string meshFileName = prefix + "-mesh.ply";
+  if (!Write(mesh, meshFileName, VTK_BINARY, VTK_BIG_ENDIAN))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkPLYReader> reader;
+  reader->SetFileName(meshFileName.c_str());
+  reader->UpdatePiece(0, 2, 0);
+  vtkPolyData* output = reader->GetOutput();
+  if (!SameArray(mesh->GetPoints()->GetData(), output->GetPoints()->GetData(), 0, "points") ||
+    output->GetNumberOfPoints() != mesh->GetNumberOfPoints() ||
+    !SameArray(mesh->GetPolys()->GetConnectivityArray(),
+      output->GetPolys()->GetConnectivityArray(), 0, "connectivity") ||
+    output->GetNumberOfPolys() != mesh->GetNumberOfPolys())
+  {
+    std::cerr << "Wrong mesh." << std::endl;
+    return EXIT_FAILURE;
+  }
+  reader->UpdatePiece(1, 2, 0);
+  if (reader->GetOutput()->GetNumberOfPoints() != 0)
+  {
+    std::cerr << "The mesh is read by the second piece." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Switching files drops the arrays the new file does not have, and keeps
+  // the status of the others.
+  vtkNew<vtkPLYReader> switchingReader;
+  switchingReader->SetFileName(fileNames[0].c_str());
+  switchingReader->UpdateInformation();
+  vtkDataArraySelection* selection = switchingReader->GetPointDataArraySelection();
+  selection->DisableArray("Normals");
+  switchingReader->SetFileName(meshFileName.c_str());
+  switchingReader->UpdateInformation();
+  if (selection->GetNumberOfArrays() != 1 || !selection->ArrayExists("Normals") ||
+    selection->ArrayIsEnabled("Normals"))
+  {
+    std::cerr << "Wrong point arrays after switching to " << meshFileName << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -92,7 +92,7 @@ void* plyAllocateMemory(size_t n)
 const char* type_names[] = { "invalid", "char", "short", "int", "int8", "int16", "int32", "uchar",
   "ushort", "uint", "uint8", "uint16", "uint32", "float", "float32", "double", "float64" };
 
-const int ply_type_size[] = { 0, 1, 2, 4, 1, 2, 4, 1, 2, 4, 1, 2, 4, 4, 4, 8 };
+const int ply_type_size[] = { 0, 1, 2, 4, 1, 2, 4, 1, 2, 4, 1, 2, 4, 4, 4, 8, 8 };
 }
 
 #define NO_OTHER_PROPS (-1)
@@ -400,7 +400,7 @@ Entry:
   nelems    - number of elements of this type to be written
 ******************************************************************************/
 
-void vtkPLY::ply_element_count(PlyFile* plyfile, const char* elem_name, int nelems)
+void vtkPLY::ply_element_count(PlyFile* plyfile, const char* elem_name, long long nelems)
 {
   PlyElement* elem;
 
@@ -898,7 +898,7 @@ Exit:
 ******************************************************************************/
 
 PlyElement* vtkPLY::ply_get_element_description(
-  PlyFile* plyfile, char* elem_name, int* nelems, int* nprops)
+  PlyFile* plyfile, char* elem_name, long long* nelems, int* nprops)
 {
   // wjs: this class has been drastically changed because of memory leaks.
   // the return type is different, and the element properties are not
@@ -1446,6 +1446,37 @@ void vtkPLY::ply_get_info(PlyFile* ply, float* version, int* file_type)
   *file_type = ply->file_type;
 }
 
+/******************************************************************************
+Get the layout of an element without list properties, as stored in a binary
+file, to read or write many of them at once.
+
+Entry:
+  elem - element to get the layout of
+
+Exit:
+  offsets - byte offset of each property of the element
+  returns the size of an element in bytes, or -1 if it has list properties
+******************************************************************************/
+
+int vtkPLY::ply_get_element_layout(PlyElement* elem, std::vector<int>* offsets)
+{
+  int size = 0;
+  offsets->clear();
+  for (int i = 0; i < elem->nprops; i++)
+  {
+    PlyProperty* prop = elem->props[i];
+    if (prop->is_list || prop->external_type <= PLY_START_TYPE ||
+      prop->external_type >= PLY_END_TYPE)
+    {
+      offsets->clear();
+      return -1;
+    }
+    offsets->push_back(size);
+    size += ply_type_size[prop->external_type];
+  }
+  return size;
+}
+
 /******************************************************************************
 Compare two null-terminated strings.  Returns 1 if they are the same, 0 if not.
 ******************************************************************************/
@@ -2610,7 +2641,7 @@ void vtkPLY::add_element(PlyFile* plyfile, const std::vector<char*>& words)
   /* create the new element */
   elem = (PlyElement*)myalloc(sizeof(PlyElement));
   elem->name = strdup(words[1]);
-  elem->num = atoi(words[2]);
+  elem->num = strtoll(words[2], nullptr, 10);
   elem->nprops = 0;
 
   /* make room for new element in the object's list of elements */
@@ -119,7 +119,7 @@ typedef struct PlyProperty
 typedef struct PlyElement
 {                      /* description of an element */
   char* name;          /* element name */
-  int num;             /* number of elements in this object */
+  long long num;       /* number of elements in this object */
   int size;            /* size of element (bytes) or -1 if variable */
   int nprops;          /* number of properties for this element */
   PlyProperty** props; /* list of properties in the file */
@@ -180,7 +180,7 @@ public:
   static PlyFile* ply_open_for_writing_to_string(std::string&, int, const char**, int);
   static void ply_describe_element(PlyFile*, const char*, int, int, PlyProperty*);
   static void ply_describe_property(PlyFile*, const char*, PlyProperty*);
-  static void ply_element_count(PlyFile*, const char*, int);
+  static void ply_element_count(PlyFile*, const char*, long long);
   static void ply_header_complete(PlyFile*);
   static void ply_put_element_setup(PlyFile*, const char*);
   static void ply_put_element(PlyFile*, void*);
@@ -189,7 +189,7 @@ public:
   static PlyFile* ply_read(std::istream*, int*, char***);
   static PlyFile* ply_open_for_reading(const char*, int*, char***);
   static PlyFile* ply_open_for_reading_from_string(const std::string&, int*, char***);
-  static PlyElement* ply_get_element_description(PlyFile*, char*, int*, int*);
+  static PlyElement* ply_get_element_description(PlyFile*, char*, long long*, int*);
   static void ply_get_element_setup(PlyFile*, const char*, int, PlyProperty*);
   static void ply_get_property(PlyFile*, const char*, PlyProperty*);
   static PlyOtherProp* ply_get_other_properties(PlyFile*, const char*, int);
@@ -204,6 +204,11 @@ public:
   static void ply_free_other_elements(PlyOtherElems*);
   static void ply_describe_other_properties(PlyFile*, PlyOtherProp*, int);
 
+  // Layout of the elements without list properties in binary files, so that
+  // they can be read or written in bulk. Returns the size of an element in
+  // bytes, and the offsets of its properties, or -1 if it has lists.
+  static int ply_get_element_layout(PlyElement*, std::vector<int>*);
+
   // These methods are internal to the PLY library in the normal distribution
   // They should be used carefully
   static bool equal_strings(const char*, const char*);
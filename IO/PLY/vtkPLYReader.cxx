@@ -14,9 +14,12 @@
 =========================================================================*/
 #include "vtkPLYReader.h"
 
+#include "vtkByteSwap.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCommand.h"
 #include "vtkDataArray.h"
+#include "vtkDataArraySelection.h"
 #include "vtkFloatArray.h"
 #include "vtkIncrementalOctreePointLocator.h"
 #include "vtkInformation.h"
@@ -30,6 +33,7 @@
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkUnsignedCharArray.h"
 
@@ -38,6 +42,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cstddef>
+#include <cstring>
 #include <vector>
 
 vtkStandardNewMacro(vtkPLYReader);
@@ -90,12 +95,150 @@ bool FuzzyEqual(double* f, double* s, double t)
   return vtkMathUtilities::FuzzyCompare(f[0], s[0], t) &&
     vtkMathUtilities::FuzzyCompare(f[1], s[1], t) && vtkMathUtilities::FuzzyCompare(f[2], s[2], t);
 }
+
+PlyFile* openForReading(
+  bool fromString, const std::string& inputString, const char* fileName, int* nelems, char*** elist)
+{
+  return fromString ? vtkPLY::ply_open_for_reading_from_string(inputString, nelems, elist)
+                    : vtkPLY::ply_open_for_reading(fileName, nelems, elist);
+}
+
+/**
+ * Where to store a property of binary elements read in bulk: every
+ * Stride-th value of either Floats or Bytes.
+ */
+struct PropertyTarget
+{
+  const char* Name;
+  float* Floats;
+  unsigned char* Bytes;
+  int Stride;
+};
+
+template <typename FileT, typename T>
+void decodeProperty(const char* data, vtkIdType count, int size, bool bigEndian, T* out, int stride)
+{
+  for (vtkIdType i = 0; i < count; ++i, data += size, out += stride)
+  {
+    FileT value;
+    memcpy(&value, data, sizeof(value));
+    if (bigEndian)
+    {
+      vtkByteSwap::SwapBE(&value);
+    }
+    else
+    {
+      vtkByteSwap::SwapLE(&value);
+    }
+    *out = static_cast<T>(value);
+  }
+}
+
+template <typename T>
+void decodeProperty(
+  int type, const char* data, vtkIdType count, int size, bool bigEndian, T* out, int stride)
+{
+  switch (type)
+  {
+    case PLY_CHAR:
+    case PLY_INT8:
+      decodeProperty<vtkTypeInt8>(data, count, size, bigEndian, out, stride);
+      break;
+    case PLY_UCHAR:
+    case PLY_UINT8:
+      decodeProperty<vtkTypeUInt8>(data, count, size, bigEndian, out, stride);
+      break;
+    case PLY_SHORT:
+    case PLY_INT16:
+      decodeProperty<vtkTypeInt16>(data, count, size, bigEndian, out, stride);
+      break;
+    case PLY_USHORT:
+    case PLY_UINT16:
+      decodeProperty<vtkTypeUInt16>(data, count, size, bigEndian, out, stride);
+      break;
+    case PLY_INT:
+    case PLY_INT32:
+      decodeProperty<vtkTypeInt32>(data, count, size, bigEndian, out, stride);
+      break;
+    case PLY_UINT:
+    case PLY_UINT32:
+      decodeProperty<vtkTypeUInt32>(data, count, size, bigEndian, out, stride);
+      break;
+    case PLY_FLOAT:
+    case PLY_FLOAT32:
+      decodeProperty<vtkTypeFloat32>(data, count, size, bigEndian, out, stride);
+      break;
+    case PLY_DOUBLE:
+    case PLY_FLOAT64:
+      decodeProperty<vtkTypeFloat64>(data, count, size, bigEndian, out, stride);
+      break;
+  }
+}
+
+/**
+ * Read the elements [first, first + count) of a binary element without list
+ * properties by blocks, and decode the properties of the targets straight
+ * into their arrays, instead of going through ply_get_element() for each
+ * element. The stream is left at the end of the element.
+ */
+bool readBinaryElements(PlyFile* ply, PlyElement* elem, int size, const std::vector<int>& offsets,
+  vtkIdType first, vtkIdType count, const std::vector<PropertyTarget>& targets)
+{
+  std::vector<int> targetOffsets;
+  std::vector<int> targetTypes;
+  for (const PropertyTarget& target : targets)
+  {
+    int index;
+    PlyProperty* prop = vtkPLY::find_property(elem, target.Name, &index);
+    if (prop == nullptr)
+    {
+      return false;
+    }
+    targetOffsets.push_back(offsets[index]);
+    targetTypes.push_back(prop->external_type);
+  }
+  const bool bigEndian = ply->file_type == PLY_BINARY_BE;
+
+  ply->is->seekg(static_cast<std::streamoff>(first) * size, std::ios::cur);
+  const vtkIdType blockSize = std::max<vtkIdType>(1, (1 << 20) / size);
+  std::vector<char> block(static_cast<size_t>(std::min(blockSize, count) * size));
+  for (vtkIdType done = 0; done < count;)
+  {
+    const vtkIdType n = std::min(blockSize, count - done);
+    ply->is->read(block.data(), static_cast<std::streamsize>(n * size));
+    if (ply->is->gcount() != static_cast<std::streamsize>(n * size))
+    {
+      return false;
+    }
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+      const PropertyTarget& target = targets[i];
+      const char* data = block.data() + targetOffsets[i];
+      if (target.Floats)
+      {
+        decodeProperty(targetTypes[i], data, n, size, bigEndian,
+          target.Floats + done * target.Stride, target.Stride);
+      }
+      else
+      {
+        decodeProperty(targetTypes[i], data, n, size, bigEndian,
+          target.Bytes + done * target.Stride, target.Stride);
+      }
+    }
+    done += n;
+  }
+  ply->is->seekg(static_cast<std::streamoff>(elem->num - first - count) * size, std::ios::cur);
+  return true;
+}
 }
 
 // Construct object with merging set to true.
 vtkPLYReader::vtkPLYReader()
 {
   this->Comments = vtkStringArray::New();
+  this->PointDataArraySelection = vtkDataArraySelection::New();
+  this->PointDataArraySelection->AddObserver(
+    vtkCommand::ModifiedEvent, this, &vtkPLYReader::Modified);
   this->ReadFromInputString = false;
   this->FaceTextureTolerance = 0.000001;
   this->DuplicatePointsForFaceTexture = true;
@@ -105,6 +248,8 @@ vtkPLYReader::~vtkPLYReader()
 {
   this->Comments->Delete();
   this->Comments = nullptr;
+  this->PointDataArraySelection->Delete();
+  this->PointDataArraySelection = nullptr;
 }
 
 namespace
@@ -134,6 +279,71 @@ typedef struct _plyFace
 } plyFace;
 }
 
+int vtkPLYReader::RequestInformation(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
+{
+  // Binary point clouds are split by ranges of vertices; otherwise the
+  // whole data is read by the first piece.
+  outputVector->GetInformationObject(0)->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
+
+  int nelems;
+  char** elist;
+  PlyFile* ply = ::openForReading(
+    this->ReadFromInputString, this->InputString, this->FileName, &nelems, &elist);
+  if (!ply)
+  {
+    // Reported by RequestData()
+    this->PointDataArraySelection->SetArraysWithDefault(nullptr, 0, 1);
+    return 1;
+  }
+
+  // List the point arrays that can be read. The arrays of a previous file
+  // that this one does not have are removed, the others keep their status.
+  std::vector<const char*> arrayNames;
+  PlyElement* elem;
+  int index;
+  bool texCoordsInVertices = false;
+  if ((elem = vtkPLY::find_element(ply, "vertex")) != nullptr)
+  {
+    if ((vtkPLY::find_property(elem, "red", &index) != nullptr &&
+          vtkPLY::find_property(elem, "green", &index) != nullptr &&
+          vtkPLY::find_property(elem, "blue", &index) != nullptr) ||
+      (vtkPLY::find_property(elem, "diffuse_red", &index) != nullptr &&
+        vtkPLY::find_property(elem, "diffuse_green", &index) != nullptr &&
+        vtkPLY::find_property(elem, "diffuse_blue", &index) != nullptr))
+    {
+      arrayNames.push_back(
+        vtkPLY::find_property(elem, "alpha", &index) != nullptr ? "RGBA" : "RGB");
+    }
+    if (vtkPLY::find_property(elem, "nx", &index) != nullptr &&
+      vtkPLY::find_property(elem, "ny", &index) != nullptr &&
+      vtkPLY::find_property(elem, "nz", &index) != nullptr)
+    {
+      arrayNames.push_back("Normals");
+    }
+    texCoordsInVertices = (vtkPLY::find_property(elem, "u", &index) != nullptr &&
+                            vtkPLY::find_property(elem, "v", &index) != nullptr) ||
+      (vtkPLY::find_property(elem, "texture_u", &index) != nullptr &&
+        vtkPLY::find_property(elem, "texture_v", &index) != nullptr);
+  }
+  if (texCoordsInVertices ||
+    ((elem = vtkPLY::find_element(ply, "face")) != nullptr &&
+      vtkPLY::find_property(elem, "texcoord", &index) != nullptr))
+  {
+    arrayNames.push_back("TCoords");
+  }
+  this->PointDataArraySelection->SetArraysWithDefault(
+    arrayNames.data(), static_cast<int>(arrayNames.size()), 1);
+
+  for (int i = 0; i < nelems; i++)
+  {
+    free(elist[i]);
+  }
+  free(elist);
+  vtkPLY::ply_close(ply);
+  return 1;
+}
+
 int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
 {
@@ -177,24 +387,15 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
 
   // open a PLY file for reading
   PlyFile* ply;
-  int nelems, numElems, nprops;
+  int nelems, nprops;
+  long long numElems;
   char **elist, *elemName;
 
-  if (this->ReadFromInputString)
+  if (!(ply = ::openForReading(
+          this->ReadFromInputString, this->InputString, this->FileName, &nelems, &elist)))
   {
-    if (!(ply = vtkPLY::ply_open_for_reading_from_string(this->InputString, &nelems, &elist)))
-    {
-      vtkWarningMacro(<< "Could not open PLY file");
-      return 0;
-    }
-  }
-  else
-  {
-    if (!(ply = vtkPLY::ply_open_for_reading(this->FileName, &nelems, &elist)))
-    {
-      vtkWarningMacro(<< "Could not open PLY file");
-      return 0;
-    }
+    vtkWarningMacro(<< "Could not open PLY file");
+    return 0;
   }
 
   int numberOfComments = 0;
@@ -215,6 +416,29 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
   {
     vtkErrorMacro(<< "Cannot read geometry");
     vtkPLY::ply_close(ply);
+    return 0;
+  }
+
+  // Binary vertices without list properties are read in bulk, and point
+  // clouds of such vertices are split in pieces by ranges of vertices.
+  std::vector<int> vertexOffsets;
+  const int vertexSize = ply->file_type == PLY_ASCII
+    ? -1
+    : vtkPLY::ply_get_element_layout(vtkPLY::find_element(ply, "vertex"), &vertexOffsets);
+  PlyElement* faceElem = vtkPLY::find_element(ply, "face");
+  const bool splitVertices = vertexSize > 0 && (faceElem == nullptr || faceElem->num == 0);
+  const int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  const int numPieces =
+    std::max(1, outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()));
+  if (piece > 0 && !splitVertices)
+  {
+    for (int i = 0; i < nelems; i++)
+    {
+      free(elist[i]);
+    }
+    free(elist);
+    vtkPLY::ply_close(ply);
+    return 1;
   }
 
   // Check for optional attribute data. We can handle intensity; and the
@@ -277,13 +501,18 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
       vertProps[10].name = "diffuse_blue";
     }
     if (rgbPointsAvailable)
+    {
+      rgbPointsHaveAlpha = vtkPLY::find_property(elem, "alpha", &index) != nullptr;
+      rgbPointsAvailable =
+        this->PointDataArraySelection->ArrayIsEnabled(rgbPointsHaveAlpha ? "RGBA" : "RGB") != 0;
+    }
+    if (rgbPointsAvailable)
     {
       rgbPoints = vtkSmartPointer<vtkUnsignedCharArray>::New();
-      if (vtkPLY::find_property(elem, "alpha", &index) != nullptr)
+      if (rgbPointsHaveAlpha)
       {
         rgbPoints->SetName("RGBA");
         rgbPoints->SetNumberOfComponents(4);
-        rgbPointsHaveAlpha = true;
       }
       else
       {
@@ -299,7 +528,8 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
   if ((elem = vtkPLY::find_element(ply, "vertex")) != nullptr &&
     vtkPLY::find_property(elem, "nx", &index) != nullptr &&
     vtkPLY::find_property(elem, "ny", &index) != nullptr &&
-    vtkPLY::find_property(elem, "nz", &index) != nullptr)
+    vtkPLY::find_property(elem, "nz", &index) != nullptr &&
+    this->PointDataArraySelection->ArrayIsEnabled("Normals"))
   {
     normals = vtkSmartPointer<vtkFloatArray>::New();
     normalPointsAvailable = true;
@@ -308,6 +538,8 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
     output->GetPointData()->SetNormals(normals);
   }
 
+  const bool texCoordsEnabled = this->PointDataArraySelection->ArrayIsEnabled("TCoords") != 0;
+  bool texCoordsInVertices = false;
   bool texCoordsPointsAvailable = false;
   vtkSmartPointer<vtkFloatArray> texCoordsPoints = nullptr;
   if ((elem = vtkPLY::find_element(ply, "vertex")) != nullptr)
@@ -315,16 +547,17 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
     if (vtkPLY::find_property(elem, "u", &index) != nullptr &&
       vtkPLY::find_property(elem, "v", &index) != nullptr)
     {
-      texCoordsPointsAvailable = true;
+      texCoordsInVertices = true;
     }
     else if (vtkPLY::find_property(elem, "texture_u", &index) != nullptr &&
       vtkPLY::find_property(elem, "texture_v", &index) != nullptr)
     {
-      texCoordsPointsAvailable = true;
+      texCoordsInVertices = true;
       vertProps[3].name = "texture_u";
       vertProps[4].name = "texture_v";
     }
 
+    texCoordsPointsAvailable = texCoordsInVertices && texCoordsEnabled;
     if (texCoordsPointsAvailable)
     {
       texCoordsPoints = vtkSmartPointer<vtkFloatArray>::New();
@@ -335,7 +568,8 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   bool texCoordsFaceAvailable = false;
-  if ((elem = vtkPLY::find_element(ply, "face")) != nullptr && !texCoordsPointsAvailable)
+  if ((elem = vtkPLY::find_element(ply, "face")) != nullptr && !texCoordsInVertices &&
+    texCoordsEnabled)
   {
     if (vtkPLY::find_property(elem, "texcoord", &index) != nullptr)
     {
@@ -347,18 +581,24 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
   // Okay, now we can grab the data
-  int numPts = 0, numPolys = 0;
+  vtkIdType numPts = 0, numPolys = 0;
   for (int i = 0; i < nelems; i++)
   {
     // get the description of the first element */
     elemName = elist[i];
-    vtkPLY::ply_get_element_description(ply, elemName, &numElems, &nprops);
+    elem = vtkPLY::ply_get_element_description(ply, elemName, &numElems, &nprops);
 
     // if we're on vertex elements, read them in
     if (elemName && !strcmp("vertex", elemName))
     {
-      // Create a list of points
-      numPts = numElems;
+      // Create a list of points, for the vertices of the requested piece
+      vtkIdType firstPt = 0;
+      numPts = static_cast<vtkIdType>(elem->num);
+      if (splitVertices)
+      {
+        firstPt = numPts * piece / numPieces;
+        numPts = numPts * (piece + 1) / numPieces - firstPt;
+      }
       vtkPoints* pts = vtkPoints::New();
       pts->SetDataTypeToFloat();
       pts->SetNumberOfPoints(numPts);
@@ -395,8 +635,54 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
         rgbPoints->SetNumberOfTuples(numPts);
       }
 
+      if (vertexSize > 0)
+      {
+        std::vector<PropertyTarget> targets;
+        float* x = vtkArrayDownCast<vtkFloatArray>(pts->GetData())->GetPointer(0);
+        for (int c = 0; c < 3; ++c)
+        {
+          targets.push_back({ vertProps[c].name, x + c, nullptr, 3 });
+        }
+        if (texCoordsPointsAvailable)
+        {
+          for (int c = 0; c < 2; ++c)
+          {
+            targets.push_back(
+              { vertProps[3 + c].name, texCoordsPoints->GetPointer(c), nullptr, 2 });
+          }
+        }
+        if (normalPointsAvailable)
+        {
+          for (int c = 0; c < 3; ++c)
+          {
+            targets.push_back({ vertProps[5 + c].name, normals->GetPointer(c), nullptr, 3 });
+          }
+        }
+        if (rgbPointsAvailable)
+        {
+          const int numComps = rgbPointsHaveAlpha ? 4 : 3;
+          for (int c = 0; c < numComps; ++c)
+          {
+            targets.push_back(
+              { vertProps[8 + c].name, nullptr, rgbPoints->GetPointer(c), numComps });
+          }
+        }
+        if (!::readBinaryElements(ply, elem, vertexSize, vertexOffsets, firstPt, numPts, targets))
+        {
+          vtkErrorMacro(<< "Error reading the vertices of the PLY file");
+          pts->Delete();
+          for (int j = i; j < nelems; j++)
+          {
+            free(elist[j]);
+          }
+          free(elist);
+          vtkPLY::ply_close(ply);
+          return 0;
+        }
+      }
+
       plyVertex vertex;
-      for (int j = 0; j < numPts; j++)
+      for (vtkIdType j = 0; vertexSize <= 0 && j < numPts; j++)
       {
         vtkPLY::ply_get_element(ply, (void*)&vertex);
         pts->SetPoint(j, vertex.x);
@@ -439,7 +725,7 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
       texLocator->InitPointInsertion(texCoords, bounds);
 
       // Create a polygonal array
-      numPolys = numElems;
+      numPolys = static_cast<vtkIdType>(numElems);
       vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
       polys->AllocateEstimate(numPolys, 3);
       plyFace face;
@@ -472,7 +758,7 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
         if (this->DuplicatePointsForFaceTexture)
         {
           // initialize texture coordinates with invalid value
-          for (int j = 0; j < numPts; ++j)
+          for (vtkIdType j = 0; j < numPts; ++j)
           {
             texCoordsPoints->SetTuple2(j, -1, -1);
           }
@@ -481,7 +767,7 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
 
       // grab all the face elements
       vtkNew<vtkPolygon> cell;
-      for (int j = 0; j < numPolys; j++)
+      for (vtkIdType j = 0; j < numPolys; j++)
       {
         // grab and element from the file
         vtkPLY::ply_get_element(ply, (void*)&face);
@@ -645,6 +931,7 @@ void vtkPLYReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
 
+  os << indent << "PointDataArraySelection: " << this->PointDataArraySelection << "\n";
   os << indent << "Comments:\n";
   indent = indent.GetNextIndent();
   for (int i = 0; i < this->Comments->GetNumberOfValues(); ++i)
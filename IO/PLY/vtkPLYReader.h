@@ -34,6 +34,13 @@
  * filter after this reader or use this reader with DuplicatePointsForFaceTexture
  * set to false.
  *
+ * Binary files are read straight into the arrays, by blocks of vertices,
+ * when the "vertex" element has no list property. Such point clouds (files
+ * without faces) are split in pieces by ranges of vertices, so
+ * that each piece only reads its part of the file. Other files are read
+ * whole by the first piece. The point arrays to read are chosen with
+ * GetPointDataArraySelection(); the properties of the others are skipped.
+ *
  * @sa
  * vtkPLYWriter, vtkCleanPolyData
  */
@@ -44,6 +51,7 @@
 #include "vtkAbstractPolyDataReader.h"
 #include "vtkIOPLYModule.h" // For export macro
 
+class vtkDataArraySelection;
 class vtkStringArray;
 
 class VTKIOPLY_EXPORT vtkPLYReader : public vtkAbstractPolyDataReader
@@ -95,17 +103,26 @@ public:
   vtkGetMacro(DuplicatePointsForFaceTexture, bool);
   vtkSetMacro(DuplicatePointsForFaceTexture, bool);
 
+  /**
+   * Get the selection of the point arrays to read, among "RGB" or "RGBA",
+   * "Normals" and "TCoords", as found in the file by UpdateInformation().
+   * All of them are read by default.
+   */
+  vtkGetObjectMacro(PointDataArraySelection, vtkDataArraySelection);
+
 protected:
   vtkPLYReader();
   ~vtkPLYReader() override;
 
   vtkStringArray* Comments;
+  vtkDataArraySelection* PointDataArraySelection;
   // Whether this object is reading from a string or a file.
   // Default is 0: read from file.
   bool ReadFromInputString;
   // The input string.
   std::string InputString;
 
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
 private:
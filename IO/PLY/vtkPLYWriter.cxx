@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPLYWriter.h"
 
+#include "vtkByteSwap.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
@@ -27,6 +28,7 @@
 #include "vtkUnsignedCharArray.h"
 
 #include <cstddef>
+#include <vector>
 
 vtkStandardNewMacro(vtkPLYWriter);
 
@@ -79,6 +81,117 @@ typedef struct
   unsigned char alpha;
 } plyFace;
 
+namespace
+{
+/**
+ * Packs binary elements in a buffer written to the file by chunks, instead
+ * of writing each property of each element through ply_put_element().
+ */
+class BinaryChunkWriter
+{
+public:
+  BinaryChunkWriter(PlyFile* ply)
+    : Stream(ply->os)
+    , BigEndian(ply->file_type == PLY_BINARY_BE)
+  {
+    this->Buffer.reserve(ChunkSize + 1024);
+  }
+
+  ~BinaryChunkWriter() { this->Flush(); }
+
+  template <typename T>
+  void Put(T value)
+  {
+    this->BigEndian ? vtkByteSwap::SwapBE(&value) : vtkByteSwap::SwapLE(&value);
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    this->Buffer.insert(this->Buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  void EndElement()
+  {
+    if (this->Buffer.size() >= ChunkSize)
+    {
+      this->Flush();
+    }
+  }
+
+  void Flush()
+  {
+    this->Stream->write(this->Buffer.data(), static_cast<std::streamsize>(this->Buffer.size()));
+    this->Buffer.clear();
+  }
+
+private:
+  static const size_t ChunkSize = 1 << 20;
+  std::ostream* Stream;
+  bool BigEndian;
+  std::vector<char> Buffer;
+};
+
+// Same properties as described in the header by vtkPLYWriter::WriteData()
+void writeBinaryVertices(PlyFile* ply, vtkPoints* points, const float* normals,
+  vtkUnsignedCharArray* colors, const float* textureCoords)
+{
+  BinaryChunkWriter writer(ply);
+  const int numColorComps = colors ? colors->GetNumberOfComponents() : 0;
+  const unsigned char* color = colors ? colors->GetPointer(0) : nullptr;
+  double point[3];
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    points->GetPoint(i, point);
+    writer.Put(static_cast<float>(point[0]));
+    writer.Put(static_cast<float>(point[1]));
+    writer.Put(static_cast<float>(point[2]));
+    if (normals)
+    {
+      writer.Put(normals[3 * i]);
+      writer.Put(normals[3 * i + 1]);
+      writer.Put(normals[3 * i + 2]);
+    }
+    for (int c = 0; c < numColorComps; ++c)
+    {
+      writer.Put(*color++);
+    }
+    if (textureCoords)
+    {
+      writer.Put(textureCoords[2 * i]);
+      writer.Put(textureCoords[2 * i + 1]);
+    }
+    writer.EndElement();
+  }
+}
+
+// Returns the number of polygons that have too many points to be written
+vtkIdType writeBinaryFaces(PlyFile* ply, vtkCellArray* polys, vtkUnsignedCharArray* colors)
+{
+  BinaryChunkWriter writer(ply);
+  const int numColorComps = colors ? colors->GetNumberOfComponents() : 0;
+  vtkIdType numSkipped = 0;
+  vtkIdType npts = 0;
+  const vtkIdType* pts = nullptr;
+  vtkIdType i = 0;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); ++i)
+  {
+    if (npts > 256)
+    {
+      ++numSkipped;
+      continue;
+    }
+    writer.Put(static_cast<unsigned char>(npts));
+    for (vtkIdType j = 0; j < npts; ++j)
+    {
+      writer.Put(static_cast<int>(pts[j]));
+    }
+    for (int c = 0; c < numColorComps; ++c)
+    {
+      writer.Put(colors->GetValue(numColorComps * i + c));
+    }
+    writer.EndElement();
+  }
+  return numSkipped;
+}
+}
+
 void vtkPLYWriter::WriteData()
 {
   vtkIdType i, j, idx;
@@ -216,6 +329,18 @@ void vtkPLYWriter::WriteData()
   // complete the header
   vtkPLY::ply_header_complete(ply);
 
+  if (this->FileType == VTK_BINARY)
+  {
+    // write the elements by chunks
+    ::writeBinaryVertices(ply, inPts, pointNormals, pointColors, textureCoords);
+    if (::writeBinaryFaces(ply, polys, cellColors) > 0)
+    {
+      vtkErrorMacro(<< "Ply file only supports polygons with <256 points");
+    }
+    vtkPLY::ply_close(ply);
+    return;
+  }
+
   // set up and write the vertex elements
   plyVertex vert;
   vtkPLY::ply_put_element_setup(ply, "vertex");
@@ -0,0 +1,519 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPOpenFOAMReaderParallelProcessors.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Writes a decomposed case of hexahedra and polyhedra in ascii and binary
+// formats, and checks that reading the binary case with the processor
+// directories read concurrently gives the cells of the mesh and the same
+// data as reading the ascii case in order.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPOpenFOAMReader.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int NumberOfProcessors = 4;
+// Cells of a processor, more than are built at once by a thread
+const int NX = 8;
+const int NY = 24;
+const int NZ = 48;
+
+int PointId(int i, int j, int k)
+{
+  return i + (NX + 1) * (j + (NY + 1) * k);
+}
+
+int CellId(int i, int j, int k)
+{
+  return i + NX * (j + NY * k);
+}
+
+// The top faces of these cells are split in two triangles, which makes
+// them polyhedra.
+bool IsPolyhedron(int i, int j, int k)
+{
+  return k == NZ - 1 && (i + j) % 3 == 0;
+}
+
+struct Mesh
+{
+  std::vector<std::array<double, 3>> Points;
+  std::vector<std::vector<int>> Faces;
+  std::vector<int> Owner;
+  std::vector<int> Neighbour;
+  int NumberOfInternalFaces = 0;
+};
+
+// A block of NX x NY x NZ cells, shifted along x for each processor, with
+// its faces in the upper triangular order, all boundary faces in one patch.
+Mesh MakeMesh(int processor)
+{
+  Mesh mesh;
+  for (int k = 0; k <= NZ; ++k)
+  {
+    for (int j = 0; j <= NY; ++j)
+    {
+      for (int i = 0; i <= NX; ++i)
+      {
+        mesh.Points.push_back(
+          { { processor * NX + i + 0.013 * j + 0.0007 * k, j * 1.0 / 3, k * 0.7 } });
+      }
+    }
+  }
+
+  auto xFace = [](int i, int j, int k) {
+    return std::vector<int>{ PointId(i, j, k), PointId(i, j + 1, k), PointId(i, j + 1, k + 1),
+      PointId(i, j, k + 1) };
+  };
+  auto yFace = [](int i, int j, int k) {
+    return std::vector<int>{ PointId(i, j, k), PointId(i, j, k + 1), PointId(i + 1, j, k + 1),
+      PointId(i + 1, j, k) };
+  };
+  auto zFace = [](int i, int j, int k) {
+    return std::vector<int>{ PointId(i, j, k), PointId(i + 1, j, k), PointId(i + 1, j + 1, k),
+      PointId(i, j + 1, k) };
+  };
+  auto addFace = [&mesh](std::vector<int> face, bool flip, int owner, int neighbour) {
+    if (flip)
+    {
+      std::reverse(face.begin() + 1, face.end());
+    }
+    mesh.Faces.push_back(face);
+    mesh.Owner.push_back(owner);
+    if (neighbour >= 0)
+    {
+      mesh.Neighbour.push_back(neighbour);
+    }
+  };
+
+  for (int k = 0; k < NZ; ++k)
+  {
+    for (int j = 0; j < NY; ++j)
+    {
+      for (int i = 0; i < NX; ++i)
+      {
+        const int cell = CellId(i, j, k);
+        if (i + 1 < NX)
+        {
+          addFace(xFace(i + 1, j, k), false, cell, CellId(i + 1, j, k));
+        }
+        if (j + 1 < NY)
+        {
+          addFace(yFace(i, j + 1, k), false, cell, CellId(i, j + 1, k));
+        }
+        if (k + 1 < NZ)
+        {
+          addFace(zFace(i, j, k + 1), false, cell, CellId(i, j, k + 1));
+        }
+      }
+    }
+  }
+  mesh.NumberOfInternalFaces = static_cast<int>(mesh.Faces.size());
+
+  for (int k = 0; k < NZ; ++k)
+  {
+    for (int j = 0; j < NY; ++j)
+    {
+      for (int i = 0; i < NX; ++i)
+      {
+        const int cell = CellId(i, j, k);
+        if (i == 0)
+        {
+          addFace(xFace(0, j, k), true, cell, -1);
+        }
+        if (i == NX - 1)
+        {
+          addFace(xFace(NX, j, k), false, cell, -1);
+        }
+        if (j == 0)
+        {
+          addFace(yFace(i, 0, k), true, cell, -1);
+        }
+        if (j == NY - 1)
+        {
+          addFace(yFace(i, NY, k), false, cell, -1);
+        }
+        if (k == 0)
+        {
+          addFace(zFace(i, j, 0), true, cell, -1);
+        }
+        if (IsPolyhedron(i, j, k))
+        {
+          const std::vector<int> face = zFace(i, j, NZ);
+          addFace({ face[0], face[1], face[2] }, false, cell, -1);
+          addFace({ face[0], face[2], face[3] }, false, cell, -1);
+        }
+        else if (k == NZ - 1)
+        {
+          addFace(zFace(i, j, NZ), false, cell, -1);
+        }
+      }
+    }
+  }
+  return mesh;
+}
+
+void WriteHeader(std::ostream& os, bool binary, const char* className, const char* object)
+{
+  os << "FoamFile\n{\n    version     2.0;\n    format      " << (binary ? "binary" : "ascii")
+     << ";\n    arch        \"LSB;label=32;scalar=64\";\n    class       " << className
+     << ";\n    object      " << object << ";\n}\n\n";
+}
+
+template <typename T>
+void WriteBinary(std::ostream& os, const std::vector<T>& values)
+{
+  os << values.size() << "\n(";
+  os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+  os << ")\n";
+}
+
+void WriteLabels(std::ostream& os, bool binary, const std::vector<int32_t>& labels)
+{
+  if (binary)
+  {
+    WriteBinary(os, labels);
+    return;
+  }
+  os << labels.size() << "\n(\n";
+  for (int32_t label : labels)
+  {
+    os << label << '\n';
+  }
+  os << ")\n";
+}
+
+// Scalars, vectors or symmetric tensors
+void WriteValues(std::ostream& os, bool binary, const std::vector<double>& values, int nComponents)
+{
+  if (binary)
+  {
+    os << values.size() / nComponents << "\n(";
+    os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+    os << ")\n";
+    return;
+  }
+  os << values.size() / nComponents << "\n(\n" << std::setprecision(17);
+  for (size_t i = 0; i < values.size(); i += nComponents)
+  {
+    if (nComponents == 1)
+    {
+      os << values[i] << '\n';
+      continue;
+    }
+    os << '(';
+    for (int c = 0; c < nComponents; ++c)
+    {
+      os << (c ? " " : "") << values[i + c];
+    }
+    os << ")\n";
+  }
+  os << ")\n";
+}
+
+void WriteField(const std::string& fileName, bool binary, const char* className, const char* name,
+  const char* typeName, const std::vector<double>& values, int nComponents)
+{
+  std::ofstream os(fileName.c_str(), std::ios::binary);
+  WriteHeader(os, binary, className, name);
+  os << "dimensions      [0 1 -1 0 0 0 0];\n\ninternalField   nonuniform List<" << typeName
+     << "> ";
+  WriteValues(os, binary, values, nComponents);
+  os << ";\n\nboundaryField\n{\n    walls\n    {\n        type zeroGradient;\n    }\n}\n";
+}
+
+bool WriteCase(const std::string& casePath, bool binary)
+{
+  vtksys::SystemTools::MakeDirectory(casePath + "/system");
+  {
+    std::ofstream os((casePath + "/case.foam").c_str());
+  }
+  {
+    std::ofstream os((casePath + "/system/controlDict").c_str());
+    WriteHeader(os, false, "dictionary", "controlDict");
+    os << "application test;\nstartTime 0;\nendTime 1;\ndeltaT 1;\nwriteControl timeStep;\n"
+          "writeInterval 1;\n";
+  }
+
+  for (int processor = 0; processor < NumberOfProcessors; ++processor)
+  {
+    const std::string processorPath = casePath + "/processor" + std::to_string(processor);
+    const std::string meshPath = processorPath + "/constant/polyMesh/";
+    if (!vtksys::SystemTools::MakeDirectory(meshPath) ||
+      !vtksys::SystemTools::MakeDirectory(processorPath + "/0"))
+    {
+      std::cerr << "Cannot create " << processorPath << std::endl;
+      return false;
+    }
+    const Mesh mesh = MakeMesh(processor);
+
+    std::ofstream points((meshPath + "points").c_str(), std::ios::binary);
+    WriteHeader(points, binary, "vectorField", "points");
+    std::vector<double> coordinates;
+    for (const auto& point : mesh.Points)
+    {
+      coordinates.insert(coordinates.end(), point.begin(), point.end());
+    }
+    WriteValues(points, binary, coordinates, 3);
+
+    std::ofstream faces((meshPath + "faces").c_str(), std::ios::binary);
+    WriteHeader(faces, binary, binary ? "faceCompactList" : "faceList", "faces");
+    if (binary)
+    {
+      std::vector<int32_t> offsets(1, 0);
+      std::vector<int32_t> labels;
+      for (const auto& face : mesh.Faces)
+      {
+        labels.insert(labels.end(), face.begin(), face.end());
+        offsets.push_back(static_cast<int32_t>(labels.size()));
+      }
+      WriteBinary(faces, offsets);
+      WriteBinary(faces, labels);
+    }
+    else
+    {
+      faces << mesh.Faces.size() << "\n(\n";
+      for (const auto& face : mesh.Faces)
+      {
+        faces << face.size() << '(';
+        for (size_t fp = 0; fp < face.size(); ++fp)
+        {
+          faces << (fp ? " " : "") << face[fp];
+        }
+        faces << ")\n";
+      }
+      faces << ")\n";
+    }
+
+    std::ofstream owner((meshPath + "owner").c_str(), std::ios::binary);
+    WriteHeader(owner, binary, "labelList", "owner");
+    WriteLabels(owner, binary, std::vector<int32_t>(mesh.Owner.begin(), mesh.Owner.end()));
+    std::ofstream neighbour((meshPath + "neighbour").c_str(), std::ios::binary);
+    WriteHeader(neighbour, binary, "labelList", "neighbour");
+    WriteLabels(
+      neighbour, binary, std::vector<int32_t>(mesh.Neighbour.begin(), mesh.Neighbour.end()));
+
+    std::ofstream boundary((meshPath + "boundary").c_str());
+    WriteHeader(boundary, false, "polyBoundaryMesh", "boundary");
+    boundary << "1\n(\n    walls\n    {\n        type wall;\n        nFaces "
+             << mesh.Faces.size() - mesh.NumberOfInternalFaces << ";\n        startFace "
+             << mesh.NumberOfInternalFaces << ";\n    }\n)\n";
+
+    std::vector<double> p, U, sigma;
+    for (int cell = 0; cell < NX * NY * NZ; ++cell)
+    {
+      const double value = processor * 1e4 + cell / 7.0;
+      p.push_back(value);
+      const double vector[3] = { value, -value / 3, value * 1e-3 };
+      U.insert(U.end(), vector, vector + 3);
+      const double tensor[6] = { 1, value, 2, 3, -value, 4 };
+      sigma.insert(sigma.end(), tensor, tensor + 6);
+    }
+    const std::string timePath = processorPath + "/0/";
+    WriteField(timePath + "p", binary, "volScalarField", "p", "scalar", p, 1);
+    WriteField(timePath + "U", binary, "volVectorField", "U", "vector", U, 3);
+    WriteField(timePath + "sigma", binary, "volSymmTensorField", "sigma", "symmTensor", sigma, 6);
+  }
+  return true;
+}
+
+vtkUnstructuredGrid* GetInternalMesh(vtkPOpenFOAMReader* reader)
+{
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(reader->GetOutput()->NewIterator());
+  iter->InitTraversal();
+  return iter->IsDoneWithTraversal()
+    ? nullptr
+    : vtkUnstructuredGrid::SafeDownCast(iter->GetCurrentDataObject());
+}
+
+// Checks the cells against the generated mesh, regardless of the point order
+bool CheckCells(vtkUnstructuredGrid* grid)
+{
+  const vtkIdType nCells = NumberOfProcessors * NX * NY * NZ;
+  if (!grid || grid->GetNumberOfCells() != nCells)
+  {
+    std::cerr << "Wrong number of cells." << std::endl;
+    return false;
+  }
+  std::vector<Mesh> meshes;
+  for (int processor = 0; processor < NumberOfProcessors; ++processor)
+  {
+    meshes.push_back(MakeMesh(processor));
+  }
+  vtkNew<vtkIdList> pointIds;
+  for (vtkIdType cellId = 0; cellId < nCells; ++cellId)
+  {
+    const int processor = static_cast<int>(cellId / (NX * NY * NZ));
+    const int cell = static_cast<int>(cellId % (NX * NY * NZ));
+    const int i = cell % NX;
+    const int j = (cell / NX) % NY;
+    const int k = cell / (NX * NY);
+    const Mesh& mesh = meshes[processor];
+    std::vector<std::array<double, 3>> expected;
+    for (int corner = 0; corner < 8; ++corner)
+    {
+      const auto& point =
+        mesh.Points[PointId(i + (corner & 1), j + ((corner >> 1) & 1), k + (corner >> 2))];
+      expected.push_back(point);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    grid->GetCellPoints(cellId, pointIds);
+    std::vector<std::array<double, 3>> points(pointIds->GetNumberOfIds());
+    for (vtkIdType p = 0; p < pointIds->GetNumberOfIds(); ++p)
+    {
+      grid->GetPoint(pointIds->GetId(p), points[p].data());
+    }
+    std::sort(points.begin(), points.end());
+
+    // The points are stored in single precision
+    bool samePoints = points.size() == expected.size();
+    for (size_t p = 0; samePoints && p < points.size(); ++p)
+    {
+      for (int c = 0; c < 3; ++c)
+      {
+        samePoints &= std::abs(points[p][c] - expected[p][c]) < 1e-5;
+      }
+    }
+    const int expectedType = IsPolyhedron(i, j, k) ? VTK_POLYHEDRON : VTK_HEXAHEDRON;
+    if (grid->GetCellType(cellId) != expectedType || !samePoints)
+    {
+      std::cerr << "Wrong cell " << cellId << std::endl;
+      return false;
+    }
+    if (expectedType == VTK_POLYHEDRON)
+    {
+      vtkIdType nFaces;
+      const vtkIdType* faces;
+      grid->GetFaceStream(cellId, nFaces, faces);
+      if (nFaces != 7)
+      {
+        std::cerr << "Wrong faces of polyhedron " << cellId << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool Compare(vtkUnstructuredGrid* expected, vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkIdList> expectedIds;
+  vtkNew<vtkIdList> ids;
+  if (!grid || grid->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    grid->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    std::cerr << "Wrong mesh size." << std::endl;
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    expected->GetCellPoints(cellId, expectedIds);
+    grid->GetCellPoints(cellId, ids);
+    bool same = expected->GetCellType(cellId) == grid->GetCellType(cellId) &&
+      expectedIds->GetNumberOfIds() == ids->GetNumberOfIds();
+    for (vtkIdType p = 0; same && p < ids->GetNumberOfIds(); ++p)
+    {
+      same = expectedIds->GetId(p) == ids->GetId(p);
+    }
+    if (!same)
+    {
+      std::cerr << "Different cell " << cellId << std::endl;
+      return false;
+    }
+  }
+  vtkDataArray* arrays[4] = { grid->GetPoints()->GetData(), grid->GetCellData()->GetArray("p"),
+    grid->GetCellData()->GetArray("U"), grid->GetCellData()->GetArray("sigma") };
+  vtkDataArray* expectedArrays[4] = { expected->GetPoints()->GetData(),
+    expected->GetCellData()->GetArray("p"), expected->GetCellData()->GetArray("U"),
+    expected->GetCellData()->GetArray("sigma") };
+  for (int a = 0; a < 4; ++a)
+  {
+    if (!arrays[a] || !expectedArrays[a] ||
+      arrays[a]->GetNumberOfValues() != expectedArrays[a]->GetNumberOfValues())
+    {
+      std::cerr << "Missing or wrong sized array " << a << std::endl;
+      return false;
+    }
+    const int nComponents = arrays[a]->GetNumberOfComponents();
+    for (vtkIdType i = 0; i < arrays[a]->GetNumberOfValues(); ++i)
+    {
+      if (arrays[a]->GetComponent(i / nComponents, i % nComponents) !=
+        expectedArrays[a]->GetComponent(i / nComponents, i % nComponents))
+      {
+        std::cerr << "Different value " << i << " in array " << a << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPOpenFOAMReaderParallelProcessors(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string casePath = std::string(tempDir) + "/TestPOpenFOAMReaderParallelProcessors";
+  delete[] tempDir;
+  if (!WriteCase(casePath + "-ascii", false) || !WriteCase(casePath + "-binary", true))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPOpenFOAMReader> asciiReader;
+  asciiReader->SetCaseType(vtkPOpenFOAMReader::DECOMPOSED_CASE);
+  asciiReader->SetFileName((casePath + "-ascii/case.foam").c_str());
+  asciiReader->Update();
+  vtkUnstructuredGrid* expected = GetInternalMesh(asciiReader);
+  if (!CheckCells(expected))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPOpenFOAMReader> binaryReader;
+  binaryReader->SetCaseType(vtkPOpenFOAMReader::DECOMPOSED_CASE);
+  binaryReader->SetFileName((casePath + "-binary/case.foam").c_str());
+  binaryReader->ReadProcessorsInParallelOn();
+  vtkSMPTools::LocalScope(
+    vtkSMPTools::Config{ 4, "STDThread", false }, [&]() { binaryReader->Update(); });
+  if (!Compare(expected, GetInternalMesh(binaryReader)))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -74,6 +74,7 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -81,6 +82,7 @@
 
 #include <cctype>
 #include <cstring>
+#include <vector>
 
 //------------------------------------------------------------------------------
 
@@ -362,6 +364,7 @@ vtkPOpenFOAMReader::vtkPOpenFOAMReader()
   }
   this->CaseType = RECONSTRUCTED_CASE;
   this->MTimeOld = 0;
+  this->ReadProcessorsInParallel = false;
 }
 
 //------------------------------------------------------------------------------
@@ -379,6 +382,8 @@ void vtkPOpenFOAMReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number of Processes: " << this->NumProcesses << endl;
   os << indent << "Process Id: " << this->ProcessId << endl;
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "ReadProcessorsInParallel: " << (this->ReadProcessorsInParallel ? "On" : "Off")
+     << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -644,6 +649,7 @@ int vtkPOpenFOAMReader::RequestData(
     // append->AppendFieldDataOn();
 
     vtkOpenFOAMReader* reader;
+    std::vector<vtkOpenFOAMReader*> subReaders;
     this->Superclass::CurrentReaderIndex = 0;
     this->Superclass::Readers->InitTraversal();
     while ((reader = vtkOpenFOAMReader::SafeDownCast(
@@ -660,9 +666,23 @@ int vtkPOpenFOAMReader::RequestData(
       if (reader->MakeMetaDataAtTimeStep(false))
       {
         append->AddInputConnection(reader->GetOutputPort());
+        subReaders.push_back(reader);
       }
     }
 
+    if (this->ReadProcessorsInParallel && subReaders.size() > 1)
+    {
+      // The sub-readers only share read-only settings and selections while
+      // reading, so update them all at once; append finds them up to date.
+      vtkSMPTools::For(0, static_cast<vtkIdType>(subReaders.size()), 1,
+        [&subReaders](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType i = begin; i < end; ++i)
+          {
+            subReaders[i]->Update();
+          }
+        });
+    }
+
     this->GatherMetaData();
 
     if (append->GetNumberOfInputConnections(0) == 0)
@@ -65,6 +65,17 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   ///@}
 
+  ///@{
+  /**
+   * Read the processor directories assigned to this process concurrently,
+   * using vtkSMPTools, instead of one after the other. Progress is not
+   * reported while they are read. Default is false.
+   */
+  vtkSetMacro(ReadProcessorsInParallel, bool);
+  vtkGetMacro(ReadProcessorsInParallel, bool);
+  vtkBooleanMacro(ReadProcessorsInParallel, bool);
+  ///@}
+
 protected:
   vtkPOpenFOAMReader();
   ~vtkPOpenFOAMReader() override;
@@ -78,6 +89,7 @@ private:
   vtkMTimeType MTimeOld;
   int NumProcesses;
   int ProcessId;
+  bool ReadProcessorsInParallel;
 
   vtkPOpenFOAMReader(const vtkPOpenFOAMReader&) = delete;
   void operator=(const vtkPOpenFOAMReader&) = delete;
@@ -0,0 +1,237 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPExodusIIReaderParallelFiles.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Writes a decomposed .e.N.M file set, and checks that reading its files
+// concurrently gives the same data as reading them in order, and that the
+// variables of the next time step prefetched in the background are found in
+// the cache.
+
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDummyController.h"
+#include "vtkExodusIIReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPExodusIIReader.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include "vtk_exodusII.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int NumberOfFiles = 4;
+const int NumberOfSteps = 3;
+const int CellsPerFile = 2000;
+
+// A row of hexahedra along x, shifted for each file.
+bool WriteFile(const std::string& fileName, int file)
+{
+  int cpuWordSize = 8;
+  int ioWordSize = 8;
+  int exoid = ex_create(fileName.c_str(), EX_CLOBBER, &cpuWordSize, &ioWordSize);
+  if (exoid < 0)
+  {
+    std::cerr << "Cannot create " << fileName << std::endl;
+    return false;
+  }
+
+  const int numberOfNodes = 4 * (CellsPerFile + 1);
+  std::vector<double> x(numberOfNodes), y(numberOfNodes), z(numberOfNodes);
+  for (int i = 0; i <= CellsPerFile; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      x[4 * i + j] = file * CellsPerFile + i;
+      y[4 * i + j] = (j == 1 || j == 2) ? 1 : 0;
+      z[4 * i + j] = j >= 2 ? 1 : 0;
+    }
+  }
+  std::vector<int> connectivity;
+  for (int i = 0; i < CellsPerFile; ++i)
+  {
+    const int hexahedron[8] = { 4 * i + 1, 4 * i + 5, 4 * i + 6, 4 * i + 2, 4 * i + 4, 4 * i + 8,
+      4 * i + 7, 4 * i + 3 };
+    connectivity.insert(connectivity.end(), hexahedron, hexahedron + 8);
+  }
+
+  bool success =
+    ex_put_init(exoid, "parallel files", 3, numberOfNodes, CellsPerFile, 1, 0, 0) >= 0 &&
+    ex_put_coord(exoid, x.data(), y.data(), z.data()) >= 0 &&
+    ex_put_block(exoid, EX_ELEM_BLOCK, 1, "HEX8", CellsPerFile, 8, 0, 0, 0) >= 0 &&
+    ex_put_conn(exoid, EX_ELEM_BLOCK, 1, connectivity.data(), nullptr, nullptr) >= 0 &&
+    ex_put_variable_param(exoid, EX_NODAL, 1) >= 0 &&
+    ex_put_variable_name(exoid, EX_NODAL, 1, "temperature") >= 0 &&
+    ex_put_variable_param(exoid, EX_ELEM_BLOCK, 1) >= 0 &&
+    ex_put_variable_name(exoid, EX_ELEM_BLOCK, 1, "stress") >= 0;
+  for (int step = 0; success && step < NumberOfSteps; ++step)
+  {
+    double time = step * 0.5;
+    std::vector<double> temperature(numberOfNodes), stress(CellsPerFile);
+    for (int i = 0; i < numberOfNodes; ++i)
+    {
+      temperature[i] = x[i] + time;
+    }
+    for (int i = 0; i < CellsPerFile; ++i)
+    {
+      stress[i] = file * 1000 + i * 0.25 + step;
+    }
+    success = ex_put_time(exoid, step + 1, &time) >= 0 &&
+      ex_put_var(exoid, step + 1, EX_NODAL, 1, 0, numberOfNodes, temperature.data()) >= 0 &&
+      ex_put_var(exoid, step + 1, EX_ELEM_BLOCK, 1, 1, CellsPerFile, stress.data()) >= 0;
+  }
+  ex_close(exoid);
+  if (!success)
+  {
+    std::cerr << "Cannot write " << fileName << std::endl;
+  }
+  return success;
+}
+
+bool CompareArrays(vtkDataArray* expected, vtkDataArray* array, const char* name)
+{
+  if (!expected || !array || expected->GetNumberOfValues() != array->GetNumberOfValues())
+  {
+    std::cerr << "Missing or wrong sized array " << name << std::endl;
+    return false;
+  }
+  const int numberOfComponents = array->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < array->GetNumberOfValues(); ++i)
+  {
+    if (expected->GetComponent(i / numberOfComponents, i % numberOfComponents) !=
+      array->GetComponent(i / numberOfComponents, i % numberOfComponents))
+    {
+      std::cerr << "Wrong value " << i << " in " << name << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Compare(vtkMultiBlockDataSet* expected, vtkMultiBlockDataSet* output)
+{
+  vtkSmartPointer<vtkCompositeDataIterator> expectedIter;
+  expectedIter.TakeReference(expected->NewIterator());
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(output->NewIterator());
+  int numberOfLeaves = 0;
+  for (expectedIter->InitTraversal(), iter->InitTraversal(); !expectedIter->IsDoneWithTraversal();
+       expectedIter->GoToNextItem(), iter->GoToNextItem(), ++numberOfLeaves)
+  {
+    vtkDataSet* expectedLeaf = vtkDataSet::SafeDownCast(expectedIter->GetCurrentDataObject());
+    vtkDataSet* leaf = iter->IsDoneWithTraversal()
+      ? nullptr
+      : vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (!leaf || leaf->GetNumberOfPoints() != expectedLeaf->GetNumberOfPoints() ||
+      leaf->GetNumberOfCells() != expectedLeaf->GetNumberOfCells())
+    {
+      std::cerr << "Wrong block " << numberOfLeaves << std::endl;
+      return false;
+    }
+    if (!CompareArrays(expectedLeaf->GetPointData()->GetArray("temperature"),
+          leaf->GetPointData()->GetArray("temperature"), "temperature") ||
+      !CompareArrays(expectedLeaf->GetCellData()->GetArray("stress"),
+        leaf->GetCellData()->GetArray("stress"), "stress"))
+    {
+      return false;
+    }
+  }
+  if (numberOfLeaves == 0 || !iter->IsDoneWithTraversal())
+  {
+    std::cerr << "Wrong number of blocks." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void Configure(vtkPExodusIIReader* reader, vtkMultiProcessController* controller,
+  const std::vector<std::string>& fileNames)
+{
+  reader->SetController(controller);
+  std::vector<const char*> names;
+  for (const std::string& fileName : fileNames)
+  {
+    names.push_back(fileName.c_str());
+  }
+  reader->SetFileNames(static_cast<int>(names.size()), names.data());
+  reader->UpdateInformation();
+  reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+}
+}
+
+int TestPExodusIIReaderParallelFiles(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestPExodusIIReaderParallelFiles.e." +
+    std::to_string(NumberOfFiles) + ".";
+  delete[] tempDir;
+
+  std::vector<std::string> fileNames;
+  for (int file = 0; file < NumberOfFiles; ++file)
+  {
+    fileNames.push_back(prefix + std::to_string(file));
+    if (!WriteFile(fileNames.back(), file))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtkNew<vtkDummyController> controller;
+  vtkNew<vtkPExodusIIReader> sequentialReader;
+  Configure(sequentialReader, controller, fileNames);
+  vtkNew<vtkPExodusIIReader> parallelReader;
+  Configure(parallelReader, controller, fileNames);
+  parallelReader->ReadFilesInParallelOn();
+  parallelReader->PrefetchNextTimeStepOn();
+
+  bool success = true;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4, "STDThread", false }, [&]() {
+    for (int step = 0; success && step < NumberOfSteps; ++step)
+    {
+      const double time = step * 0.5;
+      sequentialReader->ResetCacheStatistics();
+      sequentialReader->UpdateTimeStep(time);
+      parallelReader->ResetCacheStatistics();
+      parallelReader->UpdateTimeStep(time);
+      std::cout << "step " << step << ": " << sequentialReader->GetNumberOfCacheMisses()
+                << " misses in order, " << parallelReader->GetNumberOfCacheMisses()
+                << " misses and " << parallelReader->GetNumberOfCacheHits()
+                << " hits in parallel with prefetching" << std::endl;
+      success = Compare(sequentialReader->GetOutput(), parallelReader->GetOutput());
+
+#ifdef EXODUS_THREADSAFE
+      // The variables of the steps after the first are prefetched.
+      if (success && step > 0 &&
+        parallelReader->GetNumberOfCacheMisses() >= sequentialReader->GetNumberOfCacheMisses())
+      {
+        std::cerr << "The variables of step " << step << " were not prefetched." << std::endl;
+        success = false;
+      }
+#endif
+    }
+  });
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
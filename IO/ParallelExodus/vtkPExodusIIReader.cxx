@@ -34,6 +34,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGrid.h"
@@ -89,7 +90,9 @@ protected:
 
   void Execute(vtkObject*, unsigned long event, void* callData) override
   {
-    if (event == vtkCommand::ProgressEvent)
+    // The readers of the files read concurrently cannot report their
+    // progress from the worker threads.
+    if (event == vtkCommand::ProgressEvent && !vtkSMPTools::IsParallelScope())
     {
       double num = Reader->GetNumberOfFileNames();
       if (num <= 1)
@@ -131,6 +134,7 @@ vtkPExodusIIReader::vtkPExodusIIReader()
   this->XMLFileName = nullptr;
   this->LastCommonTimeStep = -1;
   this->VariableCacheSize = 100;
+  this->ReadFilesInParallel = false;
 }
 
 //------------------------------------------------------------------------------
@@ -453,6 +457,12 @@ int vtkPExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
     fractionalCacheSize = this->VariableCacheSize / static_cast<int>(this->ReaderList.size());
   }
 
+#ifdef EXODUS_THREADSAFE
+  bool readInParallel = this->ReadFilesInParallel && this->ReaderList.size() > 1;
+#else
+  bool readInParallel = false;
+#endif
+
   // This constructs the filenames
   for (fileIndex = min, reader_idx = 0; fileIndex <= max; ++fileIndex, ++reader_idx)
   {
@@ -604,6 +614,15 @@ int vtkPExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
       }
     }
 
+    this->ReaderList[reader_idx]->SetPrefetchNextTimeStep(this->GetPrefetchNextTimeStep());
+
+    if (readInParallel)
+    {
+      // the readers read at the same time, each uses its part of the cache
+      this->ReaderList[reader_idx]->SetCacheSize(fractionalCacheSize);
+      continue;
+    }
+
     // set this reader to use the full amount of the cache
     this->ReaderList[reader_idx]->SetCacheSize(this->VariableCacheSize);
 
@@ -657,6 +676,23 @@ int vtkPExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
 #endif // 0
   }
 
+  if (readInParallel)
+  {
+    std::vector<vtkExodusIIReader*>& readers = this->ReaderList;
+    vtkSMPTools::For(
+      0, static_cast<vtkIdType>(readers.size()), [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          readers[i]->Update();
+        }
+      });
+    for (vtkExodusIIReader* reader : readers)
+    {
+      append->AddInputConnection(reader->GetOutputPort());
+    }
+    this->UpdateProgress(1.0);
+  }
+
   // Append complains/barfs if you update it without any inputs
   if (append->GetNumberOfInputConnections(0) != 0)
   {
@@ -932,6 +968,38 @@ void vtkPExodusIIReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NumberOfFiles: " << this->NumberOfFiles << endl;
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "VariableCacheSize: " << this->VariableCacheSize << endl;
+  os << indent << "ReadFilesInParallel: " << (this->ReadFilesInParallel ? "On" : "Off") << endl;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPExodusIIReader::GetNumberOfCacheHits()
+{
+  vtkIdType total = 0;
+  for (vtkExodusIIReader* reader : this->ReaderList)
+  {
+    total += reader->GetNumberOfCacheHits();
+  }
+  return total;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPExodusIIReader::GetNumberOfCacheMisses()
+{
+  vtkIdType total = 0;
+  for (vtkExodusIIReader* reader : this->ReaderList)
+  {
+    total += reader->GetNumberOfCacheMisses();
+  }
+  return total;
+}
+
+//------------------------------------------------------------------------------
+void vtkPExodusIIReader::ResetCacheStatistics()
+{
+  for (vtkExodusIIReader* reader : this->ReaderList)
+  {
+    reader->ResetCacheStatistics();
+  }
 }
 
 vtkIdType vtkPExodusIIReader::GetTotalNumberOfElements()
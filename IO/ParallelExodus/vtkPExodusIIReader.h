@@ -141,6 +141,32 @@ public:
   vtkSetMacro(VariableCacheSize, double);
   ///@}
 
+  ///@{
+  /**
+   * Read the files of this process concurrently, using vtkSMPTools, instead
+   * of one after the other. VariableCacheSize is then split evenly between
+   * the file readers of this reader. It is not a budget shared with other
+   * reader instances. The exodus library serializes its calls, so the gain
+   * comes from the per-file processing of the arrays read, which runs
+   * concurrently. Ignored, and the files read in order, when the exodus
+   * library is not thread safe. Progress is not reported while the files
+   * are read concurrently.
+   * The Default for this is false.
+   */
+  vtkGetMacro(ReadFilesInParallel, bool);
+  vtkSetMacro(ReadFilesInParallel, bool);
+  vtkBooleanMacro(ReadFilesInParallel, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Sum the cache statistics of the file readers, or reset them.
+   */
+  vtkIdType GetNumberOfCacheHits() override;
+  vtkIdType GetNumberOfCacheMisses() override;
+  void ResetCacheStatistics() override;
+  ///@}
+
 protected:
   vtkPExodusIIReader();
   ~vtkPExodusIIReader() override;
@@ -156,6 +182,8 @@ protected:
   // holds the size of the variable cache in GigaBytes
   double VariableCacheSize;
 
+  bool ReadFilesInParallel;
+
   // **KEN** Previous discussions concluded with std classes in header
   // files is bad.  Perhaps we should change ReaderList.
 
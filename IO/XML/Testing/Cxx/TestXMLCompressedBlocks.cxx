@@ -0,0 +1,170 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompressedBlocks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that compressing and decompressing the blocks of the XML files
+// concurrently gives the same file and the same data as doing it on one
+// thread, for each compressor, data mode and header type, and that the zstd
+// dictionaries are stored in the file and used to read it back.
+
+#include "vtkDoubleArray.h"
+#include "vtkIOCoreConfigure.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int Dimension = 20;
+
+std::string WriteImage(vtkImageData* image, int compressorType, int dataMode, int headerType,
+  bool trainDictionaries = false)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->WriteToOutputStringOn();
+  writer->SetCompressorType(compressorType);
+#ifdef VTK_USE_ZSTD
+  if (trainDictionaries)
+  {
+    vtkZstdDataCompressor::SafeDownCast(writer->GetCompressor())->TrainDictionariesOn();
+  }
+#else
+  (void)trainDictionaries;
+#endif
+  writer->SetDataMode(dataMode);
+  writer->SetHeaderType(headerType);
+  // Small blocks to have many of them.
+  writer->SetBlockSize(1000);
+  writer->Write();
+  return writer->GetOutputString();
+}
+
+bool CheckImage(const std::string& content, vtkImageData* expected)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content);
+  reader->Update();
+  vtkImageData* image = reader->GetOutput();
+  for (int i = 0; i < expected->GetPointData()->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* expectedArray = expected->GetPointData()->GetArray(i);
+    vtkDataArray* array = image->GetPointData()->GetArray(expectedArray->GetName());
+    if (!array || array->GetNumberOfTuples() != expectedArray->GetNumberOfTuples() ||
+      array->GetNumberOfComponents() != expectedArray->GetNumberOfComponents())
+    {
+      std::cerr << "Wrong array " << expectedArray->GetName() << std::endl;
+      return false;
+    }
+    for (vtkIdType j = 0; j < array->GetNumberOfValues(); ++j)
+    {
+      if (array->GetComponent(j / array->GetNumberOfComponents(),
+            static_cast<int>(j % array->GetNumberOfComponents())) !=
+        expectedArray->GetComponent(j / expectedArray->GetNumberOfComponents(),
+          static_cast<int>(j % expectedArray->GetNumberOfComponents())))
+      {
+        std::cerr << "Wrong value " << j << " in array " << expectedArray->GetName() << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLCompressedBlocks(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dimension, Dimension, Dimension);
+  vtkIdType numberOfPoints = image->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("Labels");
+  labels->SetNumberOfTuples(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    vectors->SetTuple3(i, i * 0.25, (i % 17) * 1.5, -i);
+    labels->SetValue(i, static_cast<int>(i / 100));
+  }
+  image->GetPointData()->AddArray(vectors);
+  image->GetPointData()->AddArray(labels);
+
+  std::vector<int> compressorTypes = { vtkXMLImageDataWriter::ZLIB, vtkXMLImageDataWriter::LZ4,
+    vtkXMLImageDataWriter::LZMA };
+#ifdef VTK_USE_ZSTD
+  compressorTypes.push_back(vtkXMLImageDataWriter::ZSTD);
+#endif
+  const int dataModes[] = { vtkXMLImageDataWriter::Binary, vtkXMLImageDataWriter::Appended };
+  const int headerTypes[] = { vtkXMLImageDataWriter::UInt32, vtkXMLImageDataWriter::UInt64 };
+  for (int compressorType : compressorTypes)
+  {
+    for (int dataMode : dataModes)
+    {
+      for (int headerType : headerTypes)
+      {
+        std::string sequential;
+        bool sequentialRead = false;
+        vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1, "Sequential", false }, [&]() {
+          sequential = WriteImage(image, compressorType, dataMode, headerType);
+          sequentialRead = CheckImage(sequential, image);
+        });
+        std::string threaded;
+        bool threadedRead = false;
+        vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4, "STDThread", false }, [&]() {
+          threaded = WriteImage(image, compressorType, dataMode, headerType);
+          threadedRead = CheckImage(threaded, image);
+        });
+        if (sequential.empty() || sequential != threaded || !sequentialRead || !threadedRead)
+        {
+          std::cerr << "Failed with compressor " << compressorType << ", data mode " << dataMode
+                    << " and header type " << headerType << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+#ifdef VTK_USE_ZSTD
+  // Both arrays have enough blocks to train a dictionary on, which the
+  // reader must use.
+  for (int dataMode : dataModes)
+  {
+    std::string content =
+      WriteImage(image, vtkXMLImageDataWriter::ZSTD, dataMode, vtkXMLImageDataWriter::UInt64, true);
+    size_t first = content.find("CompressionDictionary=");
+    if (first == std::string::npos ||
+      content.find("CompressionDictionary=", first + 1) == std::string::npos ||
+      !CheckImage(content, image))
+    {
+      std::cerr << "Failed with trained zstd dictionaries and data mode " << dataMode << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+#endif
+  return EXIT_SUCCESS;
+}
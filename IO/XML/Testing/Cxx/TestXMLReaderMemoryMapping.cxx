@@ -0,0 +1,174 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLReaderMemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkXMLReader::UseMemoryMapping reads raw appended arrays in
+// place and gives the same values as the regular reading.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+const int Dimension = 10;
+const vtkIdType NumberOfPoints = Dimension * Dimension * Dimension;
+
+bool WriteImage(const std::string& fileName, bool encodeAppendedData)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dimension, Dimension, Dimension);
+
+  vtkNew<vtkUnsignedCharArray> first;
+  first->SetName("First");
+  first->SetNumberOfValues(NumberOfPoints);
+  vtkNew<vtkUnsignedCharArray> second;
+  second->SetName("Second");
+  second->SetNumberOfValues(NumberOfPoints);
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfComponents(3);
+  values->SetNumberOfTuples(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    first->SetValue(i, static_cast<unsigned char>(i % 251));
+    second->SetValue(i, static_cast<unsigned char>(i % 13));
+    values->SetTuple3(i, i, 0.5 * i, -1.0 * i);
+  }
+  image->GetPointData()->AddArray(first);
+  image->GetPointData()->AddArray(second);
+  image->GetPointData()->AddArray(values);
+
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetFileName(fileName.c_str());
+  writer->SetInputData(image);
+  writer->SetDataModeToAppended();
+  writer->SetEncodeAppendedData(encodeAppendedData);
+  writer->SetCompressorTypeToNone();
+  writer->SetHeaderTypeToUInt32();
+  return writer->Write() == 1;
+}
+
+vtkSmartPointer<vtkImageData> ReadImage(const std::string& fileName, bool useMemoryMapping)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetUseMemoryMapping(useMemoryMapping);
+  reader->Update();
+  // The output outlives the reader so the mapping must stay valid.
+  return reader->GetOutput();
+}
+
+bool CheckValues(vtkImageData* image)
+{
+  vtkUnsignedCharArray* first =
+    vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetArray("First"));
+  vtkUnsignedCharArray* second =
+    vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetArray("Second"));
+  vtkDoubleArray* values = vtkDoubleArray::SafeDownCast(image->GetPointData()->GetArray("Values"));
+  if (!first || !second || !values || first->GetNumberOfValues() != NumberOfPoints ||
+    second->GetNumberOfValues() != NumberOfPoints || values->GetNumberOfTuples() != NumberOfPoints)
+  {
+    std::cerr << "Missing or wrong sized arrays." << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    double tuple[3];
+    values->GetTuple(i, tuple);
+    if (first->GetValue(i) != i % 251 || second->GetValue(i) != i % 13 || tuple[0] != i ||
+      tuple[1] != 0.5 * i || tuple[2] != -1.0 * i)
+    {
+      std::cerr << "Wrong values at point " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The arrays read in place keep the layout of the appended data: the second
+// array starts after the first one and the header of its own block.
+bool IsMapped(vtkImageData* image)
+{
+  vtkUnsignedCharArray* first =
+    vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetArray("First"));
+  vtkUnsignedCharArray* second =
+    vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetArray("Second"));
+  return second->GetPointer(0) - first->GetPointer(0) == NumberOfPoints + 4;
+}
+}
+
+int TestXMLReaderMemoryMapping(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string rawFileName = std::string(tempDir) + "/TestXMLReaderMemoryMappingRaw.vti";
+  std::string encodedFileName = std::string(tempDir) + "/TestXMLReaderMemoryMappingEncoded.vti";
+  delete[] tempDir;
+
+  if (!WriteImage(rawFileName, false) || !WriteImage(encodedFileName, true))
+  {
+    std::cerr << "Cannot write the test files." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkImageData> copied = ReadImage(rawFileName, false);
+  if (!CheckValues(copied) || IsMapped(copied))
+  {
+    std::cerr << "Wrong image read without memory mapping." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkImageData> mapped = ReadImage(rawFileName, true);
+  if (!CheckValues(mapped) || !IsMapped(mapped))
+  {
+    std::cerr << "Wrong image read with memory mapping." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modifying a mapped array must not change the file.
+  vtkUnsignedCharArray::SafeDownCast(mapped->GetPointData()->GetArray("First"))->SetValue(0, 42);
+  if (!CheckValues(ReadImage(rawFileName, true)))
+  {
+    std::cerr << "Modifying a mapped array changed the file." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Resizing a mapped array copies it out of the mapping.
+  vtkDoubleArray* values = vtkDoubleArray::SafeDownCast(mapped->GetPointData()->GetArray("Values"));
+  values->InsertNextTuple3(0, 0, 0);
+  if (values->GetNumberOfTuples() != NumberOfPoints + 1 || values->GetComponent(1, 1) != 0.5)
+  {
+    std::cerr << "Wrong values after resizing a mapped array." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Base64 appended data cannot be used in place and is read as usual.
+  vtkSmartPointer<vtkImageData> encoded = ReadImage(encodedFileName, true);
+  if (!CheckValues(encoded) || IsMapped(encoded))
+  {
+    std::cerr << "Wrong image read from encoded appended data." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -485,6 +485,7 @@ vtkDataObject* vtkXMLCompositeDataReader::ReadDataObject(
     return nullptr;
   }
   reader->SetFileName(fileName.c_str());
+  reader->SetUseMemoryMapping(this->UseMemoryMapping);
   reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
   reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
   reader->GetColumnArraySelection()->CopySelections(this->ColumnArraySelection);
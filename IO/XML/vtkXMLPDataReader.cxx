@@ -303,6 +303,7 @@ int vtkXMLPDataReader::ReadPiece(vtkXMLDataElement* ePiece)
   this->PieceReaders[this->Piece]->AddObserver(
     vtkCommand::ProgressEvent, this->PieceProgressObserver);
   reader->SetFileName(pieceFileName);
+  reader->SetUseMemoryMapping(this->UseMemoryMapping);
 
   delete[] pieceFileName;
 
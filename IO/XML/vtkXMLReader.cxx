@@ -15,6 +15,7 @@
 #include "vtkXMLReader.h"
 
 #include "vtkArrayIteratorIncludes.h"
+#include "vtkBase64Utilities.h"
 #include "vtkBitArray.h"
 #include "vtkCallbackCommand.h"
 #include "vtkDataArray.h"
@@ -22,6 +23,7 @@
 #include "vtkDataCompressor.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkIOCoreConfigure.h" // For VTK_USE_ZSTD
 #include "vtkInformation.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationDoubleVectorKey.h"
@@ -46,6 +48,10 @@
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
 
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
+
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
 #include <vtksys/SystemTools.hxx>
@@ -53,12 +59,29 @@
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <limits>
 #include <locale> // C++ locale
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <vector>
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 vtkCxxSetObjectMacro(vtkXMLReader, ReaderErrorObserver, vtkCommand);
 vtkCxxSetObjectMacro(vtkXMLReader, ParserErrorObserver, vtkCommand);
 
@@ -131,6 +154,123 @@ static void ReadStringVersion(const char* version, int& major, int& minor)
     }
   }
 }
+//------------------------------------------------------------------------------
+// A private, copy-on-write memory mapping of a whole file.  It is shared by
+// the reader while reading and by the arrays that point into it.
+class vtkXMLReaderMappedFile
+{
+public:
+  static std::shared_ptr<vtkXMLReaderMappedFile> New(const char* fileName)
+  {
+    void* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    std::wstring wname = vtksys::Encoding::ToWindowsExtendedPath(fileName);
+    HANDLE file = CreateFileW(wname.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return nullptr;
+    }
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 &&
+      static_cast<vtkTypeUInt64>(fileSize.QuadPart) <= std::numeric_limits<size_t>::max())
+    {
+      HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+      if (mapping)
+      {
+        // The view keeps the mapping and the file open.
+        data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        size = static_cast<size_t>(fileSize.QuadPart);
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+      return nullptr;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0 &&
+      static_cast<vtkTypeUInt64>(fileStat.st_size) <= std::numeric_limits<size_t>::max())
+    {
+      size = static_cast<size_t>(fileStat.st_size);
+      data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED)
+      {
+        data = nullptr;
+      }
+    }
+    close(fd);
+#endif
+    if (!data)
+    {
+      return nullptr;
+    }
+    return std::shared_ptr<vtkXMLReaderMappedFile>(new vtkXMLReaderMappedFile(data, size));
+  }
+
+  ~vtkXMLReaderMappedFile()
+  {
+#if defined(_WIN32)
+    UnmapViewOfFile(this->Data);
+#else
+    munmap(this->Data, this->Size);
+#endif
+  }
+
+  unsigned char* GetData() const { return static_cast<unsigned char*>(this->Data); }
+  size_t GetSize() const { return this->Size; }
+
+private:
+  vtkXMLReaderMappedFile(void* data, size_t size)
+    : Data(data)
+    , Size(size)
+  {
+  }
+  vtkXMLReaderMappedFile(const vtkXMLReaderMappedFile&) = delete;
+  void operator=(const vtkXMLReaderMappedFile&) = delete;
+
+  void* Data;
+  size_t Size;
+};
+
+namespace
+{
+//------------------------------------------------------------------------------
+// The mappings used by the arrays, by array pointer.  The free function of an
+// array only gets its pointer, so it finds the mapping to release here.  The
+// map is never destroyed since arrays may be released after static
+// destruction.
+struct vtkXMLReaderMappedArrays
+{
+  std::mutex Mutex;
+  std::multimap<void*, std::shared_ptr<vtkXMLReaderMappedFile>> Files;
+
+  static vtkXMLReaderMappedArrays& GetInstance()
+  {
+    static vtkXMLReaderMappedArrays* instance = new vtkXMLReaderMappedArrays;
+    return *instance;
+  }
+};
+
+void vtkXMLReaderReleaseMappedArray(void* data)
+{
+  std::shared_ptr<vtkXMLReaderMappedFile> file;
+  vtkXMLReaderMappedArrays& arrays = vtkXMLReaderMappedArrays::GetInstance();
+  std::lock_guard<std::mutex> lock(arrays.Mutex);
+  auto it = arrays.Files.find(data);
+  if (it != arrays.Files.end())
+  {
+    // Unmap, if this is the last user, once the lock is released.
+    file = std::move(it->second);
+    arrays.Files.erase(it);
+  }
+}
+}
+
 //------------------------------------------------------------------------------
 vtkXMLReader::vtkXMLReader()
 {
@@ -140,6 +280,7 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = nullptr;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->UseMemoryMapping = 0;
   this->XMLParser = nullptr;
   this->ReaderErrorObserver = nullptr;
   this->ParserErrorObserver = nullptr;
@@ -227,6 +368,7 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PointDataArraySelection: " << this->PointDataArraySelection << "\n";
   os << indent << "ColumnArraySelection: " << this->PointDataArraySelection << "\n";
   os << indent << "TimeDataStringArray: " << this->TimeDataStringArray << "\n";
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << "\n";
   if (this->Stream)
   {
     os << indent << "Stream: " << this->Stream << "\n";
@@ -460,6 +602,12 @@ void vtkXMLReader::SetupCompressor(const char* type)
     {
       compressor = vtkLZMADataCompressor::New();
     }
+#ifdef VTK_USE_ZSTD
+    else if (strcmp(type, "vtkZstdDataCompressor") == 0)
+    {
+      compressor = vtkZstdDataCompressor::New();
+    }
+#endif
   }
 
   if (!compressor)
@@ -692,6 +840,9 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
     this->XMLParser->SetAbort(0);
     this->DataError = 0;
 
+    // Map the file in memory if its appended data can be used in place.
+    this->MapFile();
+
     // Let the subclasses read the data they want.
     this->ReadXMLData();
 
@@ -712,6 +863,7 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
 
   // Close the input stream to prevent resource leaks.
   this->CloseStream();
+  this->MappedFile.reset();
   if (this->TimeSteps)
   {
     // The SetupOutput should not reallocate this should be done only in a TimeStep case
@@ -922,12 +1074,37 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
                                << arrayIndex + numValues << " were requested to be read");
     return 0;
   }
-  switch (array->GetDataType())
+  if (this->ReadMappedArrayValues(da, arrayIndex, array, startIndex, numValues))
   {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
+    result = 1;
+  }
+  else
+  {
+#ifdef VTK_USE_ZSTD
+    // The data were compressed with the dictionary written with the array,
+    // if any.
+    vtkZstdDataCompressor* zstd =
+      vtkZstdDataCompressor::SafeDownCast(this->XMLParser->GetCompressor());
+    if (zstd)
+    {
+      const char* encoded = da->GetAttribute("CompressionDictionary");
+      size_t length = encoded ? strlen(encoded) : 0;
+      std::vector<unsigned char> dictionary(length);
+      if (length)
+      {
+        dictionary.resize(vtkBase64Utilities::DecodeSafely(
+          reinterpret_cast<const unsigned char*>(encoded), length, dictionary.data(), length));
+      }
+      zstd->SetDictionary(dictionary.data(), dictionary.size());
+    }
+#endif
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
+                                      arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
+      default:
+        result = 0;
+    }
   }
   if (iter)
   {
@@ -947,6 +1124,91 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   return result;
 }
 
+//------------------------------------------------------------------------------
+void vtkXMLReader::MapFile()
+{
+  this->MappedFile.reset();
+  if (!this->UseMemoryMapping || this->ReadFromInputString || !this->FileName ||
+    !this->XMLParser)
+  {
+    return;
+  }
+
+  // Only raw and uncompressed appended data in the byte order of this
+  // machine can be used in place.
+#ifdef VTK_WORDS_BIGENDIAN
+  const int byteOrder = vtkXMLDataParser::BigEndian;
+#else
+  const int byteOrder = vtkXMLDataParser::LittleEndian;
+#endif
+  if (!this->XMLParser->GetAppendedDataPosition() || !this->XMLParser->GetAppendedDataIsRaw() ||
+    this->XMLParser->GetCompressor() || this->XMLParser->GetByteOrder() != byteOrder)
+  {
+    return;
+  }
+
+  this->MappedFile = vtkXMLReaderMappedFile::New(this->FileName);
+  if (!this->MappedFile)
+  {
+    vtkWarningMacro("Cannot map file " << this->FileName << " in memory, reading it instead.");
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkXMLReader::ReadMappedArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
+  vtkAbstractArray* array, vtkIdType startIndex, vtkIdType numValues)
+{
+  // Only whole arrays of fixed size values can point to the mapping.
+  vtkDataArray* dataArray = vtkArrayDownCast<vtkDataArray>(array);
+  if (!this->MappedFile || !dataArray || arrayIndex != 0 || startIndex != 0 || numValues <= 0 ||
+    numValues != array->GetNumberOfValues() ||
+    array->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate ||
+    array->GetDataType() == VTK_BIT || !da->GetAttribute("offset"))
+  {
+    return 0;
+  }
+  vtkTypeInt64 offset = 0;
+  da->GetScalarAttribute("offset", offset);
+
+  // Check the size in the header of the data block against the whole block.
+  const size_t fileSize = this->MappedFile->GetSize();
+  const size_t headerSize = this->XMLParser->GetHeaderType() / 8;
+  const size_t wordSize = this->XMLParser->GetWordTypeSize(array->GetDataType());
+  const vtkTypeUInt64 length = static_cast<vtkTypeUInt64>(numValues) * wordSize;
+  const vtkTypeInt64 position = this->XMLParser->GetAppendedDataPosition() + offset;
+  if (offset < 0 || wordSize == 0 || static_cast<vtkTypeUInt64>(position) + headerSize > fileSize ||
+    length > fileSize - static_cast<size_t>(position) - headerSize)
+  {
+    return 0;
+  }
+  const unsigned char* header = this->MappedFile->GetData() + position;
+  vtkTypeUInt64 blockSize;
+  if (headerSize == sizeof(vtkTypeUInt32))
+  {
+    vtkTypeUInt32 size32;
+    memcpy(&size32, header, sizeof(size32));
+    blockSize = size32;
+  }
+  else
+  {
+    memcpy(&blockSize, header, sizeof(blockSize));
+  }
+  unsigned char* data = this->MappedFile->GetData() + position + headerSize;
+  if (blockSize < length || reinterpret_cast<uintptr_t>(data) % wordSize != 0)
+  {
+    return 0;
+  }
+
+  {
+    vtkXMLReaderMappedArrays& arrays = vtkXMLReaderMappedArrays::GetInstance();
+    std::lock_guard<std::mutex> lock(arrays.Mutex);
+    arrays.Files.insert(std::make_pair(static_cast<void*>(data), this->MappedFile));
+  }
+  dataArray->SetVoidArray(data, numValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  dataArray->SetArrayFreeFunction(&vtkXMLReaderReleaseMappedArray);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkXMLReader::ReadXMLData()
 {
@@ -19,6 +19,10 @@
  * vtkXMLReader uses vtkXMLDataParser to parse a
  * <a href="http://www.vtk.org/Wiki/VTK_XML_Formats">VTK XML</a> input file.
  * Concrete subclasses then traverse the parsed file structure and extract data.
+ *
+ * When UseMemoryMapping is on, the arrays stored in a raw, uncompressed
+ * appended data section are not copied: the file is mapped in memory and
+ * the arrays point to its pages, which are then loaded on demand.
  */
 
 #ifndef vtkXMLReader_h
@@ -28,6 +32,7 @@
 #include "vtkIOXMLModule.h"  // For export macro
 #include "vtkSmartPointer.h" // for vtkSmartPointer.
 
+#include <memory> // for std::shared_ptr
 #include <string> // for std::string
 
 class vtkAbstractArray;
@@ -42,6 +47,7 @@ class vtkXMLDataParser;
 class vtkInformationVector;
 class vtkInformation;
 class vtkStringArray;
+class vtkXMLReaderMappedFile;
 
 class VTKIOXML_EXPORT vtkXMLReader : public vtkAlgorithm
 {
@@ -74,6 +80,21 @@ public:
   void SetInputString(const std::string& s) { this->InputString = s; }
   ///@}
 
+  ///@{
+  /**
+   * Enable reading the arrays of the appended data section through a
+   * memory mapping of the file instead of copying them. This only applies
+   * to whole arrays of raw, uncompressed appended data whose byte order is
+   * the one of this machine and whose values are aligned in the file, the
+   * other arrays are read as usual. The arrays keep the mapping alive until
+   * they release their memory, and modifying them never changes the file.
+   * Default is off.
+   */
+  vtkSetMacro(UseMemoryMapping, vtkTypeBool);
+  vtkGetMacro(UseMemoryMapping, vtkTypeBool);
+  vtkBooleanMacro(UseMemoryMapping, vtkTypeBool);
+  ///@}
+
   /**
    * Test whether the file (type) with the given name can be read by this
    * reader. If the file has a newer version than the reader, we still say
@@ -346,6 +367,9 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether to map the appended data of the file in memory.
+  vtkTypeBool UseMemoryMapping;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
@@ -443,6 +467,12 @@ private:
   vtkDataObject* CurrentOutput;
   vtkInformation* CurrentOutputInformation;
 
+  // The memory mapping of the file being read, if UseMemoryMapping applies.
+  std::shared_ptr<vtkXMLReaderMappedFile> MappedFile;
+  void MapFile();
+  int ReadMappedArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
+    vtkIdType startIndex, vtkIdType numValues);
+
 private:
   vtkXMLReader(const vtkXMLReader&) = delete;
   void operator=(const vtkXMLReader&) = delete;
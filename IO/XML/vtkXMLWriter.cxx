@@ -18,6 +18,7 @@
 #include "vtkArrayDispatch.h"
 #include "vtkArrayIteratorIncludes.h"
 #include "vtkBase64OutputStream.h"
+#include "vtkBase64Utilities.h"
 #include "vtkBitArray.h"
 #include "vtkByteSwap.h"
 #include "vtkCellData.h"
@@ -27,6 +28,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkEndian.h"
 #include "vtkErrorCode.h"
+#include "vtkIOCoreConfigure.h" // For VTK_USE_ZSTD
 #include "vtkInformation.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationDoubleVectorKey.h"
@@ -43,10 +45,15 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZLibDataCompressor.h"
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
 #undef vtkXMLOffsetsManager_DoNotInclude
@@ -749,6 +756,8 @@ int vtkXMLWriter::StartFile()
 
   os.imbue(std::locale::classic());
 
+  this->AppendedCompressionDictionaries.clear();
+
   // Open the document-level element.  This will contain the rest of
   // the elements.
   os << "<VTKFile";
@@ -1018,6 +1027,14 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the remaining blocks, or drop them on error.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+    this->PendingCompressionBlocks.clear();
+    this->PendingCompressionBlockSizes.clear();
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1380,26 +1397,60 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // Queue a copy of the block, the caller may reuse its buffer.
+  this->PendingCompressionBlocks.insert(this->PendingCompressionBlocks.end(), data, data + size);
+  this->PendingCompressionBlockSizes.push_back(size);
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
-
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
-  this->Stream->flush();
-  if (this->Stream->fail())
+  // Compress a few blocks per thread at once to bound the memory used.
+  size_t maxPendingBlocks = 4 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  if (this->PendingCompressionBlockSizes.size() < maxPendingBlocks)
   {
-    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 1;
   }
+  return this->FlushCompressionBlocks();
+}
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  size_t numBlocks = this->PendingCompressionBlockSizes.size();
+  std::vector<size_t> offsets(numBlocks + 1, 0);
+  for (size_t i = 0; i < numBlocks; ++i)
+  {
+    offsets[i + 1] = offsets[i] + this->PendingCompressionBlockSizes[i];
+  }
 
-  outputArray->Delete();
+  // The blocks are compressed independently of each other.
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> outputArrays(numBlocks);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      outputArrays[i].TakeReference(this->Compressor->Compress(
+        this->PendingCompressionBlocks.data() + offsets[i], offsets[i + 1] - offsets[i]));
+    }
+  });
+  this->PendingCompressionBlocks.clear();
+  this->PendingCompressionBlockSizes.clear();
 
+  // Write them in order, storing their sizes in the compression header.
+  int result = 1;
+  for (size_t i = 0; i < numBlocks && result; ++i)
+  {
+    if (!outputArrays[i])
+    {
+      vtkErrorMacro("Cannot compress block " << this->CompressionBlockNumber << ".");
+      return 0;
+    }
+    size_t outputSize = outputArrays[i]->GetNumberOfTuples();
+    result = this->DataStream->Write(outputArrays[i]->GetPointer(0), outputSize);
+    this->Stream->flush();
+    if (this->Stream->fail())
+    {
+      this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+      return 0;
+    }
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  }
   return result;
 }
 
@@ -2020,6 +2071,12 @@ void vtkXMLWriter::WriteArrayAppended(vtkAbstractArray* a, vtkIndent indent, Off
   //
   offs.GetPosition(timestep) = this->ReserveAttributeSpace("offset");
 
+  std::vector<unsigned char> dictionary = this->WriteCompressionDictionary(a);
+  if (!dictionary.empty())
+  {
+    this->AppendedCompressionDictionaries[offs.GetPosition(timestep)].swap(dictionary);
+  }
+
   // Write information in the recognized keys associated with this array.
   vtkInformation* info = a->GetInformation();
   bool hasInfo = info && info->GetNumberOfKeys() > 0;
@@ -2041,7 +2098,77 @@ void vtkXMLWriter::WriteArrayAppendedData(
   vtkAbstractArray* a, vtkTypeInt64 pos, vtkTypeInt64& lastoffset)
 {
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
+
+  // Without a dictionary in the header, the data are compressed without one.
+  std::vector<unsigned char> dictionary;
+  auto found = this->AppendedCompressionDictionaries.find(pos);
+  if (found != this->AppendedCompressionDictionaries.end())
+  {
+    dictionary.swap(found->second);
+    this->AppendedCompressionDictionaries.erase(found);
+  }
+  this->SwapCompressionDictionary(dictionary);
   this->WriteBinaryData(a);
+  this->SwapCompressionDictionary(dictionary);
+}
+
+//------------------------------------------------------------------------------
+std::vector<unsigned char> vtkXMLWriter::WriteCompressionDictionary(vtkAbstractArray* a)
+{
+  std::vector<unsigned char> dictionary;
+#ifdef VTK_USE_ZSTD
+  vtkZstdDataCompressor* zstd = vtkZstdDataCompressor::SafeDownCast(this->Compressor);
+  if (!zstd || this->DataMode == vtkXMLWriter::Ascii)
+  {
+    return dictionary;
+  }
+  dictionary.assign(zstd->GetDictionary(), zstd->GetDictionary() + zstd->GetDictionarySize());
+
+  // The training uses the values in memory, before the conversion of the ids
+  // and the byte swapping, which matter little for the dictionary.
+  vtkDataArray* da = vtkArrayDownCast<vtkDataArray>(a);
+  if (zstd->GetTrainDictionaries() && da && da->GetDataType() != VTK_BIT &&
+    da->HasStandardMemoryLayout())
+  {
+    std::vector<unsigned char> previous = dictionary;
+    const size_t size = static_cast<size_t>(da->GetNumberOfValues()) * da->GetDataTypeSize();
+    if (zstd->TrainDictionary(
+          static_cast<const unsigned char*>(da->GetVoidPointer(0)), size, this->BlockSize))
+    {
+      dictionary.assign(zstd->GetDictionary(), zstd->GetDictionary() + zstd->GetDictionarySize());
+    }
+    zstd->SetDictionary(previous.data(), previous.size());
+  }
+
+  if (!dictionary.empty())
+  {
+    std::vector<unsigned char> encoded(4 * ((dictionary.size() + 2) / 3) + 1);
+    unsigned long length = vtkBase64Utilities::Encode(
+      dictionary.data(), static_cast<unsigned long>(dictionary.size()), encoded.data());
+    this->WriteStringAttribute(
+      "CompressionDictionary", std::string(encoded.begin(), encoded.begin() + length).c_str());
+  }
+#else
+  (void)a;
+#endif
+  return dictionary;
+}
+
+//------------------------------------------------------------------------------
+void vtkXMLWriter::SwapCompressionDictionary(std::vector<unsigned char>& dictionary)
+{
+#ifdef VTK_USE_ZSTD
+  vtkZstdDataCompressor* zstd = vtkZstdDataCompressor::SafeDownCast(this->Compressor);
+  if (zstd)
+  {
+    std::vector<unsigned char> previous(
+      zstd->GetDictionary(), zstd->GetDictionary() + zstd->GetDictionarySize());
+    zstd->SetDictionary(dictionary.data(), dictionary.size());
+    dictionary.swap(previous);
+  }
+#else
+  (void)dictionary;
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -2169,10 +2296,13 @@ void vtkXMLWriter::WriteArrayInline(
     this->WriteScalarAttribute("RangeMin", da->GetRange(-1)[0]);
     this->WriteScalarAttribute("RangeMax", da->GetRange(-1)[1]);
   }
+  std::vector<unsigned char> dictionary = this->WriteCompressionDictionary(a);
   // Close the header
   os << ">\n";
   // Write the inline data.
+  this->SwapCompressionDictionary(dictionary);
   this->WriteInlineData(a, indent.GetNextIndent());
+  this->SwapCompressionDictionary(dictionary);
   // Write information keys associated with this array.
   vtkInformation* info = a->GetInformation();
   if (info && info->GetNumberOfKeys() > 0)
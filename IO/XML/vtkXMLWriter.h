@@ -33,7 +33,9 @@
 #include "vtkIOXMLModule.h" // For export macro
 #include "vtkXMLWriterBase.h"
 
+#include <map>     // For std::map ivar
 #include <sstream> // For ostringstream ivar
+#include <vector>  // For std::vector ivar
 
 class vtkAbstractArray;
 class vtkArrayIterator;
@@ -139,6 +141,15 @@ protected:
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
 
+  // The blocks waiting to be compressed concurrently, one after the other,
+  // and their sizes.
+  std::vector<unsigned char> PendingCompressionBlocks;
+  std::vector<size_t> PendingCompressionBlockSizes;
+
+  // The dictionaries to compress the arrays written in appended mode with,
+  // by the position of their offset attribute.
+  std::map<vtkTypeInt64, std::vector<unsigned char>> AppendedCompressionDictionaries;
+
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
   vtkOutputStream* DataStream;
@@ -222,6 +233,15 @@ protected:
   int WriteBinaryDataInternal(vtkAbstractArray* a);
   void WriteArrayAppendedData(vtkAbstractArray* a, vtkTypeInt64 pos, vtkTypeInt64& lastoffset);
 
+  // Data compressed with a dictionary can only be uncompressed with it, so
+  // the dictionary to compress an array with, trained for it if the
+  // compressor is asked to, is written as an attribute of the array.
+  // Returns the dictionary, empty if there is none.
+  std::vector<unsigned char> WriteCompressionDictionary(vtkAbstractArray* a);
+  // Make the compressor use the given dictionary, and return the previous
+  // one in it.
+  void SwapCompressionDictionary(std::vector<unsigned char>& dictionary);
+
   // Methods for writing points, point data, and cell data.
   void WriteFieldData(vtkIndent indent);
   void WriteFieldDataInline(vtkFieldData* fd, vtkIndent indent);
@@ -254,6 +274,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
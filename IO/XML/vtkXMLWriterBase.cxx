@@ -15,12 +15,17 @@
 #include "vtkXMLWriterBase.h"
 
 #include "vtkDataCompressor.h"
+#include "vtkIOCoreConfigure.h" // For VTK_USE_ZSTD
 #include "vtkLZ4DataCompressor.h"
 #include "vtkLZMADataCompressor.h"
 #include "vtkObjectFactory.h"
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
 
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
+
 vtkCxxSetObjectMacro(vtkXMLWriterBase, Compressor, vtkDataCompressor);
 //----------------------------------------------------------------------------
 vtkXMLWriterBase::vtkXMLWriterBase()
@@ -121,6 +126,18 @@ void vtkXMLWriterBase::SetCompressorType(int compressorType)
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
     this->Modified();
   }
+  else if (compressorType == LZ4HC)
+  {
+    if (this->Compressor)
+    {
+      this->Compressor->Delete();
+    }
+    vtkLZ4DataCompressor* compressor = vtkLZ4DataCompressor::New();
+    compressor->HighCompressionOn();
+    this->Compressor = compressor;
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+  }
   else if (compressorType == LZMA)
   {
     if (this->Compressor)
@@ -131,6 +148,20 @@ void vtkXMLWriterBase::SetCompressorType(int compressorType)
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
     this->Modified();
   }
+  else if (compressorType == ZSTD)
+  {
+#ifdef VTK_USE_ZSTD
+    if (this->Compressor)
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZstdDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+#else
+    vtkWarningMacro("VTK was built without zstd support (VTK_USE_ZSTD).");
+#endif
+  }
   else
   {
     vtkWarningMacro("Invalid compressorType:" << compressorType);
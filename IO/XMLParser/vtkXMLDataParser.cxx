@@ -21,12 +21,14 @@
 #include "vtkEndian.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <memory>
@@ -47,6 +49,7 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->RootElement = nullptr;
   this->AppendedDataPosition = 0;
   this->AppendedDataMatched = 0;
+  this->AppendedDataIsRaw = 0;
   this->DataStream = nullptr;
   this->InlineDataStream = vtkBase64InputStream::New();
   this->AppendedDataStream = vtkBase64InputStream::New();
@@ -99,6 +102,7 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "AppendedDataPosition: " << this->AppendedDataPosition << "\n";
+  os << indent << "AppendedDataIsRaw: " << this->AppendedDataIsRaw << "\n";
   if (this->RootElement)
   {
     this->RootElement->PrintXML(os, indent);
@@ -174,6 +178,7 @@ void vtkXMLDataParser::StartElement(const char* name, const char** atts)
     {
       this->AppendedDataStream->Delete();
       this->AppendedDataStream = vtkInputStream::New();
+      this->AppendedDataIsRaw = 1;
     }
   }
 }
@@ -811,21 +816,52 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks in between by batches of a few blocks per
+    // thread.  The compressed blocks of a batch are read at once, then
+    // decompressed and byte swapped concurrently in place in the output.
+    vtkTypeUInt64 const batchSize =
+      4 * static_cast<vtkTypeUInt64>(vtkSMPTools::GetEstimatedNumberOfThreads());
+    std::vector<unsigned char> readBuffer;
+    vtkTypeUInt64 currentBlock = firstBlock + 1;
+    while (currentBlock < lastBlock && !this->Abort)
     {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
+      vtkTypeUInt64 const batchEnd = std::min(currentBlock + batchSize, lastBlock);
+      vtkTypeInt64 const batchStart = this->BlockStartOffsets[currentBlock];
+      size_t const batchLength = static_cast<size_t>(this->BlockStartOffsets[batchEnd - 1] +
+        this->BlockCompressedSizes[batchEnd - 1] - batchStart);
+      readBuffer.resize(batchLength);
+      if (!this->DataStream->Seek(batchStart) ||
+        this->DataStream->Read(readBuffer.data(), batchLength) < batchLength)
       {
         return 0;
       }
 
-      // Byte swap this block.  Note that blockSize will always be an
-      // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+      std::atomic<bool> uncompressed(true);
+      vtkSMPTools::For(static_cast<vtkIdType>(currentBlock), static_cast<vtkIdType>(batchEnd),
+        [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType block = begin; block < end; ++block)
+          {
+            unsigned char* blockOutput = outputPointer + (block - currentBlock) * blockSize;
+            if (!this->Compressor->Uncompress(
+                  readBuffer.data() + (this->BlockStartOffsets[block] - batchStart),
+                  this->BlockCompressedSizes[block], blockOutput, blockSize))
+            {
+              uncompressed = false;
+              continue;
+            }
+            // Note that blockSize will always be an integer multiple of the
+            // word size.
+            this->PerformByteSwap(blockOutput, blockSize / wordSize, wordSize);
+          }
+        });
+      if (!uncompressed)
+      {
+        return 0;
+      }
 
-      // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      // Advance the pointer to the beginning of the next batch.
+      outputPointer += (batchEnd - currentBlock) * blockSize;
+      currentBlock = batchEnd;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer - data) / length);
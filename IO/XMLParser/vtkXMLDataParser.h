@@ -158,6 +158,20 @@ public:
    */
   vtkTypeInt64 GetAppendedDataPosition() { return this->AppendedDataPosition; }
 
+  /**
+   * Returns 1 if the appended data section is stored with the raw
+   * encoding rather than base64. Valid after the XML is parsed.
+   */
+  vtkGetMacro(AppendedDataIsRaw, int);
+
+  /**
+   * Get the byte order of the binary data (BigEndian or LittleEndian)
+   * and the number of bits (32 or 64) of the binary data headers.
+   * Valid after the XML is parsed.
+   */
+  vtkGetMacro(ByteOrder, int);
+  vtkGetMacro(HeaderType, int);
+
 protected:
   vtkXMLDataParser();
   ~vtkXMLDataParser() override;
@@ -215,6 +229,9 @@ protected:
   // How much of the string "<AppendedData" has been matched in input.
   int AppendedDataMatched;
 
+  // Whether the appended data section uses the raw encoding.
+  int AppendedDataIsRaw;
+
   // The byte order of the binary input.
   int ByteOrder;
 
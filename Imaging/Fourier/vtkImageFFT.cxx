@@ -62,6 +62,14 @@ int vtkImageFFT::IterativeRequestUpdateExtent(vtkInformation* input, vtkInformat
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// All the axes are transformed at once, instead of one per iteration.
+int vtkImageFFT::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  return this->RequestTransformData(inputVector, outputVector, false);
+}
+
 //------------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
 // is always doubles.
@@ -178,8 +186,8 @@ void vtkImageFFTExecute(vtkImageFFT* self, vtkImageData* inData, int inExt[6], T
 
 //------------------------------------------------------------------------------
 // This method is passed input and output Datas, and executes the fft
-// algorithm to fill the output from the input.
-// Not threaded yet.
+// algorithm along the axis of the current iteration to fill the output
+// from the input. RequestData no longer calls it, it is kept for subclasses.
 void vtkImageFFT::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector),
   vtkImageData*** inDataVec, vtkImageData** outDataVec, int outExt[6], int threadId)
@@ -14,8 +14,17 @@
 =========================================================================*/
 #include "vtkImageFourierFilter.h"
 
+#include "vtkFFT.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
 #include <cmath>
+#include <type_traits>
+#include <vector>
 
 /*=========================================================================
         Vectors of complex numbers.
@@ -242,3 +251,145 @@ int vtkImageFourierFilter::RequestData(
 
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
+
+//------------------------------------------------------------------------------
+// Copies the first component (and the second one, if any, as imaginary part) of
+// the input extent into contiguous complex numbers.
+template <class T>
+void vtkImageFourierFilterCopyToComplex(
+  vtkImageData* inData, int inExt[6], T* inPtr, vtkFFT::ComplexNumber* data)
+{
+  vtkIdType inIncrements[3];
+  inData->GetIncrements(inIncrements);
+  const int numberOfComponents = inData->GetNumberOfScalarComponents();
+  const vtkIdType rowLength = inExt[1] - inExt[0] + 1;
+  const vtkIdType numberOfRows = inExt[3] - inExt[2] + 1;
+  const vtkIdType numberOfSlices = inExt[5] - inExt[4] + 1;
+
+  vtkSMPTools::For(0, numberOfRows * numberOfSlices, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType row = begin; row < end; ++row)
+    {
+      const T* inPtr0 =
+        inPtr + (row % numberOfRows) * inIncrements[1] + (row / numberOfRows) * inIncrements[2];
+      vtkFFT::ComplexNumber* outPtr0 = data + row * rowLength;
+      for (vtkIdType idx0 = 0; idx0 < rowLength; ++idx0)
+      {
+        outPtr0->r = static_cast<vtkFFT::ScalarNumber>(*inPtr0);
+        outPtr0->i = numberOfComponents > 1 ? static_cast<vtkFFT::ScalarNumber>(inPtr0[1]) : 0.0;
+        inPtr0 += inIncrements[0];
+        ++outPtr0;
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+int vtkImageFourierFilter::RequestTransformData(
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector, bool inverse)
+{
+  vtkImageData* inData = nullptr;
+  vtkImageData** inputs = &inData;
+  vtkImageData* outData = nullptr;
+  this->PrepareImageData(inputVector, outputVector, &inputs, &outData);
+
+  int outExt[6];
+  outData->GetExtent(outExt);
+  if (!inData || outExt[0] > outExt[1] || outExt[2] > outExt[3] || outExt[4] > outExt[5])
+  {
+    return 1;
+  }
+
+  // this filter expects that the output be doubles.
+  if (outData->GetScalarType() != VTK_DOUBLE || outData->GetNumberOfScalarComponents() != 2)
+  {
+    vtkErrorMacro(<< "Execute: Output must be complex doubles.");
+    return 1;
+  }
+
+  // Input has to have real components at least.
+  const int numberOfComponents = inData->GetNumberOfScalarComponents();
+  if (numberOfComponents < 1)
+  {
+    vtkErrorMacro(<< "Execute: No real components");
+    return 1;
+  }
+
+  // The whole input is needed along the transformed axes
+  int inExt[6];
+  int* wExt =
+    inputVector[0]->GetInformationObject(0)->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
+  vtkIdType dims[3];
+  bool sameExtent = true;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    inExt[2 * axis] = outExt[2 * axis];
+    inExt[2 * axis + 1] = outExt[2 * axis + 1];
+    if (axis < this->Dimensionality)
+    {
+      inExt[2 * axis] = wExt[2 * axis];
+      inExt[2 * axis + 1] = wExt[2 * axis + 1];
+      sameExtent = sameExtent && inExt[2 * axis] == outExt[2 * axis] &&
+        inExt[2 * axis + 1] == outExt[2 * axis + 1];
+    }
+    dims[axis] = inExt[2 * axis + 1] - inExt[2 * axis] + 1;
+  }
+
+  // The transform is computed in the output when it has the same extent as
+  // the input (and kissfft uses doubles), or in a buffer otherwise.
+  std::vector<vtkFFT::ComplexNumber> buffer;
+  vtkFFT::ComplexNumber* data;
+  if (sameExtent && std::is_same<vtkFFT::ScalarNumber, double>::value)
+  {
+    data = static_cast<vtkFFT::ComplexNumber*>(outData->GetScalarPointer());
+  }
+  else
+  {
+    buffer.resize(dims[0] * dims[1] * dims[2]);
+    data = buffer.data();
+  }
+
+  void* inPtr = inData->GetScalarPointerForExtent(inExt);
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(
+      vtkImageFourierFilterCopyToComplex(inData, inExt, static_cast<VTK_TT*>(inPtr), data));
+    default:
+      vtkErrorMacro(<< "Execute: Unknown ScalarType");
+      return 1;
+  }
+
+  for (int axis = 0; axis < this->Dimensionality && !this->AbortExecute; ++axis)
+  {
+    if (axis == 0 && !inverse && numberOfComponents == 1)
+    {
+      vtkFFT::RFftAxis(data, dims, 3, axis);
+    }
+    else
+    {
+      vtkFFT::FftAxis(data, dims, 3, axis, inverse);
+    }
+    this->UpdateProgress((axis + 1.0) / this->Dimensionality);
+  }
+
+  // Copy the requested extent from the buffer
+  if (!buffer.empty())
+  {
+    double* outPtr = static_cast<double*>(outData->GetScalarPointer());
+    for (int idx2 = outExt[4]; idx2 <= outExt[5]; ++idx2)
+    {
+      for (int idx1 = outExt[2]; idx1 <= outExt[3]; ++idx1)
+      {
+        const vtkFFT::ComplexNumber* pComplex = data +
+          ((idx2 - inExt[4]) * dims[1] + (idx1 - inExt[2])) * dims[0] + (outExt[0] - inExt[0]);
+        for (int idx0 = outExt[0]; idx0 <= outExt[1]; ++idx0)
+        {
+          *outPtr++ = static_cast<double>(pComplex->r);
+          *outPtr++ = static_cast<double>(pComplex->i);
+          ++pComplex;
+        }
+      }
+    }
+  }
+
+  return 1;
+}
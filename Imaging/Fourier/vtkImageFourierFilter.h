@@ -114,6 +114,16 @@ protected:
     vtkImageComplex* p_in, vtkImageComplex* p_out, int N, int bsize, int n, int fb);
   void ExecuteFftForwardBackward(vtkImageComplex* in, vtkImageComplex* out, int N, int fb);
 
+  /**
+   * Compute the DFT, or its inverse, of the input along all the axes at once,
+   * in place in the output, with vtkFFT. This replaces the iterations (one per
+   * axis) and their intermediate images: the rows along each axis are
+   * transformed in parallel with vtkSMPTools. Real inputs (with one component)
+   * use real transforms along the first axis.
+   */
+  int RequestTransformData(
+    vtkInformationVector** inputVector, vtkInformationVector* outputVector, bool inverse);
+
   /**
    * Override to change extent splitting rules.
    */
@@ -61,6 +61,14 @@ int vtkImageRFFT::IterativeRequestUpdateExtent(vtkInformation* input, vtkInforma
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// All the axes are transformed at once, instead of one per iteration.
+int vtkImageRFFT::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  return this->RequestTransformData(inputVector, outputVector, true);
+}
+
 //------------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
 // is always doubles.
@@ -177,8 +185,8 @@ void vtkImageRFFTExecute(vtkImageRFFT* self, vtkImageData* inData, int inExt[6],
 
 //------------------------------------------------------------------------------
 // This method is passed input and output Datas, and executes the RFFT
-// algorithm to fill the output from the input.
-// Not threaded yet.
+// algorithm along the axis of the current iteration to fill the output
+// from the input. RequestData no longer calls it, it is kept for subclasses.
 void vtkImageRFFT::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector),
   vtkImageData*** inDataVec, vtkImageData** outDataVec, int outExt[6], int threadId)
@@ -19,11 +19,10 @@
  * vtkImageRFFT implements the reverse fast Fourier transform.  The input
  * can have real or complex data in any components and data types, but
  * the output is always complex doubles with real values in component0, and
- * imaginary values in component1.  The filter is fastest for images that
- * have power of two sizes.  The filter uses butterfly filters for each
- * prime factor of the dimension.  This makes images with prime number dimensions
- * (i.e. 17x17) much slower to compute.  Multi dimensional (i.e volumes)
- * FFT's are decomposed so that each axis executes in series.
+ * imaginary values in component1.  The filter is fastest for images whose
+ * sizes only have small prime factors (2, 3 and 5).  All the axes are
+ * transformed in place in the output with vtkFFT, and the rows along each
+ * axis are transformed in parallel.
  * In most cases the RFFT will produce an image whose imaginary values are all
  * zero's. In this case vtkImageExtractComponents can be used to remove
  * this imaginary components leaving only the real image.
@@ -52,6 +51,15 @@ protected:
   int IterativeRequestInformation(vtkInformation* in, vtkInformation* out) override;
   int IterativeRequestUpdateExtent(vtkInformation* in, vtkInformation* out) override;
 
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  /**
+   * Transform the input along the axis of the current iteration only, for
+   * the given extent, as this filter did before all the axes were
+   * transformed at once. RequestData does not call it anymore: it is kept
+   * for subclasses, and overriding it no longer changes the output.
+   */
   void ThreadedRequestData(vtkInformation* vtkNotUsed(request), vtkInformationVector** inputVector,
     vtkInformationVector* vtkNotUsed(outputVector), vtkImageData*** inDataVec,
     vtkImageData** outDataVec, int outExt[6], int threadId) override;
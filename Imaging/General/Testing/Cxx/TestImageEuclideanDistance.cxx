@@ -0,0 +1,215 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageEuclideanDistance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares the squared distances computed by the Saito and Felzenszwalb
+// algorithms with a brute force search on a small volume, with double and
+// float output, and checks the feature ids of Felzenszwalb's. Saito's
+// algorithm is only exact for isotropic spacings, so anisotropic volumes
+// only check Felzenszwalb's.
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkImageEuclideanDistance.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const int Dimensions[3] = { 17, 13, 9 };
+
+double SquaredDistance(vtkImageData* image, vtkIdType id0, vtkIdType id1)
+{
+  double p0[3], p1[3];
+  image->GetPoint(id0, p0);
+  image->GetPoint(id1, p1);
+  return vtkMath::Distance2BetweenPoints(p0, p1);
+}
+
+// The squared distance from each voxel to the nearest zero voxel.
+std::vector<double> BruteForce(vtkImageData* image)
+{
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  std::vector<vtkIdType> zeros;
+  for (vtkIdType id = 0; id < image->GetNumberOfPoints(); ++id)
+  {
+    if (scalars->GetComponent(id, 0) == 0)
+    {
+      zeros.push_back(id);
+    }
+  }
+  std::vector<double> distances(image->GetNumberOfPoints(), VTK_DOUBLE_MAX);
+  for (vtkIdType id = 0; id < image->GetNumberOfPoints(); ++id)
+  {
+    for (vtkIdType zero : zeros)
+    {
+      distances[id] = std::min(distances[id], SquaredDistance(image, id, zero));
+    }
+  }
+  return distances;
+}
+
+bool Near(double value, double expected, double tolerance)
+{
+  return std::abs(value - expected) <= tolerance * (1.0 + expected);
+}
+
+// Run the filter, compare its output with the expected distances, clamped to
+// the maximum distance, and return it.
+vtkImageData* Run(vtkImageEuclideanDistance* filter, vtkImageData* input, int algorithm,
+  int scalarType, const std::vector<double>& expected, double maxDist, const char* name)
+{
+  filter->SetInputData(input);
+  filter->SetAlgorithm(algorithm);
+  filter->SetOutputScalarType(scalarType);
+  filter->SetMaximumDistance(maxDist);
+  filter->Update();
+  vtkImageData* output = filter->GetOutput();
+  vtkDataArray* distances = output->GetPointData()->GetScalars();
+  if (!distances || distances->GetDataType() != scalarType ||
+    distances->GetNumberOfTuples() != input->GetNumberOfPoints())
+  {
+    std::cerr << name << ": wrong output scalars" << std::endl;
+    return nullptr;
+  }
+  const double tolerance = scalarType == VTK_FLOAT ? 1e-6 : 1e-12;
+  for (vtkIdType id = 0; id < input->GetNumberOfPoints(); ++id)
+  {
+    const double value = distances->GetComponent(id, 0);
+    if (!Near(value, std::min(expected[id], maxDist), tolerance))
+    {
+      std::cerr << name << ": distance " << value << " at voxel " << id << " instead of "
+                << std::min(expected[id], maxDist) << std::endl;
+      return nullptr;
+    }
+  }
+  return output;
+}
+
+// The feature of each voxel closer than the maximum distance is a zero voxel
+// at the distance of the nearest one, the others have none.
+bool CheckFeatureIds(
+  vtkImageData* input, vtkImageData* output, const std::vector<double>& expected, double maxDist)
+{
+  vtkIdTypeArray* featureIds =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("FeatureIds"));
+  if (!featureIds || featureIds->GetNumberOfValues() != input->GetNumberOfPoints())
+  {
+    std::cerr << "Missing FeatureIds" << std::endl;
+    return false;
+  }
+  vtkDataArray* scalars = input->GetPointData()->GetScalars();
+  for (vtkIdType id = 0; id < input->GetNumberOfPoints(); ++id)
+  {
+    const vtkIdType featureId = featureIds->GetValue(id);
+    if (expected[id] > maxDist)
+    {
+      if (featureId != -1)
+      {
+        std::cerr << "Voxel " << id << " beyond the maximum distance has feature " << featureId
+                  << std::endl;
+        return false;
+      }
+    }
+    else if (featureId < 0 || featureId >= input->GetNumberOfPoints() ||
+      scalars->GetComponent(featureId, 0) != 0 ||
+      !Near(SquaredDistance(input, id, featureId), expected[id], 1e-12))
+    {
+      std::cerr << "Wrong feature " << featureId << " for voxel " << id << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestVolume(const double spacing[3], bool withSaito)
+{
+  // A few zero voxels in a non-zero volume
+  vtkNew<vtkImageData> input;
+  input->SetDimensions(Dimensions[0], Dimensions[1], Dimensions[2]);
+  input->SetSpacing(spacing[0], spacing[1], spacing[2]);
+  input->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3);
+  for (vtkIdType id = 0; id < input->GetNumberOfPoints(); ++id)
+  {
+    random->Next();
+    input->GetPointData()->GetScalars()->SetComponent(id, 0, random->GetValue() < 0.02 ? 0 : 7);
+  }
+  const std::vector<double> expected = BruteForce(input);
+
+  // The second maximum distance is not one of the squared distances, so
+  // that the voxels beyond it are not ambiguous.
+  const double maxDistances[] = { VTK_INT_MAX, 4.1 };
+  for (double maxDist : maxDistances)
+  {
+    vtkNew<vtkImageEuclideanDistance> felzenszwalb;
+    felzenszwalb->ComputeFeatureIdsOn();
+    vtkImageData* output =
+      Run(felzenszwalb, input, VTK_EDT_FELZENSZWALB, VTK_DOUBLE, expected, maxDist, "Felzenszwalb");
+    if (!output || !CheckFeatureIds(input, output, expected, maxDist))
+    {
+      return false;
+    }
+
+    vtkNew<vtkImageEuclideanDistance> felzenszwalbFloat;
+    felzenszwalbFloat->ComputeFeatureIdsOn();
+    output = Run(felzenszwalbFloat, input, VTK_EDT_FELZENSZWALB, VTK_FLOAT, expected, maxDist,
+      "Felzenszwalb float");
+    if (!output || !CheckFeatureIds(input, output, expected, maxDist))
+    {
+      return false;
+    }
+
+    if (withSaito)
+    {
+      vtkNew<vtkImageEuclideanDistance> saito;
+      saito->ComputeFeatureIdsOn();
+      output = Run(saito, input, VTK_EDT_SAITO, VTK_DOUBLE, expected, maxDist, "Saito");
+      vtkNew<vtkImageEuclideanDistance> saitoCached;
+      if (!output ||
+        !Run(saitoCached, input, VTK_EDT_SAITO_CACHED, VTK_DOUBLE, expected, maxDist,
+          "Saito cached"))
+      {
+        return false;
+      }
+      // Saito's algorithm does not compute the feature ids
+      if (output->GetPointData()->GetArray("FeatureIds"))
+      {
+        std::cerr << "Unexpected FeatureIds with Saito's algorithm" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestImageEuclideanDistance(int, char*[])
+{
+  const double isotropic[3] = { 1.0, 1.0, 1.0 };
+  const double anisotropic[3] = { 1.0, 1.5, 0.75 };
+  if (!TestVolume(isotropic, true) || !TestVolume(anisotropic, false))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,412 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageGaussianSmooth.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares vtkImageGaussianSmooth and vtkImageSeparableConvolution with
+// straightforward implementations of their per sample convolutions, in one
+// to three dimensions, for the whole extent and for pieces of it.
+//
+// The scalars accumulated in double precision must match the previous
+// per sample implementation of vtkImageGaussianSmooth exactly. The float
+// scalars must match it within float rounding, and the integer scalars, that
+// are truncated after each axis, by at most one per filtered axis. The
+// separable convolution, that accumulates in float, must match within float
+// rounding. The recursive filter must stay within 1e-3 of the range of the
+// values of a gaussian convolution with the edges replicated.
+
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkImageGaussianSmooth.h"
+#include "vtkImageSeparableConvolution.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// The values of the inputs are in [0, Range)
+const double Range = 200.0;
+const int WholeExtent[6] = { -3, 19, 2, 18, 0, 10 };
+
+// Pieces of the whole extent, touching or away from its boundaries
+const int Pieces[][6] = {
+  { -3, 19, 2, 18, 0, 10 },
+  { -3, 4, 2, 6, 0, 3 },
+  { 2, 11, 5, 13, 4, 7 },
+  { 15, 19, 14, 18, 9, 10 },
+  { 7, 7, 10, 10, 5, 5 },
+};
+
+int Size(int axis)
+{
+  return WholeExtent[2 * axis + 1] - WholeExtent[2 * axis] + 1;
+}
+
+vtkIdType Index(const int ijk[3], int numComps, int comp)
+{
+  return ((static_cast<vtkIdType>(ijk[2]) * Size(1) + ijk[1]) * Size(0) + ijk[0]) * numComps +
+    comp;
+}
+
+vtkSmartPointer<vtkImageData> MakeImage(int scalarType, int numComps, int seed)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(const_cast<int*>(WholeExtent));
+  image->AllocateScalars(scalarType, numComps);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  const bool integer = scalarType != VTK_FLOAT && scalarType != VTK_DOUBLE;
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+  {
+    random->Next();
+    const double value = Range * random->GetValue();
+    scalars->SetComponent(i / numComps, i % numComps, integer ? std::floor(value) : value);
+  }
+  return image;
+}
+
+std::vector<double> GetValues(vtkImageData* image)
+{
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  std::vector<double> values(scalars->GetNumberOfValues());
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+  {
+    values[i] = scalars->GetComponent(i / scalars->GetNumberOfComponents(),
+      static_cast<int>(i % scalars->GetNumberOfComponents()));
+  }
+  return values;
+}
+
+// Convolve the values along the axis, computing each output sample from the
+// weights and the first input sample returned by the kernel for its position,
+// and cast each sum to the type of the scalars, as the previous per sample
+// implementation of vtkImageGaussianSmooth did.
+template <class T, class Kernel>
+std::vector<double> ConvolveAxis(
+  const std::vector<double>& in, int numComps, int axis, const Kernel& kernel)
+{
+  std::vector<double> out(in.size());
+  std::vector<double> weights;
+  int ijk[3];
+  for (ijk[2] = 0; ijk[2] < Size(2); ++ijk[2])
+  {
+    for (ijk[1] = 0; ijk[1] < Size(1); ++ijk[1])
+    {
+      for (ijk[0] = 0; ijk[0] < Size(0); ++ijk[0])
+      {
+        const int first = kernel(ijk[axis], Size(axis), weights);
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          int from[3] = { ijk[0], ijk[1], ijk[2] };
+          double sum = 0.0;
+          for (size_t k = 0; k < weights.size(); ++k)
+          {
+            from[axis] = first + static_cast<int>(k);
+            sum += weights[k] * in[Index(from, numComps, comp)];
+          }
+          out[Index(ijk, numComps, comp)] = static_cast<double>(static_cast<T>(sum));
+        }
+      }
+    }
+  }
+  return out;
+}
+
+// The gaussian of the previous implementation, clipped at the edges of the
+// whole extent and renormalized.
+struct ClippedGaussian
+{
+  double Std;
+  int Radius;
+
+  int operator()(int i, int size, std::vector<double>& weights) const
+  {
+    const int first = std::max(i - this->Radius, 0);
+    const int last = std::min(i + this->Radius, size - 1);
+    weights.resize(last - first + 1);
+    if (this->Std == 0.0)
+    {
+      weights[0] = 1.0;
+      return first;
+    }
+    double sum = 0.0;
+    for (int j = first; j <= last; ++j)
+    {
+      const int x = j - i;
+      sum += weights[j - first] =
+        exp(-(static_cast<double>(x * x)) / (this->Std * this->Std * 2.0));
+    }
+    for (double& weight : weights)
+    {
+      weight /= sum;
+    }
+    return first;
+  }
+};
+
+// A wide gaussian, or a kernel of vtkImageSeparableConvolution centered at
+// (size - 1) / 2, with the samples beyond the edges replicated.
+struct ReplicatedKernel
+{
+  std::vector<double> Kernel;
+
+  int operator()(int i, int size, std::vector<double>& weights) const
+  {
+    const int kernelSize = static_cast<int>(this->Kernel.size());
+    const int center = (kernelSize - 1) / 2;
+    const int first = std::max(i - center, 0);
+    const int last = std::min(i + center, size - 1);
+    weights.assign(last - first + 1, 0.0);
+    for (int k = 0; k < kernelSize; ++k)
+    {
+      // the kernel is flipped, as in a convolution
+      const int j = std::min(std::max(i + center - k, 0), size - 1);
+      weights[j - first] += this->Kernel[k];
+    }
+    return first;
+  }
+};
+
+ReplicatedKernel WideGaussian(double std)
+{
+  ReplicatedKernel gaussian;
+  const int radius = static_cast<int>(std::ceil(8.0 * std));
+  double sum = 0.0;
+  for (int x = -radius; x <= radius; ++x)
+  {
+    gaussian.Kernel.push_back(std::exp(-x * x / (2.0 * std * std)));
+    sum += gaussian.Kernel.back();
+  }
+  for (double& weight : gaussian.Kernel)
+  {
+    weight /= sum;
+  }
+  return gaussian;
+}
+
+// The previous vtkImageGaussianSmooth, that filtered Z, then Y, then X.
+template <class T>
+std::vector<double> ReferenceSmooth(const std::vector<double>& in, int numComps,
+  int dimensionality, const double stds[3], const double radiusFactors[3], bool recursive)
+{
+  std::vector<double> out = in;
+  for (int axis = dimensionality - 1; axis >= 0; --axis)
+  {
+    if (recursive && stds[axis] >= 1.0)
+    {
+      out = ConvolveAxis<double>(out, numComps, axis, WideGaussian(stds[axis]));
+    }
+    else
+    {
+      const ClippedGaussian gaussian = { stds[axis],
+        static_cast<int>(stds[axis] * radiusFactors[axis]) };
+      out = ConvolveAxis<T>(out, numComps, axis, gaussian);
+    }
+  }
+  return out;
+}
+
+std::vector<double> ReferenceSmooth(int scalarType, const std::vector<double>& in, int numComps,
+  int dimensionality, const double stds[3], const double radiusFactors[3], bool recursive)
+{
+  switch (scalarType)
+  {
+    case VTK_UNSIGNED_CHAR:
+      return ReferenceSmooth<unsigned char>(
+        in, numComps, dimensionality, stds, radiusFactors, recursive);
+    case VTK_SHORT:
+      return ReferenceSmooth<short>(in, numComps, dimensionality, stds, radiusFactors, recursive);
+    case VTK_INT:
+      return ReferenceSmooth<int>(in, numComps, dimensionality, stds, radiusFactors, recursive);
+    case VTK_FLOAT:
+      return ReferenceSmooth<float>(in, numComps, dimensionality, stds, radiusFactors, recursive);
+    default:
+      return ReferenceSmooth<double>(in, numComps, dimensionality, stds, radiusFactors, recursive);
+  }
+}
+
+// Compare the piece of the output with the expected values of the whole
+// extent.
+bool Compare(vtkImageData* output, const int piece[6], const std::vector<double>& expected,
+  double tolerance, const char* name)
+{
+  vtkDataArray* scalars = output->GetPointData()->GetScalars();
+  const int numComps = scalars->GetNumberOfComponents();
+  int ijk[3];
+  for (ijk[2] = piece[4]; ijk[2] <= piece[5]; ++ijk[2])
+  {
+    for (ijk[1] = piece[2]; ijk[1] <= piece[3]; ++ijk[1])
+    {
+      for (ijk[0] = piece[0]; ijk[0] <= piece[1]; ++ijk[0])
+      {
+        const int index[3] = { ijk[0] - WholeExtent[0], ijk[1] - WholeExtent[2],
+          ijk[2] - WholeExtent[4] };
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          const double value = output->GetScalarComponentAsDouble(ijk[0], ijk[1], ijk[2], comp);
+          const double expectedValue = expected[Index(index, numComps, comp)];
+          if (!(std::abs(value - expectedValue) <= tolerance))
+          {
+            std::cerr << name << ": " << value << " instead of " << expectedValue << " at ("
+                      << ijk[0] << ", " << ijk[1] << ", " << ijk[2] << ") component " << comp
+                      << " of the piece " << piece[0] << " " << piece[1] << " " << piece[2]
+                      << " " << piece[3] << " " << piece[4] << " " << piece[5] << std::endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool TestSmooth(int scalarType, int numComps, int dimensionality, const double stds[3],
+  const double radiusFactors[3], bool recursive)
+{
+  vtkSmartPointer<vtkImageData> input = MakeImage(scalarType, numComps, 5);
+  const std::vector<double> expected = ReferenceSmooth(
+    scalarType, GetValues(input), numComps, dimensionality, stds, radiusFactors, recursive);
+
+  double tolerance = 0.0;
+  if (recursive)
+  {
+    tolerance = 1e-3 * Range;
+  }
+  else if (scalarType == VTK_FLOAT)
+  {
+    tolerance = 1e-6 * Range;
+  }
+  else if (scalarType == VTK_UNSIGNED_CHAR || scalarType == VTK_SHORT)
+  {
+    tolerance = dimensionality;
+  }
+
+  const char* name = recursive ? "Recursive vtkImageGaussianSmooth" : "vtkImageGaussianSmooth";
+  for (const int* piece : Pieces)
+  {
+    vtkNew<vtkImageGaussianSmooth> smooth;
+    smooth->SetInputData(input);
+    smooth->SetDimensionality(dimensionality);
+    smooth->SetStandardDeviations(const_cast<double*>(stds));
+    smooth->SetRadiusFactors(const_cast<double*>(radiusFactors));
+    smooth->SetRecursiveFilter(recursive);
+    smooth->UpdateExtent(piece);
+    vtkImageData* output = smooth->GetOutput();
+    if (output->GetScalarType() != scalarType ||
+      output->GetNumberOfScalarComponents() != numComps)
+    {
+      std::cerr << name << ": wrong output scalars" << std::endl;
+      return false;
+    }
+    if (!Compare(output, piece, expected, tolerance, name))
+    {
+      std::cerr << name << " of " << output->GetScalarTypeAsString() << " scalars with "
+                << numComps << " components in " << dimensionality << "D failed" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestSeparableConvolution(int scalarType)
+{
+  vtkSmartPointer<vtkImageData> input = MakeImage(scalarType, 1, 7);
+
+  // asymmetric kernels, to check that they are flipped, and no Y kernel
+  vtkNew<vtkFloatArray> xKernel;
+  for (float weight : { 0.1f, 0.5f, 0.3f, 0.05f, 0.05f })
+  {
+    xKernel->InsertNextValue(weight);
+  }
+  vtkNew<vtkFloatArray> zKernel;
+  for (float weight : { 0.25f, 0.7f, -0.125f })
+  {
+    zKernel->InsertNextValue(weight);
+  }
+
+  std::vector<double> expected = GetValues(input);
+  ReplicatedKernel kernel;
+  kernel.Kernel.assign(xKernel->GetPointer(0), xKernel->GetPointer(0) + 5);
+  expected = ConvolveAxis<double>(expected, 1, 0, kernel);
+  kernel.Kernel.assign(zKernel->GetPointer(0), zKernel->GetPointer(0) + 3);
+  expected = ConvolveAxis<double>(expected, 1, 2, kernel);
+
+  for (const int* piece : Pieces)
+  {
+    vtkNew<vtkImageSeparableConvolution> convolution;
+    convolution->SetInputData(input);
+    convolution->SetXKernel(xKernel);
+    convolution->SetZKernel(zKernel);
+    convolution->UpdateExtent(piece);
+    vtkImageData* output = convolution->GetOutput();
+    if (output->GetScalarType() != VTK_FLOAT)
+    {
+      std::cerr << "vtkImageSeparableConvolution: wrong output scalars" << std::endl;
+      return false;
+    }
+    if (!Compare(output, piece, expected, 1e-6 * Range, "vtkImageSeparableConvolution"))
+    {
+      std::cerr << "vtkImageSeparableConvolution of " << input->GetScalarTypeAsString()
+                << " scalars failed" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestImageGaussianSmooth(int, char*[])
+{
+  // Z has no filtering in the first case, a kernel of one sample
+  const double stds[][3] = { { 2.0, 1.5, 0.0 }, { 1.2, 0.6, 2.5 } };
+  const double radiusFactors[][3] = { { 1.5, 2.0, 3.0 }, { 2.0, 3.0, 1.5 } };
+  const int scalarTypes[] = { VTK_DOUBLE, VTK_INT, VTK_FLOAT, VTK_SHORT, VTK_UNSIGNED_CHAR };
+
+  bool success = true;
+  for (int scalarType : scalarTypes)
+  {
+    for (int dimensionality = 1; dimensionality <= 3; ++dimensionality)
+    {
+      for (int i = 0; i < 2; ++i)
+      {
+        success &= TestSmooth(scalarType, 1, dimensionality, stds[i], radiusFactors[i], false);
+      }
+    }
+    success &= TestSmooth(scalarType, 3, 3, stds[1], radiusFactors[1], false);
+    success &= TestSeparableConvolution(scalarType);
+  }
+
+  // The axes with a standard deviation below one pixel are still convolved
+  // with the kernel by the recursive filter.
+  const double recursiveStds[][3] = { { 3.0, 1.0, 0.5 }, { 1.5, 6.0, 2.0 } };
+  for (int dimensionality = 1; dimensionality <= 3; ++dimensionality)
+  {
+    for (int i = 0; i < 2; ++i)
+    {
+      success &=
+        TestSmooth(VTK_DOUBLE, 1, dimensionality, recursiveStds[i], radiusFactors[i], true);
+    }
+  }
+  success &= TestSmooth(VTK_DOUBLE, 2, 3, recursiveStds[1], radiusFactors[1], true);
+  success &= TestSmooth(VTK_FLOAT, 1, 3, recursiveStds[0], radiusFactors[0], true);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
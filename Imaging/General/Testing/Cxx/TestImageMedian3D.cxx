@@ -0,0 +1,187 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageMedian3D.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the Histogram and SortingNetwork algorithms of
+// vtkImageMedian3D, and the Automatic choice between them, give exactly the
+// medians of the Selection algorithm, for all the scalar types, for odd,
+// even and one sample wide kernels, with one or two components, and for
+// pieces of the whole extent at and away from its boundaries.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageMedian3D.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+const int WholeExtent[6] = { 2, 24, -1, 15, 0, 10 };
+
+// Pieces of the whole extent, touching or away from its boundaries
+const int Pieces[][6] = {
+  { 2, 24, -1, 15, 0, 10 },
+  { 2, 9, -1, 4, 0, 2 },
+  { 6, 17, 3, 11, 4, 7 },
+  { 20, 24, 12, 15, 8, 10 },
+  { 13, 13, 7, 7, 5, 5 },
+};
+
+const int KernelSizes[][3] = {
+  { 1, 1, 1 },
+  { 3, 3, 3 },
+  { 2, 2, 2 },
+  { 4, 4, 1 },
+  { 5, 3, 2 },
+  { 6, 1, 5 },
+  { 1, 7, 1 },
+  { 7, 7, 7 },
+  { 9, 9, 1 },
+};
+
+// Random values in [minimum, minimum + range), with a fractional part for
+// the floating point types. The small ranges have many ties.
+vtkSmartPointer<vtkImageData> MakeImage(int scalarType, int numComps, double minimum, double range)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(const_cast<int*>(WholeExtent));
+  image->AllocateScalars(scalarType, numComps);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(11);
+  const bool integer = scalarType != VTK_FLOAT && scalarType != VTK_DOUBLE;
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+  {
+    random->Next();
+    double value = range * random->GetValue();
+    value = minimum + (integer ? std::floor(value) : std::floor(8.0 * value) / 8.0);
+    scalars->SetComponent(i / numComps, static_cast<int>(i % numComps), value);
+  }
+  return image;
+}
+
+vtkSmartPointer<vtkImageData> Run(
+  vtkImageData* input, const int kernelSize[3], int algorithm, const int piece[6])
+{
+  vtkNew<vtkImageMedian3D> median;
+  median->SetInputData(input);
+  median->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+  median->SetAlgorithm(algorithm);
+  median->UpdateExtent(piece);
+  vtkSmartPointer<vtkImageData> output = vtkSmartPointer<vtkImageData>::New();
+  output->ShallowCopy(median->GetOutput());
+  return output;
+}
+
+// Compare the piece of the output with the medians of the whole extent.
+bool Compare(vtkImageData* output, vtkImageData* expected, const int piece[6])
+{
+  if (output->GetScalarType() != expected->GetScalarType() ||
+    output->GetNumberOfScalarComponents() != expected->GetNumberOfScalarComponents())
+  {
+    std::cerr << "Wrong output scalars" << std::endl;
+    return false;
+  }
+  for (int k = piece[4]; k <= piece[5]; ++k)
+  {
+    for (int j = piece[2]; j <= piece[3]; ++j)
+    {
+      for (int i = piece[0]; i <= piece[1]; ++i)
+      {
+        for (int c = 0; c < output->GetNumberOfScalarComponents(); ++c)
+        {
+          const double value = output->GetScalarComponentAsDouble(i, j, k, c);
+          const double expectedValue = expected->GetScalarComponentAsDouble(i, j, k, c);
+          if (value != expectedValue)
+          {
+            std::cerr << value << " instead of " << expectedValue << " at (" << i << ", " << j
+                      << ", " << k << ") component " << c << std::endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool TestImage(vtkImageData* input)
+{
+  const int algorithms[] = { vtkImageMedian3D::Selection, vtkImageMedian3D::Histogram,
+    vtkImageMedian3D::SortingNetwork, vtkImageMedian3D::Automatic };
+  for (const int* kernelSize : KernelSizes)
+  {
+    vtkSmartPointer<vtkImageData> expected =
+      Run(input, kernelSize, vtkImageMedian3D::Selection, WholeExtent);
+    for (int algorithm : algorithms)
+    {
+      for (const int* piece : Pieces)
+      {
+        vtkSmartPointer<vtkImageData> output = Run(input, kernelSize, algorithm, piece);
+        if (!Compare(output, expected, piece))
+        {
+          vtkNew<vtkImageMedian3D> median;
+          median->SetAlgorithm(algorithm);
+          std::cerr << median->GetAlgorithmAsString() << " differs from Selection for "
+                    << input->GetScalarTypeAsString() << " scalars with "
+                    << input->GetNumberOfScalarComponents() << " components, a kernel size of "
+                    << kernelSize[0] << " " << kernelSize[1] << " " << kernelSize[2]
+                    << " and the piece " << piece[0] << " " << piece[1] << " " << piece[2] << " "
+                    << piece[3] << " " << piece[4] << " " << piece[5] << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestImageMedian3D(int, char*[])
+{
+  struct
+  {
+    int ScalarType;
+    double Minimum;
+    double Range;
+  } cases[] = {
+    { VTK_UNSIGNED_CHAR, 0, 256 },
+    { VTK_UNSIGNED_CHAR, 100, 4 },
+    { VTK_SIGNED_CHAR, -128, 256 },
+    { VTK_CHAR, -20, 40 },
+    { VTK_SHORT, -32768, 65536 },
+    { VTK_SHORT, -300, 600 },
+    { VTK_UNSIGNED_SHORT, 0, 65536 },
+    { VTK_UNSIGNED_SHORT, 60000, 5 },
+    { VTK_INT, -100000, 200000 },
+    { VTK_FLOAT, -50, 100 },
+    { VTK_FLOAT, 0, 2 },
+    { VTK_DOUBLE, -1e6, 2e6 },
+  };
+
+  bool success = true;
+  for (const auto& c : cases)
+  {
+    for (int numComps = 1; numComps <= 2; ++numComps)
+    {
+      success &= TestImage(MakeImage(c.ScalarType, numComps, c.Minimum, c.Range));
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -14,13 +14,20 @@
 =========================================================================*/
 #include "vtkImageEuclideanDistance.h"
 
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageEuclideanDistance);
 
@@ -32,6 +39,8 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
   this->Initialize = 1;
   this->ConsiderAnisotropy = 1;
   this->Algorithm = VTK_EDT_SAITO;
+  this->OutputScalarType = VTK_DOUBLE;
+  this->ComputeFeatureIds = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -39,7 +48,8 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
 int vtkImageEuclideanDistance::IterativeRequestInformation(
   vtkInformation* vtkNotUsed(input), vtkInformation* output)
 {
-  vtkDataObject::SetPointDataActiveScalarInfo(output, VTK_DOUBLE, 1);
+  vtkDataObject::SetPointDataActiveScalarInfo(
+    output, this->OutputScalarType == VTK_FLOAT ? VTK_FLOAT : VTK_DOUBLE, 1);
   return 1;
 }
 
@@ -57,17 +67,17 @@ int vtkImageEuclideanDistance::IterativeRequestUpdateExtent(
 
 //------------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
-// is always doubles.
-template <class TT>
+// is always floats or doubles.
+template <class TT, class TOut>
 void vtkImageEuclideanDistanceCopyData(vtkImageEuclideanDistance* self, vtkImageData* inData,
-  TT* inPtr, vtkImageData* outData, int outExt[6], double* outPtr)
+  TT* inPtr, vtkImageData* outData, int outExt[6], TOut* outPtr)
 {
   vtkIdType inInc0, inInc1, inInc2;
   TT *inPtr0, *inPtr1, *inPtr2;
 
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  TOut *outPtr0, *outPtr1, *outPtr2;
 
   int idx0, idx1, idx2;
 
@@ -89,7 +99,7 @@ void vtkImageEuclideanDistanceCopyData(vtkImageEuclideanDistance* self, vtkImage
 
       for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
       {
-        *outPtr0 = *inPtr0;
+        *outPtr0 = static_cast<TOut>(*inPtr0);
         inPtr0 += inInc0;
         outPtr0 += outInc0;
       }
@@ -103,17 +113,17 @@ void vtkImageEuclideanDistanceCopyData(vtkImageEuclideanDistance* self, vtkImage
 
 //------------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
-// is always doubles.
-template <class T>
+// is always floats or doubles.
+template <class T, class TOut>
 void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance* self, vtkImageData* inData,
-  T* inPtr, vtkImageData* outData, int outExt[6], double* outPtr)
+  T* inPtr, vtkImageData* outData, int outExt[6], TOut* outPtr)
 {
   vtkIdType inInc0, inInc1, inInc2;
   T *inPtr0, *inPtr1, *inPtr2;
 
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  TOut *outPtr0, *outPtr1, *outPtr2;
 
   int idx0, idx1, idx2;
   double maxDist;
@@ -149,7 +159,7 @@ void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance* self, vtkIma
           }
           else
           {
-            *outPtr0 = maxDist;
+            *outPtr0 = static_cast<TOut>(maxDist);
           }
 
           inPtr0 += inInc0;
@@ -166,8 +176,7 @@ void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance* self, vtkIma
   else
   // No initialization required. We just copy inData to outData.
   {
-    vtkImageEuclideanDistanceCopyData(
-      self, inData, static_cast<T*>(inPtr), outData, outExt, static_cast<double*>(outPtr));
+    vtkImageEuclideanDistanceCopyData(self, inData, inPtr, outData, outExt, outPtr);
   }
 }
 
@@ -180,13 +189,14 @@ void vtkImageEuclideanDistanceInitialize(vtkImageEuclideanDistance* self, vtkIma
 //
 // Notations stay as close as possible to those used in the paper.
 //
-static void vtkImageEuclideanDistanceExecuteSaito(
-  vtkImageEuclideanDistance* self, vtkImageData* outData, int outExt[6], double* outPtr)
+template <class T>
+void vtkImageEuclideanDistanceExecuteSaito(
+  vtkImageEuclideanDistance* self, vtkImageData* outData, int outExt[6], T* outPtr)
 {
 
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  T *outPtr0, *outPtr1, *outPtr2;
   int idx0, idx1, idx2, inSize0;
   double maxDist;
   double* sq;
@@ -244,7 +254,7 @@ static void vtkImageEuclideanDistanceExecuteSaito(
             df++;
             if (sq[df] < *outPtr0)
             {
-              *outPtr0 = sq[df];
+              *outPtr0 = static_cast<T>(sq[df]);
             }
           }
           else
@@ -263,7 +273,7 @@ static void vtkImageEuclideanDistanceExecuteSaito(
             df++;
             if (sq[df] < *outPtr0)
             {
-              *outPtr0 = sq[df];
+              *outPtr0 = static_cast<T>(sq[df]);
             }
           }
           else
@@ -324,7 +334,7 @@ static void vtkImageEuclideanDistanceExecuteSaito(
               }
               else if (m < *(outPtr0 + n * outInc0))
               {
-                *(outPtr0 + n * outInc0) = m;
+                *(outPtr0 + n * outInc0) = static_cast<T>(m);
               }
             }
             a = b;
@@ -365,7 +375,7 @@ static void vtkImageEuclideanDistanceExecuteSaito(
               }
               else if (m < *(outPtr0 - n * outInc0))
               {
-                *(outPtr0 - n * outInc0) = m;
+                *(outPtr0 - n * outInc0) = static_cast<T>(m);
               }
             }
             a = b;
@@ -391,20 +401,22 @@ static void vtkImageEuclideanDistanceExecuteSaito(
 //------------------------------------------------------------------------------
 // Execute Saito's algorithm, modified for Cache Efficiency
 //
-static void vtkImageEuclideanDistanceExecuteSaitoCached(
-  vtkImageEuclideanDistance* self, vtkImageData* outData, int outExt[6], double* outPtr)
+template <class T>
+void vtkImageEuclideanDistanceExecuteSaitoCached(
+  vtkImageEuclideanDistance* self, vtkImageData* outData, int outExt[6], T* outPtr)
 {
 
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  T *outPtr0, *outPtr1, *outPtr2;
   //
   int idx0, idx1, idx2, inSize0;
 
   double maxDist;
 
   double* sq;
-  double *buff, *temp, buffer;
+  double *buff, buffer;
+  T* temp;
   int df, a, b, n;
   double m;
 
@@ -418,7 +430,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
   maxDist = self->GetMaximumDistance();
 
   buff = static_cast<double*>(calloc(outMax0 + 1, sizeof(double)));
-  temp = static_cast<double*>(calloc(outMax0 + 1, sizeof(double)));
+  temp = static_cast<T*>(calloc(outMax0 + 1, sizeof(T)));
 
   // precompute sq[]. Anisotropy is handled here by using Spacing information
   sq = static_cast<double*>(calloc(inSize0 * 2 + 2, sizeof(double)));
@@ -458,7 +470,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
             df++;
             if (sq[df] < *outPtr0)
             {
-              *outPtr0 = sq[df];
+              *outPtr0 = static_cast<T>(sq[df]);
             }
           }
           else
@@ -478,7 +490,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
             df++;
             if (sq[df] < *outPtr0)
             {
-              *outPtr0 = sq[df];
+              *outPtr0 = static_cast<T>(sq[df]);
             }
           }
           else
@@ -506,7 +518,8 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
         outPtr0 = outPtr1;
         for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
         {
-          temp[idx0] = buff[idx0] = *outPtr0;
+          buff[idx0] = *outPtr0;
+          temp[idx0] = *outPtr0;
           outPtr0 += outInc0;
         }
 
@@ -540,7 +553,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
               }
               else if (m < *(outPtr0 + n))
               {
-                *(outPtr0 + n) = m;
+                *(outPtr0 + n) = static_cast<T>(m);
               }
             }
             a = b;
@@ -580,7 +593,7 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
               }
               else if (m < *(outPtr0 - n))
               {
-                *(outPtr0 - n) = m;
+                *(outPtr0 - n) = static_cast<T>(m);
               }
             }
             a = b;
@@ -611,6 +624,275 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
   free(temp);
   free(sq);
 }
+//------------------------------------------------------------------------------
+// Computes the lower envelope of the parabolas w*(x-q)^2 + f[q] of a row, as
+// described in
+//
+// P. F. Felzenszwalb and D. P. Huttenlocher. Distance Transforms of Sampled
+// Functions. Theory of Computing, 8(19). pp. 415--428, 2012.
+//
+// which gives the exact squared distances along the row in linear time. The
+// features of the row, if any, are replaced by those of the lowest parabolas.
+class vtkImageEuclideanDistanceEnvelope
+{
+public:
+  vtkImageEuclideanDistanceEnvelope(vtkIdType n, bool features)
+    : Vertices(n)
+    , Bounds(n + 1)
+    , Values(n)
+    , Features(features ? n : 0)
+  {
+  }
+
+  void operator()(double* f, vtkIdType* features, vtkIdType n, double w)
+  {
+    vtkIdType* v = this->Vertices.data();
+    double* z = this->Bounds.data();
+    vtkIdType k = 0;
+    v[0] = 0;
+    z[0] = -std::numeric_limits<double>::infinity();
+    z[1] = std::numeric_limits<double>::infinity();
+    for (vtkIdType q = 1; q < n; ++q)
+    {
+      double s = Intersection(f, w, v[k], q);
+      while (s <= z[k])
+      {
+        --k;
+        s = Intersection(f, w, v[k], q);
+      }
+      ++k;
+      v[k] = q;
+      z[k] = s;
+      z[k + 1] = std::numeric_limits<double>::infinity();
+    }
+
+    k = 0;
+    for (vtkIdType q = 0; q < n; ++q)
+    {
+      while (z[k + 1] < q)
+      {
+        ++k;
+      }
+      const vtkIdType p = v[k];
+      this->Values[q] = w * (q - p) * (q - p) + f[p];
+      if (features)
+      {
+        this->Features[q] = features[p];
+      }
+    }
+    std::copy(this->Values.begin(), this->Values.end(), f);
+    std::copy(this->Features.begin(), this->Features.end(), features);
+  }
+
+private:
+  // Abscissa where the parabolas of q and p (p < q) intersect
+  static double Intersection(const double* f, double w, vtkIdType p, vtkIdType q)
+  {
+    return ((f[q] + w * q * q) - (f[p] + w * p * p)) / (2.0 * w * (q - p));
+  }
+
+  std::vector<vtkIdType> Vertices;
+  std::vector<double> Bounds;
+  std::vector<double> Values;
+  std::vector<vtkIdType> Features;
+};
+
+//------------------------------------------------------------------------------
+// Number of rows that are copied together, so that the copies read whole cache
+// lines when the rows are not contiguous.
+const vtkIdType vtkImageEuclideanDistanceBlockSize = 16;
+
+//------------------------------------------------------------------------------
+// Applies the envelope to all the rows of the output along one axis. The rows
+// that are not contiguous are copied by blocks, whose values are adjacent in
+// memory.
+template <class T>
+class vtkImageEuclideanDistanceRows
+{
+public:
+  vtkImageEuclideanDistanceRows(
+    T* data, vtkIdType* features, const int dims[3], int axis, double spacing, double maxDist)
+    : Data(data)
+    , FeatureIds(features)
+    , Size(dims[axis])
+    , Stride(1)
+    , NumberOfRows(1)
+    , Weight(spacing * spacing)
+    , MaximumDistance(maxDist)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      if (i < axis)
+      {
+        this->Stride *= dims[i];
+      }
+      else if (i > axis)
+      {
+        this->NumberOfRows *= dims[i];
+      }
+    }
+    const vtkIdType blockSize = vtkImageEuclideanDistanceBlockSize;
+    this->NumberOfBlocks = (this->Stride + blockSize - 1) / blockSize;
+  }
+
+  vtkIdType GetNumberOfItems() const { return this->NumberOfRows * this->NumberOfBlocks; }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const vtkIdType n = this->Size;
+    const vtkIdType stride = this->Stride;
+    const vtkIdType blockSize = vtkImageEuclideanDistanceBlockSize;
+    vtkIdType* features = this->FeatureIds;
+    vtkImageEuclideanDistanceEnvelope envelope(n, features != nullptr);
+    std::vector<double> rows(blockSize * n);
+    std::vector<vtkIdType> featureRows(features ? blockSize * n : 0);
+    for (vtkIdType item = begin; item < end; ++item)
+    {
+      const vtkIdType first = (item % this->NumberOfBlocks) * blockSize;
+      const vtkIdType count = std::min(blockSize, stride - first);
+      const vtkIdType offset = (item / this->NumberOfBlocks) * stride * n + first;
+
+      for (vtkIdType k = 0; k < n; ++k)
+      {
+        const T* in = this->Data + offset + k * stride;
+        for (vtkIdType j = 0; j < count; ++j)
+        {
+          rows[j * n + k] = std::min(static_cast<double>(in[j]), this->MaximumDistance);
+        }
+        if (features)
+        {
+          const vtkIdType* inFeatures = features + offset + k * stride;
+          for (vtkIdType j = 0; j < count; ++j)
+          {
+            featureRows[j * n + k] = inFeatures[j];
+          }
+        }
+      }
+
+      for (vtkIdType j = 0; j < count; ++j)
+      {
+        envelope(&rows[j * n], features ? &featureRows[j * n] : nullptr, n, this->Weight);
+      }
+
+      for (vtkIdType k = 0; k < n; ++k)
+      {
+        T* out = this->Data + offset + k * stride;
+        for (vtkIdType j = 0; j < count; ++j)
+        {
+          out[j] = static_cast<T>(rows[j * n + k]);
+        }
+        if (features)
+        {
+          vtkIdType* outFeatures = features + offset + k * stride;
+          for (vtkIdType j = 0; j < count; ++j)
+          {
+            outFeatures[j] = featureRows[j * n + k];
+          }
+        }
+      }
+    }
+  }
+
+private:
+  T* Data;
+  vtkIdType* FeatureIds;
+  vtkIdType Size;
+  vtkIdType Stride;
+  vtkIdType NumberOfRows;
+  vtkIdType NumberOfBlocks;
+  double Weight;
+  double MaximumDistance;
+};
+
+//------------------------------------------------------------------------------
+// Execute Felzenszwalb's algorithm along all the axes, in place in the output.
+// The rows along each axis are independent, and processed in parallel.
+template <class TOut>
+void vtkImageEuclideanDistanceExecuteFelzenszwalb(vtkImageEuclideanDistance* self,
+  vtkImageData* inData, void* inPtr, vtkImageData* outData, int outExt[6], TOut* outPtr)
+{
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkImageEuclideanDistanceInitialize(
+      self, inData, static_cast<VTK_TT*>(inPtr), outData, outExt, outPtr));
+    default:
+      vtkErrorWithObjectMacro(self, << "Execute: Unknown ScalarType");
+      return;
+  }
+
+  // Each voxel that has a distance is its own feature. The voxels set to the
+  // maximum distance hold it rounded to the output type.
+  const double maxDist = self->GetMaximumDistance();
+  const TOut outMaxDist = static_cast<TOut>(maxDist);
+  vtkIdType* features = nullptr;
+  if (self->GetComputeFeatureIds())
+  {
+    vtkNew<vtkIdTypeArray> featureIds;
+    featureIds->SetName("FeatureIds");
+    featureIds->SetNumberOfValues(outData->GetNumberOfPoints());
+    outData->GetPointData()->AddArray(featureIds);
+    features = featureIds->GetPointer(0);
+    vtkSMPTools::For(0, featureIds->GetNumberOfValues(), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType id = begin; id < end; ++id)
+      {
+        features[id] = outPtr[id] < outMaxDist ? id : -1;
+      }
+    });
+  }
+
+  int dims[3];
+  outData->GetDimensions(dims);
+  const int numberOfAxes = self->GetDimensionality();
+  for (int axis = 0; axis < numberOfAxes && !self->GetAbortExecute(); ++axis)
+  {
+    const double spacing = self->GetConsiderAnisotropy() ? outData->GetSpacing()[axis] : 1.0;
+    vtkImageEuclideanDistanceRows<TOut> rows(outPtr, features, dims, axis, spacing, maxDist);
+    vtkSMPTools::For(0, rows.GetNumberOfItems(), rows);
+    self->UpdateProgress((axis + 1.0) / numberOfAxes);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Executes one iteration of Saito's algorithms.
+template <class TOut>
+void vtkImageEuclideanDistanceExecute(vtkImageEuclideanDistance* self, vtkImageData* inData,
+  void* inPtr, vtkImageData* outData, int outExt[6], TOut* outPtr)
+{
+  if (self->GetIteration() == 0)
+  {
+    switch (inData->GetScalarType())
+    {
+      vtkTemplateMacro(vtkImageEuclideanDistanceInitialize(
+        self, inData, static_cast<VTK_TT*>(inPtr), outData, outExt, outPtr));
+      default:
+        vtkErrorWithObjectMacro(self, << "Execute: Unknown ScalarType");
+        return;
+    }
+  }
+  else
+  {
+    if (inData != outData)
+      switch (inData->GetScalarType())
+      {
+        vtkTemplateMacro(vtkImageEuclideanDistanceCopyData(
+          self, inData, static_cast<VTK_TT*>(inPtr), outData, outExt, outPtr));
+      }
+  }
+
+  // Call the specific algorithms.
+  switch (self->GetAlgorithm())
+  {
+    case VTK_EDT_SAITO:
+      vtkImageEuclideanDistanceExecuteSaito(self, outData, outExt, outPtr);
+      break;
+    case VTK_EDT_SAITO_CACHED:
+      vtkImageEuclideanDistanceExecuteSaitoCached(self, outData, outExt, outPtr);
+      break;
+    default:
+      vtkErrorWithObjectMacro(self, << "Execute: Unknown Algorithm");
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkImageEuclideanDistance::AllocateOutputScalars(
   vtkImageData* outData, int outExt[6], vtkInformation* outInfo)
@@ -619,6 +901,64 @@ void vtkImageEuclideanDistance::AllocateOutputScalars(
   outData->AllocateScalars(outInfo);
 }
 
+//------------------------------------------------------------------------------
+// Felzenszwalb's algorithm processes all the axes at once, instead of one per
+// iteration, which saves the intermediate images.
+int vtkImageEuclideanDistance::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (this->Algorithm != VTK_EDT_FELZENSZWALB)
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkImageData* inData = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* outData = vtkImageData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  int outExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), outExt);
+  this->AllocateOutputScalars(outData, outExt, outInfo);
+
+  vtkDebugMacro(<< "Executing image euclidean distance");
+
+  void* inPtr = inData->GetScalarPointerForExtent(
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()));
+  void* outPtr = outData->GetScalarPointer();
+
+  if (!inPtr)
+  {
+    vtkErrorMacro(<< "Execute: No scalars for update extent.");
+    return 1;
+  }
+
+  // this filter expects input to have 1 components
+  if (outData->GetNumberOfScalarComponents() != 1)
+  {
+    vtkErrorMacro(<< "Execute: Cannot handle more than 1 components");
+    return 1;
+  }
+
+  // The initialization does not permute the axes
+  this->Iteration = 0;
+  switch (outData->GetScalarType())
+  {
+    case VTK_FLOAT:
+      vtkImageEuclideanDistanceExecuteFelzenszwalb(
+        this, inData, inPtr, outData, outExt, static_cast<float*>(outPtr));
+      break;
+    case VTK_DOUBLE:
+      vtkImageEuclideanDistanceExecuteFelzenszwalb(
+        this, inData, inPtr, outData, outExt, static_cast<double*>(outPtr));
+      break;
+    default:
+      vtkErrorMacro(<< "Execute: Output must be type float or double.");
+  }
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // This method is passed input and output Datas, and executes the
 // EuclideanDistance algorithm to fill the output from the input.
@@ -660,13 +1000,6 @@ int vtkImageEuclideanDistance::IterativeRequestData(vtkInformation* vtkNotUsed(r
     }
   }
 
-  // this filter expects that the output be doubles.
-  if (outData->GetScalarType() != VTK_DOUBLE)
-  {
-    vtkErrorMacro(<< "Execute: Output must be type double.");
-    return 1;
-  }
-
   // this filter expects input to have 1 components
   if (outData->GetNumberOfScalarComponents() != 1)
   {
@@ -674,39 +1007,20 @@ int vtkImageEuclideanDistance::IterativeRequestData(vtkInformation* vtkNotUsed(r
     return 1;
   }
 
-  if (this->GetIteration() == 0)
-  {
-    switch (inData->GetScalarType())
-    {
-      vtkTemplateMacro(vtkImageEuclideanDistanceInitialize(
-        this, inData, static_cast<VTK_TT*>(inPtr), outData, outExt, static_cast<double*>(outPtr)));
-      default:
-        vtkErrorMacro(<< "Execute: Unknown ScalarType");
-        return 1;
-    }
-  }
-  else
-  {
-    if (inData != outData)
-      switch (inData->GetScalarType())
-      {
-        vtkTemplateMacro(vtkImageEuclideanDistanceCopyData(this, inData,
-          static_cast<VTK_TT*>(inPtr), outData, outExt, static_cast<double*>(outPtr)));
-      }
-  }
-
-  // Call the specific algorithms.
-  switch (this->GetAlgorithm())
+  // this filter expects that the output be floats or doubles.
+  switch (outData->GetScalarType())
   {
-    case VTK_EDT_SAITO:
-      vtkImageEuclideanDistanceExecuteSaito(this, outData, outExt, static_cast<double*>(outPtr));
+    case VTK_FLOAT:
+      vtkImageEuclideanDistanceExecute(
+        this, inData, inPtr, outData, outExt, static_cast<float*>(outPtr));
       break;
-    case VTK_EDT_SAITO_CACHED:
-      vtkImageEuclideanDistanceExecuteSaitoCached(
-        this, outData, outExt, static_cast<double*>(outPtr));
+    case VTK_DOUBLE:
+      vtkImageEuclideanDistanceExecute(
+        this, inData, inPtr, outData, outExt, static_cast<double*>(outPtr));
       break;
     default:
-      vtkErrorMacro(<< "Execute: Unknown Algorithm");
+      vtkErrorMacro(<< "Execute: Output must be type float or double.");
+      return 1;
   }
 
   this->UpdateProgress((this->GetIteration() + 1.0) / 3.0);
@@ -731,8 +1045,16 @@ void vtkImageEuclideanDistance::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << "Saito\n";
   }
+  else if (this->Algorithm == VTK_EDT_FELZENSZWALB)
+  {
+    os << "Felzenszwalb\n";
+  }
   else
   {
     os << "Saito Cached\n";
   }
+
+  os << indent << "Output Scalar Type: " << vtkImageScalarTypeNameMacro(this->OutputScalarType)
+     << "\n";
+  os << indent << "Compute Feature Ids: " << (this->ComputeFeatureIds ? "On\n" : "Off\n");
 }
@@ -31,6 +31,14 @@
  * slow it very significantly. In that case, one should use
  * vtkImageEuclideanDistance::SetAlgorithmToSaitoCached() instead for better performance.
  *
+ * SetAlgorithmToFelzenszwalb() selects Felzenszwalb and Huttenlocher's
+ * algorithm, which computes the exact distances in linear time by taking the
+ * lower envelope of parabolas along each axis. It should be preferred for
+ * large images: all the axes are processed at once in the output, without
+ * intermediate images, and the rows along each axis are processed in
+ * parallel with vtkSMPTools. It can also compute the feature transform (see
+ * ComputeFeatureIds).
+ *
  * References:
  *
  * T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance
@@ -40,6 +48,9 @@
  * O. Cuisenaire. Distance Transformation: fast algorithms and applications
  * to medical image processing. PhD Thesis, Universite catholique de Louvain,
  * October 1999. http://ltswww.epfl.ch/~cuisenai/papers/oc_thesis.pdf
+ *
+ * P. F. Felzenszwalb and D. P. Huttenlocher. Distance Transforms of Sampled
+ * Functions. Theory of Computing, 8(19). pp. 415--428, 2012.
  */
 
 #ifndef vtkImageEuclideanDistance_h
@@ -50,6 +61,7 @@
 
 #define VTK_EDT_SAITO_CACHED 0
 #define VTK_EDT_SAITO 1
+#define VTK_EDT_FELZENSZWALB 2
 
 class VTKIMAGINGGENERAL_EXPORT vtkImageEuclideanDistance : public vtkImageDecomposeFilter
 {
@@ -94,12 +106,39 @@ public:
    * Selects a Euclidean DT algorithm.
    * 1. Saito
    * 2. Saito-cached
-   * More algorithms will be added later on.
+   * 3. Felzenszwalb
    */
   vtkSetMacro(Algorithm, int);
   vtkGetMacro(Algorithm, int);
   void SetAlgorithmToSaito() { this->SetAlgorithm(VTK_EDT_SAITO); }
   void SetAlgorithmToSaitoCached() { this->SetAlgorithm(VTK_EDT_SAITO_CACHED); }
+  void SetAlgorithmToFelzenszwalb() { this->SetAlgorithm(VTK_EDT_FELZENSZWALB); }
+  ///@}
+
+  ///@{
+  /**
+   * Set the scalar type of the output, VTK_DOUBLE (the default) or VTK_FLOAT,
+   * which halves the size of the distance map. Floats hold the squared
+   * distances exactly up to 2^24, that is, distances of 4096 voxels.
+   */
+  vtkSetMacro(OutputScalarType, int);
+  vtkGetMacro(OutputScalarType, int);
+  void SetOutputScalarTypeToFloat() { this->SetOutputScalarType(VTK_FLOAT); }
+  void SetOutputScalarTypeToDouble() { this->SetOutputScalarType(VTK_DOUBLE); }
+  ///@}
+
+  ///@{
+  /**
+   * With the Felzenszwalb algorithm, also compute the feature transform: a
+   * "FeatureIds" point data array with, for each voxel, the id of the voxel
+   * its distance is measured from, that is, with Initialize on, of its
+   * nearest zero voxel (or -1 if it is farther than MaximumDistance). Looking
+   * up a label image with these ids gives the Voronoi partition of its
+   * labels. Off by default.
+   */
+  vtkSetMacro(ComputeFeatureIds, vtkTypeBool);
+  vtkGetMacro(ComputeFeatureIds, vtkTypeBool);
+  vtkBooleanMacro(ComputeFeatureIds, vtkTypeBool);
   ///@}
 
   int IterativeRequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
@@ -112,10 +151,14 @@ protected:
   vtkTypeBool Initialize;
   vtkTypeBool ConsiderAnisotropy;
   int Algorithm;
+  int OutputScalarType;
+  vtkTypeBool ComputeFeatureIds;
 
   // Replaces "EnlargeOutputUpdateExtent"
   virtual void AllocateOutputScalars(vtkImageData* outData, int outExt[6], vtkInformation* outInfo);
 
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
   int IterativeRequestInformation(vtkInformation* in, vtkInformation* out) override;
   int IterativeRequestUpdateExtent(vtkInformation* in, vtkInformation* out) override;
 
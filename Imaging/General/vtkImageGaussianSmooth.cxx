@@ -17,10 +17,15 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkImageSeparableKernel.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageGaussianSmooth);
 
@@ -34,6 +39,7 @@ vtkImageGaussianSmooth::vtkImageGaussianSmooth()
   this->RadiusFactors[0] = 1.5;
   this->RadiusFactors[1] = 1.5;
   this->RadiusFactors[2] = 1.5;
+  this->RecursiveFilter = false;
 }
 
 //------------------------------------------------------------------------------
@@ -55,6 +61,8 @@ void vtkImageGaussianSmooth::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "StandardDeviations: ( " << this->StandardDeviations[0] << ", "
      << this->StandardDeviations[1] << ", " << this->StandardDeviations[2] << " )\n";
+
+  os << indent << "RecursiveFilter: " << (this->RecursiveFilter ? "On\n" : "Off\n");
 }
 
 //------------------------------------------------------------------------------
@@ -84,6 +92,14 @@ void vtkImageGaussianSmooth::ComputeKernel(double* kernel, int min, int max, dou
   }
 }
 
+//------------------------------------------------------------------------------
+// Whether the axis is filtered recursively instead of with the kernel
+bool vtkImageGaussianSmooth::UseRecursion(int axis)
+{
+  return this->RecursiveFilter &&
+    this->StandardDeviations[axis] >= vtkImageRecursiveGaussian::GetMinimumStandardDeviation();
+}
+
 //------------------------------------------------------------------------------
 int vtkImageGaussianSmooth::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -114,6 +130,12 @@ void vtkImageGaussianSmooth::InternalRequestUpdateExtent(int* inExt, int* wholeE
   // Expand filtered axes
   for (idx = 0; idx < this->Dimensionality; ++idx)
   {
+    if (this->UseRecursion(idx))
+    {
+      inExt[idx * 2] = wholeExtent[idx * 2];
+      inExt[idx * 2 + 1] = wholeExtent[idx * 2 + 1];
+      continue;
+    }
     radius = static_cast<int>(this->StandardDeviations[idx] * this->RadiusFactors[idx]);
     inExt[idx * 2] -= radius;
     if (inExt[idx * 2] < wholeExtent[idx * 2])
@@ -130,212 +152,208 @@ void vtkImageGaussianSmooth::InternalRequestUpdateExtent(int* inExt, int* wholeE
 }
 
 //------------------------------------------------------------------------------
-// For a given position along the convolution axis, this method loops over
-// all other axes, and performs the convolution. Boundary conditions handled
-// previously.
+// This method loops over the rows of the output, and convolves them with the
+// kernel, or filters them recursively if recursive is not null. The rows are
+// split between the vtkSMPTools threads if split is true.
 template <class T>
-void vtkImageGaussianSmoothExecute(vtkImageGaussianSmooth* self, int axis, double* kernel,
-  int kernelSize, vtkImageData* inData, T* inPtrC, vtkImageData* outData, int outExt[6], T* outPtrC,
+void vtkImageGaussianSmoothExecute(vtkImageGaussianSmooth* self, int axis,
+  const vtkImageSeparableKernel& kernel, const vtkImageRecursiveGaussian* recursive,
+  vtkImageData* inData, int inExt[6], vtkImageData* outData, int outExt[6], bool split,
   int* pcycle, int target, int* pcount, int total)
 {
-  int maxC, max0 = 0, max1 = 0;
-  int idxC, idx0, idx1, idxK;
-  vtkIdType inIncs[3], outIncs[3];
-  vtkIdType inInc0 = 0, inInc1 = 0, inIncK, outInc0 = 0, outInc1 = 0;
-  T *outPtr1, *outPtr0;
-  T *inPtr1, *inPtr0, *inPtrK;
-  double *ptrK, sum;
+  typedef typename vtkImageSeparableKernelAccumulator<T>::Type KT;
 
-  // I am counting on the fact that tight loops (component on outside)
-  // is more important than cache misses from shuffled access.
-
-  // Do the correct shuffling of the axes (increments, extents)
+  vtkIdType inIncs[3], outIncs[3];
   inData->GetIncrements(inIncs);
   outData->GetIncrements(outIncs);
-  inIncK = inIncs[axis];
-  maxC = outData->GetNumberOfScalarComponents();
-  switch (axis)
+  const int numComps = outData->GetNumberOfScalarComponents();
+  const vtkIdType rowLength = static_cast<vtkIdType>(outExt[1] - outExt[0] + 1) * numComps;
+  const int numRows1 = outExt[3] - outExt[2] + 1;
+  const int numRows2 = outExt[5] - outExt[4] + 1;
+  const int numIn = inExt[axis * 2 + 1] - inExt[axis * 2] + 1;
+  const int firstOut = outExt[axis * 2] - inExt[axis * 2];
+  const int numOut = outExt[axis * 2 + 1] - outExt[axis * 2] + 1;
+
+  // the input starts at the first input sample along the axis
+  int coords[3] = { outExt[0], outExt[2], outExt[4] };
+  coords[axis] = inExt[axis * 2];
+  const T* inPtr = static_cast<T*>(inData->GetScalarPointer(coords));
+  T* outPtr = static_cast<T*>(outData->GetScalarPointerForExtent(outExt));
+
+  // the rows of the other axes, or the tiles of rows filtered recursively
+  // along the axis
+  const int numTiles = static_cast<int>(
+    (rowLength + vtkImageRecursiveGaussian::TileSize - 1) / vtkImageRecursiveGaussian::TileSize);
+  vtkIdType numItems = static_cast<vtkIdType>(numRows1) * numRows2;
+  if (recursive && axis != 0)
   {
-    case 0:
-      inInc0 = inIncs[1];
-      inInc1 = inIncs[2];
-      outInc0 = outIncs[1];
-      outInc1 = outIncs[2];
-      max0 = outExt[3] - outExt[2] + 1;
-      max1 = outExt[5] - outExt[4] + 1;
-      break;
-    case 1:
-      inInc0 = inIncs[0];
-      inInc1 = inIncs[2];
-      outInc0 = outIncs[0];
-      outInc1 = outIncs[2];
-      max0 = outExt[1] - outExt[0] + 1;
-      max1 = outExt[5] - outExt[4] + 1;
-      break;
-    case 2:
-      inInc0 = inIncs[0];
-      inInc1 = inIncs[1];
-      outInc0 = outIncs[0];
-      outInc1 = outIncs[1];
-      max0 = outExt[1] - outExt[0] + 1;
-      max1 = outExt[3] - outExt[2] + 1;
-      break;
+    numItems = static_cast<vtkIdType>(axis == 1 ? numRows2 : numRows1) * numTiles;
   }
 
-  for (idxC = 0; idxC < maxC; ++idxC)
-  {
-    inPtr1 = inPtrC;
-    outPtr1 = outPtrC;
-    for (idx1 = 0; !self->AbortExecute && idx1 < max1; ++idx1)
+  auto execute = [&](vtkIdType begin, vtkIdType end) {
+    std::vector<double> buffer;
+    if (recursive)
+    {
+      buffer.resize(vtkImageRecursiveGaussian::GetBufferSize(
+        numIn, axis == 0 ? numComps : vtkImageRecursiveGaussian::TileSize));
+    }
+    for (vtkIdType item = begin; !self->AbortExecute && item < end; ++item)
     {
-      inPtr0 = inPtr1;
-      outPtr0 = outPtr1;
-      for (idx0 = 0; idx0 < max0; ++idx0)
+      if (recursive && axis != 0)
       {
-        inPtrK = inPtr0;
-        ptrK = kernel;
-        sum = 0.0;
-        // too bad this short loop has to be the inner most loop
-        for (idxK = 0; idxK < kernelSize; ++idxK)
+        // filter a tile of the rows along Y (at one Z) or along Z (at one Y)
+        const int other = static_cast<int>(item / numTiles);
+        const vtkIdType start = (item % numTiles) * vtkImageRecursiveGaussian::TileSize;
+        const int width = static_cast<int>(
+          std::min<vtkIdType>(vtkImageRecursiveGaussian::TileSize, rowLength - start));
+        const int otherAxis = 3 - axis;
+        recursive->Filter(inPtr + other * inIncs[otherAxis] + start, inIncs[axis], numIn,
+          outPtr + other * outIncs[otherAxis] + start, outIncs[axis], firstOut, numOut, width,
+          buffer.data());
+        continue;
+      }
+
+      const int idx1 = static_cast<int>(item % numRows1);
+      const int idx2 = static_cast<int>(item / numRows1);
+      T* outRow = outPtr + idx1 * outIncs[1] + idx2 * outIncs[2];
+      const T* inRow =
+        inPtr + (axis == 1 ? 0 : idx1 * inIncs[1]) + (axis == 2 ? 0 : idx2 * inIncs[2]);
+      if (axis == 0)
+      {
+        if (recursive)
+        {
+          recursive->Filter(inRow, numComps, numIn, outRow, numComps, firstOut, numOut, numComps,
+            buffer.data());
+        }
+        else
         {
-          sum += *ptrK * static_cast<double>(*inPtrK);
-          ++ptrK;
-          inPtrK += inIncK;
+          kernel.ConvolveRow<KT>(inRow, outRow, numComps);
         }
-        *outPtr0 = static_cast<T>(sum);
-        inPtr0 += inInc0;
-        outPtr0 += outInc0;
       }
-      inPtr1 += inInc1;
-      outPtr1 += outInc1;
+      else
+      {
+        kernel.ConvolveRows<KT>(axis == 1 ? idx1 : idx2, inRow, inIncs[axis], outRow, rowLength);
+      }
+
       // we finished a row ... do we update ???
-      if (total)
+      if (total && !split)
       { // yes this is the main thread
-        *pcycle += max0;
+        *pcycle += static_cast<int>(rowLength);
         if (*pcycle > target)
         { // yes
           *pcycle -= target;
           *pcount += target;
           self->UpdateProgress(static_cast<double>(*pcount) / static_cast<double>(total));
-          // fprintf(stderr, "count: %d, total: %d, progress: %f\n",
-          //*pcount, total, (double)(*pcount) / (double)total);
         }
       }
     }
+  };
 
-    ++inPtrC;
-    ++outPtrC;
+  if (split)
+  {
+    vtkSMPTools::For(0, numItems, execute);
+    if (total)
+    {
+      *pcount += static_cast<int>(rowLength * numRows1 * numRows2);
+      self->UpdateProgress(static_cast<double>(*pcount) / static_cast<double>(total));
+    }
+  }
+  else
+  {
+    execute(0, numItems);
   }
 }
 
 //------------------------------------------------------------------------------
-template <class T>
-size_t vtkImageGaussianSmoothGetTypeSize(T*)
-{
-  return sizeof(T);
-}
-
-//------------------------------------------------------------------------------
-// This method convolves over one axis. It loops over the convolved axis,
-// and handles boundary conditions.
+// This method convolves over one axis. It computes the kernel of each
+// position along the convolved axis, which handles the boundary conditions.
 void vtkImageGaussianSmooth::ExecuteAxis(int axis, vtkImageData* inData, int inExt[6],
   vtkImageData* outData, int outExt[6], int* pcycle, int target, int* pcount, int total,
   vtkInformation* inInfo)
 {
+  int wholeExtent[6];
   int idxA, max;
-  int wholeExtent[6], wholeMax, wholeMin;
-  double* kernel;
-  // previousClip and currentClip rembers that the previous was not clipped
-  // keeps from recomputing kernels for center pixels.
-  int kernelSize = 0;
   int kernelLeftClip, kernelRightClip;
-  int previousClipped, currentClipped;
-  int radius, size;
-  void* inPtr;
-  void* outPtr;
-  int coords[3];
-  vtkIdType outIncs[3], outIncA;
-
-  // Get the correct starting pointer of the output
-  outPtr = outData->GetScalarPointerForExtent(outExt);
-  outData->GetIncrements(outIncs);
-  outIncA = outIncs[axis];
 
-  // trick to account for the scalar type of the output(used to be only float)
-  switch (outData->GetScalarType())
+  // get whole extent for boundary checking ...
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExtent);
+  const int wholeMin = wholeExtent[axis * 2];
+  const int wholeMax = wholeExtent[axis * 2 + 1];
+
+  vtkImageSeparableKernel kernel;
+  std::unique_ptr<vtkImageRecursiveGaussian> recursive;
+  if (this->UseRecursion(axis))
+  {
+    recursive.reset(new vtkImageRecursiveGaussian(this->StandardDeviations[axis]));
+  }
+  else
   {
-    vtkTemplateMacro(outIncA *=
-      static_cast<vtkIdType>(vtkImageGaussianSmoothGetTypeSize(static_cast<VTK_TT*>(nullptr))));
+    const int radius = static_cast<int>(this->StandardDeviations[axis] * this->RadiusFactors[axis]);
+    std::vector<double> weights(2 * radius + 1);
+
+    // loop over the convolution axis, the unclipped kernels are grouped by
+    // vtkImageSeparableKernel
+    max = outExt[axis * 2 + 1];
+    for (idxA = outExt[axis * 2]; idxA <= max; ++idxA)
+    {
+      // left boundary condition
+      kernelLeftClip = wholeMin - (idxA - radius);
+      if (kernelLeftClip < 0)
+      {
+        kernelLeftClip = 0;
+      }
+      // Right boundary condition
+      kernelRightClip = (idxA + radius) - wholeMax;
+      if (kernelRightClip < 0)
+      {
+        kernelRightClip = 0;
+      }
+
+      this->ComputeKernel(weights.data(), -radius + kernelLeftClip, radius - kernelRightClip,
+        static_cast<double>(this->StandardDeviations[axis]));
+      kernel.AddSample(idxA - outExt[axis * 2], idxA - radius + kernelLeftClip - inExt[axis * 2],
+        weights.data(), 2 * radius + 1 - kernelLeftClip - kernelRightClip);
+    }
+  }
+
+  /* now do the convolution on the rows */
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkImageGaussianSmoothExecute<VTK_TT>(this, axis, kernel, recursive.get(),
+      inData, inExt, outData, outExt, this->RecursiveFilter, pcycle, target, pcount, total));
     default:
       vtkErrorMacro("Unknown scalar type");
       return;
   }
+}
 
-  // Determine default starting position of input
-  coords[0] = inExt[0];
-  coords[1] = inExt[2];
-  coords[2] = inExt[4];
-
-  // get whole extent for boundary checking ...
-  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExtent);
-  wholeMin = wholeExtent[axis * 2];
-  wholeMax = wholeExtent[axis * 2 + 1];
-
-  // allocate memory for the kernel
-  radius = static_cast<int>(this->StandardDeviations[axis] * this->RadiusFactors[axis]);
-  size = 2 * radius + 1;
-  kernel = new double[size];
-
-  // loop over the convolution axis
-  previousClipped = currentClipped = 1;
-  max = outExt[axis * 2 + 1];
-  for (idxA = outExt[axis * 2]; idxA <= max; ++idxA)
+//------------------------------------------------------------------------------
+// The recursive filters run along the whole extent of the filtered axes, so
+// the output is processed at once, and ExecuteAxis() splits the rows
+// between the threads instead.
+int vtkImageGaussianSmooth::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (!this->RecursiveFilter)
   {
-    // left boundary condition
-    coords[axis] = idxA - radius;
-    kernelLeftClip = wholeMin - coords[axis];
-    if (kernelLeftClip > 0)
-    { // front of kernel is cut off ("kernelStart" samples)
-      coords[axis] += kernelLeftClip;
-    }
-    else
-    {
-      kernelLeftClip = 0;
-    }
-    // Right boundary condition
-    kernelRightClip = (idxA + radius) - wholeMax;
-    if (kernelRightClip < 0)
-    {
-      kernelRightClip = 0;
-    }
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
 
-    // We can only use previous kernel if it is not clipped and new
-    // kernel is also not clipped.
-    currentClipped = kernelLeftClip + kernelRightClip;
-    if (currentClipped || previousClipped)
-    {
-      this->ComputeKernel(kernel, -radius + kernelLeftClip, radius - kernelRightClip,
-        static_cast<double>(this->StandardDeviations[axis]));
-      kernelSize = size - kernelLeftClip - kernelRightClip;
-    }
-    previousClipped = currentClipped;
+  vtkImageData* inData = nullptr;
+  vtkImageData** inputs = &inData;
+  vtkImageData* outData = nullptr;
+  this->PrepareImageData(inputVector, outputVector, &inputs, &outData);
 
-    /* now do the convolution on the rest of the axes */
-    inPtr = inData->GetScalarPointer(coords);
-    switch (inData->GetScalarType())
-    {
-      vtkTemplateMacro(vtkImageGaussianSmoothExecute(this, axis, kernel, kernelSize, inData,
-        static_cast<VTK_TT*>(inPtr), outData, outExt, static_cast<VTK_TT*>(outPtr), pcycle, target,
-        pcount, total));
-      default:
-        vtkErrorMacro("Unknown scalar type");
-        return;
-    }
-    outPtr = static_cast<void*>(static_cast<unsigned char*>(outPtr) + outIncA);
+  int updateExtent[6];
+  outData->GetExtent(updateExtent);
+  if (inData && updateExtent[0] <= updateExtent[1] && updateExtent[2] <= updateExtent[3] &&
+    updateExtent[4] <= updateExtent[5])
+  {
+    this->ThreadedRequestData(
+      request, inputVector, outputVector, &inputs, &outData, updateExtent, 0);
   }
 
-  // get rid of temporary kernel
-  delete[] kernel;
+  return 1;
 }
 
 //------------------------------------------------------------------------------
@@ -18,6 +18,17 @@
  *
  * vtkImageGaussianSmooth implements a convolution of the input image
  * with a gaussian. Supports from one to three dimensional convolutions.
+ *
+ * The convolutions along each axis are done a row of X values at a time,
+ * in loops that the compiler can vectorize, and the pieces of the output
+ * are processed by vtkThreadedImageAlgorithm.  The float, char, short
+ * (and unsigned) scalars are accumulated in float precision, the others in
+ * double precision.
+ *
+ * With RecursiveFilter on, the axes with a standard deviation of at least
+ * one pixel are filtered with the fourth order recursive approximation of
+ * the gaussian of Deriche, whose cost does not depend on the standard
+ * deviation, instead of a convolution with the kernel.
  */
 
 #ifndef vtkImageGaussianSmooth_h
@@ -77,6 +88,21 @@ public:
   vtkGetMacro(Dimensionality, int);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get whether to filter with the recursive approximation of the
+   * gaussian, for large standard deviations.  The recursion extends to the
+   * whole extent of the filtered axes, whatever the RadiusFactors, and
+   * replicates the edges instead of renormalizing the kernel.  The whole
+   * extent of the filtered axes is requested from the input, and the
+   * output is processed at once, split by rows between the vtkSMPTools
+   * threads.  Off by default.
+   */
+  vtkSetMacro(RecursiveFilter, bool);
+  vtkGetMacro(RecursiveFilter, bool);
+  vtkBooleanMacro(RecursiveFilter, bool);
+  ///@}
+
 protected:
   vtkImageGaussianSmooth();
   ~vtkImageGaussianSmooth() override;
@@ -84,9 +110,12 @@ protected:
   int Dimensionality;
   double StandardDeviations[3];
   double RadiusFactors[3];
+  bool RecursiveFilter;
 
   void ComputeKernel(double* kernel, int min, int max, double std);
+  bool UseRecursion(int axis);
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   void InternalRequestUpdateExtent(int*, int*);
   void ExecuteAxis(int axis, vtkImageData* inData, int inExt[6], vtkImageData* outData,
     int outExt[6], int* pcycle, int target, int* pcount, int total, vtkInformation* inInfo);
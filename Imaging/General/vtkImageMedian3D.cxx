@@ -24,6 +24,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm> // for std::nth_element
+#include <vector>
 
 vtkStandardNewMacro(vtkImageMedian3D);
 
@@ -32,6 +33,7 @@ vtkStandardNewMacro(vtkImageMedian3D);
 vtkImageMedian3D::vtkImageMedian3D()
 {
   this->NumberOfElements = 0;
+  this->Algorithm = Automatic;
   this->SetKernelSize(1, 1, 1);
   this->HandleBoundaries = 1;
 }
@@ -45,6 +47,29 @@ void vtkImageMedian3D::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "NumberOfElements: " << this->NumberOfElements << endl;
+  os << indent << "Algorithm: " << this->GetAlgorithmAsString() << endl;
+}
+
+//------------------------------------------------------------------------------
+const char* vtkImageMedian3D::GetAlgorithmAsString()
+{
+  const char* result = "Unknown";
+  switch (this->Algorithm)
+  {
+    case Automatic:
+      result = "Automatic";
+      break;
+    case Selection:
+      result = "Selection";
+      break;
+    case Histogram:
+      result = "Histogram";
+      break;
+    case SortingNetwork:
+      result = "SortingNetwork";
+      break;
+  }
+  return result;
 }
 
 //------------------------------------------------------------------------------
@@ -101,8 +126,143 @@ T vtkComputeMedianOfArray(T* aBegin, T* aEnd)
   return m;
 }
 
+// The largest kernel of the sorting networks
+const int vtkImageMedian3DMaxNetworkSize = 125;
+
+// The smallest kernel for which Automatic uses the histograms
+const int vtkImageMedian3DMinHistogramSize = 27;
+
+// The number of voxels of a row that go through a sorting network at once
+const vtkIdType vtkImageMedian3DNetworkTile = 64;
+
+//------------------------------------------------------------------------------
+// The comparators of Batcher's odd-even merge sort that lead to the median
+// of a fixed number of values.
+class vtkImageMedian3DSortingNetwork
+{
+public:
+  explicit vtkImageMedian3DSortingNetwork(int size)
+    : Size(size)
+  {
+    int n = 1;
+    while (n < size)
+    {
+      n *= 2;
+    }
+    // the values past size would be infinite, their comparators are no-ops
+    std::vector<int> all;
+    for (int p = 1; p < n; p *= 2)
+    {
+      for (int k = p; k >= 1; k /= 2)
+      {
+        for (int j = k % p; j + k < n; j += 2 * k)
+        {
+          for (int i = 0; i < k && i + j + k < n; ++i)
+          {
+            if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < size)
+            {
+              all.push_back(i + j);
+              all.push_back(i + j + k);
+            }
+          }
+        }
+      }
+    }
+
+    // only keep the comparators that the middle values depend on
+    std::vector<char> needed(size, 0);
+    needed[size / 2] = 1;
+    needed[(size - 1) / 2] = 1;
+    std::vector<int> kept;
+    for (size_t c = all.size(); c > 0; c -= 2)
+    {
+      int a = all[c - 2];
+      int b = all[c - 1];
+      if (needed[a] || needed[b])
+      {
+        needed[a] = 1;
+        needed[b] = 1;
+        kept.push_back(b);
+        kept.push_back(a);
+      }
+    }
+    this->Comparators.assign(kept.rbegin(), kept.rend());
+  }
+
+  // Sort the values, stored with the given stride, of count voxels
+  template <class T>
+  void Apply(T* values, vtkIdType stride, vtkIdType count) const
+  {
+    for (size_t c = 0; c < this->Comparators.size(); c += 2)
+    {
+      T* a = values + this->Comparators[c] * stride;
+      T* b = values + this->Comparators[c + 1] * stride;
+      for (vtkIdType i = 0; i < count; ++i)
+      {
+        T lo = std::min(a[i], b[i]);
+        T hi = std::max(a[i], b[i]);
+        a[i] = lo;
+        b[i] = hi;
+      }
+    }
+  }
+
+  // Get the median of a voxel after Apply(), like vtkComputeMedianOfArray
+  template <class T>
+  T GetMedian(const T* values, vtkIdType stride, vtkIdType i) const
+  {
+    T m = values[(this->Size / 2) * stride + i];
+    if (this->Size % 2 == 0)
+    {
+      T low = values[(this->Size / 2 - 1) * stride + i];
+      m = low + (m - low) / 2;
+    }
+    return m;
+  }
+
+private:
+  int Size;
+  std::vector<int> Comparators;
+};
+
 } // end anonymous namespace
 
+//------------------------------------------------------------------------------
+// Compute the median of the neighborhood of one voxel, clipped by the input
+// extent.  The input pointer is at the first voxel of the input extent.
+template <class T>
+T vtkImageMedian3DVoxel(vtkImageMedian3D* self, const T* inPtr, const int* inExt,
+  const vtkIdType* inInc, int idx0, int idx1, int idx2, T* workArray)
+{
+  const int* kernelSize = self->GetKernelSize();
+  const int* kernelMiddle = self->GetKernelMiddle();
+  const int idx[3] = { idx0, idx1, idx2 };
+  int hoodMin[3];
+  int hoodMax[3];
+  for (int j = 0; j < 3; ++j)
+  {
+    hoodMin[j] = std::max(idx[j] - kernelMiddle[j], inExt[2 * j]);
+    hoodMax[j] = std::min(idx[j] - kernelMiddle[j] + kernelSize[j] - 1, inExt[2 * j + 1]);
+  }
+
+  T* workEnd = workArray;
+  for (int hoodIdx2 = hoodMin[2]; hoodIdx2 <= hoodMax[2]; ++hoodIdx2)
+  {
+    for (int hoodIdx1 = hoodMin[1]; hoodIdx1 <= hoodMax[1]; ++hoodIdx1)
+    {
+      const T* tmpPtr0 = inPtr + (hoodMin[0] - inExt[0]) * inInc[0] +
+        (hoodIdx1 - inExt[2]) * inInc[1] + (hoodIdx2 - inExt[4]) * inInc[2];
+      for (int hoodIdx0 = hoodMin[0]; hoodIdx0 <= hoodMax[0]; ++hoodIdx0)
+      {
+        *workEnd++ = *tmpPtr0;
+        tmpPtr0 += inInc[0];
+      }
+    }
+  }
+
+  return vtkComputeMedianOfArray(workArray, workEnd);
+}
+
 //------------------------------------------------------------------------------
 // This method contains the second switch statement that calls the correct
 // templated function for the mask types.
@@ -270,6 +430,340 @@ void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* in
   delete[] workArray;
 }
 
+//------------------------------------------------------------------------------
+// This templated function computes the medians of the voxels whose kernel
+// is inside the input extent with a sorting network, by tiles of voxels
+// along the rows, and of the others by selection.
+template <class T>
+void vtkImageMedian3DExecuteNetwork(vtkImageMedian3D* self, vtkImageData* inData,
+  vtkDataArray* inArray, vtkImageData* outData, int outExt[6], int id)
+{
+  const int* kernelSize = self->GetKernelSize();
+  const int* kernelMiddle = self->GetKernelMiddle();
+  const int numComp = inArray->GetNumberOfComponents();
+  const int* inExt = inData->GetExtent();
+  const T* inPtr = static_cast<T*>(inArray->GetVoidPointer(0));
+  const vtkIdType inInc[3] = { numComp, numComp * vtkIdType(inExt[1] - inExt[0] + 1),
+    numComp * vtkIdType(inExt[1] - inExt[0] + 1) * (inExt[3] - inExt[2] + 1) };
+
+  const int size = self->GetNumberOfElements();
+  vtkImageMedian3DSortingNetwork network(size);
+  std::vector<T> values(size * vtkImageMedian3DNetworkTile);
+  std::vector<T> workArray(size);
+  std::vector<vtkIdType> offsets;
+  for (int hoodIdx2 = 0; hoodIdx2 < kernelSize[2]; ++hoodIdx2)
+  {
+    for (int hoodIdx1 = 0; hoodIdx1 < kernelSize[1]; ++hoodIdx1)
+    {
+      for (int hoodIdx0 = 0; hoodIdx0 < kernelSize[0]; ++hoodIdx0)
+      {
+        offsets.push_back((hoodIdx0 - kernelMiddle[0]) * inInc[0] +
+          (hoodIdx1 - kernelMiddle[1]) * inInc[1] + (hoodIdx2 - kernelMiddle[2]) * inInc[2]);
+      }
+    }
+  }
+
+  // The voxels whose whole kernel is in the input extent
+  int middle[6];
+  for (int j = 0; j < 3; ++j)
+  {
+    middle[2 * j] = inExt[2 * j] + kernelMiddle[j];
+    middle[2 * j + 1] = inExt[2 * j + 1] - (kernelSize[j] - 1) + kernelMiddle[j];
+  }
+
+  unsigned long count = 0;
+  unsigned long target =
+    static_cast<unsigned long>((outExt[5] - outExt[4] + 1) * (outExt[3] - outExt[2] + 1) / 50.0);
+  target++;
+
+  for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
+  {
+    for (int outIdx1 = outExt[2]; !self->AbortExecute && outIdx1 <= outExt[3]; ++outIdx1)
+    {
+      if (!id)
+      {
+        if (!(count % target))
+        {
+          self->UpdateProgress(count / (50.0 * target));
+        }
+        count++;
+      }
+      T* outPtr = static_cast<T*>(outData->GetScalarPointer(outExt[0], outIdx1, outIdx2));
+
+      int min0 = std::max(outExt[0], middle[0]);
+      int max0 = std::min(outExt[1], middle[1]);
+      if (outIdx1 < middle[2] || outIdx1 > middle[3] || outIdx2 < middle[4] ||
+        outIdx2 > middle[5] || min0 > max0)
+      {
+        min0 = outExt[1] + 1;
+        max0 = outExt[1];
+      }
+
+      // the voxels near the boundaries
+      for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
+      {
+        if (outIdx0 == min0)
+        {
+          outIdx0 = max0;
+          continue;
+        }
+        for (int outIdxC = 0; outIdxC < numComp; ++outIdxC)
+        {
+          outPtr[(outIdx0 - outExt[0]) * numComp + outIdxC] = vtkImageMedian3DVoxel(self,
+            inPtr + outIdxC, inExt, inInc, outIdx0, outIdx1, outIdx2, workArray.data());
+        }
+      }
+
+      // the others go through the network by tiles
+      for (int outIdxC = 0; outIdxC < numComp; ++outIdxC)
+      {
+        for (int tileMin = min0; tileMin <= max0; tileMin += vtkImageMedian3DNetworkTile)
+        {
+          const vtkIdType tileSize =
+            std::min(vtkImageMedian3DNetworkTile, vtkIdType(max0 - tileMin + 1));
+          const T* centerPtr = inPtr + outIdxC + (tileMin - inExt[0]) * inInc[0] +
+            (outIdx1 - inExt[2]) * inInc[1] + (outIdx2 - inExt[4]) * inInc[2];
+          for (int k = 0; k < size; ++k)
+          {
+            const T* hoodPtr = centerPtr + offsets[k];
+            T* valuesPtr = &values[k * vtkImageMedian3DNetworkTile];
+            for (vtkIdType i = 0; i < tileSize; ++i)
+            {
+              valuesPtr[i] = hoodPtr[i * numComp];
+            }
+          }
+          network.Apply(values.data(), vtkImageMedian3DNetworkTile, tileSize);
+          T* outPtr0 = outPtr + (tileMin - outExt[0]) * numComp + outIdxC;
+          for (vtkIdType i = 0; i < tileSize; ++i)
+          {
+            outPtr0[i * numComp] = network.GetMedian(values.data(), vtkImageMedian3DNetworkTile, i);
+          }
+        }
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// This templated function computes the medians of 8 or 16 bit integers with
+// sliding histograms.  The histogram of each column of the kernel, at each
+// position along X, is updated as the rows advance, and the histogram of
+// the kernel is updated from the columns as the voxels advance along the
+// row.  The bins of the values present in the input are grouped in coarse
+// bins, and the fine bins of the kernel histogram are only updated for the
+// coarse bins where the median is searched.  Returns false if the
+// histograms would take too much memory.
+template <class T>
+bool vtkImageMedian3DExecuteHistogram(vtkImageMedian3D* self, vtkImageData* inData,
+  vtkDataArray* inArray, vtkImageData* outData, int outExt[6], int id)
+{
+  typedef unsigned short ColumnCount;
+  const int* kernelSize = self->GetKernelSize();
+  const int* kernelMiddle = self->GetKernelMiddle();
+  const int numComp = inArray->GetNumberOfComponents();
+  const int* inExt = inData->GetExtent();
+  const T* inPtr = static_cast<T*>(inArray->GetVoidPointer(0));
+  const vtkIdType inInc[3] = { numComp, numComp * vtkIdType(inExt[1] - inExt[0] + 1),
+    numComp * vtkIdType(inExt[1] - inExt[0] + 1) * (inExt[3] - inExt[2] + 1) };
+
+  // The input voxels that are used
+  int hoodExt[6];
+  for (int j = 0; j < 3; ++j)
+  {
+    hoodExt[2 * j] = std::max(outExt[2 * j] - kernelMiddle[j], inExt[2 * j]);
+    hoodExt[2 * j + 1] =
+      std::min(outExt[2 * j + 1] - kernelMiddle[j] + kernelSize[j] - 1, inExt[2 * j + 1]);
+  }
+  const vtkIdType numColumns = hoodExt[1] - hoodExt[0] + 1;
+
+  unsigned long count = 0;
+  unsigned long target = static_cast<unsigned long>(
+    numComp * (outExt[5] - outExt[4] + 1) * (outExt[3] - outExt[2] + 1) / 50.0);
+  target++;
+
+  for (int outIdxC = 0; outIdxC < numComp; ++outIdxC)
+  {
+    const T* inPtrC = inPtr + outIdxC;
+
+    // The range of the values gives the bins
+    int minValue = VTK_INT_MAX;
+    int maxValue = VTK_INT_MIN;
+    for (int idx2 = hoodExt[4]; idx2 <= hoodExt[5]; ++idx2)
+    {
+      for (int idx1 = hoodExt[2]; idx1 <= hoodExt[3]; ++idx1)
+      {
+        const T* tmpPtr = inPtrC + (hoodExt[0] - inExt[0]) * inInc[0] +
+          (idx1 - inExt[2]) * inInc[1] + (idx2 - inExt[4]) * inInc[2];
+        for (int idx0 = hoodExt[0]; idx0 <= hoodExt[1]; ++idx0)
+        {
+          minValue = std::min(minValue, static_cast<int>(*tmpPtr));
+          maxValue = std::max(maxValue, static_cast<int>(*tmpPtr));
+          tmpPtr += inInc[0];
+        }
+      }
+    }
+    int bits = 0;
+    while ((1 << bits) <= maxValue - minValue)
+    {
+      ++bits;
+    }
+    const int fineBits = bits / 2;
+    const int numCoarse = 1 << (bits - fineBits);
+    const int numFine = 1 << fineBits;
+    if (numColumns * (numCoarse + (1 << bits)) * vtkIdType(sizeof(ColumnCount)) > (1 << 28))
+    {
+      return false;
+    }
+
+    std::vector<ColumnCount> columnCoarse(numColumns * numCoarse);
+    std::vector<ColumnCount> columnFine(numColumns << bits);
+    std::vector<int> coarse(numCoarse);
+    std::vector<int> fine(std::size_t(1) << bits);
+    // The columns that each fine bin of the kernel holds, or none
+    std::vector<int> fineMin(numCoarse);
+    std::vector<int> fineMax(numCoarse);
+
+    // Add (or remove) a row of the kernel to the columns
+    auto updateColumns = [&](int idx1, int min2, int max2, int step) {
+      for (int idx2 = min2; idx2 <= max2; ++idx2)
+      {
+        const T* tmpPtr = inPtrC + (hoodExt[0] - inExt[0]) * inInc[0] +
+          (idx1 - inExt[2]) * inInc[1] + (idx2 - inExt[4]) * inInc[2];
+        for (vtkIdType column = 0; column < numColumns; ++column)
+        {
+          int bin = static_cast<int>(*tmpPtr) - minValue;
+          columnCoarse[column * numCoarse + (bin >> fineBits)] += step;
+          columnFine[(column << bits) + bin] += step;
+          tmpPtr += inInc[0];
+        }
+      }
+    };
+
+    // Bring the fine bins of the kernel within a coarse bin up to date
+    auto updateFine = [&](int bin, int min0, int max0) {
+      int* fineBins = &fine[bin * numFine];
+      if (fineMax[bin] < fineMin[bin] ||
+        (min0 - fineMin[bin]) + (max0 - fineMax[bin]) > max0 - min0 + 1)
+      {
+        std::fill(fineBins, fineBins + numFine, 0);
+        fineMin[bin] = min0;
+        fineMax[bin] = min0 - 1;
+      }
+      for (; fineMax[bin] < max0; ++fineMax[bin])
+      {
+        const ColumnCount* counts =
+          &columnFine[(vtkIdType(fineMax[bin] + 1 - hoodExt[0]) << bits) + bin * numFine];
+        for (int i = 0; i < numFine; ++i)
+        {
+          fineBins[i] += counts[i];
+        }
+      }
+      for (; fineMin[bin] < min0; ++fineMin[bin])
+      {
+        const ColumnCount* counts =
+          &columnFine[(vtkIdType(fineMin[bin] - hoodExt[0]) << bits) + bin * numFine];
+        for (int i = 0; i < numFine; ++i)
+        {
+          fineBins[i] -= counts[i];
+        }
+      }
+    };
+
+    // Find the value of the given rank (from zero) in the kernel
+    auto findRank = [&](int rank, int min0, int max0) {
+      int total = 0;
+      int bin = 0;
+      while (total + coarse[bin] <= rank)
+      {
+        total += coarse[bin++];
+      }
+      updateFine(bin, min0, max0);
+      int value = bin * numFine;
+      while (total + fine[value] <= rank)
+      {
+        total += fine[value++];
+      }
+      return static_cast<T>(value + minValue);
+    };
+
+    for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
+    {
+      const int min2 = std::max(outIdx2 - kernelMiddle[2], inExt[4]);
+      const int max2 = std::min(outIdx2 - kernelMiddle[2] + kernelSize[2] - 1, inExt[5]);
+      int min1 = std::max(outExt[2] - kernelMiddle[1], inExt[2]);
+      int max1 = std::min(outExt[2] - kernelMiddle[1] + kernelSize[1] - 1, inExt[3]);
+      std::fill(columnCoarse.begin(), columnCoarse.end(), 0);
+      std::fill(columnFine.begin(), columnFine.end(), 0);
+      for (int idx1 = min1; idx1 <= max1; ++idx1)
+      {
+        updateColumns(idx1, min2, max2, 1);
+      }
+
+      for (int outIdx1 = outExt[2]; !self->AbortExecute && outIdx1 <= outExt[3]; ++outIdx1)
+      {
+        if (!id)
+        {
+          if (!(count % target))
+          {
+            self->UpdateProgress(count / (50.0 * target));
+          }
+          count++;
+        }
+
+        // advance the columns to this row
+        for (; min1 < std::max(outIdx1 - kernelMiddle[1], inExt[2]); ++min1)
+        {
+          updateColumns(min1, min2, max2, -1);
+        }
+        for (; max1 < std::min(outIdx1 - kernelMiddle[1] + kernelSize[1] - 1, inExt[3]);)
+        {
+          updateColumns(++max1, min2, max2, 1);
+        }
+
+        // slide the kernel histogram along the row
+        std::fill(coarse.begin(), coarse.end(), 0);
+        std::fill(fineMin.begin(), fineMin.end(), 0);
+        std::fill(fineMax.begin(), fineMax.end(), -1);
+        int min0 = hoodExt[0];
+        int max0 = hoodExt[0] - 1;
+        const int columnSize = (max1 - min1 + 1) * (max2 - min2 + 1);
+        T* outPtr = static_cast<T*>(outData->GetScalarPointer(outExt[0], outIdx1, outIdx2));
+        for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
+        {
+          for (; max0 < std::min(outIdx0 - kernelMiddle[0] + kernelSize[0] - 1, inExt[1]);)
+          {
+            const ColumnCount* counts = &columnCoarse[(++max0 - hoodExt[0]) * numCoarse];
+            for (int i = 0; i < numCoarse; ++i)
+            {
+              coarse[i] += counts[i];
+            }
+          }
+          for (; min0 < std::max(outIdx0 - kernelMiddle[0], inExt[0]); ++min0)
+          {
+            const ColumnCount* counts = &columnCoarse[(min0 - hoodExt[0]) * numCoarse];
+            for (int i = 0; i < numCoarse; ++i)
+            {
+              coarse[i] -= counts[i];
+            }
+          }
+
+          // the median, as computed by vtkComputeMedianOfArray
+          const int size = (max0 - min0 + 1) * columnSize;
+          T m = findRank(size / 2, min0, max0);
+          if (size % 2 == 0)
+          {
+            T low = findRank(size / 2 - 1, min0, max0);
+            m = low + (m - low) / 2;
+          }
+          outPtr[(outIdx0 - outExt[0]) * numComp + outIdxC] = m;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // This method contains the first switch statement that calls the correct
 // templated function for the input and output region types.
@@ -296,7 +790,66 @@ void vtkImageMedian3D::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
     return;
   }
 
-  switch (inArray->GetDataType())
+  // Choose the algorithm: the histograms need 8 or 16 bit integers, and
+  // their column counts must fit in 16 bits.
+  const int dataType = inArray->GetDataType();
+  const bool smallIntegers = (dataType == VTK_CHAR || dataType == VTK_SIGNED_CHAR ||
+    dataType == VTK_UNSIGNED_CHAR || dataType == VTK_SHORT || dataType == VTK_UNSIGNED_SHORT);
+  const bool histogram =
+    (smallIntegers && this->KernelSize[1] * this->KernelSize[2] <= VTK_UNSIGNED_SHORT_MAX);
+  const bool network = (this->NumberOfElements <= vtkImageMedian3DMaxNetworkSize);
+  int algorithm = this->Algorithm;
+  if (algorithm == Automatic)
+  {
+    if (histogram && this->NumberOfElements > vtkImageMedian3DMinHistogramSize)
+    {
+      algorithm = Histogram;
+    }
+    else
+    {
+      algorithm = (network ? SortingNetwork : Selection);
+    }
+  }
+
+  if (algorithm == Histogram && histogram)
+  {
+    bool done = false;
+    switch (dataType)
+    {
+      vtkTemplateMacroCase(VTK_CHAR, char,
+        done = vtkImageMedian3DExecuteHistogram<VTK_TT>(
+          this, inData[0][0], inArray, outData[0], outExt, id));
+      vtkTemplateMacroCase(VTK_SIGNED_CHAR, signed char,
+        done = vtkImageMedian3DExecuteHistogram<VTK_TT>(
+          this, inData[0][0], inArray, outData[0], outExt, id));
+      vtkTemplateMacroCase(VTK_UNSIGNED_CHAR, unsigned char,
+        done = vtkImageMedian3DExecuteHistogram<VTK_TT>(
+          this, inData[0][0], inArray, outData[0], outExt, id));
+      vtkTemplateMacroCase(VTK_SHORT, short,
+        done = vtkImageMedian3DExecuteHistogram<VTK_TT>(
+          this, inData[0][0], inArray, outData[0], outExt, id));
+      vtkTemplateMacroCase(VTK_UNSIGNED_SHORT, unsigned short,
+        done = vtkImageMedian3DExecuteHistogram<VTK_TT>(
+          this, inData[0][0], inArray, outData[0], outExt, id));
+    }
+    if (done)
+    {
+      return;
+    }
+  }
+  else if (algorithm == SortingNetwork && network)
+  {
+    switch (dataType)
+    {
+      vtkTemplateMacro(vtkImageMedian3DExecuteNetwork<VTK_TT>(
+        this, inData[0][0], inArray, outData[0], outExt, id));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown input ScalarType");
+    }
+    return;
+  }
+
+  switch (dataType)
   {
     vtkTemplateMacro(vtkImageMedian3DExecute(this, inData[0][0], static_cast<VTK_TT*>(inPtr),
       outData[0], static_cast<VTK_TT*>(outPtr), outExt, id, inArray));
@@ -21,6 +21,24 @@
  * Neighborhoods can be no more than 3 dimensional.  Setting one
  * axis of the neighborhood kernelSize to 1 changes the filter
  * into a 2D median.
+ *
+ * Three algorithms compute the same medians.  Selection gathers the
+ * neighborhood of each voxel and partially sorts it, at a cost that grows
+ * with the kernel volume.  Histogram, for 8 and 16 bit integer scalars,
+ * slides a histogram of the neighborhood along the rows, built from the
+ * histograms of the kernel columns, as described by Perreault and Hebert:
+ * the columns are updated as the rows advance, and the histograms have
+ * two levels (coarse and fine) whose fine bins are only updated when the
+ * median falls in them, so the cost only grows with the kernel depth.
+ * SortingNetwork, for small kernels, computes the medians of many voxels
+ * of a row at once with a network of min/max operations that the compiler
+ * can vectorize, which is fastest for float data.  The default, Automatic,
+ * picks one of them from the scalar type and the kernel size.  The pieces
+ * of the image, slabs by default, are processed in parallel.
+ *
+ * @sa
+ * S. Perreault and P. Hebert, "Median Filtering in Constant Time", IEEE
+ * Transactions on Image Processing 16(9), 2007.
  */
 
 #ifndef vtkImageMedian3D_h
@@ -49,11 +67,39 @@ public:
   vtkGetMacro(NumberOfElements, int);
   ///@}
 
+  /**
+   * Enum constants for SetAlgorithm().
+   */
+  enum AlgorithmEnum
+  {
+    Automatic = 0,
+    Selection = 1,
+    Histogram = 2,
+    SortingNetwork = 3
+  };
+
+  ///@{
+  /**
+   * The algorithm that computes the medians, they all give the same
+   * result.  Histogram is only used for 8 and 16 bit integer scalars, and
+   * SortingNetwork for kernels of at most 125 elements, Selection is used
+   * otherwise.  The default is Automatic.
+   */
+  vtkSetClampMacro(Algorithm, int, Automatic, SortingNetwork);
+  void SetAlgorithmToAutomatic() { this->SetAlgorithm(Automatic); }
+  void SetAlgorithmToSelection() { this->SetAlgorithm(Selection); }
+  void SetAlgorithmToHistogram() { this->SetAlgorithm(Histogram); }
+  void SetAlgorithmToSortingNetwork() { this->SetAlgorithm(SortingNetwork); }
+  vtkGetMacro(Algorithm, int);
+  const char* GetAlgorithmAsString();
+  ///@}
+
 protected:
   vtkImageMedian3D();
   ~vtkImageMedian3D() override;
 
   int NumberOfElements;
+  int Algorithm;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
@@ -16,74 +16,20 @@
 
 #include "vtkFloatArray.h"
 #include "vtkImageData.h"
+#include "vtkImageSeparableKernel.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkImageSeparableConvolution);
 vtkCxxSetObjectMacro(vtkImageSeparableConvolution, XKernel, vtkFloatArray);
 vtkCxxSetObjectMacro(vtkImageSeparableConvolution, YKernel, vtkFloatArray);
 vtkCxxSetObjectMacro(vtkImageSeparableConvolution, ZKernel, vtkFloatArray);
 
-// Actually do the convolution
-static void ExecuteConvolve(
-  float* kernel, int kernelSize, float* image, float* outImage, int imageSize)
-{
-
-  // Consider the kernel to be centered at (int) ( (kernelSize - 1 ) / 2.0 )
-
-  int center = static_cast<int>((kernelSize - 1) / 2.0);
-  int i, j, k, kStart, iStart, iEnd, count;
-
-  for (i = 0; i < imageSize; ++i)
-  {
-    outImage[i] = 0.0;
-
-    //    iStart = i - center;
-    //    if ( iStart < 0 )
-    //      {
-    //      iStart = 0;
-    //      }
-
-    //    iEnd = i + center;
-    //    if ( iEnd > imageSize - 1 )
-    //      {
-    //      iEnd = imageSize - 1;
-    //      }
-
-    // Handle padding
-    iStart = i - center;
-    k = kernelSize - 1;
-    while (iStart < 0)
-    {
-      outImage[i] += image[0] * kernel[k];
-      ++iStart;
-      --k;
-    }
-
-    iEnd = i + center;
-    k = 0;
-    while (iEnd > imageSize - 1)
-    {
-      outImage[i] += image[imageSize - 1] * kernel[k];
-      ++k;
-      --iEnd;
-    }
-
-    kStart = center + i;
-    if (kStart > kernelSize - 1)
-    {
-      kStart = kernelSize - 1;
-    }
-    count = iEnd - iStart + 1;
-    for (j = 0; j < count; ++j)
-    {
-      outImage[i] += image[j + iStart] * kernel[kStart - j];
-    }
-  }
-}
-
 // Description:
 // Overload standard modified time function. If kernel arrays are modified,
 // then this object is modified as well.
@@ -102,9 +48,9 @@ vtkMTimeType vtkImageSeparableConvolution::GetMTime()
     kTime = this->YKernel->GetMTime();
     mTime = kTime > mTime ? kTime : mTime;
   }
-  if (this->YKernel)
+  if (this->ZKernel)
   {
-    kTime = this->YKernel->GetMTime();
+    kTime = this->ZKernel->GetMTime();
     mTime = kTime > mTime ? kTime : mTime;
   }
   return mTime;
@@ -193,186 +139,162 @@ int vtkImageSeparableConvolution::IterativeRequestUpdateExtent(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// This templated execute method convolves the rows of the output extent
+// along the axis of the iteration, with the edges of the input extent
+// replicated.
 template <class T>
-void vtkImageSeparableConvolutionExecute(vtkImageSeparableConvolution* self, vtkImageData* inData,
-  vtkImageData* outData, T* vtkNotUsed(dummy), int* inExt, int* outExt)
+void vtkImageSeparableConvolutionExecute(vtkImageSeparableConvolution* self,
+  vtkFloatArray* kernelArray, vtkImageData* inData, int inExt[6], vtkImageData* outData,
+  int outExt[6], int id)
 {
-  T *inPtr0, *inPtr1, *inPtr2;
-  float *outPtr0, *outPtr1, *outPtr2;
-  vtkIdType inInc0, inInc1, inInc2;
-  vtkIdType outInc0, outInc1, outInc2;
-  int inMin0, inMax0, inMin1, inMax1, inMin2, inMax2;
-  int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
-  int idx0, idx1, idx2;
-  int i;
-  unsigned long count = 0;
-  unsigned long target;
-
-  // Reorder axes (the in and out extents are assumed to be the same)
-  // (see intercept cache update)
-  self->PermuteExtent(outExt, outMin0, outMax0, outMin1, outMax1, outMin2, outMax2);
-  self->PermuteExtent(inExt, inMin0, inMax0, inMin1, inMax1, inMin2, inMax2);
-  self->PermuteIncrements(inData->GetIncrements(), inInc0, inInc1, inInc2);
-  self->PermuteIncrements(outData->GetIncrements(), outInc0, outInc1, outInc2);
-
-  target = static_cast<unsigned long>((inMax2 - inMin2 + 1) * (inMax1 - inMin1 + 1) / 50.0);
-  target++;
-
-  vtkFloatArray* KernelArray = nullptr;
-  switch (self->GetIteration())
-  {
-    case 0:
-      KernelArray = self->GetXKernel();
-      break;
-    case 1:
-      KernelArray = self->GetYKernel();
-      break;
-    case 2:
-      KernelArray = self->GetZKernel();
-      break;
-  }
-  int kernelSize = 0;
-  float* kernel = nullptr;
-
-  if (KernelArray)
+  const int axis = self->GetIteration();
+
+  // The weights of each output sample along the axis, the kernel being
+  // centered at (int)((kernelSize - 1) / 2.0), and the weights of the samples
+  // beyond the edges added to the edges
+  vtkImageSeparableKernel kernel;
+  const int numIn = inExt[axis * 2 + 1] - inExt[axis * 2] + 1;
+  const int kernelSize = (kernelArray ? static_cast<int>(kernelArray->GetNumberOfTuples()) : 1);
+  const int center = (kernelSize - 1) / 2;
+  std::vector<double> weights(kernelSize);
+  for (int idxA = outExt[axis * 2]; idxA <= outExt[axis * 2 + 1]; ++idxA)
   {
-    // Allocate the arrays
-    kernelSize = KernelArray->GetNumberOfTuples();
-    kernel = new float[kernelSize];
-    // Copy the kernel
-    for (i = 0; i < kernelSize; i++)
+    const int i = idxA - inExt[axis * 2];
+    const int first = std::max(0, i - center);
+    const int last = std::min(numIn - 1, i + center);
+    std::fill(weights.begin(), weights.end(), 0.0);
+    for (int k = 0; k < kernelSize; ++k)
     {
-      kernel[i] = KernelArray->GetValue(i);
+      const int j = std::min(std::max(i + center - k, 0), numIn - 1);
+      weights[j - first] += (kernelArray ? kernelArray->GetValue(k) : 1.0);
     }
+    kernel.AddSample(idxA - outExt[axis * 2], first, weights.data(), last - first + 1);
   }
 
-  int imageSize = inMax0 + 1;
-  float* image = new float[imageSize];
-  float* outImage = new float[imageSize];
-  float* imagePtr;
-
-  // loop over all the extra axes
-  inPtr2 = static_cast<T*>(inData->GetScalarPointerForExtent(inExt));
-  outPtr2 = static_cast<float*>(outData->GetScalarPointerForExtent(outExt));
-  for (idx2 = inMin2; idx2 <= inMax2; ++idx2)
+  // Compute the increments into a local array as `GetIncrements()` introduces
+  // a data race on `vtkImageData::Increments`.
+  vtkIdType inIncs[3], outIncs[3];
+  inData->GetIncrements(inIncs);
+  outData->GetIncrements(outIncs);
+  const int numComps = outData->GetNumberOfScalarComponents();
+  const vtkIdType rowLength = static_cast<vtkIdType>(outExt[1] - outExt[0] + 1) * numComps;
+  const int numRows1 = outExt[3] - outExt[2] + 1;
+  const int numRows = numRows1 * (outExt[5] - outExt[4] + 1);
+
+  // the input starts at the first input sample along the axis
+  int coords[3] = { outExt[0], outExt[2], outExt[4] };
+  coords[axis] = inExt[axis * 2];
+  const T* inPtr = static_cast<T*>(inData->GetScalarPointer(coords));
+  float* outPtr = static_cast<float*>(outData->GetScalarPointerForExtent(outExt));
+
+  const double startProgress =
+    self->GetIteration() / static_cast<double>(self->GetNumberOfIterations());
+  const int target = numRows / 50 + 1;
+
+  for (int row = 0; !self->AbortExecute && row < numRows; ++row)
   {
-    inPtr1 = inPtr2;
-    outPtr1 = outPtr2;
-    for (idx1 = inMin1; !self->AbortExecute && idx1 <= inMax1; ++idx1)
+    if (!id && !(row % target))
     {
-      if (!(count % target))
-      {
-        self->UpdateProgress(count / (50.0 * target));
-      }
-      count++;
-      inPtr0 = inPtr1;
-      imagePtr = image;
-      for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
-      {
-        *imagePtr = static_cast<float>(*inPtr0);
-        inPtr0 += inInc0;
-        ++imagePtr;
-      }
-
-      // Call the method that performs the convolution
-      if (kernel)
-      {
-        ExecuteConvolve(kernel, kernelSize, image, outImage, imageSize);
-        imagePtr = outImage;
-      }
-      else
-      {
-        // If we don't have a kernel, just copy to the output
-        imagePtr = image;
-      }
-
-      // Copy to output, be aware that we only copy to the extent that was asked for
-      outPtr0 = outPtr1;
-      imagePtr = imagePtr + (outMin0 - inMin0);
-      for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
-      {
-        *outPtr0 = (*imagePtr);
-        outPtr0 += outInc0;
-        ++imagePtr;
-      }
-      inPtr1 += inInc1;
-      outPtr1 += outInc1;
+      self->UpdateProgress(
+        row / (50.0 * target * self->GetNumberOfIterations()) + startProgress);
+    }
+    const int idx1 = row % numRows1;
+    const int idx2 = row / numRows1;
+    float* outRow = outPtr + idx1 * outIncs[1] + idx2 * outIncs[2];
+    const T* inRow =
+      inPtr + (axis == 1 ? 0 : idx1 * inIncs[1]) + (axis == 2 ? 0 : idx2 * inIncs[2]);
+    if (axis == 0)
+    {
+      kernel.ConvolveRow<float>(inRow, outRow, numComps);
+    }
+    else
+    {
+      kernel.ConvolveRows<float>(axis == 1 ? idx1 : idx2, inRow, inIncs[axis], outRow, rowLength);
     }
-    inPtr2 += inInc2;
-    outPtr2 += outInc2;
   }
-
-  delete[] image;
-  delete[] outImage;
-  delete[] kernel;
 }
 
 //------------------------------------------------------------------------------
 // This is written as a 1D execute method, but is called several times.
-int vtkImageSeparableConvolution::IterativeRequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+int vtkImageSeparableConvolution::IterativeRequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
   vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
   vtkImageData* inData = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   vtkImageData* outData = vtkImageData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  outData->SetExtent(outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()));
-  outData->AllocateScalars(outInfo);
-
-  if (XKernel)
+  const char* error = nullptr;
+  if (this->XKernel && this->XKernel->GetNumberOfTuples() % 2 == 0)
   {
-    // Check for a filter of odd length
-    if (1 - (XKernel->GetNumberOfTuples() % 2))
-    {
-      vtkErrorMacro(<< "Execute:  XKernel must have odd length");
-      return 1;
-    }
+    error = "Execute:  XKernel must have odd length";
   }
-  if (YKernel)
+  else if (this->YKernel && this->YKernel->GetNumberOfTuples() % 2 == 0)
   {
-    // Check for a filter of odd length
-    if (1 - (YKernel->GetNumberOfTuples() % 2))
-    {
-      vtkErrorMacro(<< "Execute:  YKernel must have odd length");
-      return 1;
-    }
+    error = "Execute:  YKernel must have odd length";
   }
-  if (ZKernel)
+  else if (this->ZKernel && this->ZKernel->GetNumberOfTuples() % 2 == 0)
   {
-    // Check for a filter of odd length
-    if (1 - (ZKernel->GetNumberOfTuples() % 2))
-    {
-      vtkErrorMacro(<< "Execute:  ZKernel must have odd length");
-      return 1;
-    }
+    error = "Execute:  ZKernel must have odd length";
   }
-
-  if (inData->GetNumberOfScalarComponents() != 1)
+  else if (inData->GetNumberOfScalarComponents() != 1)
+  {
+    error = "ImageSeparableConvolution only works on 1 component input for the moment.";
+  }
+  if (error)
   {
-    vtkErrorMacro(<< "ImageSeparableConvolution only works on 1 component input for the moment.");
+    vtkErrorMacro(<< error);
+    outData->SetExtent(outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()));
+    outData->AllocateScalars(outInfo);
     return 1;
   }
 
+  // the rows of the output are convolved by ThreadedRequestData()
+  return this->Superclass::IterativeRequestData(request, inputVector, outputVector);
+}
+
+//------------------------------------------------------------------------------
+void vtkImageSeparableConvolution::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector),
+  vtkImageData*** inDataVec, vtkImageData** outDataVec, int outExt[6], int threadId)
+{
+  vtkImageData* inData = inDataVec[0][0];
+  vtkImageData* outData = outDataVec[0];
+  int inExt[6];
+  inputVector[0]->GetInformationObject(0)->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt);
+
   // this filter expects that the output be floats.
   if (outData->GetScalarType() != VTK_FLOAT)
   {
     vtkErrorMacro(<< "Execute: Output must be type float.");
-    return 1;
+    return;
+  }
+
+  vtkFloatArray* kernelArray = nullptr;
+  switch (this->Iteration)
+  {
+    case 0:
+      kernelArray = this->XKernel;
+      break;
+    case 1:
+      kernelArray = this->YKernel;
+      break;
+    case 2:
+      kernelArray = this->ZKernel;
+      break;
   }
 
   // choose which templated function to call.
   switch (inData->GetScalarType())
   {
-    vtkTemplateMacro(vtkImageSeparableConvolutionExecute(this, inData, outData,
-      static_cast<VTK_TT*>(nullptr), inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()),
-      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT())));
+    vtkTemplateMacro(vtkImageSeparableConvolutionExecute<VTK_TT>(
+      this, kernelArray, inData, inExt, outData, outExt, threadId));
     default:
       vtkErrorMacro(<< "Execute: Unknown ScalarType");
-      return 1;
+      return;
   }
-
-  return 1;
 }
 
 void vtkImageSeparableConvolution::PrintSelf(ostream& os, vtkIndent indent)
@@ -23,7 +23,8 @@
  * that dimension is skipped.  This filter is designed to efficiently
  * convolve separable filters that can be decomposed into 1 or more 1D
  * convolutions.  It also handles arbitrarily large kernel sizes, and
- * uses edge replication to handle boundaries.
+ * uses edge replication to handle boundaries.  Each convolution is
+ * threaded by pieces of the output, and done a row of X values at a time.
  */
 
 #ifndef vtkImageSeparableConvolution_h
@@ -72,6 +73,9 @@ protected:
   vtkFloatArray* ZKernel;
 
   int IterativeRequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
+    int outExt[6], int threadId) override;
 
   int IterativeRequestInformation(vtkInformation* in, vtkInformation* out) override;
   int IterativeRequestUpdateExtent(vtkInformation* in, vtkInformation* out) override;
@@ -0,0 +1,353 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageSeparableKernel.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageSeparableKernel
+ * @brief   internals for the separable convolution filters
+ *
+ * vtkImageSeparableKernel holds the weights of a 1D convolution along one
+ * axis of an image, for each output sample along that axis, and convolves
+ * the rows of the image with them.  The samples away from the boundaries
+ * share their weights, and are grouped in runs: along X, each weight is
+ * applied to a whole run of contiguous values at once, and along Y and Z,
+ * to whole rows of contiguous values.  The accumulations are done by tiles
+ * that stay in cache, in loops over contiguous values that the compiler
+ * can vectorize.
+ *
+ * vtkImageRecursiveGaussian is the fourth order recursive approximation of
+ * the gaussian of Deriche, whose cost does not depend on the standard
+ * deviation.  The rows along Y and Z are filtered together, by tiles.
+ */
+
+#ifndef vtkImageSeparableKernel_h
+#define vtkImageSeparableKernel_h
+
+#include "vtkType.h"
+#include "vtkTypeTraits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// The type used to accumulate the weighted values of each scalar type:
+// float for the types it represents exactly, double for the others.
+template <class T>
+struct vtkImageSeparableKernelAccumulator
+{
+  typedef double Type;
+};
+
+#define vtkImageSeparableKernelFloatAccumulator(T)                                                 \
+  template <>                                                                                      \
+  struct vtkImageSeparableKernelAccumulator<T>                                                     \
+  {                                                                                                \
+    typedef float Type;                                                                            \
+  }
+
+vtkImageSeparableKernelFloatAccumulator(float);
+vtkImageSeparableKernelFloatAccumulator(char);
+vtkImageSeparableKernelFloatAccumulator(signed char);
+vtkImageSeparableKernelFloatAccumulator(unsigned char);
+vtkImageSeparableKernelFloatAccumulator(short);
+vtkImageSeparableKernelFloatAccumulator(unsigned short);
+
+#undef vtkImageSeparableKernelFloatAccumulator
+
+class vtkImageSeparableKernel
+{
+public:
+  // The number of values accumulated at once
+  enum
+  {
+    TileSize = 1024
+  };
+
+  /**
+   * Add the output sample at position (from the first output sample),
+   * computed from the size input samples from inputStart (from the first
+   * input sample).  The samples must be added in order.
+   */
+  void AddSample(int position, int inputStart, const double* weights, int size)
+  {
+    if (!this->Runs.empty())
+    {
+      Run& last = this->Runs.back();
+      if (last.Last + 1 == position && last.Size == size &&
+        last.InputStart + (position - last.First) == inputStart &&
+        std::equal(weights, weights + size, this->Weights.begin() + last.Weights))
+      {
+        last.Last = position;
+        return;
+      }
+    }
+    Run run;
+    run.First = position;
+    run.Last = position;
+    run.InputStart = inputStart;
+    run.Size = size;
+    run.Weights = this->Weights.size();
+    this->Runs.push_back(run);
+    this->Weights.insert(this->Weights.end(), weights, weights + size);
+  }
+
+  /**
+   * Convolve a row along X, from the input row at the first input sample
+   * to the output row at the first output sample.
+   */
+  template <class KT, class IT, class OT>
+  void ConvolveRow(const IT* inRow, OT* outRow, int numComponents) const
+  {
+    for (const Run& run : this->Runs)
+    {
+      vtkImageSeparableKernel::Convolve<KT>(inRow + run.InputStart * numComponents,
+        numComponents, &this->Weights[run.Weights], run.Size, outRow + run.First * numComponents,
+        static_cast<vtkIdType>(run.Last - run.First + 1) * numComponents);
+    }
+  }
+
+  /**
+   * Convolve along Y or Z the row at position of the output, from the
+   * input row at the first input sample, inInc apart from the next one.
+   */
+  template <class KT, class IT, class OT>
+  void ConvolveRows(
+    int position, const IT* inRow, vtkIdType inInc, OT* outRow, vtkIdType rowLength) const
+  {
+    const Run& run = *(std::upper_bound(this->Runs.begin(), this->Runs.end(), position,
+                         [](int p, const Run& r) { return p < r.First; }) -
+      1);
+    vtkImageSeparableKernel::Convolve<KT>(inRow + (run.InputStart + position - run.First) * inInc,
+      inInc, &this->Weights[run.Weights], run.Size, outRow, rowLength);
+  }
+
+private:
+  // Consecutive output samples computed with the same weights, from
+  // consecutive input samples
+  struct Run
+  {
+    int First;
+    int Last;
+    int InputStart;
+    int Size;
+    size_t Weights;
+  };
+
+  std::vector<Run> Runs;
+  std::vector<double> Weights;
+
+  // out[j] = sum(w[t] * in[t * step + j]) for j in [0, n)
+  template <class KT, class IT, class OT>
+  static void Convolve(
+    const IT* in, vtkIdType step, const double* w, int size, OT* out, vtkIdType n)
+  {
+    KT acc[TileSize];
+    for (vtkIdType j0 = 0; j0 < n; j0 += TileSize)
+    {
+      const int m = static_cast<int>(std::min<vtkIdType>(TileSize, n - j0));
+      const IT* inT = in + j0;
+      const KT w0 = static_cast<KT>(w[0]);
+      for (int j = 0; j < m; ++j)
+      {
+        acc[j] = w0 * static_cast<KT>(inT[j]);
+      }
+      for (int t = 1; t < size; ++t)
+      {
+        inT += step;
+        const KT wt = static_cast<KT>(w[t]);
+        for (int j = 0; j < m; ++j)
+        {
+          acc[j] += wt * static_cast<KT>(inT[j]);
+        }
+      }
+      OT* outT = out + j0;
+      for (int j = 0; j < m; ++j)
+      {
+        outT[j] = static_cast<OT>(acc[j]);
+      }
+    }
+  }
+};
+
+class vtkImageRecursiveGaussian
+{
+public:
+  // The number of rows along Y or Z filtered together
+  enum
+  {
+    TileSize = 32
+  };
+
+  /**
+   * The smallest standard deviation the filter approximates well.
+   */
+  static double GetMinimumStandardDeviation() { return 1.0; }
+
+  /**
+   * Compute the coefficients for a standard deviation in pixels, normalized
+   * so that the gain of the filter is one.
+   */
+  explicit vtkImageRecursiveGaussian(double std)
+  {
+    // The gaussian as a sum of two damped cosines and sines, as fitted by
+    // Farneback and Westin for the filter of Deriche
+    const double a0 = 1.6797292232361107;
+    const double a1 = 3.7348298269103580;
+    const double b0 = 1.7831906544515104;
+    const double b1 = 1.7228297663338028;
+    const double c0 = -0.6802783501806897;
+    const double c1 = -0.2598300478959625;
+    const double w0 = 0.6318113174569493;
+    const double w1 = 1.9969276832487770;
+
+    const double cos0 = std::cos(w0 / std);
+    const double sin0 = std::sin(w0 / std);
+    const double e0 = std::exp(-b0 / std);
+    const double cos1 = std::cos(w1 / std);
+    const double sin1 = std::sin(w1 / std);
+    const double e1 = std::exp(-b1 / std);
+
+    double* n = this->N;
+    double* d = this->D;
+    double* m = this->M;
+    n[0] = a0 + c0;
+    n[1] = e1 * (c1 * sin1 - (c0 + 2.0 * a0) * cos1) + e0 * (a1 * sin0 - (2.0 * c0 + a0) * cos0);
+    n[2] = 2.0 * e0 * e1 * ((a0 + c0) * cos1 * cos0 - a1 * cos1 * sin0 - c1 * cos0 * sin1) +
+      c0 * e0 * e0 + a0 * e1 * e1;
+    n[3] = e1 * e0 * e0 * (c1 * sin1 - c0 * cos1) + e0 * e1 * e1 * (a1 * sin0 - a0 * cos0);
+    d[0] = -2.0 * e1 * cos1 - 2.0 * e0 * cos0;
+    d[1] = 4.0 * cos1 * cos0 * e0 * e1 + e1 * e1 + e0 * e0;
+    d[2] = -2.0 * cos0 * e0 * e1 * e1 - 2.0 * cos1 * e1 * e0 * e0;
+    d[3] = e0 * e0 * e1 * e1;
+
+    // the anti-causal part mirrors the causal part
+    m[0] = n[1] - d[0] * n[0];
+    m[1] = n[2] - d[1] * n[0];
+    m[2] = n[3] - d[2] * n[0];
+    m[3] = -d[3] * n[0];
+
+    const double denominator = 1.0 + d[0] + d[1] + d[2] + d[3];
+    const double gain = (n[0] + n[1] + n[2] + n[3] + m[0] + m[1] + m[2] + m[3]) / denominator;
+    for (int k = 0; k < 4; ++k)
+    {
+      n[k] /= gain;
+      m[k] /= gain;
+    }
+    this->CausalGain = (n[0] + n[1] + n[2] + n[3]) / denominator;
+  }
+
+  /**
+   * The size of the buffer needed to filter lines of n samples.
+   */
+  static size_t GetBufferSize(int n, int width) { return static_cast<size_t>(3) * (n + 8) * width; }
+
+  /**
+   * Filter width interleaved lines of n samples, inStep apart along the
+   * lines, with the edges replicated, and write the samples [first,
+   * first + count) to out, outStep apart.  The values are clamped to the
+   * range of the output type.  The recursion is done in double precision,
+   * as it is unstable in float precision for large standard deviations.
+   */
+  template <class IT, class OT>
+  void Filter(const IT* in, vtkIdType inStep, int n, OT* out, vtkIdType outStep, int first,
+    int count, int width, double* buffer) const
+  {
+    typedef double KT;
+    const KT* nk = this->N;
+    const KT* mk = this->M;
+    const KT* dk = this->D;
+    const KT causalGain = this->CausalGain;
+    const KT antiCausalGain = 1.0 - this->CausalGain;
+
+    // the lines, with four replicated samples at each end, and the outputs
+    // of the causal and anti-causal filters, row r being sample r - 4
+    const int numRows = n + 8;
+    KT* x = buffer;
+    KT* yc = x + static_cast<size_t>(numRows) * width;
+    KT* ya = yc + static_cast<size_t>(numRows) * width;
+    for (int r = 0; r < numRows; ++r)
+    {
+      const IT* sample = in + std::min(std::max(r - 4, 0), n - 1) * inStep;
+      KT* xr = x + r * width;
+      for (int j = 0; j < width; ++j)
+      {
+        xr[j] = static_cast<KT>(sample[j]);
+      }
+    }
+
+    // causal pass, from the steady state of the first sample
+    for (int r = 0; r < 4; ++r)
+    {
+      for (int j = 0; j < width; ++j)
+      {
+        yc[r * width + j] = causalGain * x[j];
+      }
+    }
+    const int lastRow = first + count + 3;
+    for (int r = 4; r <= lastRow; ++r)
+    {
+      const KT* xr = x + r * width;
+      KT* yr = yc + r * width;
+      for (int j = 0; j < width; ++j)
+      {
+        yr[j] = nk[0] * xr[j] + nk[1] * xr[j - width] + nk[2] * xr[j - 2 * width] +
+          nk[3] * xr[j - 3 * width] - dk[0] * yr[j - width] - dk[1] * yr[j - 2 * width] -
+          dk[2] * yr[j - 3 * width] - dk[3] * yr[j - 4 * width];
+      }
+    }
+
+    // anti-causal pass, from the steady state of the last sample
+    const KT* xLast = x + (n + 3) * width;
+    for (int r = n + 4; r < numRows; ++r)
+    {
+      for (int j = 0; j < width; ++j)
+      {
+        ya[r * width + j] = antiCausalGain * xLast[j];
+      }
+    }
+    const int firstRow = first + 4;
+    for (int r = n + 3; r >= firstRow; --r)
+    {
+      const KT* xr = x + r * width;
+      KT* yr = ya + r * width;
+      for (int j = 0; j < width; ++j)
+      {
+        yr[j] = mk[0] * xr[j + width] + mk[1] * xr[j + 2 * width] + mk[2] * xr[j + 3 * width] +
+          mk[3] * xr[j + 4 * width] - dk[0] * yr[j + width] - dk[1] * yr[j + 2 * width] -
+          dk[2] * yr[j + 3 * width] - dk[3] * yr[j + 4 * width];
+      }
+    }
+
+    const KT minValue = static_cast<KT>(vtkTypeTraits<OT>::Min());
+    const KT maxValue = static_cast<KT>(vtkTypeTraits<OT>::Max());
+    for (int p = 0; p < count; ++p)
+    {
+      const KT* ycr = yc + (firstRow + p) * width;
+      const KT* yar = ya + (firstRow + p) * width;
+      OT* o = out + p * outStep;
+      for (int j = 0; j < width; ++j)
+      {
+        o[j] = static_cast<OT>(std::min(std::max(ycr[j] + yar[j], minValue), maxValue));
+      }
+    }
+  }
+
+private:
+  double N[4];
+  double M[4];
+  double D[4];
+  double CausalGain;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImageSeparableKernel.h
@@ -24,9 +24,12 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkSampleFunction);
 vtkCxxSetObjectMacro(vtkSampleFunction, ImplicitFunction, vtkImplicitFunction);
 
@@ -55,34 +58,44 @@ public:
   // Cap the boundaries with the specified cap value (if requested).
   void Cap();
 
-  // Interface implicit function computation to SMP tools.
+  // Interface implicit function computation to SMP tools. The function is
+  // evaluated one slice at a time with its array interface.
   template <class TT>
   class FunctionValueOp
   {
   public:
     FunctionValueOp(vtkSampleFunctionAlgorithm<TT>* algo) { this->Algo = algo; }
     vtkSampleFunctionAlgorithm* Algo;
+    vtkSMPThreadLocalObject<vtkDoubleArray> Points;
+    vtkSMPThreadLocalObject<vtkDoubleArray> Values;
 
     void operator()(vtkIdType k, vtkIdType end)
     {
-      double x[3];
       vtkIdType* extent = this->Algo->Extent;
-      vtkIdType i, j, jOffset, kOffset;
+      vtkIdType i, j;
+      vtkDoubleArray* points = this->Points.Local();
+      vtkDoubleArray* values = this->Values.Local();
+      points->SetNumberOfComponents(3);
+      points->SetNumberOfTuples(this->Algo->SliceSize);
       for (; k < end; ++k)
       {
-        x[2] = this->Algo->Origin[2] + k * this->Algo->Spacing[2];
-        kOffset = (k - extent[4]) * this->Algo->SliceSize;
+        double* x = points->GetPointer(0);
+        const double z = this->Algo->Origin[2] + k * this->Algo->Spacing[2];
         for (j = extent[2]; j <= extent[3]; ++j)
         {
-          x[1] = this->Algo->Origin[1] + j * this->Algo->Spacing[1];
-          jOffset = (j - extent[2]) * this->Algo->Dims[0];
-          for (i = extent[0]; i <= extent[1]; ++i)
+          const double y = this->Algo->Origin[1] + j * this->Algo->Spacing[1];
+          for (i = extent[0]; i <= extent[1]; ++i, x += 3)
           {
             x[0] = this->Algo->Origin[0] + i * this->Algo->Spacing[0];
-            this->Algo->Scalars[(i - extent[0]) + jOffset + kOffset] =
-              static_cast<TT>(this->Algo->ImplicitFunction->FunctionValue(x));
+            x[1] = y;
+            x[2] = z;
           }
         }
+        this->Algo->ImplicitFunction->FunctionValue(points, values);
+        const double* v = values->GetPointer(0);
+        std::transform(v, v + this->Algo->SliceSize,
+          this->Algo->Scalars + (k - extent[4]) * this->Algo->SliceSize,
+          [](double s) { return static_cast<TT>(s); });
       }
     }
   };
@@ -0,0 +1,312 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageMorphologyKernelShapes.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the box and ball kernels of the morphology filters
+//
+// The box kernels are compared with a brute force maximum or minimum, and
+// the ball kernels with a brute force maximum over their foot print, which
+// is the dilation of a single voxel.  The ball must also be close to the
+// ellipsoid, and the results must not depend on the number of threads.
+
+#include "vtkImageContinuousDilate3D.h"
+#include "vtkImageContinuousErode3D.h"
+#include "vtkImageData.h"
+#include "vtkImageDilateErode3D.h"
+#include "vtkImageOpenClose3D.h"
+#include "vtkNew.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// A pseudo-random image, with the given number of distinct values
+void MakeImage(vtkImageData* image, int dim0, int dim1, int dim2, int numComps, int numValues)
+{
+  image->SetDimensions(dim0, dim1, dim2);
+  image->AllocateScalars(VTK_SHORT, numComps);
+  short* ptr = static_cast<short*>(image->GetScalarPointer());
+  unsigned int seed = 12345;
+  vtkIdType n = image->GetNumberOfPoints() * numComps;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    seed = seed * 1103515245u + 12345u;
+    ptr[i] = static_cast<short>((seed >> 16) % numValues) - 10;
+  }
+}
+
+// The offsets of the voxels of a foot print
+typedef std::vector<int> FootPrint;
+
+FootPrint BoxFootPrint(const int size[3])
+{
+  FootPrint offsets;
+  for (int k = -(size[2] / 2); k < size[2] - size[2] / 2; ++k)
+  {
+    for (int j = -(size[1] / 2); j < size[1] - size[1] / 2; ++j)
+    {
+      for (int i = -(size[0] / 2); i < size[0] - size[0] / 2; ++i)
+      {
+        offsets.push_back(i);
+        offsets.push_back(j);
+        offsets.push_back(k);
+      }
+    }
+  }
+  return offsets;
+}
+
+// The foot print of the given filter, from the dilation of a single voxel
+FootPrint DilatedFootPrint(vtkImageAlgorithm* filter, const int size[3])
+{
+  vtkNew<vtkImageData> point;
+  point->SetDimensions(2 * size[0] + 1, 2 * size[1] + 1, 2 * size[2] + 1);
+  point->AllocateScalars(VTK_SHORT, 1);
+  short* ptr = static_cast<short*>(point->GetScalarPointer());
+  std::fill(ptr, ptr + point->GetNumberOfPoints(), 0);
+  *static_cast<short*>(point->GetScalarPointer(size[0], size[1], size[2])) = 1;
+  filter->SetInputData(point);
+  filter->Update();
+  FootPrint offsets;
+  vtkImageData* output = filter->GetOutput();
+  for (int k = 0; k <= 2 * size[2]; ++k)
+  {
+    for (int j = 0; j <= 2 * size[1]; ++j)
+    {
+      for (int i = 0; i <= 2 * size[0]; ++i)
+      {
+        if (*static_cast<short*>(output->GetScalarPointer(i, j, k)))
+        {
+          offsets.push_back(i - size[0]);
+          offsets.push_back(j - size[1]);
+          offsets.push_back(k - size[2]);
+        }
+      }
+    }
+  }
+  return offsets;
+}
+
+// Compare the output of a continuous dilation (or erosion) with the brute
+// force maximum (or minimum) over the foot print.
+bool CheckContinuous(
+  vtkImageData* input, vtkImageData* output, const FootPrint& offsets, bool dilate)
+{
+  int dims[3];
+  input->GetDimensions(dims);
+  const int numComps = input->GetNumberOfScalarComponents();
+  for (int k = 0; k < dims[2]; ++k)
+  {
+    for (int j = 0; j < dims[1]; ++j)
+    {
+      for (int i = 0; i < dims[0]; ++i)
+      {
+        for (int c = 0; c < numComps; ++c)
+        {
+          short expected = *(static_cast<short*>(input->GetScalarPointer(i, j, k)) + c);
+          for (size_t o = 0; o < offsets.size(); o += 3)
+          {
+            int p[3] = { i + offsets[o], j + offsets[o + 1], k + offsets[o + 2] };
+            if (p[0] >= 0 && p[0] < dims[0] && p[1] >= 0 && p[1] < dims[1] && p[2] >= 0 &&
+              p[2] < dims[2])
+            {
+              short value = *(static_cast<short*>(input->GetScalarPointer(p)) + c);
+              expected = (dilate ? std::max(expected, value) : std::min(expected, value));
+            }
+          }
+          short value = *(static_cast<short*>(output->GetScalarPointer(i, j, k)) + c);
+          if (value != expected)
+          {
+            std::cerr << "Wrong value " << value << " instead of " << expected << " at " << i
+                      << ", " << j << ", " << k << std::endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Compare the output of vtkImageDilateErode3D with the brute force
+bool CheckDilateErode(
+  vtkImageData* input, vtkImageData* output, const FootPrint& offsets, short dilate, short erode)
+{
+  int dims[3];
+  input->GetDimensions(dims);
+  for (int k = 0; k < dims[2]; ++k)
+  {
+    for (int j = 0; j < dims[1]; ++j)
+    {
+      for (int i = 0; i < dims[0]; ++i)
+      {
+        short expected = *static_cast<short*>(input->GetScalarPointer(i, j, k));
+        for (size_t o = 0; expected == erode && o < offsets.size(); o += 3)
+        {
+          int p[3] = { i + offsets[o], j + offsets[o + 1], k + offsets[o + 2] };
+          if (p[0] >= 0 && p[0] < dims[0] && p[1] >= 0 && p[1] < dims[1] && p[2] >= 0 &&
+            p[2] < dims[2] && *static_cast<short*>(input->GetScalarPointer(p)) == dilate)
+          {
+            expected = dilate;
+          }
+        }
+        if (*static_cast<short*>(output->GetScalarPointer(i, j, k)) != expected)
+        {
+          std::cerr << "Wrong dilate/erode value at " << i << ", " << j << ", " << k << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool SameScalars(vtkImageData* image1, vtkImageData* image2)
+{
+  vtkIdType n = image1->GetNumberOfPoints() * image1->GetNumberOfScalarComponents();
+  const short* ptr1 = static_cast<short*>(image1->GetScalarPointer());
+  const short* ptr2 = static_cast<short*>(image2->GetScalarPointer());
+  return (n == image2->GetNumberOfPoints() * image2->GetNumberOfScalarComponents() &&
+    std::equal(ptr1, ptr1 + n, ptr2));
+}
+}
+
+int TestImageMorphologyKernelShapes(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  MakeImage(image, 23, 19, 17, 2, 200);
+  vtkNew<vtkImageData> labels;
+  MakeImage(labels, 23, 19, 17, 1, 12);
+
+  // Box kernels, including even and flat ones
+  const int boxSizes[][3] = { { 5, 3, 7 }, { 4, 6, 1 }, { 1, 1, 9 } };
+  for (const int* size : boxSizes)
+  {
+    FootPrint box = BoxFootPrint(size);
+    vtkNew<vtkImageContinuousDilate3D> dilate;
+    dilate->SetKernelSize(size[0], size[1], size[2]);
+    dilate->SetKernelShapeToBox();
+    dilate->SetInputData(image);
+    dilate->Update();
+    vtkNew<vtkImageContinuousErode3D> erode;
+    erode->SetKernelSize(size[0], size[1], size[2]);
+    erode->SetKernelShapeToBox();
+    erode->SetInputData(image);
+    erode->Update();
+    vtkNew<vtkImageDilateErode3D> dilateErode;
+    dilateErode->SetKernelSize(size[0], size[1], size[2]);
+    dilateErode->SetKernelShapeToBox();
+    dilateErode->SetDilateValue(-10);
+    dilateErode->SetErodeValue(-9);
+    dilateErode->SetInputData(labels);
+    dilateErode->Update();
+    if (!CheckContinuous(image, dilate->GetOutput(), box, true) ||
+      !CheckContinuous(image, erode->GetOutput(), box, false) ||
+      !CheckDilateErode(labels, dilateErode->GetOutput(), box, -10, -9))
+    {
+      std::cerr << "Wrong box of size " << size[0] << " " << size[1] << " " << size[2]
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Ball kernels, whose foot print is the dilation of a single voxel
+  const int ballSizes[][3] = { { 9, 9, 9 }, { 15, 11, 1 }, { 11, 7, 13 } };
+  for (const int* size : ballSizes)
+  {
+    vtkNew<vtkImageContinuousDilate3D> dilate;
+    dilate->SetKernelSize(size[0], size[1], size[2]);
+    dilate->SetKernelShapeToBall();
+    FootPrint ball = DilatedFootPrint(dilate, size);
+    dilate->SetInputData(image);
+    dilate->Update();
+    vtkNew<vtkImageContinuousErode3D> erode;
+    erode->SetKernelSize(size[0], size[1], size[2]);
+    erode->SetKernelShapeToBall();
+    erode->SetInputData(image);
+    erode->Update();
+    vtkNew<vtkImageDilateErode3D> dilateErode;
+    dilateErode->SetKernelSize(size[0], size[1], size[2]);
+    dilateErode->SetKernelShapeToBall();
+    dilateErode->SetDilateValue(-10);
+    dilateErode->SetErodeValue(-9);
+    dilateErode->SetInputData(labels);
+    dilateErode->Update();
+    if (ball.size() < 9 || !CheckContinuous(image, dilate->GetOutput(), ball, true) ||
+      !CheckContinuous(image, erode->GetOutput(), ball, false) ||
+      !CheckDilateErode(labels, dilateErode->GetOutput(), ball, -10, -9))
+    {
+      std::cerr << "Wrong ball of size " << size[0] << " " << size[1] << " " << size[2]
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A large ball must be close to the ellipsoid, within its bounds
+  const int size[3] = { 31, 31, 31 };
+  vtkNew<vtkImageContinuousDilate3D> ballDilate;
+  ballDilate->SetKernelSize(size[0], size[1], size[2]);
+  ballDilate->SetKernelShapeToBall();
+  FootPrint ball = DilatedFootPrint(ballDilate, size);
+  vtkNew<vtkImageContinuousDilate3D> ellipsoidDilate;
+  ellipsoidDilate->SetKernelSize(size[0], size[1], size[2]);
+  FootPrint ellipsoid = DilatedFootPrint(ellipsoidDilate, size);
+  std::vector<char> inEllipsoid(size[0] * size[1] * size[2], 0);
+  for (size_t o = 0; o < ellipsoid.size(); o += 3)
+  {
+    int i = ellipsoid[o] + 15;
+    int j = ellipsoid[o + 1] + 15;
+    int k = ellipsoid[o + 2] + 15;
+    inEllipsoid[i + 31 * (j + 31 * k)] = 1;
+  }
+  size_t common = 0;
+  for (size_t o = 0; o < ball.size(); o += 3)
+  {
+    if (std::abs(ball[o]) > 15 || std::abs(ball[o + 1]) > 15 || std::abs(ball[o + 2]) > 15)
+    {
+      std::cerr << "The ball is larger than its kernel size." << std::endl;
+      return EXIT_FAILURE;
+    }
+    common += inEllipsoid[(ball[o] + 15) + 31 * ((ball[o + 1] + 15) + 31 * (ball[o + 2] + 15))];
+  }
+  double jaccard = static_cast<double>(common) / (ball.size() / 3 + ellipsoid.size() / 3 - common);
+  if (jaccard < 0.9)
+  {
+    std::cerr << "The ball is too far from the ellipsoid: " << jaccard << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The pieces of the threads must give the same result as a single piece
+  vtkNew<vtkImageOpenClose3D> openClose[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    openClose[i]->SetKernelSize(7, 7, 5);
+    openClose[i]->SetKernelShapeToBall();
+    openClose[i]->SetOpenValue(-10);
+    openClose[i]->SetCloseValue(-9);
+    openClose[i]->GetFilter0()->SetNumberOfThreads(i == 0 ? 1 : 4);
+    openClose[i]->GetFilter1()->SetNumberOfThreads(i == 0 ? 1 : 4);
+    openClose[i]->SetInputData(labels);
+    openClose[i]->Update();
+  }
+  if (openClose[0]->GetKernelShape() != vtkImageDilateErode3D::Ball ||
+    !SameScalars(openClose[0]->GetOutput(), openClose[1]->GetOutput()))
+  {
+    std::cerr << "The opening depends on the number of threads." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
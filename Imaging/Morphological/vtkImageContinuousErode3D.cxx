@@ -17,6 +17,7 @@
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageLineMorphology.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -39,6 +40,8 @@ vtkImageContinuousErode3D::vtkImageContinuousErode3D()
   this->KernelSize[1] = 0;
   this->KernelSize[2] = 0;
 
+  this->KernelShape = Ellipsoid;
+  this->LineMorphology = new vtkImageLineMorphology;
   this->Ellipse = vtkImageEllipsoidSource::New();
   // Setup the Ellipse to default size
   this->SetKernelSize(1, 1, 1);
@@ -52,12 +55,34 @@ vtkImageContinuousErode3D::~vtkImageContinuousErode3D()
     this->Ellipse->Delete();
     this->Ellipse = nullptr;
   }
+  delete this->LineMorphology;
 }
 
 //------------------------------------------------------------------------------
 void vtkImageContinuousErode3D::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "KernelShape: " << this->GetKernelShapeAsString() << "\n";
+}
+
+//------------------------------------------------------------------------------
+const char* vtkImageContinuousErode3D::GetKernelShapeAsString()
+{
+  const char* result = "Unknown";
+  switch (this->KernelShape)
+  {
+    case Ellipsoid:
+      result = "Ellipsoid";
+      break;
+    case Box:
+      result = "Box";
+      break;
+    case Ball:
+      result = "Ball";
+      break;
+  }
+  return result;
 }
 
 //------------------------------------------------------------------------------
@@ -241,6 +266,26 @@ void vtkImageContinuousErode3DExecute(vtkImageContinuousErode3D* self, vtkImageD
   }
 }
 
+//------------------------------------------------------------------------------
+// This templated function executes the filter with the line segments of a
+// box or ball kernel, at a cost that does not depend on the kernel size.
+template <class T>
+void vtkImageContinuousErode3DExecuteLines(vtkImageContinuousErode3D* self,
+  const vtkImageLineMorphology* lines, vtkImageData* inData, vtkDataArray* inArray,
+  vtkImageData* outData, const int* outExt, int id)
+{
+  auto progress = [self, id](double fraction) {
+    if (!id)
+    {
+      self->UpdateProgress(fraction);
+    }
+    return !self->AbortExecute;
+  };
+  lines->ExecuteImage<T, vtkImageLineMorphologyMin<T>>(static_cast<T*>(inArray->GetVoidPointer(0)),
+    inData->GetExtent(), static_cast<T*>(outData->GetScalarPointer()), outData->GetExtent(), outExt,
+    outData->GetNumberOfScalarComponents(), progress);
+}
+
 //------------------------------------------------------------------------------
 // This method contains the first switch statement that calls the correct
 // templated function for the input and output Data types.
@@ -268,14 +313,6 @@ void vtkImageContinuousErode3D::ThreadedRequestData(vtkInformation* vtkNotUsed(r
   // The inPtr is reset anyway, so just get the id 0 pointer.
   inPtr = inArray->GetVoidPointer(0);
 
-  // Error checking on mask
-  mask = this->Ellipse->GetOutput();
-  if (mask->GetScalarType() != VTK_UNSIGNED_CHAR)
-  {
-    vtkErrorMacro(<< "Execute: mask has wrong scalar type");
-    return;
-  }
-
   // this filter expects the output type to be same as input
   if (outData[0]->GetScalarType() != inArray->GetDataType())
   {
@@ -285,6 +322,27 @@ void vtkImageContinuousErode3D::ThreadedRequestData(vtkInformation* vtkNotUsed(r
     return;
   }
 
+  // the box and the ball are decomposed in line segments
+  if (this->KernelShape != Ellipsoid)
+  {
+    switch (inArray->GetDataType())
+    {
+      vtkTemplateMacro(vtkImageContinuousErode3DExecuteLines<VTK_TT>(
+        this, this->LineMorphology, inData[0][0], inArray, outData[0], outExt, id));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+    }
+    return;
+  }
+
+  // Error checking on mask
+  mask = this->Ellipse->GetOutput();
+  if (mask->GetScalarType() != VTK_UNSIGNED_CHAR)
+  {
+    vtkErrorMacro(<< "Execute: mask has wrong scalar type");
+    return;
+  }
+
   switch (inArray->GetDataType())
   {
     vtkTemplateMacro(vtkImageContinuousErode3DExecute(this, mask, inData[0][0],
@@ -299,6 +357,17 @@ void vtkImageContinuousErode3D::ThreadedRequestData(vtkInformation* vtkNotUsed(r
 int vtkImageContinuousErode3D::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  this->Ellipse->Update();
+  if (this->KernelShape == Box)
+  {
+    this->LineMorphology->SetBox(this->KernelSize, this->KernelMiddle);
+  }
+  else if (this->KernelShape == Ball)
+  {
+    this->LineMorphology->SetBall(this->KernelSize, this->KernelMiddle);
+  }
+  else
+  {
+    this->Ellipse->Update();
+  }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
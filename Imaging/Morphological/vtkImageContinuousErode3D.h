@@ -19,6 +19,12 @@
  * vtkImageContinuousErode3D replaces a pixel with the minimum over
  * an ellipsoidal neighborhood.  If KernelSize of an axis is 1, no processing
  * is done on that axis.
+ *
+ * The cost of the ellipsoid grows with the volume of the kernel.  For large
+ * kernels, the neighborhood can instead be a box, or a ball that
+ * approximates the ellipsoid, which are decomposed into line segments
+ * along which the minimum is computed with the van Herk/Gil-Werman algorithm,
+ * at a cost per voxel that does not depend on the kernel size.
  */
 
 #ifndef vtkImageContinuousErode3D_h
@@ -28,6 +34,7 @@
 #include "vtkImagingMorphologicalModule.h" // For export macro
 
 class vtkImageEllipsoidSource;
+class vtkImageLineMorphology;
 
 class VTKIMAGINGMORPHOLOGICAL_EXPORT vtkImageContinuousErode3D : public vtkImageSpatialAlgorithm
 {
@@ -48,11 +55,38 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  /**
+   * Enum constants for SetKernelShape().
+   */
+  enum KernelShapeEnum
+  {
+    Ellipsoid = 0,
+    Box = 1,
+    Ball = 2
+  };
+
+  ///@{
+  /**
+   * The shape of the neighborhood.  The default Ellipsoid visits every
+   * voxel of the kernel.  Box and Ball are decomposed into line segments,
+   * and Ball is an approximation of the ellipsoid with up to 13 segments,
+   * which is closer for larger kernels.
+   */
+  vtkSetClampMacro(KernelShape, int, Ellipsoid, Ball);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(Ellipsoid); }
+  void SetKernelShapeToBox() { this->SetKernelShape(Box); }
+  void SetKernelShapeToBall() { this->SetKernelShape(Ball); }
+  vtkGetMacro(KernelShape, int);
+  const char* GetKernelShapeAsString();
+  ///@}
+
 protected:
   vtkImageContinuousErode3D();
   ~vtkImageContinuousErode3D() override;
 
   vtkImageEllipsoidSource* Ellipse;
+  vtkImageLineMorphology* LineMorphology;
+  int KernelShape;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
@@ -15,12 +15,14 @@
 #include "vtkImageDilateErode3D.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageLineMorphology.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageDilateErode3D);
 
@@ -39,6 +41,8 @@ vtkImageDilateErode3D::vtkImageDilateErode3D()
   this->DilateValue = 0.0;
   this->ErodeValue = 255.0;
 
+  this->KernelShape = Ellipsoid;
+  this->LineMorphology = new vtkImageLineMorphology;
   this->Ellipse = vtkImageEllipsoidSource::New();
   // Setup the Ellipse to default size
   this->SetKernelSize(1, 1, 1);
@@ -52,6 +56,7 @@ vtkImageDilateErode3D::~vtkImageDilateErode3D()
     this->Ellipse->Delete();
     this->Ellipse = nullptr;
   }
+  delete this->LineMorphology;
 }
 
 //------------------------------------------------------------------------------
@@ -61,6 +66,26 @@ void vtkImageDilateErode3D::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "DilateValue: " << this->DilateValue << "\n";
   os << indent << "ErodeValue: " << this->ErodeValue << "\n";
+  os << indent << "KernelShape: " << this->GetKernelShapeAsString() << "\n";
+}
+
+//------------------------------------------------------------------------------
+const char* vtkImageDilateErode3D::GetKernelShapeAsString()
+{
+  const char* result = "Unknown";
+  switch (this->KernelShape)
+  {
+    case Ellipsoid:
+      result = "Ellipsoid";
+      break;
+    case Box:
+      result = "Box";
+      break;
+    case Ball:
+      result = "Ball";
+      break;
+  }
+  return result;
 }
 
 //------------------------------------------------------------------------------
@@ -249,6 +274,88 @@ void vtkImageDilateErode3DExecute(vtkImageDilateErode3D* self, vtkImageData* mas
   }
 }
 
+//------------------------------------------------------------------------------
+// This templated function executes the filter with the line segments of a
+// box or ball kernel: the voxels that have the dilate value are dilated as
+// a binary image, which then gives the voxels with the erode value that
+// change.
+template <class T>
+void vtkImageDilateErode3DExecuteLines(vtkImageDilateErode3D* self,
+  const vtkImageLineMorphology* lines, vtkImageData* inData, vtkImageData* outData,
+  const int* outExt, int id)
+{
+  const T erodeValue = static_cast<T>(self->GetErodeValue());
+  const T dilateValue = static_cast<T>(self->GetDilateValue());
+  const int numComps = outData->GetNumberOfScalarComponents();
+  const int* inExt = inData->GetExtent();
+  vtkIdType inInc0, inInc1, inInc2;
+  inData->GetIncrements(inInc0, inInc1, inInc2);
+  vtkIdType outInc0, outInc1, outInc2;
+  outData->GetIncrements(outInc0, outInc1, outInc2);
+
+  int bufferExt[6];
+  lines->GetBufferExtent(outExt, bufferExt);
+  const vtkIdType bufferInc1 = bufferExt[1] - bufferExt[0] + 1;
+  const vtkIdType bufferInc2 = bufferInc1 * (bufferExt[3] - bufferExt[2] + 1);
+  std::vector<unsigned char> buffer(bufferInc2 * (bufferExt[5] - bufferExt[4] + 1));
+  int copyExt[6];
+  for (int j = 0; j < 3; ++j)
+  {
+    copyExt[2 * j] = std::max(bufferExt[2 * j], inExt[2 * j]);
+    copyExt[2 * j + 1] = std::min(bufferExt[2 * j + 1], inExt[2 * j + 1]);
+  }
+
+  for (int c = 0; c < numComps; ++c)
+  {
+    std::fill(buffer.begin(), buffer.end(), 0);
+    for (int idx2 = copyExt[4]; idx2 <= copyExt[5]; ++idx2)
+    {
+      for (int idx1 = copyExt[2]; idx1 <= copyExt[3]; ++idx1)
+      {
+        const T* inPtr0 = static_cast<T*>(inData->GetScalarPointer(copyExt[0], idx1, idx2)) + c;
+        unsigned char* bufferPtr0 = buffer.data() + (copyExt[0] - bufferExt[0]) +
+          (idx1 - bufferExt[2]) * bufferInc1 + (idx2 - bufferExt[4]) * bufferInc2;
+        for (int idx0 = copyExt[0]; idx0 <= copyExt[1]; ++idx0)
+        {
+          *bufferPtr0++ = (*inPtr0 == dilateValue);
+          inPtr0 += inInc0;
+        }
+      }
+    }
+
+    auto progress = [self, id, c, numComps](double fraction) {
+      if (!id)
+      {
+        self->UpdateProgress((c + fraction) / numComps);
+      }
+      return !self->AbortExecute;
+    };
+    if (!lines->Execute<unsigned char, vtkImageLineMorphologyMax<unsigned char>>(
+          buffer.data(), bufferExt, outExt, progress))
+    {
+      return;
+    }
+
+    for (int idx2 = outExt[4]; idx2 <= outExt[5]; ++idx2)
+    {
+      for (int idx1 = outExt[2]; idx1 <= outExt[3]; ++idx1)
+      {
+        const T* inPtr0 = static_cast<T*>(inData->GetScalarPointer(outExt[0], idx1, idx2)) + c;
+        T* outPtr0 = static_cast<T*>(outData->GetScalarPointer(outExt[0], idx1, idx2)) + c;
+        const unsigned char* bufferPtr0 = buffer.data() + (outExt[0] - bufferExt[0]) +
+          (idx1 - bufferExt[2]) * bufferInc1 + (idx2 - bufferExt[4]) * bufferInc2;
+        for (int idx0 = outExt[0]; idx0 <= outExt[1]; ++idx0)
+        {
+          *outPtr0 = ((*inPtr0 == erodeValue && *bufferPtr0) ? dilateValue : *inPtr0);
+          inPtr0 += inInc0;
+          outPtr0 += outInc0;
+          ++bufferPtr0;
+        }
+      }
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 // This method contains the first switch statement that calls the correct
 // templated function for the input and output Data types.
@@ -265,14 +372,6 @@ void vtkImageDilateErode3D::ThreadedRequestData(vtkInformation* vtkNotUsed(reque
   void* outPtr = outData[0]->GetScalarPointerForExtent(outExt);
   vtkImageData* mask;
 
-  // Error checking on mask
-  mask = this->Ellipse->GetOutput();
-  if (mask->GetScalarType() != VTK_UNSIGNED_CHAR)
-  {
-    vtkErrorMacro(<< "Execute: mask has wrong scalar type");
-    return;
-  }
-
   // this filter expects the output type to be same as input
   if (outData[0]->GetScalarType() != inData[0][0]->GetScalarType())
   {
@@ -282,6 +381,27 @@ void vtkImageDilateErode3D::ThreadedRequestData(vtkInformation* vtkNotUsed(reque
     return;
   }
 
+  // the box and the ball are decomposed in line segments
+  if (this->KernelShape != Ellipsoid)
+  {
+    switch (inData[0][0]->GetScalarType())
+    {
+      vtkTemplateMacro(vtkImageDilateErode3DExecuteLines<VTK_TT>(
+        this, this->LineMorphology, inData[0][0], outData[0], outExt, id));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+    }
+    return;
+  }
+
+  // Error checking on mask
+  mask = this->Ellipse->GetOutput();
+  if (mask->GetScalarType() != VTK_UNSIGNED_CHAR)
+  {
+    vtkErrorMacro(<< "Execute: mask has wrong scalar type");
+    return;
+  }
+
   switch (inData[0][0]->GetScalarType())
   {
     vtkTemplateMacro(vtkImageDilateErode3DExecute(this, mask, inData[0][0],
@@ -296,6 +416,17 @@ void vtkImageDilateErode3D::ThreadedRequestData(vtkInformation* vtkNotUsed(reque
 int vtkImageDilateErode3D::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  this->Ellipse->Update();
+  if (this->KernelShape == Box)
+  {
+    this->LineMorphology->SetBox(this->KernelSize, this->KernelMiddle);
+  }
+  else if (this->KernelShape == Ball)
+  {
+    this->LineMorphology->SetBall(this->KernelSize, this->KernelMiddle);
+  }
+  else
+  {
+    this->Ellipse->Update();
+  }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
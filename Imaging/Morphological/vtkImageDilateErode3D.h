@@ -21,6 +21,12 @@
  * boundary of the two values.  The filter is restricted to the
  * X, Y, and Z axes for now.  It can degenerate to a 2 or 1 dimensional
  * filter by setting the kernel size to 1 for a specific axis.
+ *
+ * The cost of the elliptical foot print grows with the volume of the
+ * kernel.  For large kernels, the foot print can instead be a box, or a
+ * ball that approximates the ellipse, which are decomposed into line
+ * segments that are processed with the van Herk/Gil-Werman algorithm, at a
+ * cost per voxel that does not depend on the kernel size.
  */
 
 #ifndef vtkImageDilateErode3D_h
@@ -30,6 +36,7 @@
 #include "vtkImagingMorphologicalModule.h" // For export macro
 
 class vtkImageEllipsoidSource;
+class vtkImageLineMorphology;
 
 class VTKIMAGINGMORPHOLOGICAL_EXPORT vtkImageDilateErode3D : public vtkImageSpatialAlgorithm
 {
@@ -50,6 +57,31 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  /**
+   * Enum constants for SetKernelShape().
+   */
+  enum KernelShapeEnum
+  {
+    Ellipsoid = 0,
+    Box = 1,
+    Ball = 2
+  };
+
+  ///@{
+  /**
+   * The shape of the foot print.  The default Ellipsoid visits every
+   * voxel of the kernel.  Box and Ball are decomposed into line segments,
+   * and Ball is an approximation of the ellipsoid with up to 13 segments,
+   * which is closer for larger kernels.
+   */
+  vtkSetClampMacro(KernelShape, int, Ellipsoid, Ball);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(Ellipsoid); }
+  void SetKernelShapeToBox() { this->SetKernelShape(Box); }
+  void SetKernelShapeToBall() { this->SetKernelShape(Ball); }
+  vtkGetMacro(KernelShape, int);
+  const char* GetKernelShapeAsString();
+  ///@}
+
   ///@{
   /**
    * Set/Get the Dilate and Erode values to be used by this filter.
@@ -65,6 +97,8 @@ protected:
   ~vtkImageDilateErode3D() override;
 
   vtkImageEllipsoidSource* Ellipse;
+  vtkImageLineMorphology* LineMorphology;
+  int KernelShape;
   double DilateValue;
   double ErodeValue;
 
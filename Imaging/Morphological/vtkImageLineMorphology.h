@@ -0,0 +1,597 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageLineMorphology.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageLineMorphology
+ * @brief   internals for the morphology filters with decomposed kernels
+ *
+ * vtkImageLineMorphology dilates or erodes an image with a kernel that is
+ * the Minkowski sum of line segments along lattice directions, by applying
+ * the segments one after the other.  Each segment is applied with the
+ * running maximum (or minimum) of van Herk and Gil-Werman, which needs
+ * three comparisons per voxel whatever the length of the segment: the lines
+ * are cut in blocks as long as the segment, in which the maxima are
+ * accumulated forward and backward, and the maximum over the segment is the
+ * maximum of the backward accumulation at its start and of the forward
+ * accumulation at its end.  All the lines of a segment direction are
+ * processed together, row by row, in loops that the compiler can vectorize.
+ *
+ * The box kernel is the sum of three segments along the axes.  The ball
+ * kernel approximates the ellipsoid that fits in the kernel size with up to
+ * thirteen segments, along the axes, the face diagonals and the body
+ * diagonals.  Their lengths are chosen to best fit the support function of
+ * the ellipsoid, while staying within its size along each axis.
+ *
+ * @sa
+ * M. van Herk, "A fast algorithm for local minimum and maximum filters on
+ * rectangular and octagonal kernels", Pattern Recognition Letters 13, 1992.
+ * J. Gil and M. Werman, "Computing 2-D min, median, and max filters", IEEE
+ * Transactions on PAMI 15, 1993.
+ */
+
+#ifndef vtkImageLineMorphology_h
+#define vtkImageLineMorphology_h
+
+#include "vtkType.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// The operation of a dilation, with the value of the voxels that are
+// outside of the image, which do not change the result.
+template <class T>
+struct vtkImageLineMorphologyMax
+{
+  static T Identity() { return std::numeric_limits<T>::lowest(); }
+  static T Apply(T a, T b) { return (a < b ? b : a); }
+};
+
+// The operation of an erosion
+template <class T>
+struct vtkImageLineMorphologyMin
+{
+  static T Identity() { return std::numeric_limits<T>::max(); }
+  static T Apply(T a, T b) { return (b < a ? b : a); }
+};
+
+class vtkImageLineMorphology
+{
+public:
+  // A segment covers the voxels p + t * Direction, for t from -Back to
+  // Forward.
+  struct Segment
+  {
+    int Direction[3];
+    int Back;
+    int Forward;
+  };
+
+  /**
+   * Set a box kernel of the given size, whose center is at the given
+   * position from its first voxel, like the kernels of the spatial filters.
+   */
+  void SetBox(const int size[3], const int middle[3])
+  {
+    this->Segments.clear();
+    for (int j = 0; j < 3; ++j)
+    {
+      if (size[j] > 1)
+      {
+        Segment segment = { { 0, 0, 0 }, middle[j], size[j] - 1 - middle[j] };
+        segment.Direction[j] = 1;
+        this->Segments.push_back(segment);
+      }
+    }
+  }
+
+  /**
+   * Set a ball kernel that approximates the ellipsoid that fits in the
+   * given size, centered on the middle voxel.  Along the axes, the ball
+   * does not extend further than (size - 1)/2 from its center, so that it
+   * stays within the given size.  The ball of a kernel that is only larger
+   * than one voxel along one axis is the box.
+   */
+  void SetBall(const int size[3], const int middle[3])
+  {
+    int numberOfAxes = 0;
+    double radius[3];
+    int bound[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      numberOfAxes += (size[j] > 1);
+      radius[j] = 0.5 * size[j];
+      bound[j] = (size[j] - 1) / 2;
+    }
+    if (numberOfAxes < 2)
+    {
+      this->SetBox(size, middle);
+      return;
+    }
+
+    // The directions, by type, that lie along the axes of the kernel
+    static const int directions[13][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 1, 1, 0 },
+      { 1, -1, 0 }, { 1, 0, 1 }, { 1, 0, -1 }, { 0, 1, 1 }, { 0, 1, -1 }, { 1, 1, 1 },
+      { 1, 1, -1 }, { 1, -1, 1 }, { 1, -1, -1 } };
+    static const int typeEnd[3] = { 3, 9, 13 };
+    std::vector<const int*> lines;
+    int lineType[13];
+    for (int i = 0, type = 0; i < 13; ++i)
+    {
+      type += (i == typeEnd[type]);
+      const int* d = directions[i];
+      if ((d[0] == 0 || size[0] > 1) && (d[1] == 0 || size[1] > 1) && (d[2] == 0 || size[2] > 1))
+      {
+        lineType[lines.size()] = type;
+        lines.push_back(d);
+      }
+    }
+    const int n = static_cast<int>(lines.size());
+
+    // Sample the directions of the unit sphere (or circle) of the kernel
+    std::vector<double> samples;
+    if (numberOfAxes == 3)
+    {
+      const int numberOfSamples = 200;
+      for (int i = 0; i < numberOfSamples; ++i)
+      {
+        double z = 1.0 - 2.0 * (i + 0.5) / numberOfSamples;
+        double r = std::sqrt(1.0 - z * z);
+        double phi = i * 2.399963229728653;
+        samples.push_back(r * std::cos(phi));
+        samples.push_back(r * std::sin(phi));
+        samples.push_back(z);
+      }
+    }
+    else
+    {
+      const int axis0 = (size[0] > 1 ? 0 : 1);
+      const int axis1 = (size[2] > 1 ? 2 : 1);
+      const int numberOfSamples = 64;
+      for (int i = 0; i < numberOfSamples; ++i)
+      {
+        double u[3] = { 0.0, 0.0, 0.0 };
+        u[axis0] = std::cos(3.141592653589793 * i / numberOfSamples);
+        u[axis1] = std::sin(3.141592653589793 * i / numberOfSamples);
+        samples.insert(samples.end(), u, u + 3);
+      }
+    }
+
+    // The support function of the sum of the segments, in the space where
+    // the ellipsoid is the unit sphere, is the sum of lengths[i]*support[i]
+    const int numberOfSamples = static_cast<int>(samples.size() / 3);
+    std::vector<double> support(n * numberOfSamples);
+    double scale[13];
+    double typeScale[3] = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < n; ++i)
+    {
+      const int* d = lines[i];
+      double norm2 = 0.0;
+      for (int j = 0; j < 3; ++j)
+      {
+        norm2 += (d[j] ? (d[j] / radius[j]) * (d[j] / radius[j]) : 0.0);
+      }
+      scale[i] = 1.0 / std::sqrt(norm2);
+      typeScale[lineType[i]] = std::max(typeScale[lineType[i]], scale[i]);
+      for (int s = 0; s < numberOfSamples; ++s)
+      {
+        const double* u = &samples[3 * s];
+        support[i * numberOfSamples + s] =
+          std::fabs(d[0] * u[0] / radius[0] + d[1] * u[1] / radius[1] + d[2] * u[2] / radius[2]);
+      }
+    }
+
+    std::vector<double> h(numberOfSamples);
+    auto error = [&](const int* lengths) {
+      // the sums must stay within the bounds
+      for (int j = 0; j < 3; ++j)
+      {
+        int extent = 0;
+        for (int i = 0; i < n; ++i)
+        {
+          extent += lengths[i] * std::abs(lines[i][j]);
+        }
+        if (extent > bound[j])
+        {
+          return -1.0;
+        }
+      }
+      std::fill(h.begin(), h.end(), -1.0);
+      for (int i = 0; i < n; ++i)
+      {
+        const double* iter = &support[i * numberOfSamples];
+        for (int s = 0; s < numberOfSamples; ++s)
+        {
+          h[s] += lengths[i] * iter[s];
+        }
+      }
+      double e = 0.0;
+      for (int s = 0; s < numberOfSamples; ++s)
+      {
+        e += h[s] * h[s];
+      }
+      return e;
+    };
+
+    // Search the lengths of the longest segment of each type, the others
+    // being proportional, then adjust the segments one by one.
+    int lengths[13];
+    int best[13];
+    double bestError = -1.0;
+    const int maxLength = std::max(bound[0], std::max(bound[1], bound[2]));
+    int maxTypeLength[3];
+    for (int type = 0; type < 3; ++type)
+    {
+      maxTypeLength[type] = (typeScale[type] > 0.0 ? maxLength : 0);
+    }
+    int typeLength[3];
+    for (typeLength[0] = 0; typeLength[0] <= maxTypeLength[0]; ++typeLength[0])
+    {
+      for (typeLength[1] = 0; typeLength[1] <= maxTypeLength[1]; ++typeLength[1])
+      {
+        for (typeLength[2] = 0; typeLength[2] <= maxTypeLength[2]; ++typeLength[2])
+        {
+          for (int i = 0; i < n; ++i)
+          {
+            int type = lineType[i];
+            lengths[i] = static_cast<int>(typeLength[type] * scale[i] / typeScale[type] + 0.5);
+          }
+          double e = error(lengths);
+          if (e < 0.0)
+          {
+            // longer segments of this type would not fit either
+            break;
+          }
+          if (bestError < 0.0 || e < bestError)
+          {
+            bestError = e;
+            std::copy(lengths, lengths + n, best);
+          }
+        }
+        if (typeLength[2] == 0)
+        {
+          break;
+        }
+      }
+      if (typeLength[1] == 0 && typeLength[2] == 0)
+      {
+        break;
+      }
+    }
+    for (bool improved = true; improved;)
+    {
+      improved = false;
+      for (int i = 0; i < n; ++i)
+      {
+        for (int step = 1; step >= -1; step -= 2)
+        {
+          best[i] += step;
+          double e = (best[i] < 0 ? -1.0 : error(best));
+          if (e >= 0.0 && e < bestError - 1e-12)
+          {
+            bestError = e;
+            improved = true;
+          }
+          else
+          {
+            best[i] -= step;
+          }
+        }
+      }
+    }
+
+    this->Segments.clear();
+    for (int i = 0; i < n; ++i)
+    {
+      if (best[i] > 0)
+      {
+        Segment segment = { { lines[i][0], lines[i][1], lines[i][2] }, best[i], best[i] };
+        this->Segments.push_back(segment);
+      }
+    }
+  }
+
+  const std::vector<Segment>& GetSegments() const { return this->Segments; }
+
+  /**
+   * Get how far the kernel extends below and above its center, along each
+   * axis, which is how much the buffer given to Execute() must be padded.
+   */
+  void GetPadding(int padding[6]) const
+  {
+    std::fill(padding, padding + 6, 0);
+    for (const Segment& segment : this->Segments)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        int d = segment.Direction[j];
+        padding[2 * j] += std::max(segment.Back * d, -segment.Forward * d);
+        padding[2 * j + 1] += std::max(segment.Forward * d, -segment.Back * d);
+      }
+    }
+  }
+
+  /**
+   * Get the extent of the buffer that Execute() needs for the given
+   * output extent.
+   */
+  void GetBufferExtent(const int outExt[6], int bufferExt[6]) const
+  {
+    int padding[6];
+    this->GetPadding(padding);
+    for (int j = 0; j < 3; ++j)
+    {
+      bufferExt[2 * j] = outExt[2 * j] - padding[2 * j];
+      bufferExt[2 * j + 1] = outExt[2 * j + 1] + padding[2 * j + 1];
+    }
+  }
+
+  /**
+   * Dilate or erode each component of an image, whose scalars of extent
+   * inExt start at inPtr, into the output extent of the scalars of extent
+   * outDataExt that start at outPtr.  The voxels outside of inExt are
+   * ignored, which must hold the output extent padded by the kernel,
+   * clipped to the whole extent.
+   */
+  template <class T, class TOp, class TProgress>
+  bool ExecuteImage(const T* inPtr, const int inExt[6], T* outPtr, const int outDataExt[6],
+    const int outExt[6], int numComps, TProgress progress) const
+  {
+    int bufferExt[6];
+    this->GetBufferExtent(outExt, bufferExt);
+    const vtkIdType bufferInc[3] = { 1, bufferExt[1] - bufferExt[0] + 1,
+      vtkIdType(bufferExt[1] - bufferExt[0] + 1) * (bufferExt[3] - bufferExt[2] + 1) };
+    std::vector<T> buffer(bufferInc[2] * (bufferExt[5] - bufferExt[4] + 1));
+    const vtkIdType inInc[3] = { numComps, numComps * vtkIdType(inExt[1] - inExt[0] + 1),
+      numComps * vtkIdType(inExt[1] - inExt[0] + 1) * (inExt[3] - inExt[2] + 1) };
+    const vtkIdType outInc[3] = { numComps, numComps * vtkIdType(outDataExt[1] - outDataExt[0] + 1),
+      numComps * vtkIdType(outDataExt[1] - outDataExt[0] + 1) *
+        (outDataExt[3] - outDataExt[2] + 1) };
+    int copyExt[6];
+    for (int j = 0; j < 3; ++j)
+    {
+      copyExt[2 * j] = std::max(bufferExt[2 * j], inExt[2 * j]);
+      copyExt[2 * j + 1] = std::min(bufferExt[2 * j + 1], inExt[2 * j + 1]);
+    }
+
+    for (int c = 0; c < numComps; ++c)
+    {
+      std::fill(buffer.begin(), buffer.end(), TOp::Identity());
+      for (int z = copyExt[4]; z <= copyExt[5]; ++z)
+      {
+        for (int y = copyExt[2]; y <= copyExt[3]; ++y)
+        {
+          const T* inRow = inPtr + c + (y - inExt[2]) * inInc[1] + (z - inExt[4]) * inInc[2];
+          T* row = buffer.data() + (y - bufferExt[2]) * bufferInc[1] +
+            (z - bufferExt[4]) * bufferInc[2];
+          for (int x = copyExt[0]; x <= copyExt[1]; ++x)
+          {
+            row[x - bufferExt[0]] = inRow[(x - inExt[0]) * numComps];
+          }
+        }
+      }
+
+      auto componentProgress = [&](double fraction) { return progress((c + fraction) / numComps); };
+      if (!this->Execute<T, TOp>(buffer.data(), bufferExt, outExt, componentProgress))
+      {
+        return false;
+      }
+
+      for (int z = outExt[4]; z <= outExt[5]; ++z)
+      {
+        for (int y = outExt[2]; y <= outExt[3]; ++y)
+        {
+          T* outRow =
+            outPtr + c + (y - outDataExt[2]) * outInc[1] + (z - outDataExt[4]) * outInc[2];
+          const T* row = buffer.data() + (y - bufferExt[2]) * bufferInc[1] +
+            (z - bufferExt[4]) * bufferInc[2];
+          for (int x = outExt[0]; x <= outExt[1]; ++x)
+          {
+            outRow[(x - outDataExt[0]) * numComps] = row[x - bufferExt[0]];
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Dilate (with vtkImageLineMorphologyMax) or erode (with
+   * vtkImageLineMorphologyMin) the buffer, whose extent must be the output
+   * extent padded by the extent of the kernel, and whose voxels outside of
+   * the image must be set to the identity of the operation.  The result is
+   * valid over the output extent.  The progress, between 0 and 1, is
+   * reported to the given function after each segment, which returns false
+   * to abort.
+   */
+  template <class T, class TOp, class TProgress>
+  bool Execute(T* buffer, const int bufferExt[6], const int outExt[6], TProgress progress) const
+  {
+    const vtkIdType dims[3] = { bufferExt[1] - bufferExt[0] + 1, bufferExt[3] - bufferExt[2] + 1,
+      bufferExt[5] - bufferExt[4] + 1 };
+    const vtkIdType size = dims[0] * dims[1] * dims[2];
+    std::vector<T> forward(size);
+    std::vector<T> backward(size);
+
+    // The voxels that each segment must compute are the output voxels,
+    // padded by the extent of the segments that follow it.
+    const size_t numberOfSegments = this->Segments.size();
+    std::vector<int> cores(6 * numberOfSegments);
+    int core[6];
+    for (int j = 0; j < 3; ++j)
+    {
+      core[2 * j] = outExt[2 * j] - bufferExt[2 * j];
+      core[2 * j + 1] = outExt[2 * j + 1] - bufferExt[2 * j];
+    }
+    for (size_t i = numberOfSegments; i-- > 0;)
+    {
+      std::copy(core, core + 6, &cores[6 * i]);
+      const Segment& segment = this->Segments[i];
+      for (int j = 0; j < 3; ++j)
+      {
+        int d = segment.Direction[j];
+        core[2 * j] = std::max(core[2 * j] - std::max(segment.Back * d, -segment.Forward * d), 0);
+        core[2 * j + 1] = std::min(
+          core[2 * j + 1] + std::max(segment.Forward * d, -segment.Back * d), int(dims[j]) - 1);
+      }
+    }
+
+    for (size_t i = 0; i < numberOfSegments; ++i)
+    {
+      vtkImageLineMorphology::ExecuteSegment<T, TOp>(
+        buffer, forward.data(), backward.data(), dims, &cores[6 * i], this->Segments[i]);
+      if (!progress(static_cast<double>(i + 1) / numberOfSegments))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  template <class T, class TOp>
+  static void ExecuteSegment(T* buffer, T* forward, T* backward, const vtkIdType dims[3],
+    const int core[6], const Segment& segment)
+  {
+    // Step along the last axis that the direction crosses, forward
+    int d[3] = { segment.Direction[0], segment.Direction[1], segment.Direction[2] };
+    int back = segment.Back;
+    int front = segment.Forward;
+    const int axis = (d[2] ? 2 : (d[1] ? 1 : 0));
+    if (d[axis] < 0)
+    {
+      d[0] = -d[0];
+      d[1] = -d[1];
+      d[2] = -d[2];
+      std::swap(back, front);
+    }
+    const vtkIdType length = back + front + 1;
+    const vtkIdType inc[3] = { 1, dims[0], dims[0] * dims[1] };
+    const vtkIdType step = d[0] + d[1] * inc[1] + d[2] * inc[2];
+    const vtkIdType n = dims[0];
+
+    if (axis == 0)
+    {
+      // Along the rows: the accumulations restart at each block
+      for (vtkIdType row = 0; row < dims[1] * dims[2]; ++row)
+      {
+        const T* f = buffer + row * n;
+        T* g = forward + row * n;
+        T* h = backward + row * n;
+        for (vtkIdType x = 0; x < n; ++x)
+        {
+          g[x] = (x % length == 0 ? f[x] : TOp::Apply(g[x - 1], f[x]));
+        }
+        for (vtkIdType x = n - 1; x >= 0; --x)
+        {
+          h[x] = ((x + 1) % length == 0 || x == n - 1 ? f[x] : TOp::Apply(h[x + 1], f[x]));
+        }
+      }
+    }
+    else
+    {
+      // Across the rows: each row accumulates the previous row along the
+      // direction, shifted by d[0], except at the starts of the blocks.
+      const vtkIdType shift = d[0];
+      const vtkIdType x0 = std::max(shift, vtkIdType(0));
+      const vtkIdType x1 = n + std::min(shift, vtkIdType(0));
+      for (vtkIdType z = 0; z < dims[2]; ++z)
+      {
+        for (vtkIdType y = 0; y < dims[1]; ++y)
+        {
+          const vtkIdType offset = y * inc[1] + z * inc[2];
+          const T* f = buffer + offset;
+          T* g = forward + offset;
+          const vtkIdType position = (axis == 1 ? y : z);
+          const vtkIdType py = y - d[1];
+          const vtkIdType pz = z - d[2];
+          if (position % length == 0 || py < 0 || py >= dims[1] || pz < 0)
+          {
+            std::copy(f, f + n, g);
+            continue;
+          }
+          const T* p = forward + py * inc[1] + pz * inc[2];
+          for (vtkIdType x = 0; x < x0; ++x)
+          {
+            g[x] = f[x];
+          }
+          for (vtkIdType x = x0; x < x1; ++x)
+          {
+            g[x] = TOp::Apply(p[x - shift], f[x]);
+          }
+          for (vtkIdType x = x1; x < n; ++x)
+          {
+            g[x] = f[x];
+          }
+        }
+      }
+      for (vtkIdType z = dims[2] - 1; z >= 0; --z)
+      {
+        for (vtkIdType y = dims[1] - 1; y >= 0; --y)
+        {
+          const vtkIdType offset = y * inc[1] + z * inc[2];
+          const T* f = buffer + offset;
+          T* h = backward + offset;
+          const vtkIdType position = (axis == 1 ? y : z);
+          const vtkIdType ny = y + d[1];
+          const vtkIdType nz = z + d[2];
+          if ((position + 1) % length == 0 || ny < 0 || ny >= dims[1] || nz >= dims[2])
+          {
+            std::copy(f, f + n, h);
+            continue;
+          }
+          const T* p = backward + ny * inc[1] + nz * inc[2];
+          const vtkIdType xs0 = std::max(-shift, vtkIdType(0));
+          const vtkIdType xs1 = n - std::max(shift, vtkIdType(0));
+          for (vtkIdType x = 0; x < xs0; ++x)
+          {
+            h[x] = f[x];
+          }
+          for (vtkIdType x = xs0; x < xs1; ++x)
+          {
+            h[x] = TOp::Apply(p[x + shift], f[x]);
+          }
+          for (vtkIdType x = xs1; x < n; ++x)
+          {
+            h[x] = f[x];
+          }
+        }
+      }
+    }
+
+    // The maximum over the segment that starts at back steps behind
+    const vtkIdType backOffset = -back * step;
+    const vtkIdType frontOffset = front * step;
+    for (vtkIdType z = core[4]; z <= core[5]; ++z)
+    {
+      for (vtkIdType y = core[2]; y <= core[3]; ++y)
+      {
+        const vtkIdType offset = y * inc[1] + z * inc[2];
+        T* f = buffer + offset;
+        const T* h = backward + offset + backOffset;
+        const T* g = forward + offset + frontOffset;
+        for (vtkIdType x = core[0]; x <= core[1]; ++x)
+        {
+          f[x] = TOp::Apply(h[x], g[x]);
+        }
+      }
+    }
+  }
+
+  std::vector<Segment> Segments;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImageLineMorphology.h
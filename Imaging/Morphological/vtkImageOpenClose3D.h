@@ -28,6 +28,9 @@
  * Values other than open value and close value are not touched.
  * This enables the filter to processes segmented images containing more than
  * two tags.
+ * For large kernels, SetKernelShapeToBall() or SetKernelShapeToBox() make
+ * the cost per voxel independent of the kernel size, see
+ * vtkImageDilateErode3D.
  */
 
 #ifndef vtkImageOpenClose3D_h
@@ -76,6 +79,19 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  ///@{
+  /**
+   * Selects the shape of the kernel, among the shapes of
+   * vtkImageDilateErode3D.  The default is the exact ellipsoid, and the box
+   * and the ball are faster for large kernels.
+   */
+  void SetKernelShape(int shape);
+  int GetKernelShape();
+  void SetKernelShapeToEllipsoid();
+  void SetKernelShapeToBox();
+  void SetKernelShapeToBall();
+  ///@}
+
   ///@{
   /**
    * Determines the value that will opened.